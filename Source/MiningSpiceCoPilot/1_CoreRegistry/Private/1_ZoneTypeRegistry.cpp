@@ -45,6 +45,7 @@ bool FZoneTypeRegistry::Initialize()
     
     // Initialize internal maps
     TransactionTypeMap.Empty();
+    TransactionTypeTable.Clear();
     TransactionTypeNameMap.Empty();
     ZoneConfigMap.Empty();
     ZoneTypeMap.Empty();
@@ -67,6 +68,7 @@ void FZoneTypeRegistry::Shutdown()
         
         // Clear all registered items
         TransactionTypeMap.Empty();
+        TransactionTypeTable.Clear();
         TransactionTypeNameMap.Empty();
         ZoneConfigMap.Empty();
         
@@ -204,6 +206,7 @@ void FZoneTypeRegistry::Clear()
         
         // Clear all registered items
         TransactionTypeMap.Empty();
+        TransactionTypeTable.Clear();
         TransactionTypeNameMap.Empty();
         ZoneConfigMap.Empty();
         
@@ -362,6 +365,7 @@ uint32 FZoneTypeRegistry::RegisterTransactionType(
         
         // Add to maps
         TransactionTypeMap.Add(NewTypeId, TypeInfo);
+        TransactionTypeTable.AddOrUpdateTypeInfo(NewTypeId, TypeInfo);
         TransactionTypeNameMap.Add(InTypeName, NewTypeId);
     }
     
@@ -426,6 +430,7 @@ uint32 FZoneTypeRegistry::RegisterMaterialTransaction(
     
     // Register the type
     TransactionTypeMap.Add(TypeId, TypeInfo);
+    TransactionTypeTable.AddOrUpdateTypeInfo(TypeId, TypeInfo);
     TransactionTypeNameMap.Add(InTypeName, TypeId);
     
     UE_LOG(LogTemp, Verbose, TEXT("FZoneTypeRegistry::RegisterMaterialTransaction - registered type '%s' with ID %u for channel %d"),
@@ -503,17 +508,9 @@ const FZoneTransactionTypeInfo* FZoneTypeRegistry::GetTransactionTypeInfo(uint32
         return nullptr;
     }
     
-    // Lock for thread safety
-    FScopedSpinLock Lock(RegistryLock);
-    
-    // Look up type by ID
-    const TSharedRef<FZoneTransactionTypeInfo>* TypeInfoPtr = TransactionTypeMap.Find(InTypeId);
-    if (TypeInfoPtr)
-    {
-        return &(TypeInfoPtr->Get());
-    }
-    
-    return nullptr;
+    // Lock-free lookup; registered infos are never removed individually, so the pointer outlives the scope
+    FVersionedTypeTable<FZoneTransactionTypeInfo>::FReadScope Scope(TransactionTypeTable);
+    return TransactionTypeTable.FindTypeInfo(InTypeId, Scope);
 }
 
 const FZoneTransactionTypeInfo* FZoneTypeRegistry::GetTransactionTypeInfoByName(const FName& InTypeName) const
@@ -720,10 +717,8 @@ bool FZoneTypeRegistry::IsTransactionTypeRegistered(uint32 InTypeId) const
         return false;
     }
     
-    // Lock for thread safety
-    FScopedSpinLock Lock(RegistryLock);
-    
-    return TransactionTypeMap.Contains(InTypeId);
+    FVersionedTypeTable<FZoneTransactionTypeInfo>::FReadScope Scope(TransactionTypeTable);
+    return TransactionTypeTable.FindTypeInfo(InTypeId, Scope) != nullptr;
 }
 
 bool FZoneTypeRegistry::IsTransactionTypeRegistered(const FName& InTypeName) const
@@ -412,7 +412,7 @@ public:
         uint32 InMaxConcurrentTransactions = 16);
     
     /**
-     * Gets information about a registered transaction type
+     * Gets information about a registered transaction type without taking the registry lock
      * @param InTypeId Unique ID of the transaction type
      * @return Pointer to transaction type info, or nullptr if not found
      */
@@ -666,6 +666,9 @@ private:
     /** Map of transaction types by ID */
     TMap<uint32, TSharedRef<FZoneTransactionTypeInfo>> TransactionTypeMap;
     
+    /** Lock-free copy of TransactionTypeMap for lookups by ID; republished whenever the map changes */
+    FVersionedTypeTable<FZoneTransactionTypeInfo> TransactionTypeTable;
+    
     /** Map of transaction type names to IDs */
     TMap<FName, uint32> TransactionTypeNameMap;
     
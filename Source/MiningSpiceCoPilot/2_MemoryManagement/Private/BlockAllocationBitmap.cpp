@@ -0,0 +1,243 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BlockAllocationBitmap.h"
+
+namespace BlockAllocationBitmapInternal
+{
+    /** Mask of the bits at and above Bit in a word */
+    static FORCEINLINE uint64 MaskFrom(uint32 Bit)
+    {
+        return ~0ull << Bit;
+    }
+
+    /** Mask of the bits below Bit in a word; Bit 0 means the whole word */
+    static FORCEINLINE uint64 MaskBelow(uint32 Bit)
+    {
+        return Bit ? ~0ull >> (64 - Bit) : ~0ull;
+    }
+}
+
+void FBlockAllocationBitmap::SetNum(uint32 InNumBits)
+{
+    Words.SetNumZeroed(FMath::DivideAndRoundUp(InNumBits, 64u));
+    NumBits = InNumBits;
+    ClearTrailingBits();
+}
+
+void FBlockAllocationBitmap::ClearAll()
+{
+    FMemory::Memzero(Words.GetData(), Words.Num() * sizeof(uint64));
+}
+
+void FBlockAllocationBitmap::Empty()
+{
+    Words.Empty();
+    NumBits = 0;
+}
+
+void FBlockAllocationBitmap::SetLeading(uint32 Count)
+{
+    check(Count <= NumBits);
+
+    const uint32 FullWords = Count >> 6;
+    for (int32 WordIndex = 0; WordIndex < Words.Num(); ++WordIndex)
+    {
+        if (static_cast<uint32>(WordIndex) < FullWords)
+        {
+            Words[WordIndex] = ~0ull;
+        }
+        else if (static_cast<uint32>(WordIndex) == FullWords)
+        {
+            Words[WordIndex] = (Count & 63) ? BlockAllocationBitmapInternal::MaskBelow(Count & 63) : 0;
+        }
+        else
+        {
+            Words[WordIndex] = 0;
+        }
+    }
+}
+
+uint32 FBlockAllocationBitmap::CountSet() const
+{
+    uint32 Count = 0;
+    for (uint64 Word : Words)
+    {
+        Count += static_cast<uint32>(FMath::CountBits(Word));
+    }
+    return Count;
+}
+
+uint32 FBlockAllocationBitmap::CountSetInRange(uint32 Start, uint32 End) const
+{
+    using namespace BlockAllocationBitmapInternal;
+
+    End = FMath::Min(End, NumBits);
+    if (Start >= End)
+    {
+        return 0;
+    }
+
+    const uint32 FirstWord = Start >> 6;
+    const uint32 LastWord = (End - 1) >> 6;
+    uint32 Count = 0;
+    for (uint32 WordIndex = FirstWord; WordIndex <= LastWord; ++WordIndex)
+    {
+        uint64 Word = Words[WordIndex];
+        if (WordIndex == FirstWord)
+        {
+            Word &= MaskFrom(Start & 63);
+        }
+        if (WordIndex == LastWord)
+        {
+            Word &= MaskBelow(End & 63);
+        }
+        Count += static_cast<uint32>(FMath::CountBits(Word));
+    }
+    return Count;
+}
+
+uint32 FBlockAllocationBitmap::CountTransitions() const
+{
+    if (NumBits == 0)
+    {
+        return 0;
+    }
+
+    // Compare each bit with the one before it by xoring the word with itself shifted up one,
+    // carrying the top bit of the previous word in. Block 0 is compared with itself.
+    uint32 Count = 0;
+    uint64 Carry = Words[0] & 1;
+    const int32 LastWord = Words.Num() - 1;
+    for (int32 WordIndex = 0; WordIndex <= LastWord; ++WordIndex)
+    {
+        const uint64 Word = Words[WordIndex];
+        uint64 Differences = Word ^ ((Word << 1) | Carry);
+        if (WordIndex == LastWord)
+        {
+            Differences &= BlockAllocationBitmapInternal::MaskBelow(NumBits & 63);
+        }
+        Count += static_cast<uint32>(FMath::CountBits(Differences));
+        Carry = Word >> 63;
+    }
+    return Count;
+}
+
+int32 FBlockAllocationBitmap::FindFirstSet(uint32 Start) const
+{
+    if (Start >= NumBits)
+    {
+        return INDEX_NONE;
+    }
+
+    uint32 WordIndex = Start >> 6;
+    uint64 Word = Words[WordIndex] & BlockAllocationBitmapInternal::MaskFrom(Start & 63);
+    while (true)
+    {
+        if (Word)
+        {
+            return static_cast<int32>((WordIndex << 6) + FMath::CountTrailingZeros64(Word));
+        }
+        if (++WordIndex >= static_cast<uint32>(Words.Num()))
+        {
+            return INDEX_NONE;
+        }
+        Word = Words[WordIndex];
+    }
+}
+
+int32 FBlockAllocationBitmap::FindFirstClear(uint32 Start) const
+{
+    if (Start >= NumBits)
+    {
+        return INDEX_NONE;
+    }
+
+    uint32 WordIndex = Start >> 6;
+    uint64 Word = ~Words[WordIndex] & BlockAllocationBitmapInternal::MaskFrom(Start & 63);
+    while (true)
+    {
+        if (Word)
+        {
+            // Bits past NumBits read as clear, so they are filtered here
+            const uint32 Index = (WordIndex << 6) + static_cast<uint32>(FMath::CountTrailingZeros64(Word));
+            return Index < NumBits ? static_cast<int32>(Index) : INDEX_NONE;
+        }
+        if (++WordIndex >= static_cast<uint32>(Words.Num()))
+        {
+            return INDEX_NONE;
+        }
+        Word = ~Words[WordIndex];
+    }
+}
+
+int32 FBlockAllocationBitmap::FindLastSet(uint32 End) const
+{
+    End = FMath::Min(End, NumBits);
+    if (End == 0)
+    {
+        return INDEX_NONE;
+    }
+
+    int32 WordIndex = static_cast<int32>((End - 1) >> 6);
+    uint64 Word = Words[WordIndex] & BlockAllocationBitmapInternal::MaskBelow(End & 63);
+    while (true)
+    {
+        if (Word)
+        {
+            return (WordIndex << 6) + 63 - static_cast<int32>(FMath::CountLeadingZeros64(Word));
+        }
+        if (--WordIndex < 0)
+        {
+            return INDEX_NONE;
+        }
+        Word = Words[WordIndex];
+    }
+}
+
+int32 FBlockAllocationBitmap::FindClearRun(uint32 Length, uint32 Start) const
+{
+    if (Length == 0)
+    {
+        return Start < NumBits ? static_cast<int32>(Start) : INDEX_NONE;
+    }
+
+    // Jump from each free run's start to the next allocated block, so runs cost two word scans
+    int32 RunStart = FindFirstClear(Start);
+    while (RunStart != INDEX_NONE)
+    {
+        const int32 RunEnd = FindFirstSet(RunStart);
+        const uint32 RunLength = (RunEnd == INDEX_NONE ? NumBits : static_cast<uint32>(RunEnd)) - RunStart;
+        if (RunLength >= Length)
+        {
+            return RunStart;
+        }
+        if (RunEnd == INDEX_NONE)
+        {
+            break;
+        }
+        RunStart = FindFirstClear(RunEnd);
+    }
+    return INDEX_NONE;
+}
+
+void FBlockAllocationBitmap::GetSetIndices(TArray<uint32>& OutIndices) const
+{
+    OutIndices.Reserve(OutIndices.Num() + CountSet());
+    for (int32 WordIndex = 0; WordIndex < Words.Num(); ++WordIndex)
+    {
+        uint64 Word = Words[WordIndex];
+        while (Word)
+        {
+            OutIndices.Add((static_cast<uint32>(WordIndex) << 6) + static_cast<uint32>(FMath::CountTrailingZeros64(Word)));
+            Word &= Word - 1;
+        }
+    }
+}
+
+void FBlockAllocationBitmap::ClearTrailingBits()
+{
+    if ((NumBits & 63) != 0)
+    {
+        Words.Last() &= BlockAllocationBitmapInternal::MaskBelow(NumBits & 63);
+    }
+}
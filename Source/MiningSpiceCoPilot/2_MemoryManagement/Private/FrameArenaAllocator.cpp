@@ -0,0 +1,342 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FrameArenaAllocator.h"
+#include "Interfaces/IMemoryTracker.h"
+#include "Misc/ScopeLock.h"
+
+namespace FrameArenaInternal
+{
+    /** Next slot to hand to a thread; shared by all arenas so a thread uses the same slot everywhere */
+    static std::atomic<uint32> NextThreadSlot(0);
+
+    /** Slot of the calling thread, assigned on first use */
+    static thread_local int32 ThreadSlot = INDEX_NONE;
+
+#if DO_CHECK
+    /** Counts the calling thread as inside Allocate for the scope's lifetime */
+    struct FActiveAllocatorScope
+    {
+        explicit FActiveAllocatorScope(std::atomic<int32>& InCount)
+            : Count(InCount)
+        {
+            Count.fetch_add(1);
+        }
+
+        ~FActiveAllocatorScope()
+        {
+            Count.fetch_sub(1);
+        }
+
+        std::atomic<int32>& Count;
+    };
+#endif
+}
+
+void FFrameArenaAllocator::FChunkList::Push(FChunk* Chunk)
+{
+    Chunk->Next = Head;
+    Head = Chunk;
+    if (!Tail)
+    {
+        Tail = Chunk;
+    }
+}
+
+void FFrameArenaAllocator::FChunkList::Splice(FChunkList& Other)
+{
+    if (!Other.Head)
+    {
+        return;
+    }
+
+    Other.Tail->Next = Head;
+    Head = Other.Head;
+    if (!Tail)
+    {
+        Tail = Other.Tail;
+    }
+    Other.Head = nullptr;
+    Other.Tail = nullptr;
+}
+
+FFrameArenaAllocator::FFrameArenaAllocator(const FName& InCategoryName, uint32 InBufferCount, uint64 InChunkSize)
+    : CategoryName(InCategoryName)
+    , BufferCount(FMath::Clamp<uint32>(InBufferCount, 1, MaxBufferCount))
+    , ChunkSize(FMath::Max<uint64>(Align(InChunkSize, PLATFORM_CACHE_LINE_SIZE), 4096))
+    , FrameNumber(1)
+    , ReservedBytes(0)
+    , LastFrameBytes(0)
+    , HighWaterBytes(0)
+    , HighWaterChunkBytes(0)
+    , MemoryTracker(nullptr)
+{
+}
+
+FFrameArenaAllocator::~FFrameArenaAllocator()
+{
+    Empty();
+}
+
+void FFrameArenaAllocator::SetMemoryTracker(IMemoryTracker* InMemoryTracker)
+{
+    FScopeLock Lock(&ArenaLock);
+
+    if (InMemoryTracker == MemoryTracker)
+    {
+        return;
+    }
+
+    auto MoveList = [this, InMemoryTracker](const FChunkList& List)
+    {
+        for (FChunk* Chunk = List.Head; Chunk; Chunk = Chunk->Next)
+        {
+            if (MemoryTracker)
+            {
+                MemoryTracker->UntrackAllocation(Chunk);
+            }
+            if (InMemoryTracker)
+            {
+                InMemoryTracker->TrackAllocation(Chunk, Chunk->Size, CategoryName);
+            }
+        }
+    };
+
+    MoveList(IdleChunks);
+    for (const FFrame& Frame : Frames)
+    {
+        MoveList(Frame.Chunks);
+        MoveList(Frame.OversizedBlocks);
+    }
+
+    MemoryTracker = InMemoryTracker;
+}
+
+void* FFrameArenaAllocator::Allocate(uint64 SizeInBytes, uint32 Alignment)
+{
+    check(FMath::IsPowerOfTwo(Alignment));
+
+#if DO_CHECK
+    FrameArenaInternal::FActiveAllocatorScope ActiveScope(ActiveAllocators);
+#endif
+
+    const uint32 CurrentFrame = FrameNumber.load(std::memory_order_acquire);
+
+    // Large requests would waste most of a shared chunk, so they get a block of their own
+    if (SizeInBytes + Alignment > ChunkSize / 4)
+    {
+        return AllocateOversized(CurrentFrame, SizeInBytes, Alignment);
+    }
+
+    FSlot& Slot = LockSlot();
+
+    // A slot last used in an earlier frame holds a chunk that has since been recycled
+    if (Slot.FrameNumber != CurrentFrame)
+    {
+        Slot.FrameNumber = CurrentFrame;
+        Slot.Cursor = nullptr;
+        Slot.End = nullptr;
+        Slot.AllocatedBytes = 0;
+    }
+
+    uint8* Result = Align(Slot.Cursor, Alignment);
+    if (!Slot.Cursor || Result + SizeInBytes > Slot.End)
+    {
+        FChunk* Chunk = AcquireChunk(CurrentFrame);
+        if (!Chunk)
+        {
+            UnlockSlot(Slot);
+            return nullptr;
+        }
+
+        Slot.End = Chunk->GetEnd();
+        Result = Align(Chunk->GetData(), Alignment);
+    }
+
+    Slot.Cursor = Result + SizeInBytes;
+    Slot.AllocatedBytes += SizeInBytes;
+    UnlockSlot(Slot);
+
+    return Result;
+}
+
+void FFrameArenaAllocator::BeginFrame()
+{
+#if DO_CHECK
+    checkf(ActiveAllocators.load() == 0, TEXT("FFrameArenaAllocator::BeginFrame - Called while %d threads are allocating"), ActiveAllocators.load());
+#endif
+
+    FScopeLock Lock(&ArenaLock);
+
+    // Bytes the finished frame allocated, from the slots still on it and its oversized blocks
+    const uint32 FinishedFrame = FrameNumber.load(std::memory_order_relaxed);
+    FFrame& Finished = GetFrame(FinishedFrame);
+    uint64 FrameBytes = Finished.OversizedBytes;
+    for (const FSlot& Slot : Slots)
+    {
+        if (Slot.FrameNumber == FinishedFrame)
+        {
+            FrameBytes += Slot.AllocatedBytes;
+        }
+    }
+
+    LastFrameBytes = FrameBytes;
+    HighWaterBytes = FMath::Max(HighWaterBytes, FrameBytes);
+    HighWaterChunkBytes = FMath::Max(HighWaterChunkBytes, Finished.ChunkBytes);
+
+    // The new frame takes over the oldest frame's memory
+    const uint32 NextFrame = FinishedFrame + 1;
+    ResetFrame(GetFrame(NextFrame));
+    FrameNumber.store(NextFrame, std::memory_order_release);
+}
+
+uint64 FFrameArenaAllocator::Trim()
+{
+#if DO_CHECK
+    checkf(ActiveAllocators.load() == 0, TEXT("FFrameArenaAllocator::Trim - Called while %d threads are allocating"), ActiveAllocators.load());
+#endif
+
+    FScopeLock Lock(&ArenaLock);
+    return FreeChunks(IdleChunks);
+}
+
+void FFrameArenaAllocator::Empty()
+{
+#if DO_CHECK
+    checkf(ActiveAllocators.load() == 0, TEXT("FFrameArenaAllocator::Empty - Called while %d threads are allocating"), ActiveAllocators.load());
+#endif
+
+    FScopeLock Lock(&ArenaLock);
+
+    for (FFrame& Frame : Frames)
+    {
+        ResetFrame(Frame);
+    }
+    FreeChunks(IdleChunks);
+
+    // Move every slot off its chunk
+    FrameNumber.store(FrameNumber.load(std::memory_order_relaxed) + BufferCount, std::memory_order_release);
+}
+
+FFrameArenaAllocator::FFrameArenaStats FFrameArenaAllocator::GetStats() const
+{
+    FScopeLock Lock(&ArenaLock);
+
+    FFrameArenaStats Stats;
+    Stats.FrameNumber = FrameNumber.load(std::memory_order_relaxed);
+    Stats.LastFrameBytes = LastFrameBytes;
+    Stats.HighWaterBytes = HighWaterBytes;
+    Stats.HighWaterChunkBytes = HighWaterChunkBytes;
+    Stats.ReservedBytes = ReservedBytes;
+    return Stats;
+}
+
+FFrameArenaAllocator::FSlot& FFrameArenaAllocator::LockSlot()
+{
+    using namespace FrameArenaInternal;
+
+    if (ThreadSlot == INDEX_NONE)
+    {
+        ThreadSlot = static_cast<int32>(NextThreadSlot.fetch_add(1, std::memory_order_relaxed) % SlotCount);
+    }
+
+    // Slots are private to one thread unless more than SlotCount threads run, so this rarely waits
+    FSlot& Slot = Slots[ThreadSlot];
+    FAdaptiveSpinWait::Lock(Slot.LockState, Slot.LockBudget);
+
+    return Slot;
+}
+
+FFrameArenaAllocator::FChunk* FFrameArenaAllocator::AcquireChunk(uint32 InFrameNumber)
+{
+    FScopeLock Lock(&ArenaLock);
+
+    FChunk* Chunk = IdleChunks.Head;
+    if (Chunk)
+    {
+        IdleChunks.Head = Chunk->Next;
+        if (!IdleChunks.Head)
+        {
+            IdleChunks.Tail = nullptr;
+        }
+    }
+    else
+    {
+        Chunk = AllocateChunk(ChunkSize);
+        if (!Chunk)
+        {
+            return nullptr;
+        }
+    }
+
+    FFrame& Frame = GetFrame(InFrameNumber);
+    Frame.Chunks.Push(Chunk);
+    Frame.ChunkBytes += Chunk->Size;
+    return Chunk;
+}
+
+void* FFrameArenaAllocator::AllocateOversized(uint32 InFrameNumber, uint64 SizeInBytes, uint32 Alignment)
+{
+    FScopeLock Lock(&ArenaLock);
+
+    FChunk* Block = AllocateChunk(sizeof(FChunk) + SizeInBytes + Alignment);
+    if (!Block)
+    {
+        return nullptr;
+    }
+
+    FFrame& Frame = GetFrame(InFrameNumber);
+    Frame.OversizedBlocks.Push(Block);
+    Frame.ChunkBytes += Block->Size;
+    Frame.OversizedBytes += SizeInBytes;
+    return Align(Block->GetData(), Alignment);
+}
+
+FFrameArenaAllocator::FChunk* FFrameArenaAllocator::AllocateChunk(uint64 Size)
+{
+    FChunk* Chunk = static_cast<FChunk*>(FMemory::Malloc(Size, PLATFORM_CACHE_LINE_SIZE));
+    if (!Chunk)
+    {
+        UE_LOG(LogTemp, Error, TEXT("FFrameArenaAllocator::AllocateChunk - Failed to allocate %llu bytes"), Size);
+        return nullptr;
+    }
+
+    Chunk->Next = nullptr;
+    Chunk->Size = Size;
+    ReservedBytes += Size;
+
+    if (MemoryTracker)
+    {
+        MemoryTracker->TrackAllocation(Chunk, Size, CategoryName);
+    }
+
+    return Chunk;
+}
+
+uint64 FFrameArenaAllocator::FreeChunks(FChunkList& List)
+{
+    uint64 FreedBytes = 0;
+    while (FChunk* Chunk = List.Head)
+    {
+        List.Head = Chunk->Next;
+        FreedBytes += Chunk->Size;
+
+        if (MemoryTracker)
+        {
+            MemoryTracker->UntrackAllocation(Chunk);
+        }
+        FMemory::Free(Chunk);
+    }
+
+    List.Tail = nullptr;
+    ReservedBytes -= FreedBytes;
+    return FreedBytes;
+}
+
+void FFrameArenaAllocator::ResetFrame(FFrame& Frame)
+{
+    // Shared chunks go back to the idle list whole; only oversized blocks are freed one by one
+    IdleChunks.Splice(Frame.Chunks);
+    FreeChunks(Frame.OversizedBlocks);
+    Frame.ChunkBytes = 0;
+    Frame.OversizedBytes = 0;
+}
@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FrameArenaAllocator.h"
+
+/**
+ * Test program for the frame arena
+ * Checks that a double-buffered arena keeps the previous frame's allocations intact while the next
+ * frame is written, that recycling a frame frees its oversized blocks and reuses its chunks, that
+ * the finished frame's bytes are reported, and that idle chunks are released by Trim and Empty
+ */
+void TestFrameArenaAllocator()
+{
+    const FName Category(TEXT("FrameArenaTest"));
+    const int32 ValueCount = 256;
+
+    // Double-buffered validity and reset
+    {
+        FFrameArenaAllocator Arena(Category, 2, 64 * 1024);
+        const uint32 StartFrame = Arena.GetStats().FrameNumber;
+
+        int32* FirstValues = Arena.AllocateArray<int32>(ValueCount);
+        verifyf(FirstValues != nullptr, TEXT("first frame allocates"));
+        for (int32 Index = 0; Index < ValueCount; ++Index)
+        {
+            FirstValues[Index] = Index;
+        }
+
+        // Over a quarter of a chunk, so it gets a block of its own
+        const uint64 OversizedBytes = 32 * 1024;
+        verifyf(Arena.Allocate(OversizedBytes) != nullptr, TEXT("oversized requests allocate"));
+
+        Arena.BeginFrame();
+        verifyf(Arena.GetStats().LastFrameBytes == ValueCount * sizeof(int32) + OversizedBytes,
+            TEXT("the finished frame's bytes are reported"));
+
+        int32* SecondValues = Arena.AllocateArray<int32>(ValueCount);
+        verifyf(SecondValues != nullptr && SecondValues != FirstValues, TEXT("the next frame writes to a different chunk"));
+        for (int32 Index = 0; Index < ValueCount; ++Index)
+        {
+            SecondValues[Index] = -Index;
+        }
+
+        bool bFirstIntact = true;
+        for (int32 Index = 0; Index < ValueCount; ++Index)
+        {
+            bFirstIntact &= FirstValues[Index] == Index;
+        }
+        verifyf(bFirstIntact, TEXT("the previous frame's allocations stay valid for one more frame"));
+
+        const uint64 ReservedBefore = Arena.GetStats().ReservedBytes;
+        Arena.BeginFrame();
+        verifyf(Arena.GetStats().ReservedBytes < ReservedBefore, TEXT("recycling a frame frees its oversized blocks"));
+
+        int32* ThirdValues = Arena.AllocateArray<int32>(ValueCount);
+        verifyf(ThirdValues == FirstValues, TEXT("the recycled frame's chunk is reused"));
+
+        bool bSecondIntact = true;
+        for (int32 Index = 0; Index < ValueCount; ++Index)
+        {
+            bSecondIntact &= SecondValues[Index] == -Index;
+        }
+        verifyf(bSecondIntact, TEXT("recycling the oldest frame leaves the previous one intact"));
+        verifyf(Arena.GetStats().FrameNumber == StartFrame + 2, TEXT("each BeginFrame advances the frame number"));
+    }
+
+    // Single-buffered reuse and release
+    {
+        FFrameArenaAllocator Arena(Category, 1, 64 * 1024);
+
+        void* First = Arena.Allocate(64);
+        Arena.BeginFrame();
+        verifyf(Arena.Allocate(64) == First, TEXT("a single-buffered arena reuses its chunk every frame"));
+
+        // With one buffer, recycling the frame leaves its chunk idle
+        Arena.BeginFrame();
+        verifyf(Arena.Trim() > 0 && Arena.GetStats().ReservedBytes == 0, TEXT("Trim releases idle chunks"));
+
+        verifyf(Arena.Allocate(64) != nullptr, TEXT("allocation works after a trim"));
+        Arena.Empty();
+        verifyf(Arena.GetStats().ReservedBytes == 0, TEXT("Empty releases every chunk"));
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("Frame arena allocator test completed"));
+}
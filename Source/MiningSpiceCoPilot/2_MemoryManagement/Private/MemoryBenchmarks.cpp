@@ -0,0 +1,906 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SVOAllocator.h"
+#include "NarrowBandAllocator.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/ThreadSafeCounter64.h"
+#include "Misc/ScopeRWLock.h"
+#include "Containers/LockFreeList.h"
+#include "Async/Async.h"
+#include "BlockAllocationBitmap.h"
+#include "PoolAddressMap.h"
+#include "NarrowBandQuantization.h"
+#include "SizeClassAllocator.h"
+#include "MemoryTelemetry.h"
+#include "MemoryDefragmenter.h"
+#include "Math/RandomStream.h"
+#include <atomic>
+
+#if PLATFORM_LINUX
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Benchmark programs for the memory management system
+ * Each benchmark logs its results; timings are wall-clock and include result gathering
+ */
+
+/**
+ * Benchmark for pool allocator alloc/free throughput
+ * Dedicated threads allocate a burst of blocks and free them again for a fixed period, from 1 to
+ * 32 threads. Tagged allocations with debug tracking on take the pool lock on every call, as all
+ * allocations did before the magazine caches; untagged allocations go through the per-thread
+ * magazines. A second pattern hands every burst to a shared list and frees whatever another
+ * thread left there, so most frees happen on a different thread from the allocation.
+ */
+void BenchmarkPoolAllocFreeThroughput()
+{
+    const float RunSeconds = 0.5f;
+    const int32 BurstSize = 16;
+    const int32 ThreadCounts[] = { 1, 2, 4, 8, 16, 32 };
+    const FName BenchmarkTag(TEXT("AllocBenchmark"));
+
+    // Runs PoolThreads dedicated threads against a fresh pool until stopped. Returns alloc/free
+    // pairs per second across all threads.
+    auto Measure = [&](int32 PoolThreads, bool bTagged, bool bCrossThread, bool bNarrowBand) -> double
+    {
+        // Interface destructors are not public, so keep the concrete pools
+        FNarrowBandAllocator NarrowBandPool(TEXT("BenchmarkNarrowBand"), 64, 4096);
+        FSVOAllocator SVOPool(TEXT("BenchmarkSVO"), 64, 4096);
+        IPoolAllocator* Pool = bNarrowBand ? static_cast<IPoolAllocator*>(&NarrowBandPool) : static_cast<IPoolAllocator*>(&SVOPool);
+        NarrowBandPool.SetDebugTracking(bTagged);
+        SVOPool.SetDebugTracking(bTagged);
+        Pool->Initialize();
+
+        TLockFreePointerListUnordered<uint8, PLATFORM_CACHE_LINE_SIZE> Handoff;
+        std::atomic<bool> bStarted(false);
+        std::atomic<bool> bStopped(false);
+        FThreadSafeCounter64 Pairs;
+
+        TArray<TFuture<void>> Threads;
+        for (int32 Thread = 0; Thread < PoolThreads; ++Thread)
+        {
+            Threads.Add(Async(EAsyncExecution::Thread, [&]()
+            {
+                while (!bStarted.load())
+                {
+                    FPlatformProcess::Yield();
+                }
+
+                void* Burst[BurstSize];
+                int64 LocalPairs = 0;
+                while (!bStopped.load(std::memory_order_relaxed))
+                {
+                    for (int32 Index = 0; Index < BurstSize; ++Index)
+                    {
+                        Burst[Index] = bTagged ? Pool->Allocate(nullptr, BenchmarkTag) : Pool->Allocate();
+                    }
+
+                    for (int32 Index = 0; Index < BurstSize; ++Index)
+                    {
+                        void* Ptr = Burst[Index];
+                        if (bCrossThread)
+                        {
+                            // Leave this block for another thread and free one left by someone else
+                            if (Ptr)
+                            {
+                                Handoff.Push(static_cast<uint8*>(Ptr));
+                            }
+                            Ptr = Handoff.Pop();
+                        }
+
+                        if (Ptr)
+                        {
+                            Pool->Free(Ptr);
+                        }
+                    }
+
+                    LocalPairs += BurstSize;
+                }
+
+                Pairs.Add(LocalPairs);
+            }));
+        }
+
+        double StartTime = FPlatformTime::Seconds();
+        bStarted.store(true);
+        FPlatformProcess::Sleep(RunSeconds);
+        bStopped.store(true);
+        double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+        for (TFuture<void>& Thread : Threads)
+        {
+            Thread.Wait();
+        }
+
+        while (uint8* Ptr = Handoff.Pop())
+        {
+            Pool->Free(Ptr);
+        }
+        Pool->Shutdown();
+
+        return Pairs.GetValue() / ElapsedSeconds;
+    };
+
+    for (bool bNarrowBand : { false, true })
+    {
+        UE_LOG(LogTemp, Display, TEXT("%s pool alloc/free benchmark: %.1f s per run, %d-block bursts, alloc/free pairs per second in millions"),
+            bNarrowBand ? TEXT("Narrow-band") : TEXT("SVO"), RunSeconds, BurstSize);
+        UE_LOG(LogTemp, Display, TEXT("  Threads | Locked | Magazine | Locked cross-thread | Magazine cross-thread"));
+
+        for (int32 ThreadCount : ThreadCounts)
+        {
+            double LockedRate = Measure(ThreadCount, true, false, bNarrowBand);
+            double MagazineRate = Measure(ThreadCount, false, false, bNarrowBand);
+            double LockedCrossRate = Measure(ThreadCount, true, true, bNarrowBand);
+            double MagazineCrossRate = Measure(ThreadCount, false, true, bNarrowBand);
+
+            UE_LOG(LogTemp, Display, TEXT("  %7d | %6.2f | %8.2f | %19.2f | %21.2f"),
+                ThreadCount, LockedRate / 1.0e6, MagazineRate / 1.0e6, LockedCrossRate / 1.0e6, MagazineCrossRate / 1.0e6);
+        }
+    }
+}
+
+/**
+ * Benchmark for scanning block allocation state
+ * Builds a pool-sized occupancy pattern of alternating allocated and free runs, then times the
+ * scans the pool allocators run over it (allocated count, fragmentation count and a search for a
+ * contiguous free run) against the same scans over per-block metadata structs laid out as the
+ * narrow-band pool stored them before the allocation bitmap. Also reports metadata bytes per block.
+ */
+void BenchmarkBlockMetadataScan()
+{
+    const uint32 BlockCount = 1 << 20;
+    const int32 Iterations = 20;
+
+    // Per-block metadata as the narrow-band pool kept it, with the allocation flag inline
+    struct FInlineBlockMetadata
+    {
+        bool bAllocated = false;
+        FName AllocationTag;
+        TWeakObjectPtr<const UObject> RequestingObject;
+        FVector Position = FVector::ZeroVector;
+        double AllocationTime = 0.0;
+        float DistanceFromSurface = 0.0f;
+    };
+
+    FBlockAllocationBitmap Bitmap;
+    Bitmap.SetNum(BlockCount);
+    TArray<FInlineBlockMetadata> Metadata;
+    Metadata.SetNum(BlockCount);
+
+    // Runs of 1 to 64 blocks, about two thirds allocated
+    FRandomStream Random(1234);
+    for (uint32 Index = 0; Index < BlockCount;)
+    {
+        const uint32 RunLength = FMath::Min<uint32>(Random.RandRange(1, 64), BlockCount - Index);
+        const bool bAllocated = Random.FRand() < 0.67f;
+        for (uint32 RunIndex = Index; RunIndex < Index + RunLength; ++RunIndex)
+        {
+            Metadata[RunIndex].bAllocated = bAllocated;
+            if (bAllocated)
+            {
+                Bitmap.Set(RunIndex);
+            }
+        }
+        Index += RunLength;
+    }
+
+    // The run search looks for a gap longer than any in the pattern, so both scan everything
+    const uint32 RunLength = 128;
+    uint64 Checksum = 0;
+
+    double StartTime = FPlatformTime::Seconds();
+    for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+    {
+        Checksum += Bitmap.CountSet();
+        Checksum += Bitmap.CountTransitions();
+        Checksum += static_cast<uint32>(Bitmap.FindClearRun(RunLength));
+    }
+    double BitmapSeconds = FPlatformTime::Seconds() - StartTime;
+
+    StartTime = FPlatformTime::Seconds();
+    for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+    {
+        uint32 AllocatedCount = 0;
+        uint32 Transitions = 0;
+        int32 FoundRun = INDEX_NONE;
+        uint32 CurrentRun = 0;
+        for (uint32 Index = 0; Index < BlockCount; ++Index)
+        {
+            const bool bAllocated = Metadata[Index].bAllocated;
+            AllocatedCount += bAllocated ? 1 : 0;
+            Transitions += (Index > 0 && bAllocated != Metadata[Index - 1].bAllocated) ? 1 : 0;
+            CurrentRun = bAllocated ? 0 : CurrentRun + 1;
+            if (FoundRun == INDEX_NONE && CurrentRun == RunLength)
+            {
+                FoundRun = static_cast<int32>(Index - RunLength + 1);
+            }
+        }
+        Checksum -= AllocatedCount;
+        Checksum -= Transitions;
+        Checksum -= static_cast<uint32>(FoundRun);
+    }
+    double InlineSeconds = FPlatformTime::Seconds() - StartTime;
+
+    const double BlocksScanned = static_cast<double>(BlockCount) * Iterations;
+    UE_LOG(LogTemp, Display, TEXT("Block metadata scan benchmark: %u blocks, %d passes of count, fragmentation and free-run search"),
+        BlockCount, Iterations);
+    UE_LOG(LogTemp, Display, TEXT("  Allocation bitmap:  %.3f bytes per block, %.0f M blocks/s"),
+        static_cast<double>(Bitmap.GetAllocatedSize()) / BlockCount, BlocksScanned / BitmapSeconds / 1.0e6);
+    UE_LOG(LogTemp, Display, TEXT("  Inline metadata:    %.3f bytes per block, %.0f M blocks/s"),
+        static_cast<double>(Metadata.GetAllocatedSize()) / BlockCount, BlocksScanned / InlineSeconds / 1.0e6);
+    UE_LOG(LogTemp, Display, TEXT("  Results %s"), Checksum == 0 ? TEXT("match") : TEXT("DIFFER"));
+}
+
+/**
+ * Benchmark for mapping a pointer back to its pool
+ * Creates up to 100 pools, allocates blocks from each and looks up random block addresses both by
+ * asking every pool in turn under a read lock, as FMemoryPoolManager::GetPoolAllocator did before
+ * the address map, and through an FPoolAddressMap. Lookups are confirmed with OwnsPointer in both.
+ */
+void BenchmarkPoolPointerLookup()
+{
+    const int32 PoolCounts[] = { 1, 10, 100 };
+    const int32 BlocksPerPool = 256;
+    const int32 LookupCount = 1 << 20;
+
+    UE_LOG(LogTemp, Display, TEXT("Pool pointer lookup benchmark: %d lookups of random allocated blocks, M lookups/s"), LookupCount);
+    UE_LOG(LogTemp, Display, TEXT("  Pools | Linear scan | Address map | Results"));
+
+    for (int32 PoolCount : PoolCounts)
+    {
+        TArray<TUniquePtr<FSVOAllocator>> Pools;
+        TArray<void*> Blocks;
+        TArray<IPoolAllocator*> Owners;
+        FPoolAddressMap AddressMap;
+        FRWLock PoolsLock;
+
+        for (int32 PoolIndex = 0; PoolIndex < PoolCount; ++PoolIndex)
+        {
+            TUniquePtr<FSVOAllocator>& Pool = Pools.Add_GetRef(MakeUnique<FSVOAllocator>(
+                FName(TEXT("LookupBenchmark"), PoolIndex), 64, BlocksPerPool));
+            Pool->Initialize();
+
+            const void* RangeBase = nullptr;
+            uint64 RangeSize = 0;
+            if (Pool->GetReservedAddressRange(RangeBase, RangeSize))
+            {
+                AddressMap.Register(RangeBase, RangeSize, Pool.Get());
+            }
+
+            for (int32 BlockIndex = 0; BlockIndex < BlocksPerPool; ++BlockIndex)
+            {
+                if (void* Ptr = Pool->Allocate())
+                {
+                    Blocks.Add(Ptr);
+                    Owners.Add(Pool.Get());
+                }
+            }
+        }
+
+        // Same random lookup order for both methods
+        FRandomStream Random(5678);
+        TArray<int32> Order;
+        Order.SetNumUninitialized(LookupCount);
+        for (int32& Index : Order)
+        {
+            Index = Random.RandHelper(Blocks.Num());
+        }
+
+        int32 LinearMatches = 0;
+        double StartTime = FPlatformTime::Seconds();
+        for (int32 Index : Order)
+        {
+            FReadScopeLock ReadLock(PoolsLock);
+            for (const TUniquePtr<FSVOAllocator>& Pool : Pools)
+            {
+                if (Pool->OwnsPointer(Blocks[Index]))
+                {
+                    LinearMatches += (Pool.Get() == Owners[Index]) ? 1 : 0;
+                    break;
+                }
+            }
+        }
+        double LinearSeconds = FPlatformTime::Seconds() - StartTime;
+
+        int32 MapMatches = 0;
+        StartTime = FPlatformTime::Seconds();
+        for (int32 Index : Order)
+        {
+            IPoolAllocator* Pool = AddressMap.Find(Blocks[Index]);
+            if (Pool && Pool->OwnsPointer(Blocks[Index]))
+            {
+                MapMatches += (Pool == Owners[Index]) ? 1 : 0;
+            }
+        }
+        double MapSeconds = FPlatformTime::Seconds() - StartTime;
+
+        UE_LOG(LogTemp, Display, TEXT("  %5d | %11.2f | %11.2f | %s"),
+            PoolCount, LookupCount / LinearSeconds / 1.0e6, LookupCount / MapSeconds / 1.0e6,
+            (LinearMatches == LookupCount && MapMatches == LookupCount) ? TEXT("match") : TEXT("DIFFER"));
+
+        for (TUniquePtr<FSVOAllocator>& Pool : Pools)
+        {
+            Pool->Shutdown();
+        }
+    }
+}
+
+/**
+ * Benchmark for narrow-band precision tiers
+ * Fills a pool with a synthetic distance field, a sphere with a rippled surface stored as 16^3
+ * bricks of 32-bit floats, then converts a fresh copy to each tier. Reports the time to convert,
+ * the largest and RMS decoding error for samples inside the band, resident memory against the hot
+ * pool and decode throughput through the read accessor.
+ */
+void BenchmarkNarrowBandPrecisionTiers()
+{
+    const int32 BrickSize = 16;
+    const int32 BricksPerAxis = 8;
+    const int32 VolumeSize = BrickSize * BricksPerAxis;
+    const uint32 ValuesPerBrick = BrickSize * BrickSize * BrickSize;
+    const int32 BrickCount = BricksPerAxis * BricksPerAxis * BricksPerAxis;
+    const float BandWidth = 3.0f;
+
+    // Brick-major samples of the distance to a rippled sphere, in voxels
+    TArray<float> Samples;
+    Samples.SetNumUninitialized(ValuesPerBrick * BrickCount);
+    const FVector Center(VolumeSize * 0.5f);
+    for (int32 BrickIndex = 0; BrickIndex < BrickCount; ++BrickIndex)
+    {
+        const FIntVector BrickOrigin(BrickIndex % BricksPerAxis, (BrickIndex / BricksPerAxis) % BricksPerAxis, BrickIndex / (BricksPerAxis * BricksPerAxis));
+        for (uint32 Index = 0; Index < ValuesPerBrick; ++Index)
+        {
+            const FVector Position = FVector(BrickOrigin * BrickSize) + FVector(Index % BrickSize, (Index / BrickSize) % BrickSize, Index / (BrickSize * BrickSize));
+            const FVector Offset = Position - Center;
+            const float Ripple = 2.0f * FMath::Sin(Offset.X * 0.3f) * FMath::Cos(Offset.Y * 0.2f);
+            Samples[BrickIndex * ValuesPerBrick + Index] = static_cast<float>(Offset.Size()) - VolumeSize * 0.3f + Ripple;
+        }
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("Narrow-band precision tier benchmark: %d bricks of %u samples, band width %.1f voxels"),
+        BrickCount, ValuesPerBrick, BandWidth);
+    UE_LOG(LogTemp, Display, TEXT("  Tier    | Convert ms | Max error | RMS error | Bound    | Resident KB | Saved | Decode M values/s"));
+
+    uint64 HotResidentBytes = 0;
+    const EMemoryTier Tiers[] = { EMemoryTier::Hot, EMemoryTier::Warm, EMemoryTier::Cold, EMemoryTier::Archive };
+    const TCHAR* TierNames[] = { TEXT("Hot"), TEXT("Warm"), TEXT("Cold"), TEXT("Archive") };
+
+    for (int32 TierIndex = 0; TierIndex < UE_ARRAY_COUNT(Tiers); ++TierIndex)
+    {
+        FNarrowBandAllocator Pool(TEXT("PrecisionBenchmark"), ValuesPerBrick * sizeof(float), BrickCount, EMemoryAccessPattern::SDFOperation, false);
+        Pool.SetBandWidth(BandWidth);
+        Pool.Initialize();
+
+        TArray<void*> Bricks;
+        for (int32 BrickIndex = 0; BrickIndex < BrickCount; ++BrickIndex)
+        {
+            void* Ptr = Pool.Allocate();
+            Pool.WriteValues(Ptr, 0, ValuesPerBrick, &Samples[BrickIndex * ValuesPerBrick]);
+            Bricks.Add(Ptr);
+        }
+
+        double StartTime = FPlatformTime::Seconds();
+        Pool.SetPrecisionTier(Tiers[TierIndex]);
+        const double ConvertSeconds = FPlatformTime::Seconds() - StartTime;
+
+        // Decode everything once for timing, then again to measure the error against the source
+        TArray<float> Decoded;
+        Decoded.SetNumUninitialized(ValuesPerBrick);
+        StartTime = FPlatformTime::Seconds();
+        for (void* Ptr : Bricks)
+        {
+            Pool.ReadValues(Ptr, 0, ValuesPerBrick, Decoded.GetData());
+        }
+        const double DecodeSeconds = FPlatformTime::Seconds() - StartTime;
+
+        double MaxError = 0.0;
+        double SquaredError = 0.0;
+        int64 BandSamples = 0;
+        for (int32 BrickIndex = 0; BrickIndex < BrickCount; ++BrickIndex)
+        {
+            Pool.ReadValues(Bricks[BrickIndex], 0, ValuesPerBrick, Decoded.GetData());
+            for (uint32 Index = 0; Index < ValuesPerBrick; ++Index)
+            {
+                const float Expected = Samples[BrickIndex * ValuesPerBrick + Index];
+                if (FMath::Abs(Expected) <= BandWidth)
+                {
+                    const double Error = FMath::Abs(Decoded[Index] - Expected);
+                    MaxError = FMath::Max(MaxError, Error);
+                    SquaredError += Error * Error;
+                    BandSamples++;
+                }
+            }
+        }
+
+        const uint64 ResidentBytes = Pool.GetResidentBytes();
+        if (TierIndex == 0)
+        {
+            HotResidentBytes = ResidentBytes;
+        }
+
+        UE_LOG(LogTemp, Display, TEXT("  %-7s | %10.2f | %9.5f | %9.5f | %8.5f | %11llu | %4.0f%% | %17.0f"),
+            TierNames[TierIndex], ConvertSeconds * 1000.0, MaxError, FMath::Sqrt(SquaredError / FMath::Max<int64>(BandSamples, 1)),
+            FNarrowBandQuantization::GetMaxError(Tiers[TierIndex], BandWidth), ResidentBytes / 1024,
+            100.0 * (1.0 - static_cast<double>(ResidentBytes) / FMath::Max<uint64>(HotResidentBytes, 1)),
+            static_cast<double>(ValuesPerBrick) * BrickCount / DecodeSeconds / 1.0e6);
+
+        for (void* Ptr : Bricks)
+        {
+            Pool.Free(Ptr);
+        }
+        Pool.Shutdown();
+    }
+}
+
+/**
+ * Counts data TLB load misses on the calling thread through perf events
+ * Only available on Linux, and only where perf_event_paranoid lets the process count its own
+ * user-space events; elsewhere IsAvailable returns false.
+ */
+class FTLBMissCounter
+{
+public:
+    FTLBMissCounter()
+        : Descriptor(-1)
+    {
+#if PLATFORM_LINUX
+        perf_event_attr Attributes;
+        FMemory::Memzero(Attributes);
+        Attributes.type = PERF_TYPE_HW_CACHE;
+        Attributes.size = sizeof(Attributes);
+        Attributes.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        Attributes.disabled = 1;
+        Attributes.exclude_kernel = 1;
+        Attributes.exclude_hv = 1;
+        Descriptor = static_cast<int32>(syscall(__NR_perf_event_open, &Attributes, 0, -1, -1, 0));
+#endif
+    }
+
+    ~FTLBMissCounter()
+    {
+#if PLATFORM_LINUX
+        if (Descriptor >= 0)
+        {
+            close(Descriptor);
+        }
+#endif
+    }
+
+    bool IsAvailable() const { return Descriptor >= 0; }
+
+    void Start()
+    {
+#if PLATFORM_LINUX
+        if (Descriptor >= 0)
+        {
+            ioctl(Descriptor, PERF_EVENT_IOC_RESET, 0);
+            ioctl(Descriptor, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    /** Stops counting and returns the misses since Start, or 0 if unavailable */
+    uint64 Stop()
+    {
+        uint64 Count = 0;
+#if PLATFORM_LINUX
+        if (Descriptor >= 0)
+        {
+            ioctl(Descriptor, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(Descriptor, &Count, sizeof(Count)) != sizeof(Count))
+            {
+                Count = 0;
+            }
+        }
+#endif
+        return Count;
+    }
+
+private:
+    int32 Descriptor;
+};
+
+/**
+ * Benchmark for pool page backing
+ * First sweeps a 128 MB octree pool in random block order with huge pages off and on, reporting
+ * nanoseconds per access as a TLB-miss proxy and, where perf events are available, data TLB load
+ * misses. Then fills a 64 MB hot narrow-band pool, frees every other segment, shrinks it and
+ * reports process resident memory before and after, with eager and lazy release, along with the
+ * time to allocate the freed blocks again.
+ */
+void BenchmarkPoolPageBacking()
+{
+    const uint32 NodeSize = 64;
+    const uint32 NodeCount = 2 * 1024 * 1024;
+    const int32 SweepCount = 4;
+    FTLBMissCounter TLBMisses;
+
+    UE_LOG(LogTemp, Display, TEXT("Pool page backing benchmark: random sweep of %u nodes of %u bytes, %s"),
+        NodeCount, NodeSize, TLBMisses.IsAvailable() ? TEXT("dTLB misses from perf events") : TEXT("perf events unavailable"));
+    UE_LOG(LogTemp, Display, TEXT("  Huge pages | Applied | ns/access | dTLB misses/access"));
+
+    for (bool bHugePages : { false, true })
+    {
+        FSVOAllocator Pool(TEXT("PageBackingBenchmark"), NodeSize, NodeCount, EMemoryAccessPattern::OctreeTraversal, false);
+        const bool bApplied = Pool.SetHugePages(bHugePages);
+        Pool.Initialize();
+
+        TArray<void*> Nodes;
+        Nodes.Reserve(NodeCount);
+        for (uint32 Index = 0; Index < NodeCount; ++Index)
+        {
+            void* Ptr = Pool.Allocate();
+            if (!Ptr)
+            {
+                break;
+            }
+            *static_cast<uint64*>(Ptr) = Index;
+            Nodes.Add(Ptr);
+        }
+
+        // Visit nodes in a fixed random order so every access is likely a different page
+        FRandomStream Random(1234);
+        for (int32 Index = Nodes.Num() - 1; Index > 0; --Index)
+        {
+            Nodes.Swap(Index, Random.RandRange(0, Index));
+        }
+
+        uint64 Checksum = 0;
+        TLBMisses.Start();
+        const double StartTime = FPlatformTime::Seconds();
+        for (int32 Sweep = 0; Sweep < SweepCount; ++Sweep)
+        {
+            for (void* Ptr : Nodes)
+            {
+                uint64& Value = *static_cast<uint64*>(Ptr);
+                Checksum += Value;
+                Value += 1;
+            }
+        }
+        const double Seconds = FPlatformTime::Seconds() - StartTime;
+        const uint64 Misses = TLBMisses.Stop();
+
+        const double Accesses = static_cast<double>(Nodes.Num()) * SweepCount;
+        UE_LOG(LogTemp, Display, TEXT("  %-10s | %-7s | %9.2f | %18s  (checksum %llu)"),
+            bHugePages ? TEXT("On") : TEXT("Off"), bApplied ? TEXT("Yes") : TEXT("No"), Seconds * 1.0e9 / Accesses,
+            TLBMisses.IsAvailable() ? *FString::Printf(TEXT("%.3f"), Misses / Accesses) : TEXT("n/a"), Checksum);
+
+        for (void* Ptr : Nodes)
+        {
+            Pool.Free(Ptr);
+        }
+        Pool.Shutdown();
+    }
+
+    const uint32 BrickBytes = 64 * 1024;
+    const uint32 BrickCount = 1024;
+
+    UE_LOG(LogTemp, Display, TEXT("  Release | RSS before MB | RSS after MB | Pool resident MB | Released blocks | Realloc ms"));
+
+    for (bool bLazy : { false, true })
+    {
+        FNarrowBandAllocator Pool(TEXT("PageReleaseBenchmark"), BrickBytes, BrickCount, EMemoryAccessPattern::SDFOperation, false);
+        Pool.SetLazySegmentRelease(bLazy);
+        Pool.Initialize();
+
+        TArray<void*> Bricks;
+        for (uint32 Index = 0; Index < BrickCount; ++Index)
+        {
+            void* Ptr = Pool.Allocate();
+            if (!Ptr)
+            {
+                break;
+            }
+            FMemory::Memset(Ptr, 0x3F, BrickBytes);
+            Bricks.Add(Ptr);
+        }
+
+        // Free every other segment, so all but the last freed segment sit between live ones
+        const uint32 BricksPerSegment = FMath::Max<uint32>(FSegmentedPoolStorage::DefaultSegmentSize / BrickBytes, 1);
+        TArray<void*> Freed;
+        for (int32 Index = 0; Index < Bricks.Num(); ++Index)
+        {
+            if ((Index / BricksPerSegment) % 2 == 1)
+            {
+                Pool.Free(Bricks[Index]);
+                Freed.Add(Bricks[Index]);
+            }
+        }
+
+        const uint64 RSSBefore = FPlatformMemory::GetStats().UsedPhysical;
+        const uint32 Released = Pool.Shrink(MAX_uint32);
+        const uint64 RSSAfter = FPlatformMemory::GetStats().UsedPhysical;
+        const uint64 ResidentBytes = Pool.GetResidentBytes();
+
+        // Allocating again recommits the released segments before growing
+        const double StartTime = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < Freed.Num(); ++Index)
+        {
+            if (void* Ptr = Pool.Allocate())
+            {
+                FMemory::Memset(Ptr, 0x3F, BrickBytes);
+            }
+        }
+        const double ReallocSeconds = FPlatformTime::Seconds() - StartTime;
+
+        UE_LOG(LogTemp, Display, TEXT("  %-7s | %13.1f | %12.1f | %16.1f | %15u | %10.2f"),
+            bLazy ? TEXT("Lazy") : TEXT("Eager"), RSSBefore / (1024.0 * 1024.0), RSSAfter / (1024.0 * 1024.0),
+            ResidentBytes / (1024.0 * 1024.0), Released, ReallocSeconds * 1000.0);
+
+        Pool.Shutdown();
+    }
+}
+
+/**
+ * Benchmark for general-purpose allocations
+ * Dedicated threads allocate bursts of mixed-size blocks, mostly under 256 bytes with a tail up to
+ * 8 KB as SDF scratch buffers and operation descriptors are, and free them again for a fixed
+ * period. Compares the size-class slabs with the path FMemoryPoolManager::Allocate took before
+ * them, the system allocator plus a telemetry record per allocation, and with the system
+ * allocator alone.
+ */
+void BenchmarkGeneralAllocation()
+{
+    const float RunSeconds = 0.5f;
+    const int32 BurstSize = 64;
+    const int32 ThreadCounts[] = { 1, 2, 4, 8, 16 };
+    const FName BenchmarkCategory(TEXT("General"));
+
+    enum class EAllocationPath
+    {
+        TrackedMalloc,
+        Malloc,
+        SizeClass
+    };
+
+    // Sizes repeat per thread; three quarters small, the rest spread up to 8 KB
+    TArray<uint32> Sizes;
+    FRandomStream Random(4321);
+    for (int32 Index = 0; Index < BurstSize; ++Index)
+    {
+        Sizes.Add(Random.FRand() < 0.75f ? Random.RandRange(8, 256) : Random.RandRange(257, 8192));
+    }
+
+    // Runs AllocationThreads dedicated threads until stopped. Returns alloc/free pairs per second
+    // across all threads.
+    auto Measure = [&](int32 AllocationThreads, EAllocationPath Path) -> double
+    {
+        FMemoryTelemetry Telemetry;
+        Telemetry.Initialize();
+        FSizeClassAllocator SizeClassAllocator;
+        SizeClassAllocator.Initialize();
+
+        std::atomic<bool> bStarted(false);
+        std::atomic<bool> bStopped(false);
+        FThreadSafeCounter64 Pairs;
+
+        TArray<TFuture<void>> Threads;
+        for (int32 Thread = 0; Thread < AllocationThreads; ++Thread)
+        {
+            Threads.Add(Async(EAsyncExecution::Thread, [&]()
+            {
+                while (!bStarted.load())
+                {
+                    FPlatformProcess::Yield();
+                }
+
+                void* Burst[BurstSize];
+                int64 LocalPairs = 0;
+                while (!bStopped.load(std::memory_order_relaxed))
+                {
+                    for (int32 Index = 0; Index < BurstSize; ++Index)
+                    {
+                        if (Path == EAllocationPath::SizeClass)
+                        {
+                            Burst[Index] = SizeClassAllocator.Allocate(Sizes[Index], 16);
+                        }
+                        else
+                        {
+                            Burst[Index] = FMemory::Malloc(Sizes[Index], 16);
+                            if (Path == EAllocationPath::TrackedMalloc)
+                            {
+                                Telemetry.TrackAllocation(Burst[Index], Sizes[Index], BenchmarkCategory);
+                            }
+                        }
+                    }
+
+                    for (int32 Index = 0; Index < BurstSize; ++Index)
+                    {
+                        if (Path == EAllocationPath::SizeClass)
+                        {
+                            SizeClassAllocator.Free(Burst[Index]);
+                        }
+                        else
+                        {
+                            if (Path == EAllocationPath::TrackedMalloc)
+                            {
+                                Telemetry.UntrackAllocation(Burst[Index]);
+                            }
+                            FMemory::Free(Burst[Index]);
+                        }
+                    }
+
+                    LocalPairs += BurstSize;
+                }
+
+                Pairs.Add(LocalPairs);
+            }));
+        }
+
+        double StartTime = FPlatformTime::Seconds();
+        bStarted.store(true);
+        FPlatformProcess::Sleep(RunSeconds);
+        bStopped.store(true);
+        double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+        for (TFuture<void>& Thread : Threads)
+        {
+            Thread.Wait();
+        }
+
+        SizeClassAllocator.Shutdown();
+        Telemetry.Shutdown();
+
+        return Pairs.GetValue() / ElapsedSeconds;
+    };
+
+    UE_LOG(LogTemp, Display, TEXT("General allocation benchmark: %.1f s per run, %d-allocation bursts, alloc/free pairs per second in millions"),
+        RunSeconds, BurstSize);
+    UE_LOG(LogTemp, Display, TEXT("  Threads | Malloc + telemetry | Malloc | Size classes"));
+
+    for (int32 ThreadCount : ThreadCounts)
+    {
+        double TrackedRate = Measure(ThreadCount, EAllocationPath::TrackedMalloc);
+        double MallocRate = Measure(ThreadCount, EAllocationPath::Malloc);
+        double SizeClassRate = Measure(ThreadCount, EAllocationPath::SizeClass);
+
+        UE_LOG(LogTemp, Display, TEXT("  %7d | %18.2f | %6.2f | %12.2f"),
+            ThreadCount, TrackedRate / 1.0e6, MallocRate / 1.0e6, SizeClassRate / 1.0e6);
+    }
+}
+
+/**
+ * Benchmark for defragmenting pools whose blocks are referenced from elsewhere
+ * Fills an SVO pool, frees every other block and compacts it. With pointers, each referrer is
+ * registered with an FMemoryDefragmenter and every block moved by MoveNextFragmentedAllocation is
+ * followed by UpdateReferences. With handles, referrers hold copies of the handle and each move
+ * rewrites one table slot, either block by block or in one Defragment pass. Referrer registration
+ * is not timed. Blocks hold their own allocation number, which is checked through every handle
+ * after compaction.
+ */
+void BenchmarkDefragmentHandles()
+{
+    const int32 BlockCounts[] = { 4096, 65536 };
+    const int32 ReferrerCounts[] = { 1, 4 };
+    const uint32 BenchmarkBlockSize = 64;
+
+    // Allocates BlockCount blocks with handles and frees every other one
+    auto MakeHandlePool = [BenchmarkBlockSize](int32 BlockCount, TArray<uint32>& OutHandles)
+    {
+        TUniquePtr<FSVOAllocator> Pool = MakeUnique<FSVOAllocator>(FName(TEXT("DefragBenchmark")), BenchmarkBlockSize, BlockCount);
+        Pool->Initialize();
+
+        TArray<uint32> Handles;
+        for (int32 Index = 0; Index < BlockCount; ++Index)
+        {
+            const uint32 Handle = Pool->AllocateHandle();
+            *static_cast<int32*>(Pool->ResolveHandle(Handle)) = Index;
+            Handles.Add(Handle);
+        }
+
+        OutHandles.Reset();
+        for (int32 Index = 0; Index < BlockCount; ++Index)
+        {
+            if (Index % 2 == 0)
+            {
+                Pool->FreeHandle(Handles[Index]);
+            }
+            else
+            {
+                OutHandles.Add(Handles[Index]);
+            }
+        }
+
+        return Pool;
+    };
+
+    // Checks that every surviving handle still reaches its block's contents
+    auto CheckHandles = [](const FSVOAllocator& Pool, const TArray<uint32>& Handles)
+    {
+        for (int32 Index = 0; Index < Handles.Num(); ++Index)
+        {
+            const int32* Block = static_cast<const int32*>(Pool.ResolveHandle(Handles[Index]));
+            if (!Block || *Block != Index * 2 + 1)
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    UE_LOG(LogTemp, Display, TEXT("Defragmentation benchmark: %u-byte blocks, every other block freed, ms to compact"), BenchmarkBlockSize);
+    UE_LOG(LogTemp, Display, TEXT("  Blocks | Referrers | Pointers + reference updates | Handles, block by block | Handles, one pass | Results"));
+
+    for (int32 BlockCount : BlockCounts)
+    {
+        for (int32 ReferrerCount : ReferrerCounts)
+        {
+            // Pointers: referrers are registered against each surviving block
+            double PointerMs = 0.0;
+            {
+                FSVOAllocator Pool(FName(TEXT("DefragBenchmark")), BenchmarkBlockSize, BlockCount);
+                Pool.Initialize();
+                FMemoryDefragmenter Defragmenter(nullptr);
+
+                TArray<void*> Blocks;
+                for (int32 Index = 0; Index < BlockCount; ++Index)
+                {
+                    Blocks.Add(Pool.Allocate());
+                }
+
+                TArray<void*> Referrers;
+                Referrers.SetNumZeroed((BlockCount / 2) * ReferrerCount);
+                int32 ReferrerIndex = 0;
+                for (int32 Index = 0; Index < BlockCount; ++Index)
+                {
+                    if (Index % 2 == 0)
+                    {
+                        Pool.Free(Blocks[Index]);
+                        continue;
+                    }
+
+                    for (int32 Referrer = 0; Referrer < ReferrerCount; ++Referrer)
+                    {
+                        Referrers[ReferrerIndex] = Blocks[Index];
+                        Defragmenter.RegisterAllocationReferences(&Referrers[ReferrerIndex], { Blocks[Index] });
+                        ReferrerIndex++;
+                    }
+                }
+
+                void* OldPtr = nullptr;
+                void* NewPtr = nullptr;
+                uint64 MovedSize = 0;
+                double StartTime = FPlatformTime::Seconds();
+                while (Pool.MoveNextFragmentedAllocation(OldPtr, NewPtr, MovedSize))
+                {
+                    Defragmenter.UpdateReferences(OldPtr, NewPtr);
+                }
+                PointerMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+                Pool.Shutdown();
+            }
+
+            // Handles moved one block at a time, as the defragmenter's incremental path does
+            TArray<uint32> Handles;
+            TUniquePtr<FSVOAllocator> IncrementalPool = MakeHandlePool(BlockCount, Handles);
+            void* OldPtr = nullptr;
+            void* NewPtr = nullptr;
+            uint64 MovedSize = 0;
+            double StartTime = FPlatformTime::Seconds();
+            while (IncrementalPool->MoveNextFragmentedAllocation(OldPtr, NewPtr, MovedSize))
+            {
+            }
+            const double IncrementalMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+            const bool bIncrementalValid = CheckHandles(*IncrementalPool, Handles);
+            IncrementalPool->Shutdown();
+
+            // Handles compacted in one pass
+            TUniquePtr<FSVOAllocator> CompactPool = MakeHandlePool(BlockCount, Handles);
+            StartTime = FPlatformTime::Seconds();
+            CompactPool->Defragment(1000.0f);
+            const double CompactMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+            const bool bCompactValid = CheckHandles(*CompactPool, Handles) && CompactPool->GetStats().FragmentationPercent < 1.0f;
+            CompactPool->Shutdown();
+
+            UE_LOG(LogTemp, Display, TEXT("  %6d | %9d | %28.3f | %23.3f | %17.3f | %s"),
+                BlockCount, ReferrerCount, PointerMs, IncrementalMs, CompactMs,
+                (bIncrementalValid && bCompactValid) ? TEXT("valid") : TEXT("BROKEN"));
+        }
+    }
+}
@@ -8,6 +8,7 @@
 #include "MemoryTelemetry.h"
 #include "MemoryDefragmenter.h"
 #include "CompressionUtility.h"
+#include "NumaMemory.h"
 #include "HAL/PlatformMemory.h"
 #include "HAL/LowLevelMemTracker.h"
 #include "HAL/MallocBinned.h"
@@ -18,13 +19,12 @@
 #include "CoreServiceLocator.h"
 #include "Interfaces/IMemoryManager.h"
 
-// Add FPlatformMemory::GetNumNUMANodes fix
+// Node count as seen by pool placement, which reads it from the OS
 namespace
 {
     int32 GetNumNUMANodes()
     {
-        // Simple fallback as UE 5.5 API might have changed
-        return 1;
+        return FNumaMemory::GetNodeCount();
     }
 
     bool SupportsSSE4_1()
@@ -49,6 +49,7 @@ static const FName CATEGORY_NARROW_BAND(TEXT("NarrowBand"));
 static const FName CATEGORY_MATERIAL_CHANNELS(TEXT("MaterialChannels"));
 static const FName CATEGORY_MESH_DATA(TEXT("MeshData"));
 static const FName CATEGORY_GENERAL(TEXT("General"));
+static const FName CATEGORY_FRAME_ARENA(TEXT("FrameArena"));
 
 // Default memory budgets - these can be adjusted through configuration
 static constexpr uint64 DEFAULT_BUDGET_SVO_NODES = 256 * 1024 * 1024;       // 256 MB
@@ -71,6 +72,8 @@ IMemoryManager& IMemoryManager::Get()
 FMemoryPoolManager::FMemoryPoolManager()
     : MemoryTracker(nullptr)
     , Defragmenter(nullptr)
+    , MappedRangeEpoch(0)
+    , FrameArena(CATEGORY_FRAME_ARENA, 2)
     , bIsInitialized(false)
     , bNUMAAwarenessEnabled(false)
     , NUMAPreferredNode(0)
@@ -110,6 +113,9 @@ bool FMemoryPoolManager::Initialize()
     // Register for memory warnings
     FCoreDelegates::GetMemoryTrimDelegate().AddRaw(this, &FMemoryPoolManager::OnMemoryWarning);
 
+    // The frame arena's frames follow the engine's
+    FCoreDelegates::OnBeginFrame.AddRaw(this, &FMemoryPoolManager::OnBeginFrame);
+
     // Check platform capabilities
     if (!IsSupported())
     {
@@ -161,6 +167,15 @@ bool FMemoryPoolManager::Initialize()
         return false;
     }
 
+    // Small general allocations fall back to the system allocator if the slabs cannot be reserved
+    if (!SizeClassAllocator.Initialize())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("FMemoryPoolManager::Initialize - Size-class allocator unavailable, small allocations will use the system allocator"));
+    }
+    
+    // Frame arena chunks show up as a single tracker category
+    FrameArena.SetMemoryTracker(MemoryTracker);
+    
     // Set default NUMA policy based on system configuration
     SetNUMAPolicy(GetNumNUMANodes() > 1);
     
@@ -181,12 +196,16 @@ void FMemoryPoolManager::Shutdown()
         return;
     }
 
-    // Unregister from memory warnings
+    // Unregister from memory warnings and frame starts
     FCoreDelegates::GetMemoryTrimDelegate().RemoveAll(this);
+    FCoreDelegates::OnBeginFrame.RemoveAll(this);
 
     // Release all pools
     {
         FWriteScopeLock WriteLock(PoolsLock);
+        PoolAddressMap.Empty();
+        MappedPoolRanges.Empty();
+        UnmappedPoolCount.Reset();
         Pools.Empty();
     }
 
@@ -196,6 +215,14 @@ void FMemoryPoolManager::Shutdown()
         Buffers.Empty();
     }
 
+    // Release the size-class slabs; blocks still allocated from them become invalid, and the
+    // allocator drops any later free of them instead of passing it on to FMemory::Free
+    SizeClassAllocator.Shutdown();
+
+    // Release the frame arena before its tracker goes away
+    FrameArena.Empty();
+    FrameArena.SetMemoryTracker(nullptr);
+
     // Clean up memory tracker
     if (MemoryTracker)
     {
@@ -274,6 +301,18 @@ bool FMemoryPoolManager::SetNUMAPolicy(bool bUseNUMAAwareness, int32 PreferredNo
         UE_LOG(LogTemp, Verbose, TEXT("FMemoryPoolManager::SetNUMAPolicy - NUMA awareness disabled"));
     }
     
+    // Existing pools follow the new policy; binding migrates the pages they already hold
+    {
+        FReadScopeLock ReadLock(PoolsLock);
+        for (const TPair<FName, TSharedPtr<IPoolAllocator>>& Pair : Pools)
+        {
+            if (Pair.Value.IsValid())
+            {
+                Pair.Value->SetNumaNode(bNUMAAwarenessEnabled ? NUMAPreferredNode : INDEX_NONE);
+            }
+        }
+    }
+    
     return true;
 }
 
@@ -341,6 +380,12 @@ IPoolAllocator* FMemoryPoolManager::CreatePool(
             break;
     }
     
+    // Place the pool before its memory is committed, so first-touch placement covers it too
+    if (bNUMAAwarenessEnabled)
+    {
+        NewPool->SetNumaNode(NUMAPreferredNode);
+    }
+    
     // Initialize the pool
     if (!NewPool->Initialize())
     {
@@ -353,6 +398,9 @@ IPoolAllocator* FMemoryPoolManager::CreatePool(
     {
         FWriteScopeLock WriteLock(PoolsLock);
         Pools.Add(PoolName, NewPool);
+        
+        // Map the pool's reserved range so pointer lookups can find it by address
+        UpdatePoolAddressMap();
     }
     
     UE_LOG(LogTemp, Log, TEXT("FMemoryPoolManager::CreatePool - Created pool '%s' (BlockSize=%u, BlockCount=%u)"),
@@ -566,6 +614,13 @@ void* FMemoryPoolManager::Allocate(uint64 SizeInBytes, uint32 Alignment)
     check(FMath::IsPowerOfTwo(Alignment));
     check(Alignment >= 1);
     
+    // Small requests come from the size-class slabs through per-thread magazines. They are not
+    // tracked one by one; GetMemoryUsage adds the slab allocator's aggregate counts instead.
+    if (void* SmallMemory = SizeClassAllocator.Allocate(SizeInBytes, Alignment))
+    {
+        return SmallMemory;
+    }
+    
     // Allocate memory from the system allocator
     void* Memory = FMemory::Malloc(SizeInBytes, Alignment);
     
@@ -585,6 +640,12 @@ void FMemoryPoolManager::Free(void* Ptr)
         return;
     }
     
+    // Slab blocks were never tracked
+    if (SizeClassAllocator.Free(Ptr))
+    {
+        return;
+    }
+    
     // Untrack the allocation if memory tracker is available
     if (MemoryTracker && IsInitialized())
     {
@@ -647,7 +708,14 @@ uint64 FMemoryPoolManager::GetMemoryUsage(const FName& CategoryName) const
         return 0;
     }
 
-    return MemoryTracker->GetMemoryUsage(CategoryName);
+    // Size-class blocks are untracked general allocations, counted from the slab allocator
+    uint64 SizeClassBytes = 0;
+    if (CategoryName.IsNone() || CategoryName == CATEGORY_GENERAL)
+    {
+        SizeClassBytes = SizeClassAllocator.GetAllocatedBytes();
+    }
+
+    return MemoryTracker->GetMemoryUsage(CategoryName) + SizeClassBytes;
 }
 
 void FMemoryPoolManager::RegisterAllocation(void* Ptr, uint64 SizeInBytes, const FName& CategoryName, const FName& AllocationName)
@@ -798,7 +866,31 @@ FMemoryStats FMemoryPoolManager::GetDetailedMemoryStats() const
         return FMemoryStats();
     }
 
-    return MemoryTracker->GetMemoryStats();
+    FMemoryStats Stats = MemoryTracker->GetMemoryStats();
+
+    // Size-class blocks are untracked general allocations, counted from the slab allocator as in
+    // GetMemoryUsage, so budget enforcement and reports see them too
+    TArray<FSizeClassAllocator::FSizeClassStats> SizeClassStats;
+    SizeClassAllocator.GetSizeClassStats(SizeClassStats);
+
+    uint64 SizeClassBytes = 0;
+    uint64 SizeClassBlocks = 0;
+    for (const FSizeClassAllocator::FSizeClassStats& ClassStats : SizeClassStats)
+    {
+        SizeClassBytes += ClassStats.AllocatedBlocks * ClassStats.BlockSize;
+        SizeClassBlocks += ClassStats.AllocatedBlocks;
+    }
+
+    if (SizeClassBlocks > 0)
+    {
+        Stats.TotalAllocatedBytes += SizeClassBytes;
+        Stats.AllocationCount += SizeClassBlocks;
+        Stats.PeakMemoryUsage = FMath::Max(Stats.PeakMemoryUsage, Stats.TotalAllocatedBytes);
+        Stats.UsageByCategory.FindOrAdd(CATEGORY_GENERAL) += SizeClassBytes;
+        Stats.AllocationCountByCategory.FindOrAdd(CATEGORY_GENERAL) += SizeClassBlocks;
+    }
+
+    return Stats;
 }
 
 FSVOSDFMemoryMetrics FMemoryPoolManager::GetSVOSDFMemoryMetrics() const
@@ -1068,6 +1160,11 @@ uint64 FMemoryPoolManager::ReleaseUnusedResources(float MaxTimeMs)
     return 0; // Report no freed memory since we don't directly track it here
 }
 
+void FMemoryPoolManager::OnBeginFrame()
+{
+    FrameArena.BeginFrame();
+}
+
 void FMemoryPoolManager::OnMemoryWarning()
 {
     if (!bIsInitialized)
@@ -1099,6 +1196,16 @@ TArray<FName> FMemoryPoolManager::GetPoolNames() const
     return Names;
 }
 
+void FMemoryPoolManager::GetPoolCommittedRanges(TArray<TPair<const void*, uint64>>& OutRanges) const
+{
+    FReadScopeLock ReadLock(PoolsLock);
+    
+    for (const auto& Pair : Pools)
+    {
+        Pair.Value->GetCommittedRanges(OutRanges);
+    }
+}
+
 bool FMemoryPoolManager::UpdatePointerReference(void* OldPtr, void* NewPtr, uint64 Size)
 {
     if (!OldPtr || !NewPtr || Size == 0)
@@ -1141,7 +1248,26 @@ IPoolAllocator* FMemoryPoolManager::GetPoolAllocator(const void* Ptr) const
         return nullptr;
     }
 
-    // Try to find a pool that owns this pointer
+    // A pool initialized or shut down since the map was built may have moved its range
+    if (MappedRangeEpoch.load(std::memory_order_acquire) != FSegmentedPoolStorage::GetAddressRangeEpoch())
+    {
+        FWriteScopeLock WriteLock(PoolsLock);
+        UpdatePoolAddressMap();
+    }
+    
+    // Pools with a reserved range are found from the address alone, without the pools lock.
+    // Ranges never overlap, so a mapped address cannot belong to any other pool.
+    if (IPoolAllocator* MappedPool = PoolAddressMap.Find(Ptr))
+    {
+        return MappedPool->OwnsPointer(Ptr) ? MappedPool : nullptr;
+    }
+    
+    if (UnmappedPoolCount.GetValue() == 0)
+    {
+        return nullptr;
+    }
+    
+    // Fall back to asking the pools that could not be mapped
     FReadScopeLock ReadLock(PoolsLock);
     for (const auto& Pair : Pools)
     {
@@ -1154,6 +1280,57 @@ IPoolAllocator* FMemoryPoolManager::GetPoolAllocator(const void* Ptr) const
     return nullptr;
 }
 
+void FMemoryPoolManager::UpdatePoolAddressMap() const
+{
+    // Read the epoch before the ranges, so a range that changes during the update is caught by
+    // the next lookup
+    const uint32 Epoch = FSegmentedPoolStorage::GetAddressRangeEpoch();
+    
+    // Unmap every moved range before mapping any new one, as a released range may have been
+    // reserved again by another pool
+    TArray<TPair<IPoolAllocator*, FMappedPoolRange>> MovedPools;
+    for (const auto& Pair : Pools)
+    {
+        IPoolAllocator* Pool = Pair.Value.Get();
+        FMappedPoolRange Current;
+        if (!Pool->GetReservedAddressRange(Current.Base, Current.Size))
+        {
+            Current = FMappedPoolRange();
+        }
+        
+        FMappedPoolRange& Mapped = MappedPoolRanges.FindOrAdd(Pool);
+        if (Mapped.Base != Current.Base || Mapped.Size != Current.Size)
+        {
+            if (Mapped.Base)
+            {
+                PoolAddressMap.Unregister(Mapped.Base, Mapped.Size, Pool);
+                Mapped = FMappedPoolRange();
+            }
+            if (Current.Base)
+            {
+                MovedPools.Emplace(Pool, Current);
+            }
+        }
+    }
+    
+    for (const TPair<IPoolAllocator*, FMappedPoolRange>& Moved : MovedPools)
+    {
+        if (PoolAddressMap.Register(Moved.Value.Base, Moved.Value.Size, Moved.Key))
+        {
+            MappedPoolRanges[Moved.Key] = Moved.Value;
+        }
+    }
+    
+    int32 UnmappedCount = 0;
+    for (const auto& Pair : MappedPoolRanges)
+    {
+        UnmappedCount += Pair.Value.Base ? 0 : 1;
+    }
+    UnmappedPoolCount.Set(UnmappedCount);
+    
+    MappedRangeEpoch.store(Epoch, std::memory_order_release);
+}
+
 IPoolAllocator* FMemoryPoolManager::GetPoolForType(uint32 TypeId) const
 {
     if (!IsInitialized())
@@ -4,6 +4,8 @@
 #include "HAL/PlatformMemory.h"
 #include "Misc/ScopeLock.h"
 #include "Interfaces/IPoolAllocator.h"
+#include "MemoryPoolManager.h"
+#include "NumaMemory.h"
 
 FMemoryTelemetry::FMemoryTelemetry()
     : bIsInitialized(false)
@@ -527,25 +529,59 @@ TArray<TPair<double, uint64>> FMemoryTelemetry::GetMemoryUsageTimeline() const
 
 TMap<int32, uint64> FMemoryTelemetry::GetMemoryUsageByNUMANode() const
 {
-    FScopeLock Lock(&AllocationLock);
-    
     TMap<int32, uint64> NumaUsage;
     
-    // Get NUMA node for each allocation
-    for (const auto& Pair : Allocations)
+    // Pool blocks never go through TrackAllocation, so pool memory comes from the pools'
+    // committed segments
+    TArray<TPair<const void*, uint64>> Ranges;
+    static_cast<FMemoryPoolManager&>(FMemoryPoolManager::Get()).GetPoolCommittedRanges(Ranges);
+    
     {
-        const void* Ptr = Pair.Key;
-        const uint64 Size = Pair.Value.SizeInBytes;
+        FScopeLock Lock(&AllocationLock);
         
-        // Use a default NUMA node value since GetPoolNumaNode is not available
-        int32 NumaNode = 0; // Default to node 0
+        for (const auto& Pair : Allocations)
+        {
+            // Entries added by TrackPool stand for a whole pool and are keyed by the pool object,
+            // not by its memory
+            if (Pair.Value.PoolName.IsNone())
+            {
+                Ranges.Emplace(Pair.Key, Pair.Value.SizeInBytes);
+            }
+        }
+    }
+    
+    // Collect every page each range touches, with the bytes of the range inside it; the kernel is
+    // queried without AllocationLock so tracking is not stalled behind it
+    const uint64 PageSize = FPlatformMemory::FPlatformVirtualMemoryBlock::GetCommitAlignment();
+    TArray<const void*> Pages;
+    TArray<uint64> PageBytes;
+    for (const TPair<const void*, uint64>& Range : Ranges)
+    {
+        const UPTRINT Start = reinterpret_cast<UPTRINT>(Range.Key);
+        const UPTRINT End = Start + Range.Value;
         
-        // Add to the appropriate NUMA node bucket
-        if (!NumaUsage.Contains(NumaNode))
+        for (UPTRINT Page = Start & ~static_cast<UPTRINT>(PageSize - 1); Page < End; Page += PageSize)
         {
-            NumaUsage.Add(NumaNode, 0);
+            Pages.Add(reinterpret_cast<const void*>(Page));
+            PageBytes.Add(FMath::Min<UPTRINT>(End, Page + PageSize) - FMath::Max<UPTRINT>(Start, Page));
         }
-        NumaUsage[NumaNode] += Size;
+    }
+    
+    // Ask the OS where each page really lives; pages not yet resident are counted under INDEX_NONE
+    TArray<int32> PageNodes;
+    PageNodes.SetNumUninitialized(Pages.Num());
+    if (!FNumaMemory::GetPageNodes(Pages.GetData(), Pages.Num(), PageNodes.GetData()))
+    {
+        // Placement cannot be queried here, so everything is on the one node
+        for (int32 PageIndex = 0; PageIndex < PageNodes.Num(); ++PageIndex)
+        {
+            PageNodes[PageIndex] = 0;
+        }
+    }
+    
+    for (int32 PageIndex = 0; PageIndex < Pages.Num(); ++PageIndex)
+    {
+        NumaUsage.FindOrAdd(PageNodes[PageIndex]) += PageBytes[PageIndex];
     }
     
     return NumaUsage;
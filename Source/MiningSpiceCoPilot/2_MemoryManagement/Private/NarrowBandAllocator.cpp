@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "NarrowBandAllocator.h"
+#include "NumaMemory.h"
 #include "HAL/PlatformMemory.h"
 #include "Misc/ScopeLock.h"
 #include "Math/UnrealMathSSE.h"
@@ -14,13 +15,19 @@ FNarrowBandAllocator::FNarrowBandAllocator(const FName& InPoolName, uint32 InBlo
     : IPoolAllocator()
     , PoolName(InPoolName)
     , BlockSize(InBlockSize < 8u ? 8u : InBlockSize) // Ensure minimum block size
-    , PoolMemory(nullptr)
     , MaxBlockCount(InBlockCount)
     , CurrentBlockCount(0)
+    , MagazineCache(
+        [this](uint32* OutBlockIndices, uint32 MaxCount) { return AllocateBatch(OutBlockIndices, MaxCount); },
+        [this](const uint32* BlockIndices, uint32 Count) { FreeBatch(BlockIndices, Count); })
     , bIsInitialized(false)
     , bAllowsGrowth(InAllowGrowth)
+    , bDebugTracking(false)
+    , bHugePagesAllowed(true)
+    , bLazySegmentRelease(false)
     , AccessPattern(InAccessPattern)
     , PrecisionTier(EMemoryTier::Hot) // Default to highest precision
+    , BandWidth(3.0f) // Default narrow band width in voxels
     , ChannelCount(1) // Default to single channel
     , bStatsDirty(true)
     , LastMiningDirection(FVector::ForwardVector) // Default mining direction
@@ -31,6 +38,8 @@ FNarrowBandAllocator::FNarrowBandAllocator(const FName& InPoolName, uint32 InBlo
 {
     // Align block size to appropriate boundary based on precision tier
     BlockSize = Align(BlockSize, GetElementAlignment());
+    ValuesPerBlock = BlockSize * 8 / FNarrowBandQuantization::GetBitsPerValue(PrecisionTier);
+    ApplyHugePagePolicy();
 }
 
 FNarrowBandAllocator::~FNarrowBandAllocator()
@@ -63,6 +72,7 @@ bool FNarrowBandAllocator::Initialize()
 
 void FNarrowBandAllocator::Shutdown()
 {
+    FPoolMagazineCache::FExclusiveScope CacheScope(MagazineCache);
     FScopeLock Lock(&PoolLock);
     
     if (!bIsInitialized)
@@ -93,23 +103,39 @@ uint32 FNarrowBandAllocator::GetBlockSize() const
 
 void* FNarrowBandAllocator::Allocate(const UObject* RequestingObject, FName AllocationTag)
 {
-    FScopeLock Lock(&PoolLock);
-    
     if (!bIsInitialized)
     {
         return nullptr;
     }
     
-    if (FreeBlocks.Num() == 0)
+    // Untracked allocations come from the calling thread's magazine without the pool lock;
+    // tags and owners are only worth the lock when debug tracking will record them
+    if (!bDebugTracking || (!RequestingObject && AllocationTag.IsNone()))
     {
-        // No free blocks, try to grow if allowed
-        uint32 growAmount = MaxBlockCount / 4;
-        if (growAmount < 32u) 
+        int32 CachedIndex = MagazineCache.Allocate();
+        if (CachedIndex == INDEX_NONE)
         {
-            growAmount = 32u;
+            return nullptr;
         }
         
-        if (!bAllowsGrowth || !Grow(growAmount))
+        Storage.MarkBlockHeld(CachedIndex);
+        void* CachedPtr = Storage.GetBlock(CachedIndex);
+        FMemory::Memzero(CachedPtr, GetEncodedBlockBytes());
+        return CachedPtr;
+    }
+    
+    FScopeLock Lock(&PoolLock);
+    
+    if (!bIsInitialized)
+    {
+        return nullptr;
+    }
+    
+    // Reuse a released segment before reserving a new one
+    if (FreeBlocks.Num() == 0 && !RecommitReleasedSegment())
+    {
+        // No free blocks, try to grow by one segment if allowed
+        if (!bAllowsGrowth || !Grow(Storage.GetBlocksPerSegment()))
         {
             // Could not grow the pool
             CachedStats.AllocationFailures++;
@@ -122,10 +148,8 @@ void* FNarrowBandAllocator::Allocate(const UObject* RequestingObject, FName Allo
     uint32 BlockIndex = FreeBlocks.Pop(EAllowShrinking::No);
     
     // Mark as allocated and set metadata
-    BlockMetadata[BlockIndex].bAllocated = true;
-    BlockMetadata[BlockIndex].AllocationTag = AllocationTag;
-    BlockMetadata[BlockIndex].RequestingObject = RequestingObject;
-    BlockMetadata[BlockIndex].AllocationTime = FPlatformTime::Seconds();
+    MarkBlockAllocated(BlockIndex, RequestingObject, AllocationTag, FPlatformTime::Seconds());
+    Storage.MarkBlockHeld(BlockIndex);
     
     // Record access pattern for prefetching - fix to manage buffer size
     if (RecentAccessPattern.Num() >= 32) // Using a reasonable size instead of GetCapacity
@@ -135,10 +159,10 @@ void* FNarrowBandAllocator::Allocate(const UObject* RequestingObject, FName Allo
     RecentAccessPattern.Add(BlockIndex);
     
     // Calculate address of the block
-    void* Ptr = PoolMemory + (BlockIndex * BlockSize);
+    void* Ptr = Storage.GetBlock(BlockIndex);
     
-    // Zero out the memory for the new allocation
-    FMemory::Memzero(Ptr, BlockSize);
+    // Zero out the encoded values; pages past them may be decommitted
+    FMemory::Memzero(Ptr, GetEncodedBlockBytes());
     
     // Track allocation count for performance tuning
     AllocationCounter++;
@@ -163,38 +187,97 @@ bool FNarrowBandAllocator::Free(void* Ptr)
         return false;
     }
     
-    FScopeLock Lock(&PoolLock);
-    
-    // Find which block this is
+    // Block lookup reads only the storage base and published block count, so it needs no lock
     int32 BlockIndex = GetBlockIndex(Ptr);
     if (BlockIndex == INDEX_NONE)
     {
         return false;
     }
     
-    // Check if already freed
-    if (!BlockMetadata[BlockIndex].bAllocated)
+    // Only one free of a block can clear its held mark, so a second free stops here. Blocks owned
+    // by a handle are never held, so a pointer resolved from a handle stops here too.
+    if (!Storage.TryReleaseHeldBlock(BlockIndex))
     {
+        FScopeLock Lock(&PoolLock);
+        if (Handles.HasHandle(static_cast<uint32>(BlockIndex)))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("FNarrowBandAllocator::Free - Pool '%s' rejected free of block %d, which is owned by a handle; use FreeHandle"),
+                *PoolName.ToString(), BlockIndex);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("FNarrowBandAllocator::Free - Pool '%s' ignored free of block %d that is not allocated"),
+                *PoolName.ToString(), BlockIndex);
+        }
         return false;
     }
     
-    // Mark as free
-    BlockMetadata[BlockIndex].bAllocated = false;
-    BlockMetadata[BlockIndex].AllocationTag = NAME_None;
-    BlockMetadata[BlockIndex].RequestingObject = nullptr;
-    BlockMetadata[BlockIndex].AllocationTime = 0.0;
-    BlockMetadata[BlockIndex].DistanceFromSurface = 0.0f;
+    // The block stays marked allocated until its magazine is flushed back to the pool
+    MagazineCache.Free(static_cast<uint32>(BlockIndex));
     
-    // Add to free list
-    FreeBlocks.Add(BlockIndex);
+    return true;
+}
+
+uint32 FNarrowBandAllocator::AllocateHandle(const UObject* RequestingObject, FName AllocationTag)
+{
+    FScopeLock Lock(&PoolLock);
     
-    // Update stats
-    bStatsDirty = true;
-    CachedStats.TotalFrees++;
+    if (!bIsInitialized)
+    {
+        return FPoolHandleTable::InvalidHandle;
+    }
+    
+    // Handle-owned blocks bypass the magazines so a block never has a handle while cached
+    uint32 BlockIndex = 0;
+    if (AllocateBatch(&BlockIndex, 1) == 0)
+    {
+        return FPoolHandleTable::InvalidHandle;
+    }
+    
+    if (RequestingObject || !AllocationTag.IsNone())
+    {
+        MarkBlockAllocated(BlockIndex, RequestingObject, AllocationTag, FPlatformTime::Seconds());
+    }
+    
+    const uint32 Handle = Handles.Add(BlockIndex);
+    if (Handle == FPoolHandleTable::InvalidHandle)
+    {
+        FreeBatch(&BlockIndex, 1);
+        return FPoolHandleTable::InvalidHandle;
+    }
     
+    // Zero out the encoded values; pages past them may be decommitted
+    FMemory::Memzero(Storage.GetBlock(BlockIndex), GetEncodedBlockBytes());
+    
+    CachedStats.TotalAllocations++;
+    return Handle;
+}
+
+bool FNarrowBandAllocator::FreeHandle(uint32 Handle)
+{
+    FScopeLock Lock(&PoolLock);
+    
+    const int32 BlockIndex = Handles.Remove(Handle);
+    if (BlockIndex == INDEX_NONE)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("FNarrowBandAllocator::FreeHandle - Pool '%s' ignored free of stale handle 0x%08x"),
+            *PoolName.ToString(), Handle);
+        return false;
+    }
+    
+    const uint32 FreedIndex = static_cast<uint32>(BlockIndex);
+    FreeBatch(&FreedIndex, 1);
+    CachedStats.TotalFrees++;
     return true;
 }
 
+void* FNarrowBandAllocator::ResolveHandle(uint32 Handle) const
+{
+    // The table and the storage base are both safe to read without the pool lock
+    const int32 BlockIndex = Handles.Resolve(Handle);
+    return BlockIndex != INDEX_NONE ? Storage.GetBlock(BlockIndex) : nullptr;
+}
+
 bool FNarrowBandAllocator::Grow(uint32 AdditionalBlockCount, bool bForceGrowth)
 {
     FScopeLock Lock(&PoolLock);
@@ -216,45 +299,26 @@ bool FNarrowBandAllocator::Grow(uint32 AdditionalBlockCount, bool bForceGrowth)
         return true; // Nothing to do
     }
     
-    // Store old memory info
-    uint8* OldMemory = PoolMemory;
     uint32 OldBlockCount = CurrentBlockCount;
-    uint32 NewBlockCount = OldBlockCount + AdditionalBlockCount;
     
-    // Allocate aligned memory for SIMD operations
-    uint32 Alignment = GetElementAlignment();
-    uint8* NewMemory = (uint8*)FMemory::Malloc(NewBlockCount * BlockSize, Alignment);
-    if (!NewMemory)
+    // Append whole segments; existing blocks and pointers into them are left untouched
+    uint32 AddedBlockCount = Storage.AddBlocks(AdditionalBlockCount);
+    if (AddedBlockCount == 0)
     {
         return false;
     }
     
-    // Copy existing blocks if there were any
-    if (OldMemory && OldBlockCount > 0)
-    {
-        FMemory::Memcpy(NewMemory, OldMemory, OldBlockCount * BlockSize);
-    }
-    
-    // Update pool information
-    PoolMemory = NewMemory;
+    uint32 NewBlockCount = OldBlockCount + AddedBlockCount;
     CurrentBlockCount = NewBlockCount;
     
-    // Zero out new memory
-    FMemory::Memzero(NewMemory + (OldBlockCount * BlockSize), AdditionalBlockCount * BlockSize);
-    
     // Make new blocks available
-    BlockMetadata.SetNum(NewBlockCount);
+    ResizeBlockMetadata(NewBlockCount);
+    FreeBlocks.Reserve(FreeBlocks.Num() + AddedBlockCount);
     for (uint32 i = OldBlockCount; i < NewBlockCount; ++i)
     {
         FreeBlocks.Add(i);
     }
     
-    // Free old memory if we grew an existing pool
-    if (OldMemory)
-    {
-        FMemory::Free(OldMemory);
-    }
-    
     // Update stats
     bStatsDirty = true;
     CachedStats.GrowthCount++;
@@ -267,6 +331,7 @@ bool FNarrowBandAllocator::Grow(uint32 AdditionalBlockCount, bool bForceGrowth)
 
 uint32 FNarrowBandAllocator::Shrink(uint32 MaxBlocksToRemove)
 {
+    FPoolMagazineCache::FExclusiveScope CacheScope(MagazineCache);
     FScopeLock Lock(&PoolLock);
     
     if (!bIsInitialized || CurrentBlockCount == 0)
@@ -304,92 +369,87 @@ uint32 FNarrowBandAllocator::Shrink(uint32 MaxBlocksToRemove)
         return 0;
     }
     
-    // Sort free blocks to facilitate removing those at the end (compacting memory)
-    FreeBlocks.Sort([](uint32 A, uint32 B) { return A > B; });
-    
-    // Check how many blocks at the end are contiguously free
-    uint32 ContigFreeBlocks = 0;
-    for (int32 i = 0; i < FreeBlocks.Num(); ++i)
+    // Trailing segments with no live blocks are dropped from the pool outright, since block
+    // indices stay dense. The first segment is always kept.
+    const uint32 BlocksPerSegment = Storage.GetBlocksPerSegment();
+    uint32 SegmentsToRelease = 0;
+    for (int32 SegmentIndex = Storage.GetSegmentCount() - 1; SegmentIndex > 0; --SegmentIndex)
     {
-        uint32 BlockIndex = FreeBlocks[i];
-        if (BlockIndex == CurrentBlockCount - 1 - ContigFreeBlocks)
+        if ((SegmentsToRelease + 1) * BlocksPerSegment > BlocksToRemove)
         {
-            ContigFreeBlocks++;
+            break;
         }
-        else
+        
+        const uint32 FirstBlock = static_cast<uint32>(SegmentIndex) * BlocksPerSegment;
+        if (AllocatedBits.CountSetInRange(FirstBlock, FirstBlock + BlocksPerSegment) > 0)
         {
             break;
         }
+        
+        SegmentsToRelease++;
     }
     
-    // Determine how many blocks we can actually remove
-    BlocksToRemove = BlocksToRemove < ContigFreeBlocks ? BlocksToRemove : ContigFreeBlocks;
-    if (BlocksToRemove == 0)
-    {
-        return 0;
-    }
-    
-    // Remove the highest-numbered free blocks from the free list
-    for (uint32 i = 0; i < BlocksToRemove; ++i)
+    uint32 BlocksRemoved = 0;
+    if (SegmentsToRelease > 0)
     {
-        FreeBlocks.RemoveAt(0); // Remove the highest index (first in sorted array)
+        // Drop the released blocks from the free list and metadata, then return their segments
+        uint32 NewBlockCount = CurrentBlockCount - SegmentsToRelease * BlocksPerSegment;
+        FreeBlocks.RemoveAll([NewBlockCount](uint32 BlockIndex) { return BlockIndex >= NewBlockCount; });
+        ResizeBlockMetadata(NewBlockCount);
+        BlocksRemoved = Storage.ReleaseTrailingSegments(SegmentsToRelease);
+        CurrentBlockCount = NewBlockCount;
     }
     
-    // Reduce metadata array size
-    uint32 NewBlockCount = CurrentBlockCount - BlocksToRemove;
-    BlockMetadata.SetNum(NewBlockCount);
-    
-    // Reallocate memory with optimal alignment
-    if (NewBlockCount > 0)
+    // Fully free segments further down give back their pages while keeping their addresses
+    const uint32 BlocksReleased = ReleaseFreeSegments(BlocksToRemove - BlocksRemoved);
+    if (BlocksRemoved + BlocksReleased == 0)
     {
-        uint32 Alignment = GetElementAlignment();
-        uint8* NewMemory = (uint8*)FMemory::Malloc(NewBlockCount * BlockSize, Alignment);
-        if (NewMemory)
-        {
-            // Copy the remaining blocks
-            FMemory::Memcpy(NewMemory, PoolMemory, NewBlockCount * BlockSize);
-            
-            // Free old memory
-            FMemory::Free(PoolMemory);
-            
-            // Update pool information
-            PoolMemory = NewMemory;
-            CurrentBlockCount = NewBlockCount;
-        }
-        else
-        {
-            // Failed to allocate new memory, revert changes
-            BlockMetadata.SetNum(CurrentBlockCount);
-            BlocksToRemove = 0;
-        }
-    }
-    else
-    {
-        // No blocks left, just free all memory
-        FMemory::Free(PoolMemory);
-        PoolMemory = nullptr;
-        CurrentBlockCount = 0;
+        return 0;
     }
     
     // Update stats
     bStatsDirty = true;
     
-    UE_LOG(LogTemp, Log, TEXT("FNarrowBandAllocator::Shrink - Shrunk pool '%s' by %u blocks to %u blocks"),
-        *PoolName.ToString(), BlocksToRemove, NewBlockCount);
+    UE_LOG(LogTemp, Log, TEXT("FNarrowBandAllocator::Shrink - Shrunk pool '%s' by %u blocks to %u blocks and released %u more in place"),
+        *PoolName.ToString(), BlocksRemoved, CurrentBlockCount, BlocksReleased);
     
-    return BlocksToRemove;
+    return BlocksRemoved + BlocksReleased;
 }
 
 bool FNarrowBandAllocator::OwnsPointer(const void* Ptr) const
 {
-    if (!bIsInitialized || !PoolMemory || !Ptr)
+    if (!bIsInitialized || !Ptr)
     {
         return false;
     }
     
-    // Check if the pointer is within our memory range
-    const uint8* BytePtr = static_cast<const uint8*>(Ptr);
-    return BytePtr >= PoolMemory && BytePtr < (PoolMemory + (CurrentBlockCount * BlockSize));
+    // The storage range is fixed while initialized and the block count is published atomically,
+    // so this does not need the pool lock
+    return Storage.Contains(Ptr);
+}
+
+bool FNarrowBandAllocator::GetReservedAddressRange(const void*& OutBase, uint64& OutSize) const
+{
+    if (!bIsInitialized)
+    {
+        OutBase = nullptr;
+        OutSize = 0;
+        return false;
+    }
+    
+    OutBase = Storage.GetReservedBase();
+    OutSize = Storage.GetReservedBytes();
+    return OutBase != nullptr;
+}
+
+void FNarrowBandAllocator::GetCommittedRanges(TArray<TPair<const void*, uint64>>& OutRanges) const
+{
+    FScopeLock Lock(&PoolLock);
+    
+    if (bIsInitialized)
+    {
+        Storage.GetCommittedRanges(OutRanges);
+    }
 }
 
 void FNarrowBandAllocator::SetAccessPattern(EMemoryAccessPattern InAccessPattern)
@@ -413,11 +473,23 @@ FPoolStats FNarrowBandAllocator::GetStats() const
         bStatsDirty = false;
     }
     
-    return CachedStats;
+    // Blocks cached in magazines are marked allocated in the metadata but are free to callers
+    FPoolStats Stats = CachedStats;
+    uint64 CachedAllocations = 0;
+    uint64 CachedFrees = 0;
+    MagazineCache.GetOperationCounts(CachedAllocations, CachedFrees);
+    uint32 CachedBlocks = FMath::Min(MagazineCache.GetCachedBlockCount(), Stats.AllocatedBlocks);
+    Stats.AllocatedBlocks -= CachedBlocks;
+    Stats.FreeBlocks += CachedBlocks;
+    Stats.TotalAllocations += CachedAllocations;
+    Stats.TotalFrees += CachedFrees;
+    
+    return Stats;
 }
 
 bool FNarrowBandAllocator::Defragment(float MaxTimeMs)
 {
+    FPoolMagazineCache::FExclusiveScope CacheScope(MagazineCache);
     FScopeLock Lock(&PoolLock);
     
     if (!bIsInitialized || CurrentBlockCount == 0)
@@ -430,100 +502,35 @@ bool FNarrowBandAllocator::Defragment(float MaxTimeMs)
     double EndTime = StartTime + MaxTimeMs / 1000.0;
     bool bDidDefragment = false;
     
-    // Count fragmentation (transitions between allocated and free blocks)
-    uint32 FragmentCount = 0;
-    bool PrevWasAllocated = false;
+    // Count fragmentation (transitions between allocated and free blocks) from the bitmap,
+    // 64 blocks per word
+    uint32 FragmentCount = AllocatedBits.CountTransitions();
     
     // Sort allocated blocks to be contiguous
     TArray<uint32> AllocatedBlocks;
-    TArray<uint32> SpatialMap; // Maps new indices to original block indices
+    AllocatedBits.GetSetIndices(AllocatedBlocks);
     
-    // First pass: collect all allocated blocks
-    for (uint32 i = 0; i < CurrentBlockCount; ++i)
+    // Moving is all or nothing, so give up before touching any block if the scan used the budget
+    if (FPlatformTime::Seconds() >= EndTime)
     {
-        bool IsAllocated = BlockMetadata[i].bAllocated;
-        
-        if (i > 0 && IsAllocated != PrevWasAllocated)
-        {
-            FragmentCount++;
-        }
-        
-        if (IsAllocated)
-        {
-            AllocatedBlocks.Add(i);
-        }
-        
-        PrevWasAllocated = IsAllocated;
-        
-        // Check if we're out of time
-        if (FPlatformTime::Seconds() >= EndTime)
-        {
-            break;
-        }
+        return false;
     }
     
     // If we have significant fragmentation, try to defragment
     if (FragmentCount > 1 && AllocatedBlocks.Num() > 0)
     {
-        // Allocate a temporary buffer to hold relocated blocks
-        uint32 Alignment = GetElementAlignment();
-        uint8* TempMemory = (uint8*)FMemory::Malloc(CurrentBlockCount * BlockSize, Alignment);
+        // Move all allocated blocks to the front in place, without a second copy of the pool.
+        // Blocks are copied through every segment, so released ones must be committed again.
+        RecommitReleasedSegments();
+        Storage.PermuteBlocks(AllocatedBlocks);
+        CompactBlockMetadata(AllocatedBlocks);
         
-        if (TempMemory)
-        {
-            // Create a new layout with all allocated blocks first, then free blocks
-            SpatialMap.SetNum(CurrentBlockCount);
-            uint32 NewIndex = 0;
-            
-            // First, copy all allocated blocks to the beginning of the temp buffer
-            for (uint32 OldIndex : AllocatedBlocks)
-            {
-                // Copy block data
-                FMemory::Memcpy(TempMemory + (NewIndex * BlockSize), 
-                            PoolMemory + (OldIndex * BlockSize), 
-                            BlockSize);
-                
-                // Update spatial mapping
-                SpatialMap[NewIndex] = OldIndex;
-                NewIndex++;
-            }
-            
-            // Reset free blocks array
-            FreeBlocks.Empty(CurrentBlockCount - AllocatedBlocks.Num());
-            
-            // Update metadata and create free list
-            for (uint32 i = 0; i < CurrentBlockCount; ++i)
-            {
-                if (i < static_cast<uint32>(AllocatedBlocks.Num()))
-                {
-                    // This is now an allocated block
-                    uint32 OldIndex = SpatialMap[i];
-                    BlockMetadata[i] = BlockMetadata[OldIndex];
-                }
-                else
-                {
-                    // This is now a free block
-                    BlockMetadata[i].bAllocated = false;
-                    BlockMetadata[i].AllocationTag = NAME_None;
-                    BlockMetadata[i].RequestingObject = nullptr;
-                    BlockMetadata[i].AllocationTime = 0.0;
-                    BlockMetadata[i].Position = FVector::ZeroVector;
-                    BlockMetadata[i].DistanceFromSurface = 0.0f;
-                    FreeBlocks.Add(i);
-                }
-            }
-            
-            // Replace the old buffer with the new one
-            FMemory::Free(PoolMemory);
-            PoolMemory = TempMemory;
-            
-            // Update stats
-            bStatsDirty = true;
-            bDidDefragment = true;
-            
-            UE_LOG(LogTemp, Log, TEXT("FNarrowBandAllocator::Defragment - Defragmented pool '%s', reduced fragments from %u to 1"),
-                *PoolName.ToString(), FragmentCount);
-        }
+        // Update stats
+        bStatsDirty = true;
+        bDidDefragment = true;
+        
+        UE_LOG(LogTemp, Log, TEXT("FNarrowBandAllocator::Defragment - Defragmented pool '%s', reduced fragments from %u to 1"),
+            *PoolName.ToString(), FragmentCount);
     }
     
     return bDidDefragment;
@@ -531,6 +538,7 @@ bool FNarrowBandAllocator::Defragment(float MaxTimeMs)
 
 bool FNarrowBandAllocator::PackBlocksByPosition(float MaxTimeMs)
 {
+    FPoolMagazineCache::FExclusiveScope CacheScope(MagazineCache);
     FScopeLock Lock(&PoolLock);
     
     if (!bIsInitialized || CurrentBlockCount == 0)
@@ -545,13 +553,7 @@ bool FNarrowBandAllocator::PackBlocksByPosition(float MaxTimeMs)
     
     // Collect all allocated blocks
     TArray<uint32> AllocatedBlocks;
-    for (uint32 i = 0; i < CurrentBlockCount; ++i)
-    {
-        if (BlockMetadata[i].bAllocated)
-        {
-            AllocatedBlocks.Add(i);
-        }
-    }
+    AllocatedBits.GetSetIndices(AllocatedBlocks);
     
     if (AllocatedBlocks.Num() < 2)
     {
@@ -561,82 +563,22 @@ bool FNarrowBandAllocator::PackBlocksByPosition(float MaxTimeMs)
     
     // Sort blocks by Z-order curve index for spatial locality
     AllocatedBlocks.Sort([this](uint32 A, uint32 B) {
-        uint64 ZOrderA = PositionToZOrder(BlockMetadata[A].Position);
-        uint64 ZOrderB = PositionToZOrder(BlockMetadata[B].Position);
+        uint64 ZOrderA = PositionToZOrder(GetBlockPosition(A));
+        uint64 ZOrderB = PositionToZOrder(GetBlockPosition(B));
         return ZOrderA < ZOrderB;
     });
     
-    // Allocate temporary memory for reorganized blocks
-    uint32 Alignment = GetElementAlignment();
-    uint8* TempMemory = (uint8*)FMemory::Malloc(CurrentBlockCount * BlockSize, Alignment);
-    
-    if (!TempMemory)
+    // Moving is all or nothing, so give up before touching any block if sorting used the budget
+    if (FPlatformTime::Seconds() >= EndTime)
     {
         return false;
     }
     
-    // Create a mapping from old indices to new indices
-    TArray<uint32> OldToNewIndex;
-    OldToNewIndex.SetNum(CurrentBlockCount);
-    for (uint32 i = 0; i < CurrentBlockCount; ++i)
-    {
-        OldToNewIndex[i] = INDEX_NONE;
-    }
-    
-    // Copy blocks in Z-order to new memory
-    uint32 NewIndex = 0;
-    for (uint32 OldIndex : AllocatedBlocks)
-    {
-        // Copy block data
-        FMemory::Memcpy(TempMemory + (NewIndex * BlockSize), 
-                     PoolMemory + (OldIndex * BlockSize), 
-                     BlockSize);
-        
-        // Update mapping
-        OldToNewIndex[OldIndex] = NewIndex;
-        NewIndex++;
-        
-        // Check time budget
-        if (FPlatformTime::Seconds() >= EndTime)
-        {
-            // Out of time, clean up and abort
-            FMemory::Free(TempMemory);
-            return false;
-        }
-    }
-    
-    // Create new metadata array
-    TArray<FBlockMetadata> NewMetadata;
-    NewMetadata.SetNum(CurrentBlockCount);
-    
-    // Update metadata and prepare free list
-    FreeBlocks.Empty(CurrentBlockCount - AllocatedBlocks.Num());
-    
-    for (uint32 i = 0; i < CurrentBlockCount; ++i)
-    {
-        if (i < static_cast<uint32>(AllocatedBlocks.Num()))
-        {
-            // This is an allocated block - copy metadata
-            uint32 OldIndex = AllocatedBlocks[i];
-            NewMetadata[i] = BlockMetadata[OldIndex];
-        }
-        else
-        {
-            // This is a free block
-            NewMetadata[i].bAllocated = false;
-            NewMetadata[i].AllocationTag = NAME_None;
-            NewMetadata[i].RequestingObject = nullptr;
-            NewMetadata[i].AllocationTime = 0.0;
-            NewMetadata[i].Position = FVector::ZeroVector;
-            NewMetadata[i].DistanceFromSurface = 0.0f;
-            FreeBlocks.Add(i);
-        }
-    }
-    
-    // Replace old memory and metadata
-    FMemory::Free(PoolMemory);
-    PoolMemory = TempMemory;
-    BlockMetadata = MoveTemp(NewMetadata);
+    // Reorder the blocks in place, then their metadata and the free list. Blocks are copied
+    // through every segment, so released ones must be committed again.
+    RecommitReleasedSegments();
+    Storage.PermuteBlocks(AllocatedBlocks);
+    CompactBlockMetadata(AllocatedBlocks);
     
     // Update stats
     bStatsDirty = true;
@@ -650,6 +592,7 @@ bool FNarrowBandAllocator::PackBlocksByPosition(float MaxTimeMs)
 
 bool FNarrowBandAllocator::OptimizeNarrowBand(float MaxTimeMs)
 {
+    FPoolMagazineCache::FExclusiveScope CacheScope(MagazineCache);
     FScopeLock Lock(&PoolLock);
     
     if (!bIsInitialized || CurrentBlockCount == 0)
@@ -664,13 +607,7 @@ bool FNarrowBandAllocator::OptimizeNarrowBand(float MaxTimeMs)
     
     // Collect all allocated blocks
     TArray<uint32> AllocatedBlocks;
-    for (uint32 i = 0; i < CurrentBlockCount; ++i)
-    {
-        if (BlockMetadata[i].bAllocated)
-        {
-            AllocatedBlocks.Add(i);
-        }
-    }
+    AllocatedBits.GetSetIndices(AllocatedBlocks);
     
     if (AllocatedBlocks.Num() < 2)
     {
@@ -680,70 +617,20 @@ bool FNarrowBandAllocator::OptimizeNarrowBand(float MaxTimeMs)
     
     // Sort blocks by distance from surface (narrow band optimization)
     AllocatedBlocks.Sort([this](uint32 A, uint32 B) {
-        return BlockMetadata[A].DistanceFromSurface < BlockMetadata[B].DistanceFromSurface;
+        return GetBlockDistance(A) < GetBlockDistance(B);
     });
     
-    // Allocate temporary memory for reorganized blocks
-    uint32 Alignment = GetElementAlignment();
-    uint8* TempMemory = (uint8*)FMemory::Malloc(CurrentBlockCount * BlockSize, Alignment);
-    
-    if (!TempMemory)
+    // Moving is all or nothing, so give up before touching any block if sorting used the budget
+    if (FPlatformTime::Seconds() >= EndTime)
     {
         return false;
     }
     
-    // Copy blocks in narrow band order to new memory
-    uint32 NewIndex = 0;
-    for (uint32 OldIndex : AllocatedBlocks)
-    {
-        // Copy block data
-        FMemory::Memcpy(TempMemory + (NewIndex * BlockSize), 
-                     PoolMemory + (OldIndex * BlockSize), 
-                     BlockSize);
-        
-        NewIndex++;
-        
-        // Check time budget
-        if (FPlatformTime::Seconds() >= EndTime)
-        {
-            // Out of time, clean up and abort
-            FMemory::Free(TempMemory);
-            return false;
-        }
-    }
-    
-    // Create new metadata array
-    TArray<FBlockMetadata> NewMetadata;
-    NewMetadata.SetNum(CurrentBlockCount);
-    
-    // Update metadata and prepare free list
-    FreeBlocks.Empty(CurrentBlockCount - AllocatedBlocks.Num());
-    
-    for (uint32 i = 0; i < CurrentBlockCount; ++i)
-    {
-        if (i < static_cast<uint32>(AllocatedBlocks.Num()))
-        {
-            // This is an allocated block - copy metadata
-            uint32 OldIndex = AllocatedBlocks[i];
-            NewMetadata[i] = BlockMetadata[OldIndex];
-        }
-        else
-        {
-            // This is a free block
-            NewMetadata[i].bAllocated = false;
-            NewMetadata[i].AllocationTag = NAME_None;
-            NewMetadata[i].RequestingObject = nullptr;
-            NewMetadata[i].AllocationTime = 0.0;
-            NewMetadata[i].Position = FVector::ZeroVector;
-            NewMetadata[i].DistanceFromSurface = 0.0f;
-            FreeBlocks.Add(i);
-        }
-    }
-    
-    // Replace old memory and metadata
-    FMemory::Free(PoolMemory);
-    PoolMemory = TempMemory;
-    BlockMetadata = MoveTemp(NewMetadata);
+    // Reorder the blocks in place, then their metadata and the free list. Blocks are copied
+    // through every segment, so released ones must be committed again.
+    RecommitReleasedSegments();
+    Storage.PermuteBlocks(AllocatedBlocks);
+    CompactBlockMetadata(AllocatedBlocks);
     
     // Update stats
     bStatsDirty = true;
@@ -765,7 +652,7 @@ bool FNarrowBandAllocator::Validate(TArray<FString>& OutErrors) const
         return false;
     }
     
-    if (!PoolMemory)
+    if (Storage.GetSegmentCount() == 0 || Storage.GetBlockCount() != CurrentBlockCount)
     {
         OutErrors.Add(FString::Printf(TEXT("Pool '%s' has invalid memory"), *PoolName.ToString()));
         return false;
@@ -793,74 +680,290 @@ bool FNarrowBandAllocator::Validate(TArray<FString>& OutErrors) const
             return false;
         }
         
-        if (BlockMetadata[FreeIndex].bAllocated)
+        if (AllocatedBits.IsSet(FreeIndex))
         {
             OutErrors.Add(FString::Printf(TEXT("Pool '%s' has free index %u marked as allocated"), 
                 *PoolName.ToString(), FreeIndex));
             return false;
         }
         
+        if (Storage.IsSegmentReleased(static_cast<int32>(FreeIndex / Storage.GetBlocksPerSegment())))
+        {
+            OutErrors.Add(FString::Printf(TEXT("Pool '%s' has free index %u in a released segment"), 
+                *PoolName.ToString(), FreeIndex));
+            return false;
+        }
+        
         BlockUsed[FreeIndex] = true;
     }
     
     // Check metadata consistency
-    uint32 AllocatedCount = 0;
-    uint32 FreeCount = 0;
+    if (AllocatedBits.Num() != CurrentBlockCount ||
+        (BlockTracking.Num() > 0 && BlockTracking.Num() != static_cast<int32>(CurrentBlockCount)) ||
+        (BlockSpatial.Num() > 0 && BlockSpatial.Num() != static_cast<int32>(CurrentBlockCount)))
+    {
+        OutErrors.Add(FString::Printf(TEXT("Pool '%s' metadata does not cover its %u blocks"), 
+            *PoolName.ToString(), CurrentBlockCount));
+        return false;
+    }
     
-    for (uint32 i = 0; i < CurrentBlockCount; ++i)
+    // Blocks in released segments are neither allocated nor on the free list
+    uint32 AllocatedCount = AllocatedBits.CountSet();
+    uint32 ReleasedCount = Storage.GetReleasedSegmentCount() * Storage.GetBlocksPerSegment();
+    uint32 FreeCount = CurrentBlockCount - AllocatedCount - ReleasedCount;
+    
+    if (FreeCount != (uint32)FreeBlocks.Num())
     {
-        if (BlockMetadata[i].bAllocated)
-        {
-            AllocatedCount++;
-        }
-        else
+        OutErrors.Add(FString::Printf(TEXT("Pool '%s' free count mismatch: %u in metadata, %u in free list"), 
+            *PoolName.ToString(), FreeCount, FreeBlocks.Num()));
+        return false;
+    }
+    
+    if (AllocatedCount + FreeCount + ReleasedCount != CurrentBlockCount)
+    {
+        OutErrors.Add(FString::Printf(TEXT("Pool '%s' block count mismatch: %u allocated + %u free + %u released != %u total"), 
+            *PoolName.ToString(), AllocatedCount, FreeCount, ReleasedCount, CurrentBlockCount));
+        return false;
+    }
+    
+    return true;
+}
+
+bool FNarrowBandAllocator::SetPrecisionTier(EMemoryTier NewTier)
+{
+    FPoolMagazineCache::FExclusiveScope CacheScope(MagazineCache);
+    FScopeLock Lock(&PoolLock);
+    
+    if (NewTier == PrecisionTier)
+    {
+        return true;
+    }
+    
+    // With no values to keep, the block is re-laid out to hold as many values as fit the new tier
+    if (!bIsInitialized || AllocatedBits.CountSet() == 0)
+    {
+        PrecisionTier = NewTier;
+        ValuesPerBlock = BlockSize * 8 / FNarrowBandQuantization::GetBitsPerValue(PrecisionTier);
+        if (bIsInitialized)
         {
-            FreeCount++;
+            RecommitReleasedSegments();
+            Storage.CommitBlocks(0, CurrentBlockCount);
+            Storage.SetResidentBlockBytes(GetEncodedBlockBytes());
         }
+        ApplyHugePagePolicy();
+        bStatsDirty = true;
+        return true;
+    }
+    
+    if (!ConvertBlocks(NewTier, BandWidth))
+    {
+        return false;
+    }
+    
+    ApplyHugePagePolicy();
+    return true;
+}
+
+EMemoryTier FNarrowBandAllocator::GetPrecisionTier() const
+{
+    return PrecisionTier;
+}
+
+bool FNarrowBandAllocator::SetBandWidth(float NewBandWidth)
+{
+    if (!(NewBandWidth > 0.0f))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("FNarrowBandAllocator::SetBandWidth - Invalid band width %f for pool '%s'"),
+            NewBandWidth, *PoolName.ToString());
+        return false;
+    }
+    
+    FPoolMagazineCache::FExclusiveScope CacheScope(MagazineCache);
+    FScopeLock Lock(&PoolLock);
+    
+    if (NewBandWidth == BandWidth)
+    {
+        return true;
+    }
+    
+    // Only the normalized tiers store values relative to the band width
+    const bool bNormalized = PrecisionTier == EMemoryTier::Cold || PrecisionTier == EMemoryTier::Archive;
+    if (!bIsInitialized || !bNormalized || AllocatedBits.CountSet() == 0)
+    {
+        BandWidth = NewBandWidth;
+        return true;
+    }
+    
+    return ConvertBlocks(PrecisionTier, NewBandWidth);
+}
+
+float FNarrowBandAllocator::GetBandWidth() const
+{
+    return BandWidth;
+}
+
+uint32 FNarrowBandAllocator::GetValuesPerBlock() const
+{
+    return ValuesPerBlock;
+}
+
+uint32 FNarrowBandAllocator::GetEncodedBlockBytes() const
+{
+    return FNarrowBandQuantization::GetEncodedSize(PrecisionTier, ValuesPerBlock);
+}
+
+uint64 FNarrowBandAllocator::GetResidentBytes() const
+{
+    FScopeLock Lock(&PoolLock);
+    return Storage.GetResidentBytes();
+}
+
+bool FNarrowBandAllocator::SetHugePages(bool bEnable)
+{
+    FScopeLock Lock(&PoolLock);
+    
+    bHugePagesAllowed = bEnable;
+    return ApplyHugePagePolicy();
+}
+
+void FNarrowBandAllocator::SetLazySegmentRelease(bool bEnable)
+{
+    FScopeLock Lock(&PoolLock);
+    
+    bLazySegmentRelease = bEnable;
+}
+
+bool FNarrowBandAllocator::ReadValues(const void* Ptr, uint32 FirstValue, uint32 Count, float* OutValues) const
+{
+    if (!OutValues || !IsValidValueRange(Ptr, FirstValue, Count))
+    {
+        return false;
+    }
+    
+    FNarrowBandQuantization::Decode(PrecisionTier, static_cast<const uint8*>(Ptr), FirstValue, Count, BandWidth, OutValues);
+    return true;
+}
+
+float FNarrowBandAllocator::ReadValue(const void* Ptr, uint32 ValueIndex) const
+{
+    float Value = 0.0f;
+    ReadValues(Ptr, ValueIndex, 1, &Value);
+    return Value;
+}
+
+bool FNarrowBandAllocator::WriteValues(void* Ptr, uint32 FirstValue, uint32 Count, const float* Values)
+{
+    if (!Values || !IsValidValueRange(Ptr, FirstValue, Count))
+    {
+        return false;
     }
     
-    if (FreeCount != (uint32)FreeBlocks.Num())
+    FNarrowBandQuantization::Encode(PrecisionTier, Values, FirstValue, Count, BandWidth, static_cast<uint8*>(Ptr));
+    return true;
+}
+
+bool FNarrowBandAllocator::IsValidValueRange(const void* Ptr, uint32 FirstValue, uint32 Count) const
+{
+    if (Storage.GetBlockIndex(Ptr) == INDEX_NONE)
     {
-        OutErrors.Add(FString::Printf(TEXT("Pool '%s' free count mismatch: %u in metadata, %u in free list"), 
-            *PoolName.ToString(), FreeCount, FreeBlocks.Num()));
+        UE_LOG(LogTemp, Warning, TEXT("FNarrowBandAllocator::IsValidValueRange - Pointer %p is not a block of pool '%s'"),
+            Ptr, *PoolName.ToString());
         return false;
     }
     
-    if (AllocatedCount + FreeCount != CurrentBlockCount)
+    if (static_cast<uint64>(FirstValue) + Count > ValuesPerBlock)
     {
-        OutErrors.Add(FString::Printf(TEXT("Pool '%s' block count mismatch: %u allocated + %u free != %u total"), 
-            *PoolName.ToString(), AllocatedCount, FreeCount, CurrentBlockCount));
+        UE_LOG(LogTemp, Warning, TEXT("FNarrowBandAllocator::IsValidValueRange - Values %u to %u are past the %u values per block of pool '%s'"),
+            FirstValue, FirstValue + Count, ValuesPerBlock, *PoolName.ToString());
         return false;
     }
     
     return true;
 }
 
-void FNarrowBandAllocator::SetPrecisionTier(EMemoryTier NewTier)
+bool FNarrowBandAllocator::ConvertBlocks(EMemoryTier NewTier, float NewBandWidth)
 {
-    FScopeLock Lock(&PoolLock);
+    const uint32 OldEncodedBytes = GetEncodedBlockBytes();
+    const uint32 NewEncodedBytes = FNarrowBandQuantization::GetEncodedSize(NewTier, ValuesPerBlock);
+    if (NewEncodedBytes > BlockSize)
+    {
+        UE_LOG(LogTemp, Error, TEXT("FNarrowBandAllocator::ConvertBlocks - Pool '%s' holds %u values per block, which need %u bytes in tier %d but blocks are %u bytes"),
+            *PoolName.ToString(), ValuesPerBlock, NewEncodedBytes, static_cast<int32>(NewTier), BlockSize);
+        return false;
+    }
+    
+    // Tails are committed and decommitted a segment at a time below, which must not touch
+    // released segments
+    RecommitReleasedSegments();
     
-    if (NewTier != PrecisionTier)
+    const double StartTime = FPlatformTime::Seconds();
+    const uint64 OldResidentBytes = Storage.GetResidentBytes();
+    uint32 ConvertedCount = 0;
+    
+    // Work a segment at a time so a widening conversion only recommits one segment's tails ahead
+    // of converting them, and a narrowing one releases tails as it goes
+    const uint32 SegmentBlocks = FMath::Max(Storage.GetBlocksPerSegment(), 1u);
+    for (uint32 SegmentStart = 0; SegmentStart < CurrentBlockCount; SegmentStart += SegmentBlocks)
     {
-        // Save old tier for logging
-        EMemoryTier OldTier = PrecisionTier;
-        PrecisionTier = NewTier;
+        const uint32 SegmentEnd = FMath::Min(SegmentStart + SegmentBlocks, CurrentBlockCount);
+        if (NewEncodedBytes > OldEncodedBytes)
+        {
+            Storage.CommitBlocks(SegmentStart, SegmentEnd);
+        }
         
-        // If initialized, we'll need to re-align blocks the next time we grow
-        if (bIsInitialized)
+        for (int32 BlockIndex = AllocatedBits.FindFirstSet(SegmentStart);
+            BlockIndex != INDEX_NONE && static_cast<uint32>(BlockIndex) < SegmentEnd;
+            BlockIndex = AllocatedBits.FindFirstSet(BlockIndex + 1))
         {
-            UE_LOG(LogTemp, Warning, TEXT("FNarrowBandAllocator::SetPrecisionTier - Pool '%s' precision tier changed from %d to %d after initialization. Changes will be applied on next allocation."),
-                *PoolName.ToString(), static_cast<int32>(OldTier), static_cast<int32>(NewTier));
+            FNarrowBandQuantization::Convert(Storage.GetBlock(BlockIndex), ValuesPerBlock, PrecisionTier, BandWidth, NewTier, NewBandWidth);
+            ConvertedCount++;
         }
         
-        // Force stats update
-        bStatsDirty = true;
+        if (NewEncodedBytes < OldEncodedBytes)
+        {
+            Storage.DecommitBlockTails(SegmentStart, SegmentEnd, NewEncodedBytes);
+        }
     }
+    
+    Storage.SetResidentBlockBytes(NewEncodedBytes);
+    
+    UE_LOG(LogTemp, Log, TEXT("FNarrowBandAllocator::ConvertBlocks - Pool '%s' converted %u blocks from tier %d to %d in %.2f ms, resident memory %llu -> %llu bytes"),
+        *PoolName.ToString(), ConvertedCount, static_cast<int32>(PrecisionTier), static_cast<int32>(NewTier),
+        (FPlatformTime::Seconds() - StartTime) * 1000.0, OldResidentBytes, Storage.GetResidentBytes());
+    
+    PrecisionTier = NewTier;
+    BandWidth = NewBandWidth;
+    bStatsDirty = true;
+    return true;
 }
 
-EMemoryTier FNarrowBandAllocator::GetPrecisionTier() const
+void FNarrowBandAllocator::SetDebugTracking(bool bEnable)
 {
-    return PrecisionTier;
+    FScopeLock Lock(&PoolLock);
+    
+    if (bEnable == bDebugTracking)
+    {
+        return;
+    }
+    
+    bDebugTracking = bEnable;
+    
+    // Blocks allocated before tracking was turned on have empty entries
+    if (bEnable)
+    {
+        BlockTracking.SetNum(CurrentBlockCount);
+    }
+    else
+    {
+        BlockTracking.Empty();
+    }
+    
+    bStatsDirty = true;
+}
+
+bool FNarrowBandAllocator::IsDebugTracking() const
+{
+    return bDebugTracking;
 }
 
 void FNarrowBandAllocator::SetChannelCount(uint32 NewChannelCount)
@@ -920,13 +1023,19 @@ bool FNarrowBandAllocator::SetBlockPosition(void* Ptr, const FVector& Position)
     
     // Find which block this is
     int32 BlockIndex = GetBlockIndex(Ptr);
-    if (BlockIndex == INDEX_NONE || !BlockMetadata[BlockIndex].bAllocated)
+    if (BlockIndex == INDEX_NONE || !AllocatedBits.IsSet(BlockIndex))
     {
         return false;
     }
     
+    // Spatial data is only kept once some block uses it
+    if (BlockSpatial.Num() == 0)
+    {
+        BlockSpatial.SetNum(CurrentBlockCount);
+    }
+    
     // Set position
-    BlockMetadata[BlockIndex].Position = Position;
+    BlockSpatial[BlockIndex].Position = Position;
     return true;
 }
 
@@ -941,18 +1050,25 @@ bool FNarrowBandAllocator::SetDistanceFromSurface(void* Ptr, float Distance)
     
     // Find which block this is
     int32 BlockIndex = GetBlockIndex(Ptr);
-    if (BlockIndex == INDEX_NONE || !BlockMetadata[BlockIndex].bAllocated)
+    if (BlockIndex == INDEX_NONE || !AllocatedBits.IsSet(BlockIndex))
     {
         return false;
     }
     
+    // Spatial data is only kept once some block uses it
+    if (BlockSpatial.Num() == 0)
+    {
+        BlockSpatial.SetNum(CurrentBlockCount);
+    }
+    
     // Set distance
-    BlockMetadata[BlockIndex].DistanceFromSurface = Distance;
+    BlockSpatial[BlockIndex].DistanceFromSurface = Distance;
     return true;
 }
 
 bool FNarrowBandAllocator::Reset()
 {
+    FPoolMagazineCache::FExclusiveScope CacheScope(MagazineCache);
     FScopeLock Lock(&PoolLock);
     
     if (!bIsInitialized)
@@ -960,20 +1076,23 @@ bool FNarrowBandAllocator::Reset()
         return false;
     }
     
-    // Clear all allocations
-    FreeBlocks.Empty(CurrentBlockCount);
+    // Every block becomes free, so bring released segments back before listing them
+    RecommitReleasedSegments();
     
+    // Clear all allocations, their side table entries and any handles to them
+    AllocatedBits.ClearAll();
+    Storage.ClearHeldBlocks();
+    BlockSpatial.Empty();
+    Handles.Empty();
+    if (bDebugTracking)
+    {
+        BlockTracking.Reset();
+        BlockTracking.SetNum(CurrentBlockCount);
+    }
+    
+    FreeBlocks.Empty(CurrentBlockCount);
     for (uint32 i = 0; i < CurrentBlockCount; ++i)
     {
-        // Reset metadata
-        BlockMetadata[i].bAllocated = false;
-        BlockMetadata[i].AllocationTag = NAME_None;
-        BlockMetadata[i].RequestingObject = nullptr;
-        BlockMetadata[i].Position = FVector::ZeroVector;
-        BlockMetadata[i].AllocationTime = 0.0;
-        BlockMetadata[i].DistanceFromSurface = 0.0f;
-        
-        // Add to free list
         FreeBlocks.Add(i);
     }
     
@@ -999,31 +1118,28 @@ bool FNarrowBandAllocator::AllocatePoolMemory(uint32 BlockCount)
     }
     
     // Free existing memory if any
-    if (PoolMemory)
+    if (Storage.GetSegmentCount() > 0)
     {
         FreePoolMemory();
     }
     
-    // Calculate total memory size
-    uint64 TotalSize = static_cast<uint64>(BlockCount) * static_cast<uint64>(BlockSize);
-    
-    // Get appropriate alignment based on precision tier
-    uint32 Alignment = GetElementAlignment();
-    
-    // Allocate memory with alignment for SIMD operations
-    PoolMemory = (uint8*)FMemory::Malloc(TotalSize, Alignment);
-    if (!PoolMemory)
+    // Segments are page aligned and blocks are already padded to the element alignment,
+    // so every block meets the SIMD alignment. Only the encoded values at the front of each
+    // block are kept committed.
+    const bool bConfigured = Storage.Configure(BlockSize, BlockCount);
+    Storage.SetResidentBlockBytes(GetEncodedBlockBytes());
+    if (!bConfigured || Storage.AddBlocks(BlockCount) == 0)
     {
-        UE_LOG(LogTemp, Error, TEXT("FNarrowBandAllocator::AllocatePoolMemory - Failed to allocate %llu bytes with alignment %u"),
-            TotalSize, Alignment);
+        UE_LOG(LogTemp, Error, TEXT("FNarrowBandAllocator::AllocatePoolMemory - Failed to allocate %u blocks of %u bytes"),
+            BlockCount, BlockSize);
         return false;
     }
     
-    // Zero out the memory
-    FMemory::Memzero(PoolMemory, TotalSize);
+    // Segments are whole, so the pool may hold more blocks than requested
+    BlockCount = Storage.GetBlockCount();
     
     // Initialize metadata
-    BlockMetadata.SetNum(BlockCount);
+    ResizeBlockMetadata(BlockCount);
     
     // Initialize free blocks
     FreeBlocks.Empty(BlockCount);
@@ -1048,13 +1164,12 @@ bool FNarrowBandAllocator::AllocatePoolMemory(uint32 BlockCount)
 
 void FNarrowBandAllocator::FreePoolMemory()
 {
-    if (PoolMemory)
-    {
-        FMemory::Free(PoolMemory);
-        PoolMemory = nullptr;
-    }
+    Storage.Empty();
     
-    BlockMetadata.Empty();
+    AllocatedBits.Empty();
+    BlockTracking.Empty();
+    BlockSpatial.Empty();
+    Handles.Empty();
     FreeBlocks.Empty();
     CurrentBlockCount = 0;
 }
@@ -1067,93 +1182,241 @@ void FNarrowBandAllocator::UpdateStats() const
     CachedStats.BlockCount = CurrentBlockCount;
     CachedStats.bAllowsGrowth = bAllowsGrowth;
     
-    // Count allocations and track data
-    uint32 AllocatedBlockCount = 0;
-    TMap<FName, uint32> AllocationsByTag;
-    float AvgDistanceFromSurface = 0.0f;
+    // Count allocations from the bitmap, 64 blocks per word
+    uint32 AllocatedBlockCount = AllocatedBits.CountSet();
+    
+    // Update peak allocation tracking
+    CachedStats.PeakAllocatedBlocks = FMath::Max(CachedStats.PeakAllocatedBlocks, AllocatedBlockCount);
+    
+    // Calculate memory usage
+    CachedStats.AllocatedBlocks = AllocatedBlockCount;
+    CachedStats.FreeBlocks = CurrentBlockCount - AllocatedBlockCount - Storage.GetReleasedSegmentCount() * Storage.GetBlocksPerSegment();
+    
+    // Calculate fragmentation - transitions between allocated and free
+    uint32 FragmentCount = AllocatedBits.CountTransitions();
+    
+    // Simplified fragmentation metric based on the number of transitions
+    CachedStats.FragmentationPercent = (CurrentBlockCount > 1) ? 
+        (100.0f * static_cast<float>(FragmentCount) / (CurrentBlockCount - 1)) : 0.0f;
     
-    for (const auto& Metadata : BlockMetadata)
+    // Calculate overhead (class size + bitmap + side tables + free list)
+    CachedStats.OverheadBytes = sizeof(FNarrowBandAllocator) +
+                               AllocatedBits.GetAllocatedSize() +
+                               BlockTracking.GetAllocatedSize() +
+                               BlockSpatial.GetAllocatedSize() +
+                               Handles.GetAllocatedSize() +
+                               FreeBlocks.GetAllocatedSize();
+}
+
+int32 FNarrowBandAllocator::GetBlockIndex(const void* Ptr) const
+{
+    if (!bIsInitialized || !Ptr)
     {
-        if (Metadata.bAllocated)
-        {
-            AllocatedBlockCount++;
-            
-            // Track allocations by tag
-            uint32& TagCount = AllocationsByTag.FindOrAdd(Metadata.AllocationTag, 0);
-            TagCount++;
-            
-            // Track distance metrics
-            AvgDistanceFromSurface += Metadata.DistanceFromSurface;
-        }
+        return INDEX_NONE;
     }
     
-    // Calculate average distances
-    if (AllocatedBlockCount > 0)
+    // Validates that the pointer is at a block boundary inside the committed range
+    return Storage.GetBlockIndex(Ptr);
+}
+
+uint32 FNarrowBandAllocator::AllocateBatch(uint32* OutBlockIndices, uint32 MaxCount)
+{
+    FScopeLock Lock(&PoolLock);
+    
+    if (!bIsInitialized)
     {
-        AvgDistanceFromSurface /= AllocatedBlockCount;
+        return 0;
     }
     
-    // Update peak allocation tracking
-    CachedStats.PeakAllocatedBlocks = FMath::Max(CachedStats.PeakAllocatedBlocks, AllocatedBlockCount);
+    // Reuse a released segment before reserving a new one
+    if (FreeBlocks.Num() == 0 && !RecommitReleasedSegment())
+    {
+        // No free blocks, try to grow by one segment if allowed
+        if (!bAllowsGrowth || !Grow(Storage.GetBlocksPerSegment()))
+        {
+            CachedStats.AllocationFailures++;
+            bStatsDirty = true;
+            return 0;
+        }
+    }
     
-    // Calculate memory usage
-    CachedStats.AllocatedBlocks = AllocatedBlockCount;
-    CachedStats.FreeBlocks = CurrentBlockCount - AllocatedBlockCount;
+    const double Now = FPlatformTime::Seconds();
+    uint32 Count = FMath::Min(MaxCount, static_cast<uint32>(FreeBlocks.Num()));
+    for (uint32 i = 0; i < Count; ++i)
+    {
+        uint32 BlockIndex = FreeBlocks.Pop(EAllowShrinking::No);
+        MarkBlockAllocated(BlockIndex, nullptr, NAME_None, Now);
+        OutBlockIndices[i] = BlockIndex;
+    }
     
-    // Calculate fragmentation - transitions between allocated and free
-    uint32 FragmentCount = 0;
-    bool PrevWasAllocated = false;
+    bStatsDirty = true;
+    return Count;
+}
+
+void FNarrowBandAllocator::FreeBatch(const uint32* BlockIndices, uint32 Count)
+{
+    FScopeLock Lock(&PoolLock);
     
-    for (uint32 i = 0; i < CurrentBlockCount; ++i)
+    for (uint32 i = 0; i < Count; ++i)
     {
-        bool IsAllocated = BlockMetadata[i].bAllocated;
+        uint32 BlockIndex = BlockIndices[i];
         
-        if (i > 0 && IsAllocated != PrevWasAllocated)
+        // A block freed twice reaches the pool twice; only the first return counts
+        if (BlockIndex >= CurrentBlockCount || !AllocatedBits.IsSet(BlockIndex))
         {
-            FragmentCount++;
+            UE_LOG(LogTemp, Warning, TEXT("FNarrowBandAllocator::FreeBatch - Pool '%s' ignored free of block %u that is not allocated"),
+                *PoolName.ToString(), BlockIndex);
+            continue;
         }
         
-        PrevWasAllocated = IsAllocated;
+        MarkBlockFree(BlockIndex);
+        FreeBlocks.Add(BlockIndex);
     }
     
-    // Simplified fragmentation metric based on the number of transitions
-    CachedStats.FragmentationPercent = (CurrentBlockCount > 1) ? 
-        (100.0f * static_cast<float>(FragmentCount) / (CurrentBlockCount - 1)) : 0.0f;
+    bStatsDirty = true;
+}
+
+void FNarrowBandAllocator::MarkBlockAllocated(uint32 BlockIndex, const UObject* RequestingObject, FName AllocationTag, double AllocationTime)
+{
+    AllocatedBits.Set(BlockIndex);
     
-    // Calculate overhead (class size + metadata + free list)
-    CachedStats.OverheadBytes = sizeof(FNarrowBandAllocator) +
-                               (BlockMetadata.Num() * sizeof(FBlockMetadata)) +
-                               (FreeBlocks.Num() * sizeof(uint32));
+    if (bDebugTracking)
+    {
+        FBlockTrackingInfo& Tracking = BlockTracking[BlockIndex];
+        Tracking.AllocationTag = AllocationTag;
+        Tracking.RequestingObject = RequestingObject;
+        Tracking.AllocationTime = AllocationTime;
+    }
 }
 
-int32 FNarrowBandAllocator::GetBlockIndex(const void* Ptr) const
+void FNarrowBandAllocator::MarkBlockFree(uint32 BlockIndex)
 {
-    if (!bIsInitialized || !PoolMemory || !Ptr)
+    AllocatedBits.Clear(BlockIndex);
+    
+    if (BlockTracking.Num() > 0)
     {
-        return INDEX_NONE;
+        BlockTracking[BlockIndex] = FBlockTrackingInfo();
+    }
+    if (BlockSpatial.Num() > 0)
+    {
+        BlockSpatial[BlockIndex] = FBlockSpatialInfo();
+    }
+}
+
+void FNarrowBandAllocator::ResizeBlockMetadata(uint32 NewBlockCount)
+{
+    AllocatedBits.SetNum(NewBlockCount);
+    
+    // Side tables stay empty until they are used
+    if (BlockTracking.Num() > 0 || bDebugTracking)
+    {
+        BlockTracking.SetNum(NewBlockCount);
+    }
+    if (BlockSpatial.Num() > 0)
+    {
+        BlockSpatial.SetNum(NewBlockCount);
+    }
+}
+
+bool FNarrowBandAllocator::ApplyHugePagePolicy()
+{
+    return Storage.SetHugePages(bHugePagesAllowed && PrecisionTier == EMemoryTier::Hot);
+}
+
+uint32 FNarrowBandAllocator::ReleaseFreeSegments(uint32 MaxBlocks)
+{
+    const uint32 BlocksPerSegment = Storage.GetBlocksPerSegment();
+    uint32 BlocksReleased = 0;
+    for (int32 SegmentIndex = 1; SegmentIndex < Storage.GetSegmentCount() && BlocksReleased + BlocksPerSegment <= MaxBlocks; ++SegmentIndex)
+    {
+        const uint32 FirstBlock = static_cast<uint32>(SegmentIndex) * BlocksPerSegment;
+        if (!Storage.IsSegmentReleased(SegmentIndex) &&
+            AllocatedBits.CountSetInRange(FirstBlock, FirstBlock + BlocksPerSegment) == 0 &&
+            Storage.ReleaseSegment(SegmentIndex, bLazySegmentRelease) > 0)
+        {
+            BlocksReleased += BlocksPerSegment;
+        }
     }
     
-    // Calculate offset from pool base
-    const uint8* BytePtr = static_cast<const uint8*>(Ptr);
-    ptrdiff_t Offset = BytePtr - PoolMemory;
+    if (BlocksReleased > 0)
+    {
+        FreeBlocks.RemoveAll([this, BlocksPerSegment](uint32 BlockIndex)
+        {
+            return Storage.IsSegmentReleased(static_cast<int32>(BlockIndex / BlocksPerSegment));
+        });
+    }
     
-    // Check if pointer is within pool range
-    if (Offset < 0 || Offset >= static_cast<ptrdiff_t>(CurrentBlockCount * BlockSize))
+    return BlocksReleased;
+}
+
+bool FNarrowBandAllocator::RecommitReleasedSegment()
+{
+    const int32 SegmentIndex = Storage.FindReleasedSegment();
+    if (SegmentIndex == INDEX_NONE)
     {
-        return INDEX_NONE;
+        return false;
     }
     
-    // Calculate block index
-    int32 BlockIndex = static_cast<int32>(Offset / BlockSize);
+    // The storage reapplies the current tier's resident prefix to the recommitted blocks
+    Storage.RecommitSegment(SegmentIndex);
     
-    // Validate that pointer is at block boundary
-    if ((Offset % BlockSize) != 0)
+    const uint32 BlocksPerSegment = Storage.GetBlocksPerSegment();
+    const uint32 FirstBlock = static_cast<uint32>(SegmentIndex) * BlocksPerSegment;
+    FreeBlocks.Reserve(FreeBlocks.Num() + BlocksPerSegment);
+    for (uint32 i = FirstBlock; i < FirstBlock + BlocksPerSegment; ++i)
     {
-        // Not at a block boundary
-        return INDEX_NONE;
+        FreeBlocks.Add(i);
+    }
+    
+    bStatsDirty = true;
+    return true;
+}
+
+void FNarrowBandAllocator::RecommitReleasedSegments()
+{
+    while (RecommitReleasedSegment())
+    {
+    }
+}
+
+void FNarrowBandAllocator::CompactBlockMetadata(const TArray<uint32>& Order)
+{
+    const uint32 MovedCount = static_cast<uint32>(Order.Num());
+    
+    // Blocks [0, MovedCount) are now allocated and everything after is free
+    AllocatedBits.SetLeading(MovedCount);
+    
+    if (BlockTracking.Num() > 0)
+    {
+        TArray<FBlockTrackingInfo> NewTracking;
+        NewTracking.SetNum(CurrentBlockCount);
+        for (uint32 i = 0; i < MovedCount; ++i)
+        {
+            NewTracking[i] = BlockTracking[Order[i]];
+        }
+        BlockTracking = MoveTemp(NewTracking);
+    }
+    
+    if (BlockSpatial.Num() > 0)
+    {
+        TArray<FBlockSpatialInfo> NewSpatial;
+        NewSpatial.SetNum(CurrentBlockCount);
+        for (uint32 i = 0; i < MovedCount; ++i)
+        {
+            NewSpatial[i] = BlockSpatial[Order[i]];
+        }
+        BlockSpatial = MoveTemp(NewSpatial);
     }
     
-    return BlockIndex;
+    // One slot write per moved handle; nothing else refers to the old addresses
+    Handles.PermuteBlocks(Order);
+    
+    // Rebuild the free list from the free tail
+    FreeBlocks.Empty(CurrentBlockCount - MovedCount);
+    for (uint32 i = MovedCount; i < CurrentBlockCount; ++i)
+    {
+        FreeBlocks.Add(i);
+    }
 }
 
 uint32 FNarrowBandAllocator::GetElementAlignment() const
@@ -1201,9 +1464,8 @@ uint32 FNarrowBandAllocator::GetBytesPerChannel() const
             return 1;
             
         case EMemoryTier::Archive:
-            // Compressed format - sub-byte precision
-            // For simplicity, we'll use a reasonable approximation
-            return (ChannelCount > 1) ? 1 : 2; // More aggressive compression with multiple channels
+            // Packed 4-bit values, two to a byte; a lone channel still takes a byte
+            return 1;
             
         default:
             // Default to full float
@@ -1216,7 +1478,8 @@ void FNarrowBandAllocator::PrefetchLikelyBlocks()
     // This function doesn't need the lock as it only reads data and uses prefetching
     // which is just a hint to the CPU and not a critical operation
     
-    if (!bIsInitialized || CurrentBlockCount == 0)
+    // Without spatial data no block has a position to prefetch around
+    if (!bIsInitialized || CurrentBlockCount == 0 || BlockSpatial.Num() == 0)
     {
         return;
     }
@@ -1227,13 +1490,13 @@ void FNarrowBandAllocator::PrefetchLikelyBlocks()
         uint32 RecentBlockIndex = RecentAccessPattern[i];
         
         // Skip if not valid
-        if (RecentBlockIndex >= CurrentBlockCount || !BlockMetadata[RecentBlockIndex].bAllocated)
+        if (RecentBlockIndex >= CurrentBlockCount || !AllocatedBits.IsSet(RecentBlockIndex))
         {
             continue;
         }
         
         // Get position of this block
-        const FVector& Position = BlockMetadata[RecentBlockIndex].Position;
+        const FVector& Position = BlockSpatial[RecentBlockIndex].Position;
         
         // Skip if position is not set
         if (Position.IsZero())
@@ -1244,36 +1507,34 @@ void FNarrowBandAllocator::PrefetchLikelyBlocks()
         // Calculate a position in the mining direction
         FVector PrefetchPos = Position + (LastMiningDirection * PrefetchDistance);
         
-        // Find blocks near this position
-        for (uint32 j = 0; j < CurrentBlockCount; ++j)
+        // Find allocated blocks near this position, skipping free runs a word at a time
+        for (int32 Next = AllocatedBits.FindFirstSet(0); Next != INDEX_NONE; Next = AllocatedBits.FindFirstSet(Next + 1))
         {
-            if (BlockMetadata[j].bAllocated)
+            const uint32 j = static_cast<uint32>(Next);
+            const FVector& BlockPos = BlockSpatial[j].Position;
+            
+            // Skip if position is not set
+            if (BlockPos.IsZero())
             {
-                const FVector& BlockPos = BlockMetadata[j].Position;
-                
-                // Skip if position is not set
-                if (BlockPos.IsZero())
-                {
-                    continue;
-                }
+                continue;
+            }
+            
+            // Check if this block is in our prefetch direction
+            float DistSq = FVector::DistSquared(BlockPos, PrefetchPos);
+            
+            // If it's close enough to our prefetch position
+            if (DistSq < (PrefetchDistance * PrefetchDistance * 4.0f))
+            {
+                // Calculate address of this block
+                void* PrefetchPtr = Storage.GetBlock(j);
                 
-                // Check if this block is in our prefetch direction
-                float DistSq = FVector::DistSquared(BlockPos, PrefetchPos);
+                // Prefetch this block into cache
+                FPlatformMisc::Prefetch(PrefetchPtr);
                 
-                // If it's close enough to our prefetch position
-                if (DistSq < (PrefetchDistance * PrefetchDistance * 4.0f))
+                // Limit the number of prefetches to avoid thrashing the cache
+                if (j % 4 == 0)
                 {
-                    // Calculate address of this block
-                    void* PrefetchPtr = PoolMemory + (j * BlockSize);
-                    
-                    // Prefetch this block into cache
-                    FPlatformMisc::Prefetch(PrefetchPtr);
-                    
-                    // Limit the number of prefetches to avoid thrashing the cache
-                    if (j % 4 == 0)
-                    {
-                        break;
-                    }
+                    break;
                 }
             }
         }
@@ -1315,6 +1576,7 @@ uint64 FNarrowBandAllocator::PositionToZOrder(const FVector& Position, float Gri
 
 bool FNarrowBandAllocator::MoveNextFragmentedAllocation(void*& OutOldPtr, void*& OutNewPtr, uint64& OutSize)
 {
+    FPoolMagazineCache::FExclusiveScope CacheScope(MagazineCache);
     FScopeLock Lock(&PoolLock);
     
     if (!bIsInitialized || CurrentBlockCount == 0)
@@ -1322,82 +1584,65 @@ bool FNarrowBandAllocator::MoveNextFragmentedAllocation(void*& OutOldPtr, void*&
         return false;
     }
     
-    // Find a fragmented block - a block where one side is allocated and the other is free
-    for (uint32 i = 0; i < CurrentBlockCount - 1; ++i)
+    // Destinations may lie in released segments, so bring them back first
+    RecommitReleasedSegments();
+    
+    // The last allocated block and the first free block after it are the same for every
+    // candidate, so find them once
+    const int32 LastAllocatedIndex = AllocatedBits.FindLastSet(CurrentBlockCount);
+    if (LastAllocatedIndex == INDEX_NONE)
+    {
+        return false;
+    }
+    
+    const int32 DestIndex = AllocatedBits.FindFirstClear(LastAllocatedIndex + 1);
+    if (DestIndex == INDEX_NONE)
     {
-        // Look for an allocated block followed by a free block
-        if (BlockMetadata[i].bAllocated && !BlockMetadata[i+1].bAllocated)
+        // No suitable destination found
+        return false;
+    }
+    
+    // Find a fragmented block - an allocated block followed by a free block, before the last
+    // allocated block
+    const int32 FirstAllocated = AllocatedBits.FindFirstSet(0);
+    const int32 FirstGap = FirstAllocated != INDEX_NONE ? AllocatedBits.FindFirstClear(FirstAllocated) : INDEX_NONE;
+    if (FirstGap != INDEX_NONE && FirstGap < LastAllocatedIndex)
+    {
+        const uint32 i = static_cast<uint32>(FirstGap - 1);
+        
+        // Calculate source and destination pointers
+        OutOldPtr = Storage.GetBlock(i);
+        OutNewPtr = Storage.GetBlock(DestIndex);
+        OutSize = BlockSize;
+        
+        // Move the encoded values; pages past them may be decommitted
+        FMemory::Memcpy(OutNewPtr, OutOldPtr, GetEncodedBlockBytes());
+        
+        // Update metadata
+        MarkBlockAllocated(DestIndex, nullptr, NAME_None, 0.0);
+        if (BlockTracking.Num() > 0)
         {
-            // Found a fragmented allocation - see if there's room at the end
-            uint32 LastAllocatedIndex = 0;
-            
-            // Find the last allocated block
-            for (uint32 j = CurrentBlockCount - 1; j > i + 1; --j)
-            {
-                if (BlockMetadata[j].bAllocated)
-                {
-                    LastAllocatedIndex = j;
-                    break;
-                }
-            }
-            
-            // If the last allocated block is after our current position, move this block there
-            if (LastAllocatedIndex == 0 || LastAllocatedIndex <= i + 1)
-            {
-                // No suitable location found
-                continue;
-            }
-            
-            // Find an available destination position after the last allocated block
-            uint32 DestIndex = 0;
-            for (uint32 j = LastAllocatedIndex + 1; j < CurrentBlockCount; ++j)
-            {
-                if (!BlockMetadata[j].bAllocated)
-                {
-                    DestIndex = j;
-                    break;
-                }
-            }
-            
-            if (DestIndex == 0)
-            {
-                // No suitable destination found
-                continue;
-            }
-            
-            // Calculate source and destination pointers
-            OutOldPtr = PoolMemory + (i * BlockSize);
-            OutNewPtr = PoolMemory + (DestIndex * BlockSize);
-            OutSize = BlockSize;
-            
-            // Move the block data
-            FMemory::Memcpy(OutNewPtr, OutOldPtr, BlockSize);
-            
-            // Update metadata
-            BlockMetadata[DestIndex] = BlockMetadata[i];
-            BlockMetadata[i].bAllocated = false;
-            BlockMetadata[i].AllocationTag = NAME_None;
-            BlockMetadata[i].RequestingObject = nullptr;
-            BlockMetadata[i].AllocationTime = 0.0;
-            BlockMetadata[i].Position = FVector::ZeroVector;
-            BlockMetadata[i].DistanceFromSurface = 0.0f;
-            
-            // Update free blocks list
-            FreeBlocks.Add(i);
-            for (int32 FreeIndex = 0; FreeIndex < FreeBlocks.Num(); ++FreeIndex)
-            {
-                if (FreeBlocks[FreeIndex] == DestIndex)
-                {
-                    FreeBlocks.RemoveAt(FreeIndex);
-                    break;
-                }
-            }
-            
-            // Update stats
-            bStatsDirty = true;
-            
-            return true;
+            BlockTracking[DestIndex] = BlockTracking[i];
+        }
+        if (BlockSpatial.Num() > 0)
+        {
+            BlockSpatial[DestIndex] = BlockSpatial[i];
+        }
+        MarkBlockFree(i);
+        Handles.MoveBlock(i, DestIndex);
+        if (Storage.TryReleaseHeldBlock(i))
+        {
+            Storage.MarkBlockHeld(DestIndex);
         }
+        
+        // Update free blocks list
+        FreeBlocks.Add(i);
+        FreeBlocks.RemoveSingleSwap(static_cast<uint32>(DestIndex), EAllowShrinking::No);
+        
+        // Update stats
+        bStatsDirty = true;
+        
+        return true;
     }
     
     // No fragmented allocations found
@@ -1508,11 +1753,19 @@ void FNarrowBandAllocator::SetMemoryUsageHint(EPoolMemoryUsage UsageHint)
 
 void FNarrowBandAllocator::SetNumaNode(int32 NodeId)
 {
-    UE_LOG(LogTemp, Verbose, TEXT("FNarrowBandAllocator(%s): Setting NUMA node to %d"), 
-        *PoolName.ToString(), NodeId);
+    FScopeLock Lock(&PoolLock);
     
-    // In a real implementation, we would bind allocations to the specified NUMA node
-    // For now, we just log the request
+    // Segments committed from now on follow the node; resident pages move where the platform can bind
+    if (Storage.SetNumaNode(NodeId))
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("FNarrowBandAllocator(%s): Placing pool memory on NUMA node %d"), 
+            *PoolName.ToString(), NodeId);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("FNarrowBandAllocator(%s): NUMA node %d not applied; %d node(s) available"), 
+            *PoolName.ToString(), NodeId, FNumaMemory::GetNodeCount());
+    }
 }
 
 bool FNarrowBandAllocator::ConfigureSIMDLayout(uint32 MaterialTypeId, uint32 FieldAlignment, bool bEnableVectorization, ESIMDInstructionSet SIMDOperationType)
@@ -0,0 +1,345 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "NarrowBandQuantization.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+#include <emmintrin.h>
+#define NARROWBAND_QUANTIZATION_SSE2 1
+#else
+#define NARROWBAND_QUANTIZATION_SSE2 0
+#endif
+
+namespace NarrowBandQuantizationInternal
+{
+    /** Largest magnitude of a Cold value */
+    static constexpr int32 ByteLevels = 127;
+
+    /** Largest magnitude of an Archive value */
+    static constexpr int32 NibbleLevels = 7;
+
+    /** Values decoded to the stack per step of Convert; even, so chunks start on whole bytes */
+    static constexpr uint32 ConvertChunkSize = 256;
+
+    /** Gets the band width used for normalizing, guarding against zero */
+    static FORCEINLINE float SafeBandWidth(float BandWidth)
+    {
+        return FMath::Max(BandWidth, SMALL_NUMBER);
+    }
+
+    /** Quantizes a value to an integer in [-Levels, Levels], rounding half to even as SSE does */
+    static FORCEINLINE int32 QuantizeScalar(float Value, float Scale, int32 Levels)
+    {
+        const float Scaled = FMath::Clamp(Value * Scale, -static_cast<float>(Levels), static_cast<float>(Levels));
+        return static_cast<int32>(FMath::RoundHalfToEven(Scaled));
+    }
+
+    /** Writes a 4-bit value, low nibble for even indices and high nibble for odd ones */
+    static FORCEINLINE void StoreNibble(uint8* Encoded, uint32 Index, int32 Value)
+    {
+        uint8& Byte = Encoded[Index >> 1];
+        const uint32 Shift = (Index & 1) * 4;
+        Byte = static_cast<uint8>((Byte & ~(0xF << Shift)) | ((Value & 0xF) << Shift));
+    }
+
+    /** Reads a 4-bit value and sign extends it */
+    static FORCEINLINE int32 LoadNibble(const uint8* Encoded, uint32 Index)
+    {
+        const int32 Nibble = (Encoded[Index >> 1] >> ((Index & 1) * 4)) & 0xF;
+        return (Nibble ^ 8) - 8;
+    }
+
+#if NARROWBAND_QUANTIZATION_SSE2
+    /** Scales, clamps and rounds 4 values to 32-bit integers */
+    static FORCEINLINE __m128i QuantizeSSE(const float* Values, __m128 Scale, __m128 Limit, __m128 NegLimit)
+    {
+        const __m128 Scaled = _mm_mul_ps(_mm_loadu_ps(Values), Scale);
+        return _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(Scaled, NegLimit), Limit));
+    }
+
+    /** Quantizes 16 values to signed bytes, in order */
+    static FORCEINLINE __m128i QuantizeBytesSSE(const float* Values, __m128 Scale, __m128 Limit, __m128 NegLimit)
+    {
+        const __m128i Low = _mm_packs_epi32(QuantizeSSE(Values, Scale, Limit, NegLimit), QuantizeSSE(Values + 4, Scale, Limit, NegLimit));
+        const __m128i High = _mm_packs_epi32(QuantizeSSE(Values + 8, Scale, Limit, NegLimit), QuantizeSSE(Values + 12, Scale, Limit, NegLimit));
+        return _mm_packs_epi16(Low, High);
+    }
+
+    /** Sign extends 16 bytes and stores them as scaled floats */
+    static FORCEINLINE void StoreBytesSSE(float* OutValues, __m128i Bytes, __m128 Step)
+    {
+        // Unpacking a lane with itself puts the value in the high half, so an arithmetic shift sign extends it
+        const __m128i Words[2] = { _mm_srai_epi16(_mm_unpacklo_epi8(Bytes, Bytes), 8), _mm_srai_epi16(_mm_unpackhi_epi8(Bytes, Bytes), 8) };
+        for (int32 Half = 0; Half < 2; ++Half)
+        {
+            const __m128i Low = _mm_srai_epi32(_mm_unpacklo_epi16(Words[Half], Words[Half]), 16);
+            const __m128i High = _mm_srai_epi32(_mm_unpackhi_epi16(Words[Half], Words[Half]), 16);
+            _mm_storeu_ps(OutValues + Half * 8, _mm_mul_ps(_mm_cvtepi32_ps(Low), Step));
+            _mm_storeu_ps(OutValues + Half * 8 + 4, _mm_mul_ps(_mm_cvtepi32_ps(High), Step));
+        }
+    }
+#endif
+
+    static void EncodeBytes(const float* Values, uint32 Count, float BandWidth, int8* OutBytes)
+    {
+        const float Scale = ByteLevels / SafeBandWidth(BandWidth);
+        uint32 Index = 0;
+
+#if NARROWBAND_QUANTIZATION_SSE2
+        const __m128 VScale = _mm_set1_ps(Scale);
+        const __m128 Limit = _mm_set1_ps(static_cast<float>(ByteLevels));
+        const __m128 NegLimit = _mm_set1_ps(-static_cast<float>(ByteLevels));
+        for (; Index + 16 <= Count; Index += 16)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(OutBytes + Index), QuantizeBytesSSE(Values + Index, VScale, Limit, NegLimit));
+        }
+#endif
+
+        for (; Index < Count; ++Index)
+        {
+            OutBytes[Index] = static_cast<int8>(QuantizeScalar(Values[Index], Scale, ByteLevels));
+        }
+    }
+
+    static void DecodeBytes(const int8* Bytes, uint32 Count, float BandWidth, float* OutValues)
+    {
+        const float Step = SafeBandWidth(BandWidth) / ByteLevels;
+        uint32 Index = 0;
+
+#if NARROWBAND_QUANTIZATION_SSE2
+        const __m128 VStep = _mm_set1_ps(Step);
+        for (; Index + 16 <= Count; Index += 16)
+        {
+            StoreBytesSSE(OutValues + Index, _mm_loadu_si128(reinterpret_cast<const __m128i*>(Bytes + Index)), VStep);
+        }
+#endif
+
+        for (; Index < Count; ++Index)
+        {
+            OutValues[Index] = Bytes[Index] * Step;
+        }
+    }
+
+    static void EncodeNibbles(const float* Values, uint32 FirstValue, uint32 Count, float BandWidth, uint8* Encoded)
+    {
+        const float Scale = NibbleLevels / SafeBandWidth(BandWidth);
+        uint32 Index = 0;
+
+        // An odd first value shares its byte with the value before it
+        if ((FirstValue & 1) && Count > 0)
+        {
+            StoreNibble(Encoded, FirstValue, QuantizeScalar(Values[0], Scale, NibbleLevels));
+            Index = 1;
+        }
+
+        uint8* OutBytes = Encoded + ((FirstValue + Index) >> 1);
+
+#if NARROWBAND_QUANTIZATION_SSE2
+        const __m128 VScale = _mm_set1_ps(Scale);
+        const __m128 Limit = _mm_set1_ps(static_cast<float>(NibbleLevels));
+        const __m128 NegLimit = _mm_set1_ps(-static_cast<float>(NibbleLevels));
+        const __m128i LowMask = _mm_set1_epi16(0x000F);
+        const __m128i HighMask = _mm_set1_epi16(0x00F0);
+        for (; Index + 16 <= Count; Index += 16, OutBytes += 8)
+        {
+            // Join each pair of bytes: the even value goes to the low nibble, the odd value to the high
+            const __m128i Bytes = QuantizeBytesSSE(Values + Index, VScale, Limit, NegLimit);
+            const __m128i Pairs = _mm_or_si128(_mm_and_si128(Bytes, LowMask), _mm_and_si128(_mm_srli_epi16(Bytes, 4), HighMask));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(OutBytes), _mm_packus_epi16(Pairs, _mm_setzero_si128()));
+        }
+#endif
+
+        for (; Index + 2 <= Count; Index += 2, ++OutBytes)
+        {
+            const int32 Low = QuantizeScalar(Values[Index], Scale, NibbleLevels);
+            const int32 High = QuantizeScalar(Values[Index + 1], Scale, NibbleLevels);
+            *OutBytes = static_cast<uint8>((Low & 0xF) | ((High & 0xF) << 4));
+        }
+
+        if (Index < Count)
+        {
+            StoreNibble(Encoded, FirstValue + Index, QuantizeScalar(Values[Index], Scale, NibbleLevels));
+        }
+    }
+
+    static void DecodeNibbles(const uint8* Encoded, uint32 FirstValue, uint32 Count, float BandWidth, float* OutValues)
+    {
+        const float Step = SafeBandWidth(BandWidth) / NibbleLevels;
+        uint32 Index = 0;
+
+        if ((FirstValue & 1) && Count > 0)
+        {
+            OutValues[0] = LoadNibble(Encoded, FirstValue) * Step;
+            Index = 1;
+        }
+
+#if NARROWBAND_QUANTIZATION_SSE2
+        const uint8* InBytes = Encoded + ((FirstValue + Index) >> 1);
+        const __m128 VStep = _mm_set1_ps(Step);
+        const __m128i Mask = _mm_set1_epi8(0x0F);
+        const __m128i Sign = _mm_set1_epi8(8);
+        for (; Index + 16 <= Count; Index += 16, InBytes += 8)
+        {
+            // Split the nibbles, interleave them back into value order and sign extend each to a byte
+            const __m128i Packed = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(InBytes));
+            const __m128i Low = _mm_and_si128(Packed, Mask);
+            const __m128i High = _mm_and_si128(_mm_srli_epi16(Packed, 4), Mask);
+            const __m128i Bytes = _mm_sub_epi8(_mm_xor_si128(_mm_unpacklo_epi8(Low, High), Sign), Sign);
+            StoreBytesSSE(OutValues + Index, Bytes, VStep);
+        }
+#endif
+
+        for (; Index < Count; ++Index)
+        {
+            OutValues[Index] = LoadNibble(Encoded, FirstValue + Index) * Step;
+        }
+    }
+
+    static void EncodeHalves(const float* Values, uint32 Count, uint16* OutHalves)
+    {
+        uint32 Index = 0;
+        for (; Index + 4 <= Count; Index += 4)
+        {
+            FPlatformMath::VectorStoreHalf(OutHalves + Index, Values + Index);
+        }
+        for (; Index < Count; ++Index)
+        {
+            FPlatformMath::StoreHalf(OutHalves + Index, Values[Index]);
+        }
+    }
+
+    static void DecodeHalves(const uint16* Halves, uint32 Count, float* OutValues)
+    {
+        uint32 Index = 0;
+        for (; Index + 4 <= Count; Index += 4)
+        {
+            FPlatformMath::VectorLoadHalf(OutValues + Index, Halves + Index);
+        }
+        for (; Index < Count; ++Index)
+        {
+            OutValues[Index] = FPlatformMath::LoadHalf(Halves + Index);
+        }
+    }
+}
+
+uint32 FNarrowBandQuantization::GetBitsPerValue(EMemoryTier Tier)
+{
+    switch (Tier)
+    {
+        case EMemoryTier::Warm:
+            return 16;
+
+        case EMemoryTier::Cold:
+            return 8;
+
+        case EMemoryTier::Archive:
+            return 4;
+
+        case EMemoryTier::Hot:
+        default:
+            return 32;
+    }
+}
+
+uint32 FNarrowBandQuantization::GetEncodedSize(EMemoryTier Tier, uint32 ValueCount)
+{
+    return static_cast<uint32>((static_cast<uint64>(ValueCount) * GetBitsPerValue(Tier) + 7) / 8);
+}
+
+float FNarrowBandQuantization::GetMaxError(EMemoryTier Tier, float BandWidth)
+{
+    using namespace NarrowBandQuantizationInternal;
+
+    switch (Tier)
+    {
+        case EMemoryTier::Warm:
+            // Half floats keep 11 significant bits, so rounding is within 2^-11 of the value
+            return BandWidth / 2048.0f;
+
+        case EMemoryTier::Cold:
+            return SafeBandWidth(BandWidth) / (2 * ByteLevels);
+
+        case EMemoryTier::Archive:
+            return SafeBandWidth(BandWidth) / (2 * NibbleLevels);
+
+        case EMemoryTier::Hot:
+        default:
+            return 0.0f;
+    }
+}
+
+void FNarrowBandQuantization::Encode(EMemoryTier Tier, const float* Values, uint32 FirstValue, uint32 Count, float BandWidth, uint8* Encoded)
+{
+    using namespace NarrowBandQuantizationInternal;
+
+    switch (Tier)
+    {
+        case EMemoryTier::Warm:
+            EncodeHalves(Values, Count, reinterpret_cast<uint16*>(Encoded) + FirstValue);
+            break;
+
+        case EMemoryTier::Cold:
+            EncodeBytes(Values, Count, BandWidth, reinterpret_cast<int8*>(Encoded) + FirstValue);
+            break;
+
+        case EMemoryTier::Archive:
+            EncodeNibbles(Values, FirstValue, Count, BandWidth, Encoded);
+            break;
+
+        case EMemoryTier::Hot:
+        default:
+            FMemory::Memcpy(reinterpret_cast<float*>(Encoded) + FirstValue, Values, Count * sizeof(float));
+            break;
+    }
+}
+
+void FNarrowBandQuantization::Decode(EMemoryTier Tier, const uint8* Encoded, uint32 FirstValue, uint32 Count, float BandWidth, float* OutValues)
+{
+    using namespace NarrowBandQuantizationInternal;
+
+    switch (Tier)
+    {
+        case EMemoryTier::Warm:
+            DecodeHalves(reinterpret_cast<const uint16*>(Encoded) + FirstValue, Count, OutValues);
+            break;
+
+        case EMemoryTier::Cold:
+            DecodeBytes(reinterpret_cast<const int8*>(Encoded) + FirstValue, Count, BandWidth, OutValues);
+            break;
+
+        case EMemoryTier::Archive:
+            DecodeNibbles(Encoded, FirstValue, Count, BandWidth, OutValues);
+            break;
+
+        case EMemoryTier::Hot:
+        default:
+            FMemory::Memcpy(OutValues, reinterpret_cast<const float*>(Encoded) + FirstValue, Count * sizeof(float));
+            break;
+    }
+}
+
+void FNarrowBandQuantization::Convert(uint8* Block, uint32 ValueCount, EMemoryTier FromTier, float FromBandWidth, EMemoryTier ToTier, float ToBandWidth)
+{
+    using namespace NarrowBandQuantizationInternal;
+
+    // Float tiers do not depend on the band width
+    const bool bNormalized = FromTier == EMemoryTier::Cold || FromTier == EMemoryTier::Archive;
+    if (FromTier == ToTier && (!bNormalized || FromBandWidth == ToBandWidth))
+    {
+        return;
+    }
+
+    // Each chunk is decoded to the stack and re-encoded at the same value indices. Narrowing walks
+    // forward, so writes only land on bytes already read; widening walks backward from the end,
+    // so writes only land on bytes of chunks already converted.
+    float Chunk[ConvertChunkSize];
+    const uint32 ChunkCount = FMath::DivideAndRoundUp(ValueCount, ConvertChunkSize);
+    const bool bForward = GetBitsPerValue(ToTier) <= GetBitsPerValue(FromTier);
+
+    for (uint32 Step = 0; Step < ChunkCount; ++Step)
+    {
+        const uint32 First = (bForward ? Step : ChunkCount - 1 - Step) * ConvertChunkSize;
+        const uint32 Count = FMath::Min(ConvertChunkSize, ValueCount - First);
+        Decode(FromTier, Block, First, Count, FromBandWidth, Chunk);
+        Encode(ToTier, Chunk, First, Count, ToBandWidth, Block);
+    }
+}
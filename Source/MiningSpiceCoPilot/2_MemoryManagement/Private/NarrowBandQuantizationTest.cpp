@@ -0,0 +1,114 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "NarrowBandQuantization.h"
+#include "NarrowBandAllocator.h"
+
+/**
+ * Test program for narrow-band precision tiers
+ * Fills pool blocks with a sphere distance field, converts the pool through each tier and checks
+ * that decoded values stay within the tier's error bound, that narrow tiers release block tails
+ * and that a block sized for a narrow tier refuses to widen
+ */
+void TestNarrowBandQuantization()
+{
+    // Encoding a partial range at an odd offset leaves neighbouring Archive values alone
+    {
+        const float Values[3] = { 1.0f, -2.0f, 0.5f };
+        uint8 Encoded[4] = { 0, 0, 0, 0 };
+        FNarrowBandQuantization::Encode(EMemoryTier::Archive, Values, 1, 3, 2.0f, Encoded);
+
+        float Decoded[5];
+        FNarrowBandQuantization::Decode(EMemoryTier::Archive, Encoded, 0, 5, 2.0f, Decoded);
+        const float Bound = FNarrowBandQuantization::GetMaxError(EMemoryTier::Archive, 2.0f);
+        verifyf(Decoded[0] == 0.0f && Decoded[4] == 0.0f, TEXT("neighbouring 4-bit values are preserved"));
+        verifyf(FMath::Abs(Decoded[1] - 1.0f) <= Bound && FMath::Abs(Decoded[2] + 2.0f) <= Bound && FMath::Abs(Decoded[3] - 0.5f) <= Bound,
+            TEXT("odd-offset 4-bit values decode within the bound"));
+    }
+
+    // Pool conversion through every tier
+    {
+        const uint32 BlockBytes = 64 * 1024;
+        const float BandWidth = 3.0f;
+        FNarrowBandAllocator Pool(TEXT("QuantizationTest"), BlockBytes, 8);
+        Pool.SetBandWidth(BandWidth);
+        Pool.Initialize();
+
+        const uint32 ValueCount = Pool.GetValuesPerBlock();
+        verifyf(ValueCount == BlockBytes / sizeof(float), TEXT("hot blocks hold one float per four bytes"));
+
+        // Distances to a sphere through a row-major 32x32x16 brick, in voxels, most inside the band
+        TArray<float> Expected;
+        Expected.SetNumUninitialized(ValueCount);
+        for (uint32 Index = 0; Index < ValueCount; ++Index)
+        {
+            const FVector Position(Index % 32, (Index / 32) % 32, Index / 1024);
+            Expected[Index] = FMath::Clamp(static_cast<float>((Position - FVector(16.0f, 16.0f, 8.0f)).Size() - 7.0f), -BandWidth, BandWidth);
+        }
+
+        TArray<void*> Blocks;
+        for (int32 BlockIndex = 0; BlockIndex < 4; ++BlockIndex)
+        {
+            void* Ptr = Pool.Allocate();
+            Blocks.Add(Ptr);
+            Pool.WriteValues(Ptr, 0, ValueCount, Expected.GetData());
+        }
+
+        const uint64 HotResidentBytes = Pool.GetResidentBytes();
+        TArray<float> Decoded;
+        Decoded.SetNumUninitialized(ValueCount);
+
+        // Each narrowing step re-quantizes the previous tier's values, so errors add up
+        float Bound = 0.0f;
+
+        for (EMemoryTier Tier : { EMemoryTier::Warm, EMemoryTier::Cold, EMemoryTier::Archive })
+        {
+            verifyf(Pool.SetPrecisionTier(Tier), TEXT("allocated blocks convert to a narrower tier"));
+
+            Bound += FNarrowBandQuantization::GetMaxError(Tier, BandWidth);
+            float MaxError = 0.0f;
+            for (void* Ptr : Blocks)
+            {
+                Pool.ReadValues(Ptr, 0, ValueCount, Decoded.GetData());
+                for (uint32 Index = 0; Index < ValueCount; ++Index)
+                {
+                    MaxError = FMath::Max(MaxError, FMath::Abs(Decoded[Index] - Expected[Index]));
+                }
+            }
+
+            UE_LOG(LogTemp, Display, TEXT("  Tier %d: max error %f, bound %f, resident %llu of %llu bytes"),
+                static_cast<int32>(Tier), MaxError, Bound, Pool.GetResidentBytes(), HotResidentBytes);
+            verifyf(MaxError <= Bound * 1.001f, TEXT("decoded values stay within the tier error bound"));
+        }
+
+        verifyf(Pool.GetResidentBytes() <= HotResidentBytes / 4, TEXT("archive blocks release their unused pages"));
+
+        const float ArchiveValue = Pool.ReadValue(Blocks[0], 100);
+        verifyf(Pool.SetPrecisionTier(EMemoryTier::Hot) && Pool.GetResidentBytes() == HotResidentBytes, TEXT("widening recommits the block tails"));
+        verifyf(Pool.ReadValue(Blocks[0], 100) == ArchiveValue, TEXT("widening keeps decoded values exactly"));
+
+        for (void* Ptr : Blocks)
+        {
+            Pool.Free(Ptr);
+        }
+
+        TArray<FString> Errors;
+        verifyf(Pool.Validate(Errors), TEXT("pool validates after conversions"));
+        Pool.Shutdown();
+    }
+
+    // A pool laid out for a narrow tier cannot widen while it holds values
+    {
+        FNarrowBandAllocator Pool(TEXT("QuantizationNarrowTest"), 256, 8);
+        Pool.SetPrecisionTier(EMemoryTier::Cold);
+        Pool.Initialize();
+        verifyf(Pool.GetValuesPerBlock() == Pool.GetBlockSize(), TEXT("cold blocks hold one value per byte"));
+
+        void* Ptr = Pool.Allocate();
+        verifyf(!Pool.SetPrecisionTier(EMemoryTier::Hot) && Pool.GetPrecisionTier() == EMemoryTier::Cold,
+            TEXT("widening past the block size is refused"));
+        Pool.Free(Ptr);
+        Pool.Shutdown();
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("Narrow-band quantization test completed"));
+}
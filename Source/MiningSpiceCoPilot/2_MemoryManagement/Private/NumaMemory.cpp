@@ -0,0 +1,191 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "NumaMemory.h"
+#include "HAL/PlatformMemory.h"
+
+#if PLATFORM_LINUX
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+
+namespace NumaMemoryLinux
+{
+    /** Bits in the node masks passed to the kernel */
+    constexpr int32 MaxNodes = 1024;
+
+    constexpr int32 BitsPerWord = 8 * sizeof(unsigned long);
+
+    /**
+     * Reads a sysfs id list such as "0-3,8-11" and calls Visit for every id in it
+     * @return False if the file cannot be read or parsed
+     */
+    template <typename VisitorType>
+    bool ParseSysfsList(const char* Path, VisitorType Visit)
+    {
+        FILE* File = fopen(Path, "r");
+        if (!File)
+        {
+            return false;
+        }
+
+        char Line[4096];
+        const bool bRead = fgets(Line, sizeof(Line), File) != nullptr;
+        fclose(File);
+        if (!bRead)
+        {
+            return false;
+        }
+
+        for (char* Cursor = Line; *Cursor && *Cursor != '\n';)
+        {
+            char* End = nullptr;
+            const long First = strtol(Cursor, &End, 10);
+            if (End == Cursor)
+            {
+                return false;
+            }
+
+            long Last = First;
+            Cursor = End;
+            if (*Cursor == '-')
+            {
+                Last = strtol(Cursor + 1, &End, 10);
+                Cursor = End;
+            }
+
+            for (long Id = First; Id <= Last; ++Id)
+            {
+                Visit(static_cast<int32>(Id));
+            }
+
+            if (*Cursor == ',')
+            {
+                ++Cursor;
+            }
+        }
+        return true;
+    }
+}
+#endif
+
+int32 FNumaMemory::GetNodeCount()
+{
+#if PLATFORM_LINUX
+    // Node ids can have gaps, so count up to the highest online id
+    static const int32 NodeCount = []()
+    {
+        int32 HighestNode = 0;
+        NumaMemoryLinux::ParseSysfsList("/sys/devices/system/node/online",
+            [&HighestNode](int32 NodeId) { HighestNode = FMath::Max(HighestNode, NodeId); });
+        return FMath::Min(HighestNode + 1, NumaMemoryLinux::MaxNodes);
+    }();
+    return NodeCount;
+#else
+    return 1;
+#endif
+}
+
+bool FNumaMemory::BindRange(void* Ptr, uint64 Size, int32 NodeId)
+{
+#if PLATFORM_LINUX
+    if (!Ptr || Size == 0 || NodeId < INDEX_NONE || NodeId >= GetNodeCount())
+    {
+        return false;
+    }
+
+    if (NodeId == INDEX_NONE)
+    {
+        return syscall(SYS_mbind, Ptr, Size, MPOL_DEFAULT, nullptr, 0, 0) == 0;
+    }
+
+    // The kernel reads one bit fewer than the node count it is given
+    unsigned long NodeMask[NumaMemoryLinux::MaxNodes / NumaMemoryLinux::BitsPerWord] = {};
+    NodeMask[NodeId / NumaMemoryLinux::BitsPerWord] |= 1ul << (NodeId % NumaMemoryLinux::BitsPerWord);
+    return syscall(SYS_mbind, Ptr, Size, MPOL_PREFERRED, NodeMask, NumaMemoryLinux::MaxNodes + 1, MPOL_MF_MOVE) == 0;
+#else
+    return false;
+#endif
+}
+
+bool FNumaMemory::TouchRangeOnNode(void* Ptr, uint64 Size, int32 NodeId)
+{
+#if PLATFORM_LINUX
+    if (!Ptr || NodeId < 0 || NodeId >= GetNodeCount())
+    {
+        return false;
+    }
+
+    char Path[64];
+    snprintf(Path, sizeof(Path), "/sys/devices/system/node/node%d/cpulist", NodeId);
+
+    cpu_set_t NodeCPUs;
+    CPU_ZERO(&NodeCPUs);
+    int32 CPUCount = 0;
+    const bool bParsed = NumaMemoryLinux::ParseSysfsList(Path, [&NodeCPUs, &CPUCount](int32 CPU)
+    {
+        if (CPU >= 0 && CPU < CPU_SETSIZE)
+        {
+            CPU_SET(CPU, &NodeCPUs);
+            CPUCount++;
+        }
+    });
+
+    cpu_set_t PreviousCPUs;
+    if (!bParsed || CPUCount == 0 ||
+        sched_getaffinity(0, sizeof(PreviousCPUs), &PreviousCPUs) != 0 ||
+        sched_setaffinity(0, sizeof(NodeCPUs), &NodeCPUs) != 0)
+    {
+        return false;
+    }
+
+    // Reading maps the shared zero page and the write then allocates a private page on the node
+    // the thread runs on, keeping whatever the page held
+    const uint64 PageSize = FPlatformMemory::FPlatformVirtualMemoryBlock::GetCommitAlignment();
+    for (uint64 Offset = 0; Offset < Size; Offset += PageSize)
+    {
+        volatile uint8* Byte = static_cast<uint8*>(Ptr) + Offset;
+        *Byte = *Byte;
+    }
+
+    sched_setaffinity(0, sizeof(PreviousCPUs), &PreviousCPUs);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool FNumaMemory::GetPageNodes(const void* const* Pages, int32 Count, int32* OutNodes)
+{
+#if PLATFORM_LINUX
+    // Without target nodes move_pages moves nothing and only reports where each page is
+    constexpr int32 BatchSize = 1024;
+    void* Batch[BatchSize];
+    int Status[BatchSize];
+
+    for (int32 First = 0; First < Count; First += BatchSize)
+    {
+        const int32 BatchCount = FMath::Min(BatchSize, Count - First);
+        for (int32 Index = 0; Index < BatchCount; ++Index)
+        {
+            Batch[Index] = const_cast<void*>(Pages[First + Index]);
+        }
+
+        if (syscall(SYS_move_pages, 0, static_cast<unsigned long>(BatchCount), Batch, nullptr, Status, 0) != 0)
+        {
+            return false;
+        }
+
+        // Pages that were never written or were released report a negative error
+        for (int32 Index = 0; Index < BatchCount; ++Index)
+        {
+            OutNodes[First + Index] = Status[Index] >= 0 ? Status[Index] : INDEX_NONE;
+        }
+    }
+    return true;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,133 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PoolAddressMap.h"
+#include "Interfaces/IPoolAllocator.h"
+
+FPoolAddressMap::FPoolAddressMap()
+    : LeafCount(0)
+    , MappedRegionCount(0)
+{
+    for (std::atomic<FLeaf*>& Leaf : Root)
+    {
+        Leaf.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+FPoolAddressMap::~FPoolAddressMap()
+{
+    for (std::atomic<FLeaf*>& Leaf : Root)
+    {
+        delete Leaf.load(std::memory_order_relaxed);
+    }
+}
+
+bool FPoolAddressMap::Register(const void* Base, uint64 Size, IPoolAllocator* Pool)
+{
+    UPTRINT FirstRegion = 0;
+    UPTRINT EndRegion = 0;
+    if (!Pool || !GetRegionRange(Base, Size, FirstRegion, EndRegion))
+    {
+        UE_LOG(LogTemp, Error, TEXT("FPoolAddressMap::Register - Range at %p of %llu bytes is not aligned to %llu byte regions"),
+            Base, Size, RegionSize);
+        return false;
+    }
+
+    // Check the whole range before writing anything so a failed registration leaves no entries
+    for (UPTRINT Region = FirstRegion; Region < EndRegion; ++Region)
+    {
+        const FLeaf* Leaf = Root[Region >> LeafBits].load(std::memory_order_relaxed);
+        IPoolAllocator* Owner = Leaf ? Leaf->Entries[Region & (LeafSize - 1)].load(std::memory_order_relaxed) : nullptr;
+        if (Owner && Owner != Pool)
+        {
+            UE_LOG(LogTemp, Error, TEXT("FPoolAddressMap::Register - Range at %p overlaps pool '%s'"),
+                Base, *Owner->GetPoolName().ToString());
+            return false;
+        }
+    }
+
+    for (UPTRINT Region = FirstRegion; Region < EndRegion; ++Region)
+    {
+        std::atomic<FLeaf*>& RootEntry = Root[Region >> LeafBits];
+        FLeaf* Leaf = RootEntry.load(std::memory_order_relaxed);
+        if (!Leaf)
+        {
+            // Entries must read as null before the leaf is published
+            Leaf = new FLeaf();
+            for (std::atomic<IPoolAllocator*>& Entry : Leaf->Entries)
+            {
+                Entry.store(nullptr, std::memory_order_relaxed);
+            }
+            RootEntry.store(Leaf, std::memory_order_release);
+            LeafCount++;
+        }
+
+        std::atomic<IPoolAllocator*>& Entry = Leaf->Entries[Region & (LeafSize - 1)];
+        if (!Entry.load(std::memory_order_relaxed))
+        {
+            MappedRegionCount++;
+        }
+        Entry.store(Pool, std::memory_order_release);
+    }
+
+    return true;
+}
+
+void FPoolAddressMap::Unregister(const void* Base, uint64 Size, IPoolAllocator* Pool)
+{
+    UPTRINT FirstRegion = 0;
+    UPTRINT EndRegion = 0;
+    if (!GetRegionRange(Base, Size, FirstRegion, EndRegion))
+    {
+        return;
+    }
+
+    for (UPTRINT Region = FirstRegion; Region < EndRegion; ++Region)
+    {
+        FLeaf* Leaf = Root[Region >> LeafBits].load(std::memory_order_relaxed);
+        if (!Leaf)
+        {
+            continue;
+        }
+
+        std::atomic<IPoolAllocator*>& Entry = Leaf->Entries[Region & (LeafSize - 1)];
+        if (Entry.load(std::memory_order_relaxed) == Pool)
+        {
+            Entry.store(nullptr, std::memory_order_release);
+            MappedRegionCount--;
+        }
+    }
+}
+
+void FPoolAddressMap::Empty()
+{
+    for (std::atomic<FLeaf*>& RootEntry : Root)
+    {
+        if (FLeaf* Leaf = RootEntry.load(std::memory_order_relaxed))
+        {
+            for (std::atomic<IPoolAllocator*>& Entry : Leaf->Entries)
+            {
+                Entry.store(nullptr, std::memory_order_release);
+            }
+        }
+    }
+
+    MappedRegionCount = 0;
+}
+
+SIZE_T FPoolAddressMap::GetAllocatedSize() const
+{
+    return sizeof(Root) + static_cast<SIZE_T>(LeafCount) * sizeof(FLeaf);
+}
+
+bool FPoolAddressMap::GetRegionRange(const void* Base, uint64 Size, UPTRINT& OutFirstRegion, UPTRINT& OutEndRegion)
+{
+    const UPTRINT Address = reinterpret_cast<UPTRINT>(Base);
+    if (!Base || Size == 0 || (Address & (RegionSize - 1)) != 0 || (Size & (RegionSize - 1)) != 0)
+    {
+        return false;
+    }
+
+    OutFirstRegion = Address >> RegionShift;
+    OutEndRegion = OutFirstRegion + (Size >> RegionShift);
+    return OutEndRegion <= (static_cast<UPTRINT>(1) << (RootBits + LeafBits));
+}
@@ -0,0 +1,204 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PoolHandleTable.h"
+
+namespace PoolHandleTableInternal
+{
+    /** Packs a slot's generation and block index */
+    FORCEINLINE uint64 MakeEntry(uint32 Generation, uint32 BlockIndex)
+    {
+        return (static_cast<uint64>(Generation) << 32) | BlockIndex;
+    }
+
+    /** Gets the generation after another, skipping 0 so no handle is ever InvalidHandle */
+    FORCEINLINE uint32 NextGeneration(uint32 Generation)
+    {
+        const uint32 Next = (Generation + 1) & ((1u << FPoolHandleTable::GenerationBits) - 1);
+        return Next == 0 ? 1 : Next;
+    }
+}
+
+FPoolHandleTable::FPoolHandleTable()
+    : SlotCount(0)
+    , HandleCount(0)
+{
+    for (std::atomic<FSlot*>& Page : Pages)
+    {
+        Page.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+FPoolHandleTable::~FPoolHandleTable()
+{
+    for (std::atomic<FSlot*>& Page : Pages)
+    {
+        delete[] Page.load(std::memory_order_relaxed);
+    }
+}
+
+uint32 FPoolHandleTable::Add(uint32 BlockIndex)
+{
+    using namespace PoolHandleTableInternal;
+
+    uint32 SlotIndex;
+    if (FreeSlots.Num() > 0)
+    {
+        SlotIndex = FreeSlots.Pop(EAllowShrinking::No);
+    }
+    else
+    {
+        if (SlotCount == MaxHandles)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("FPoolHandleTable::Add - All %u handles are in use"), MaxHandles);
+            return InvalidHandle;
+        }
+
+        // Slot 0 of each new page starts at generation 1 like every other slot
+        SlotIndex = SlotCount++;
+        if ((SlotIndex & (PageSize - 1)) == 0)
+        {
+            FSlot* Page = new FSlot[PageSize];
+            for (uint32 Index = 0; Index < PageSize; ++Index)
+            {
+                Page[Index].store(MakeEntry(1, FreeEntry), std::memory_order_relaxed);
+            }
+            Pages[SlotIndex >> PageBits].store(Page, std::memory_order_release);
+        }
+    }
+
+    if (static_cast<uint32>(BlockSlots.Num()) <= BlockIndex)
+    {
+        const int32 OldNum = BlockSlots.Num();
+        BlockSlots.SetNumUninitialized(BlockIndex + 1);
+        FMemory::Memset(BlockSlots.GetData() + OldNum, 0xFF, (BlockSlots.Num() - OldNum) * sizeof(uint32));
+    }
+    BlockSlots[BlockIndex] = SlotIndex;
+
+    FSlot& Slot = GetSlot(SlotIndex);
+    const uint32 Generation = static_cast<uint32>(Slot.load(std::memory_order_relaxed) >> 32);
+    Slot.store(MakeEntry(Generation, BlockIndex), std::memory_order_release);
+
+    HandleCount++;
+    return (Generation << IndexBits) | SlotIndex;
+}
+
+int32 FPoolHandleTable::Remove(uint32 Handle)
+{
+    using namespace PoolHandleTableInternal;
+
+    const int32 BlockIndex = Resolve(Handle);
+    if (BlockIndex == INDEX_NONE)
+    {
+        return INDEX_NONE;
+    }
+
+    // Advancing the generation is what makes copies of the handle stale
+    const uint32 SlotIndex = Handle & (MaxHandles - 1);
+    GetSlot(SlotIndex).store(MakeEntry(NextGeneration(Handle >> IndexBits), FreeEntry), std::memory_order_release);
+    BlockSlots[BlockIndex] = FreeEntry;
+    FreeSlots.Add(SlotIndex);
+
+    HandleCount--;
+    return BlockIndex;
+}
+
+void FPoolHandleTable::MoveBlock(uint32 FromBlock, uint32 ToBlock)
+{
+    if (!HasHandle(FromBlock))
+    {
+        return;
+    }
+
+    const uint32 SlotIndex = BlockSlots[FromBlock];
+    BlockSlots[FromBlock] = FreeEntry;
+    if (static_cast<uint32>(BlockSlots.Num()) <= ToBlock)
+    {
+        const int32 OldNum = BlockSlots.Num();
+        BlockSlots.SetNumUninitialized(ToBlock + 1);
+        FMemory::Memset(BlockSlots.GetData() + OldNum, 0xFF, (BlockSlots.Num() - OldNum) * sizeof(uint32));
+    }
+    BlockSlots[ToBlock] = SlotIndex;
+    SetSlotBlock(SlotIndex, ToBlock);
+}
+
+void FPoolHandleTable::PermuteBlocks(const TArray<uint32>& Order)
+{
+    using namespace PoolHandleTableInternal;
+
+    if (HandleCount == 0)
+    {
+        return;
+    }
+
+    // One slot write per moved block that has a handle
+    TArray<uint32> NewBlockSlots;
+    NewBlockSlots.SetNumUninitialized(Order.Num());
+    FMemory::Memset(NewBlockSlots.GetData(), 0xFF, NewBlockSlots.Num() * sizeof(uint32));
+
+    uint32 MovedHandles = 0;
+    for (int32 NewIndex = 0; NewIndex < Order.Num(); ++NewIndex)
+    {
+        const uint32 OldIndex = Order[NewIndex];
+        if (HasHandle(OldIndex))
+        {
+            const uint32 SlotIndex = BlockSlots[OldIndex];
+            BlockSlots[OldIndex] = FreeEntry;
+            NewBlockSlots[NewIndex] = SlotIndex;
+            SetSlotBlock(SlotIndex, static_cast<uint32>(NewIndex));
+            MovedHandles++;
+        }
+    }
+
+    // Blocks left out of the order are free now, so any handle still on them is retired
+    if (MovedHandles != HandleCount)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("FPoolHandleTable::PermuteBlocks - Retiring %u handles to blocks that were not kept"),
+            HandleCount - MovedHandles);
+
+        for (uint32 SlotIndex : BlockSlots)
+        {
+            if (SlotIndex != FreeEntry)
+            {
+                FSlot& Slot = GetSlot(SlotIndex);
+                const uint32 Generation = static_cast<uint32>(Slot.load(std::memory_order_relaxed) >> 32);
+                Slot.store(MakeEntry(NextGeneration(Generation), FreeEntry), std::memory_order_release);
+                FreeSlots.Add(SlotIndex);
+            }
+        }
+        HandleCount = MovedHandles;
+    }
+
+    BlockSlots = MoveTemp(NewBlockSlots);
+}
+
+void FPoolHandleTable::Empty()
+{
+    using namespace PoolHandleTableInternal;
+
+    for (uint32 SlotIndex : BlockSlots)
+    {
+        if (SlotIndex != FreeEntry)
+        {
+            FSlot& Slot = GetSlot(SlotIndex);
+            const uint32 Generation = static_cast<uint32>(Slot.load(std::memory_order_relaxed) >> 32);
+            Slot.store(MakeEntry(NextGeneration(Generation), FreeEntry), std::memory_order_release);
+            FreeSlots.Add(SlotIndex);
+        }
+    }
+
+    BlockSlots.Empty();
+    HandleCount = 0;
+}
+
+SIZE_T FPoolHandleTable::GetAllocatedSize() const
+{
+    const SIZE_T PageBytes = static_cast<SIZE_T>(FMath::DivideAndRoundUp(SlotCount, PageSize)) * PageSize * sizeof(FSlot);
+    return PageBytes + FreeSlots.GetAllocatedSize() + BlockSlots.GetAllocatedSize();
+}
+
+void FPoolHandleTable::SetSlotBlock(uint32 SlotIndex, uint32 BlockIndex)
+{
+    FSlot& Slot = GetSlot(SlotIndex);
+    const uint64 Generation = Slot.load(std::memory_order_relaxed) >> 32;
+    Slot.store((Generation << 32) | BlockIndex, std::memory_order_release);
+}
@@ -0,0 +1,258 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PoolMagazineCache.h"
+
+static_assert(FPoolMagazineCache::SlotCount <= 64, "slot claims are tracked in one 64-bit word");
+
+namespace PoolMagazineCacheInternal
+{
+    /**
+     * Slots claimed by a live thread, one bit per slot
+     * Shared by all caches so a thread uses the same slot everywhere
+     */
+    static std::atomic<uint64> ClaimedSlots(0);
+
+    /** Next slot to share once every slot is claimed */
+    static std::atomic<uint32> NextSharedSlot(0);
+
+    /** The calling thread's slot; a claimed slot is given back when the thread exits */
+    struct FThreadSlotHandle
+    {
+        int32 Slot = INDEX_NONE;
+        bool bClaimed = false;
+
+        ~FThreadSlotHandle()
+        {
+            if (bClaimed)
+            {
+                ClaimedSlots.fetch_and(~(1ull << Slot), std::memory_order_release);
+            }
+        }
+    };
+
+    static thread_local FThreadSlotHandle ThreadSlot;
+
+    /** Claims the lowest free slot for the calling thread, or picks one to share if all are claimed */
+    static void AssignThreadSlot(FThreadSlotHandle& Handle)
+    {
+        const uint64 AllSlots = FPoolMagazineCache::SlotCount == 64 ? ~0ull : (1ull << FPoolMagazineCache::SlotCount) - 1;
+        uint64 Claimed = ClaimedSlots.load(std::memory_order_relaxed);
+        while ((Claimed & AllSlots) != AllSlots)
+        {
+            const int32 Slot = static_cast<int32>(FMath::CountTrailingZeros64(~Claimed));
+            if (ClaimedSlots.compare_exchange_weak(Claimed, Claimed | (1ull << Slot), std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                Handle.Slot = Slot;
+                Handle.bClaimed = true;
+                return;
+            }
+        }
+
+        // Every slot belongs to a live thread; the slot lock keeps sharing correct
+        Handle.Slot = static_cast<int32>(NextSharedSlot.fetch_add(1, std::memory_order_relaxed) % FPoolMagazineCache::SlotCount);
+    }
+
+    /** Adjusts a counter only ever written under its slot lock, without a locked instruction */
+    template<typename T>
+    static FORCEINLINE void AddToSlotCounter(std::atomic<T>& Counter, T Delta)
+    {
+        Counter.store(Counter.load(std::memory_order_relaxed) + Delta, std::memory_order_relaxed);
+    }
+}
+
+FPoolMagazineCache::FPoolMagazineCache(FRefillFunction InRefill, FFlushFunction InFlush)
+    : FullMagazineCount(0)
+    , Refill(MoveTemp(InRefill))
+    , Flush(MoveTemp(InFlush))
+{
+}
+
+FPoolMagazineCache::~FPoolMagazineCache()
+{
+    for (FSlot& Slot : Slots)
+    {
+        delete Slot.Loaded;
+        delete Slot.Previous;
+    }
+
+    while (FMagazine* Magazine = FullMagazines.Pop())
+    {
+        delete Magazine;
+    }
+
+    while (FMagazine* Magazine = EmptyMagazines.Pop())
+    {
+        delete Magazine;
+    }
+}
+
+int32 FPoolMagazineCache::Allocate()
+{
+    using namespace PoolMagazineCacheInternal;
+
+    FSlot& Slot = LockSlot();
+
+    if (Slot.Loaded->Count == 0)
+    {
+        if (Slot.Previous->Count > 0)
+        {
+            Swap(Slot.Loaded, Slot.Previous);
+        }
+        else if (FMagazine* Full = FullMagazines.Pop())
+        {
+            // Both magazines are empty: trade one for a full magazine from the depot
+            FullMagazineCount.fetch_sub(1, std::memory_order_relaxed);
+            EmptyMagazines.Push(Slot.Previous);
+            Slot.Previous = Slot.Loaded;
+            Slot.Loaded = Full;
+            AddToSlotCounter(Slot.CachedCount, Full->Count);
+        }
+        else
+        {
+            // Depot is empty too, so fetch a batch from the pool
+            Slot.Loaded->Count = Refill(Slot.Loaded->Blocks, MagazineSize);
+            AddToSlotCounter(Slot.CachedCount, Slot.Loaded->Count);
+        }
+    }
+
+    int32 BlockIndex = INDEX_NONE;
+    if (Slot.Loaded->Count > 0)
+    {
+        BlockIndex = static_cast<int32>(Slot.Loaded->Blocks[--Slot.Loaded->Count]);
+        AddToSlotCounter(Slot.CachedCount, static_cast<uint32>(-1));
+        AddToSlotCounter(Slot.Allocations, static_cast<uint64>(1));
+    }
+
+    UnlockSlot(Slot);
+    return BlockIndex;
+}
+
+void FPoolMagazineCache::Free(uint32 BlockIndex)
+{
+    using namespace PoolMagazineCacheInternal;
+
+    FSlot& Slot = LockSlot();
+
+    if (Slot.Loaded->Count == MagazineSize)
+    {
+        if (Slot.Previous->Count == 0)
+        {
+            Swap(Slot.Loaded, Slot.Previous);
+        }
+        else if (FullMagazineCount.load(std::memory_order_relaxed) < MaxDepotMagazines)
+        {
+            // Both magazines are full: pass one to the depot for other threads to allocate from
+            FullMagazines.Push(Slot.Previous);
+            FullMagazineCount.fetch_add(1, std::memory_order_relaxed);
+            AddToSlotCounter(Slot.CachedCount, static_cast<uint32>(-static_cast<int32>(MagazineSize)));
+            Slot.Previous = Slot.Loaded;
+            Slot.Loaded = GetEmptyMagazine();
+        }
+        else
+        {
+            // Depot is full, so the batch goes back to the pool
+            Flush(Slot.Previous->Blocks, Slot.Previous->Count);
+            AddToSlotCounter(Slot.CachedCount, static_cast<uint32>(-static_cast<int32>(Slot.Previous->Count)));
+            Slot.Previous->Count = 0;
+            Swap(Slot.Loaded, Slot.Previous);
+        }
+    }
+
+    Slot.Loaded->Blocks[Slot.Loaded->Count++] = BlockIndex;
+    AddToSlotCounter(Slot.CachedCount, 1u);
+    AddToSlotCounter(Slot.Frees, static_cast<uint64>(1));
+
+    UnlockSlot(Slot);
+}
+
+uint32 FPoolMagazineCache::GetCachedBlockCount() const
+{
+    uint32 CachedBlocks = FMath::Max(FullMagazineCount.load(std::memory_order_relaxed), 0) * MagazineSize;
+    for (const FSlot& Slot : Slots)
+    {
+        CachedBlocks += Slot.CachedCount.load(std::memory_order_relaxed);
+    }
+    return CachedBlocks;
+}
+
+void FPoolMagazineCache::GetOperationCounts(uint64& OutAllocations, uint64& OutFrees) const
+{
+    OutAllocations = 0;
+    OutFrees = 0;
+    for (const FSlot& Slot : Slots)
+    {
+        OutAllocations += Slot.Allocations.load(std::memory_order_relaxed);
+        OutFrees += Slot.Frees.load(std::memory_order_relaxed);
+    }
+}
+
+FPoolMagazineCache::FSlot& FPoolMagazineCache::LockSlot()
+{
+    using namespace PoolMagazineCacheInternal;
+
+    FThreadSlotHandle& Handle = ThreadSlot;
+    if (Handle.Slot == INDEX_NONE)
+    {
+        AssignThreadSlot(Handle);
+    }
+
+    FSlot& Slot = Slots[Handle.Slot];
+    LockSlot(Slot);
+
+    if (!Slot.Loaded)
+    {
+        Slot.Loaded = GetEmptyMagazine();
+        Slot.Previous = GetEmptyMagazine();
+    }
+
+    return Slot;
+}
+
+FPoolMagazineCache::FMagazine* FPoolMagazineCache::GetEmptyMagazine()
+{
+    FMagazine* Magazine = EmptyMagazines.Pop();
+    return Magazine ? Magazine : new FMagazine();
+}
+
+void FPoolMagazineCache::FlushAll()
+{
+    for (FSlot& Slot : Slots)
+    {
+        for (FMagazine* Magazine : { Slot.Loaded, Slot.Previous })
+        {
+            if (Magazine && Magazine->Count > 0)
+            {
+                Flush(Magazine->Blocks, Magazine->Count);
+                Magazine->Count = 0;
+            }
+        }
+        Slot.CachedCount.store(0, std::memory_order_relaxed);
+    }
+
+    while (FMagazine* Full = FullMagazines.Pop())
+    {
+        FullMagazineCount.fetch_sub(1, std::memory_order_relaxed);
+        Flush(Full->Blocks, Full->Count);
+        Full->Count = 0;
+        EmptyMagazines.Push(Full);
+    }
+}
+
+FPoolMagazineCache::FExclusiveScope::FExclusiveScope(FPoolMagazineCache& InCache)
+    : Cache(InCache)
+{
+    for (FSlot& Slot : Cache.Slots)
+    {
+        FPoolMagazineCache::LockSlot(Slot);
+    }
+
+    Cache.FlushAll();
+}
+
+FPoolMagazineCache::FExclusiveScope::~FExclusiveScope()
+{
+    for (FSlot& Slot : Cache.Slots)
+    {
+        FPoolMagazineCache::UnlockSlot(Slot);
+    }
+}
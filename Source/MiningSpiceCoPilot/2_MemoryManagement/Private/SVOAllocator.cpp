@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "SVOAllocator.h"
+#include "NumaMemory.h"
 #include "HAL/PlatformMath.h"
 #include "Misc/ScopeLock.h"
 #include "Math/UnrealMathSSE.h"
@@ -44,17 +45,24 @@ FSVOAllocator::FSVOAllocator(const FName& InPoolName, uint32 InBlockSize, uint32
     : IPoolAllocator()
     , PoolName(InPoolName)
     , BlockSize(InBlockSize < 8u ? 8u : InBlockSize) // Ensure minimum block size
-    , PoolMemory(nullptr)
     , MaxBlockCount(InBlockCount)
     , CurrentBlockCount(0)
+    , MagazineCache(
+        [this](uint32* OutBlockIndices, uint32 MaxCount) { return AllocateBatch(OutBlockIndices, MaxCount); },
+        [this](const uint32* BlockIndices, uint32 Count) { FreeBatch(BlockIndices, Count); })
     , bIsInitialized(false)
     , bAllowsGrowth(InAllowGrowth)
+    , bDebugTracking(false)
+    , bLazySegmentRelease(false)
     , AccessPattern(InAccessPattern)
     , ZOrderMappingFunction(&FSVOAllocator::DefaultZOrderMapping)
     , bStatsDirty(true)
 {
     // Align block size to 16 bytes for SIMD operations
     BlockSize = Align(BlockSize, 16);
+    
+    // Traversals jump between nodes all over the pool, so back it with huge pages where available
+    Storage.SetHugePages(true);
 }
 
 FSVOAllocator::~FSVOAllocator()
@@ -84,6 +92,7 @@ bool FSVOAllocator::Initialize()
 
 void FSVOAllocator::Shutdown()
 {
+    FPoolMagazineCache::FExclusiveScope CacheScope(MagazineCache);
     FScopeLock Lock(&PoolLock);
     
     if (!bIsInitialized)
@@ -112,23 +121,37 @@ uint32 FSVOAllocator::GetBlockSize() const
 
 void* FSVOAllocator::Allocate(const UObject* RequestingObject, FName AllocationTag)
 {
-    FScopeLock Lock(&PoolLock);
-    
     if (!bIsInitialized)
     {
         return nullptr;
     }
     
-    if (FreeBlocks.Num() == 0)
+    // Untracked allocations come from the calling thread's magazine without the pool lock;
+    // tags and owners are only worth the lock when debug tracking will record them
+    if (!bDebugTracking || (!RequestingObject && AllocationTag.IsNone()))
     {
-        // No free blocks, try to grow if allowed
-        uint32 growAmount = MaxBlockCount / 4;
-        if (growAmount < 32u) 
+        int32 CachedIndex = MagazineCache.Allocate();
+        if (CachedIndex == INDEX_NONE)
         {
-            growAmount = 32u;
+            return nullptr;
         }
         
-        if (!bAllowsGrowth || !Grow(growAmount))
+        Storage.MarkBlockHeld(CachedIndex);
+        return Storage.GetBlock(CachedIndex);
+    }
+    
+    FScopeLock Lock(&PoolLock);
+    
+    if (!bIsInitialized)
+    {
+        return nullptr;
+    }
+    
+    // Reuse a released segment before reserving a new one
+    if (FreeBlocks.Num() == 0 && !RecommitReleasedSegment())
+    {
+        // No free blocks, try to grow by one segment if allowed
+        if (!bAllowsGrowth || !Grow(Storage.GetBlocksPerSegment()))
         {
             // Could not grow the pool
             CachedStats.AllocationFailures++;
@@ -141,13 +164,11 @@ void* FSVOAllocator::Allocate(const UObject* RequestingObject, FName AllocationT
     uint32 BlockIndex = FreeBlocks.Pop(EAllowShrinking::No);
     
     // Mark as allocated and set metadata
-    BlockMetadata[BlockIndex].bAllocated = true;
-    BlockMetadata[BlockIndex].AllocationTag = AllocationTag;
-    BlockMetadata[BlockIndex].RequestingObject = RequestingObject;
-    BlockMetadata[BlockIndex].AllocationTime = FPlatformTime::Seconds();
+    MarkBlockAllocated(BlockIndex, RequestingObject, AllocationTag, FPlatformTime::Seconds());
+    Storage.MarkBlockHeld(BlockIndex);
     
     // Calculate address of the block
-    void* Ptr = PoolMemory + (BlockIndex * BlockSize);
+    void* Ptr = Storage.GetBlock(BlockIndex);
     
     // Update stats
     bStatsDirty = true;
@@ -163,37 +184,94 @@ bool FSVOAllocator::Free(void* Ptr)
         return false;
     }
     
-    FScopeLock Lock(&PoolLock);
-    
-    // Find which block this is
+    // Block lookup reads only the storage base and published block count, so it needs no lock
     int32 BlockIndex = GetBlockIndex(Ptr);
     if (BlockIndex == INDEX_NONE)
     {
         return false;
     }
     
-    // Check if already freed
-    if (!BlockMetadata[BlockIndex].bAllocated)
+    // Only one free of a block can clear its held mark, so a second free stops here. Blocks owned
+    // by a handle are never held, so a pointer resolved from a handle stops here too.
+    if (!Storage.TryReleaseHeldBlock(BlockIndex))
     {
+        FScopeLock Lock(&PoolLock);
+        if (Handles.HasHandle(static_cast<uint32>(BlockIndex)))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("FSVOAllocator::Free - Pool '%s' rejected free of block %d, which is owned by a handle; use FreeHandle"),
+                *PoolName.ToString(), BlockIndex);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("FSVOAllocator::Free - Pool '%s' ignored free of block %d that is not allocated"),
+                *PoolName.ToString(), BlockIndex);
+        }
         return false;
     }
     
-    // Mark as free
-    BlockMetadata[BlockIndex].bAllocated = false;
-    BlockMetadata[BlockIndex].AllocationTag = NAME_None;
-    BlockMetadata[BlockIndex].RequestingObject = nullptr;
-    BlockMetadata[BlockIndex].AllocationTime = 0.0;
+    // The block stays marked allocated until its magazine is flushed back to the pool
+    MagazineCache.Free(static_cast<uint32>(BlockIndex));
     
-    // Add to free list
-    FreeBlocks.Add(BlockIndex);
+    return true;
+}
+
+uint32 FSVOAllocator::AllocateHandle(const UObject* RequestingObject, FName AllocationTag)
+{
+    FScopeLock Lock(&PoolLock);
     
-    // Update stats
-    bStatsDirty = true;
-    CachedStats.TotalFrees++;
+    if (!bIsInitialized)
+    {
+        return FPoolHandleTable::InvalidHandle;
+    }
+    
+    // Handle-owned blocks bypass the magazines so a block never has a handle while cached
+    uint32 BlockIndex = 0;
+    if (AllocateBatch(&BlockIndex, 1) == 0)
+    {
+        return FPoolHandleTable::InvalidHandle;
+    }
+    
+    if (RequestingObject || !AllocationTag.IsNone())
+    {
+        MarkBlockAllocated(BlockIndex, RequestingObject, AllocationTag, FPlatformTime::Seconds());
+    }
     
+    const uint32 Handle = Handles.Add(BlockIndex);
+    if (Handle == FPoolHandleTable::InvalidHandle)
+    {
+        FreeBatch(&BlockIndex, 1);
+        return FPoolHandleTable::InvalidHandle;
+    }
+    
+    CachedStats.TotalAllocations++;
+    return Handle;
+}
+
+bool FSVOAllocator::FreeHandle(uint32 Handle)
+{
+    FScopeLock Lock(&PoolLock);
+    
+    const int32 BlockIndex = Handles.Remove(Handle);
+    if (BlockIndex == INDEX_NONE)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("FSVOAllocator::FreeHandle - Pool '%s' ignored free of stale handle 0x%08x"),
+            *PoolName.ToString(), Handle);
+        return false;
+    }
+    
+    const uint32 FreedIndex = static_cast<uint32>(BlockIndex);
+    FreeBatch(&FreedIndex, 1);
+    CachedStats.TotalFrees++;
     return true;
 }
 
+void* FSVOAllocator::ResolveHandle(uint32 Handle) const
+{
+    // The table and the storage base are both safe to read without the pool lock
+    const int32 BlockIndex = Handles.Resolve(Handle);
+    return BlockIndex != INDEX_NONE ? Storage.GetBlock(BlockIndex) : nullptr;
+}
+
 bool FSVOAllocator::Grow(uint32 AdditionalBlockCount, bool bForceGrowth)
 {
     FScopeLock Lock(&PoolLock);
@@ -215,41 +293,26 @@ bool FSVOAllocator::Grow(uint32 AdditionalBlockCount, bool bForceGrowth)
         return true; // Nothing to do
     }
     
-    // Store old memory info
-    uint8* OldMemory = PoolMemory;
     uint32 OldBlockCount = CurrentBlockCount;
-    uint32 NewBlockCount = OldBlockCount + AdditionalBlockCount;
     
-    // Allocate new memory
-    uint8* NewMemory = (uint8*)FMemory::Malloc(NewBlockCount * BlockSize, 16);
-    if (!NewMemory)
+    // Append whole segments; existing blocks and pointers into them are left untouched
+    uint32 AddedBlockCount = Storage.AddBlocks(AdditionalBlockCount);
+    if (AddedBlockCount == 0)
     {
         return false;
     }
     
-    // Copy existing blocks if there were any
-    if (OldMemory && OldBlockCount > 0)
-    {
-        FMemory::Memcpy(NewMemory, OldMemory, OldBlockCount * BlockSize);
-    }
-    
-    // Update pool information
-    PoolMemory = NewMemory;
+    uint32 NewBlockCount = OldBlockCount + AddedBlockCount;
     CurrentBlockCount = NewBlockCount;
     
     // Make new blocks available
-    BlockMetadata.SetNum(NewBlockCount);
+    ResizeBlockMetadata(NewBlockCount);
+    FreeBlocks.Reserve(FreeBlocks.Num() + AddedBlockCount);
     for (uint32 i = OldBlockCount; i < NewBlockCount; ++i)
     {
         FreeBlocks.Add(i);
     }
     
-    // Free old memory if we grew an existing pool
-    if (OldMemory)
-    {
-        FMemory::Free(OldMemory);
-    }
-    
     // Update stats
     bStatsDirty = true;
     CachedStats.GrowthCount++;
@@ -259,6 +322,7 @@ bool FSVOAllocator::Grow(uint32 AdditionalBlockCount, bool bForceGrowth)
 
 uint32 FSVOAllocator::Shrink(uint32 MaxBlocksToRemove)
 {
+    FPoolMagazineCache::FExclusiveScope CacheScope(MagazineCache);
     FScopeLock Lock(&PoolLock);
     
     if (!bIsInitialized || CurrentBlockCount == 0)
@@ -278,15 +342,16 @@ uint32 FSVOAllocator::Shrink(uint32 MaxBlocksToRemove)
         return 0; // Can't remove any blocks
     }
     
-    // Don't shrink below minimum capacity
+    // Don't shrink below minimum capacity; released segments no longer count towards it
     uint32 MinCapacity = AllocatedBlocks * 2;
     if (MinCapacity < 64u)
     {
         MinCapacity = 64u;
     }
-    if (CurrentBlockCount - BlocksToRemove < MinCapacity)
+    const uint32 CommittedBlockCount = CurrentBlockCount - Storage.GetReleasedSegmentCount() * Storage.GetBlocksPerSegment();
+    if (CommittedBlockCount - BlocksToRemove < MinCapacity)
     {
-        BlocksToRemove = CurrentBlockCount > MinCapacity ? CurrentBlockCount - MinCapacity : 0;
+        BlocksToRemove = CommittedBlockCount > MinCapacity ? CommittedBlockCount - MinCapacity : 0;
     }
     
     if (BlocksToRemove == 0)
@@ -294,95 +359,83 @@ uint32 FSVOAllocator::Shrink(uint32 MaxBlocksToRemove)
         return 0;
     }
     
-    // To properly shrink, we would need to relocate allocated blocks to create
-    // a contiguous free area at the end of the pool. This would require tracking
-    // all pointers to allocated blocks and updating them.
-    
-    // For this implementation, we simply verify that all blocks at the end are free,
-    // and if so, we can easily truncate the pool.
-    
-    // Sort free blocks by index (descending) to check if the highest-numbered blocks are free
-    FreeBlocks.Sort([](uint32 A, uint32 B) { return A > B; });
-    
-    // Check how many blocks at the end are contiguously free
-    uint32 ContigFreeBlocks = 0;
-    for (int32 i = 0; i < FreeBlocks.Num(); ++i)
+    // Allocated blocks are never relocated, so trailing segments with no live blocks are dropped
+    // from the pool outright. The first segment is always kept.
+    const uint32 BlocksPerSegment = Storage.GetBlocksPerSegment();
+    uint32 SegmentsToRelease = 0;
+    for (int32 SegmentIndex = Storage.GetSegmentCount() - 1; SegmentIndex > 0; --SegmentIndex)
     {
-        uint32 BlockIndex = FreeBlocks[i];
-        if (BlockIndex == CurrentBlockCount - 1 - ContigFreeBlocks)
+        if ((SegmentsToRelease + 1) * BlocksPerSegment > BlocksToRemove)
         {
-            ContigFreeBlocks++;
+            break;
         }
-        else
+        
+        const uint32 FirstBlock = static_cast<uint32>(SegmentIndex) * BlocksPerSegment;
+        if (AllocatedBits.CountSetInRange(FirstBlock, FirstBlock + BlocksPerSegment) > 0)
         {
             break;
         }
+        
+        SegmentsToRelease++;
     }
     
-    // Determine how many blocks we can actually remove
-    BlocksToRemove = BlocksToRemove < ContigFreeBlocks ? BlocksToRemove : ContigFreeBlocks;
-    if (BlocksToRemove == 0)
-    {
-        return 0;
-    }
-    
-    // Remove the highest-numbered free blocks from the free list
-    for (uint32 i = 0; i < BlocksToRemove; ++i)
+    uint32 BlocksRemoved = 0;
+    if (SegmentsToRelease > 0)
     {
-        FreeBlocks.RemoveAt(0); // Remove the highest index (first in sorted array)
+        // Drop the released blocks from the free list and metadata, then return their segments
+        uint32 NewBlockCount = CurrentBlockCount - SegmentsToRelease * BlocksPerSegment;
+        FreeBlocks.RemoveAll([NewBlockCount](uint32 BlockIndex) { return BlockIndex >= NewBlockCount; });
+        ResizeBlockMetadata(NewBlockCount);
+        BlocksRemoved = Storage.ReleaseTrailingSegments(SegmentsToRelease);
+        CurrentBlockCount = NewBlockCount;
     }
     
-    // Reduce metadata array size
-    uint32 NewBlockCount = CurrentBlockCount - BlocksToRemove;
-    BlockMetadata.SetNum(NewBlockCount);
+    // Fully free segments further down give back their pages while keeping their addresses
+    BlocksRemoved += ReleaseFreeSegments(BlocksToRemove - BlocksRemoved);
     
-    // Reallocate memory if we have any blocks left
-    if (NewBlockCount > 0)
+    // Update stats
+    if (BlocksRemoved > 0)
     {
-        uint8* NewMemory = (uint8*)FMemory::Malloc(NewBlockCount * BlockSize, 16);
-        if (NewMemory)
-        {
-            // Copy the remaining blocks
-            FMemory::Memcpy(NewMemory, PoolMemory, NewBlockCount * BlockSize);
-            
-            // Free old memory
-            FMemory::Free(PoolMemory);
-            
-            // Update pool information
-            PoolMemory = NewMemory;
-            CurrentBlockCount = NewBlockCount;
-        }
-        else
-        {
-            // Failed to allocate new memory, revert changes
-            BlockMetadata.SetNum(CurrentBlockCount);
-            BlocksToRemove = 0;
-        }
+        bStatsDirty = true;
     }
-    else
+    
+    return BlocksRemoved;
+}
+
+bool FSVOAllocator::OwnsPointer(const void* Ptr) const
+{
+    if (!bIsInitialized || !Ptr)
     {
-        // No blocks left, just free all memory
-        FMemory::Free(PoolMemory);
-        PoolMemory = nullptr;
-        CurrentBlockCount = 0;
+        return false;
     }
     
-    // Update stats
-    bStatsDirty = true;
-    
-    return BlocksToRemove;
+    // The storage range is fixed while initialized and the block count is published atomically,
+    // so this does not need the pool lock
+    return Storage.Contains(Ptr);
 }
 
-bool FSVOAllocator::OwnsPointer(const void* Ptr) const
+bool FSVOAllocator::GetReservedAddressRange(const void*& OutBase, uint64& OutSize) const
 {
-    if (!bIsInitialized || !PoolMemory || !Ptr)
+    if (!bIsInitialized)
     {
+        OutBase = nullptr;
+        OutSize = 0;
         return false;
     }
     
-    // Check if the pointer is within our memory range
-    const uint8* BytePtr = static_cast<const uint8*>(Ptr);
-    return BytePtr >= PoolMemory && BytePtr < (PoolMemory + (CurrentBlockCount * BlockSize));
+    OutBase = Storage.GetReservedBase();
+    OutSize = Storage.GetReservedBytes();
+    return OutBase != nullptr;
+}
+
+void FSVOAllocator::GetCommittedRanges(TArray<TPair<const void*, uint64>>& OutRanges) const
+{
+    FScopeLock Lock(&PoolLock);
+    
+    if (bIsInitialized)
+    {
+        Storage.GetCommittedRanges(OutRanges);
+    }
 }
 
 void FSVOAllocator::SetAccessPattern(EMemoryAccessPattern InAccessPattern)
@@ -418,11 +471,23 @@ FPoolStats FSVOAllocator::GetStats() const
         CachedStats.PeakAllocatedBlocks = CachedStats.AllocatedBlocks;
     }
     
-    return CachedStats;
+    // Blocks cached in magazines are marked allocated in the metadata but are free to callers
+    FPoolStats Stats = CachedStats;
+    uint64 CachedAllocations = 0;
+    uint64 CachedFrees = 0;
+    MagazineCache.GetOperationCounts(CachedAllocations, CachedFrees);
+    uint32 CachedBlocks = FMath::Min(MagazineCache.GetCachedBlockCount(), Stats.AllocatedBlocks);
+    Stats.AllocatedBlocks -= CachedBlocks;
+    Stats.FreeBlocks += CachedBlocks;
+    Stats.TotalAllocations += CachedAllocations;
+    Stats.TotalFrees += CachedFrees;
+    
+    return Stats;
 }
 
 bool FSVOAllocator::Defragment(float MaxTimeMs)
 {
+    FPoolMagazineCache::FExclusiveScope CacheScope(MagazineCache);
     FScopeLock Lock(&PoolLock);
     
     if (!bIsInitialized)
@@ -431,43 +496,45 @@ bool FSVOAllocator::Defragment(float MaxTimeMs)
     }
     
     // Track time to stay within budget
-    double StartTime = FPlatformTime::Seconds();
-    double EndTime = StartTime + MaxTimeMs / 1000.0;
+    double EndTime = FPlatformTime::Seconds() + MaxTimeMs / 1000.0;
     bool bDidDefragment = false;
 
-    // Calculate current fragmentation
-    uint32 FragmentCount = 0;
-    uint32 FragmentedBlocks = 0;
+    // Calculate current fragmentation: transitions between allocated and free blocks,
+    // counted from the bitmap 64 blocks at a time
+    uint32 FragmentCount = AllocatedBits.CountTransitions();
     
-    // Simple approach: count transitions between allocated and free blocks
-    bool PrevWasAllocated = false;
+    // Calculate fragmentation percentage for logging
+    float FragmentationPercentage = (CurrentBlockCount > 0) ? 
+        (100.0f * static_cast<float>(FragmentCount) / CurrentBlockCount) : 0.0f;
     
-    for (uint32 i = 0; i < CurrentBlockCount; ++i)
+    // Blocks handed out as pointers cannot move without fixing up whoever holds them, so the
+    // pool is only compacted when every allocated block is reached through a handle
+    const uint32 AllocatedCount = AllocatedBits.CountSet();
+    if (FragmentCount > 1 && AllocatedCount > 0 && AllocatedCount == Handles.Num())
     {
-        bool IsAllocated = BlockMetadata[i].bAllocated;
+        TArray<uint32> AllocatedBlocks;
+        AllocatedBits.GetSetIndices(AllocatedBlocks);
         
-        if (i > 0 && IsAllocated != PrevWasAllocated)
+        // Moving is all or nothing, so give up before touching any block if the scan used the budget
+        if (FPlatformTime::Seconds() >= EndTime)
         {
-            FragmentCount++;
+            return false;
         }
         
-        PrevWasAllocated = IsAllocated;
+        // Move all allocated blocks to the front in place; each handle's slot is updated once.
+        // Blocks are copied through every segment, so released ones must be committed again.
+        RecommitReleasedSegments();
+        Storage.PermuteBlocks(AllocatedBlocks);
+        CompactBlockMetadata(AllocatedBlocks);
         
-        // Check if we're out of time
-        if (FPlatformTime::Seconds() >= EndTime)
-        {
-            break;
-        }
+        bStatsDirty = true;
+        
+        UE_LOG(LogTemp, Verbose, TEXT("FSVOAllocator::Defragment - Compacted pool '%s' from %u fragments (%.1f%%) to 1"),
+            *PoolName.ToString(), FragmentCount, FragmentationPercentage);
+        return true;
     }
     
-    // Calculate fragmentation percentage for logging
-    float FragmentationPercentage = (CurrentBlockCount > 0) ? 
-        (100.0f * static_cast<float>(FragmentCount) / CurrentBlockCount) : 0.0f;
-    
-    // For a real implementation, we would actually move blocks around to reduce fragmentation
-    // This would require tracking all pointers to allocated blocks and updating them
-    
-    // In this simplified version, we'll just log the fragmentation
+    // Otherwise just report the fragmentation
     if (FragmentCount > 0)
     {
         UE_LOG(LogTemp, Verbose, TEXT("FSVOAllocator::Defragment - Pool '%s' has %u fragments (%.1f%%)"),
@@ -491,7 +558,7 @@ bool FSVOAllocator::Validate(TArray<FString>& OutErrors) const
         return false;
     }
     
-    if (!PoolMemory)
+    if (Storage.GetSegmentCount() == 0 || Storage.GetBlockCount() != CurrentBlockCount)
     {
         OutErrors.Add(FString::Printf(TEXT("Pool '%s' has invalid memory"), *PoolName.ToString()));
         return false;
@@ -519,32 +586,37 @@ bool FSVOAllocator::Validate(TArray<FString>& OutErrors) const
             return false;
         }
         
-        if (BlockMetadata[FreeIndex].bAllocated)
+        if (AllocatedBits.IsSet(FreeIndex))
         {
             OutErrors.Add(FString::Printf(TEXT("Pool '%s' has free index %u marked as allocated"), 
                 *PoolName.ToString(), FreeIndex));
             return false;
         }
         
+        if (Storage.IsSegmentReleased(static_cast<int32>(FreeIndex / Storage.GetBlocksPerSegment())))
+        {
+            OutErrors.Add(FString::Printf(TEXT("Pool '%s' has free index %u in a released segment"), 
+                *PoolName.ToString(), FreeIndex));
+            return false;
+        }
+        
         BlockUsed[FreeIndex] = true;
     }
     
     // Check metadata consistency
-    uint32 AllocatedCount = 0;
-    uint32 FreeCount = 0;
-    
-    for (uint32 i = 0; i < CurrentBlockCount; ++i)
+    if (AllocatedBits.Num() != CurrentBlockCount ||
+        (BlockTracking.Num() > 0 && BlockTracking.Num() != static_cast<int32>(CurrentBlockCount)))
     {
-        if (BlockMetadata[i].bAllocated)
-        {
-            AllocatedCount++;
-        }
-        else
-        {
-            FreeCount++;
-        }
+        OutErrors.Add(FString::Printf(TEXT("Pool '%s' metadata does not cover its %u blocks"), 
+            *PoolName.ToString(), CurrentBlockCount));
+        return false;
     }
     
+    // Blocks in released segments are neither allocated nor on the free list
+    uint32 AllocatedCount = AllocatedBits.CountSet();
+    uint32 ReleasedCount = Storage.GetReleasedSegmentCount() * Storage.GetBlocksPerSegment();
+    uint32 FreeCount = CurrentBlockCount - AllocatedCount - ReleasedCount;
+    
     if (FreeCount != (uint32)FreeBlocks.Num())
     {
         OutErrors.Add(FString::Printf(TEXT("Pool '%s' free count mismatch: %u in metadata, %u in free list"), 
@@ -552,10 +624,10 @@ bool FSVOAllocator::Validate(TArray<FString>& OutErrors) const
         return false;
     }
     
-    if (AllocatedCount + FreeCount != CurrentBlockCount)
+    if (AllocatedCount + FreeCount + ReleasedCount != CurrentBlockCount)
     {
-        OutErrors.Add(FString::Printf(TEXT("Pool '%s' block count mismatch: %u allocated + %u free != %u total"), 
-            *PoolName.ToString(), AllocatedCount, FreeCount, CurrentBlockCount));
+        OutErrors.Add(FString::Printf(TEXT("Pool '%s' block count mismatch: %u allocated + %u free + %u released != %u total"), 
+            *PoolName.ToString(), AllocatedCount, FreeCount, ReleasedCount, CurrentBlockCount));
         return false;
     }
     
@@ -626,6 +698,7 @@ uint32 FSVOAllocator::LookupTableZOrderMapping(uint32 x, uint32 y, uint32 z)
 
 bool FSVOAllocator::Reset()
 {
+    FPoolMagazineCache::FExclusiveScope CacheScope(MagazineCache);
     FScopeLock Lock(&PoolLock);
     
     if (!bIsInitialized)
@@ -633,17 +706,22 @@ bool FSVOAllocator::Reset()
         return false;
     }
     
-    // Clear all allocations
-    FreeBlocks.Empty(CurrentBlockCount);
+    // Every block becomes free, so bring released segments back before listing them
+    RecommitReleasedSegments();
+    
+    // Clear all allocations, their tracking entries and any handles to them
+    AllocatedBits.ClearAll();
+    Storage.ClearHeldBlocks();
+    Handles.Empty();
+    if (bDebugTracking)
+    {
+        BlockTracking.Reset();
+        BlockTracking.SetNum(CurrentBlockCount);
+    }
     
+    FreeBlocks.Empty(CurrentBlockCount);
     for (uint32 i = 0; i < CurrentBlockCount; ++i)
     {
-        // Reset metadata
-        BlockMetadata[i].bAllocated = false;
-        BlockMetadata[i].AllocationTag = NAME_None;
-        BlockMetadata[i].RequestingObject = nullptr;
-        
-        // Add to free list
         FreeBlocks.Add(i);
     }
     
@@ -662,26 +740,22 @@ bool FSVOAllocator::AllocatePoolMemory(uint32 BlockCount)
     }
     
     // Free existing memory if any
-    if (PoolMemory)
+    if (Storage.GetSegmentCount() > 0)
     {
         FreePoolMemory();
     }
     
-    // Calculate total memory size
-    uint64 TotalSize = static_cast<uint64>(BlockCount) * static_cast<uint64>(BlockSize);
-    
-    // Allocate memory aligned to 16 bytes for SIMD operations
-    PoolMemory = (uint8*)FMemory::Malloc(TotalSize, 16);
-    if (!PoolMemory)
+    // Segments are page aligned and blocks are padded to 16 bytes, so every block is SIMD aligned
+    if (!Storage.Configure(BlockSize, BlockCount) || Storage.AddBlocks(BlockCount) == 0)
     {
         return false;
     }
     
-    // Zero out the memory
-    FMemory::Memzero(PoolMemory, TotalSize);
+    // Segments are whole, so the pool may hold more blocks than requested
+    BlockCount = Storage.GetBlockCount();
     
     // Initialize metadata
-    BlockMetadata.SetNum(BlockCount);
+    ResizeBlockMetadata(BlockCount);
     
     // Initialize free blocks
     FreeBlocks.Empty(BlockCount);
@@ -706,13 +780,11 @@ bool FSVOAllocator::AllocatePoolMemory(uint32 BlockCount)
 
 void FSVOAllocator::FreePoolMemory()
 {
-    if (PoolMemory)
-    {
-        FMemory::Free(PoolMemory);
-        PoolMemory = nullptr;
-    }
+    Storage.Empty();
     
-    BlockMetadata.Empty();
+    AllocatedBits.Empty();
+    BlockTracking.Empty();
+    Handles.Empty();
     FreeBlocks.Empty();
     CurrentBlockCount = 0;
 }
@@ -734,38 +806,18 @@ void FSVOAllocator::UpdateStats() const
     CachedStats.BlockCount = CurrentBlockCount;
     CachedStats.bAllowsGrowth = bAllowsGrowth;
     
-    // Count allocations
-    uint32 AllocatedBlockCount = 0;
-    for (const auto& Metadata : BlockMetadata)
-    {
-        if (Metadata.bAllocated)
-        {
-            AllocatedBlockCount++;
-        }
-    }
+    // Count allocations from the bitmap, 64 blocks per word
+    uint32 AllocatedBlockCount = AllocatedBits.CountSet();
     
     // Update peak allocation tracking
     CachedStats.PeakAllocatedBlocks = FMath::Max(CachedStats.PeakAllocatedBlocks, AllocatedBlockCount);
     
     // Calculate memory usage
     CachedStats.AllocatedBlocks = AllocatedBlockCount;
-    CachedStats.FreeBlocks = CurrentBlockCount - AllocatedBlockCount;
+    CachedStats.FreeBlocks = CurrentBlockCount - AllocatedBlockCount - Storage.GetReleasedSegmentCount() * Storage.GetBlocksPerSegment();
     
     // Calculate fragmentation - simple transitions between allocated and free
-    uint32 FragmentCount = 0;
-    bool PrevWasAllocated = false;
-    
-    for (uint32 i = 0; i < CurrentBlockCount; ++i)
-    {
-        bool IsAllocated = BlockMetadata[i].bAllocated;
-        
-        if (i > 0 && IsAllocated != PrevWasAllocated)
-        {
-            FragmentCount++;
-        }
-        
-        PrevWasAllocated = IsAllocated;
-    }
+    uint32 FragmentCount = AllocatedBits.CountTransitions();
     
     // Simplified fragmentation metric based on the number of transitions
     CachedStats.FragmentationPercent = (CurrentBlockCount > 1) ? 
@@ -773,8 +825,10 @@ void FSVOAllocator::UpdateStats() const
     
     // Calculate overhead
     CachedStats.OverheadBytes = sizeof(FSVOAllocator) +                              // Class instance
-                                (BlockMetadata.Num() * sizeof(FBlockMetadata)) +     // Metadata
-                                (FreeBlocks.Num() * sizeof(uint32));                 // Free list
+                                AllocatedBits.GetAllocatedSize() +                   // Allocation bitmap
+                                BlockTracking.GetAllocatedSize() +                   // Tracking side table
+                                Handles.GetAllocatedSize() +                         // Handle table
+                                FreeBlocks.GetAllocatedSize();                       // Free list
     
     // Mark stats as clean
     bStatsDirty = false;
@@ -782,39 +836,246 @@ void FSVOAllocator::UpdateStats() const
 
 int32 FSVOAllocator::GetBlockIndex(const void* Ptr) const
 {
-    if (!bIsInitialized || !PoolMemory || !Ptr)
+    if (!bIsInitialized || !Ptr)
     {
         return INDEX_NONE;
     }
     
-    // Calculate offset from pool base
-    const uint8* BytePtr = static_cast<const uint8*>(Ptr);
-    ptrdiff_t Offset = BytePtr - PoolMemory;
+    // Validates that the pointer is at a block boundary inside the committed range
+    return Storage.GetBlockIndex(Ptr);
+}
+
+uint32 FSVOAllocator::AllocateBatch(uint32* OutBlockIndices, uint32 MaxCount)
+{
+    FScopeLock Lock(&PoolLock);
     
-    // Check if pointer is within pool range
-    if (Offset < 0 || Offset >= static_cast<ptrdiff_t>(CurrentBlockCount * BlockSize))
+    if (!bIsInitialized)
     {
-        return INDEX_NONE;
+        return 0;
     }
     
-    // Calculate block index
-    int32 BlockIndex = static_cast<int32>(Offset / BlockSize);
+    // Reuse a released segment before reserving a new one
+    if (FreeBlocks.Num() == 0 && !RecommitReleasedSegment())
+    {
+        // No free blocks, try to grow by one segment if allowed
+        if (!bAllowsGrowth || !Grow(Storage.GetBlocksPerSegment()))
+        {
+            CachedStats.AllocationFailures++;
+            bStatsDirty = true;
+            return 0;
+        }
+    }
     
-    // Validate that pointer is at block boundary
-    if ((Offset % BlockSize) != 0)
+    const double Now = FPlatformTime::Seconds();
+    uint32 Count = FMath::Min(MaxCount, static_cast<uint32>(FreeBlocks.Num()));
+    for (uint32 i = 0; i < Count; ++i)
     {
-        // Not at a block boundary
-        return INDEX_NONE;
+        uint32 BlockIndex = FreeBlocks.Pop(EAllowShrinking::No);
+        MarkBlockAllocated(BlockIndex, nullptr, NAME_None, Now);
+        OutBlockIndices[i] = BlockIndex;
+    }
+    
+    bStatsDirty = true;
+    return Count;
+}
+
+void FSVOAllocator::FreeBatch(const uint32* BlockIndices, uint32 Count)
+{
+    FScopeLock Lock(&PoolLock);
+    
+    for (uint32 i = 0; i < Count; ++i)
+    {
+        uint32 BlockIndex = BlockIndices[i];
+        
+        // A block freed twice reaches the pool twice; only the first return counts
+        if (BlockIndex >= CurrentBlockCount || !AllocatedBits.IsSet(BlockIndex))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("FSVOAllocator::FreeBatch - Pool '%s' ignored free of block %u that is not allocated"),
+                *PoolName.ToString(), BlockIndex);
+            continue;
+        }
+        
+        MarkBlockFree(BlockIndex);
+        FreeBlocks.Add(BlockIndex);
+    }
+    
+    bStatsDirty = true;
+}
+
+uint32 FSVOAllocator::ReleaseFreeSegments(uint32 MaxBlocks)
+{
+    const uint32 BlocksPerSegment = Storage.GetBlocksPerSegment();
+    uint32 BlocksReleased = 0;
+    for (int32 SegmentIndex = 1; SegmentIndex < Storage.GetSegmentCount() && BlocksReleased + BlocksPerSegment <= MaxBlocks; ++SegmentIndex)
+    {
+        const uint32 FirstBlock = static_cast<uint32>(SegmentIndex) * BlocksPerSegment;
+        if (!Storage.IsSegmentReleased(SegmentIndex) &&
+            AllocatedBits.CountSetInRange(FirstBlock, FirstBlock + BlocksPerSegment) == 0 &&
+            Storage.ReleaseSegment(SegmentIndex, bLazySegmentRelease) > 0)
+        {
+            BlocksReleased += BlocksPerSegment;
+        }
+    }
+    
+    if (BlocksReleased > 0)
+    {
+        FreeBlocks.RemoveAll([this, BlocksPerSegment](uint32 BlockIndex)
+        {
+            return Storage.IsSegmentReleased(static_cast<int32>(BlockIndex / BlocksPerSegment));
+        });
+    }
+    
+    return BlocksReleased;
+}
+
+bool FSVOAllocator::RecommitReleasedSegment()
+{
+    const int32 SegmentIndex = Storage.FindReleasedSegment();
+    if (SegmentIndex == INDEX_NONE)
+    {
+        return false;
+    }
+    
+    Storage.RecommitSegment(SegmentIndex);
+    
+    const uint32 BlocksPerSegment = Storage.GetBlocksPerSegment();
+    const uint32 FirstBlock = static_cast<uint32>(SegmentIndex) * BlocksPerSegment;
+    FreeBlocks.Reserve(FreeBlocks.Num() + BlocksPerSegment);
+    for (uint32 i = FirstBlock; i < FirstBlock + BlocksPerSegment; ++i)
+    {
+        FreeBlocks.Add(i);
+    }
+    
+    bStatsDirty = true;
+    return true;
+}
+
+void FSVOAllocator::RecommitReleasedSegments()
+{
+    while (RecommitReleasedSegment())
+    {
+    }
+}
+
+void FSVOAllocator::MarkBlockAllocated(uint32 BlockIndex, const UObject* RequestingObject, FName AllocationTag, double AllocationTime)
+{
+    AllocatedBits.Set(BlockIndex);
+    
+    if (bDebugTracking)
+    {
+        FBlockTrackingInfo& Tracking = BlockTracking[BlockIndex];
+        Tracking.AllocationTag = AllocationTag;
+        Tracking.RequestingObject = RequestingObject;
+        Tracking.AllocationTime = AllocationTime;
+    }
+}
+
+void FSVOAllocator::MarkBlockFree(uint32 BlockIndex)
+{
+    AllocatedBits.Clear(BlockIndex);
+    
+    if (BlockTracking.Num() > 0)
+    {
+        BlockTracking[BlockIndex] = FBlockTrackingInfo();
+    }
+}
+
+void FSVOAllocator::ResizeBlockMetadata(uint32 NewBlockCount)
+{
+    AllocatedBits.SetNum(NewBlockCount);
+    
+    // The tracking table stays empty unless tracking is on
+    if (BlockTracking.Num() > 0 || bDebugTracking)
+    {
+        BlockTracking.SetNum(NewBlockCount);
+    }
+}
+
+void FSVOAllocator::CompactBlockMetadata(const TArray<uint32>& Order)
+{
+    const uint32 MovedCount = static_cast<uint32>(Order.Num());
+    
+    // Blocks [0, MovedCount) are now allocated and everything after is free
+    AllocatedBits.SetLeading(MovedCount);
+    
+    if (BlockTracking.Num() > 0)
+    {
+        TArray<FBlockTrackingInfo> NewTracking;
+        NewTracking.SetNum(CurrentBlockCount);
+        for (uint32 i = 0; i < MovedCount; ++i)
+        {
+            NewTracking[i] = BlockTracking[Order[i]];
+        }
+        BlockTracking = MoveTemp(NewTracking);
+    }
+    
+    // One slot write per moved handle; nothing else refers to the old addresses
+    Handles.PermuteBlocks(Order);
+    
+    // Rebuild the free list from the free tail
+    FreeBlocks.Empty(CurrentBlockCount - MovedCount);
+    for (uint32 i = MovedCount; i < CurrentBlockCount; ++i)
+    {
+        FreeBlocks.Add(i);
+    }
+}
+
+void FSVOAllocator::SetDebugTracking(bool bEnable)
+{
+    FScopeLock Lock(&PoolLock);
+    
+    if (bEnable == bDebugTracking)
+    {
+        return;
     }
     
-    return BlockIndex;
+    bDebugTracking = bEnable;
+    
+    // Blocks allocated before tracking was turned on have empty entries
+    if (bEnable)
+    {
+        BlockTracking.SetNum(CurrentBlockCount);
+    }
+    else
+    {
+        BlockTracking.Empty();
+    }
+    
+    bStatsDirty = true;
+}
+
+bool FSVOAllocator::IsDebugTracking() const
+{
+    return bDebugTracking;
+}
+
+bool FSVOAllocator::SetHugePages(bool bEnable)
+{
+    FScopeLock Lock(&PoolLock);
+    
+    return Storage.SetHugePages(bEnable);
+}
+
+void FSVOAllocator::SetLazySegmentRelease(bool bEnable)
+{
+    FScopeLock Lock(&PoolLock);
+    
+    bLazySegmentRelease = bEnable;
+}
+
+uint64 FSVOAllocator::GetResidentBytes() const
+{
+    FScopeLock Lock(&PoolLock);
+    
+    return Storage.GetResidentBytes();
 }
 
 bool FSVOAllocator::MoveNextFragmentedAllocation(void*& OutOldPtr, void*& OutNewPtr, uint64& OutAllocationSize)
 {
+    FPoolMagazineCache::FExclusiveScope CacheScope(MagazineCache);
     FScopeLock Lock(&PoolLock);
     
-    if (!bIsInitialized || !PoolMemory)
+    if (!bIsInitialized || CurrentBlockCount == 0)
     {
         return false;
     }
@@ -822,61 +1083,55 @@ bool FSVOAllocator::MoveNextFragmentedAllocation(void*& OutOldPtr, void*& OutNew
     // Simple defragmentation approach: scan for non-contiguous allocated blocks
     // and move them to lower memory addresses to reduce fragmentation
     
-    // Start from the last block and find an allocated block
-    static uint32 LastCheckedIndex = 0;
-    uint32 BlockIndex = LastCheckedIndex;
-    bool bFoundAllocated = false;
+    // Gaps in released segments would be picked as targets, so bring them back first
+    RecommitReleasedSegments();
     
-    // Find the next allocated block starting from the last checked index
-    for (uint32 i = 0; i < CurrentBlockCount; ++i)
+    // Any allocated block past the first free block can move down into it. Candidates are
+    // taken round-robin from where the previous call stopped.
+    static uint32 LastCheckedIndex = 0;
+    const int32 TargetIndex = AllocatedBits.FindFirstClear(0);
+    if (TargetIndex != INDEX_NONE)
     {
-        BlockIndex = (LastCheckedIndex + i) % CurrentBlockCount;
+        int32 BlockIndex = AllocatedBits.FindFirstSet(FMath::Max(LastCheckedIndex, static_cast<uint32>(TargetIndex) + 1));
+        if (BlockIndex == INDEX_NONE)
+        {
+            BlockIndex = AllocatedBits.FindFirstSet(TargetIndex + 1);
+        }
         
-        // Check if this block is allocated
-        if (BlockMetadata[BlockIndex].bAllocated)
+        if (BlockIndex != INDEX_NONE)
         {
-            // Find the first free block with a lower index
-            uint32 TargetIndex = BlockIndex;
-            for (uint32 j = 0; j < BlockIndex; ++j)
+            // Get the pointers
+            OutOldPtr = Storage.GetBlock(BlockIndex);
+            OutNewPtr = Storage.GetBlock(TargetIndex);
+            OutAllocationSize = BlockSize;
+            
+            // Update our last checked index for the next call
+            LastCheckedIndex = (BlockIndex + 1) % CurrentBlockCount;
+            
+            // Move the memory
+            FMemory::Memcpy(OutNewPtr, OutOldPtr, BlockSize);
+            
+            // Update metadata
+            MarkBlockAllocated(TargetIndex, nullptr, NAME_None, 0.0);
+            if (BlockTracking.Num() > 0)
             {
-                if (!BlockMetadata[j].bAllocated)
-                {
-                    TargetIndex = j;
-                    bFoundAllocated = true;
-                    break;
-                }
+                BlockTracking[TargetIndex] = BlockTracking[BlockIndex];
             }
-            
-            // If we found a free block with a lower index, we can move this allocation
-            if (bFoundAllocated && TargetIndex < BlockIndex)
+            MarkBlockFree(BlockIndex);
+            Handles.MoveBlock(BlockIndex, TargetIndex);
+            if (Storage.TryReleaseHeldBlock(BlockIndex))
             {
-                // Get the pointers
-                OutOldPtr = PoolMemory + (BlockIndex * BlockSize);
-                OutNewPtr = PoolMemory + (TargetIndex * BlockSize);
-                OutAllocationSize = BlockSize;
-                
-                // Update our last checked index for the next call
-                LastCheckedIndex = (BlockIndex + 1) % CurrentBlockCount;
-                
-                // Move the memory
-                FMemory::Memcpy(OutNewPtr, OutOldPtr, BlockSize);
-                
-                // Update metadata
-                BlockMetadata[TargetIndex] = BlockMetadata[BlockIndex];
-                BlockMetadata[BlockIndex].bAllocated = false;
-                BlockMetadata[BlockIndex].AllocationTag = NAME_None;
-                BlockMetadata[BlockIndex].RequestingObject = nullptr;
-                BlockMetadata[BlockIndex].AllocationTime = 0.0;
-                
-                // Update free block list
-                FreeBlocks.Remove(TargetIndex);
-                FreeBlocks.Add(BlockIndex);
-                
-                // Stats are now dirty
-                bStatsDirty = true;
-                
-                return true;
+                Storage.MarkBlockHeld(TargetIndex);
             }
+            
+            // Update free block list
+            FreeBlocks.RemoveSingleSwap(static_cast<uint32>(TargetIndex), EAllowShrinking::No);
+            FreeBlocks.Add(BlockIndex);
+            
+            // Stats are now dirty
+            bStatsDirty = true;
+            
+            return true;
         }
     }
     
@@ -937,11 +1192,19 @@ void FSVOAllocator::SetMemoryUsageHint(EPoolMemoryUsage UsageHint)
 
 void FSVOAllocator::SetNumaNode(int32 NodeId)
 {
-    UE_LOG(LogTemp, Verbose, TEXT("FSVOAllocator(%s): Setting NUMA node to %d"), 
-        *PoolName.ToString(), NodeId);
+    FScopeLock Lock(&PoolLock);
     
-    // In a real implementation, we would bind allocations to the specified NUMA node
-    // For now, we just log the request
+    // Segments committed from now on follow the node; resident pages move where the platform can bind
+    if (Storage.SetNumaNode(NodeId))
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("FSVOAllocator(%s): Placing pool memory on NUMA node %d"), 
+            *PoolName.ToString(), NodeId);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("FSVOAllocator(%s): NUMA node %d not applied; %d node(s) available"), 
+            *PoolName.ToString(), NodeId, FNumaMemory::GetNodeCount());
+    }
 }
 
 bool FSVOAllocator::ConfigureTypeLayout(uint32 TypeId, bool bUseZOrderCurve, bool bEnablePrefetching, EMemoryAccessPattern InAccessPattern)
@@ -0,0 +1,631 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SegmentedPoolStorage.h"
+#include "NumaMemory.h"
+#include "Containers/BitArray.h"
+
+#if PLATFORM_LINUX
+#include <sys/mman.h>
+#include <errno.h>
+#endif
+
+std::atomic<uint32> FSegmentedPoolStorage::AddressRangeEpoch(0);
+
+FSegmentedPoolStorage::FSegmentedPoolStorage()
+    : Base(nullptr)
+#if !PLATFORM_LINUX
+    , BaseOffset(0)
+#endif
+    , BlockSize(0)
+    , ResidentBlockBytes(0)
+    , BlocksPerSegment(0)
+    , ReservedBytes(0)
+    , CommittedBytes(0)
+    , BlockCount(0)
+    , ReleasedSegmentCount(0)
+    , HugePageBytes(0)
+    , bHugePages(false)
+    , NumaNode(INDEX_NONE)
+    , bNumaBound(false)
+{
+}
+
+FSegmentedPoolStorage::~FSegmentedPoolStorage()
+{
+    Empty();
+}
+
+bool FSegmentedPoolStorage::Configure(uint32 InBlockSize, uint32 InitialBlockCount, uint64 TargetSegmentSize, uint64 ReservedSize)
+{
+    Empty();
+
+    BlockSize = FMath::Max(InBlockSize, 1u);
+    ResidentBlockBytes = BlockSize;
+
+    // Segments hold as many blocks as fit the target size; small pools get smaller segments,
+    // but never less than a commit granule
+    const uint64 CommitAlignment = FPlatformMemory::FPlatformVirtualMemoryBlock::GetCommitAlignment();
+    uint64 TargetBlocks = FMath::Clamp<uint64>(TargetSegmentSize / BlockSize, 1, MAX_int32);
+    uint64 GranuleBlocks = FMath::Min<uint64>((CommitAlignment + BlockSize - 1) / BlockSize, TargetBlocks);
+    BlocksPerSegment = static_cast<uint32>(FMath::Max(FMath::Min<uint64>(TargetBlocks, FMath::Max(InitialBlockCount, 1u)), GranuleBlocks));
+
+    // Block indices are handed out as int32, and the first segments must fit
+    uint64 MaxBytes = static_cast<uint64>(MAX_int32) * BlockSize;
+    uint64 InitialBytes = static_cast<uint64>(FMath::DivideAndRoundUp(FMath::Max(InitialBlockCount, 1u), BlocksPerSegment)) * GetSegmentSize();
+    ReservedBytes = Align(FMath::Min(FMath::Max(ReservedSize, InitialBytes), MaxBytes), AddressRangeAlignment);
+
+    if (!ReserveAddressSpace())
+    {
+        UE_LOG(LogTemp, Error, TEXT("FSegmentedPoolStorage::Configure - Failed to reserve %llu bytes of address space"), ReservedBytes);
+        ReservedBytes = 0;
+        return false;
+    }
+
+    bNumaBound = NumaNode != INDEX_NONE && FNumaMemory::BindRange(Base, ReservedBytes, NumaNode);
+
+    const uint64 MaxBlocks = FMath::Min<uint64>(ReservedBytes / BlockSize, MAX_int32);
+    HeldPages.SetNumZeroed(static_cast<int32>(MaxBlocks / BlocksPerSegment));
+
+    return true;
+}
+
+uint32 FSegmentedPoolStorage::AddBlocks(uint32 InBlockCount)
+{
+    if (InBlockCount == 0 || !Base)
+    {
+        return 0;
+    }
+
+    const uint32 OldBlockCount = BlockCount.load(std::memory_order_relaxed);
+    const uint64 MaxBlocks = FMath::Min<uint64>(ReservedBytes / BlockSize, MAX_int32);
+    const uint64 SegmentsNeeded = FMath::DivideAndRoundUp(InBlockCount, BlocksPerSegment);
+    const uint64 SegmentsAvailable = (MaxBlocks - OldBlockCount) / BlocksPerSegment;
+    if (SegmentsAvailable == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("FSegmentedPoolStorage::AddBlocks - Reserved range of %llu bytes is full at %u blocks"), ReservedBytes, OldBlockCount);
+        return 0;
+    }
+
+    const uint32 BlocksAdded = static_cast<uint32>(FMath::Min(SegmentsNeeded, SegmentsAvailable)) * BlocksPerSegment;
+    const uint32 NewBlockCount = OldBlockCount + BlocksAdded;
+
+    // Freshly committed pages are zero filled
+    const uint64 NewCommittedBytes = FMath::Min(Align(static_cast<uint64>(NewBlockCount) * BlockSize,
+        static_cast<uint64>(FPlatformMemory::FPlatformVirtualMemoryBlock::GetCommitAlignment())), ReservedBytes);
+    if (NewCommittedBytes > CommittedBytes)
+    {
+        CommitRange(CommittedBytes, NewCommittedBytes - CommittedBytes);
+        PlaceRange(CommittedBytes, NewCommittedBytes - CommittedBytes);
+        CommittedBytes = NewCommittedBytes;
+    }
+
+    if (ResidentBlockBytes < BlockSize)
+    {
+        DecommitBlockTails(OldBlockCount, NewBlockCount, ResidentBlockBytes);
+    }
+
+    // Advise before the blocks are published so their first writes can fault in huge pages
+    if (bHugePages)
+    {
+        AdviseHugePages();
+    }
+
+    ReleasedSegments.Add(false, BlocksAdded / BlocksPerSegment);
+
+    // Pages of segments released by an earlier shrink are still there, and still clear
+    const uint32 HeldWords = GetHeldWordsPerSegment();
+    for (uint32 SegmentIndex = OldBlockCount / BlocksPerSegment; SegmentIndex < NewBlockCount / BlocksPerSegment; ++SegmentIndex)
+    {
+        if (!HeldPages[SegmentIndex])
+        {
+            std::atomic<uint64>* Page = new std::atomic<uint64>[HeldWords];
+            for (uint32 Word = 0; Word < HeldWords; ++Word)
+            {
+                Page[Word].store(0, std::memory_order_relaxed);
+            }
+            HeldPages[SegmentIndex] = Page;
+        }
+    }
+
+    // Lock-free lookups may see the new blocks from here on
+    BlockCount.store(NewBlockCount, std::memory_order_release);
+
+    return BlocksAdded;
+}
+
+uint32 FSegmentedPoolStorage::ReleaseTrailingSegments(uint32 SegmentCount)
+{
+    const uint32 OldBlockCount = BlockCount.load(std::memory_order_relaxed);
+    const uint32 BlocksReleased = FMath::Min(SegmentCount, static_cast<uint32>(GetSegmentCount())) * BlocksPerSegment;
+    if (BlocksReleased == 0)
+    {
+        return 0;
+    }
+
+    const uint32 NewBlockCount = OldBlockCount - BlocksReleased;
+    BlockCount.store(NewBlockCount, std::memory_order_release);
+
+    // Segments released individually are now gone for good
+    const int32 NewSegmentCount = static_cast<int32>(NewBlockCount / BlocksPerSegment);
+    for (int32 SegmentIndex = NewSegmentCount; SegmentIndex < ReleasedSegments.Num(); ++SegmentIndex)
+    {
+        ReleasedSegmentCount -= ReleasedSegments[SegmentIndex] ? 1 : 0;
+    }
+    ReleasedSegments.RemoveAt(NewSegmentCount, ReleasedSegments.Num() - NewSegmentCount);
+
+    // Only whole commit granules past the last kept block can be returned
+    const uint64 NewCommittedBytes = Align(static_cast<uint64>(NewBlockCount) * BlockSize,
+        static_cast<uint64>(FPlatformMemory::FPlatformVirtualMemoryBlock::GetCommitAlignment()));
+    if (NewCommittedBytes < CommittedBytes)
+    {
+        DecommitRange(NewCommittedBytes, CommittedBytes - NewCommittedBytes);
+        CommittedBytes = NewCommittedBytes;
+        HugePageBytes = FMath::Min(HugePageBytes, CommittedBytes);
+    }
+
+    return BlocksReleased;
+}
+
+uint64 FSegmentedPoolStorage::ReleaseSegment(int32 SegmentIndex, bool bLazy)
+{
+    uint64 Offset = 0;
+    uint64 Size = 0;
+    if (SegmentIndex < 0 || SegmentIndex >= GetSegmentCount() || ReleasedSegments[SegmentIndex] ||
+        !GetSegmentPages(SegmentIndex, Offset, Size))
+    {
+        return 0;
+    }
+
+    DecommitRange(Offset, Size, bLazy);
+    ReleasedSegments[SegmentIndex] = true;
+    ReleasedSegmentCount++;
+    return Size;
+}
+
+void FSegmentedPoolStorage::RecommitSegment(int32 SegmentIndex)
+{
+    if (!IsSegmentReleased(SegmentIndex))
+    {
+        return;
+    }
+
+    const uint32 FirstBlock = static_cast<uint32>(SegmentIndex) * BlocksPerSegment;
+    const uint32 EndBlock = FirstBlock + BlocksPerSegment;
+    CommitBlocks(FirstBlock, EndBlock);
+
+    uint64 Offset = 0;
+    uint64 Size = 0;
+    if (GetSegmentPages(SegmentIndex, Offset, Size))
+    {
+        PlaceRange(Offset, Size);
+    }
+
+    if (ResidentBlockBytes < BlockSize)
+    {
+        DecommitBlockTails(FirstBlock, EndBlock, ResidentBlockBytes);
+    }
+
+    ReleasedSegments[SegmentIndex] = false;
+    ReleasedSegmentCount--;
+}
+
+bool FSegmentedPoolStorage::SetHugePages(bool bEnable)
+{
+    bHugePages = bEnable;
+    if (!Base)
+    {
+        // Applied once segments are added
+#if PLATFORM_LINUX
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    if (bEnable)
+    {
+        return AdviseHugePages();
+    }
+
+    HugePageBytes = 0;
+#if PLATFORM_LINUX
+    return madvise(Base, ReservedBytes, MADV_NOHUGEPAGE) == 0;
+#else
+    return false;
+#endif
+}
+
+bool FSegmentedPoolStorage::SetNumaNode(int32 NodeId)
+{
+    // With a single node every page is already local
+    const int32 NodeCount = FNumaMemory::GetNodeCount();
+    if (NodeId != INDEX_NONE && (NodeId < 0 || NodeId >= NodeCount || NodeCount <= 1))
+    {
+        return false;
+    }
+
+    if (NodeId == NumaNode)
+    {
+        return true;
+    }
+
+    if (Base && (bNumaBound || NodeId != INDEX_NONE))
+    {
+        bNumaBound = FNumaMemory::BindRange(Base, ReservedBytes, NodeId) && NodeId != INDEX_NONE;
+    }
+    NumaNode = NodeId;
+
+    // Without binding, pages are placed by first touch as segments are committed
+#if PLATFORM_LINUX
+    return true;
+#else
+    return NodeId == INDEX_NONE;
+#endif
+}
+
+void FSegmentedPoolStorage::Empty()
+{
+    if (Base)
+    {
+        FreeAddressSpace();
+    }
+
+    Base = nullptr;
+    ReservedBytes = 0;
+    CommittedBytes = 0;
+    HugePageBytes = 0;
+    bNumaBound = false;
+    BlockCount.store(0, std::memory_order_release);
+    ReleasedSegments.Empty();
+    ReleasedSegmentCount = 0;
+
+    for (std::atomic<uint64>* Page : HeldPages)
+    {
+        delete[] Page;
+    }
+    HeldPages.Empty();
+}
+
+void FSegmentedPoolStorage::ClearHeldBlocks()
+{
+    const uint32 HeldWords = GetHeldWordsPerSegment();
+    for (int32 SegmentIndex = 0; SegmentIndex < GetSegmentCount(); ++SegmentIndex)
+    {
+        for (uint32 Word = 0; Word < HeldWords; ++Word)
+        {
+            HeldPages[SegmentIndex][Word].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void FSegmentedPoolStorage::SetResidentBlockBytes(uint32 Bytes)
+{
+    ResidentBlockBytes = FMath::Clamp(Bytes, 1u, BlockSize);
+}
+
+void FSegmentedPoolStorage::CommitBlocks(uint32 FirstBlock, uint32 EndBlock)
+{
+    const uint64 PageSize = FPlatformMemory::FPlatformVirtualMemoryBlock::GetCommitAlignment();
+    const uint64 Start = AlignDown(static_cast<uint64>(FirstBlock) * BlockSize, PageSize);
+    const uint64 End = FMath::Min(Align(static_cast<uint64>(EndBlock) * BlockSize, PageSize), CommittedBytes);
+    if (End > Start)
+    {
+        CommitRange(Start, End - Start);
+    }
+}
+
+uint64 FSegmentedPoolStorage::DecommitBlockTails(uint32 FirstBlock, uint32 EndBlock, uint32 KeepBytes)
+{
+    // Pages past the committed range are clipped, so this also works on blocks not yet published
+    uint64 BytesReleased = 0;
+    for (uint32 BlockIndex = FirstBlock; BlockIndex < EndBlock; ++BlockIndex)
+    {
+        uint64 Offset = 0;
+        uint64 Size = 0;
+        if (GetBlockTailPages(BlockIndex, KeepBytes, Offset, Size))
+        {
+            DecommitRange(Offset, Size);
+            BytesReleased += Size;
+        }
+    }
+    return BytesReleased;
+}
+
+void FSegmentedPoolStorage::GetCommittedRanges(TArray<TPair<const void*, uint64>>& OutRanges) const
+{
+    const uint64 SegmentSize = GetSegmentSize();
+    const int32 SegmentCount = GetSegmentCount();
+    int32 RunStart = INDEX_NONE;
+    for (int32 SegmentIndex = 0; SegmentIndex <= SegmentCount; ++SegmentIndex)
+    {
+        const bool bCommitted = SegmentIndex < SegmentCount && !ReleasedSegments[SegmentIndex];
+        if (bCommitted && RunStart == INDEX_NONE)
+        {
+            RunStart = SegmentIndex;
+        }
+        else if (!bCommitted && RunStart != INDEX_NONE)
+        {
+            OutRanges.Emplace(Base + RunStart * SegmentSize, (SegmentIndex - RunStart) * SegmentSize);
+            RunStart = INDEX_NONE;
+        }
+    }
+}
+
+uint64 FSegmentedPoolStorage::GetResidentBytes() const
+{
+    if (ResidentBlockBytes >= BlockSize && ReleasedSegmentCount == 0)
+    {
+        return CommittedBytes;
+    }
+
+    // A released segment's pages include its blocks' tails, so count one or the other
+    uint64 ReleasedBytes = 0;
+    const int32 SegmentCount = GetSegmentCount();
+    for (int32 SegmentIndex = 0; SegmentIndex < SegmentCount; ++SegmentIndex)
+    {
+        uint64 Offset = 0;
+        uint64 Size = 0;
+        if (ReleasedSegments[SegmentIndex])
+        {
+            if (GetSegmentPages(SegmentIndex, Offset, Size))
+            {
+                ReleasedBytes += Size;
+            }
+            continue;
+        }
+
+        if (ResidentBlockBytes < BlockSize)
+        {
+            const uint32 FirstBlock = static_cast<uint32>(SegmentIndex) * BlocksPerSegment;
+            for (uint32 BlockIndex = FirstBlock; BlockIndex < FirstBlock + BlocksPerSegment; ++BlockIndex)
+            {
+                if (GetBlockTailPages(BlockIndex, ResidentBlockBytes, Offset, Size))
+                {
+                    ReleasedBytes += Size;
+                }
+            }
+        }
+    }
+    return CommittedBytes - ReleasedBytes;
+}
+
+bool FSegmentedPoolStorage::GetBlockTailPages(uint32 BlockIndex, uint32 KeepBytes, uint64& OutOffset, uint64& OutSize) const
+{
+    // Pages shared with the block's prefix or with the next block stay committed
+    const uint64 PageSize = FPlatformMemory::FPlatformVirtualMemoryBlock::GetCommitAlignment();
+    const uint64 BlockStart = static_cast<uint64>(BlockIndex) * BlockSize;
+    const uint64 Start = Align(BlockStart + FMath::Min(KeepBytes, BlockSize), PageSize);
+    const uint64 End = FMath::Min(AlignDown(BlockStart + BlockSize, PageSize), CommittedBytes);
+    if (End <= Start)
+    {
+        return false;
+    }
+
+    OutOffset = Start;
+    OutSize = End - Start;
+    return true;
+}
+
+bool FSegmentedPoolStorage::GetSegmentPages(int32 SegmentIndex, uint64& OutOffset, uint64& OutSize) const
+{
+    const uint64 PageSize = FPlatformMemory::FPlatformVirtualMemoryBlock::GetCommitAlignment();
+    const uint64 SegmentStart = static_cast<uint64>(SegmentIndex) * GetSegmentSize();
+    const uint64 Start = Align(SegmentStart, PageSize);
+    const uint64 End = FMath::Min(AlignDown(SegmentStart + GetSegmentSize(), PageSize), CommittedBytes);
+    if (End <= Start)
+    {
+        return false;
+    }
+
+    OutOffset = Start;
+    OutSize = End - Start;
+    return true;
+}
+
+bool FSegmentedPoolStorage::ReserveAddressSpace()
+{
+    // Reserve one extra alignment unit so an aligned range of ReservedBytes fits inside the
+    // reservation. Only address space is wasted; the slack is never committed.
+    const uint64 ReservationSize = ReservedBytes + AddressRangeAlignment;
+
+#if PLATFORM_LINUX
+    // No swap is reserved up front, and pages are only backed once written
+    void* Mapping = mmap(nullptr, ReservationSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (Mapping == MAP_FAILED)
+    {
+        Base = nullptr;
+        return false;
+    }
+
+    // Unmap the slack on both sides so the mapping is exactly the aligned range
+    uint8* MappingStart = static_cast<uint8*>(Mapping);
+    uint8* MappingEnd = MappingStart + ReservationSize;
+    Base = Align(MappingStart, AddressRangeAlignment);
+    if (Base > MappingStart)
+    {
+        munmap(MappingStart, Base - MappingStart);
+    }
+    if (MappingEnd > Base + ReservedBytes)
+    {
+        munmap(Base + ReservedBytes, MappingEnd - (Base + ReservedBytes));
+    }
+#else
+    VirtualBlock = FPlatformMemory::FPlatformVirtualMemoryBlock::AllocateVirtual(ReservationSize);
+    uint8* VirtualBase = static_cast<uint8*>(VirtualBlock.GetVirtualPointer());
+    Base = VirtualBase ? Align(VirtualBase, AddressRangeAlignment) : nullptr;
+    BaseOffset = VirtualBase ? static_cast<uint64>(Base - VirtualBase) : 0;
+#endif
+
+    if (Base)
+    {
+        AddressRangeEpoch.fetch_add(1, std::memory_order_release);
+    }
+    return Base != nullptr;
+}
+
+void FSegmentedPoolStorage::FreeAddressSpace()
+{
+#if PLATFORM_LINUX
+    munmap(Base, ReservedBytes);
+#else
+    if (CommittedBytes > 0)
+    {
+        VirtualBlock.Decommit(BaseOffset, CommittedBytes);
+    }
+    VirtualBlock.FreeVirtual();
+    BaseOffset = 0;
+#endif
+
+    AddressRangeEpoch.fetch_add(1, std::memory_order_release);
+}
+
+void FSegmentedPoolStorage::CommitRange(uint64 Offset, uint64 Size)
+{
+#if PLATFORM_LINUX
+    // The whole mapping is already accessible; pages are backed on first write
+#else
+    VirtualBlock.Commit(BaseOffset + Offset, Size);
+#endif
+}
+
+void FSegmentedPoolStorage::DecommitRange(uint64 Offset, uint64 Size, bool bLazy)
+{
+#if PLATFORM_LINUX
+    // Released pages read as zero once reclaimed; lazily freed pages may keep old contents until then
+    int Advice = MADV_DONTNEED;
+#ifdef MADV_FREE
+    if (bLazy)
+    {
+        Advice = MADV_FREE;
+    }
+#endif
+    if (madvise(Base + Offset, Size, Advice) != 0 && Advice != MADV_DONTNEED && errno == EINVAL)
+    {
+        // Kernels before 4.5 do not know MADV_FREE
+        madvise(Base + Offset, Size, MADV_DONTNEED);
+    }
+#else
+    VirtualBlock.Decommit(BaseOffset + Offset, Size);
+#endif
+}
+
+bool FSegmentedPoolStorage::AdviseHugePages()
+{
+#if PLATFORM_LINUX && defined(MADV_HUGEPAGE)
+    const uint64 End = AlignDown(CommittedBytes, HugePageSize);
+    if (End > HugePageBytes)
+    {
+        // Fails with EINVAL on kernels built without transparent huge pages
+        if (madvise(Base + HugePageBytes, End - HugePageBytes, MADV_HUGEPAGE) != 0)
+        {
+            return false;
+        }
+        HugePageBytes = End;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void FSegmentedPoolStorage::PlaceRange(uint64 Offset, uint64 Size)
+{
+    if (NumaNode != INDEX_NONE && !bNumaBound && Size > 0)
+    {
+        FNumaMemory::TouchRangeOnNode(Base + Offset, Size, NumaNode);
+    }
+}
+
+uint32 FSegmentedPoolStorage::PermuteBlocks(const TArray<uint32>& Order)
+{
+    const uint32 Count = GetBlockCount();
+    const int32 OrderedCount = Order.Num();
+    if (OrderedCount == 0 || Count == 0)
+    {
+        return 0;
+    }
+
+    // Complete the mapping: blocks past the ordered range take the unused sources in ascending
+    // order, which leaves most of them where they are
+    TArray<uint32> Source;
+    Source.SetNumUninitialized(Count);
+    TBitArray<> SourceUsed(false, Count);
+
+    for (int32 Index = 0; Index < OrderedCount; ++Index)
+    {
+        check(Order[Index] < Count && !SourceUsed[Order[Index]]);
+        Source[Index] = Order[Index];
+        SourceUsed[Order[Index]] = true;
+    }
+
+    uint32 NextUnused = 0;
+    for (uint32 Index = OrderedCount; Index < Count; ++Index)
+    {
+        while (SourceUsed[NextUnused])
+        {
+            ++NextUnused;
+        }
+        Source[Index] = NextUnused++;
+    }
+
+    // Held marks follow their blocks; everything past the ordered range ends up free
+    TBitArray<> Held(false, OrderedCount);
+    for (int32 Index = 0; Index < OrderedCount; ++Index)
+    {
+        Held[Index] = IsBlockHeld(Order[Index]);
+    }
+    ClearHeldBlocks();
+    for (int32 Index = 0; Index < OrderedCount; ++Index)
+    {
+        if (Held[Index])
+        {
+            MarkBlockHeld(Index);
+        }
+    }
+
+    // Follow each cycle of the permutation, parking its first block in scratch space. Destinations
+    // past the ordered range only need their old contents read out, never written. Only the
+    // resident prefix of each block holds data, and its tail pages may not be committed.
+    const uint32 CopySize = ResidentBlockBytes;
+    TArray<uint8> Scratch;
+    Scratch.SetNumUninitialized(CopySize);
+    TBitArray<> Done(false, Count);
+    uint32 BlocksCopied = 0;
+
+    for (uint32 Start = 0; Start < Count; ++Start)
+    {
+        if (Done[Start] || Source[Start] == Start)
+        {
+            continue;
+        }
+
+        FMemory::Memcpy(Scratch.GetData(), GetBlock(Start), CopySize);
+
+        uint32 Current = Start;
+        while (true)
+        {
+            Done[Current] = true;
+            const uint32 From = Source[Current];
+            const bool bNeedsContents = Current < static_cast<uint32>(OrderedCount);
+
+            if (From == Start)
+            {
+                if (bNeedsContents)
+                {
+                    FMemory::Memcpy(GetBlock(Current), Scratch.GetData(), CopySize);
+                    BlocksCopied++;
+                }
+                break;
+            }
+
+            if (bNeedsContents)
+            {
+                FMemory::Memcpy(GetBlock(Current), GetBlock(From), CopySize);
+                BlocksCopied++;
+            }
+            Current = From;
+        }
+    }
+
+    return BlocksCopied;
+}
@@ -0,0 +1,143 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SegmentedPoolStorage.h"
+#include "NarrowBandAllocator.h"
+
+/**
+ * Test program for segmented pool storage
+ * Checks that growing a pool keeps earlier pointers valid, that pointer lookups work across
+ * segments, that in-place reordering matches the requested order and carries held marks along,
+ * that segments can be released and recommitted in place, that empty trailing segments are
+ * released on shrink, that a block freed twice is only freed once and that a handle's block cannot
+ * be freed by pointer
+ */
+void TestSegmentedPoolStorage()
+{
+    // Storage layout, lookups and reordering
+    {
+        FSegmentedPoolStorage Storage;
+        verifyf(Storage.Configure(64, 1024, 16 * 1024), TEXT("address space is reserved"));
+
+        const uint32 BlocksPerSegment = Storage.GetBlocksPerSegment();
+        verifyf(Storage.GetSegmentSize() <= 16 * 1024 && Storage.GetReservedBytes() >= FSegmentedPoolStorage::DefaultReservedSize,
+            TEXT("segments stay within the target size"));
+
+        uint32 Added = Storage.AddBlocks(BlocksPerSegment * 3 - 1);
+        verifyf(Added == BlocksPerSegment * 3 && Storage.GetSegmentCount() == 3, TEXT("block counts round up to whole segments"));
+
+        bool bLookupsMatch = true;
+        for (uint32 Index = 0; Index < Storage.GetBlockCount(); ++Index)
+        {
+            *reinterpret_cast<uint32*>(Storage.GetBlock(Index)) = Index;
+            bLookupsMatch &= Storage.GetBlockIndex(Storage.GetBlock(Index)) == static_cast<int32>(Index);
+        }
+        verifyf(bLookupsMatch, TEXT("every block address maps back to its index"));
+        verifyf(Storage.GetBlockIndex(Storage.GetBlock(1) + 1) == INDEX_NONE, TEXT("addresses inside a block are not block starts"));
+        verifyf(!Storage.Contains(&Added), TEXT("foreign addresses are not contained"));
+
+        TArray<uint32> Order;
+        for (uint32 Index = Storage.GetBlockCount() - 1; Index > 0; Index -= 3)
+        {
+            Order.Add(Index);
+            if (Index < 3)
+            {
+                break;
+            }
+        }
+
+        Storage.MarkBlockHeld(Order[0]);
+        verifyf(Storage.TryReleaseHeldBlock(Order[0]) && !Storage.TryReleaseHeldBlock(Order[0]), TEXT("a held mark is released only once"));
+        Storage.MarkBlockHeld(Order[1]);
+        Storage.MarkBlockHeld(Order[0] - 1);
+        Storage.PermuteBlocks(Order);
+
+        uint32 HeldCount = 0;
+        for (uint32 Index = 0; Index < Storage.GetBlockCount(); ++Index)
+        {
+            HeldCount += Storage.IsBlockHeld(Index) ? 1 : 0;
+        }
+        verifyf(Storage.IsBlockHeld(1) && HeldCount == 1, TEXT("held marks move with ordered blocks and are dropped from the rest"));
+
+        bool bReordered = true;
+        for (int32 Index = 0; Index < Order.Num(); ++Index)
+        {
+            bReordered &= *reinterpret_cast<uint32*>(Storage.GetBlock(Index)) == Order[Index];
+        }
+        verifyf(bReordered, TEXT("in-place reordering places each source block at its destination"));
+
+        const uint64 ResidentBeforeRelease = Storage.GetResidentBytes();
+        const uint64 SegmentBytesReleased = Storage.ReleaseSegment(1);
+        verifyf(SegmentBytesReleased > 0 && Storage.IsSegmentReleased(1) && Storage.FindReleasedSegment() == 1,
+            TEXT("an interior segment is released in place"));
+        verifyf(Storage.GetResidentBytes() == ResidentBeforeRelease - SegmentBytesReleased && Storage.GetBlockCount() == BlocksPerSegment * 3,
+            TEXT("interior release drops resident memory but keeps every block index"));
+        verifyf(Storage.ReleaseSegment(1) == 0, TEXT("a released segment is not released twice"));
+
+        TArray<TPair<const void*, uint64>> CommittedRanges;
+        Storage.GetCommittedRanges(CommittedRanges);
+        verifyf(CommittedRanges.Num() == 2 && CommittedRanges[0].Key == Storage.GetBlock(0) &&
+            CommittedRanges[1].Key == Storage.GetBlock(BlocksPerSegment * 2) && CommittedRanges[1].Value == Storage.GetSegmentSize(),
+            TEXT("committed ranges skip released segments"));
+
+        Storage.RecommitSegment(1);
+        *reinterpret_cast<uint32*>(Storage.GetBlock(BlocksPerSegment)) = 7;
+        verifyf(!Storage.IsSegmentReleased(1) && Storage.GetResidentBytes() == ResidentBeforeRelease &&
+            *reinterpret_cast<uint32*>(Storage.GetBlock(BlocksPerSegment)) == 7, TEXT("a recommitted segment is usable again"));
+
+        Storage.ReleaseSegment(2);
+
+        verifyf(Storage.ReleaseTrailingSegments(2) == BlocksPerSegment * 2 && Storage.GetSegmentCount() == 1 && Storage.GetReleasedSegmentCount() == 0,
+            TEXT("trailing segments are released, including ones released in place"));
+        verifyf(Storage.GetCommittedBytes() < Storage.GetSegmentSize() * 3, TEXT("released segments are decommitted"));
+        verifyf(Storage.GetBlockIndex(Storage.GetBlock(0) + Storage.GetSegmentSize()) == INDEX_NONE, TEXT("released blocks are no longer found"));
+    }
+
+    // Pool growth keeps earlier allocations in place
+    {
+        FNarrowBandAllocator Pool(TEXT("SegmentedTestPool"), 256, 64);
+        Pool.Initialize();
+
+        TArray<void*> Allocations;
+        for (int32 Index = 0; Index < 64; ++Index)
+        {
+            void* Ptr = Pool.Allocate();
+            *static_cast<int32*>(Ptr) = Index;
+            Allocations.Add(Ptr);
+        }
+        void* FirstAllocation = Allocations[0];
+
+        const uint32 BlocksBeforeGrowth = Pool.GetStats().BlockCount;
+        for (uint32 Index = 0; Index < BlocksBeforeGrowth * 2; ++Index)
+        {
+            Allocations.Add(Pool.Allocate());
+        }
+        verifyf(Pool.GetStats().GrowthCount > 0, TEXT("pool grew past its initial capacity"));
+
+        bool bIntact = true;
+        for (int32 Index = 0; Index < 64; ++Index)
+        {
+            bIntact &= Pool.OwnsPointer(Allocations[Index]) && *static_cast<int32*>(Allocations[Index]) == Index;
+        }
+        verifyf(bIntact && Allocations[0] == FirstAllocation, TEXT("allocations made before growth keep their address and contents"));
+
+        for (int32 Index = 64; Index < Allocations.Num(); ++Index)
+        {
+            Pool.Free(Allocations[Index]);
+        }
+        verifyf(!Pool.Free(Allocations[64]), TEXT("a second free of the same block is rejected"));
+        verifyf(Pool.Shrink() > 0, TEXT("empty trailing segments are released"));
+        verifyf(*static_cast<int32*>(FirstAllocation) == 0, TEXT("shrinking leaves live allocations untouched"));
+
+        const uint32 Handle = Pool.AllocateHandle();
+        verifyf(Handle != FPoolHandleTable::InvalidHandle, TEXT("a handle is allocated"));
+        verifyf(!Pool.Free(Pool.ResolveHandle(Handle)), TEXT("freeing a handle's block by pointer is rejected"));
+        verifyf(Pool.ResolveHandle(Handle) != nullptr, TEXT("the handle still resolves after the rejected free"));
+        verifyf(Pool.FreeHandle(Handle) && Pool.ResolveHandle(Handle) == nullptr, TEXT("FreeHandle releases the block"));
+
+        TArray<FString> Errors;
+        verifyf(Pool.Validate(Errors), TEXT("pool validates after growth and shrink"));
+        Pool.Shutdown();
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("Segmented pool storage test completed"));
+}
@@ -0,0 +1,340 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SizeClassAllocator.h"
+#include "Misc/ScopeLock.h"
+#include "Algo/Sort.h"
+
+namespace SizeClassAllocatorLayout
+{
+    /** Classes in 16-byte steps, covering 16 to 128 bytes */
+    constexpr int32 LinearClassCount = 8;
+
+    /** Largest size served by the linear classes */
+    constexpr uint32 LinearLimit = LinearClassCount * FSizeClassAllocator::MinAllocationSize;
+
+    /** Log2 of LinearLimit, where the geometric classes start */
+    constexpr uint32 LinearLimitShift = 7;
+
+    /** Classes per doubling above LinearLimit, as a shift */
+    constexpr uint32 ClassesPerDoublingShift = 2;
+
+    static_assert(LinearLimit == 1u << LinearLimitShift, "Linear classes must end on a power of two");
+    static_assert(FSizeClassAllocator::SizeClassCount == LinearClassCount + (1 << ClassesPerDoublingShift) * (16 - LinearLimitShift),
+        "Geometric classes must end at MaxAllocationSize");
+
+    /** Gets the class holding Size bytes, for Size from 1 to MaxAllocationSize */
+    FORCEINLINE int32 GetClassForSize(uint32 Size)
+    {
+        if (Size <= LinearLimit)
+        {
+            return static_cast<int32>((Size - 1) / FSizeClassAllocator::MinAllocationSize);
+        }
+
+        // Split [2^Log, 2^(Log+1)) into four equal steps
+        const uint32 Log = FMath::FloorLog2(Size - 1);
+        const uint32 Step = (Size - 1 - (1u << Log)) >> (Log - ClassesPerDoublingShift);
+        return LinearClassCount + static_cast<int32>(((Log - LinearLimitShift) << ClassesPerDoublingShift) + Step);
+    }
+}
+
+FSizeClassAllocator::FSizeClass::FSizeClass(uint32 InBlockSize)
+    : BlockSize(InBlockSize)
+    , MagazineCache(
+        [this](uint32* OutBlockIndices, uint32 MaxCount) { return Refill(OutBlockIndices, MaxCount); },
+        [this](const uint32* BlockIndices, uint32 Count) { Flush(BlockIndices, Count); })
+{
+}
+
+uint32 FSizeClassAllocator::FSizeClass::Refill(uint32* OutBlockIndices, uint32 MaxCount)
+{
+    FScopeLock ScopeLock(&Lock);
+
+    // Grow by a slab; the new blocks follow the existing indices
+    if (FreeBlocks.Num() == 0)
+    {
+        const uint32 FirstBlock = Storage.GetBlockCount();
+        const uint32 BlocksAdded = Storage.AddBlocks(MaxCount);
+        FreeBlocks.Reserve(BlocksAdded);
+        for (uint32 BlockIndex = FirstBlock + BlocksAdded; BlockIndex > FirstBlock; --BlockIndex)
+        {
+            FreeBlocks.Add(BlockIndex - 1);
+        }
+    }
+
+    const uint32 Count = FMath::Min(MaxCount, static_cast<uint32>(FreeBlocks.Num()));
+    const int32 FirstTaken = FreeBlocks.Num() - static_cast<int32>(Count);
+    FMemory::Memcpy(OutBlockIndices, FreeBlocks.GetData() + FirstTaken, Count * sizeof(uint32));
+    FreeBlocks.SetNum(FirstTaken, EAllowShrinking::No);
+    return Count;
+}
+
+void FSizeClassAllocator::FSizeClass::Flush(const uint32* BlockIndices, uint32 Count)
+{
+    FScopeLock ScopeLock(&Lock);
+    FreeBlocks.Append(BlockIndices, Count);
+}
+
+void FSizeClassAllocator::FSizeClass::Release()
+{
+    // Cached blocks go back to the free list first, so no magazine refers to a released slab
+    FPoolMagazineCache::FExclusiveScope CacheScope(MagazineCache);
+    FScopeLock ScopeLock(&Lock);
+
+    FreeBlocks.Empty();
+    Storage.ClearHeldBlocks();
+    Storage.ReleaseTrailingSegments(Storage.GetSegmentCount());
+    MagazineCache.GetOperationCounts(BaseAllocations, BaseFrees);
+}
+
+FSizeClassAllocator::FSizeClassAllocator()
+    : bIsInitialized(false)
+{
+    FMemory::Memzero(ClassesByAddress, sizeof(ClassesByAddress));
+}
+
+FSizeClassAllocator::~FSizeClassAllocator()
+{
+    Shutdown();
+}
+
+bool FSizeClassAllocator::Initialize()
+{
+    if (bIsInitialized)
+    {
+        return true;
+    }
+
+    // Classes kept by Shutdown still hold their ranges and start out empty
+    if (ClassesByAddress[0])
+    {
+        bIsInitialized = true;
+        return true;
+    }
+
+    for (int32 ClassIndex = 0; ClassIndex < SizeClassCount; ++ClassIndex)
+    {
+        const uint32 BlockSize = GetSizeClassSize(ClassIndex);
+        SizeClasses[ClassIndex] = MakeUnique<FSizeClass>(BlockSize);
+
+        // Segments are sized to hold exactly one slab, so a refill commits one slab at a time
+        const uint32 BlocksPerSlab = static_cast<uint32>(SlabSize / BlockSize);
+        if (!SizeClasses[ClassIndex]->Storage.Configure(BlockSize, BlocksPerSlab, SlabSize, ClassReservedSize))
+        {
+            UE_LOG(LogTemp, Error, TEXT("FSizeClassAllocator::Initialize - Failed to reserve address space for %u-byte blocks"), BlockSize);
+            FMemory::Memzero(ClassesByAddress, sizeof(ClassesByAddress));
+            for (TUniquePtr<FSizeClass>& SizeClass : SizeClasses)
+            {
+                SizeClass.Reset();
+            }
+            return false;
+        }
+
+        ClassesByAddress[ClassIndex] = SizeClasses[ClassIndex].Get();
+    }
+
+    // Pointer lookups binary search the reserved ranges, which never move once reserved
+    Algo::Sort(ClassesByAddress, [](const FSizeClass* A, const FSizeClass* B)
+    {
+        return A->Storage.GetReservedBase() < B->Storage.GetReservedBase();
+    });
+
+    bIsInitialized = true;
+    return true;
+}
+
+void FSizeClassAllocator::Shutdown()
+{
+    if (!bIsInitialized)
+    {
+        return;
+    }
+
+    bIsInitialized = false;
+
+    // The ranges stay reserved until the allocator is destroyed, so late frees still find their
+    // class and no other allocation can be placed at a stale block's address
+    for (TUniquePtr<FSizeClass>& SizeClass : SizeClasses)
+    {
+        SizeClass->Release();
+    }
+}
+
+void* FSizeClassAllocator::Allocate(uint64 SizeInBytes, uint32 Alignment)
+{
+    const int32 ClassIndex = GetSizeClass(SizeInBytes, Alignment);
+    if (ClassIndex == INDEX_NONE || !bIsInitialized)
+    {
+        return nullptr;
+    }
+
+    FSizeClass& SizeClass = *SizeClasses[ClassIndex];
+    const int32 BlockIndex = SizeClass.MagazineCache.Allocate();
+    if (BlockIndex == INDEX_NONE)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("FSizeClassAllocator::Allocate - %u-byte size class is full"), SizeClass.BlockSize);
+        return nullptr;
+    }
+
+    SizeClass.Storage.MarkBlockHeld(BlockIndex);
+    return SizeClass.Storage.GetBlock(BlockIndex);
+}
+
+bool FSizeClassAllocator::Free(void* Ptr)
+{
+    FSizeClass* SizeClass = FindSizeClass(Ptr);
+    if (!SizeClass)
+    {
+        return false;
+    }
+
+    // Its slab is gone, and the block must not reach another allocator
+    if (!bIsInitialized)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("FSizeClassAllocator::Free - Dropped free of a %u-byte block after shutdown"), SizeClass->BlockSize);
+        return true;
+    }
+
+    const int32 BlockIndex = SizeClass->Storage.GetBlockIndex(Ptr);
+    if (BlockIndex == INDEX_NONE)
+    {
+        UE_LOG(LogTemp, Error, TEXT("FSizeClassAllocator::Free - Pointer is not the start of a %u-byte block"), SizeClass->BlockSize);
+        return true;
+    }
+
+    // Only one free of a block can clear its held mark, so a second free stops here
+    if (!SizeClass->Storage.TryReleaseHeldBlock(BlockIndex))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("FSizeClassAllocator::Free - Ignored free of %u-byte block %d that is not allocated"),
+            SizeClass->BlockSize, BlockIndex);
+        return true;
+    }
+
+    SizeClass->MagazineCache.Free(static_cast<uint32>(BlockIndex));
+    return true;
+}
+
+uint32 FSizeClassAllocator::GetAllocationSize(const void* Ptr) const
+{
+    const FSizeClass* SizeClass = FindSizeClass(Ptr);
+    return SizeClass ? SizeClass->BlockSize : 0;
+}
+
+int32 FSizeClassAllocator::GetSizeClass(uint64 SizeInBytes, uint32 Alignment)
+{
+    if (SizeInBytes > MaxAllocationSize)
+    {
+        return INDEX_NONE;
+    }
+
+    int32 ClassIndex = SizeClassAllocatorLayout::GetClassForSize(FMath::Max<uint32>(static_cast<uint32>(SizeInBytes), 1));
+
+    // Blocks are aligned to the largest power of two dividing the class size, so larger
+    // alignments move up to the first class that is a multiple of the alignment
+    while (ClassIndex < SizeClassCount && (GetSizeClassSize(ClassIndex) & (Alignment - 1)) != 0)
+    {
+        ++ClassIndex;
+    }
+
+    return ClassIndex < SizeClassCount ? ClassIndex : INDEX_NONE;
+}
+
+uint32 FSizeClassAllocator::GetSizeClassSize(int32 ClassIndex)
+{
+    using namespace SizeClassAllocatorLayout;
+
+    if (ClassIndex < LinearClassCount)
+    {
+        return static_cast<uint32>(ClassIndex + 1) * MinAllocationSize;
+    }
+
+    // Class n of a doubling starting at 2^Log ends at 2^Log + (n + 1) * 2^(Log - 2)
+    const uint32 GeometricIndex = static_cast<uint32>(ClassIndex - LinearClassCount);
+    const uint32 Log = LinearLimitShift + (GeometricIndex >> ClassesPerDoublingShift);
+    const uint32 Step = GeometricIndex & ((1u << ClassesPerDoublingShift) - 1);
+    return (1u << Log) + ((Step + 1) << (Log - ClassesPerDoublingShift));
+}
+
+uint64 FSizeClassAllocator::GetAllocatedBytes() const
+{
+    TArray<FSizeClassStats> Stats;
+    GetSizeClassStats(Stats);
+
+    uint64 AllocatedBytes = 0;
+    for (const FSizeClassStats& ClassStats : Stats)
+    {
+        AllocatedBytes += ClassStats.AllocatedBlocks * ClassStats.BlockSize;
+    }
+    return AllocatedBytes;
+}
+
+uint64 FSizeClassAllocator::GetCommittedBytes() const
+{
+    uint64 CommittedBytes = 0;
+    for (const TUniquePtr<FSizeClass>& SizeClass : SizeClasses)
+    {
+        if (SizeClass)
+        {
+            CommittedBytes += SizeClass->Storage.GetCommittedBytes();
+        }
+    }
+    return CommittedBytes;
+}
+
+void FSizeClassAllocator::GetSizeClassStats(TArray<FSizeClassStats>& OutStats) const
+{
+    OutStats.Reset(SizeClassCount);
+    for (int32 ClassIndex = 0; ClassIndex < SizeClassCount; ++ClassIndex)
+    {
+        FSizeClassStats& ClassStats = OutStats.AddDefaulted_GetRef();
+        ClassStats.BlockSize = GetSizeClassSize(ClassIndex);
+
+        const FSizeClass* SizeClass = SizeClasses[ClassIndex].Get();
+        if (!SizeClass)
+        {
+            continue;
+        }
+
+        // Every block reaches callers through the magazines, so their counts cover all traffic
+        uint64 Allocations = 0;
+        uint64 Frees = 0;
+        SizeClass->MagazineCache.GetOperationCounts(Allocations, Frees);
+        Allocations -= SizeClass->BaseAllocations;
+        Frees -= SizeClass->BaseFrees;
+        ClassStats.AllocatedBlocks = Allocations > Frees ? Allocations - Frees : 0;
+        ClassStats.CommittedBlocks = SizeClass->Storage.GetBlockCount();
+        ClassStats.TotalAllocations = Allocations;
+    }
+}
+
+FSizeClassAllocator::FSizeClass* FSizeClassAllocator::FindSizeClass(const void* Ptr) const
+{
+    if (!Ptr || !ClassesByAddress[0])
+    {
+        return nullptr;
+    }
+
+    // Last class whose range starts at or below the address
+    int32 Low = 0;
+    int32 High = SizeClassCount;
+    while (Low < High)
+    {
+        const int32 Middle = (Low + High) / 2;
+        if (ClassesByAddress[Middle]->Storage.GetReservedBase() <= Ptr)
+        {
+            Low = Middle + 1;
+        }
+        else
+        {
+            High = Middle;
+        }
+    }
+
+    if (Low == 0)
+    {
+        return nullptr;
+    }
+
+    FSizeClass* SizeClass = ClassesByAddress[Low - 1];
+    const UPTRINT Offset = reinterpret_cast<UPTRINT>(Ptr) - reinterpret_cast<UPTRINT>(SizeClass->Storage.GetReservedBase());
+    return Offset < SizeClass->Storage.GetReservedBytes() ? SizeClass : nullptr;
+}
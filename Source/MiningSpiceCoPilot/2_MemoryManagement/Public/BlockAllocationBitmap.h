@@ -0,0 +1,121 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Dense allocation state for fixed-size block pools, one bit per block
+ *
+ * Scans over the pool (fragmentation, free segment checks, compaction order) read 64 blocks per
+ * word and use popcount and count-trailing-zeros to skip runs, instead of reading a metadata
+ * struct per block. Bits past Num() are always clear.
+ *
+ * Not thread safe; the owning pool serializes access with its pool lock.
+ */
+class MININGSPICECOPILOT_API FBlockAllocationBitmap
+{
+public:
+    /**
+     * Resizes the bitmap; new blocks start free
+     * @param InNumBits Number of blocks tracked
+     */
+    void SetNum(uint32 InNumBits);
+
+    /** Marks every block free */
+    void ClearAll();
+
+    /** Releases all memory */
+    void Empty();
+
+    /** Gets the number of blocks tracked */
+    FORCEINLINE uint32 Num() const { return NumBits; }
+
+    /** Checks whether a block is allocated */
+    FORCEINLINE bool IsSet(uint32 Index) const
+    {
+        checkSlow(Index < NumBits);
+        return (Words[Index >> 6] >> (Index & 63)) & 1;
+    }
+
+    /** Marks a block allocated */
+    FORCEINLINE void Set(uint32 Index)
+    {
+        checkSlow(Index < NumBits);
+        Words[Index >> 6] |= 1ull << (Index & 63);
+    }
+
+    /** Marks a block free */
+    FORCEINLINE void Clear(uint32 Index)
+    {
+        checkSlow(Index < NumBits);
+        Words[Index >> 6] &= ~(1ull << (Index & 63));
+    }
+
+    /**
+     * Marks blocks [0, Count) allocated and every later block free, the layout after compaction
+     * @param Count Number of leading blocks to mark allocated
+     */
+    void SetLeading(uint32 Count);
+
+    /** Counts allocated blocks */
+    uint32 CountSet() const;
+
+    /**
+     * Counts allocated blocks in a range
+     * @param Start First block of the range
+     * @param End One past the last block of the range
+     */
+    uint32 CountSetInRange(uint32 Start, uint32 End) const;
+
+    /**
+     * Counts positions where a block's state differs from the block before it
+     * A fully compacted pool has at most one transition.
+     */
+    uint32 CountTransitions() const;
+
+    /**
+     * Finds the first allocated block at or after Start
+     * @return Block index, or INDEX_NONE if there is none
+     */
+    int32 FindFirstSet(uint32 Start = 0) const;
+
+    /**
+     * Finds the first free block at or after Start
+     * @return Block index, or INDEX_NONE if there is none
+     */
+    int32 FindFirstClear(uint32 Start = 0) const;
+
+    /**
+     * Finds the last allocated block before End
+     * @return Block index, or INDEX_NONE if there is none
+     */
+    int32 FindLastSet(uint32 End) const;
+
+    /**
+     * Finds the first run of free blocks of at least Length
+     * @param Length Number of contiguous free blocks needed
+     * @param Start Block to start searching from
+     * @return First block of the run, or INDEX_NONE if there is none
+     */
+    int32 FindClearRun(uint32 Length, uint32 Start = 0) const;
+
+    /**
+     * Appends the indices of all allocated blocks in ascending order
+     * @param OutIndices Array receiving the indices
+     */
+    void GetSetIndices(TArray<uint32>& OutIndices) const;
+
+    /** Gets the bytes used by the bitmap */
+    FORCEINLINE SIZE_T GetAllocatedSize() const { return Words.GetAllocatedSize(); }
+
+private:
+    /** Bits, 64 blocks per word, block i at bit i % 64 of word i / 64 */
+    TArray<uint64> Words;
+
+    /** Number of blocks tracked */
+    uint32 NumBits = 0;
+
+    /** Clears the bits past NumBits in the last word */
+    void ClearTrailingBits();
+};
@@ -0,0 +1,267 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "AdaptiveSpinWait.h"
+#include <atomic>
+
+class IMemoryTracker;
+
+/**
+ * Bump-pointer arena for data that lives for one frame or one task
+ *
+ * Each thread allocates from its own chunk by advancing a cursor, so an allocation costs an
+ * uncontended slot lock and an add. When the chunk is full the thread takes another one from the
+ * arena's free list, which takes the arena lock. Allocations are never freed individually.
+ * BeginFrame releases everything allocated in the frame being recycled at once: that frame's chunks
+ * are spliced back onto the free list and thread slots notice the new frame number on their next
+ * allocation. The cost does not depend on how many allocations were made. Requests larger than a
+ * quarter of a chunk get a block of their own, which is freed when its frame is recycled.
+ *
+ * With BufferCount of 2 the arena is double-buffered. Allocations made in the previous frame stay
+ * valid for one more frame, so async readers can still use them while the next frame is written.
+ * For task scratch data, use a single-buffered arena and call BeginFrame when the task finishes.
+ *
+ * Chunks are reported to the memory tracker under one category as they are taken from and given
+ * back to the system allocator. The arena also records high-water marks of the bytes allocated and
+ * the chunk bytes used in a single frame.
+ *
+ * BeginFrame, Trim and Empty must not run while other threads allocate from the arena. Builds with
+ * checks enabled count the threads inside Allocate and assert that none are when those run.
+ */
+class MININGSPICECOPILOT_API FFrameArenaAllocator
+{
+public:
+    /** Number of thread slots; threads beyond this share slots */
+    static constexpr int32 SlotCount = 64;
+
+    /** Default chunk size in bytes */
+    static constexpr uint64 DefaultChunkSize = 256 * 1024;
+
+    /** Most frames kept alive at once */
+    static constexpr uint32 MaxBufferCount = 2;
+
+    /** Usage figures of an arena */
+    struct FFrameArenaStats
+    {
+        /** Current frame number, which BeginFrame advances */
+        uint32 FrameNumber = 0;
+
+        /** Bytes allocated in the last completed frame */
+        uint64 LastFrameBytes = 0;
+
+        /** Most bytes allocated in a single completed frame */
+        uint64 HighWaterBytes = 0;
+
+        /** Most chunk and oversized block bytes used by a single completed frame */
+        uint64 HighWaterChunkBytes = 0;
+
+        /** Bytes held from the system allocator, including idle chunks */
+        uint64 ReservedBytes = 0;
+    };
+
+    /**
+     * Constructor
+     * @param InCategoryName Memory tracker category the arena's chunks are reported under
+     * @param InBufferCount Frames kept alive at once, 1 or 2
+     * @param InChunkSize Size of each per-thread chunk in bytes
+     */
+    explicit FFrameArenaAllocator(const FName& InCategoryName, uint32 InBufferCount = 1, uint64 InChunkSize = DefaultChunkSize);
+
+    /** Destructor, frees every chunk */
+    ~FFrameArenaAllocator();
+
+    FFrameArenaAllocator(const FFrameArenaAllocator&) = delete;
+    FFrameArenaAllocator& operator=(const FFrameArenaAllocator&) = delete;
+
+    /**
+     * Sets the tracker chunks are reported to
+     * Chunks already held are moved from the old tracker to the new one.
+     * @param InMemoryTracker Tracker, or null to stop reporting
+     */
+    void SetMemoryTracker(IMemoryTracker* InMemoryTracker);
+
+    /**
+     * Allocates memory that stays valid until its frame is recycled
+     * @param SizeInBytes Size to allocate in bytes
+     * @param Alignment Alignment, a power of two
+     * @return Uninitialized memory, or null if the system allocator fails
+     */
+    void* Allocate(uint64 SizeInBytes, uint32 Alignment = 16);
+
+    /**
+     * Allocates an uninitialized array that stays valid until its frame is recycled
+     * @param Count Number of elements
+     */
+    template<typename ElementType>
+    ElementType* AllocateArray(int32 Count)
+    {
+        return static_cast<ElementType*>(Allocate(sizeof(ElementType) * FMath::Max(Count, 0), alignof(ElementType)));
+    }
+
+    /**
+     * Starts a new frame
+     * The oldest frame's allocations are released and its memory is reused for the new frame;
+     * with double buffering the frame just finished stays valid.
+     */
+    void BeginFrame();
+
+    /**
+     * Frees idle chunks back to the system allocator
+     * @return Number of bytes freed
+     */
+    uint64 Trim();
+
+    /** Releases every frame and frees every chunk; all allocations become invalid */
+    void Empty();
+
+    /** Gets the number of frames kept alive at once */
+    FORCEINLINE uint32 GetBufferCount() const { return BufferCount; }
+
+    /** Gets the chunk size in bytes */
+    FORCEINLINE uint64 GetChunkSize() const { return ChunkSize; }
+
+    /** Gets the arena's usage figures */
+    FFrameArenaStats GetStats() const;
+
+private:
+    /** Header at the start of each chunk and oversized block */
+    struct FChunk
+    {
+        /** Next chunk in the list holding this one */
+        FChunk* Next;
+
+        /** Size of the chunk including this header */
+        uint64 Size;
+
+        /** Gets the first byte after the header */
+        FORCEINLINE uint8* GetData() { return reinterpret_cast<uint8*>(this + 1); }
+
+        /** Gets the first byte past the chunk */
+        FORCEINLINE uint8* GetEnd() { return reinterpret_cast<uint8*>(this) + Size; }
+    };
+
+    /** Singly linked list of chunks with a tail, so lists splice in constant time */
+    struct FChunkList
+    {
+        FChunk* Head = nullptr;
+        FChunk* Tail = nullptr;
+
+        /** Adds a chunk at the head */
+        void Push(FChunk* Chunk);
+
+        /** Moves every chunk of another list to the head of this one */
+        void Splice(FChunkList& Other);
+    };
+
+    /** Memory owned by one live frame */
+    struct FFrame
+    {
+        /** Full-size chunks handed to thread slots */
+        FChunkList Chunks;
+
+        /** Blocks for requests too large to share a chunk */
+        FChunkList OversizedBlocks;
+
+        /** Bytes of chunks and oversized blocks */
+        uint64 ChunkBytes = 0;
+
+        /** Bytes requested in oversized blocks */
+        uint64 OversizedBytes = 0;
+    };
+
+    /** One thread's cursor into its current chunk, on its own cache line */
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) FSlot
+    {
+        /** Slot lock word (see FAdaptiveSpinWait); held by the owning thread for each allocation */
+        std::atomic<int32> LockState{FAdaptiveSpinWait::Unlocked};
+
+        /** Spin budget of the slot lock */
+        FAdaptiveSpinWait::FSpinBudget LockBudget;
+
+        /** Frame the cursor belongs to; a different frame number means the slot holds no chunk */
+        uint32 FrameNumber = 0;
+
+        /** Next free byte of the current chunk */
+        uint8* Cursor = nullptr;
+
+        /** End of the current chunk */
+        uint8* End = nullptr;
+
+        /** Bytes allocated from this slot in FrameNumber */
+        uint64 AllocatedBytes = 0;
+    };
+
+    /** Gets the calling thread's slot and locks it */
+    FSlot& LockSlot();
+
+    /** Unlocks a slot */
+    static FORCEINLINE void UnlockSlot(FSlot& Slot)
+    {
+        FAdaptiveSpinWait::Unlock(Slot.LockState);
+    }
+
+    /** Gets the live frame for a frame number */
+    FORCEINLINE FFrame& GetFrame(uint32 InFrameNumber) { return Frames[InFrameNumber % BufferCount]; }
+
+    /** Takes a chunk for a frame from the free list or the system allocator; takes ArenaLock */
+    FChunk* AcquireChunk(uint32 InFrameNumber);
+
+    /** Allocates an oversized block for a frame; takes ArenaLock */
+    void* AllocateOversized(uint32 InFrameNumber, uint64 SizeInBytes, uint32 Alignment);
+
+    /** Allocates a chunk from the system allocator and reports it; called under ArenaLock */
+    FChunk* AllocateChunk(uint64 Size);
+
+    /** Reports and frees every chunk in a list; called under ArenaLock */
+    uint64 FreeChunks(FChunkList& List);
+
+    /** Releases a frame's memory, keeping its chunks for reuse; called under ArenaLock */
+    void ResetFrame(FFrame& Frame);
+
+    /** Memory tracker category for chunks */
+    FName CategoryName;
+
+    /** Frames kept alive at once */
+    uint32 BufferCount;
+
+    /** Size of each chunk in bytes, including its header */
+    uint64 ChunkSize;
+
+    /** Thread slots */
+    FSlot Slots[SlotCount];
+
+    /** Live frames by frame number modulo BufferCount */
+    FFrame Frames[MaxBufferCount];
+
+    /** Chunks ready for reuse */
+    FChunkList IdleChunks;
+
+    /** Current frame number; starts at 1 so fresh slots hold no chunk */
+    std::atomic<uint32> FrameNumber;
+
+    /** Bytes held from the system allocator */
+    uint64 ReservedBytes;
+
+    /** Bytes allocated in the last completed frame */
+    uint64 LastFrameBytes;
+
+    /** Most bytes allocated in a single completed frame */
+    uint64 HighWaterBytes;
+
+    /** Most chunk bytes used by a single completed frame */
+    uint64 HighWaterChunkBytes;
+
+    /** Tracker chunks are reported to */
+    IMemoryTracker* MemoryTracker;
+
+    /** Lock for the frames, the idle chunk list, the tracker and the usage figures */
+    mutable FCriticalSection ArenaLock;
+
+#if DO_CHECK
+    /** Threads currently inside Allocate */
+    std::atomic<int32> ActiveAllocators{0};
+#endif
+};
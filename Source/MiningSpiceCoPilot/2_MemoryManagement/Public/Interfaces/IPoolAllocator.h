@@ -116,6 +116,42 @@ public:
      */
     virtual bool Free(void* Ptr) = 0;
     
+    /**
+     * Allocates a relocatable block and returns a handle to it instead of a pointer
+     * The pool may move handle-owned blocks while compacting and only updates the handle's table
+     * slot, so holders never need their pointers fixed up. Resolve the handle each time the block
+     * is used, and free it with FreeHandle; Free rejects a pointer resolved from a handle. Pools
+     * without handle support keep the default and return 0.
+     * @param RequestingObject Optional object for tracking (can be null)
+     * @param AllocationTag Optional tag for tracking allocations
+     * @return Handle to the block, or 0 if allocation failed
+     */
+    virtual uint32 AllocateHandle(const UObject* RequestingObject = nullptr, FName AllocationTag = NAME_None)
+    {
+        return 0;
+    }
+    
+    /**
+     * Frees a block allocated with AllocateHandle
+     * @param Handle Handle to the block
+     * @return True if the handle was live and its block was freed
+     */
+    virtual bool FreeHandle(uint32 Handle)
+    {
+        return false;
+    }
+    
+    /**
+     * Gets the current address of a handle-owned block
+     * The pointer is only valid until the pool next defragments.
+     * @param Handle Handle to the block
+     * @return Pointer to the block, or nullptr if the handle is stale or invalid
+     */
+    virtual void* ResolveHandle(uint32 Handle) const
+    {
+        return nullptr;
+    }
+    
     /**
      * Attempts to grow the pool by adding more blocks
      * @param AdditionalBlockCount Number of blocks to add
@@ -138,6 +174,31 @@ public:
      */
     virtual bool OwnsPointer(const void* Ptr) const = 0;
     
+    /**
+     * Gets the address range reserved for the pool's blocks
+     * Used to map addresses back to their pool without asking every pool; pools whose blocks
+     * do not live in a single reserved range keep the default and return false
+     * @param OutBase Start of the reserved range
+     * @param OutSize Size of the reserved range in bytes
+     * @return True if the pool has a reserved range
+     */
+    virtual bool GetReservedAddressRange(const void*& OutBase, uint64& OutSize) const
+    {
+        OutBase = nullptr;
+        OutSize = 0;
+        return false;
+    }
+    
+    /**
+     * Appends the address ranges the pool currently has committed for its blocks
+     * Used to report where pool memory is physically placed; pools that cannot enumerate their
+     * committed memory keep the default and append nothing
+     * @param OutRanges Receives the start and size in bytes of each range
+     */
+    virtual void GetCommittedRanges(TArray<TPair<const void*, uint64>>& OutRanges) const
+    {
+    }
+    
     /**
      * Sets the memory access pattern for optimizing allocation strategies
      * @param AccessPattern The new access pattern
@@ -214,7 +275,8 @@ public:
     
     /**
      * Sets the NUMA node preference for this pool
-     * @param NodeId NUMA node ID to prefer for allocations
+     * Has no effect on single-node machines.
+     * @param NodeId NUMA node ID to prefer for allocations, or INDEX_NONE for the default policy
      */
     virtual void SetNumaNode(int32 NodeId) = 0;
 };
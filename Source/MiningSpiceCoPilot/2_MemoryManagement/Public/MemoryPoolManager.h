@@ -13,6 +13,9 @@
 #include "Interfaces/IPoolAllocator.h"
 #include "Interfaces/IBufferProvider.h"
 #include "Interfaces/IMemoryTracker.h"
+#include "PoolAddressMap.h"
+#include "SizeClassAllocator.h"
+#include "FrameArenaAllocator.h"
 
 /**
  * Memory pool manager implementation for the SVO+SDF mining system
@@ -165,6 +168,9 @@ public:
      * Used to proactively reduce memory usage
      */
     void OnMemoryWarning();
+    
+    /** Callback at the start of each engine frame; recycles the oldest frame of the frame arena */
+    void OnBeginFrame();
 
     /**
      * Gets the total memory used by this manager
@@ -172,6 +178,30 @@ public:
      */
     uint64 GetTotalMemoryUsage() const { return GetMemoryUsage(NAME_None); }
     
+    /**
+     * Gets the size-class allocator serving small Allocate requests
+     * @return Size-class allocator, for its per-class usage
+     */
+    const FSizeClassAllocator& GetSizeClassAllocator() const { return SizeClassAllocator; }
+    
+    /**
+     * Gets the shared double-buffered arena for per-frame scratch data
+     * The manager calls BeginFrame on it at the start of every engine frame, so an allocation stays
+     * valid through the frame after the one it was made in. Allocate from the game thread, or from
+     * work that finishes before the next frame starts; an allocation racing with the frame
+     * boundary trips a check.
+     * @return Frame arena, reported to the memory tracker under the FrameArena category
+     */
+    FFrameArenaAllocator& GetFrameArena() { return FrameArena; }
+    
+    /**
+     * Gets the address ranges every pool currently has committed for its blocks
+     * Pool blocks are not tracked as individual allocations, so this is how reports that look at
+     * physical pages see pool memory.
+     * @param OutRanges Receives the start and size in bytes of each range
+     */
+    void GetPoolCommittedRanges(TArray<TPair<const void*, uint64>>& OutRanges) const;
+    
     /**
      * Creates a type-specific memory pool for registered types
      * @param TypeId The ID of the type to create a pool for
@@ -274,6 +304,14 @@ private:
      * @return The number of bytes freed
      */
     uint64 ReleaseUnusedResources(float MaxTimeMs = 5.0f);
+    
+    /**
+     * Brings PoolAddressMap in line with the ranges the pools currently reserve
+     * Pools reserve a new range each time they are initialized, which callers can do directly, so
+     * every pool whose range differs from its mapped one is unmapped and mapped again.
+     * Must be called with PoolsLock held for writing.
+     */
+    void UpdatePoolAddressMap() const;
 
     /** Memory tracker instance */
     IMemoryTracker* MemoryTracker;
@@ -284,6 +322,31 @@ private:
     /** Map of registered memory pools by name */
     TMap<FName, TSharedPtr<IPoolAllocator>> Pools;
     
+    /** Owning pool by address region, for pointer lookups without the pools lock; written under PoolsLock */
+    mutable FPoolAddressMap PoolAddressMap;
+    
+    /** Reserved range a pool is mapped with in PoolAddressMap */
+    struct FMappedPoolRange
+    {
+        const void* Base = nullptr;
+        uint64 Size = 0;
+    };
+    
+    /** Range each pool is mapped with, null for pools that are not mapped; written under PoolsLock */
+    mutable TMap<IPoolAllocator*, FMappedPoolRange> MappedPoolRanges;
+    
+    /** FSegmentedPoolStorage::GetAddressRangeEpoch when PoolAddressMap was last updated */
+    mutable std::atomic<uint32> MappedRangeEpoch;
+    
+    /** Number of pools without a mapped range, which pointer lookups must still scan */
+    mutable FThreadSafeCounter UnmappedPoolCount;
+    
+    /** Slabs for Allocate requests up to FSizeClassAllocator::MaxAllocationSize, not tracked per allocation */
+    FSizeClassAllocator SizeClassAllocator;
+    
+    /** Shared per-frame scratch arena, double-buffered for async readers */
+    FFrameArenaAllocator FrameArena;
+    
     /** Map of registered buffers by name */
     TMap<FName, TSharedPtr<IBufferProvider>> Buffers;
     
@@ -8,6 +8,11 @@
 #include "Math/Vector.h"
 #include "Containers/RingBuffer.h"
 #include "CompressionUtility.h" // Include for EMaterialCompressionLevel
+#include "SegmentedPoolStorage.h"
+#include "PoolMagazineCache.h"
+#include "BlockAllocationBitmap.h"
+#include "NarrowBandQuantization.h"
+#include "PoolHandleTable.h"
 
 /**
  * Enum defining supported SIMD instruction sets for memory layout optimization
@@ -52,9 +57,14 @@ public:
     virtual uint32 GetBlockSize() const override;
     virtual void* Allocate(const UObject* RequestingObject = nullptr, FName AllocationTag = NAME_None) override;
     virtual bool Free(void* Ptr) override;
+    virtual uint32 AllocateHandle(const UObject* RequestingObject = nullptr, FName AllocationTag = NAME_None) override;
+    virtual bool FreeHandle(uint32 Handle) override;
+    virtual void* ResolveHandle(uint32 Handle) const override;
     virtual bool Grow(uint32 AdditionalBlockCount, bool bForceGrowth = false) override;
     virtual uint32 Shrink(uint32 MaxBlocksToRemove = UINT32_MAX) override;
     virtual bool OwnsPointer(const void* Ptr) const override;
+    virtual bool GetReservedAddressRange(const void*& OutBase, uint64& OutSize) const override;
+    virtual void GetCommittedRanges(TArray<TPair<const void*, uint64>>& OutRanges) const override;
     virtual void SetAccessPattern(EMemoryAccessPattern AccessPattern) override;
     virtual EMemoryAccessPattern GetAccessPattern() const override;
     virtual FPoolStats GetStats() const override;
@@ -70,10 +80,15 @@ public:
 
     /**
      * Sets the precision tier for this allocator
-     * Affects memory layout and representation of distance field values
+     * Blocks hold distance values encoded as 32-bit floats (Hot), 16-bit floats (Warm), bytes
+     * normalized by the band width (Cold) or packed 4-bit values normalized by the band width
+     * (Archive). Allocated blocks are converted in place, and whole pages past each block's
+     * encoded values are returned to the OS. While no block is allocated the values per block are
+     * re-derived to fill a block in the new tier instead. Blocks must not be accessed during the call.
      * @param NewTier Precision tier to use (Hot=high, Warm=medium, Cold=low, Archive=compressed)
+     * @return True if the tier was applied; false if the values per block do not fit a block in the new tier
      */
-    void SetPrecisionTier(EMemoryTier NewTier);
+    bool SetPrecisionTier(EMemoryTier NewTier);
 
     /**
      * Gets the current precision tier
@@ -81,6 +96,88 @@ public:
      */
     EMemoryTier GetPrecisionTier() const;
 
+    /**
+     * Sets the band width Cold and Archive values are normalized by
+     * Distances beyond the band width saturate at it in those tiers. Allocated blocks in those
+     * tiers are re-encoded with the new width.
+     * @param NewBandWidth Band width in distance units, greater than zero
+     * @return True if the band width was applied
+     */
+    bool SetBandWidth(float NewBandWidth);
+
+    /**
+     * Gets the band width Cold and Archive values are normalized by
+     * @return Band width in distance units
+     */
+    float GetBandWidth() const;
+
+    /**
+     * Gets the number of distance values each block holds
+     * Multi-channel data interleaves channels within a block.
+     * @return Values per block
+     */
+    uint32 GetValuesPerBlock() const;
+
+    /**
+     * Gets the bytes at the front of each block holding its encoded values
+     * @return Encoded bytes per block in the current tier
+     */
+    uint32 GetEncodedBlockBytes() const;
+
+    /**
+     * Gets the bytes of pool memory committed after releasing the unused tails of blocks and
+     * fully free segments
+     * @return Resident bytes
+     */
+    uint64 GetResidentBytes() const;
+
+    /**
+     * Allows transparent huge pages for the pool, on by default
+     * Huge pages are only requested while the pool is in the Hot tier. Narrower tiers release the
+     * unused tail of every block, which would split huge pages, so they stay on normal pages.
+     * @param bEnable Whether huge pages may be used
+     * @return True if the platform accepted the resulting request
+     */
+    bool SetHugePages(bool bEnable);
+
+    /**
+     * Sets whether Shrink releases free segments lazily
+     * Lazily released pages are reclaimed by the OS only under memory pressure, which makes
+     * reusing them cheaper but keeps them counted as resident until then. Only Linux honors this.
+     * @param bEnable Whether to release lazily
+     */
+    void SetLazySegmentRelease(bool bEnable);
+
+    /**
+     * Decodes distance values from a block whatever its tier
+     * Not synchronized with tier changes; callers must not read while the tier changes.
+     * @param Ptr Block returned by Allocate
+     * @param FirstValue Index of the first value to read
+     * @param Count Number of values to read
+     * @param OutValues Receives the values
+     * @return True if the block and range are valid
+     */
+    bool ReadValues(const void* Ptr, uint32 FirstValue, uint32 Count, float* OutValues) const;
+
+    /**
+     * Decodes one distance value from a block
+     * @param Ptr Block returned by Allocate
+     * @param ValueIndex Index of the value
+     * @return Value, or zero if the block or index is invalid
+     */
+    float ReadValue(const void* Ptr, uint32 ValueIndex) const;
+
+    /**
+     * Encodes distance values into a block in the current tier
+     * Not synchronized with tier changes; callers must not write while the tier changes.
+     * @param Ptr Block returned by Allocate
+     * @param FirstValue Index of the first value to write
+     * @param Count Number of values to write
+     * @param Values Values to store
+     * @return True if the block and range are valid
+     */
+    bool WriteValues(void* Ptr, uint32 FirstValue, uint32 Count, const float* Values);
+
     /**
      * Sets the number of material channels per element
      * @param NewChannelCount Number of material channels
@@ -123,7 +220,8 @@ public:
 
     /**
      * Packs blocks to optimize for spatial locality based on position data
-     * More expensive than standard defragmentation but improves cache coherence
+     * More expensive than standard defragmentation but improves cache coherence. Blocks move, so
+     * pointers to them go stale; handles from AllocateHandle keep resolving.
      * @param MaxTimeMs Maximum time to spend packing in milliseconds
      * @return True if packing was performed
      */
@@ -131,11 +229,26 @@ public:
 
     /**
      * Optimizes memory layout based on distance from surface for narrow band efficiency
+     * Blocks move, so pointers to them go stale; handles from AllocateHandle keep resolving.
      * @param MaxTimeMs Maximum time to spend reorganizing in milliseconds
      * @return True if optimization was performed
      */
     bool OptimizeNarrowBand(float MaxTimeMs = 10.0f);
 
+    /**
+     * Enables or disables recording of allocation tags, requesting objects and times
+     * Tracking data lives in a side table that is only allocated while tracking is on, and only
+     * covers allocations made while it is on.
+     * @param bEnable Whether to record tracking data
+     */
+    void SetDebugTracking(bool bEnable);
+
+    /**
+     * Checks whether allocation tracking data is being recorded
+     * @return True if debug tracking is on
+     */
+    bool IsDebugTracking() const;
+
     /**
      * Allocates memory for material channels
      * @param MaterialTypeId ID of the material type
@@ -169,6 +282,7 @@ public:
 private:
     /**
      * Allocates memory for the pool with appropriate alignment for SIMD operations
+     * The block count is rounded up to whole storage segments
      * @param BlockCount Number of blocks to allocate
      * @return True if allocation was successful
      */
@@ -191,6 +305,23 @@ private:
      */
     int32 GetBlockIndex(const void* Ptr) const;
 
+    /**
+     * Takes a batch of free blocks for the magazine cache and marks them allocated
+     * Grows the pool if no block is free and growth is allowed
+     * @param OutBlockIndices Receives the block indices
+     * @param MaxCount Maximum number of blocks to take
+     * @return Number of blocks taken
+     */
+    uint32 AllocateBatch(uint32* OutBlockIndices, uint32 MaxCount);
+
+    /**
+     * Returns a batch of blocks from the magazine cache to the free list
+     * Blocks that are already free are skipped with a warning
+     * @param BlockIndices Indices of the blocks being freed
+     * @param Count Number of blocks
+     */
+    void FreeBatch(const uint32* BlockIndices, uint32 Count);
+
     /**
      * Gets the optimal element alignment based on current precision tier
      * @return Alignment in bytes
@@ -203,6 +334,44 @@ private:
      */
     uint32 GetBytesPerChannel() const;
     
+    /**
+     * Re-encodes every allocated block for a new tier or band width, one segment at a time
+     * Called with the magazines flushed and the pool lock held
+     * @param NewTier Tier to convert to
+     * @param NewBandWidth Band width to encode with
+     * @return True if the blocks were converted
+     */
+    bool ConvertBlocks(EMemoryTier NewTier, float NewBandWidth);
+    
+    /**
+     * Checks that a pointer is a block and a value range lies inside it
+     * @return True if both are valid
+     */
+    bool IsValidValueRange(const void* Ptr, uint32 FirstValue, uint32 Count) const;
+    
+    /**
+     * Requests huge pages from the storage if they are allowed and the tier keeps blocks whole
+     * @return True if the platform accepted the request
+     */
+    bool ApplyHugePagePolicy();
+    
+    /**
+     * Returns the pages of fully free segments past the first to the OS, wherever they lie
+     * Their blocks leave the free list until RecommitReleasedSegment brings the segment back.
+     * @param MaxBlocks Maximum number of blocks to release
+     * @return Number of blocks released
+     */
+    uint32 ReleaseFreeSegments(uint32 MaxBlocks);
+    
+    /**
+     * Recommits one released segment and returns its blocks to the free list
+     * @return False if no segment is released
+     */
+    bool RecommitReleasedSegment();
+    
+    /** Recommits every released segment, ahead of operations that move or rebuild free blocks */
+    void RecommitReleasedSegments();
+    
     /**
      * Prefetches blocks that are likely to be accessed based on mining direction
      * and recent access patterns
@@ -217,38 +386,82 @@ private:
      */
     uint64 PositionToZOrder(const FVector& Position, float GridSize = 4.0f) const;
     
-    /** Structure containing metadata for tracking memory block allocations */
-    struct FBlockMetadata
+    /** Allocation tracking data for a block, kept only while debug tracking is on */
+    struct FBlockTrackingInfo
     {
-        /** Whether this block is currently allocated */
-        bool bAllocated;
-        
         /** Allocation tag for tracking */
         FName AllocationTag;
         
         /** Object that requested this allocation */
         TWeakObjectPtr<const UObject> RequestingObject;
         
+        /** Time when this block was allocated */
+        double AllocationTime;
+        
+        /** Constructor */
+        FBlockTrackingInfo()
+            : AllocationTag(NAME_None)
+            , RequestingObject(nullptr)
+            , AllocationTime(0.0)
+        {
+        }
+    };
+    
+    /** Spatial data for a block, kept once any block has been given a position or distance */
+    struct FBlockSpatialInfo
+    {
         /** Position this block is associated with (for spatial prefetching) */
         FVector Position;
         
-        /** Time when this block was allocated */
-        double AllocationTime;
-
         /** Distance from the surface (0 = directly on surface) */
         float DistanceFromSurface;
         
         /** Constructor */
-        FBlockMetadata()
-            : bAllocated(false)
-            , AllocationTag(NAME_None)
-            , RequestingObject(nullptr)
-            , Position(FVector::ZeroVector)
-            , AllocationTime(0.0)
+        FBlockSpatialInfo()
+            : Position(FVector::ZeroVector)
             , DistanceFromSurface(0.0f)
         {
         }
     };
+    
+    /**
+     * Marks a block allocated and records tracking data if tracking is on
+     * @param BlockIndex Block being allocated
+     * @param RequestingObject Object that requested the allocation
+     * @param AllocationTag Tag for the allocation
+     * @param AllocationTime Time of the allocation
+     */
+    void MarkBlockAllocated(uint32 BlockIndex, const UObject* RequestingObject, FName AllocationTag, double AllocationTime);
+    
+    /**
+     * Marks a block free and clears its side table entries
+     * @param BlockIndex Block being freed
+     */
+    void MarkBlockFree(uint32 BlockIndex);
+    
+    /**
+     * Resizes the allocation bitmap and any side tables to the current block count
+     * @param NewBlockCount Number of blocks in the pool
+     */
+    void ResizeBlockMetadata(uint32 NewBlockCount);
+    
+    /**
+     * Rebuilds metadata, handles and the free list after blocks were compacted to the front of the pool
+     * @param Order Old indices of the blocks now at 0..Order.Num()-1
+     */
+    void CompactBlockMetadata(const TArray<uint32>& Order);
+    
+    /** Gets the position of a block, or zero if no positions have been set */
+    FORCEINLINE const FVector& GetBlockPosition(uint32 BlockIndex) const
+    {
+        return BlockSpatial.Num() > 0 ? BlockSpatial[BlockIndex].Position : FVector::ZeroVector;
+    }
+    
+    /** Gets the distance from the surface of a block, or zero if no distances have been set */
+    FORCEINLINE float GetBlockDistance(uint32 BlockIndex) const
+    {
+        return BlockSpatial.Num() > 0 ? BlockSpatial[BlockIndex].DistanceFromSurface : 0.0f;
+    }
 
     /** Name of this pool */
     FName PoolName;
@@ -256,8 +469,8 @@ private:
     /** Size of each block in bytes */
     uint32 BlockSize;
     
-    /** Base address of the pool memory */
-    uint8* PoolMemory;
+    /** Segmented block storage; blocks never move when the pool grows */
+    FSegmentedPoolStorage Storage;
     
     /** Maximum number of blocks this pool can hold (initial capacity) */
     uint32 MaxBlockCount;
@@ -268,24 +481,51 @@ private:
     /** Array of free block indices */
     TArray<uint32> FreeBlocks;
     
-    /** Array of metadata for each block */
-    TArray<FBlockMetadata> BlockMetadata;
+    /** Allocation state of each block, one bit per block */
+    FBlockAllocationBitmap AllocatedBits;
+    
+    /** Tracking data per block; empty unless debug tracking is on */
+    TArray<FBlockTrackingInfo> BlockTracking;
+    
+    /** Spatial data per block; empty until a position or distance is first set */
+    TArray<FBlockSpatialInfo> BlockSpatial;
     
     /** Lock for thread safety */
     mutable FCriticalSection PoolLock;
     
+    /** Per-thread caches of free blocks serving untracked allocations without the pool lock */
+    FPoolMagazineCache MagazineCache;
+    
+    /** Indirection from handles to blocks allocated with AllocateHandle; written under PoolLock */
+    FPoolHandleTable Handles;
+    
     /** Whether this pool has been initialized */
     bool bIsInitialized;
     
     /** Whether this pool allows growth beyond initial capacity */
     bool bAllowsGrowth;
     
+    /** Whether allocation tags, requesting objects and times are recorded */
+    bool bDebugTracking;
+    
+    /** Whether huge pages may be used while the pool is in the Hot tier */
+    bool bHugePagesAllowed;
+    
+    /** Whether Shrink releases free segments lazily */
+    bool bLazySegmentRelease;
+    
     /** Memory access pattern for this pool */
     EMemoryAccessPattern AccessPattern;
     
     /** Precision tier for this narrow band */
     EMemoryTier PrecisionTier;
     
+    /** Band width Cold and Archive values are normalized by */
+    float BandWidth;
+    
+    /** Distance values stored in each block */
+    uint32 ValuesPerBlock;
+    
     /** Number of material channels per element */
     uint32 ChannelCount;
     
@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IMemoryManager.h"
+
+/**
+ * Encodings of narrow-band distance values for each precision tier
+ *
+ * Hot stores 32-bit floats, Warm 16-bit floats, Cold one signed byte per value and Archive one
+ * signed 4-bit value per value, two to a byte. Cold and Archive store distance divided by the band
+ * width, so values outside [-BandWidth, BandWidth] saturate at the band edge. Zero bytes decode to
+ * zero in every tier, so freshly cleared blocks read as zero whatever the tier.
+ *
+ * The bulk kernels use SSE2 on x86 and plain loops elsewhere.
+ */
+struct MININGSPICECOPILOT_API FNarrowBandQuantization
+{
+    /** Gets the bits stored per value in a tier */
+    static uint32 GetBitsPerValue(EMemoryTier Tier);
+
+    /**
+     * Gets the bytes needed to encode values in a tier
+     * @param Tier Precision tier
+     * @param ValueCount Number of values
+     */
+    static uint32 GetEncodedSize(EMemoryTier Tier, uint32 ValueCount);
+
+    /**
+     * Gets the largest decoding error for values within [-BandWidth, BandWidth]
+     * Warm error is relative to the value; the bound given is for a value at the band edge.
+     * @param Tier Precision tier
+     * @param BandWidth Band width the values were encoded with
+     */
+    static float GetMaxError(EMemoryTier Tier, float BandWidth);
+
+    /**
+     * Encodes a range of values into an encoded block
+     * @param Tier Precision tier of the encoded block
+     * @param Values Values to encode
+     * @param FirstValue Index in the encoded block of the first value
+     * @param Count Number of values
+     * @param BandWidth Band width Cold and Archive values are normalized by
+     * @param Encoded Start of the encoded block; must not overlap Values
+     */
+    static void Encode(EMemoryTier Tier, const float* Values, uint32 FirstValue, uint32 Count, float BandWidth, uint8* Encoded);
+
+    /**
+     * Decodes a range of values from an encoded block
+     * @param Tier Precision tier of the encoded block
+     * @param Encoded Start of the encoded block
+     * @param FirstValue Index in the encoded block of the first value
+     * @param Count Number of values
+     * @param BandWidth Band width the values were encoded with
+     * @param OutValues Receives the values; must not overlap Encoded
+     */
+    static void Decode(EMemoryTier Tier, const uint8* Encoded, uint32 FirstValue, uint32 Count, float BandWidth, float* OutValues);
+
+    /**
+     * Re-encodes a block in place from one tier to another
+     * The block must be large enough for ValueCount values in both tiers.
+     * @param Block Start of the block
+     * @param ValueCount Number of values in the block
+     * @param FromTier Current tier of the block
+     * @param FromBandWidth Band width the block was encoded with
+     * @param ToTier Tier to convert to
+     * @param ToBandWidth Band width to encode with
+     */
+    static void Convert(uint8* Block, uint32 ValueCount, EMemoryTier FromTier, float FromBandWidth, EMemoryTier ToTier, float ToBandWidth);
+};
@@ -0,0 +1,53 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * NUMA placement of pool memory
+ *
+ * On Linux, ranges are bound to a node with the mbind system call. The policy is preferred rather
+ * than strict, so pages still come from another node when the preferred one is full. Binding also
+ * migrates pages that are already resident. If the kernel rejects mbind, for example because it
+ * was built without NUMA support, pages are placed by first touch instead: the calling thread is
+ * pinned to the node's CPUs while it writes each page, so the default local policy puts the page
+ * on that node. Page placement is read back with move_pages.
+ *
+ * The system calls are made directly, so libnuma is not needed at build or run time. Other
+ * platforms report a single node and place nothing.
+ */
+struct MININGSPICECOPILOT_API FNumaMemory
+{
+    /** Gets the number of NUMA nodes, 1 where NUMA is unsupported */
+    static int32 GetNodeCount();
+
+    /**
+     * Sets the node that pages in a range are taken from, migrating resident pages
+     * @param Ptr Start of the range, page aligned
+     * @param Size Size of the range in bytes
+     * @param NodeId Node to prefer, or INDEX_NONE to restore the default local policy
+     * @return True if the policy was applied; false if the kernel does not support it
+     */
+    static bool BindRange(void* Ptr, uint64 Size, int32 NodeId);
+
+    /**
+     * Faults in every page of a range from a thread pinned to a node
+     * Pages already resident stay where they are, and page contents are preserved. No other
+     * thread may write to the range meanwhile.
+     * @param Ptr Start of the range, page aligned
+     * @param Size Size of the range in bytes
+     * @param NodeId Node to place the pages on
+     * @return True if the calling thread could be pinned to the node while touching the pages
+     */
+    static bool TouchRangeOnNode(void* Ptr, uint64 Size, int32 NodeId);
+
+    /**
+     * Gets the node holding each of a set of pages
+     * @param Pages Addresses inside the pages to look up
+     * @param Count Number of pages
+     * @param OutNodes Receives each page's node, or INDEX_NONE if the page is not resident
+     * @return False if placement cannot be queried on this platform
+     */
+    static bool GetPageNodes(const void* const* Pages, int32 Count, int32* OutNodes);
+};
@@ -0,0 +1,120 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SegmentedPoolStorage.h"
+#include <atomic>
+
+class IPoolAllocator;
+
+/**
+ * Two-level radix table from addresses to the pools that own them
+ *
+ * Pools reserve their storage as aligned ranges of whole regions (see
+ * FSegmentedPoolStorage::AddressRangeAlignment), so a region belongs to at most one pool and the
+ * owner of an address is found by shifting the address down to its region number and indexing a
+ * root table and then a leaf table. Find is lock-free and constant time regardless of pool count.
+ *
+ * Leaves are allocated on first use and kept until the map is destroyed, so a lookup racing with
+ * Unregister sees either the pool or null, never freed memory. Register, Unregister and Empty
+ * must be serialized by the caller.
+ */
+class MININGSPICECOPILOT_API FPoolAddressMap
+{
+public:
+    /** Bits of an address below the region number */
+    static constexpr uint32 RegionShift = 26;
+
+    /** Bytes covered by each entry */
+    static constexpr uint64 RegionSize = 1ull << RegionShift;
+
+    /** Bits of user-space addresses covered by the table; higher addresses are never mapped */
+    static constexpr uint32 AddressBits = 48;
+
+    /** Region number bits resolved by a leaf */
+    static constexpr uint32 LeafBits = 11;
+
+    /** Region number bits resolved by the root */
+    static constexpr uint32 RootBits = AddressBits - RegionShift - LeafBits;
+
+    static_assert(RegionSize == FSegmentedPoolStorage::AddressRangeAlignment, "Pool address ranges must be aligned to whole regions");
+
+    /** Constructor */
+    FPoolAddressMap();
+
+    /** Destructor, frees the leaves */
+    ~FPoolAddressMap();
+
+    FPoolAddressMap(const FPoolAddressMap&) = delete;
+    FPoolAddressMap& operator=(const FPoolAddressMap&) = delete;
+
+    /**
+     * Maps every region of a pool's reserved range to the pool
+     * @param Base Start of the range, aligned to RegionSize
+     * @param Size Size of the range in bytes, a multiple of RegionSize
+     * @param Pool Pool owning the range
+     * @return True if the range was mapped; false if it is misaligned, out of range or overlaps another pool
+     */
+    bool Register(const void* Base, uint64 Size, IPoolAllocator* Pool);
+
+    /**
+     * Removes the regions of a range that map to a pool
+     * @param Base Start of the range passed to Register
+     * @param Size Size of the range passed to Register
+     * @param Pool Pool the range was registered for
+     */
+    void Unregister(const void* Base, uint64 Size, IPoolAllocator* Pool);
+
+    /** Removes every mapping; leaves stay allocated for concurrent readers */
+    void Empty();
+
+    /**
+     * Finds the pool whose reserved range contains an address
+     * The pool still has to confirm the address is inside a committed block.
+     * @param Ptr Address to look up
+     * @return Owning pool, or null if no registered range contains the address
+     */
+    FORCEINLINE IPoolAllocator* Find(const void* Ptr) const
+    {
+        const UPTRINT Region = reinterpret_cast<UPTRINT>(Ptr) >> RegionShift;
+        if ((Region >> (RootBits + LeafBits)) != 0)
+        {
+            return nullptr;
+        }
+
+        const FLeaf* Leaf = Root[Region >> LeafBits].load(std::memory_order_acquire);
+        return Leaf ? Leaf->Entries[Region & (LeafSize - 1)].load(std::memory_order_acquire) : nullptr;
+    }
+
+    /** Gets the number of regions currently mapped */
+    FORCEINLINE uint32 GetMappedRegionCount() const { return MappedRegionCount; }
+
+    /** Gets the bytes used by the root and the allocated leaves */
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    static constexpr uint32 RootSize = 1u << RootBits;
+    static constexpr uint32 LeafSize = 1u << LeafBits;
+
+    /** Owners of LeafSize consecutive regions */
+    struct FLeaf
+    {
+        std::atomic<IPoolAllocator*> Entries[LeafSize];
+    };
+
+    /**
+     * Gets the region numbers spanned by a range
+     * @return False if the range is misaligned, empty or outside the mapped address space
+     */
+    static bool GetRegionRange(const void* Base, uint64 Size, UPTRINT& OutFirstRegion, UPTRINT& OutEndRegion);
+
+    /** Leaves by the high bits of the region number */
+    std::atomic<FLeaf*> Root[RootSize];
+
+    /** Number of allocated leaves */
+    uint32 LeafCount;
+
+    /** Number of regions currently mapped */
+    uint32 MappedRegionCount;
+};
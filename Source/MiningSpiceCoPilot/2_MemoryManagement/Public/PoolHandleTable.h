@@ -0,0 +1,149 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Indirection table from relocatable pool handles to block indices
+ *
+ * A handle is 32 bits: the low IndexBits select a table slot and the high GenerationBits hold
+ * the slot's generation when the handle was issued. A slot's generation advances each time its
+ * handle is removed, so a stale handle no longer resolves unless the slot has been reused
+ * 2^GenerationBits - 1 times since. Generations start at 1, so 0 is never a valid handle.
+ *
+ * The table also records which slot refers to each block. When the pool moves blocks it reports
+ * the moves here, and exactly one slot is rewritten per moved block, however many places hold the
+ * handle.
+ *
+ * Slots live in fixed pages that are allocated on first use and kept until the table is
+ * destroyed, so Resolve is lock-free and never reads freed memory. Every other call must be
+ * serialized by the owning pool's lock. A resolved block index is only good until the pool next
+ * moves blocks.
+ */
+class MININGSPICECOPILOT_API FPoolHandleTable
+{
+public:
+    /** Handle bits that select a slot */
+    static constexpr uint32 IndexBits = 24;
+
+    /** Handle bits that hold the slot generation */
+    static constexpr uint32 GenerationBits = 32 - IndexBits;
+
+    /** Most handles a table can hold at once */
+    static constexpr uint32 MaxHandles = 1u << IndexBits;
+
+    /** Handle value that never resolves */
+    static constexpr uint32 InvalidHandle = 0;
+
+    /** Constructor */
+    FPoolHandleTable();
+
+    /** Destructor, frees the pages */
+    ~FPoolHandleTable();
+
+    FPoolHandleTable(const FPoolHandleTable&) = delete;
+    FPoolHandleTable& operator=(const FPoolHandleTable&) = delete;
+
+    /**
+     * Issues a handle for an allocated block
+     * @param BlockIndex Block the handle refers to; must not already have a handle
+     * @return Handle, or InvalidHandle if the table is full
+     */
+    uint32 Add(uint32 BlockIndex);
+
+    /**
+     * Retires a handle
+     * @param Handle Handle to retire
+     * @return Block the handle referred to, or INDEX_NONE if the handle is stale or invalid
+     */
+    int32 Remove(uint32 Handle);
+
+    /**
+     * Records that a block moved to another index
+     * @param FromBlock Old block index
+     * @param ToBlock New block index, which must not have a handle
+     */
+    void MoveBlock(uint32 FromBlock, uint32 ToBlock);
+
+    /**
+     * Records that blocks were compacted to the front of the pool
+     * @param Order Old indices of the blocks now at 0..Order.Num()-1; blocks not listed lose their handles
+     */
+    void PermuteBlocks(const TArray<uint32>& Order);
+
+    /** Retires every handle */
+    void Empty();
+
+    /**
+     * Gets the block a handle refers to, without locking
+     * @param Handle Handle to resolve
+     * @return Block index, or INDEX_NONE if the handle is stale or invalid
+     */
+    FORCEINLINE int32 Resolve(uint32 Handle) const
+    {
+        const uint32 SlotIndex = Handle & (MaxHandles - 1);
+        const FSlot* Page = Pages[SlotIndex >> PageBits].load(std::memory_order_acquire);
+        if (Handle == InvalidHandle || !Page)
+        {
+            return INDEX_NONE;
+        }
+
+        const uint64 Entry = Page[SlotIndex & (PageSize - 1)].load(std::memory_order_acquire);
+        const uint32 BlockIndex = static_cast<uint32>(Entry);
+        return (Entry >> 32) == (Handle >> IndexBits) && BlockIndex != FreeEntry ? static_cast<int32>(BlockIndex) : INDEX_NONE;
+    }
+
+    /**
+     * Checks whether a block is referred to by a handle
+     * @param BlockIndex Block to check
+     */
+    FORCEINLINE bool HasHandle(uint32 BlockIndex) const
+    {
+        return BlockSlots.IsValidIndex(BlockIndex) && BlockSlots[BlockIndex] != FreeEntry;
+    }
+
+    /** Gets the number of live handles */
+    FORCEINLINE uint32 Num() const { return HandleCount; }
+
+    /** Gets the bytes used by the pages and side tables */
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    /** Slot bits resolved within a page */
+    static constexpr uint32 PageBits = 14;
+
+    static constexpr uint32 PageSize = 1u << PageBits;
+    static constexpr uint32 PageCount = MaxHandles / PageSize;
+
+    /** Block index stored in slots without a live handle */
+    static constexpr uint32 FreeEntry = MAX_uint32;
+
+    /** Generation in the high 32 bits and block index in the low 32 bits */
+    typedef std::atomic<uint64> FSlot;
+
+    /** Gets a slot; its page must exist */
+    FORCEINLINE FSlot& GetSlot(uint32 SlotIndex) const
+    {
+        return Pages[SlotIndex >> PageBits].load(std::memory_order_relaxed)[SlotIndex & (PageSize - 1)];
+    }
+
+    /** Points a live slot at a block, keeping its generation */
+    void SetSlotBlock(uint32 SlotIndex, uint32 BlockIndex);
+
+    /** Slot pages by the high bits of the slot index */
+    std::atomic<FSlot*> Pages[PageCount];
+
+    /** Slots whose handles were removed, ready for reuse */
+    TArray<uint32> FreeSlots;
+
+    /** Slot referring to each block, or FreeEntry */
+    TArray<uint32> BlockSlots;
+
+    /** Slots handed out so far, live or free */
+    uint32 SlotCount;
+
+    /** Number of live handles */
+    uint32 HandleCount;
+};
@@ -0,0 +1,182 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LockFreeList.h"
+#include "Templates/Function.h"
+#include "AdaptiveSpinWait.h"
+#include <atomic>
+
+/**
+ * Per-thread magazines of free block indices in front of a fixed-size block pool
+ *
+ * Each thread works out of its own slot holding two magazines of up to MagazineSize block indices.
+ * A thread claims a free slot on first use and gives it back when it exits, so thread churn does
+ * not use slots up; only threads that start while all SlotCount slots are claimed share one.
+ * Allocate and Free only touch the calling thread's slot, so the common case costs an uncontended
+ * slot lock and an array push or pop. When a slot runs dry it takes a full magazine from a shared
+ * lock-free depot, and only if the depot is empty does it refill a batch from the pool under the
+ * pool lock. When a slot overflows it hands a full magazine to the depot. Blocks freed on a
+ * different thread from the one that allocated them therefore flow back to allocating threads
+ * through the depot without touching the pool lock.
+ *
+ * Blocks held in magazines count as allocated to the pool. Before the pool reorganizes or frees
+ * blocks it takes an FExclusiveScope, which locks every slot and returns every cached block to the
+ * pool.
+ *
+ * Lock order: a slot lock is taken before the pool lock, never after it.
+ */
+class MININGSPICECOPILOT_API FPoolMagazineCache
+{
+public:
+    /** Number of thread slots; threads beyond this many live at once share slots */
+    static constexpr int32 SlotCount = 64;
+
+    /** Block indices per magazine, which is also the batch size for pool refills and flushes */
+    static constexpr uint32 MagazineSize = 32;
+
+    /** Full magazines the depot holds before further overflow is flushed to the pool */
+    static constexpr int32 MaxDepotMagazines = SlotCount * 2;
+
+    /**
+     * Takes up to MaxCount free blocks from the pool and marks them allocated
+     * Called with a slot lock held; takes the pool lock
+     */
+    typedef TFunction<uint32(uint32* OutBlockIndices, uint32 MaxCount)> FRefillFunction;
+
+    /**
+     * Returns blocks to the pool's free list
+     * Called with a slot lock held; takes the pool lock
+     */
+    typedef TFunction<void(const uint32* BlockIndices, uint32 Count)> FFlushFunction;
+
+    /**
+     * Constructor
+     * @param InRefill Function that takes blocks from the pool
+     * @param InFlush Function that gives blocks back to the pool
+     */
+    FPoolMagazineCache(FRefillFunction InRefill, FFlushFunction InFlush);
+
+    /** Destructor; cached blocks are dropped without being flushed */
+    ~FPoolMagazineCache();
+
+    FPoolMagazineCache(const FPoolMagazineCache&) = delete;
+    FPoolMagazineCache& operator=(const FPoolMagazineCache&) = delete;
+
+    /**
+     * Takes a free block for the calling thread
+     * @return Block index, or INDEX_NONE if the pool is exhausted
+     */
+    int32 Allocate();
+
+    /**
+     * Caches a freed block for the calling thread
+     * The block must be allocated and no longer owned by a caller; the pool rejects a second free
+     * of the same block before it gets here
+     * @param BlockIndex Index of the block being freed
+     */
+    void Free(uint32 BlockIndex);
+
+    /**
+     * Gets the number of blocks currently cached
+     * Approximate while other threads are allocating
+     */
+    uint32 GetCachedBlockCount() const;
+
+    /**
+     * Gets the allocations and frees served by the magazines
+     * @param OutAllocations Blocks handed out
+     * @param OutFrees Blocks taken back
+     */
+    void GetOperationCounts(uint64& OutAllocations, uint64& OutFrees) const;
+
+    /**
+     * Locks every slot and returns every cached block to the pool for the scope's lifetime
+     * Take this before acquiring the pool lock in any operation that moves, frees or resets blocks.
+     */
+    class MININGSPICECOPILOT_API FExclusiveScope
+    {
+    public:
+        explicit FExclusiveScope(FPoolMagazineCache& InCache);
+        ~FExclusiveScope();
+
+        FExclusiveScope(const FExclusiveScope&) = delete;
+        FExclusiveScope& operator=(const FExclusiveScope&) = delete;
+
+    private:
+        FPoolMagazineCache& Cache;
+    };
+
+private:
+    /** Fixed-capacity stack of block indices */
+    struct FMagazine
+    {
+        uint32 Count = 0;
+        uint32 Blocks[MagazineSize];
+    };
+
+    /** One thread's magazines, on its own cache line */
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) FSlot
+    {
+        /** Slot lock word (see FAdaptiveSpinWait); held by the owning thread for each operation and by exclusive scopes */
+        std::atomic<int32> LockState{FAdaptiveSpinWait::Unlocked};
+
+        /** Spin budget of the slot lock */
+        FAdaptiveSpinWait::FSpinBudget LockBudget;
+
+        /** Magazine operations are served from */
+        FMagazine* Loaded = nullptr;
+
+        /** Second magazine, kept so alternating allocations and frees do not trip the depot */
+        FMagazine* Previous = nullptr;
+
+        /** Blocks held by Loaded and Previous, readable by other threads */
+        std::atomic<uint32> CachedCount{0};
+
+        /** Blocks handed out from this slot; written only under the slot lock */
+        std::atomic<uint64> Allocations{0};
+
+        /** Blocks taken back into this slot; written only under the slot lock */
+        std::atomic<uint64> Frees{0};
+    };
+
+    /** Gets the calling thread's slot and locks it */
+    FSlot& LockSlot();
+
+    /** Locks a slot */
+    static FORCEINLINE void LockSlot(FSlot& Slot)
+    {
+        FAdaptiveSpinWait::Lock(Slot.LockState, Slot.LockBudget);
+    }
+
+    /** Unlocks a slot */
+    static FORCEINLINE void UnlockSlot(FSlot& Slot)
+    {
+        FAdaptiveSpinWait::Unlock(Slot.LockState);
+    }
+
+    /** Gets an empty magazine from the spare list or allocates one */
+    FMagazine* GetEmptyMagazine();
+
+    /** Returns every block in the slots and the depot to the pool; all slots must be locked */
+    void FlushAll();
+
+    /** Thread slots */
+    FSlot Slots[SlotCount];
+
+    /** Full magazines shared between slots */
+    TLockFreePointerListUnordered<FMagazine, PLATFORM_CACHE_LINE_SIZE> FullMagazines;
+
+    /** Empty magazines ready for reuse */
+    TLockFreePointerListUnordered<FMagazine, PLATFORM_CACHE_LINE_SIZE> EmptyMagazines;
+
+    /** Number of magazines in FullMagazines */
+    std::atomic<int32> FullMagazineCount;
+
+    /** Takes blocks from the pool */
+    FRefillFunction Refill;
+
+    /** Gives blocks back to the pool */
+    FFlushFunction Flush;
+};
@@ -5,6 +5,10 @@
 #include "CoreMinimal.h"
 #include "Interfaces/IPoolAllocator.h"
 #include "Interfaces/IMemoryManager.h"
+#include "SegmentedPoolStorage.h"
+#include "PoolMagazineCache.h"
+#include "BlockAllocationBitmap.h"
+#include "PoolHandleTable.h"
 
 /**
  * Specialized allocator for SVO octree nodes
@@ -36,9 +40,14 @@ public:
     virtual uint32 GetBlockSize() const override;
     virtual void* Allocate(const UObject* RequestingObject = nullptr, FName AllocationTag = NAME_None) override;
     virtual bool Free(void* Ptr) override;
+    virtual uint32 AllocateHandle(const UObject* RequestingObject = nullptr, FName AllocationTag = NAME_None) override;
+    virtual bool FreeHandle(uint32 Handle) override;
+    virtual void* ResolveHandle(uint32 Handle) const override;
     virtual bool Grow(uint32 AdditionalBlockCount, bool bForceGrowth = false) override;
     virtual uint32 Shrink(uint32 MaxBlocksToRemove = UINT32_MAX) override;
     virtual bool OwnsPointer(const void* Ptr) const override;
+    virtual bool GetReservedAddressRange(const void*& OutBase, uint64& OutSize) const override;
+    virtual void GetCommittedRanges(TArray<TPair<const void*, uint64>>& OutRanges) const override;
     virtual void SetAccessPattern(EMemoryAccessPattern AccessPattern) override;
     virtual EMemoryAccessPattern GetAccessPattern() const override;
     virtual FPoolStats GetStats() const override;
@@ -87,9 +96,47 @@ public:
      */
     bool ConfigureTypeLayout(uint32 TypeId, bool bUseZOrderCurve, bool bEnablePrefetching, EMemoryAccessPattern AccessPattern);
 
+    /**
+     * Enables or disables recording of allocation tags, requesting objects and times
+     * Tracking data lives in a side table that is only allocated while tracking is on, and only
+     * covers allocations made while it is on.
+     * @param bEnable Whether to record tracking data
+     */
+    void SetDebugTracking(bool bEnable);
+
+    /**
+     * Checks whether allocation tracking data is being recorded
+     * @return True if debug tracking is on
+     */
+    bool IsDebugTracking() const;
+
+    /**
+     * Requests transparent huge pages for the pool's committed segments, on by default
+     * Octree traversal touches nodes all over the pool, so large pools spend less time on TLB
+     * misses with huge pages. Pools smaller than a huge page are unaffected.
+     * @param bEnable Whether to use huge pages
+     * @return True if the platform accepted the request
+     */
+    bool SetHugePages(bool bEnable);
+
+    /**
+     * Sets whether Shrink releases free segments lazily
+     * Lazily released pages are reclaimed by the OS only under memory pressure, which makes
+     * reusing them cheaper but keeps them counted as resident until then. Only Linux honors this.
+     * @param bEnable Whether to release lazily
+     */
+    void SetLazySegmentRelease(bool bEnable);
+
+    /**
+     * Gets the bytes of the pool's storage backed by memory, excluding released segments
+     * @return Resident bytes
+     */
+    uint64 GetResidentBytes() const;
+
 private:
     /**
      * Allocates memory for the pool
+     * The block count is rounded up to whole storage segments
      * @param BlockCount Number of blocks to allocate
      * @return True if allocation was successful
      */
@@ -112,12 +159,70 @@ private:
      */
     int32 GetBlockIndex(const void* Ptr) const;
 
-    /** Structure containing metadata for a single block in the pool */
-    struct FBlockMetadata
+    /**
+     * Takes a batch of free blocks for the magazine cache and marks them allocated
+     * Grows the pool if no block is free and growth is allowed
+     * @param OutBlockIndices Receives the block indices
+     * @param MaxCount Maximum number of blocks to take
+     * @return Number of blocks taken
+     */
+    uint32 AllocateBatch(uint32* OutBlockIndices, uint32 MaxCount);
+
+    /**
+     * Returns a batch of blocks from the magazine cache to the free list
+     * Blocks that are already free are skipped with a warning
+     * @param BlockIndices Indices of the blocks being freed
+     * @param Count Number of blocks
+     */
+    void FreeBatch(const uint32* BlockIndices, uint32 Count);
+
+    /**
+     * Returns the pages of fully free segments past the first to the OS, wherever they lie
+     * Their blocks leave the free list until RecommitReleasedSegment brings the segment back.
+     * @param MaxBlocks Maximum number of blocks to release
+     * @return Number of blocks released
+     */
+    uint32 ReleaseFreeSegments(uint32 MaxBlocks);
+
+    /**
+     * Recommits one released segment and returns its blocks to the free list
+     * @return False if no segment is released
+     */
+    bool RecommitReleasedSegment();
+
+    /** Recommits every released segment, ahead of operations that move or rebuild free blocks */
+    void RecommitReleasedSegments();
+
+    /**
+     * Marks a block allocated and records tracking data if tracking is on
+     * @param BlockIndex Block being allocated
+     * @param RequestingObject Object that requested the allocation
+     * @param AllocationTag Tag for the allocation
+     * @param AllocationTime Time of the allocation
+     */
+    void MarkBlockAllocated(uint32 BlockIndex, const UObject* RequestingObject, FName AllocationTag, double AllocationTime);
+
+    /**
+     * Marks a block free and clears its tracking entry
+     * @param BlockIndex Block being freed
+     */
+    void MarkBlockFree(uint32 BlockIndex);
+
+    /**
+     * Resizes the allocation bitmap and the tracking table to the current block count
+     * @param NewBlockCount Number of blocks in the pool
+     */
+    void ResizeBlockMetadata(uint32 NewBlockCount);
+
+    /**
+     * Rebuilds metadata, handles and the free list after blocks were compacted to the front of the pool
+     * @param Order Old indices of the blocks now at 0..Order.Num()-1
+     */
+    void CompactBlockMetadata(const TArray<uint32>& Order);
+
+    /** Allocation tracking data for a block, kept only while debug tracking is on */
+    struct FBlockTrackingInfo
     {
-        /** Whether this block is currently allocated */
-        bool bAllocated;
-        
         /** Allocation tag for tracking */
         FName AllocationTag;
         
@@ -128,9 +233,8 @@ private:
         double AllocationTime;
         
         /** Constructor */
-        FBlockMetadata()
-            : bAllocated(false)
-            , AllocationTag(NAME_None)
+        FBlockTrackingInfo()
+            : AllocationTag(NAME_None)
             , RequestingObject(nullptr)
             , AllocationTime(0.0)
         {
@@ -143,8 +247,8 @@ private:
     /** Size of each block in bytes */
     uint32 BlockSize;
     
-    /** Base address of the pool memory */
-    uint8* PoolMemory;
+    /** Segmented block storage; blocks never move when the pool grows */
+    FSegmentedPoolStorage Storage;
     
     /** Maximum number of blocks this pool can hold (initial capacity) */
     uint32 MaxBlockCount;
@@ -155,18 +259,33 @@ private:
     /** Array of free block indices */
     TArray<uint32> FreeBlocks;
     
-    /** Array of metadata for each block */
-    TArray<FBlockMetadata> BlockMetadata;
+    /** Allocation state of each block, one bit per block */
+    FBlockAllocationBitmap AllocatedBits;
+    
+    /** Tracking data per block; empty unless debug tracking is on */
+    TArray<FBlockTrackingInfo> BlockTracking;
     
     /** Lock for thread safety */
     mutable FCriticalSection PoolLock;
     
+    /** Per-thread caches of free blocks serving untracked allocations without the pool lock */
+    FPoolMagazineCache MagazineCache;
+    
+    /** Indirection from handles to blocks allocated with AllocateHandle; written under PoolLock */
+    FPoolHandleTable Handles;
+    
     /** Whether this pool has been initialized */
     bool bIsInitialized;
     
     /** Whether this pool allows growth beyond initial capacity */
     bool bAllowsGrowth;
     
+    /** Whether allocation tags, requesting objects and times are recorded */
+    bool bDebugTracking;
+    
+    /** Whether Shrink releases free segments lazily */
+    bool bLazySegmentRelease;
+    
     /** Memory access pattern for this pool */
     EMemoryAccessPattern AccessPattern;
     
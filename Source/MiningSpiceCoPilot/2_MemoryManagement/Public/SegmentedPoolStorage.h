@@ -0,0 +1,402 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformMemory.h"
+#include <atomic>
+
+/**
+ * Block storage for fixed-size pool allocators, grown and shrunk in equally sized segments
+ *
+ * The storage reserves address space for the largest pool it can hold up front and commits it one
+ * segment at a time, so blocks are contiguous and a block index maps to an address with a multiply.
+ * Growing commits more segments and never moves existing blocks, which keeps every pointer handed
+ * out by the pool valid for the life of the pool. Shrinking decommits whole trailing segments,
+ * returning their memory to the OS.
+ *
+ * The reserved range starts on an AddressRangeAlignment boundary and spans a whole number of
+ * those units, so no two pools share one and the owning pool of an address can be found from its
+ * high bits (see FPoolAddressMap).
+ *
+ * Fully free segments anywhere in the range can also be released individually with
+ * ReleaseSegment, which returns their pages but keeps their blocks' indices and addresses until
+ * RecommitSegment brings them back.
+ *
+ * On Linux the range is a single anonymous mmap that is readable and writable throughout, so
+ * committing costs nothing until pages are first written and releasing is an madvise. The range
+ * can also be advised to use transparent huge pages (see SetHugePages). Other platforms use
+ * FPlatformVirtualMemoryBlock. Pages can be placed on a NUMA node with SetNumaNode.
+ *
+ * Each block also has a held mark, set while a caller owns the block. The marks are atomic and
+ * live in per-segment pages that are kept until Empty, so a pool can test and clear one on Free
+ * without its lock and turn a second free of the same block into a failed call.
+ *
+ * Adding and releasing segments must be serialized by the owner's pool lock. GetBlock,
+ * GetBlockIndex, Contains and the held marks only read the base address, the published block
+ * count and the mark pages, so they are safe to use without the lock while segments are being
+ * added.
+ */
+class MININGSPICECOPILOT_API FSegmentedPoolStorage
+{
+public:
+    /** Default segment size in bytes */
+    static constexpr uint64 DefaultSegmentSize = 2 * 1024 * 1024;
+
+    /** Default address space reserved per pool in bytes */
+    static constexpr uint64 DefaultReservedSize = 4ull * 1024 * 1024 * 1024;
+
+    /** Alignment and size granularity of the reserved range in bytes */
+    static constexpr uint64 AddressRangeAlignment = 64 * 1024 * 1024;
+
+    /** Size of a transparent huge page in bytes */
+    static constexpr uint64 HugePageSize = 2 * 1024 * 1024;
+
+    /** Constructor */
+    FSegmentedPoolStorage();
+
+    /** Destructor, releases all memory */
+    ~FSegmentedPoolStorage();
+
+    FSegmentedPoolStorage(const FSegmentedPoolStorage&) = delete;
+    FSegmentedPoolStorage& operator=(const FSegmentedPoolStorage&) = delete;
+
+    /**
+     * Sets the block layout and reserves address space; releases any existing memory
+     * @param InBlockSize Size of each block in bytes
+     * @param InitialBlockCount Expected initial capacity, used to keep small pools from committing a full segment
+     * @param TargetSegmentSize Preferred segment size in bytes
+     * @param ReservedSize Address space to reserve, which bounds how far the pool can grow
+     * @return True if the address space was reserved
+     */
+    bool Configure(uint32 InBlockSize, uint32 InitialBlockCount, uint64 TargetSegmentSize = DefaultSegmentSize, uint64 ReservedSize = DefaultReservedSize);
+
+    /**
+     * Commits enough segments to hold at least BlockCount more blocks
+     * New blocks are zero filled and follow the existing block indices
+     * @param BlockCount Minimum number of blocks to add
+     * @return Number of blocks added, a multiple of the blocks per segment, or 0 on failure
+     */
+    uint32 AddBlocks(uint32 BlockCount);
+
+    /**
+     * Decommits the last segments, returning their memory to the OS
+     * The caller must ensure no block in them is in use
+     * @param SegmentCount Number of trailing segments to release
+     * @return Number of blocks released
+     */
+    uint32 ReleaseTrailingSegments(uint32 SegmentCount);
+
+    /**
+     * Returns the whole pages of a segment to the OS while keeping its blocks' addresses
+     * The caller must ensure no block in the segment is in use, and must not touch its blocks
+     * until RecommitSegment. Pages shared with a neighbouring segment stay committed.
+     * @param SegmentIndex Segment to release
+     * @param bLazy On Linux, use MADV_FREE so the kernel reclaims the pages only under memory
+     *              pressure; resident memory then drops later rather than immediately
+     * @return Bytes released, or 0 if the segment spans no whole page or is already released
+     */
+    uint64 ReleaseSegment(int32 SegmentIndex, bool bLazy = false);
+
+    /**
+     * Commits a segment released by ReleaseSegment, reapplying the resident prefix to its blocks
+     * Block contents are unspecified afterwards.
+     * @param SegmentIndex Segment to recommit
+     */
+    void RecommitSegment(int32 SegmentIndex);
+
+    /**
+     * Requests transparent huge pages for the committed range, and for segments added later
+     * Only whole huge pages inside the committed range are advised, so a pool smaller than a huge
+     * page never has its footprint rounded up. Block tails decommitted afterwards split the huge
+     * pages they fall in, so this suits pools whose blocks stay fully resident. The setting
+     * persists across Configure.
+     * @param bEnable Whether to use huge pages
+     * @return True if the platform accepted the request; false where huge pages are unsupported
+     */
+    bool SetHugePages(bool bEnable);
+
+    /**
+     * Places the storage's pages on a NUMA node
+     * The reserved range is bound to the node where the platform supports it, which also migrates
+     * resident pages. Otherwise each segment is faulted in from a thread pinned to the node as it
+     * is committed, which makes its pages resident up front and leaves earlier pages where they
+     * are. The setting persists across Configure.
+     * @param NodeId Node to place pages on, or INDEX_NONE for the default policy
+     * @return True if pages will be placed on the node; false on single-node machines, for an
+     *         invalid node or where placement is unsupported
+     */
+    bool SetNumaNode(int32 NodeId);
+
+    /** Releases all memory, including the reserved address space */
+    void Empty();
+
+    /**
+     * Sets how many leading bytes of each block hold data
+     * Blocks added later have the whole pages past this prefix decommitted, and PermuteBlocks only
+     * copies the prefix. Existing blocks are left as they are; see CommitBlocks and DecommitBlockTails.
+     * @param Bytes Bytes of each block in use, at most the block size
+     */
+    void SetResidentBlockBytes(uint32 Bytes);
+
+    /**
+     * Commits every page of a range of blocks, undoing DecommitBlockTails
+     * @param FirstBlock First block of the range
+     * @param EndBlock One past the last block of the range
+     */
+    void CommitBlocks(uint32 FirstBlock, uint32 EndBlock);
+
+    /**
+     * Decommits the whole pages of each block in a range that lie past its first KeepBytes bytes
+     * Blocks smaller than two pages rarely contain a whole page past the prefix, so this mostly
+     * pays off for large blocks.
+     * @param FirstBlock First block of the range
+     * @param EndBlock One past the last block of the range
+     * @param KeepBytes Leading bytes of each block to keep committed
+     * @return Bytes decommitted
+     */
+    uint64 DecommitBlockTails(uint32 FirstBlock, uint32 EndBlock, uint32 KeepBytes);
+
+    /**
+     * Reorders blocks in place so that block i receives the old contents of block Order[i]
+     * Blocks at or past Order.Num() receive unspecified contents and lose their held marks; held
+     * marks of ordered blocks move with them. Uses one block of scratch space.
+     * @param Order Distinct source block indices for destinations 0..Order.Num()-1
+     * @return Number of blocks copied
+     */
+    uint32 PermuteBlocks(const TArray<uint32>& Order);
+
+    /**
+     * Gets the address of a block
+     * @param BlockIndex Index of the block, must be less than GetBlockCount()
+     * @return Block address
+     */
+    FORCEINLINE uint8* GetBlock(uint32 BlockIndex) const
+    {
+        checkSlow(BlockIndex < GetBlockCount());
+        return Base + static_cast<SIZE_T>(BlockIndex) * BlockSize;
+    }
+
+    /**
+     * Gets the index of the block starting at an address
+     * @param Ptr Address to look up
+     * @return Block index, or INDEX_NONE if the address is not the start of a committed block
+     */
+    FORCEINLINE int32 GetBlockIndex(const void* Ptr) const
+    {
+        const UPTRINT Offset = reinterpret_cast<UPTRINT>(Ptr) - reinterpret_cast<UPTRINT>(Base);
+        if (!Base || Offset >= static_cast<UPTRINT>(GetBlockCount()) * BlockSize || (Offset % BlockSize) != 0)
+        {
+            return INDEX_NONE;
+        }
+        return static_cast<int32>(Offset / BlockSize);
+    }
+
+    /**
+     * Checks whether an address lies inside a committed block
+     * @param Ptr Address to check
+     * @return True if the address is inside this storage
+     */
+    FORCEINLINE bool Contains(const void* Ptr) const
+    {
+        const UPTRINT Offset = reinterpret_cast<UPTRINT>(Ptr) - reinterpret_cast<UPTRINT>(Base);
+        return Base && Offset < static_cast<UPTRINT>(GetBlockCount()) * BlockSize;
+    }
+
+    /**
+     * Marks a block as owned by a caller
+     * @param BlockIndex Index of the block, must be less than GetBlockCount()
+     */
+    FORCEINLINE void MarkBlockHeld(uint32 BlockIndex)
+    {
+        uint64 Mask;
+        GetHeldWord(BlockIndex, Mask).fetch_or(Mask, std::memory_order_relaxed);
+    }
+
+    /**
+     * Clears a block's held mark as its caller gives it back
+     * Of several concurrent calls for the same block, only one succeeds.
+     * @param BlockIndex Index of the block, must be less than GetBlockCount()
+     * @return False if the block was not held, so it is free, cached or was already given back
+     */
+    FORCEINLINE bool TryReleaseHeldBlock(uint32 BlockIndex)
+    {
+        uint64 Mask;
+        return (GetHeldWord(BlockIndex, Mask).fetch_and(~Mask, std::memory_order_relaxed) & Mask) != 0;
+    }
+
+    /**
+     * Checks whether a block is owned by a caller
+     * @param BlockIndex Index of the block, must be less than GetBlockCount()
+     */
+    FORCEINLINE bool IsBlockHeld(uint32 BlockIndex) const
+    {
+        uint64 Mask;
+        return (GetHeldWord(BlockIndex, Mask).load(std::memory_order_relaxed) & Mask) != 0;
+    }
+
+    /** Clears every held mark, for when the owner takes back all blocks at once */
+    void ClearHeldBlocks();
+
+    /** Gets the number of committed blocks */
+    FORCEINLINE uint32 GetBlockCount() const { return BlockCount.load(std::memory_order_acquire); }
+
+    /** Gets the number of blocks added or released with each segment */
+    FORCEINLINE uint32 GetBlocksPerSegment() const { return BlocksPerSegment; }
+
+    /** Gets the number of committed segments */
+    FORCEINLINE int32 GetSegmentCount() const { return BlocksPerSegment ? static_cast<int32>(GetBlockCount() / BlocksPerSegment) : 0; }
+
+    /** Gets the size of each segment in bytes */
+    FORCEINLINE uint64 GetSegmentSize() const { return static_cast<uint64>(BlocksPerSegment) * BlockSize; }
+
+    /** Gets the bytes currently committed */
+    FORCEINLINE uint64 GetCommittedBytes() const { return CommittedBytes; }
+
+    /**
+     * Appends the address ranges of the committed segments, skipping released ones
+     * Adjacent segments are merged into one range. Must be called with the owner's pool lock held.
+     * @param OutRanges Receives the start and size in bytes of each range
+     */
+    void GetCommittedRanges(TArray<TPair<const void*, uint64>>& OutRanges) const;
+
+    /** Checks whether a segment has been released by ReleaseSegment */
+    FORCEINLINE bool IsSegmentReleased(int32 SegmentIndex) const { return ReleasedSegments.IsValidIndex(SegmentIndex) && ReleasedSegments[SegmentIndex]; }
+
+    /** Gets the first released segment, or INDEX_NONE if every segment is committed */
+    FORCEINLINE int32 FindReleasedSegment() const { return ReleasedSegmentCount > 0 ? ReleasedSegments.Find(true) : INDEX_NONE; }
+
+    /** Gets the number of segments released by ReleaseSegment */
+    FORCEINLINE int32 GetReleasedSegmentCount() const { return ReleasedSegmentCount; }
+
+    /** Checks whether huge pages were requested */
+    FORCEINLINE bool IsUsingHugePages() const { return bHugePages; }
+
+    /** Gets the NUMA node pages are placed on, or INDEX_NONE */
+    FORCEINLINE int32 GetNumaNode() const { return NumaNode; }
+
+    /** Gets the bytes of each block in use */
+    FORCEINLINE uint32 GetResidentBlockBytes() const { return ResidentBlockBytes; }
+
+    /**
+     * Gets the bytes committed once block tails past the resident prefix and released segments
+     * are taken out
+     * Assumes every block's tail has been released as set by SetResidentBlockBytes.
+     */
+    uint64 GetResidentBytes() const;
+
+    /** Gets the reserved address space in bytes */
+    FORCEINLINE uint64 GetReservedBytes() const { return ReservedBytes; }
+
+    /** Gets the start of the reserved range, null until configured */
+    FORCEINLINE const uint8* GetReservedBase() const { return Base; }
+
+    /**
+     * Gets a counter that advances after any storage reserves or releases its address range
+     * Address maps compare it against the value they were built at to tell whether a pool's range
+     * may have moved.
+     */
+    static FORCEINLINE uint32 GetAddressRangeEpoch() { return AddressRangeEpoch.load(std::memory_order_acquire); }
+
+private:
+    /**
+     * Gets the whole pages of a block past its first KeepBytes bytes
+     * @return False if there are none
+     */
+    bool GetBlockTailPages(uint32 BlockIndex, uint32 KeepBytes, uint64& OutOffset, uint64& OutSize) const;
+
+    /**
+     * Gets the whole pages inside a segment
+     * @return False if there are none
+     */
+    bool GetSegmentPages(int32 SegmentIndex, uint64& OutOffset, uint64& OutSize) const;
+
+    /** Gets the held mark word for a block and the block's bit in it */
+    FORCEINLINE std::atomic<uint64>& GetHeldWord(uint32 BlockIndex, uint64& OutMask) const
+    {
+        checkSlow(BlockIndex < GetBlockCount());
+        const uint32 SegmentBlock = BlockIndex % BlocksPerSegment;
+        OutMask = 1ull << (SegmentBlock & 63);
+        return HeldPages[BlockIndex / BlocksPerSegment][SegmentBlock >> 6];
+    }
+
+    /** Gets the number of held mark words per segment */
+    FORCEINLINE uint32 GetHeldWordsPerSegment() const { return FMath::DivideAndRoundUp(BlocksPerSegment, 64u); }
+
+    /** Reserves ReservedBytes of address space aligned to AddressRangeAlignment and sets Base */
+    bool ReserveAddressSpace();
+
+    /** Releases the reserved address space */
+    void FreeAddressSpace();
+
+    /** Commits a page-aligned range given as an offset from Base */
+    void CommitRange(uint64 Offset, uint64 Size);
+
+    /**
+     * Returns a page-aligned range given as an offset from Base to the OS
+     * @param bLazy Let the OS reclaim the pages when it needs them, where supported
+     */
+    void DecommitRange(uint64 Offset, uint64 Size, bool bLazy = false);
+
+    /** Advises the whole huge pages committed since the last call */
+    bool AdviseHugePages();
+
+    /** Faults in a freshly committed range on the NUMA node when the range could not be bound */
+    void PlaceRange(uint64 Offset, uint64 Size);
+
+    /** Advanced after every reservation and release of an address range */
+    static std::atomic<uint32> AddressRangeEpoch;
+
+    /** Start of the reserved range, null until configured */
+    uint8* Base;
+
+#if !PLATFORM_LINUX
+    /** Reserved address range */
+    FPlatformMemory::FPlatformVirtualMemoryBlock VirtualBlock;
+
+    /** Offset of Base into the virtual block, which is over-reserved to align Base */
+    uint64 BaseOffset;
+#endif
+
+    /** Size of each block in bytes */
+    uint32 BlockSize;
+
+    /** Leading bytes of each block in use; pages past them may be decommitted */
+    uint32 ResidentBlockBytes;
+
+    /** Blocks added or released with each segment */
+    uint32 BlocksPerSegment;
+
+    /** Bytes of address space reserved */
+    uint64 ReservedBytes;
+
+    /** Bytes committed from the start of the range */
+    uint64 CommittedBytes;
+
+    /** Number of committed blocks, published after their memory is committed */
+    std::atomic<uint32> BlockCount;
+
+    /**
+     * Held mark pages, one per segment the reserved range can hold, allocated when the segment is
+     * first added and kept until Empty; sized once in Configure so lock-free readers never see it move
+     */
+    TArray<std::atomic<uint64>*> HeldPages;
+
+    /** Per segment, whether ReleaseSegment returned its pages */
+    TBitArray<> ReleasedSegments;
+
+    /** Number of set bits in ReleasedSegments */
+    int32 ReleasedSegmentCount;
+
+    /** Bytes from the start of the range already advised to use huge pages */
+    uint64 HugePageBytes;
+
+    /** Whether huge pages were requested */
+    bool bHugePages;
+
+    /** NUMA node to place pages on, or INDEX_NONE */
+    int32 NumaNode;
+
+    /** Whether the reserved range is bound to NumaNode, so pages need no placing by first touch */
+    bool bNumaBound;
+};
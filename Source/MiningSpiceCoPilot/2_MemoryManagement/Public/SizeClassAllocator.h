@@ -0,0 +1,186 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/UniquePtr.h"
+#include "SegmentedPoolStorage.h"
+#include "PoolMagazineCache.h"
+
+/**
+ * Size-class slab allocator for small general-purpose allocations
+ *
+ * Requests from MinAllocationSize to MaxAllocationSize bytes are rounded up to one of
+ * SizeClassCount size classes: 16-byte steps up to 128 bytes, then four classes for each doubling,
+ * so above 128 bytes no more than a fifth of a block is padding. Each class is a fixed-size block
+ * pool in its own FSegmentedPoolStorage, grown one slab of SlabSize bytes at a time, with an
+ * FPoolMagazineCache in front of it, so allocations and frees are served from the calling thread's
+ * magazines and only take the class lock to refill or flush a batch. Larger requests, and
+ * alignments no size class provides, are left to the caller.
+ *
+ * Allocations are not tracked individually. The magazines already count every allocation and free
+ * they serve, and the allocator sums those counts for its usage figures. Each block's held mark in
+ * its storage is set while a caller owns it, so a second free of a block is caught and dropped.
+ *
+ * Initialize and Shutdown must not race with other calls. Shutdown returns every slab's memory, so
+ * any block still allocated becomes invalid, but each class keeps its reserved range until the
+ * allocator is destroyed. A block freed after Shutdown is therefore still recognized and dropped
+ * rather than passed on to another allocator, and a later Initialize reuses the ranges.
+ */
+class MININGSPICECOPILOT_API FSizeClassAllocator
+{
+public:
+    /** Smallest size class in bytes, which is also the alignment every class provides */
+    static constexpr uint32 MinAllocationSize = 16;
+
+    /** Largest size class in bytes */
+    static constexpr uint32 MaxAllocationSize = 64 * 1024;
+
+    /** Number of size classes */
+    static constexpr int32 SizeClassCount = 44;
+
+    /** Bytes committed each time a class grows */
+    static constexpr uint64 SlabSize = 256 * 1024;
+
+    /** Address space reserved for each class, which bounds how far it can grow */
+    static constexpr uint64 ClassReservedSize = 256 * 1024 * 1024;
+
+    /** Usage of one size class */
+    struct FSizeClassStats
+    {
+        /** Bytes per block in the class */
+        uint32 BlockSize = 0;
+
+        /** Blocks currently allocated, approximate while other threads are allocating */
+        uint64 AllocatedBlocks = 0;
+
+        /** Blocks in committed slabs */
+        uint64 CommittedBlocks = 0;
+
+        /** Allocations served since the class was initialized */
+        uint64 TotalAllocations = 0;
+    };
+
+    /** Constructor */
+    FSizeClassAllocator();
+
+    /** Destructor, frees every slab */
+    ~FSizeClassAllocator();
+
+    FSizeClassAllocator(const FSizeClassAllocator&) = delete;
+    FSizeClassAllocator& operator=(const FSizeClassAllocator&) = delete;
+
+    /**
+     * Reserves address space for every size class
+     * @return True if every class could reserve its range
+     */
+    bool Initialize();
+
+    /** Returns every slab's memory while keeping the reserved ranges; blocks still allocated become invalid */
+    void Shutdown();
+
+    /** Checks whether the allocator is initialized */
+    FORCEINLINE bool IsInitialized() const { return bIsInitialized; }
+
+    /**
+     * Allocates a block from the size class that fits a request
+     * @param SizeInBytes Requested size
+     * @param Alignment Requested alignment, a power of two
+     * @return Block address, or null if the allocator does not serve the request or the class is full
+     */
+    void* Allocate(uint64 SizeInBytes, uint32 Alignment);
+
+    /**
+     * Frees a block if it belongs to this allocator
+     * Frees of blocks that are not allocated, including every free after Shutdown, are dropped.
+     * @param Ptr Block address
+     * @return True if the address lies in one of the allocator's ranges; false if it is not ours
+     */
+    bool Free(void* Ptr);
+
+    /**
+     * Gets the usable size of a block
+     * @param Ptr Block address
+     * @return Size of the block's class, or 0 if the allocator does not own the block
+     */
+    uint32 GetAllocationSize(const void* Ptr) const;
+
+    /**
+     * Gets the size class that serves a request
+     * @param SizeInBytes Requested size
+     * @param Alignment Requested alignment, a power of two
+     * @return Class index, or INDEX_NONE if no class serves the request
+     */
+    static int32 GetSizeClass(uint64 SizeInBytes, uint32 Alignment = MinAllocationSize);
+
+    /**
+     * Gets the block size of a size class
+     * @param ClassIndex Class index, less than SizeClassCount
+     */
+    static uint32 GetSizeClassSize(int32 ClassIndex);
+
+    /** Gets the bytes in blocks currently allocated, counted at their class size */
+    uint64 GetAllocatedBytes() const;
+
+    /** Gets the bytes committed to slabs */
+    uint64 GetCommittedBytes() const;
+
+    /**
+     * Gets the usage of every size class
+     * @param OutStats Receives one entry per class, in class order
+     */
+    void GetSizeClassStats(TArray<FSizeClassStats>& OutStats) const;
+
+private:
+    /** One size class: slabs of equally sized blocks, a free list and the per-thread magazines */
+    struct FSizeClass
+    {
+        explicit FSizeClass(uint32 InBlockSize);
+
+        /** Takes up to MaxCount free blocks, growing by a slab if none are left; takes Lock */
+        uint32 Refill(uint32* OutBlockIndices, uint32 MaxCount);
+
+        /** Returns blocks to the free list; takes Lock */
+        void Flush(const uint32* BlockIndices, uint32 Count);
+
+        /** Drops every block and returns the slabs' memory, keeping the reserved range */
+        void Release();
+
+        /** Bytes per block */
+        uint32 BlockSize;
+
+        /** Slab storage */
+        FSegmentedPoolStorage Storage;
+
+        /** Indices of blocks not held by the magazines or the caller */
+        TArray<uint32> FreeBlocks;
+
+        /** Per-thread magazines in front of the free list */
+        FPoolMagazineCache MagazineCache;
+
+        /** Lock for Storage growth and FreeBlocks */
+        FCriticalSection Lock;
+
+        /** Magazine allocation count when the class was last released, left out of the stats */
+        uint64 BaseAllocations = 0;
+
+        /** Magazine free count when the class was last released, left out of the stats */
+        uint64 BaseFrees = 0;
+    };
+
+    /**
+     * Finds the size class whose reserved range contains an address, also after Shutdown
+     * @return Class, or null if no class owns the address
+     */
+    FSizeClass* FindSizeClass(const void* Ptr) const;
+
+    /** Size classes by class index */
+    TUniquePtr<FSizeClass> SizeClasses[SizeClassCount];
+
+    /** Classes ordered by the base of their reserved range, for pointer lookups; null until first initialized */
+    FSizeClass* ClassesByAddress[SizeClassCount];
+
+    /** Flag indicating if the allocator has been initialized */
+    bool bIsInitialized;
+};
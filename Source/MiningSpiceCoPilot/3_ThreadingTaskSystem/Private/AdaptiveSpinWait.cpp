@@ -0,0 +1,214 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AdaptiveSpinWait.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+namespace AdaptiveSpinWaitInternal
+{
+    /** Thread parked in WaitOnAddress; lives on the waiting thread's stack */
+    struct FWaiter
+    {
+        const void* Address;
+        FEvent* Event;
+    };
+
+    /** Wait queue shared by every address that hashes to it, in arrival order */
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) FWaitBucket
+    {
+        FCriticalSection Mutex;
+        TArray<FWaiter*, TInlineAllocator<8>> Waiters;
+    };
+
+    /** Number of wait queues (power of two) */
+    static constexpr int32 BucketBits = 8;
+
+    FWaitBucket& GetBucket(const void* Address)
+    {
+        static FWaitBucket Buckets[1 << BucketBits];
+
+        // Fibonacci hashing spreads neighbouring lock words across queues
+        uint64 Hash = static_cast<uint64>(reinterpret_cast<UPTRINT>(Address)) * 0x9E3779B97F4A7C15ull;
+        return Buckets[Hash >> (64 - BucketBits)];
+    }
+
+    /** Auto-reset event a thread parks on, returned to the pool when the thread exits */
+    struct FThreadEvent
+    {
+        FEvent* Event = nullptr;
+
+        ~FThreadEvent()
+        {
+            if (Event)
+            {
+                FPlatformProcess::ReturnSynchEventToPool(Event);
+                Event = nullptr;
+            }
+        }
+    };
+
+    FEvent* GetThreadEvent()
+    {
+        static thread_local FThreadEvent Handle;
+        if (!Handle.Event)
+        {
+            Handle.Event = FPlatformProcess::GetSynchEventFromPool(false);
+        }
+        return Handle.Event;
+    }
+
+    /** Folds one observed spin count into the lock's running average (weight 1/8) */
+    void UpdateBudget(FAdaptiveSpinWait::FSpinBudget& Budget, uint32 ObservedSpins)
+    {
+        int32 Average = static_cast<int32>(Budget.AverageSpins.load(std::memory_order_relaxed));
+        int32 Updated = Average + (static_cast<int32>(ObservedSpins) - Average) / 8;
+        Budget.AverageSpins.store(
+            static_cast<uint32>(FMath::Clamp<int32>(Updated, 0, FAdaptiveSpinWait::MaxSpinBudget)),
+            std::memory_order_relaxed);
+    }
+}
+
+bool FAdaptiveSpinWait::LockSlow(std::atomic<int32>& State, FSpinBudget& Budget, uint32 TimeoutMs)
+{
+    using namespace AdaptiveSpinWaitInternal;
+
+    // Spin with exponential backoff; the spins a waiter needed before the owner released is the
+    // remaining hold time it observed, which is what the budget learns
+    const uint32 SpinLimit = GetSpinLimit(Budget);
+    uint32 Spins = 0;
+    uint32 Backoff = 1;
+
+    while (Spins < SpinLimit)
+    {
+        for (uint32 Pause = 0; Pause < Backoff; ++Pause)
+        {
+            FPlatformProcess::Yield();
+        }
+        Spins += Backoff;
+        Backoff = FMath::Min(Backoff * 2, MaxBackoff);
+
+        if (TryLock(State))
+        {
+            UpdateBudget(Budget, Spins);
+            return true;
+        }
+    }
+
+    // Spinning did not pay off; decay the budget so long holds park sooner next time
+    UpdateBudget(Budget, 0);
+
+    const double EndTime = (TimeoutMs > 0) ? (FPlatformTime::Seconds() + TimeoutMs / 1000.0) : 0.0;
+
+    // Marking the word before sleeping tells the owner to wake us; a thread that acquires
+    // through the exchange keeps the mark because other waiters may still be parked
+    while (State.exchange(LockedWithWaiters, std::memory_order_acquire) != Unlocked)
+    {
+        uint32 WaitMs = 0;
+        if (TimeoutMs > 0)
+        {
+            double RemainingSeconds = EndTime - FPlatformTime::Seconds();
+            if (RemainingSeconds <= 0.0)
+            {
+                return false;
+            }
+            WaitMs = FMath::Max<uint32>(1, static_cast<uint32>(FMath::CeilToInt(RemainingSeconds * 1000.0)));
+        }
+
+        WaitOnAddress(State, LockedWithWaiters, WaitMs);
+    }
+
+    return true;
+}
+
+bool FAdaptiveSpinWait::WaitOnAddress(const std::atomic<int32>& Address, int32 Expected, uint32 TimeoutMs)
+{
+    using namespace AdaptiveSpinWaitInternal;
+
+    FWaitBucket& Bucket = GetBucket(&Address);
+    FWaiter Self = { &Address, GetThreadEvent() };
+
+    // The value is checked under the queue lock, and wakers take the same lock after changing it,
+    // so either the change is seen here or this thread is queued before the wake looks for it
+    {
+        FScopeLock Lock(&Bucket.Mutex);
+        if (Address.load(std::memory_order_relaxed) != Expected)
+        {
+            return true;
+        }
+        Bucket.Waiters.Add(&Self);
+    }
+
+    if (Self.Event->Wait(TimeoutMs > 0 ? TimeoutMs : MAX_uint32))
+    {
+        return true;
+    }
+
+    bool bStillQueued;
+    {
+        FScopeLock Lock(&Bucket.Mutex);
+        bStillQueued = Bucket.Waiters.RemoveSingle(&Self) > 0;
+    }
+
+    // A waker dequeued us after the timeout expired; consume its trigger so the event is clean
+    if (!bStillQueued)
+    {
+        Self.Event->Wait();
+    }
+
+    return false;
+}
+
+bool FAdaptiveSpinWait::WakeOne(const void* Address)
+{
+    using namespace AdaptiveSpinWaitInternal;
+
+    FWaitBucket& Bucket = GetBucket(Address);
+    FEvent* Event = nullptr;
+    {
+        FScopeLock Lock(&Bucket.Mutex);
+        for (int32 Index = 0; Index < Bucket.Waiters.Num(); ++Index)
+        {
+            if (Bucket.Waiters[Index]->Address == Address)
+            {
+                Event = Bucket.Waiters[Index]->Event;
+                Bucket.Waiters.RemoveAt(Index);
+                break;
+            }
+        }
+    }
+
+    // The waiter stays blocked until this trigger, so its event is still valid here
+    if (Event)
+    {
+        Event->Trigger();
+        return true;
+    }
+    return false;
+}
+
+int32 FAdaptiveSpinWait::WakeAll(const void* Address)
+{
+    using namespace AdaptiveSpinWaitInternal;
+
+    FWaitBucket& Bucket = GetBucket(Address);
+    TArray<FEvent*, TInlineAllocator<8>> Events;
+    {
+        FScopeLock Lock(&Bucket.Mutex);
+        for (int32 Index = Bucket.Waiters.Num() - 1; Index >= 0; --Index)
+        {
+            if (Bucket.Waiters[Index]->Address == Address)
+            {
+                Events.Add(Bucket.Waiters[Index]->Event);
+                Bucket.Waiters.RemoveAt(Index);
+            }
+        }
+    }
+
+    for (FEvent* Event : Events)
+    {
+        Event->Trigger();
+    }
+    return Events.Num();
+}
@@ -0,0 +1,163 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AsyncTaskManager.h"
+#include "HAL/PlatformProcess.h"
+#include <atomic>
+
+/** Operation that sleeps briefly and succeeds, or fails when started with Fail=1 */
+class FContinuationTestOperation : public FAsyncOperationImpl
+{
+public:
+    FContinuationTestOperation(uint64 InId, const FString& InName)
+        : FAsyncOperationImpl(InId, TEXT("ContinuationTest"), InName)
+    {
+    }
+
+    virtual bool Execute() override
+    {
+        FPlatformProcess::Sleep(0.01f);
+        if (GetParameters().FindRef(TEXT("Fail")) == TEXT("1"))
+        {
+            SetResult(FAsyncResult(TEXT("Requested failure")));
+            return false;
+        }
+        return true;
+    }
+
+    virtual bool Cancel() override
+    {
+        return true;
+    }
+};
+
+/**
+ * Test program for async operation continuations
+ * Checks that Then chains pass results along by move, that failure and cancellation propagate down
+ * a chain without running the skipped bodies, and that WhenAll and WhenAny resolve correctly
+ */
+void TestAsyncContinuations()
+{
+    FAsyncTaskManager& Manager = static_cast<FAsyncTaskManager&>(FAsyncTaskManager::Get());
+    Manager.RegisterOperationType(TEXT("ContinuationTest"), [](uint64 Id, const FString& Name) -> FAsyncOperationImpl*
+    {
+        return new FContinuationTestOperation(Id, Name);
+    });
+
+    TMap<FString, FString> FailParameters;
+    FailParameters.Add(TEXT("Fail"), TEXT("1"));
+
+    // Results flow through a chain and a single consumer takes them by move
+    {
+        uint64 First = Manager.CreateOperation(TEXT("ContinuationTest"));
+        uint64 Second = Manager.Then(First, [](FAsyncResult&& Input)
+        {
+            FAsyncResult Output = MoveTemp(Input);
+            Output.ResultData = MakeShared<int32>(21);
+            return Output;
+        });
+        uint64 Third = Manager.Then(Second, [](FAsyncResult&& Input)
+        {
+            FAsyncResult Output = MoveTemp(Input);
+            Output.ResultData = MakeShared<int32>(*StaticCastSharedPtr<int32>(Output.ResultData) * 2);
+            return Output;
+        });
+
+        Manager.StartOperation(First);
+        bool bCompleted = Manager.WaitForCompletion(Third, 5000);
+        FAsyncResult Result = Manager.GetOperationResult(Third);
+
+        verifyf(bCompleted && Result.bSuccess, TEXT("three-step chain completes"));
+        verifyf(Result.ResultData.IsValid() && *StaticCastSharedPtr<int32>(Result.ResultData) == 42, TEXT("result data is passed down the chain"));
+        verifyf(!Manager.GetOperationResult(Second).ResultData.IsValid() && Manager.GetOperationResult(Second).bSuccess,
+            TEXT("a single continuation takes the result, leaving the flags"));
+    }
+
+    // A failure skips the chained bodies unless they opt in
+    {
+        std::atomic<int32> BodiesRun(0);
+        FString ReceivedError;
+        uint64 Failing = Manager.CreateOperation(TEXT("ContinuationTest"));
+        uint64 Skipped = Manager.Then(Failing, [&BodiesRun](FAsyncResult&& Input)
+        {
+            BodiesRun.fetch_add(1);
+            return MoveTemp(Input);
+        });
+        uint64 Recovered = Manager.Then(Skipped, [&BodiesRun, &ReceivedError](FAsyncResult&& Input)
+        {
+            BodiesRun.fetch_add(10);
+            ReceivedError = Input.ErrorMessage;
+            return FAsyncResult();
+        }, true);
+
+        Manager.StartOperation(Failing, FailParameters);
+        verifyf(Manager.WaitForCompletion(Recovered, 5000), TEXT("a continuation that runs on failure can recover"));
+        verifyf(Manager.GetOperationStatus(Skipped) == EAsyncStatus::Failed, TEXT("failure propagates to the next continuation"));
+        verifyf(ReceivedError == TEXT("Requested failure"), TEXT("propagated failure keeps the error"));
+        verifyf(BodiesRun.load() == 10, TEXT("only the opted-in body ran"));
+    }
+
+    // Cancelling an operation that never started cancels everything after it
+    {
+        std::atomic<int32> BodiesRun(0);
+        uint64 Root = Manager.CreateOperation(TEXT("ContinuationTest"));
+        uint64 Middle = Manager.Then(Root, [&BodiesRun](FAsyncResult&& Input)
+        {
+            BodiesRun.fetch_add(1);
+            return MoveTemp(Input);
+        });
+        uint64 Last = Manager.Then(Middle, [&BodiesRun](FAsyncResult&& Input)
+        {
+            BodiesRun.fetch_add(1);
+            return MoveTemp(Input);
+        }, true);
+
+        Manager.CancelOperation(Root);
+        verifyf(Manager.GetOperationStatus(Middle) == EAsyncStatus::Cancelled && Manager.GetOperationStatus(Last) == EAsyncStatus::Cancelled,
+            TEXT("cancellation propagates down the chain"));
+        verifyf(Manager.GetOperationResult(Last).bCancelled, TEXT("propagated result is marked cancelled"));
+        verifyf(BodiesRun.load() == 0, TEXT("no body runs after a cancellation, even when opted in to failures"));
+    }
+
+    // WhenAll collects results in order; WhenAny takes the first to end
+    {
+        TArray<uint64> Group;
+        for (int32 Index = 0; Index < 4; ++Index)
+        {
+            Group.Add(Manager.Then(Manager.CreateOperation(TEXT("ContinuationTest")), [Index](FAsyncResult&& Input)
+            {
+                FAsyncResult Output = MoveTemp(Input);
+                Output.ErrorCode = Index;
+                return Output;
+            }));
+        }
+        uint64 All = Manager.WhenAll(Group);
+        uint64 Any = Manager.WhenAny(Group);
+
+        for (uint64 OperationId : Manager.GetOperationsOfType(TEXT("ContinuationTest")))
+        {
+            Manager.StartOperation(OperationId);
+        }
+
+        verifyf(Manager.WaitForCompletion(All, 5000), TEXT("WhenAll completes when every operation completes"));
+        TSharedPtr<TArray<FAsyncResult>> Results = StaticCastSharedPtr<TArray<FAsyncResult>>(Manager.GetOperationResult(All).ResultData);
+        bool bInOrder = Results.IsValid() && Results->Num() == 4;
+        for (int32 Index = 0; bInOrder && Index < 4; ++Index)
+        {
+            bInOrder = (*Results)[Index].ErrorCode == Index;
+        }
+        verifyf(bInOrder, TEXT("WhenAll results are in the given order"));
+        verifyf(Manager.GetOperationStatus(Any) == EAsyncStatus::Completed, TEXT("WhenAny completes with the first operation"));
+
+        uint64 Failing = Manager.CreateOperation(TEXT("ContinuationTest"));
+        uint64 Pending = Manager.CreateOperation(TEXT("ContinuationTest"));
+        uint64 Mixed = Manager.WhenAll({ Failing, Pending });
+        Manager.StartOperation(Failing, FailParameters);
+        Manager.WaitForCompletion(Mixed, 5000);
+        verifyf(Manager.GetOperationStatus(Mixed) == EAsyncStatus::Failed, TEXT("WhenAll fails with its first failing operation"));
+        Manager.CancelOperation(Pending);
+    }
+
+    Manager.CleanupCompletedOperations(1.0e-6);
+
+    UE_LOG(LogTemp, Display, TEXT("Async continuation test completed"));
+}
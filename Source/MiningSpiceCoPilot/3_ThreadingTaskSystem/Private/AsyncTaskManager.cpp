@@ -23,10 +23,10 @@
 #include "ProfilingDebugging/CsvProfiler.h"
 #include "Async/AsyncWork.h"
 #include "CoreGlobals.h"
+#include "Interfaces/ITaskScheduler.h"
 
 // Stats declarations
 DECLARE_CYCLE_STAT(TEXT("Async Operation Execute"), STAT_AsyncOperation_Execute, STATGROUP_Threading);
-DECLARE_CYCLE_STAT(TEXT("Async Operation Progress"), STAT_AsyncOperation_Progress, STATGROUP_Threading);
 DECLARE_CYCLE_STAT(TEXT("Async Manager Update"), STAT_AsyncManager_Update, STATGROUP_Threading);
 
 // CSV profiler category
@@ -49,6 +49,10 @@ FAsyncOperationImpl::FAsyncOperationImpl(uint64 InId, const FString& InType, con
     , CreationTime(FPlatformTime::Seconds())
     , StartTime(0.0)
     , CompletionTime(0.0)
+    , ProgressCallbackThread(EAsyncCallbackThread::GameThread)
+    , CompletionCallbackThread(EAsyncCallbackThread::GameThread)
+    , bProgressQueued(false)
+    , bContinuationsFired(false)
 {
     Progress.CompletionPercentage = 0.0f;
     Progress.CurrentStage = 0;
@@ -112,21 +116,20 @@ EAsyncStatus FAsyncOperationImpl::GetStatus() const
 
 void FAsyncOperationImpl::UpdateProgress(const FAsyncProgress& InProgress)
 {
-    FScopeLock Lock(&StateLock);
-    
-    // Update progress data
-    Progress = InProgress;
-    
-    // Calculate elapsed time if not set
-    if (Progress.ElapsedTimeSeconds <= 0.0 && StartTime > 0.0)
     {
-        Progress.ElapsedTimeSeconds = FPlatformTime::Seconds() - StartTime;
+        FScopeLock Lock(&StateLock);
+        
+        // Update progress data
+        Progress = InProgress;
+        
+        // Calculate elapsed time if not set
+        if (Progress.ElapsedTimeSeconds <= 0.0 && StartTime > 0.0)
+        {
+            Progress.ElapsedTimeSeconds = FPlatformTime::Seconds() - StartTime;
+        }
     }
     
-    // Update last progress time
-    LastProgressUpdateTime = FPlatformTime::Seconds();
-    
-    // Notify about progress
+    // Notify outside the lock; a completing thread callback runs inline
     NotifyProgress();
 }
 
@@ -156,20 +159,28 @@ FAsyncResult FAsyncOperationImpl::GetResult() const
     return Result;
 }
 
-bool FAsyncOperationImpl::RegisterProgressCallback(const FAsyncProgressDelegate& Callback, uint32 UpdateIntervalMs)
+bool FAsyncOperationImpl::RegisterProgressCallback(const FAsyncProgressDelegate& Callback, uint32 UpdateIntervalMs, EAsyncCallbackThread CallbackThread)
 {
     if (!Callback.IsBound())
     {
         return false;
     }
     
-    FScopeLock Lock(&StateLock);
-    
-    ProgressCallback = Callback;
-    ProgressUpdateIntervalSeconds = FMath::Max(0.01, UpdateIntervalMs / 1000.0);
+    bool bInProgress = false;
+    {
+        FScopeLock Lock(&StateLock);
+        
+        ProgressCallback = Callback;
+        ProgressCallbackThread = CallbackThread;
+        ProgressUpdateIntervalSeconds = FMath::Max(0.01, UpdateIntervalMs / 1000.0);
+        
+        // Let the initial notification through the throttle
+        LastProgressUpdateTime = 0.0;
+        bInProgress = Status == EAsyncStatus::InProgress;
+    }
     
     // Trigger initial progress notification
-    if (Status == EAsyncStatus::InProgress)
+    if (bInProgress)
     {
         NotifyProgress();
     }
@@ -177,7 +188,7 @@ bool FAsyncOperationImpl::RegisterProgressCallback(const FAsyncProgressDelegate&
     return true;
 }
 
-bool FAsyncOperationImpl::RegisterCompletionCallback(const FAsyncCompletionDelegate& Callback)
+bool FAsyncOperationImpl::RegisterCompletionCallback(const FAsyncCompletionDelegate& Callback, EAsyncCallbackThread CallbackThread)
 {
     if (!Callback.IsBound())
     {
@@ -187,6 +198,7 @@ bool FAsyncOperationImpl::RegisterCompletionCallback(const FAsyncCompletionDeleg
     FScopeLock Lock(&StateLock);
     
     CompletionCallback = Callback;
+    CompletionCallbackThread = CallbackThread;
     
     // If already completed, trigger immediately
     if (Status == EAsyncStatus::Completed || 
@@ -217,22 +229,85 @@ void FAsyncOperationImpl::NotifyCompletion()
     // Make a local copy of the callback to avoid calling it while locked
     FAsyncCompletionDelegate CallbackCopy;
     FAsyncResult ResultCopy;
+    EAsyncCallbackThread CallbackThread;
+    double Completed;
     
     {
         FScopeLock Lock(&StateLock);
         CallbackCopy = CompletionCallback;
         ResultCopy = Result;
+        CallbackThread = CompletionCallbackThread;
+        Completed = CompletionTime > 0.0 ? CompletionTime : FPlatformTime::Seconds();
     }
     
-    // Call the completion callback if bound
     if (CallbackCopy.IsBound())
     {
-        CallbackCopy.Execute(ResultCopy);
+        FAsyncTaskManager* Manager = FAsyncTaskManager::Instance;
+        
+        // Game thread callbacks completed elsewhere go through the manager's queue
+        if (CallbackThread == EAsyncCallbackThread::GameThread && !IsInGameThread() && Manager)
+        {
+            Manager->PostCompletion(Id, CallbackCopy, ResultCopy, Completed);
+        }
+        else
+        {
+            if (Manager)
+            {
+                Manager->RecordCompletionDispatched(Completed);
+            }
+            CallbackCopy.Execute(ResultCopy);
+        }
     }
+    
+    // Continuations run after the callback, on this thread
+    FireContinuations();
 }
 
 void FAsyncOperationImpl::NotifyProgress()
 {
+    FAsyncTaskManager* Manager = FAsyncTaskManager::Instance;
+    
+    {
+        FScopeLock Lock(&StateLock);
+        if (!ProgressCallback.IsBound())
+        {
+            return;
+        }
+        
+        const bool bPostToGameThread = ProgressCallbackThread == EAsyncCallbackThread::GameThread && !IsInGameThread() && Manager;
+        if (bPostToGameThread)
+        {
+            Manager->RecordProgressReported();
+        }
+        
+        // Reports inside the registered update interval are dropped; the next one that is due
+        // carries the latest progress
+        if (!IsProgressUpdateDue())
+        {
+            return;
+        }
+        LastProgressUpdateTime = FPlatformTime::Seconds();
+        
+        // Only one game thread update per operation is queued at a time; it delivers whatever
+        // progress is latest when it runs, so reports made while it waits are merged into it
+        if (bPostToGameThread)
+        {
+            if (!bProgressQueued.AtomicSet(true))
+            {
+                Manager->PostProgress(Id);
+            }
+            return;
+        }
+    }
+    
+    DispatchQueuedProgress();
+}
+
+void FAsyncOperationImpl::DispatchQueuedProgress()
+{
+    // Clear the flag first so a report made while the callback runs queues a new update
+    bProgressQueued.AtomicSet(false);
+    
     // Make a local copy of the callback to avoid calling it while locked
     FAsyncProgressDelegate CallbackCopy;
     FAsyncProgress ProgressCopy;
@@ -256,6 +331,101 @@ void FAsyncOperationImpl::NotifyProgress()
     }
 }
 
+void FAsyncOperationImpl::AddContinuation(FContinuationHandler Handler)
+{
+    if (!Handler)
+    {
+        return;
+    }
+    
+    {
+        FScopeLock Lock(&StateLock);
+        if (!bContinuationsFired)
+        {
+            Continuations.Add(MoveTemp(Handler));
+            return;
+        }
+    }
+    
+    // Already ended; whatever result is left is all a late handler can get
+    Handler(GetStatus(), GetResult());
+}
+
+void FAsyncOperationImpl::FireContinuations()
+{
+    TArray<FContinuationHandler> Handlers;
+    EAsyncStatus FinalStatus;
+    FAsyncResult FinalResult;
+    
+    {
+        FScopeLock Lock(&StateLock);
+        if (bContinuationsFired || !IsFinished())
+        {
+            return;
+        }
+        
+        bContinuationsFired = true;
+        Handlers = MoveTemp(Continuations);
+        FinalStatus = Status;
+        
+        if (Handlers.Num() == 1)
+        {
+            // A single consumer takes the result; keep the flags so status queries stay meaningful
+            FinalResult = MoveTemp(Result);
+            Result.bSuccess = FinalResult.bSuccess;
+            Result.bCancelled = FinalResult.bCancelled;
+            Result.ErrorCode = FinalResult.ErrorCode;
+        }
+        else if (Handlers.Num() > 1)
+        {
+            FinalResult = Result;
+        }
+    }
+    
+    for (int32 Index = 0; Index < Handlers.Num(); ++Index)
+    {
+        if (Index == Handlers.Num() - 1)
+        {
+            Handlers[Index](FinalStatus, MoveTemp(FinalResult));
+        }
+        else
+        {
+            FAsyncResult ResultCopy = FinalResult;
+            Handlers[Index](FinalStatus, MoveTemp(ResultCopy));
+        }
+    }
+}
+
+bool FAsyncOperationImpl::Resolve(EAsyncStatus FinalStatus, FAsyncResult&& FinalResult)
+{
+    {
+        FScopeLock Lock(&StateLock);
+        if (IsFinished())
+        {
+            return false;
+        }
+        
+        Result = MoveTemp(FinalResult);
+        if (FinalStatus == EAsyncStatus::Cancelled)
+        {
+            bCancelled.Set(1);
+        }
+        SetStatus(FinalStatus);
+    }
+    
+    NotifyCompletion();
+    return true;
+}
+
+bool FAsyncOperationImpl::IsFinished() const
+{
+    FScopeLock Lock(&StateLock);
+    return Status == EAsyncStatus::Completed ||
+        Status == EAsyncStatus::Failed ||
+        Status == EAsyncStatus::Cancelled ||
+        Status == EAsyncStatus::TimedOut;
+}
+
 double FAsyncOperationImpl::GetCreationTime() const
 {
     return CreationTime;
@@ -360,6 +530,58 @@ bool FAsyncOperationFactory::IsTypeRegistered(const FString& Type) const
     return OperationCreators.Contains(Type);
 }
 
+//----------------------------------------------------------------------
+// FAsyncContinuationOperation Implementation
+//----------------------------------------------------------------------
+
+/**
+ * Operation created by Then, WhenAll and WhenAny
+ * Never started through StartOperation; it is resolved by its antecedents' continuation handlers
+ */
+class FAsyncContinuationOperation : public FAsyncOperationImpl
+{
+public:
+    FAsyncContinuationOperation(uint64 InId, const FString& InType)
+        : FAsyncOperationImpl(InId, InType, TEXT(""))
+    {
+    }
+    
+    virtual bool Execute() override
+    {
+        return false;
+    }
+    
+    virtual bool Cancel() override
+    {
+        // CancelOperation has already set the status and result; pass the cancellation on
+        NotifyCompletion();
+        return true;
+    }
+};
+
+namespace AsyncTaskManagerInternal
+{
+    /** Maps an unsuccessful result to the status the operation should end with */
+    EAsyncStatus GetStatusForResult(const FAsyncResult& Result)
+    {
+        if (Result.bSuccess)
+        {
+            return EAsyncStatus::Completed;
+        }
+        return Result.bCancelled ? EAsyncStatus::Cancelled : EAsyncStatus::Failed;
+    }
+    
+    /** Shared state of a WhenAll */
+    struct FWhenAllState
+    {
+        /** Antecedents still running */
+        std::atomic<int32> Remaining;
+        
+        /** Results by antecedent index; each slot is written by one antecedent only */
+        TArray<FAsyncResult> Results;
+    };
+}
+
 //----------------------------------------------------------------------
 // FAsyncTaskManager Implementation
 //----------------------------------------------------------------------
@@ -379,6 +601,12 @@ IAsyncOperation& FAsyncTaskManager::Get()
 FAsyncTaskManager::FAsyncTaskManager()
     : bIsInitialized(false)
     , NextOperationId(1)
+    , CompletionsDispatched(0)
+    , CompletionsQueued(0)
+    , TotalCompletionLatencyUs(0)
+    , MaxCompletionLatencyUs(0)
+    , ProgressReported(0)
+    , ProgressDispatched(0)
 {
     // Set the singleton instance
     check(Instance == nullptr);
@@ -407,9 +635,7 @@ bool FAsyncTaskManager::Initialize()
     NextOperationId.Set(1);
     
     // No need for FTicker here since we inherit from FTickableGameObject
-    // and implement Tick() in our class
-    // Instead, we'll just set the update interval
-    TickInterval = 0.1f; // 100ms interval
+    // and implement Tick() in our class; queued callbacks are drained every frame
     
     // Register built-in operation types
     // This would be expanded with mining-specific operations in a real implementation
@@ -426,6 +652,16 @@ void FAsyncTaskManager::Shutdown()
     
     // No need to unregister ticker, FTickableGameObject handles this
     
+    // Deliver callbacks that are still queued; off the game thread they are dropped
+    if (IsInGameThread())
+    {
+        ProcessGameThreadCallbacks();
+    }
+    else
+    {
+        GameThreadCallbacks.Empty();
+    }
+    
     // Clean up operations
     CleanupCompletedOperations(0.0);
     
@@ -533,6 +769,9 @@ bool FAsyncTaskManager::CancelOperation(uint64 OperationId, bool bWaitForCancell
     // Attempt to cancel the operation
     bool bSuccess = Operation->Cancel();
     
+    // Cancel everything chained after it, even if the operation never started
+    Operation->FireContinuations();
+    
     if (bWaitForCancellation)
     {
         // Wait for the operation to be marked as complete
@@ -702,6 +941,38 @@ bool FAsyncTaskManager::RegisterCompletionCallback(uint64 OperationId, const FAs
     return Operation->RegisterCompletionCallback(Callback);
 }
 
+bool FAsyncTaskManager::RegisterProgressCallback(uint64 OperationId, const FAsyncProgressDelegate& Callback, uint32 UpdateIntervalMs, EAsyncCallbackThread CallbackThread)
+{
+    if (!bIsInitialized || OperationId == 0 || !Callback.IsBound())
+    {
+        return false;
+    }
+    
+    FAsyncOperationImpl* Operation = GetOperationById(OperationId);
+    if (!Operation)
+    {
+        return false;
+    }
+    
+    return Operation->RegisterProgressCallback(Callback, UpdateIntervalMs, CallbackThread);
+}
+
+bool FAsyncTaskManager::RegisterCompletionCallback(uint64 OperationId, const FAsyncCompletionDelegate& Callback, EAsyncCallbackThread CallbackThread)
+{
+    if (!bIsInitialized || OperationId == 0 || !Callback.IsBound())
+    {
+        return false;
+    }
+    
+    FAsyncOperationImpl* Operation = GetOperationById(OperationId);
+    if (!Operation)
+    {
+        return false;
+    }
+    
+    return Operation->RegisterCompletionCallback(Callback, CallbackThread);
+}
+
 uint32 FAsyncTaskManager::GetActiveOperationCount() const
 {
     if (!bIsInitialized)
@@ -840,70 +1111,193 @@ uint32 FAsyncTaskManager::CleanupCompletedOperations(double MaxAgeSeconds)
     return CleanedCount;
 }
 
-bool FAsyncTaskManager::RegisterOperationType(const FString& Type, TFunction<FAsyncOperationImpl*(uint64, const FString&)> Creator)
+uint64 FAsyncTaskManager::Then(uint64 AntecedentId, FAsyncContinuation Continuation, bool bRunOnFailure)
 {
-    if (!bIsInitialized || Type.IsEmpty() || !Creator)
+    using namespace AsyncTaskManagerInternal;
+    
+    if (!bIsInitialized || !Continuation)
     {
-        return false;
+        return 0;
     }
     
-    return Factory.RegisterOperationType(Type, Creator);
-}
-
-TArray<FString> FAsyncTaskManager::GetRegisteredOperationTypes() const
-{
-    if (!bIsInitialized)
+    FAsyncOperationImpl* Antecedent = GetOperationById(AntecedentId);
+    if (!Antecedent)
     {
-        return TArray<FString>();
+        return 0;
     }
     
-    return Factory.GetRegisteredTypes();
+    uint64 ContinuationId = GenerateOperationId();
+    AddInternalOperation(new FAsyncContinuationOperation(ContinuationId, TEXT("Continuation")));
+    
+    Antecedent->AddContinuation([this, ContinuationId, Continuation = MoveTemp(Continuation), bRunOnFailure](EAsyncStatus AntecedentStatus, FAsyncResult&& AntecedentResult) mutable
+    {
+        FAsyncOperationImpl* Operation = GetOperationById(ContinuationId);
+        if (!Operation || Operation->IsFinished())
+        {
+            return;
+        }
+        
+        const bool bRun = AntecedentStatus == EAsyncStatus::Completed ||
+            (bRunOnFailure && AntecedentStatus != EAsyncStatus::Cancelled);
+        if (!bRun)
+        {
+            // Propagate the antecedent's failure or cancellation
+            Operation->Resolve(AntecedentStatus, MoveTemp(AntecedentResult));
+            return;
+        }
+        
+        Operation->SetStatus(EAsyncStatus::InProgress);
+        
+        auto Body = [this, ContinuationId, Continuation = MoveTemp(Continuation), Input = MoveTemp(AntecedentResult)]() mutable
+        {
+            FAsyncOperationImpl* Target = GetOperationById(ContinuationId);
+            if (!Target || Target->IsFinished())
+            {
+                return;
+            }
+            
+            FAsyncResult Output = Continuation(MoveTemp(Input));
+            EAsyncStatus FinalStatus = GetStatusForResult(Output);
+            Target->Resolve(FinalStatus, MoveTemp(Output));
+        };
+        
+        // Straight onto a worker; run inline only if the scheduler is not available
+        FTaskConfig Config;
+        Config.Type = ETaskType::General;
+        TSharedRef<decltype(Body)> SharedBody = MakeShared<decltype(Body)>(MoveTemp(Body));
+        if (ITaskScheduler::Get().ScheduleTask([SharedBody]() { (*SharedBody)(); }, Config, TEXT("Async continuation")) == 0)
+        {
+            (*SharedBody)();
+        }
+    });
+    
+    return ContinuationId;
 }
 
-void FAsyncTaskManager::UpdateOperations()
+uint64 FAsyncTaskManager::WhenAll(const TArray<uint64>& OperationIds)
 {
-    SCOPE_CYCLE_COUNTER(STAT_AsyncManager_Update);
+    using namespace AsyncTaskManagerInternal;
     
     if (!bIsInitialized)
     {
-        return;
+        return 0;
     }
     
-    // Make a copy of active operations to avoid holding the lock while iterating
-    TArray<uint64> ActiveIds;
+    TArray<FAsyncOperationImpl*> Antecedents;
+    for (uint64 OperationId : OperationIds)
     {
-        FScopeLock Lock(&OperationsLock);
-        
-        for (const auto& Pair : Operations)
+        FAsyncOperationImpl* Antecedent = GetOperationById(OperationId);
+        if (!Antecedent)
         {
-            FAsyncOperationImpl* Operation = Pair.Value;
-            if (!Operation)
+            return 0;
+        }
+        Antecedents.Add(Antecedent);
+    }
+    
+    uint64 CombinedId = GenerateOperationId();
+    FAsyncOperationImpl* Combined = new FAsyncContinuationOperation(CombinedId, TEXT("WhenAll"));
+    AddInternalOperation(Combined);
+    Combined->SetStatus(EAsyncStatus::InProgress);
+    
+    TSharedRef<FWhenAllState, ESPMode::ThreadSafe> State = MakeShared<FWhenAllState, ESPMode::ThreadSafe>();
+    State->Remaining.store(Antecedents.Num(), std::memory_order_relaxed);
+    State->Results.SetNum(Antecedents.Num());
+    
+    if (Antecedents.Num() == 0)
+    {
+        FAsyncResult Empty;
+        Empty.ResultData = MakeShared<TArray<FAsyncResult>>();
+        Combined->Resolve(EAsyncStatus::Completed, MoveTemp(Empty));
+        return CombinedId;
+    }
+    
+    for (int32 Index = 0; Index < Antecedents.Num(); ++Index)
+    {
+        Antecedents[Index]->AddContinuation([this, CombinedId, State, Index](EAsyncStatus AntecedentStatus, FAsyncResult&& AntecedentResult)
+        {
+            FAsyncOperationImpl* Target = GetOperationById(CombinedId);
+            if (!Target)
             {
-                continue;
+                return;
             }
             
-            EAsyncStatus Status = Operation->GetStatus();
-            if (Status == EAsyncStatus::InProgress)
+            if (AntecedentStatus != EAsyncStatus::Completed)
+            {
+                // The first failure or cancellation ends the whole group
+                Target->Resolve(AntecedentStatus, MoveTemp(AntecedentResult));
+                return;
+            }
+            
+            State->Results[Index] = MoveTemp(AntecedentResult);
+            if (State->Remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
             {
-                ActiveIds.Add(Pair.Key);
+                FAsyncResult CombinedResult;
+                CombinedResult.ResultData = MakeShared<TArray<FAsyncResult>>(MoveTemp(State->Results));
+                Target->Resolve(EAsyncStatus::Completed, MoveTemp(CombinedResult));
             }
+        });
+    }
+    
+    return CombinedId;
+}
+
+uint64 FAsyncTaskManager::WhenAny(const TArray<uint64>& OperationIds)
+{
+    if (!bIsInitialized || OperationIds.Num() == 0)
+    {
+        return 0;
+    }
+    
+    TArray<FAsyncOperationImpl*> Antecedents;
+    for (uint64 OperationId : OperationIds)
+    {
+        FAsyncOperationImpl* Antecedent = GetOperationById(OperationId);
+        if (!Antecedent)
+        {
+            return 0;
         }
+        Antecedents.Add(Antecedent);
     }
     
-    // Update progress for each active operation
-    for (uint64 Id : ActiveIds)
+    uint64 CombinedId = GenerateOperationId();
+    FAsyncOperationImpl* Combined = new FAsyncContinuationOperation(CombinedId, TEXT("WhenAny"));
+    AddInternalOperation(Combined);
+    Combined->SetStatus(EAsyncStatus::InProgress);
+    
+    for (FAsyncOperationImpl* Antecedent : Antecedents)
     {
-        FAsyncOperationImpl* Operation = GetOperationById(Id);
-        if (Operation && Operation->GetStatus() == EAsyncStatus::InProgress)
+        Antecedent->AddContinuation([this, CombinedId](EAsyncStatus AntecedentStatus, FAsyncResult&& AntecedentResult)
         {
-            // Check if it's time for a progress update
-            if (Operation->IsProgressUpdateDue())
+            // Resolve ignores every antecedent after the first
+            FAsyncOperationImpl* Target = GetOperationById(CombinedId);
+            if (Target)
             {
-                SCOPE_CYCLE_COUNTER(STAT_AsyncOperation_Progress);
-                Operation->NotifyProgress();
+                Target->Resolve(AntecedentStatus, MoveTemp(AntecedentResult));
             }
-        }
+        });
     }
+    
+    return CombinedId;
+}
+
+bool FAsyncTaskManager::RegisterOperationType(const FString& Type, TFunction<FAsyncOperationImpl*(uint64, const FString&)> Creator)
+{
+    if (!bIsInitialized || Type.IsEmpty() || !Creator)
+    {
+        return false;
+    }
+    
+    return Factory.RegisterOperationType(Type, Creator);
+}
+
+TArray<FString> FAsyncTaskManager::GetRegisteredOperationTypes() const
+{
+    if (!bIsInitialized)
+    {
+        return TArray<FString>();
+    }
+    
+    return Factory.GetRegisteredTypes();
 }
 
 FAsyncOperationImpl* FAsyncTaskManager::GetOperationById(uint64 OperationId) const
@@ -966,11 +1360,114 @@ FString FAsyncTaskManager::CreateProgressDelta(const FAsyncProgress& Previous, c
     return FString::Join(Changes, TEXT(", "));
 }
 
+int32 FAsyncTaskManager::ProcessGameThreadCallbacks()
+{
+    check(IsInGameThread());
+    
+    int32 DispatchedCount = 0;
+    FQueuedCallback Callback;
+    
+    while (GameThreadCallbacks.Dequeue(Callback))
+    {
+        if (Callback.bCompletion)
+        {
+            RecordCompletionDispatched(Callback.CompletionTime);
+            Callback.CompletionCallback.ExecuteIfBound(Callback.Result);
+        }
+        else
+        {
+            // Progress for an operation cleaned up since it was queued is dropped
+            FAsyncOperationImpl* Operation = GetOperationById(Callback.OperationId);
+            if (Operation)
+            {
+                ProgressDispatched.fetch_add(1, std::memory_order_relaxed);
+                Operation->DispatchQueuedProgress();
+            }
+        }
+        
+        DispatchedCount++;
+    }
+    
+    return DispatchedCount;
+}
+
+void FAsyncTaskManager::PostCompletion(uint64 OperationId, const FAsyncCompletionDelegate& Callback, const FAsyncResult& Result, double CompletionTime)
+{
+    FQueuedCallback Queued;
+    Queued.OperationId = OperationId;
+    Queued.bCompletion = true;
+    Queued.CompletionCallback = Callback;
+    Queued.Result = Result;
+    Queued.CompletionTime = CompletionTime;
+    
+    CompletionsQueued.fetch_add(1, std::memory_order_relaxed);
+    GameThreadCallbacks.Enqueue(MoveTemp(Queued));
+}
+
+void FAsyncTaskManager::PostProgress(uint64 OperationId)
+{
+    FQueuedCallback Queued;
+    Queued.OperationId = OperationId;
+    Queued.bCompletion = false;
+    Queued.CompletionTime = 0.0;
+    
+    GameThreadCallbacks.Enqueue(MoveTemp(Queued));
+}
+
+void FAsyncTaskManager::RecordCompletionDispatched(double CompletionTime)
+{
+    const uint64 LatencyUs = static_cast<uint64>(FMath::Max(FPlatformTime::Seconds() - CompletionTime, 0.0) * 1.0e6);
+    
+    CompletionsDispatched.fetch_add(1, std::memory_order_relaxed);
+    TotalCompletionLatencyUs.fetch_add(LatencyUs, std::memory_order_relaxed);
+    
+    uint64 Max = MaxCompletionLatencyUs.load(std::memory_order_relaxed);
+    while (LatencyUs > Max && !MaxCompletionLatencyUs.compare_exchange_weak(Max, LatencyUs, std::memory_order_relaxed))
+    {
+    }
+}
+
+void FAsyncTaskManager::RecordProgressReported()
+{
+    ProgressReported.fetch_add(1, std::memory_order_relaxed);
+}
+
+FAsyncDispatchStats FAsyncTaskManager::GetDispatchStats() const
+{
+    FAsyncDispatchStats Stats;
+    Stats.CompletionsDispatched = CompletionsDispatched.load(std::memory_order_relaxed);
+    Stats.CompletionsQueued = CompletionsQueued.load(std::memory_order_relaxed);
+    Stats.AverageCompletionLatencyMs = Stats.CompletionsDispatched > 0
+        ? TotalCompletionLatencyUs.load(std::memory_order_relaxed) / 1000.0 / Stats.CompletionsDispatched
+        : 0.0;
+    Stats.MaxCompletionLatencyMs = MaxCompletionLatencyUs.load(std::memory_order_relaxed) / 1000.0;
+    Stats.ProgressReported = ProgressReported.load(std::memory_order_relaxed);
+    Stats.ProgressDispatched = ProgressDispatched.load(std::memory_order_relaxed);
+    return Stats;
+}
+
+void FAsyncTaskManager::ResetDispatchStats()
+{
+    CompletionsDispatched.store(0, std::memory_order_relaxed);
+    CompletionsQueued.store(0, std::memory_order_relaxed);
+    TotalCompletionLatencyUs.store(0, std::memory_order_relaxed);
+    MaxCompletionLatencyUs.store(0, std::memory_order_relaxed);
+    ProgressReported.store(0, std::memory_order_relaxed);
+    ProgressDispatched.store(0, std::memory_order_relaxed);
+}
+
 uint64 FAsyncTaskManager::GenerateOperationId()
 {
     return NextOperationId.Add(1);
 }
 
+void FAsyncTaskManager::AddInternalOperation(FAsyncOperationImpl* Operation)
+{
+    FScopeLock Lock(&OperationsLock);
+    Operations.Add(Operation->GetId(), Operation);
+    UpdateActiveOperationsMap(Operation->GetType(), Operation->GetId(), true);
+}
+
 void FAsyncTaskManager::MoveToCompleted(FAsyncOperationImpl* Operation)
 {
     if (!Operation)
@@ -1035,8 +1532,8 @@ bool FAsyncTaskManager::TickUpdateOperations(float DeltaTime)
         return false;
     }
     
-    // Update any active operations
-    UpdateOperations();
+    // Deliver completions and coalesced progress posted by workers since the last frame
+    ProcessGameThreadCallbacks();
     
     // Cleanup old completed operations periodically
     static float TimeUntilCleanup = 60.0f; // Cleanup every minute
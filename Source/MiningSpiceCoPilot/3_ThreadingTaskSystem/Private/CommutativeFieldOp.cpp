@@ -0,0 +1,101 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CommutativeFieldOp.h"
+
+FCommutativeFieldOp FCommutativeFieldOp::MakeSphere(int32 InZoneId, ECommutativeOpType InOperationType, const FVector& InCenter, float Radius, float BandWidth, int32 InMaterialId)
+{
+    FCommutativeFieldOp Operation;
+    Operation.ZoneId = InZoneId;
+    Operation.MaterialId = InMaterialId;
+    Operation.OperationType = InOperationType;
+    Operation.Shape = ECommutativeOpShape::Sphere;
+    Operation.Center = InCenter;
+    Operation.Extent = FVector(Radius, Radius, Radius);
+    Operation.Bounds = GetAffectedBounds(InOperationType, FBox(InCenter - FVector(Radius + BandWidth), InCenter + FVector(Radius + BandWidth)));
+    return Operation;
+}
+
+FCommutativeFieldOp FCommutativeFieldOp::MakeBox(int32 InZoneId, ECommutativeOpType InOperationType, const FVector& InCenter, const FVector& HalfSize, float BandWidth, int32 InMaterialId)
+{
+    FCommutativeFieldOp Operation;
+    Operation.ZoneId = InZoneId;
+    Operation.MaterialId = InMaterialId;
+    Operation.OperationType = InOperationType;
+    Operation.Shape = ECommutativeOpShape::Box;
+    Operation.Center = InCenter;
+    Operation.Extent = HalfSize;
+    Operation.Bounds = GetAffectedBounds(InOperationType, FBox(InCenter - HalfSize - FVector(BandWidth), InCenter + HalfSize + FVector(BandWidth)));
+    return Operation;
+}
+
+FBox FCommutativeFieldOp::GetAffectedBounds(ECommutativeOpType InOperationType, const FBox& ShapeBounds)
+{
+    // An intersection removes all material outside the shape, so it modifies the whole field
+    if (InOperationType == ECommutativeOpType::Intersection)
+    {
+        return FBox(FVector(-HALF_WORLD_MAX), FVector(HALF_WORLD_MAX));
+    }
+
+    return ShapeBounds;
+}
+
+ECommutativeOpClass FCommutativeFieldOp::GetClass(ECommutativeOpType InOperationType)
+{
+    switch (InOperationType)
+    {
+        case ECommutativeOpType::Union:
+            return ECommutativeOpClass::Min;
+
+        case ECommutativeOpType::Subtraction:
+        case ECommutativeOpType::Intersection:
+            return ECommutativeOpClass::Max;
+    }
+
+    return ECommutativeOpClass::NonCommutative;
+}
+
+float FCommutativeFieldOp::EvaluateShape(const FVector& Position) const
+{
+    FVector Local = Position - Center;
+
+    switch (Shape)
+    {
+        case ECommutativeOpShape::Sphere:
+            return static_cast<float>(Local.Size() - Extent.X);
+
+        case ECommutativeOpShape::Box:
+        {
+            // Exact box distance: outside part plus negative inside part
+            FVector Q = Local.GetAbs() - Extent;
+            double Outside = Q.ComponentMax(FVector::ZeroVector).Size();
+            double Inside = FMath::Min(FMath::Max3(Q.X, Q.Y, Q.Z), 0.0);
+            return static_cast<float>(Outside + Inside);
+        }
+    }
+
+    return MAX_flt;
+}
+
+float FCommutativeFieldOp::Apply(float FieldValue, const FVector& Position) const
+{
+    if (!Bounds.IsInsideOrOn(Position))
+    {
+        return FieldValue;
+    }
+
+    float ShapeValue = EvaluateShape(Position);
+
+    switch (OperationType)
+    {
+        case ECommutativeOpType::Union:
+            return FMath::Min(FieldValue, ShapeValue);
+
+        case ECommutativeOpType::Subtraction:
+            return FMath::Max(FieldValue, -ShapeValue);
+
+        case ECommutativeOpType::Intersection:
+            return FMath::Max(FieldValue, ShapeValue);
+    }
+
+    return FieldValue;
+}
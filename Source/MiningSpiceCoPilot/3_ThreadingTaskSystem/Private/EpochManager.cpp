@@ -0,0 +1,260 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EpochManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+FEpochManager::FEpochManager()
+    : GlobalEpoch(1)
+    , Records(nullptr)
+    , PendingCount(0)
+    , FreedCount(0)
+{
+}
+
+FEpochManager::~FEpochManager()
+{
+    // Records are left allocated: a thread-exit handle may still reach them during process teardown
+    for (FThreadRecord* Record = Records.load(std::memory_order_acquire); Record; Record = Record->Next)
+    {
+        FreeExpired(Record->RetireList, MAX_uint64);
+    }
+
+    FScopeLock Lock(&OrphanLock);
+    FreeExpired(OrphanList, MAX_uint64);
+}
+
+FEpochManager& FEpochManager::Get()
+{
+    static FEpochManager Instance;
+    return Instance;
+}
+
+FEpochManager::FThreadRecordHandle::~FThreadRecordHandle()
+{
+    if (Record)
+    {
+        FEpochManager::Get().ReleaseThreadRecord(Record);
+        Record = nullptr;
+    }
+}
+
+FEpochManager::FThreadRecord& FEpochManager::GetThreadRecord()
+{
+    static thread_local FThreadRecordHandle Handle;
+    if (Handle.Record)
+    {
+        return *Handle.Record;
+    }
+
+    // Reuse a record released by an exited thread before growing the registry
+    for (FThreadRecord* Record = Records.load(std::memory_order_acquire); Record; Record = Record->Next)
+    {
+        bool bExpected = false;
+        if (!Record->bInUse.load(std::memory_order_relaxed) &&
+            Record->bInUse.compare_exchange_strong(bExpected, true, std::memory_order_acquire))
+        {
+            Handle.Record = Record;
+            return *Record;
+        }
+    }
+
+    FThreadRecord* Record = new FThreadRecord();
+    Record->bInUse.store(true, std::memory_order_relaxed);
+
+    FThreadRecord* Head = Records.load(std::memory_order_relaxed);
+    do
+    {
+        Record->Next = Head;
+    }
+    while (!Records.compare_exchange_weak(Head, Record, std::memory_order_release, std::memory_order_relaxed));
+
+    Handle.Record = Record;
+    return *Record;
+}
+
+void FEpochManager::ReleaseThreadRecord(FThreadRecord* Record)
+{
+    // A thread cannot exit while pinned, but be defensive so the epoch is never held forever
+    Record->PinDepth = 0;
+    Record->PinnedEpoch.store(0, std::memory_order_release);
+
+    if (Record->RetireList.Num() > 0)
+    {
+        FScopeLock Lock(&OrphanLock);
+        OrphanList.Append(Record->RetireList);
+        Record->RetireList.Empty();
+    }
+
+    Record->bInUse.store(false, std::memory_order_release);
+}
+
+void FEpochManager::Enter()
+{
+    FThreadRecord& Record = GetThreadRecord();
+    if (Record.PinDepth++ == 0)
+    {
+        // The fence orders the announcement before any load of shared pointers; it pairs with
+        // the fence in TryAdvanceEpoch
+        Record.PinnedEpoch.store(GlobalEpoch.load(std::memory_order_relaxed) | ActiveBit, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+void FEpochManager::Exit()
+{
+    FThreadRecord& Record = GetThreadRecord();
+    check(Record.PinDepth > 0);
+
+    if (--Record.PinDepth == 0)
+    {
+        Record.PinnedEpoch.store(0, std::memory_order_release);
+
+        if (Record.RetireList.Num() >= CollectThreshold)
+        {
+            Collect();
+        }
+    }
+}
+
+bool FEpochManager::IsPinned() const
+{
+    return const_cast<FEpochManager*>(this)->GetThreadRecord().PinDepth > 0;
+}
+
+void FEpochManager::Retire(void* Object, FDeleter Deleter)
+{
+    if (!Object)
+    {
+        return;
+    }
+
+    FThreadRecord& Record = GetThreadRecord();
+
+    // Tag with the epoch after the object was unlinked; readers that could still see it are
+    // pinned at this epoch or earlier
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    Record.RetireList.Add({ Object, Deleter, GlobalEpoch.load(std::memory_order_relaxed) });
+    PendingCount.fetch_add(1, std::memory_order_relaxed);
+
+    // Bound the list even if this thread never quiesces
+    if (Record.RetireList.Num() >= CollectThreshold * 4)
+    {
+        Collect();
+    }
+}
+
+void FEpochManager::Quiesce()
+{
+    FThreadRecord& Record = GetThreadRecord();
+    if (Record.PinDepth == 0 && Record.RetireList.Num() >= CollectThreshold)
+    {
+        Collect();
+    }
+}
+
+bool FEpochManager::TryAdvanceEpoch()
+{
+    uint64 Current = GlobalEpoch.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    for (FThreadRecord* Record = Records.load(std::memory_order_acquire); Record; Record = Record->Next)
+    {
+        uint64 Pinned = Record->PinnedEpoch.load(std::memory_order_relaxed);
+        if ((Pinned & ActiveBit) != 0 && (Pinned & ~ActiveBit) != Current)
+        {
+            return false;
+        }
+    }
+
+    return GlobalEpoch.compare_exchange_strong(Current, Current + 1, std::memory_order_seq_cst);
+}
+
+int32 FEpochManager::FreeExpired(TArray<FRetiredObject>& List, uint64 SafeEpoch)
+{
+    int32 ExpiredCount = 0;
+    while (ExpiredCount < List.Num() && List[ExpiredCount].Epoch < SafeEpoch)
+    {
+        ExpiredCount++;
+    }
+
+    for (int32 Index = 0; Index < ExpiredCount; ++Index)
+    {
+        List[Index].Deleter(List[Index].Object);
+    }
+
+    if (ExpiredCount > 0)
+    {
+        List.RemoveAt(0, ExpiredCount, false);
+        PendingCount.fetch_sub(ExpiredCount, std::memory_order_relaxed);
+        FreedCount.fetch_add(ExpiredCount, std::memory_order_relaxed);
+    }
+
+    return ExpiredCount;
+}
+
+int32 FEpochManager::Collect()
+{
+    FThreadRecord& Record = GetThreadRecord();
+
+    TryAdvanceEpoch();
+
+    // Objects retired two or more epochs ago are unreachable: every thread pinned when they were
+    // unlinked has since unpinned or moved to a newer epoch
+    uint64 SafeEpoch = GlobalEpoch.load(std::memory_order_acquire) - 1;
+    int32 Freed = FreeExpired(Record.RetireList, SafeEpoch);
+
+    // Orphans are opportunistic; skip them rather than contend with another collector
+    if (OrphanLock.TryLock())
+    {
+        Freed += FreeExpired(OrphanList, SafeEpoch);
+        OrphanLock.Unlock();
+    }
+
+    return Freed;
+}
+
+bool FEpochManager::Synchronize(uint32 TimeoutMs)
+{
+    check(!IsPinned());
+
+    double EndTime = (TimeoutMs > 0) ? (FPlatformTime::Seconds() + TimeoutMs / 1000.0) : DBL_MAX;
+    uint64 TargetEpoch = GlobalEpoch.load(std::memory_order_acquire) + 2;
+
+    while (GlobalEpoch.load(std::memory_order_acquire) < TargetEpoch)
+    {
+        if (!TryAdvanceEpoch())
+        {
+            if (FPlatformTime::Seconds() >= EndTime)
+            {
+                return false;
+            }
+            FPlatformProcess::Yield();
+        }
+    }
+
+    FThreadRecord& Record = GetThreadRecord();
+    uint64 SafeEpoch = GlobalEpoch.load(std::memory_order_acquire) - 1;
+    FreeExpired(Record.RetireList, SafeEpoch);
+
+    FScopeLock Lock(&OrphanLock);
+    FreeExpired(OrphanList, SafeEpoch);
+
+    return true;
+}
+
+uint64 FEpochManager::GetGlobalEpoch() const
+{
+    return GlobalEpoch.load(std::memory_order_acquire);
+}
+
+int64 FEpochManager::GetPendingCount() const
+{
+    return PendingCount.load(std::memory_order_relaxed);
+}
+
+int64 FEpochManager::GetFreedCount() const
+{
+    return FreedCount.load(std::memory_order_relaxed);
+}
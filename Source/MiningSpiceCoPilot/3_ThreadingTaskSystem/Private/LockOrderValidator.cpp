@@ -0,0 +1,316 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LockOrderValidator.h"
+#include "LockProfiler.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/ScopeLock.h"
+#include "Algo/Sort.h"
+#include <atomic>
+
+namespace LockOrderValidatorInternal
+{
+    /** Holds of other levels in an already held rank that one thread can track exactly */
+    static constexpr uint32 MaxSharedHolds = 8;
+
+    /** Locks one thread holds in one domain */
+    struct FDomainState
+    {
+        /** Bit R is set while a lock of rank R is held */
+        uint64 HeldMask;
+
+        /** Hold count per rank, including shared holds, so repeated holds are released correctly */
+        uint8 HoldCount[FLockOrderValidator::MaxRank + 1];
+
+        /** Level and call site of the first hold of each rank */
+        uint32 Level[FLockOrderValidator::MaxRank + 1];
+        const void* Site[FLockOrderValidator::MaxRank + 1];
+
+        /** Holds of a different level in a rank whose first hold is above, in acquisition order */
+        uint32 SharedLevel[MaxSharedHolds];
+        const void* SharedSite[MaxSharedHolds];
+        uint32 SharedCount;
+    };
+
+    /** Per-thread state; zero-initialized, so first use costs nothing */
+    struct FThreadState
+    {
+        FDomainState Domains[static_cast<int32>(ELockOrderDomain::Count)];
+    };
+
+    static thread_local FThreadState ThreadState;
+
+    FORCEINLINE FDomainState& GetDomainState(ELockOrderDomain Domain)
+    {
+        return ThreadState.Domains[static_cast<int32>(Domain)];
+    }
+
+    /** Violations since the last reset */
+    static std::atomic<int64> ViolationCount(0);
+
+    /** First violation; written once per reset by the thread that moves ViolationCount from 0 */
+    static FLockOrderViolation FirstViolation;
+    static bool bHasFirstViolation = false;
+    static FCriticalSection FirstViolationLock;
+
+    const TCHAR* GetDomainName(ELockOrderDomain Domain)
+    {
+        return Domain == ELockOrderDomain::Registry ? TEXT("registry") : TEXT("hierarchical");
+    }
+
+    /** Gets the highest level held in a held rank and the call site that acquired it */
+    uint32 GetHighestLevelInRank(const FDomainState& State, uint32 Rank, const void*& OutSite)
+    {
+        uint32 Highest = State.Level[Rank];
+        OutSite = State.Site[Rank];
+        for (uint32 Index = 0; Index < State.SharedCount; ++Index)
+        {
+            if (FLockOrderValidator::GetRank(State.SharedLevel[Index]) == Rank && State.SharedLevel[Index] > Highest)
+            {
+                Highest = State.SharedLevel[Index];
+                OutSite = State.SharedSite[Index];
+            }
+        }
+        return Highest;
+    }
+
+    /** Counts the shared holds recorded for a rank */
+    uint32 CountSharedHolds(const FDomainState& State, uint32 Rank)
+    {
+        uint32 Count = 0;
+        for (uint32 Index = 0; Index < State.SharedCount; ++Index)
+        {
+            Count += FLockOrderValidator::GetRank(State.SharedLevel[Index]) == Rank ? 1 : 0;
+        }
+        return Count;
+    }
+
+    /** Removes a shared hold, keeping the others in acquisition order */
+    void RemoveSharedHold(FDomainState& State, uint32 Index)
+    {
+        for (uint32 Next = Index + 1; Next < State.SharedCount; ++Next)
+        {
+            State.SharedLevel[Next - 1] = State.SharedLevel[Next];
+            State.SharedSite[Next - 1] = State.SharedSite[Next];
+        }
+        State.SharedCount--;
+    }
+
+    /** Slow path, only reached on a violation */
+    FORCENOINLINE void ReportViolation(ELockOrderDomain Domain, uint32 HeldLevel, const void* HeldSite, uint32 Level, const void* Site)
+    {
+        FLockOrderViolation Violation;
+        Violation.Domain = Domain;
+        Violation.HeldLevel = HeldLevel;
+        Violation.AcquiredLevel = Level;
+        Violation.HeldSite = HeldSite;
+        Violation.AcquireSite = Site;
+        Violation.ThreadId = FPlatformTLS::GetCurrentThreadId();
+
+        if (ViolationCount.fetch_add(1, std::memory_order_relaxed) != 0)
+        {
+            UE_LOG(LogTemp, Verbose, TEXT("Lock order violation (%s): level %u acquired at %p while holding level %u"),
+                GetDomainName(Domain), Level, Site, Violation.HeldLevel);
+            return;
+        }
+
+        {
+            FScopeLock Lock(&FirstViolationLock);
+            FirstViolation = Violation;
+            bHasFirstViolation = true;
+        }
+
+        UE_LOG(LogTemp, Error, TEXT("Lock order violation (%s) on thread %u: acquiring level %u while holding level %u"),
+            GetDomainName(Domain), Violation.ThreadId, Level, Violation.HeldLevel);
+        UE_LOG(LogTemp, Error, TEXT("  Acquired at: %s"), *FLockProfiler::GetSiteName(Site));
+        UE_LOG(LogTemp, Error, TEXT("  Held since:  %s"), *FLockProfiler::GetSiteName(Violation.HeldSite));
+    }
+}
+
+bool FLockOrderValidator::OnAcquireChecked(ELockOrderDomain Domain, uint32 Level, const void* Site)
+{
+    using namespace LockOrderValidatorInternal;
+
+    FDomainState& State = GetDomainState(Domain);
+    const uint32 Rank = GetRank(Level);
+    const void* AcquireSite = Site ? Site : PLATFORM_RETURN_ADDRESS();
+
+    // Any held rank above the new one breaks the ordering; within the same rank the levels decide
+    const uint64 Conflicts = State.HeldMask >> Rank;
+    bool bValid = true;
+    if (UNLIKELY(Conflicts != 0))
+    {
+        const uint32 HeldRank = Rank + FMath::FloorLog2_64(Conflicts);
+        const void* HeldSite;
+        const uint32 HeldLevel = GetHighestLevelInRank(State, HeldRank, HeldSite);
+        if (HeldRank != Rank || HeldLevel >= Level)
+        {
+            ReportViolation(Domain, HeldLevel, HeldSite, Level, AcquireSite);
+            bValid = false;
+        }
+    }
+
+    if (State.HoldCount[Rank]++ == 0)
+    {
+        State.HeldMask |= 1ull << Rank;
+        State.Level[Rank] = Level;
+        State.Site[Rank] = AcquireSite;
+    }
+    else if (Level != State.Level[Rank])
+    {
+        if (State.SharedCount < MaxSharedHolds)
+        {
+            State.SharedLevel[State.SharedCount] = Level;
+            State.SharedSite[State.SharedCount] = AcquireSite;
+            State.SharedCount++;
+        }
+        else
+        {
+            UE_LOG(LogTemp, Verbose, TEXT("FLockOrderValidator - More than %u shared-rank holds; level %u is not compared in full"),
+                MaxSharedHolds, Level);
+        }
+    }
+
+    return bValid;
+}
+
+void FLockOrderValidator::OnReleaseChecked(ELockOrderDomain Domain, uint32 Level)
+{
+    using namespace LockOrderValidatorInternal;
+
+    FDomainState& State = GetDomainState(Domain);
+    const uint32 Rank = GetRank(Level);
+
+    if (State.HoldCount[Rank] == 0)
+    {
+        return;
+    }
+
+    if (--State.HoldCount[Rank] == 0)
+    {
+        // Drop shared holds left behind by unbalanced releases so they cannot outlive the rank
+        for (uint32 Index = State.SharedCount; Index-- > 0; )
+        {
+            if (GetRank(State.SharedLevel[Index]) == Rank)
+            {
+                RemoveSharedHold(State, Index);
+            }
+        }
+        State.HeldMask &= ~(1ull << Rank);
+        return;
+    }
+
+    if (Level != State.Level[Rank])
+    {
+        // Latest matching shared hold, as locks are normally released in reverse order
+        for (uint32 Index = State.SharedCount; Index-- > 0; )
+        {
+            if (State.SharedLevel[Index] == Level)
+            {
+                RemoveSharedHold(State, Index);
+                break;
+            }
+        }
+    }
+    else if (State.HoldCount[Rank] == CountSharedHolds(State, Rank))
+    {
+        // The first level has no holds left, so the oldest shared hold takes its place
+        for (uint32 Index = 0; Index < State.SharedCount; ++Index)
+        {
+            if (GetRank(State.SharedLevel[Index]) == Rank)
+            {
+                State.Level[Rank] = State.SharedLevel[Index];
+                State.Site[Rank] = State.SharedSite[Index];
+                RemoveSharedHold(State, Index);
+                break;
+            }
+        }
+    }
+}
+
+bool FLockOrderValidator::CanAcquire(ELockOrderDomain Domain, uint32 Level)
+{
+#if MINING_LOCK_ORDER_VALIDATION
+    const LockOrderValidatorInternal::FDomainState& State = LockOrderValidatorInternal::GetDomainState(Domain);
+    const uint32 Rank = GetRank(Level);
+    const uint64 Conflicts = State.HeldMask >> Rank;
+    if (Conflicts == 0)
+    {
+        return true;
+    }
+
+    const void* HeldSite;
+    return Conflicts == 1 && LockOrderValidatorInternal::GetHighestLevelInRank(State, Rank, HeldSite) < Level;
+#else
+    return true;
+#endif
+}
+
+TArray<uint32> FLockOrderValidator::GetHeldLevels(ELockOrderDomain Domain)
+{
+    TArray<uint32> Levels;
+#if MINING_LOCK_ORDER_VALIDATION
+    const LockOrderValidatorInternal::FDomainState& State = LockOrderValidatorInternal::GetDomainState(Domain);
+    for (uint64 Mask = State.HeldMask; Mask != 0; Mask &= Mask - 1)
+    {
+        const uint32 Rank = FMath::CountTrailingZeros64(Mask);
+        const int32 RankStart = Levels.Num();
+        Levels.Add(State.Level[Rank]);
+        for (uint32 Index = 0; Index < State.SharedCount; ++Index)
+        {
+            if (GetRank(State.SharedLevel[Index]) == Rank)
+            {
+                Levels.AddUnique(State.SharedLevel[Index]);
+            }
+        }
+        Algo::Sort(MakeArrayView(Levels.GetData() + RankStart, Levels.Num() - RankStart));
+    }
+#endif
+    return Levels;
+}
+
+uint32 FLockOrderValidator::GetHighestHeldLevel(ELockOrderDomain Domain)
+{
+#if MINING_LOCK_ORDER_VALIDATION
+    const LockOrderValidatorInternal::FDomainState& State = LockOrderValidatorInternal::GetDomainState(Domain);
+    if (State.HeldMask != 0)
+    {
+        const void* HeldSite;
+        return LockOrderValidatorInternal::GetHighestLevelInRank(State, FMath::FloorLog2_64(State.HeldMask), HeldSite);
+    }
+#endif
+    return 0;
+}
+
+void FLockOrderValidator::ResetThread(ELockOrderDomain Domain)
+{
+#if MINING_LOCK_ORDER_VALIDATION
+    FMemory::Memzero(LockOrderValidatorInternal::GetDomainState(Domain));
+#endif
+}
+
+bool FLockOrderValidator::GetFirstViolation(FLockOrderViolation& OutViolation)
+{
+    using namespace LockOrderValidatorInternal;
+
+    FScopeLock Lock(&FirstViolationLock);
+    if (bHasFirstViolation)
+    {
+        OutViolation = FirstViolation;
+    }
+    return bHasFirstViolation;
+}
+
+int64 FLockOrderValidator::GetViolationCount()
+{
+    return LockOrderValidatorInternal::ViolationCount.load(std::memory_order_relaxed);
+}
+
+void FLockOrderValidator::ResetViolations()
+{
+    using namespace LockOrderValidatorInternal;
+
+    FScopeLock Lock(&FirstViolationLock);
+    bHasFirstViolation = false;
+    ViolationCount.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,107 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LockOrderValidator.h"
+#include "ThreadSafety.h"
+#include "HAL/PlatformTime.h"
+
+/**
+ * Test program for the lock order validator
+ * Checks in-order and out-of-order acquisition in both domains, that the first violation keeps
+ * both call sites, and logs the cost of a validated acquire/release pair
+ */
+void TestLockOrderValidation()
+{
+    if (!FLockOrderValidator::IsEnabled())
+    {
+        UE_LOG(LogTemp, Display, TEXT("Lock order validation is compiled out in this configuration"));
+        return;
+    }
+
+    FLockOrderValidator::ResetViolations();
+
+    // Registry levels taken in hierarchy order are accepted and reported back in order
+    {
+        verifyf(FRegistryOperationValidator::AddLockToHistory(ERegistryLockLevel::Zone), TEXT("zone lock with nothing held"));
+        verifyf(FRegistryOperationValidator::AddLockToHistory(ERegistryLockLevel::SVO), TEXT("SVO lock while holding zone"));
+
+        TArray<ERegistryLockLevel> History = FRegistryOperationValidator::GetThreadLockHistory();
+        verifyf(History.Num() == 2 && History[0] == ERegistryLockLevel::Zone && History[1] == ERegistryLockLevel::SVO,
+            TEXT("history lists held levels in hierarchy order"));
+        verifyf(!FRegistryOperationValidator::CanSafelyAcquireLock(ERegistryLockLevel::Material), TEXT("material is refused while holding SVO"));
+
+        FRegistryOperationValidator::RemoveLockFromHistory(ERegistryLockLevel::SVO);
+        verifyf(FRegistryOperationValidator::CanSafelyAcquireLock(ERegistryLockLevel::Material), TEXT("material is accepted after SVO is released"));
+
+        FRegistryOperationValidator::RemoveLockFromHistory(ERegistryLockLevel::Zone);
+        verifyf(FRegistryOperationValidator::GetThreadLockHistory().Num() == 0, TEXT("history is empty after releasing everything"));
+        verifyf(FLockOrderValidator::GetViolationCount() == 0, TEXT("no violations recorded for ordered acquisition"));
+    }
+
+    // An inverted acquisition is reported once, with the call sites of both locks
+    {
+        FHierarchicalLock Outer(20);
+        FHierarchicalLock Inner(10);
+
+        Outer.Lock();
+        Inner.Lock();
+
+        FLockOrderViolation Violation;
+        bool bReported = FLockOrderValidator::GetFirstViolation(Violation);
+        verifyf(bReported && FLockOrderValidator::GetViolationCount() == 1, TEXT("inverted hierarchical acquisition is reported"));
+        verifyf(bReported && Violation.Domain == ELockOrderDomain::Hierarchical && Violation.HeldLevel == 20 && Violation.AcquiredLevel == 10,
+            TEXT("violation names the held and acquired levels"));
+        verifyf(bReported && Violation.HeldSite != nullptr && Violation.AcquireSite != nullptr && Violation.HeldSite != Violation.AcquireSite,
+            TEXT("violation keeps both call sites"));
+        verifyf(Inner.IsLockedByCurrentThread(), TEXT("violating acquisition still takes the lock"));
+
+        Inner.Unlock();
+        Outer.Unlock();
+        verifyf(FHierarchicalLock::GetThreadHighestLockLevel() == 0, TEXT("no hierarchical level held after unlocking"));
+
+        // A second violation is counted but does not replace the first
+        FRegistryOperationValidator::AddLockToHistory(ERegistryLockLevel::SDF);
+        FRegistryOperationValidator::AddLockToHistory(ERegistryLockLevel::Service);
+        FRegistryOperationValidator::RemoveLockFromHistory(ERegistryLockLevel::Service);
+        FRegistryOperationValidator::RemoveLockFromHistory(ERegistryLockLevel::SDF);
+
+        FLockOrderViolation First;
+        FLockOrderValidator::GetFirstViolation(First);
+        verifyf(FLockOrderValidator::GetViolationCount() == 2 && First.Domain == ELockOrderDomain::Hierarchical,
+            TEXT("later violations are counted without replacing the first"));
+    }
+
+    // Levels that share a rank are still ordered by their full values
+    {
+        FLockOrderValidator::ResetViolations();
+        verifyf(FLockOrderValidator::GetRank(64) > FLockOrderValidator::GetRank(10), TEXT("a higher level never maps to a lower rank"));
+
+        verifyf(FLockOrderValidator::OnAcquire(ELockOrderDomain::Hierarchical, 120), TEXT("first level in a shared rank is accepted"));
+        verifyf(FLockOrderValidator::OnAcquire(ELockOrderDomain::Hierarchical, 150), TEXT("higher level in the same rank is accepted"));
+        verifyf(!FLockOrderValidator::CanAcquire(ELockOrderDomain::Hierarchical, 130), TEXT("lower level in a held rank is refused"));
+
+        FLockOrderValidator::OnRelease(ELockOrderDomain::Hierarchical, 150);
+        verifyf(FLockOrderValidator::CanAcquire(ELockOrderDomain::Hierarchical, 130), TEXT("released level no longer blocks its rank"));
+        FLockOrderValidator::OnRelease(ELockOrderDomain::Hierarchical, 120);
+
+        verifyf(FLockOrderValidator::GetViolationCount() == 0, TEXT("no violations recorded within a shared rank"));
+    }
+
+    // Cost of one validated acquire/release pair
+    {
+        const int32 Iterations = 10000000;
+        double StartTime = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < Iterations; ++Index)
+        {
+            FLockOrderValidator::OnAcquire(ELockOrderDomain::Registry, static_cast<uint32>(ERegistryLockLevel::Zone));
+            FLockOrderValidator::OnAcquire(ELockOrderDomain::Registry, static_cast<uint32>(ERegistryLockLevel::SDF));
+            FLockOrderValidator::OnRelease(ELockOrderDomain::Registry, static_cast<uint32>(ERegistryLockLevel::SDF));
+            FLockOrderValidator::OnRelease(ELockOrderDomain::Registry, static_cast<uint32>(ERegistryLockLevel::Zone));
+        }
+        double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+        UE_LOG(LogTemp, Display, TEXT("  %.2f ns per validated acquire/release pair"), ElapsedSeconds * 1.0e9 / (Iterations * 2.0));
+    }
+
+    FLockOrderValidator::ResetViolations();
+
+    UE_LOG(LogTemp, Display, TEXT("Lock order validation test completed"));
+}
@@ -0,0 +1,403 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LockProfiler.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformStackWalk.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+
+std::atomic<bool> FLockProfiler::bEnabled(false);
+
+namespace LockProfilerInternal
+{
+    /** Deepest nesting of sampled acquisitions tracked per thread */
+    static constexpr int32 MaxHeldLocks = 32;
+
+    /** Per-thread sample ring; rings are never freed, only recycled when their thread exits */
+    struct FThreadRing
+    {
+        /** Sample storage */
+        FLockProfileSample Samples[FLockProfiler::RingCapacity];
+
+        /** Total samples ever written; the slot is Head % RingCapacity */
+        std::atomic<uint64> Head{0};
+
+        /** Samples before this index were discarded by Reset */
+        std::atomic<uint64> ResetIndex{0};
+
+        /** Whether a live thread owns this ring */
+        std::atomic<bool> bInUse{false};
+
+        /** Next ring in the registry */
+        FThreadRing* Next = nullptr;
+    };
+
+    /** Sampled acquisition waiting for its release */
+    struct FHeldLock
+    {
+        const void* Lock;
+        const void* Site;
+        uint64 WaitCycles;
+        uint64 AcquiredCycles;
+        ELockProfileType Type;
+    };
+
+    /** Profiler state owned by one thread */
+    struct FThreadState
+    {
+        FThreadRing* Ring = nullptr;
+        int32 Countdown = 0;
+        uint32 Generation = 0;
+        const void* SiteOverride = nullptr;
+        int32 HeldCount = 0;
+        FHeldLock Held[MaxHeldLocks];
+
+        ~FThreadState()
+        {
+            if (Ring)
+            {
+                Ring->bInUse.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    /** Head of the ring registry (append only) */
+    static std::atomic<FThreadRing*> Rings(nullptr);
+
+    /** Sampling interval */
+    static std::atomic<int32> SampleEvery(1);
+
+    /** Bumped by Enable so held records from an earlier session are dropped */
+    static std::atomic<uint32> Generation(1);
+
+    static thread_local FThreadState ThreadState;
+
+    static FThreadRing* AcquireRing()
+    {
+        for (FThreadRing* Ring = Rings.load(std::memory_order_acquire); Ring; Ring = Ring->Next)
+        {
+            bool bExpected = false;
+            if (!Ring->bInUse.load(std::memory_order_relaxed) &&
+                Ring->bInUse.compare_exchange_strong(bExpected, true, std::memory_order_acquire))
+            {
+                return Ring;
+            }
+        }
+
+        FThreadRing* Ring = new FThreadRing();
+        Ring->bInUse.store(true, std::memory_order_relaxed);
+
+        FThreadRing* Head = Rings.load(std::memory_order_relaxed);
+        do
+        {
+            Ring->Next = Head;
+        }
+        while (!Rings.compare_exchange_weak(Head, Ring, std::memory_order_release, std::memory_order_relaxed));
+
+        return Ring;
+    }
+
+    /** Key used to merge samples of one lock taken from one site */
+    struct FSiteKey
+    {
+        const void* Lock;
+        const void* Site;
+        ELockProfileType Type;
+
+        bool operator==(const FSiteKey& Other) const
+        {
+            return Lock == Other.Lock && Site == Other.Site && Type == Other.Type;
+        }
+
+        friend uint32 GetTypeHash(const FSiteKey& Key)
+        {
+            return HashCombine(HashCombine(::GetTypeHash(Key.Lock), ::GetTypeHash(Key.Site)), static_cast<uint32>(Key.Type));
+        }
+    };
+}
+
+FString FLockProfiler::GetSiteName(const void* Site)
+{
+    static bool bStackWalkInitialized = FPlatformStackWalk::InitStackWalking();
+
+    ANSICHAR Buffer[1024];
+    Buffer[0] = '\0';
+    if (bStackWalkInitialized &&
+        FPlatformStackWalk::ProgramCounterToHumanReadableString(0, reinterpret_cast<uint64>(Site), Buffer, sizeof(Buffer)) &&
+        Buffer[0] != '\0')
+    {
+        return FString(ANSI_TO_TCHAR(Buffer)).TrimStartAndEnd();
+    }
+
+    return FString::Printf(TEXT("0x%016llx"), reinterpret_cast<uint64>(Site));
+}
+
+void FLockProfiler::Enable(int32 InSampleEvery)
+{
+    LockProfilerInternal::SampleEvery.store(FMath::Max(InSampleEvery, 1), std::memory_order_relaxed);
+    LockProfilerInternal::Generation.fetch_add(1, std::memory_order_relaxed);
+    bEnabled.store(true, std::memory_order_release);
+}
+
+void FLockProfiler::Disable()
+{
+    bEnabled.store(false, std::memory_order_release);
+}
+
+void FLockProfiler::Reset()
+{
+    using namespace LockProfilerInternal;
+
+    for (FThreadRing* Ring = Rings.load(std::memory_order_acquire); Ring; Ring = Ring->Next)
+    {
+        Ring->ResetIndex.store(Ring->Head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+}
+
+uint64 FLockProfiler::BeginAcquireSampled()
+{
+    LockProfilerInternal::FThreadState& State = LockProfilerInternal::ThreadState;
+
+    if (--State.Countdown > 0)
+    {
+        return 0;
+    }
+    State.Countdown = LockProfilerInternal::SampleEvery.load(std::memory_order_relaxed);
+
+    // Zero means "not sampled", so never hand it out as a timestamp
+    return FMath::Max<uint64>(FPlatformTime::Cycles64(), 1);
+}
+
+void FLockProfiler::EndAcquireSampled(uint64 StartCycles, const void* Lock, const void* Site, ELockProfileType Type)
+{
+    using namespace LockProfilerInternal;
+
+    uint64 Now = FPlatformTime::Cycles64();
+    FThreadState& State = ThreadState;
+
+    uint32 CurrentGeneration = Generation.load(std::memory_order_relaxed);
+    if (State.Generation != CurrentGeneration)
+    {
+        State.Generation = CurrentGeneration;
+        State.HeldCount = 0;
+    }
+
+    if (State.HeldCount == MaxHeldLocks)
+    {
+        return;
+    }
+
+    FHeldLock& Held = State.Held[State.HeldCount++];
+    Held.Lock = Lock;
+    Held.Site = State.SiteOverride ? State.SiteOverride : Site;
+    Held.WaitCycles = Now - StartCycles;
+    Held.AcquiredCycles = Now;
+    Held.Type = Type;
+}
+
+void FLockProfiler::ReleaseSampled(const void* Lock)
+{
+    using namespace LockProfilerInternal;
+
+    FThreadState& State = ThreadState;
+    if (State.HeldCount == 0)
+    {
+        return;
+    }
+
+    // Records from before the profiler was last enabled have meaningless hold times
+    if (State.Generation != Generation.load(std::memory_order_relaxed))
+    {
+        State.HeldCount = 0;
+        return;
+    }
+
+    // Locks are almost always released in reverse order, so search from the top
+    for (int32 Index = State.HeldCount - 1; Index >= 0; --Index)
+    {
+        if (State.Held[Index].Lock != Lock)
+        {
+            continue;
+        }
+
+        const FHeldLock& Held = State.Held[Index];
+        if (!State.Ring)
+        {
+            State.Ring = AcquireRing();
+        }
+
+        FThreadRing& Ring = *State.Ring;
+        uint64 Head = Ring.Head.load(std::memory_order_relaxed);
+        FLockProfileSample& Sample = Ring.Samples[Head % RingCapacity];
+        Sample.Lock = Held.Lock;
+        Sample.Site = Held.Site;
+        Sample.WaitCycles = Held.WaitCycles;
+        Sample.HoldCycles = FPlatformTime::Cycles64() - Held.AcquiredCycles;
+        Sample.Type = Held.Type;
+        Ring.Head.store(Head + 1, std::memory_order_release);
+
+        for (int32 Move = Index + 1; Move < State.HeldCount; ++Move)
+        {
+            State.Held[Move - 1] = State.Held[Move];
+        }
+        State.HeldCount--;
+        return;
+    }
+}
+
+bool FLockProfiler::PushSite(const void* Site)
+{
+    LockProfilerInternal::FThreadState& State = LockProfilerInternal::ThreadState;
+    if (State.SiteOverride)
+    {
+        return false;
+    }
+
+    State.SiteOverride = Site;
+    return true;
+}
+
+void FLockProfiler::PopSite()
+{
+    LockProfilerInternal::ThreadState.SiteOverride = nullptr;
+}
+
+TArray<FLockSiteReport> FLockProfiler::BuildReport(int32 MaxEntries)
+{
+    using namespace LockProfilerInternal;
+
+    const double MicrosecondsPerCycle = FPlatformTime::GetSecondsPerCycle64() * 1.0e6;
+    TMap<FSiteKey, FLockSiteReport> Merged;
+    TArray<FLockProfileSample> Copy;
+
+    for (FThreadRing* Ring = Rings.load(std::memory_order_acquire); Ring; Ring = Ring->Next)
+    {
+        // Copy the live window, then drop anything the owner overwrote while we were copying
+        uint64 Head = Ring->Head.load(std::memory_order_acquire);
+        uint64 Start = FMath::Max(Head > RingCapacity ? Head - RingCapacity : 0, Ring->ResetIndex.load(std::memory_order_acquire));
+
+        Copy.Reset();
+        for (uint64 Index = Start; Index < Head; ++Index)
+        {
+            Copy.Add(Ring->Samples[Index % RingCapacity]);
+        }
+
+        // The owner may already be writing the slot of sample HeadAfter, which is also where
+        // sample HeadAfter - RingCapacity lived
+        uint64 HeadAfter = Ring->Head.load(std::memory_order_acquire);
+        uint64 FirstValid = HeadAfter + 1 > RingCapacity ? HeadAfter + 1 - RingCapacity : 0;
+        int32 Skip = static_cast<int32>(FMath::Min<uint64>(FirstValid > Start ? FirstValid - Start : 0, Copy.Num()));
+
+        for (int32 Index = Skip; Index < Copy.Num(); ++Index)
+        {
+            const FLockProfileSample& Sample = Copy[Index];
+            FLockSiteReport& Entry = Merged.FindOrAdd(FSiteKey{ Sample.Lock, Sample.Site, Sample.Type });
+            Entry.Lock = Sample.Lock;
+            Entry.Site = Sample.Site;
+            Entry.Type = Sample.Type;
+            Entry.SampleCount++;
+
+            double WaitUs = Sample.WaitCycles * MicrosecondsPerCycle;
+            double HoldUs = Sample.HoldCycles * MicrosecondsPerCycle;
+            Entry.TotalWaitUs += WaitUs;
+            Entry.MaxWaitUs = FMath::Max(Entry.MaxWaitUs, WaitUs);
+            Entry.TotalHoldUs += HoldUs;
+            Entry.MaxHoldUs = FMath::Max(Entry.MaxHoldUs, HoldUs);
+        }
+    }
+
+    TArray<FLockSiteReport> Report;
+    Merged.GenerateValueArray(Report);
+    Report.Sort([](const FLockSiteReport& A, const FLockSiteReport& B)
+    {
+        return A.TotalWaitUs > B.TotalWaitUs;
+    });
+
+    if (MaxEntries > 0 && Report.Num() > MaxEntries)
+    {
+        Report.SetNum(MaxEntries);
+    }
+
+    // Symbolicate only what is reported
+    for (FLockSiteReport& Entry : Report)
+    {
+        Entry.SiteName = GetSiteName(Entry.Site);
+    }
+
+    return Report;
+}
+
+FString FLockProfiler::FormatReportText(const TArray<FLockSiteReport>& Report)
+{
+    FString Text = FString::Printf(TEXT("Top contended locks by site (1 in %d acquisitions sampled)\n"),
+        LockProfilerInternal::SampleEvery.load(std::memory_order_relaxed));
+    Text += TEXT("Rank  Type    Samples  TotalWait(us)  AvgWait(us)  MaxWait(us)  AvgHold(us)  Lock                Site\n");
+
+    for (int32 Index = 0; Index < Report.Num(); ++Index)
+    {
+        const FLockSiteReport& Entry = Report[Index];
+        double Count = FMath::Max<double>(Entry.SampleCount, 1.0);
+        Text += FString::Printf(TEXT("%4d  %-6s  %7lld  %13.1f  %11.3f  %11.1f  %11.3f  0x%016llx  %s\n"),
+            Index + 1,
+            GetTypeName(Entry.Type),
+            Entry.SampleCount,
+            Entry.TotalWaitUs,
+            Entry.TotalWaitUs / Count,
+            Entry.MaxWaitUs,
+            Entry.TotalHoldUs / Count,
+            reinterpret_cast<uint64>(Entry.Lock),
+            *Entry.SiteName);
+    }
+
+    return Text;
+}
+
+FString FLockProfiler::FormatReportJson(const TArray<FLockSiteReport>& Report)
+{
+    TSharedPtr<FJsonObject> RootObject = MakeShareable(new FJsonObject);
+    RootObject->SetNumberField(TEXT("SampleEvery"), LockProfilerInternal::SampleEvery.load(std::memory_order_relaxed));
+
+    TArray<TSharedPtr<FJsonValue>> EntryArray;
+    for (int32 Index = 0; Index < Report.Num(); ++Index)
+    {
+        const FLockSiteReport& Entry = Report[Index];
+        TSharedPtr<FJsonObject> EntryObject = MakeShareable(new FJsonObject);
+        EntryObject->SetNumberField(TEXT("Rank"), Index + 1);
+        EntryObject->SetStringField(TEXT("Type"), GetTypeName(Entry.Type));
+        EntryObject->SetStringField(TEXT("Lock"), FString::Printf(TEXT("0x%016llx"), reinterpret_cast<uint64>(Entry.Lock)));
+        EntryObject->SetStringField(TEXT("Site"), Entry.SiteName);
+        EntryObject->SetNumberField(TEXT("Samples"), static_cast<double>(Entry.SampleCount));
+        EntryObject->SetNumberField(TEXT("TotalWaitUs"), Entry.TotalWaitUs);
+        EntryObject->SetNumberField(TEXT("MaxWaitUs"), Entry.MaxWaitUs);
+        EntryObject->SetNumberField(TEXT("TotalHoldUs"), Entry.TotalHoldUs);
+        EntryObject->SetNumberField(TEXT("MaxHoldUs"), Entry.MaxHoldUs);
+        EntryArray.Add(MakeShareable(new FJsonValueObject(EntryObject)));
+    }
+    RootObject->SetArrayField(TEXT("Entries"), EntryArray);
+
+    FString OutputString;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+    FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer);
+
+    return OutputString;
+}
+
+const TCHAR* FLockProfiler::GetTypeName(ELockProfileType Type)
+{
+    switch (Type)
+    {
+        case ELockProfileType::Hybrid:
+            return TEXT("Hybrid");
+        case ELockProfileType::NUMASpin:
+            return TEXT("NUMA");
+        case ELockProfileType::Zone:
+            return TEXT("Zone");
+        case ELockProfileType::Read:
+            return TEXT("Read");
+        case ELockProfileType::Write:
+            return TEXT("Write");
+    }
+
+    return TEXT("Unknown");
+}
@@ -2,10 +2,54 @@
 
 #include "TaskDependencyVisualizer.h"
 #include "TaskScheduler.h"
+#include "TaskTraceRecorder.h"
+#include "EpochManager.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "Misc/DateTime.h"
 
+namespace TaskDependencyVisualizerInternal
+{
+    /** Escapes a string for use inside a JSON string literal */
+    FString EscapeJsonString(const FString& Value)
+    {
+        FString Result;
+        Result.Reserve(Value.Len());
+        for (TCHAR Character : Value)
+        {
+            switch (Character)
+            {
+                case TEXT('"'):
+                    Result += TEXT("\\\"");
+                    break;
+                case TEXT('\\'):
+                    Result += TEXT("\\\\");
+                    break;
+                case TEXT('\n'):
+                    Result += TEXT("\\n");
+                    break;
+                case TEXT('\r'):
+                    Result += TEXT("\\r");
+                    break;
+                case TEXT('\t'):
+                    Result += TEXT("\\t");
+                    break;
+                default:
+                    if (Character < 0x20)
+                    {
+                        Result += FString::Printf(TEXT("\\u%04x"), static_cast<uint32>(Character));
+                    }
+                    else
+                    {
+                        Result.AppendChar(Character);
+                    }
+                    break;
+            }
+        }
+        return Result;
+    }
+}
+
 // Initialize static instance to nullptr
 FTaskDependencyVisualizer* FTaskDependencyVisualizer::Instance = nullptr;
 
@@ -368,7 +412,7 @@ FString FTaskDependencyVisualizer::GenerateJSONVisualization(const TArray<FTaskD
         
         Result += TEXT("    {\n");
         Result += FString::Printf(TEXT("      \"id\": %llu,\n"), Node.TaskId);
-        Result += FString::Printf(TEXT("      \"description\": \"%s\",\n"), *Node.Description.Replace(TEXT("\""), TEXT("\\\"")));
+        Result += FString::Printf(TEXT("      \"description\": \"%s\",\n"), *TaskDependencyVisualizerInternal::EscapeJsonString(Node.Description));
         Result += FString::Printf(TEXT("      \"status\": \"%s\",\n"),
             *StaticEnum<ETaskStatus>()->GetNameStringByValue(static_cast<int64>(Node.Status)));
         Result += FString::Printf(TEXT("      \"priority\": \"%s\",\n"),
@@ -635,6 +679,487 @@ FString FTaskDependencyVisualizer::GenerateTextVisualization(const TArray<FTaskD
     return Result;
 }
 
+FString FTaskDependencyVisualizer::ExportChromeTrace()
+{
+    TArray<FTaskTraceEvent> Events = FTaskTraceRecorder::CollectEvents();
+    
+    TMap<uint64, FString> TaskNames = GetTraceTaskNames(Events);
+    
+    TSet<uint64> CriticalPath;
+    CriticalPath.Append(AnalyzeCriticalPath(Events, TArray<int32>(), TaskNames).CriticalPath);
+    
+    for (TPair<uint64, FString>& Pair : TaskNames)
+    {
+        Pair.Value = TaskDependencyVisualizerInternal::EscapeJsonString(Pair.Value);
+    }
+    
+    // Timestamps are microseconds from the first enqueue
+    double Origin = DBL_MAX;
+    TMap<uint64, int32> EventIndexById;
+    TSet<int32> Workers;
+    for (int32 i = 0; i < Events.Num(); ++i)
+    {
+        Origin = FMath::Min(Origin, Events[i].EnqueueTime);
+        EventIndexById.Add(Events[i].TaskId, i);
+        Workers.Add(Events[i].WorkerId);
+    }
+    auto ToMicroseconds = [Origin](double Seconds)
+    {
+        return (Seconds - Origin) * 1.0e6;
+    };
+    
+    TArray<FString> TraceEvents;
+    
+    for (int32 WorkerId : Workers)
+    {
+        TraceEvents.Add(FString::Printf(TEXT("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"Worker %d\"}}"),
+            WorkerId, WorkerId));
+        TraceEvents.Add(FString::Printf(TEXT("{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"sort_index\":%d}}"),
+            WorkerId, WorkerId));
+    }
+    
+    int32 FlowId = 0;
+    for (const FTaskTraceEvent& Event : Events)
+    {
+        const bool bCritical = CriticalPath.Contains(Event.TaskId);
+        const FString* Name = TaskNames.Find(Event.TaskId);
+        FString TaskName = Name ? *Name : FString::Printf(TEXT("Task %llu"), Event.TaskId);
+        
+        // Task slice on its worker's track
+        FString Slice = FString::Printf(TEXT("{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f"),
+            *TaskName,
+            *StaticEnum<ETaskType>()->GetNameStringByValue(static_cast<int64>(Event.Type)),
+            Event.WorkerId,
+            ToMicroseconds(Event.StartTime),
+            (Event.EndTime - Event.StartTime) * 1.0e6);
+        if (bCritical)
+        {
+            Slice += TEXT(",\"cname\":\"terrible\"");
+        }
+        else if (!Event.bSucceeded)
+        {
+            Slice += TEXT(",\"cname\":\"bad\"");
+        }
+        Slice += FString::Printf(TEXT(",\"args\":{\"id\":%llu,\"priority\":\"%s\",\"queueUs\":%.3f,\"succeeded\":%s,\"criticalPath\":%s,\"dependencies\":%d}}"),
+            Event.TaskId,
+            *StaticEnum<ETaskPriority>()->GetNameStringByValue(static_cast<int64>(Event.Priority)),
+            (Event.StartTime - Event.EnqueueTime) * 1.0e6,
+            Event.bSucceeded ? TEXT("true") : TEXT("false"),
+            bCritical ? TEXT("true") : TEXT("false"),
+            Event.Dependencies.Num());
+        TraceEvents.Add(Slice);
+        
+        // Flow arrow from the end of each recorded dependency into this task
+        for (uint64 DependencyId : Event.Dependencies)
+        {
+            const int32* Found = EventIndexById.Find(DependencyId);
+            if (!Found)
+            {
+                continue;
+            }
+            
+            const FTaskTraceEvent& Dependency = Events[*Found];
+            const TCHAR* Category = (bCritical && CriticalPath.Contains(Dependency.TaskId)) ? TEXT("critical") : TEXT("dependency");
+            
+            // Flow points bind to the enclosing slice, so nudge them inside the slice bounds
+            double FlowStart = FMath::Max(ToMicroseconds(Dependency.EndTime) - 0.001, ToMicroseconds(Dependency.StartTime));
+            double FlowEnd = ToMicroseconds(Event.StartTime);
+            
+            FlowId++;
+            TraceEvents.Add(FString::Printf(TEXT("{\"name\":\"dependency\",\"cat\":\"%s\",\"ph\":\"s\",\"id\":%d,\"pid\":1,\"tid\":%d,\"ts\":%.3f}"),
+                Category, FlowId, Dependency.WorkerId, FlowStart));
+            TraceEvents.Add(FString::Printf(TEXT("{\"name\":\"dependency\",\"cat\":\"%s\",\"ph\":\"f\",\"bp\":\"e\",\"id\":%d,\"pid\":1,\"tid\":%d,\"ts\":%.3f}"),
+                Category, FlowId, Event.WorkerId, FlowEnd));
+        }
+    }
+    
+    FString Result = TEXT("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    Result += FString::Join(TraceEvents, TEXT(",\n"));
+    Result += TEXT("\n]}\n");
+    
+    return Result;
+}
+
+TMap<uint64, FString> FTaskDependencyVisualizer::GetTraceTaskNames(const TArray<FTaskTraceEvent>& Events) const
+{
+    TMap<uint64, FString> TaskNames;
+    
+    // Completed tasks are retired through the epoch manager, so stay pinned while reading them
+    FEpochGuard Guard;
+    TMap<uint64, FMiningTask*> AllTasks = static_cast<FTaskScheduler&>(FTaskScheduler::Get()).GetAllTasks();
+    for (const FTaskTraceEvent& Event : Events)
+    {
+        FMiningTask** Task = AllTasks.Find(Event.TaskId);
+        if (Task && !(*Task)->Description.IsEmpty())
+        {
+            TaskNames.Add(Event.TaskId, (*Task)->Description);
+        }
+    }
+    
+    return TaskNames;
+}
+
+FCriticalPathReport FTaskDependencyVisualizer::AnalyzeCriticalPath(const TArray<FTaskTraceEvent>& Events, const TArray<int32>& WorkerCounts,
+    const TMap<uint64, FString>& TaskNames)
+{
+    FCriticalPathReport Report;
+    if (Events.Num() == 0)
+    {
+        return Report;
+    }
+    
+    // A task whose dependency IDs were overwritten cannot be placed in the graph, so leave it out
+    // rather than treat it as having no dependencies
+    TArray<FTaskTraceEvent> CompleteEvents = Events.FilterByPredicate([](const FTaskTraceEvent& Event)
+    {
+        return Event.bDependenciesComplete;
+    });
+    if (CompleteEvents.Num() < Events.Num())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Critical path analysis: ignoring %d tasks whose dependencies were not fully recorded"),
+            Events.Num() - CompleteEvents.Num());
+        return AnalyzeCriticalPath(CompleteEvents, WorkerCounts, TaskNames);
+    }
+        
+    const int32 TaskCount = Events.Num();
+    TMap<uint64, int32> IndexById;
+    for (int32 i = 0; i < TaskCount; ++i)
+    {
+        IndexById.Add(Events[i].TaskId, i);
+    }
+    
+    // Dependency edges within the frame; dependencies outside it finished before the frame began
+    TArray<TArray<int32>> Predecessors;
+    TArray<TArray<int32>> Successors;
+    Predecessors.SetNum(TaskCount);
+    Successors.SetNum(TaskCount);
+    
+    TSet<int32> Workers;
+    double FrameStart = DBL_MAX;
+    double FrameEnd = -DBL_MAX;
+    
+    for (int32 i = 0; i < TaskCount; ++i)
+    {
+        const FTaskTraceEvent& Event = Events[i];
+        for (uint64 DependencyId : Event.Dependencies)
+        {
+            const int32* Found = IndexById.Find(DependencyId);
+            if (Found && *Found != i)
+            {
+                Predecessors[i].AddUnique(*Found);
+                Successors[*Found].AddUnique(i);
+            }
+        }
+        
+        Workers.Add(Event.WorkerId);
+        FrameStart = FMath::Min(FrameStart, Event.StartTime);
+        FrameEnd = FMath::Max(FrameEnd, Event.EndTime);
+    }
+    
+    // Topological order (Kahn); anything left on a cycle is appended with its remaining edges ignored
+    TArray<int32> Order;
+    Order.Reserve(TaskCount);
+    TArray<int32> PendingPredecessors;
+    PendingPredecessors.SetNum(TaskCount);
+    for (int32 i = 0; i < TaskCount; ++i)
+    {
+        PendingPredecessors[i] = Predecessors[i].Num();
+        if (PendingPredecessors[i] == 0)
+        {
+            Order.Add(i);
+        }
+    }
+    for (int32 Cursor = 0; Cursor < Order.Num(); ++Cursor)
+    {
+        for (int32 Successor : Successors[Order[Cursor]])
+        {
+            if (--PendingPredecessors[Successor] == 0)
+            {
+                Order.Add(Successor);
+            }
+        }
+    }
+    if (Order.Num() < TaskCount)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Critical path analysis: %d tasks are on dependency cycles; their ordering is approximate"),
+            TaskCount - Order.Num());
+        for (int32 i = 0; i < TaskCount; ++i)
+        {
+            if (PendingPredecessors[i] > 0)
+            {
+                Order.Add(i);
+            }
+        }
+    }
+    
+    TArray<double> Duration;
+    TArray<double> EarliestStart;
+    TArray<double> LatestStart;
+    Duration.SetNum(TaskCount);
+    EarliestStart.Init(0.0, TaskCount);
+    LatestStart.Init(0.0, TaskCount);
+    
+    for (int32 i = 0; i < TaskCount; ++i)
+    {
+        Duration[i] = FMath::Max(Events[i].EndTime - Events[i].StartTime, 0.0) * 1000.0;
+        Report.TotalWorkMs += Duration[i];
+    }
+    
+    // Forward pass: earliest start is the latest earliest finish among the predecessors
+    for (int32 Node : Order)
+    {
+        for (int32 Predecessor : Predecessors[Node])
+        {
+            EarliestStart[Node] = FMath::Max(EarliestStart[Node], EarliestStart[Predecessor] + Duration[Predecessor]);
+        }
+        Report.SpanMs = FMath::Max(Report.SpanMs, EarliestStart[Node] + Duration[Node]);
+    }
+    
+    // Backward pass: latest finish is the earliest latest start among the successors
+    for (int32 OrderIndex = Order.Num() - 1; OrderIndex >= 0; --OrderIndex)
+    {
+        const int32 Node = Order[OrderIndex];
+        double LatestFinish = Report.SpanMs;
+        for (int32 Successor : Successors[Node])
+        {
+            LatestFinish = FMath::Min(LatestFinish, LatestStart[Successor]);
+        }
+        LatestStart[Node] = LatestFinish - Duration[Node];
+    }
+    
+    // Critical path: from the task that ends the span, back through the predecessor that gated it
+    const double Tolerance = FMath::Max(Report.SpanMs * 1.0e-9, 1.0e-9);
+    TSet<int32> CriticalSet;
+    int32 Current = INDEX_NONE;
+    for (int32 Node : Order)
+    {
+        if (Current == INDEX_NONE || EarliestStart[Node] + Duration[Node] > EarliestStart[Current] + Duration[Current])
+        {
+            Current = Node;
+        }
+    }
+    while (Current != INDEX_NONE && !CriticalSet.Contains(Current))
+    {
+        CriticalSet.Add(Current);
+        Report.CriticalPath.Insert(Events[Current].TaskId, 0);
+        
+        int32 Gating = INDEX_NONE;
+        for (int32 Predecessor : Predecessors[Current])
+        {
+            const double Finish = EarliestStart[Predecessor] + Duration[Predecessor];
+            if (FMath::Abs(Finish - EarliestStart[Current]) <= Tolerance &&
+                (Gating == INDEX_NONE || Finish > EarliestStart[Gating] + Duration[Gating]))
+            {
+                Gating = Predecessor;
+            }
+        }
+        Current = Gating;
+    }
+    
+    Report.Tasks.Reserve(TaskCount);
+    for (int32 Node : Order)
+    {
+        const FTaskTraceEvent& Event = Events[Node];
+        FTaskSlackInfo& Info = Report.Tasks.AddDefaulted_GetRef();
+        
+        const FString* Name = TaskNames.Find(Event.TaskId);
+        Info.TaskId = Event.TaskId;
+        Info.Description = Name ? *Name : FString::Printf(TEXT("Task %llu"), Event.TaskId);
+        Info.WorkerId = Event.WorkerId;
+        Info.DurationMs = Duration[Node];
+        Info.EarliestStartMs = EarliestStart[Node];
+        Info.LatestStartMs = LatestStart[Node];
+        Info.SlackMs = FMath::Max(LatestStart[Node] - EarliestStart[Node], 0.0);
+        Info.bOnCriticalPath = CriticalSet.Contains(Node);
+        for (int32 Predecessor : Predecessors[Node])
+        {
+            Info.Dependencies.Add(Events[Predecessor].TaskId);
+        }
+    }
+    
+    Report.Parallelism = (Report.SpanMs > 0.0) ? Report.TotalWorkMs / Report.SpanMs : 0.0;
+    Report.ObservedMakespanMs = (FrameEnd - FrameStart) * 1000.0;
+    Report.ObservedWorkerCount = Workers.Num();
+    
+    // Work/span bounds: no schedule beats max(T1/P, Tinf) and any greedy one achieves T1/P + Tinf
+    TArray<int32> Counts = WorkerCounts;
+    if (Counts.Num() == 0)
+    {
+        Counts = { 1, 2, 4, 8, 16, 32, 64 };
+    }
+    for (int32 WorkerCount : Counts)
+    {
+        if (WorkerCount <= 0)
+        {
+            continue;
+        }
+        
+        FWorkerScalingEstimate& Estimate = Report.Scaling.AddDefaulted_GetRef();
+        Estimate.WorkerCount = WorkerCount;
+        Estimate.BestMakespanMs = FMath::Max(Report.TotalWorkMs / WorkerCount, Report.SpanMs);
+        Estimate.GreedyMakespanMs = Report.TotalWorkMs / WorkerCount + Report.SpanMs;
+        Estimate.BestSpeedup = (Estimate.BestMakespanMs > 0.0) ? Report.TotalWorkMs / Estimate.BestMakespanMs : 0.0;
+        Estimate.GreedySpeedup = (Estimate.GreedyMakespanMs > 0.0) ? Report.TotalWorkMs / Estimate.GreedyMakespanMs : 0.0;
+    }
+    
+    return Report;
+}
+
+FString FTaskDependencyVisualizer::VisualizeCriticalPath(const FCriticalPathReport& Report, EVisualizationFormat Format)
+{
+    if (Format == EVisualizationFormat::DOT)
+    {
+        FString Result = TEXT("digraph CriticalPath {\n");
+        Result += TEXT("  rankdir=LR;\n");
+        Result += TEXT("  node [shape=box, style=filled, fontname=\"Arial\"];\n");
+        Result += FString::Printf(TEXT("  label=\"Work %.2f ms, span %.2f ms, parallelism %.2f, observed %.2f ms on %d workers\";\n"),
+            Report.TotalWorkMs, Report.SpanMs, Report.Parallelism, Report.ObservedMakespanMs, Report.ObservedWorkerCount);
+        
+        TSet<uint64> CriticalSet;
+        CriticalSet.Append(Report.CriticalPath);
+        
+        for (const FTaskSlackInfo& Task : Report.Tasks)
+        {
+            // Critical tasks are red; the rest fade from orange to white as slack grows
+            FString Color = TEXT("#FF6666");
+            if (!Task.bOnCriticalPath)
+            {
+                const double SlackFraction = (Report.SpanMs > 0.0) ? FMath::Clamp(Task.SlackMs / Report.SpanMs, 0.0, 1.0) : 1.0;
+                const int32 Channel = 0xB0 + static_cast<int32>(SlackFraction * 0x4F);
+                Color = FString::Printf(TEXT("#FF%02X%02X"), Channel, Channel);
+            }
+            
+            Result += FString::Printf(TEXT("  \"%llu\" [label=\"%llu: %s\\nDuration: %.2f ms\\nSlack: %.2f ms\\nWorker %d\", fillcolor=\"%s\"%s];\n"),
+                Task.TaskId, Task.TaskId, *Task.Description.Replace(TEXT("\""), TEXT("\\\"")),
+                Task.DurationMs, Task.SlackMs, Task.WorkerId, *Color,
+                Task.bOnCriticalPath ? TEXT(", penwidth=3") : TEXT(""));
+        }
+        
+        for (const FTaskSlackInfo& Task : Report.Tasks)
+        {
+            for (uint64 Dependency : Task.Dependencies)
+            {
+                const bool bCriticalEdge = Task.bOnCriticalPath && CriticalSet.Contains(Dependency) &&
+                    Report.CriticalPath.IndexOfByKey(Dependency) + 1 == Report.CriticalPath.IndexOfByKey(Task.TaskId);
+                Result += FString::Printf(TEXT("  \"%llu\" -> \"%llu\" [color=%s%s];\n"),
+                    Dependency, Task.TaskId,
+                    bCriticalEdge ? TEXT("red") : TEXT("gray"),
+                    bCriticalEdge ? TEXT(", penwidth=3") : TEXT(""));
+            }
+        }
+        
+        Result += TEXT("}\n");
+        return Result;
+    }
+    
+    if (Format == EVisualizationFormat::JSON)
+    {
+        FString Result = TEXT("{\n");
+        Result += FString::Printf(TEXT("  \"totalWorkMs\": %.4f,\n"), Report.TotalWorkMs);
+        Result += FString::Printf(TEXT("  \"spanMs\": %.4f,\n"), Report.SpanMs);
+        Result += FString::Printf(TEXT("  \"parallelism\": %.4f,\n"), Report.Parallelism);
+        Result += FString::Printf(TEXT("  \"observedMakespanMs\": %.4f,\n"), Report.ObservedMakespanMs);
+        Result += FString::Printf(TEXT("  \"observedWorkerCount\": %d,\n"), Report.ObservedWorkerCount);
+        
+        TArray<FString> PathIds;
+        for (uint64 TaskId : Report.CriticalPath)
+        {
+            PathIds.Add(FString::Printf(TEXT("%llu"), TaskId));
+        }
+        Result += FString::Printf(TEXT("  \"criticalPath\": [%s],\n"), *FString::Join(PathIds, TEXT(", ")));
+        
+        TArray<FString> Estimates;
+        for (const FWorkerScalingEstimate& Estimate : Report.Scaling)
+        {
+            Estimates.Add(FString::Printf(TEXT("    { \"workers\": %d, \"bestMakespanMs\": %.4f, \"greedyMakespanMs\": %.4f, \"bestSpeedup\": %.4f, \"greedySpeedup\": %.4f }"),
+                Estimate.WorkerCount, Estimate.BestMakespanMs, Estimate.GreedyMakespanMs, Estimate.BestSpeedup, Estimate.GreedySpeedup));
+        }
+        Result += FString::Printf(TEXT("  \"scaling\": [\n%s\n  ],\n"), *FString::Join(Estimates, TEXT(",\n")));
+        
+        TArray<FString> Tasks;
+        for (const FTaskSlackInfo& Task : Report.Tasks)
+        {
+            TArray<FString> DependencyIds;
+            for (uint64 Dependency : Task.Dependencies)
+            {
+                DependencyIds.Add(FString::Printf(TEXT("%llu"), Dependency));
+            }
+            Tasks.Add(FString::Printf(TEXT("    { \"id\": %llu, \"description\": \"%s\", \"worker\": %d, \"durationMs\": %.4f, \"earliestStartMs\": %.4f, \"latestStartMs\": %.4f, \"slackMs\": %.4f, \"critical\": %s, \"dependencies\": [%s] }"),
+                Task.TaskId, *TaskDependencyVisualizerInternal::EscapeJsonString(Task.Description),
+                Task.WorkerId, Task.DurationMs, Task.EarliestStartMs, Task.LatestStartMs, Task.SlackMs,
+                Task.bOnCriticalPath ? TEXT("true") : TEXT("false"), *FString::Join(DependencyIds, TEXT(", "))));
+        }
+        Result += FString::Printf(TEXT("  \"tasks\": [\n%s\n  ]\n"), *FString::Join(Tasks, TEXT(",\n")));
+        Result += TEXT("}\n");
+        return Result;
+    }
+    
+    if (Format != EVisualizationFormat::Text)
+    {
+        return TEXT("Unsupported visualization format");
+    }
+    
+    FString Result = TEXT("Critical Path Analysis\n");
+    Result += TEXT("======================\n\n");
+    Result += FString::Printf(TEXT("Tasks: %d\n"), Report.Tasks.Num());
+    Result += FString::Printf(TEXT("Total work: %.2f ms\n"), Report.TotalWorkMs);
+    Result += FString::Printf(TEXT("Span (critical path): %.2f ms\n"), Report.SpanMs);
+    Result += FString::Printf(TEXT("Parallelism (work / span): %.2f\n"), Report.Parallelism);
+    Result += FString::Printf(TEXT("Observed frame: %.2f ms on %d workers\n\n"), Report.ObservedMakespanMs, Report.ObservedWorkerCount);
+    
+    // The span is what the frame would take with unlimited workers
+    if (Report.ObservedWorkerCount > 0 && Report.SpanMs > 0.0)
+    {
+        if (Report.Parallelism <= Report.ObservedWorkerCount || Report.ObservedMakespanMs <= Report.SpanMs * 1.1)
+        {
+            Result += TEXT("Verdict: the frame is bound by its critical path; more workers will not help, shorten the critical tasks.\n\n");
+        }
+        else
+        {
+            Result += FString::Printf(TEXT("Verdict: up to %.2f ms could be recovered with more workers (parallelism %.2f > %d workers).\n\n"),
+                Report.ObservedMakespanMs - Report.SpanMs, Report.Parallelism, Report.ObservedWorkerCount);
+        }
+    }
+    
+    Result += TEXT("Workers | Best frame ms | Greedy frame ms | Best speedup | Greedy speedup\n");
+    for (const FWorkerScalingEstimate& Estimate : Report.Scaling)
+    {
+        Result += FString::Printf(TEXT("%7d | %13.2f | %15.2f | %12.2f | %14.2f\n"),
+            Estimate.WorkerCount, Estimate.BestMakespanMs, Estimate.GreedyMakespanMs, Estimate.BestSpeedup, Estimate.GreedySpeedup);
+    }
+    
+    Result += TEXT("\nCritical path:\n");
+    for (const FTaskSlackInfo& Task : Report.Tasks)
+    {
+        if (Task.bOnCriticalPath)
+        {
+            Result += FString::Printf(TEXT("  %llu: %s  (%.2f ms, starts at %.2f ms)\n"),
+                Task.TaskId, *Task.Description, Task.DurationMs, Task.EarliestStartMs);
+        }
+    }
+    
+    TArray<const FTaskSlackInfo*> BySlack;
+    for (const FTaskSlackInfo& Task : Report.Tasks)
+    {
+        BySlack.Add(&Task);
+    }
+    BySlack.Sort([](const FTaskSlackInfo& A, const FTaskSlackInfo& B)
+    {
+        return A.SlackMs < B.SlackMs || (A.SlackMs == B.SlackMs && A.DurationMs > B.DurationMs);
+    });
+    
+    Result += TEXT("\nTasks by slack:\n");
+    Result += TEXT("      Task | Duration ms | Slack ms | Worker | Description\n");
+    for (const FTaskSlackInfo* Task : BySlack)
+    {
+        Result += FString::Printf(TEXT("%10llu | %11.2f | %8.2f | %6d | %s%s\n"),
+            Task->TaskId, Task->DurationMs, Task->SlackMs, Task->WorkerId, *Task->Description,
+            Task->bOnCriticalPath ? TEXT(" [critical]") : TEXT(""));
+    }
+    
+    return Result;
+}
+
 FString FTaskDependencyVisualizer::GetStatusColor(ETaskStatus Status) const
 {
     switch (Status)
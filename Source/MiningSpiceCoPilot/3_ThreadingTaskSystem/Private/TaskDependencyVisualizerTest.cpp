@@ -2,11 +2,81 @@
 
 #include "TaskDependencyVisualizer.h"
 #include "TaskScheduler.h"
+#include "TaskTraceRecorder.h"
 #include "HAL/FileManager.h"
 #include "Misc/Paths.h"
 #include "Misc/CommandLine.h"
 #include "Templates/Function.h"
 
+/**
+ * Checks AnalyzeCriticalPath against a hand-built frame with known durations and dependencies
+ *
+ *   Worker 0: A (2 ms) -> B (3 ms) -> D (2 ms)
+ *   Worker 1: E (1 ms)    C (1 ms, after A; D also waits for it)
+ *
+ * The span is A-B-D at 7 ms out of 9 ms of work, C has 2 ms of slack and the independent E has 6 ms.
+ */
+static void TestCriticalPathAnalysis(FTaskDependencyVisualizer& Visualizer)
+{
+    TArray<FTaskTraceEvent> Events;
+    auto AddEvent = [&Events](uint64 TaskId, double StartMs, double EndMs, int32 WorkerId, const TArray<uint64>& Dependencies)
+    {
+        FTaskTraceEvent& Event = Events.AddDefaulted_GetRef();
+        Event.TaskId = TaskId;
+        Event.EnqueueTime = 0.0;
+        Event.StartTime = StartMs / 1000.0;
+        Event.EndTime = EndMs / 1000.0;
+        Event.WorkerId = WorkerId;
+        Event.Type = ETaskType::General;
+        Event.Priority = ETaskPriority::Normal;
+        Event.bSucceeded = true;
+        Event.bDependenciesComplete = true;
+        Event.Dependencies = Dependencies;
+    };
+    AddEvent(1, 0.0, 2.0, 0, {});
+    AddEvent(2, 2.0, 5.0, 0, { 1 });
+    AddEvent(3, 2.0, 3.0, 1, { 1 });
+    AddEvent(4, 5.0, 7.0, 0, { 2, 3 });
+    AddEvent(5, 0.0, 1.0, 1, {});
+    
+    // Names are passed in, so the analysis needs no live scheduler
+    TMap<uint64, FString> TaskNames;
+    TaskNames.Add(1, TEXT("A"));
+    
+    const double Tolerance = 1.0e-6;
+    FCriticalPathReport Report = Visualizer.AnalyzeCriticalPath(Events, { 1, 2, 4 }, TaskNames);
+    verifyf(FMath::IsNearlyEqual(Report.SpanMs, 7.0, Tolerance) && FMath::IsNearlyEqual(Report.TotalWorkMs, 9.0, Tolerance),
+        TEXT("span is the longest dependency chain and work is the sum of durations"));
+    verifyf(FMath::IsNearlyEqual(Report.ObservedMakespanMs, 7.0, Tolerance) && Report.ObservedWorkerCount == 2,
+        TEXT("the observed makespan and worker count come from the timestamps"));
+    verifyf(Report.CriticalPath == TArray<uint64>({ 1, 2, 4 }), TEXT("the critical path runs A, B, D in order"));
+    
+    const double ExpectedSlack[] = { 0.0, 0.0, 0.0, 2.0, 0.0, 6.0 };
+    bool bSlackMatches = Report.Tasks.Num() == 5;
+    for (const FTaskSlackInfo& Info : Report.Tasks)
+    {
+        bSlackMatches &= FMath::IsNearlyEqual(Info.SlackMs, ExpectedSlack[Info.TaskId], Tolerance) &&
+            Info.bOnCriticalPath == (Info.SlackMs <= Tolerance);
+    }
+    verifyf(bSlackMatches, TEXT("each task's slack matches the hand-computed value and only zero-slack tasks are critical"));
+    
+    const FTaskSlackInfo* First = Report.Tasks.FindByPredicate([](const FTaskSlackInfo& Info) { return Info.TaskId == 1; });
+    const FTaskSlackInfo* Last = Report.Tasks.FindByPredicate([](const FTaskSlackInfo& Info) { return Info.TaskId == 5; });
+    verifyf(First && First->Description == TEXT("A") && Last && Last->Description == TEXT("Task 5"),
+        TEXT("given names are used and unnamed tasks fall back to their ID"));
+    
+    // Best is max(work / workers, span) and greedy is work / workers + span
+    const double ExpectedBest[] = { 9.0, 7.0, 7.0 };
+    const double ExpectedGreedy[] = { 16.0, 11.5, 9.25 };
+    bool bBoundsMatch = Report.Scaling.Num() == 3;
+    for (int32 Index = 0; bBoundsMatch && Index < Report.Scaling.Num(); ++Index)
+    {
+        bBoundsMatch &= FMath::IsNearlyEqual(Report.Scaling[Index].BestMakespanMs, ExpectedBest[Index], Tolerance) &&
+            FMath::IsNearlyEqual(Report.Scaling[Index].GreedyMakespanMs, ExpectedGreedy[Index], Tolerance);
+    }
+    verifyf(bBoundsMatch, TEXT("the best and greedy bounds follow from work and span"));
+}
+
 /**
  * Test program for the task dependency visualizer
  * Creates a sample task graph and generates visualizations in different formats
@@ -20,6 +90,12 @@ void TestTaskDependencyVisualizer()
     // Create a task dependency visualizer
     FTaskDependencyVisualizer* Visualizer = new FTaskDependencyVisualizer();
     
+    TestCriticalPathAnalysis(*Visualizer);
+    
+    // Record the task timeline for the Chrome trace export
+    FTaskTraceRecorder::Reset();
+    FTaskTraceRecorder::Enable();
+    
     // Output directory for visualizations
     FString OutputDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("TaskVisualizations"));
     IFileManager::Get().MakeDirectory(*OutputDir, true);
@@ -186,6 +262,24 @@ void TestTaskDependencyVisualizer()
     
     Scheduler->WaitForTasks(AllTaskIds, true, 5000);
     
+    // Export the recorded timeline for chrome://tracing or ui.perfetto.dev
+    FTaskTraceRecorder::Disable();
+    FString ChromeTrace = Visualizer->ExportChromeTrace();
+    FString ChromeTraceFilename = FPaths::Combine(OutputDir, TEXT("TaskTimeline.json"));
+    Visualizer->SaveVisualization(ChromeTraceFilename, ChromeTrace, EVisualizationFormat::JSON);
+    
+    // Critical path, slack and work/span scaling of the recorded frame
+    TArray<FTaskTraceEvent> RecordedEvents = FTaskTraceRecorder::CollectEvents();
+    FCriticalPathReport CriticalPathReport = Visualizer->AnalyzeCriticalPath(RecordedEvents, TArray<int32>(), Visualizer->GetTraceTaskNames(RecordedEvents));
+    FString CriticalPathText = Visualizer->VisualizeCriticalPath(CriticalPathReport, EVisualizationFormat::Text);
+    FString CriticalPathTextFilename = FPaths::Combine(OutputDir, TEXT("CriticalPath.txt"));
+    Visualizer->SaveVisualization(CriticalPathTextFilename, CriticalPathText, EVisualizationFormat::Text);
+    FString CriticalPathDot = Visualizer->VisualizeCriticalPath(CriticalPathReport, EVisualizationFormat::DOT);
+    FString CriticalPathDotFilename = FPaths::Combine(OutputDir, TEXT("CriticalPath.dot"));
+    Visualizer->SaveVisualization(CriticalPathDotFilename, CriticalPathDot, EVisualizationFormat::DOT);
+    UE_LOG(LogTemp, Display, TEXT("Recorded frame: work %.2f ms, span %.2f ms, parallelism %.2f"),
+        CriticalPathReport.TotalWorkMs, CriticalPathReport.SpanMs, CriticalPathReport.Parallelism);
+
     // Generate visualizations again after tasks have completed
     FString CompletedDotVisualization = Visualizer->VisualizeAllTasks(Options, EVisualizationFormat::DOT);
     FString CompletedDotFilename = FPaths::Combine(OutputDir, TEXT("TaskGraph_Completed.dot"));
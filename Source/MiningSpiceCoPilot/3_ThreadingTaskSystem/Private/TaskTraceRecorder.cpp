@@ -0,0 +1,225 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TaskTraceRecorder.h"
+#include "TaskScheduler.h"
+
+std::atomic<bool> FTaskTraceRecorder::bEnabled(false);
+
+namespace TaskTraceRecorderInternal
+{
+    /** Fixed-size form of FTaskTraceEvent kept in the rings; dependencies live in their own ring */
+    struct FRecordedEvent
+    {
+        uint64 TaskId;
+        double EnqueueTime;
+        double StartTime;
+        double EndTime;
+        int32 WorkerId;
+        ETaskType Type;
+        ETaskPriority Priority;
+        bool bSucceeded;
+
+        /** Number of dependency IDs */
+        uint32 DependencyCount;
+
+        /** Dependency ring index of the first ID */
+        uint64 FirstDependency;
+    };
+
+    /** Per-thread event ring; rings are never freed, only recycled when their thread exits */
+    struct FThreadRing
+    {
+        /** Event storage */
+        FRecordedEvent Events[FTaskTraceRecorder::RingCapacity];
+
+        /** Dependency ID storage */
+        uint64 DependencyIds[FTaskTraceRecorder::DependencyRingCapacity];
+
+        /** Total events ever written; the slot is Head % RingCapacity */
+        std::atomic<uint64> Head{0};
+
+        /** Total dependency IDs ever reserved, published before the IDs are written */
+        std::atomic<uint64> DependencyHead{0};
+
+        /** Events before this index were discarded by Reset */
+        std::atomic<uint64> ResetIndex{0};
+
+        /** Whether a live thread owns this ring */
+        std::atomic<bool> bInUse{false};
+
+        /** Next ring in the registry */
+        FThreadRing* Next = nullptr;
+    };
+
+    /** Releases a ring when its thread exits */
+    struct FThreadRingHandle
+    {
+        FThreadRing* Ring = nullptr;
+
+        ~FThreadRingHandle()
+        {
+            if (Ring)
+            {
+                Ring->bInUse.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    /** Head of the ring registry (append only) */
+    static std::atomic<FThreadRing*> Rings(nullptr);
+
+    static thread_local FThreadRingHandle ThreadRing;
+
+    static FThreadRing* AcquireRing()
+    {
+        for (FThreadRing* Ring = Rings.load(std::memory_order_acquire); Ring; Ring = Ring->Next)
+        {
+            bool bExpected = false;
+            if (!Ring->bInUse.load(std::memory_order_relaxed) &&
+                Ring->bInUse.compare_exchange_strong(bExpected, true, std::memory_order_acquire))
+            {
+                return Ring;
+            }
+        }
+
+        FThreadRing* Ring = new FThreadRing();
+        Ring->bInUse.store(true, std::memory_order_relaxed);
+
+        FThreadRing* Head = Rings.load(std::memory_order_relaxed);
+        do
+        {
+            Ring->Next = Head;
+        }
+        while (!Rings.compare_exchange_weak(Head, Ring, std::memory_order_release, std::memory_order_relaxed));
+
+        return Ring;
+    }
+}
+
+void FTaskTraceRecorder::Enable()
+{
+    bEnabled.store(true, std::memory_order_release);
+}
+
+void FTaskTraceRecorder::Disable()
+{
+    bEnabled.store(false, std::memory_order_release);
+}
+
+void FTaskTraceRecorder::Reset()
+{
+    using namespace TaskTraceRecorderInternal;
+
+    for (FThreadRing* Ring = Rings.load(std::memory_order_acquire); Ring; Ring = Ring->Next)
+    {
+        Ring->ResetIndex.store(Ring->Head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+}
+
+void FTaskTraceRecorder::RecordTaskEnabled(const FMiningTask& Task, int32 WorkerId)
+{
+    using namespace TaskTraceRecorderInternal;
+
+    FThreadRingHandle& Handle = ThreadRing;
+    if (!Handle.Ring)
+    {
+        Handle.Ring = AcquireRing();
+    }
+
+    FThreadRing& Ring = *Handle.Ring;
+    uint64 Head = Ring.Head.load(std::memory_order_relaxed);
+    FRecordedEvent& Event = Ring.Events[Head % RingCapacity];
+
+    Event.TaskId = Task.Id;
+    Event.EnqueueTime = Task.EnqueueTime;
+    Event.StartTime = Task.StartTime;
+    Event.EndTime = Task.CompletionTime;
+    Event.WorkerId = WorkerId;
+    Event.Type = Task.Config.Type;
+    Event.Priority = Task.Config.Priority;
+    Event.bSucceeded = Task.GetStatus() == ETaskStatus::Completed;
+
+    const int32 DependencyCount = Task.Dependencies.Num();
+    const uint64 DependencyHead = Ring.DependencyHead.load(std::memory_order_relaxed);
+    Event.DependencyCount = static_cast<uint32>(DependencyCount);
+    Event.FirstDependency = DependencyHead;
+    if (DependencyCount > 0)
+    {
+        // Reserve the slots before overwriting them, so a collector that copied the old IDs sees
+        // that they may have been replaced
+        Ring.DependencyHead.store(DependencyHead + DependencyCount, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (int32 Index = 0; Index < DependencyCount; ++Index)
+        {
+            Ring.DependencyIds[(DependencyHead + Index) % DependencyRingCapacity] = Task.Dependencies[Index].TaskId;
+        }
+    }
+
+    Ring.Head.store(Head + 1, std::memory_order_release);
+}
+
+TArray<FTaskTraceEvent> FTaskTraceRecorder::CollectEvents()
+{
+    using namespace TaskTraceRecorderInternal;
+
+    TArray<FTaskTraceEvent> Events;
+    TArray<FRecordedEvent> Copy;
+
+    for (FThreadRing* Ring = Rings.load(std::memory_order_acquire); Ring; Ring = Ring->Next)
+    {
+        // Copy the live window, then drop anything the owner overwrote or was writing meanwhile
+        uint64 Head = Ring->Head.load(std::memory_order_acquire);
+        uint64 Start = FMath::Max(Head > RingCapacity ? Head - RingCapacity : 0, Ring->ResetIndex.load(std::memory_order_acquire));
+
+        Copy.Reset();
+        for (uint64 Index = Start; Index < Head; ++Index)
+        {
+            Copy.Add(Ring->Events[Index % RingCapacity]);
+        }
+
+        uint64 HeadAfter = Ring->Head.load(std::memory_order_acquire);
+        uint64 FirstValid = HeadAfter >= RingCapacity ? HeadAfter - RingCapacity + 1 : 0;
+        int32 Skip = static_cast<int32>(FMath::Min<uint64>(FirstValid > Start ? FirstValid - Start : 0, Copy.Num()));
+
+        const int32 FirstEvent = Events.Num();
+        for (int32 Index = Skip; Index < Copy.Num(); ++Index)
+        {
+            const FRecordedEvent& Recorded = Copy[Index];
+            FTaskTraceEvent& Event = Events.AddDefaulted_GetRef();
+            Event.TaskId = Recorded.TaskId;
+            Event.EnqueueTime = Recorded.EnqueueTime;
+            Event.StartTime = Recorded.StartTime;
+            Event.EndTime = Recorded.EndTime;
+            Event.WorkerId = Recorded.WorkerId;
+            Event.Type = Recorded.Type;
+            Event.Priority = Recorded.Priority;
+            Event.bSucceeded = Recorded.bSucceeded;
+            Event.Dependencies.SetNumUninitialized(Recorded.DependencyCount);
+            for (uint32 DependencyIndex = 0; DependencyIndex < Recorded.DependencyCount; ++DependencyIndex)
+            {
+                Event.Dependencies[DependencyIndex] = Ring->DependencyIds[(Recorded.FirstDependency + DependencyIndex) % DependencyRingCapacity];
+            }
+        }
+
+        // IDs below the reserved head minus the capacity may have been overwritten while we copied
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64 DependencyHeadAfter = Ring->DependencyHead.load(std::memory_order_relaxed);
+        uint64 FirstValidDependency = DependencyHeadAfter > DependencyRingCapacity ? DependencyHeadAfter - DependencyRingCapacity : 0;
+        for (int32 Index = FirstEvent; Index < Events.Num(); ++Index)
+        {
+            const FRecordedEvent& Recorded = Copy[Skip + Index - FirstEvent];
+            Events[Index].bDependenciesComplete = Recorded.FirstDependency >= FirstValidDependency;
+            if (!Events[Index].bDependenciesComplete)
+            {
+                Events[Index].Dependencies.Reset();
+            }
+        }
+    }
+
+    Events.Sort([](const FTaskTraceEvent& A, const FTaskTraceEvent& B)
+    {
+        return A.StartTime < B.StartTime;
+    });
+
+    return Events;
+}
@@ -29,28 +29,11 @@
 #endif
 
 // Initialize static members before they're used
-uint32 FHierarchicalLock::ThreadHighestLockLevelTLS = FPlatformTLS::AllocTlsSlot();
 uint32 FThreadSafety::ThreadAccessedZonesTLS = FPlatformTLS::AllocTlsSlot();
 FThreadSafety* FThreadSafety::Instance = nullptr;
 TMap<void*, FLockContentionStats> FThreadSafety::ContentionStats;
 FCriticalSection FThreadSafety::ContentionStatsLock;
 
-// Add the missing TLS methods for FHierarchicalLock
-uint32 FHierarchicalLock::GetThreadHighestLockLevel()
-{
-    void* TlsValue = FPlatformTLS::GetTlsValue(ThreadHighestLockLevelTLS);
-    if (TlsValue == nullptr)
-    {
-        return 0;
-    }
-    return static_cast<uint32>(reinterpret_cast<UPTRINT>(TlsValue));
-}
-
-void FHierarchicalLock::SetThreadHighestLockLevel(uint32 Level)
-{
-    FPlatformTLS::SetTlsValue(ThreadHighestLockLevelTLS, reinterpret_cast<void*>(static_cast<UPTRINT>(Level)));
-}
-
 // Add the missing TLS methods for FThreadSafety
 TArray<int32>* FThreadSafety::GetThreadAccessedZones()
 {
@@ -62,108 +45,252 @@ void FThreadSafety::SetThreadAccessedZones(TArray<int32>* Zones)
     FPlatformTLS::SetTlsValue(ThreadAccessedZonesTLS, Zones);
 }
 
-// Implement the atomic operations for FThreadSafetyHelpers without redefining the class
-// These are helper functions that are used by the thread safety system
-
-// Helper for locking an atomic variable
-bool TryLockAtomic(TAtomic<int32>& LockVar)
-{
-    // Cast to volatile int32* for compatibility with InterlockedCompareExchange
-    volatile int32* LockPtr = reinterpret_cast<volatile int32*>(&LockVar);
-    return FPlatformAtomics::InterlockedCompareExchange(LockPtr, 1, 0) == 0;
-}
+//----------------------------------------------------------------------
+// FThreadStripeSlot Implementation
+//----------------------------------------------------------------------
 
-void LockAtomic(TAtomic<int32>& LockVar)
+int32 FThreadStripeSlot::Get()
 {
-    // Cast to volatile int32* for compatibility with InterlockedCompareExchange
-    volatile int32* LockPtr = reinterpret_cast<volatile int32*>(&LockVar);
-    while (FPlatformAtomics::InterlockedCompareExchange(LockPtr, 1, 0) != 0)
+    static std::atomic<int32> NextSlot{0};
+    static thread_local int32 ThreadSlot = INDEX_NONE;
+    
+    if (ThreadSlot == INDEX_NONE)
     {
-        FPlatformProcess::Yield();
+        ThreadSlot = NextSlot.fetch_add(1, std::memory_order_relaxed) & (MaxSlots - 1);
     }
+    return ThreadSlot;
 }
 
-void UnlockAtomic(TAtomic<int32>& LockVar)
+int32 FThreadStripeSlot::GetStripeCount()
 {
-    // Cast to volatile int32* for compatibility with InterlockedExchange
-    volatile int32* LockPtr = reinterpret_cast<volatile int32*>(&LockVar);
-    FPlatformAtomics::InterlockedExchange(LockPtr, 0);
+    // One stripe per hardware thread is enough to keep concurrent threads on separate lines
+    static const int32 StripeCount = FMath::Min<int32>(
+        FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(FPlatformMisc::NumberOfCoresIncludingHyperthreads(), 1))),
+        MaxSlots);
+    return StripeCount;
 }
 
 //----------------------------------------------------------------------
 // FMiningReaderWriterLock Implementation
 //----------------------------------------------------------------------
 
+namespace MiningReaderWriterLockInternal
+{
+    /**
+     * Read locks held by the calling thread, so a nested read can proceed while a writer drains
+     * Tracking is skipped once the table is full; nested reads of untracked locks then wait behind
+     * pending writers as plain reads do
+     */
+    struct FHeldReadLocks
+    {
+        static constexpr int32 MaxEntries = 16;
+
+        const FMiningReaderWriterLock* Locks[MaxEntries];
+        int32 Depths[MaxEntries];
+        int32 Num = 0;
+
+        int32 Find(const FMiningReaderWriterLock* Lock) const
+        {
+            for (int32 Index = 0; Index < Num; ++Index)
+            {
+                if (Locks[Index] == Lock)
+                {
+                    return Index;
+                }
+            }
+            return INDEX_NONE;
+        }
+
+        void Add(const FMiningReaderWriterLock* Lock)
+        {
+            int32 Index = Find(Lock);
+            if (Index != INDEX_NONE)
+            {
+                Depths[Index]++;
+            }
+            else if (Num < MaxEntries)
+            {
+                Locks[Num] = Lock;
+                Depths[Num] = 1;
+                Num++;
+            }
+        }
+
+        void Remove(const FMiningReaderWriterLock* Lock)
+        {
+            int32 Index = Find(Lock);
+            if (Index != INDEX_NONE && --Depths[Index] == 0)
+            {
+                Num--;
+                Locks[Index] = Locks[Num];
+                Depths[Index] = Depths[Num];
+            }
+        }
+    };
+
+    static thread_local FHeldReadLocks HeldReadLocks;
+
+    /**
+     * Converts an absolute deadline into an event wait time
+     * @param EndTime Absolute deadline in seconds (DBL_MAX for no timeout)
+     * @param OutWaitMs Receives the time to wait in milliseconds
+     * @return False if the deadline has passed
+     */
+    static bool GetRemainingWaitMs(double EndTime, uint32& OutWaitMs)
+    {
+        if (EndTime == DBL_MAX)
+        {
+            OutWaitMs = MAX_uint32;
+            return true;
+        }
+
+        double RemainingMs = (EndTime - FPlatformTime::Seconds()) * 1000.0;
+        if (RemainingMs <= 0.0)
+        {
+            return false;
+        }
+
+        OutWaitMs = FMath::Max<uint32>(1, static_cast<uint32>(FMath::CeilToDouble(RemainingMs)));
+        return true;
+    }
+}
+
 FMiningReaderWriterLock::FMiningReaderWriterLock()
+    : WriterThreadId(0)
+    , WriterRecursion(0)
+    , WriterWaiting(0)
 {
-    ReaderEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    int32 StripeCount = FThreadStripeSlot::GetStripeCount();
+    ReaderStripes = new FReaderStripe[StripeCount];
+    StripeMask = StripeCount - 1;
+    
     WriterEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    DrainEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    ReaderEvent = FPlatformProcess::GetSynchEventFromPool(true);
 }
 
 FMiningReaderWriterLock::~FMiningReaderWriterLock()
 {
     FPlatformProcess::ReturnSynchEventToPool(ReaderEvent);
+    FPlatformProcess::ReturnSynchEventToPool(DrainEvent);
     FPlatformProcess::ReturnSynchEventToPool(WriterEvent);
     
     ReaderEvent = nullptr;
+    DrainEvent = nullptr;
     WriterEvent = nullptr;
+    
+    delete[] ReaderStripes;
+    ReaderStripes = nullptr;
 }
 
-bool FMiningReaderWriterLock::ReadLock(uint32 TimeoutMs)
+FMiningReaderWriterLock::FReaderStripe& FMiningReaderWriterLock::GetThreadStripe() const
 {
-    uint32 CurrentThreadId = GetCurrentThreadId();
+    return ReaderStripes[FThreadStripeSlot::Get() & StripeMask];
+}
+
+void FMiningReaderWriterLock::ReleaseReaderStripe(FReaderStripe& Stripe)
+{
+    Stripe.Count.fetch_sub(1);
     
-    // Fast path for reader if no writer is active or waiting
-    if (WriterActive.GetValue() == 0 && WriterWaiting.GetValue() == 0)
+    // The writer publishes ownership before scanning the stripes, so either it sees this
+    // decrement or this load sees the writer and the event wakes it
+    if (WriterThreadId.load() != 0)
     {
-        ReaderCount.Increment();
-        return true;
+        DrainEvent->Trigger();
     }
+}
+
+bool FMiningReaderWriterLock::ReadLock(uint32 TimeoutMs)
+{
+    using namespace MiningReaderWriterLockInternal;
     
-    // If this thread already holds the write lock, don't try to take a read lock
-    if (WriterActive.GetValue() > 0 && WriterThreadId.GetValue() == CurrentThreadId)
+    uint32 CurrentThreadId = GetCurrentThreadId();
+    
+    // Write access implies read access
+    if (WriterThreadId.load(std::memory_order_relaxed) == CurrentThreadId)
     {
-        // Already have write access, which implies read access
         return true;
     }
     
-    // Wait for any active writer to finish
-    double StartTime = FPlatformTime::Seconds();
-    double EndTime = (TimeoutMs > 0) ? (StartTime + TimeoutMs / 1000.0) : DBL_MAX;
+    FReaderStripe& Stripe = GetThreadStripe();
+    uint64 ProfileStart = FLockProfiler::BeginAcquire();
+    double EndTime = (TimeoutMs > 0) ? (FPlatformTime::Seconds() + TimeoutMs / 1000.0) : DBL_MAX;
     
-    while (WriterActive.GetValue() > 0)
+    for (;;)
     {
-        // Check if we've timed out
-        if (FPlatformTime::Seconds() >= EndTime)
+        // Fast path: announce on our own stripe, then confirm no writer owns the lock
+        Stripe.Count.fetch_add(1);
+        if (WriterThreadId.load() == 0)
         {
-            return false;
+            HeldReadLocks.Add(this);
+            FLockProfiler::EndAcquire(ProfileStart, this, PLATFORM_RETURN_ADDRESS(), ELockProfileType::Read);
+            return true;
+        }
+        
+        // A writer is draining, but it cannot finish before we release our outer read anyway
+        if (HeldReadLocks.Find(this) != INDEX_NONE)
+        {
+            HeldReadLocks.Add(this);
+            FLockProfiler::EndAcquire(ProfileStart, this, PLATFORM_RETURN_ADDRESS(), ELockProfileType::Read);
+            return true;
         }
         
-        ReaderEvent->Wait(1);  // Wait with a short timeout to check again
+        // Back off so the writer can drain, then sleep until it releases
+        ReleaseReaderStripe(Stripe);
+        
+        while (WriterThreadId.load() != 0)
+        {
+            uint32 WaitMs;
+            if (!GetRemainingWaitMs(EndTime, WaitMs))
+            {
+                return false;
+            }
+            
+            ReaderEvent->Wait(WaitMs);
+        }
     }
-    
-    // Increment reader count
-    ReaderCount.Increment();
-    
-    return true;
 }
 
 void FMiningReaderWriterLock::ReadUnlock()
 {
-    uint32 CurrentThreadId = GetCurrentThreadId();
-    
-    // If this thread holds the write lock, don't release a read lock
-    if (WriterActive.GetValue() > 0 && WriterThreadId.GetValue() == CurrentThreadId)
+    // If this thread holds the write lock, its reads were not counted
+    if (WriterThreadId.load(std::memory_order_relaxed) == GetCurrentThreadId())
     {
-        // Have write lock, don't decrement read count
         return;
     }
     
-    // Decrement reader count
-    int32 RemainingReaders = ReaderCount.Decrement();
+    FLockProfiler::Release(this);
+    MiningReaderWriterLockInternal::HeldReadLocks.Remove(this);
+    ReleaseReaderStripe(GetThreadStripe());
+}
+
+bool FMiningReaderWriterLock::DrainReaders(double EndTime)
+{
+    for (int32 Index = 0; Index <= StripeMask; ++Index)
+    {
+        while (ReaderStripes[Index].Count.load() != 0)
+        {
+            uint32 WaitMs;
+            if (!MiningReaderWriterLockInternal::GetRemainingWaitMs(EndTime, WaitMs))
+            {
+                return false;
+            }
+            
+            DrainEvent->Wait(WaitMs);
+        }
+    }
+    
+    return true;
+}
+
+void FMiningReaderWriterLock::ReleaseWriterOwnership()
+{
+    // Open the reader gate before clearing ownership, so the next writer's reset cannot be undone
+    ReaderEvent->Trigger();
+    WriterThreadId.store(0);
     
-    // If there are no more readers and a writer is waiting, signal the writer
-    if (RemainingReaders == 0 && WriterWaiting.GetValue() > 0)
+    // Wake one writer waiting for ownership; it retries the exchange when it wakes
+    if (WriterWaiting.load() > 0)
     {
         WriterEvent->Trigger();
     }
@@ -173,136 +300,145 @@ bool FMiningReaderWriterLock::WriteLock(uint32 TimeoutMs)
 {
     uint32 CurrentThreadId = GetCurrentThreadId();
     
-    // If this thread already holds the write lock, just increment the counter
-    if (WriterActive.GetValue() > 0 && WriterThreadId.GetValue() == CurrentThreadId)
+    // If this thread already holds the write lock, just increment the recursion depth
+    if (WriterThreadId.load(std::memory_order_relaxed) == CurrentThreadId)
     {
-        WriterActive.Increment();
+        WriterRecursion++;
         return true;
     }
     
-    // Signal that a writer is waiting
-    WriterWaiting.Increment();
+    uint64 ProfileStart = FLockProfiler::BeginAcquire();
+    double EndTime = (TimeoutMs > 0) ? (FPlatformTime::Seconds() + TimeoutMs / 1000.0) : DBL_MAX;
     
-    // Wait for all readers to finish
-    double StartTime = FPlatformTime::Seconds();
-    double EndTime = (TimeoutMs > 0) ? (StartTime + TimeoutMs / 1000.0) : DBL_MAX;
+    // Announce before trying so a releasing writer knows to trigger the event
+    WriterWaiting.fetch_add(1);
     
-    while (ReaderCount.GetValue() > 0 || WriterActive.GetValue() > 0)
+    for (;;)
     {
-        // Check if we've timed out
-        if (FPlatformTime::Seconds() >= EndTime)
+        uint32 Expected = 0;
+        if (WriterThreadId.compare_exchange_strong(Expected, CurrentThreadId))
         {
-            WriterWaiting.Decrement();
+            break;
+        }
+        
+        uint32 WaitMs;
+        if (!MiningReaderWriterLockInternal::GetRemainingWaitMs(EndTime, WaitMs))
+        {
+            WriterWaiting.fetch_sub(1);
             return false;
         }
         
-        WriterEvent->Wait(1);  // Wait with a short timeout to check again
+        WriterEvent->Wait(WaitMs);
     }
     
-    // Mark the writer as active and store the thread ID
-    WriterActive.Set(1);
-    WriterThreadId.Set(CurrentThreadId);
+    // New readers now back off; close their gate and wait for current readers to leave
+    ReaderEvent->Reset();
+    
+    if (!DrainReaders(EndTime))
+    {
+        WriterWaiting.fetch_sub(1);
+        ReleaseWriterOwnership();
+        return false;
+    }
     
-    // No longer waiting
-    WriterWaiting.Decrement();
+    WriterRecursion = 1;
+    WriterWaiting.fetch_sub(1);
+    FLockProfiler::EndAcquire(ProfileStart, this, PLATFORM_RETURN_ADDRESS(), ELockProfileType::Write);
     
     return true;
 }
 
 void FMiningReaderWriterLock::WriteUnlock()
 {
-    uint32 CurrentThreadId = GetCurrentThreadId();
-    
     // Only allow the writer thread to unlock
-    if (WriterThreadId.GetValue() != CurrentThreadId)
+    if (WriterThreadId.load(std::memory_order_relaxed) != GetCurrentThreadId())
     {
         return;
     }
     
-    // Decrement the write lock count
-    int32 RemainingWriteLocks = WriterActive.Decrement();
-    
-    // If this was the last write lock, clear the writer thread ID and signal others
-    if (RemainingWriteLocks == 0)
+    if (--WriterRecursion == 0)
     {
-        WriterThreadId.Set(0);
-        
-        // Signal readers
-        ReaderEvent->Trigger();
-        
-        // Signal one waiting writer if any
-        if (WriterWaiting.GetValue() > 0)
-        {
-            WriterEvent->Trigger();
-        }
+        FLockProfiler::Release(this);
+        ReleaseWriterOwnership();
     }
 }
 
 bool FMiningReaderWriterLock::IsWriteLocked() const
 {
-    return WriterActive.GetValue() > 0;
+    return WriterThreadId.load() != 0;
 }
 
 int32 FMiningReaderWriterLock::GetReaderCount() const
 {
-    return ReaderCount.GetValue();
+    int32 Count = 0;
+    for (int32 Index = 0; Index <= StripeMask; ++Index)
+    {
+        Count += ReaderStripes[Index].Count.load(std::memory_order_relaxed);
+    }
+    return Count;
 }
 
 bool FMiningReaderWriterLock::IsWritePending() const
 {
-    return WriterWaiting.GetValue() > 0;
+    return WriterWaiting.load() > 0;
 }
 
 bool FMiningReaderWriterLock::TryUpgradeToWriteLock()
 {
+    using namespace MiningReaderWriterLockInternal;
+    
     uint32 CurrentThreadId = GetCurrentThreadId();
     
     // Already have a write lock
-    if (WriterActive.GetValue() > 0 && WriterThreadId.GetValue() == CurrentThreadId)
+    if (WriterThreadId.load(std::memory_order_relaxed) == CurrentThreadId)
     {
         return true;
     }
     
-    // Try to acquire a write lock without waiting
-    WriterWaiting.Increment();
+    // A nested read cannot be converted without leaving the outer read unbalanced
+    int32 HeldIndex = HeldReadLocks.Find(this);
+    if (HeldIndex == INDEX_NONE || HeldReadLocks.Depths[HeldIndex] != 1)
+    {
+        return false;
+    }
     
-    bool bCanUpgrade = (ReaderCount.GetValue() == 1) && (WriterActive.GetValue() == 0);
+    uint32 Expected = 0;
+    if (!WriterThreadId.compare_exchange_strong(Expected, CurrentThreadId))
+    {
+        return false;
+    }
+    
+    // Readers arriving from now on back off, so a single remaining reader must be this thread
+    ReaderEvent->Reset();
     
-    if (bCanUpgrade)
+    if (GetReaderCount() != 1)
     {
-        // Set writer active and thread ID
-        WriterActive.Set(1);
-        WriterThreadId.Set(CurrentThreadId);
-        
-        // Decrement reader count since we're upgrading from read to write
-        ReaderCount.Decrement();
+        ReleaseWriterOwnership();
+        return false;
     }
     
-    WriterWaiting.Decrement();
+    // Convert our read into the write
+    HeldReadLocks.Remove(this);
+    GetThreadStripe().Count.fetch_sub(1);
+    WriterRecursion = 1;
     
-    return bCanUpgrade;
+    return true;
 }
 
 void FMiningReaderWriterLock::DowngradeToReadLock()
 {
-    uint32 CurrentThreadId = GetCurrentThreadId();
-    
     // Only the writer can downgrade
-    if (WriterThreadId.GetValue() != CurrentThreadId)
+    if (WriterThreadId.load(std::memory_order_relaxed) != GetCurrentThreadId())
     {
         return;
     }
     
-    // Downgrading means adding a reader and removing a writer
-    ReaderCount.Increment();
-    
-    // Clear writer status
-    WriterActive.Set(0);
-    WriterThreadId.Set(0);
+    // Register as a reader before giving up ownership so no writer can slip in between
+    GetThreadStripe().Count.fetch_add(1);
+    MiningReaderWriterLockInternal::HeldReadLocks.Add(this);
     
-    // Signal writers and readers
-    WriterEvent->Trigger();
-    ReaderEvent->Trigger();
+    WriterRecursion = 0;
+    ReleaseWriterOwnership();
 }
 
 uint32 FMiningReaderWriterLock::GetCurrentThreadId()
@@ -318,6 +454,7 @@ FScopedReadLock::FScopedReadLock(FMiningReaderWriterLock& InLock, uint32 Timeout
     : Lock(InLock)
     , bLocked(false)
 {
+    FLockProfiler::FSiteScope SiteScope(PLATFORM_RETURN_ADDRESS());
     bLocked = Lock.ReadLock(TimeoutMs);
 }
 
@@ -342,6 +479,7 @@ FScopedWriteLock::FScopedWriteLock(FMiningReaderWriterLock& InLock, uint32 Timeo
     : Lock(InLock)
     , bLocked(false)
 {
+    FLockProfiler::FSiteScope SiteScope(PLATFORM_RETURN_ADDRESS());
     bLocked = Lock.WriteLock(TimeoutMs);
 }
 
@@ -386,15 +524,9 @@ bool FHierarchicalLock::Lock(uint32 TimeoutMs)
         return true;
     }
     
-    // Check for hierarchical violation
-    if (Level <= GetThreadHighestLockLevel())
-    {
-        // Use FString to ensure format safety
-        FString ErrorMessage = FString::Format(TEXT("Hierarchical lock violation: Trying to lock level {0} when already holding level {1}"),
-            { Level, GetThreadHighestLockLevel() });
-        UE_LOG(LogTemp, Error, TEXT("%s"), *ErrorMessage);
-        return false;
-    }
+    // Validate before blocking so an ordering deadlock is reported instead of hanging; the first
+    // violation is logged with both call sites and the lock is still taken
+    FLockOrderValidator::OnAcquire(ELockOrderDomain::Hierarchical, Level, PLATFORM_RETURN_ADDRESS());
     
     // Try to acquire the lock
     double StartTime = FPlatformTime::Seconds();
@@ -405,15 +537,13 @@ bool FHierarchicalLock::Lock(uint32 TimeoutMs)
         // Check if we've timed out
         if (FPlatformTime::Seconds() >= EndTime)
         {
+            FLockOrderValidator::OnRelease(ELockOrderDomain::Hierarchical, Level);
             return false;
         }
         
         FPlatformProcess::Sleep(0.001f);
     }
     
-    // Update thread-local highest lock level
-    SetThreadHighestLockLevel(FMath::Max(GetThreadHighestLockLevel(), Level));
-    
     // Update owner and count
     OwnerThreadId.Set(CurrentThreadId);
     LockCount.Set(1);
@@ -442,17 +572,17 @@ void FHierarchicalLock::Unlock()
     if (RemainingLocks == 0)
     {
         OwnerThreadId.Set(0);
-        
-        // Reset thread-local highest lock level if this was the highest
-        if (GetThreadHighestLockLevel() == Level)
-        {
-            SetThreadHighestLockLevel(0);
-        }
+        FLockOrderValidator::OnRelease(ELockOrderDomain::Hierarchical, Level);
         
         InternalLock.Unlock();
     }
 }
 
+uint32 FHierarchicalLock::GetThreadHighestLockLevel()
+{
+    return FLockOrderValidator::GetHighestHeldLevel(ELockOrderDomain::Hierarchical);
+}
+
 uint32 FHierarchicalLock::GetLevel() const
 {
     return Level;
@@ -469,10 +599,9 @@ bool FHierarchicalLock::IsLockedByCurrentThread() const
 //----------------------------------------------------------------------
 
 FHybridLock::FHybridLock()
-    : ContentionThreshold(10)
+    : State(FAdaptiveSpinWait::Unlocked)
 {
     ContentionCount.Set(0);
-    bUseSlowLock.Set(0);
 }
 
 FHybridLock::~FHybridLock()
@@ -482,66 +611,30 @@ FHybridLock::~FHybridLock()
 
 bool FHybridLock::Lock(uint32 TimeoutMs)
 {
-    if (bUseSlowLock.GetValue() > 0)
+    uint64 ProfileStart = FLockProfiler::BeginAcquire();
+    bool bAcquired = AcquireLock(TimeoutMs);
+    if (bAcquired)
     {
-        // Use the critical section for high-contention scenarios
-        FScopeLock Lock(&SlowLock);
-        return true;
+        FLockProfiler::EndAcquire(ProfileStart, this, PLATFORM_RETURN_ADDRESS(), ELockProfileType::Hybrid);
     }
-    
-    // Try the fast lock first
-    if (TryLockAtomic(FastLock))
-    {
-        return true;
-    }
-    
-    // Increment contention counter and check if we should switch to slow lock
-    UpdateContentionStats();
-    
-    // If we're over the threshold, switch to the slow lock
-    if (static_cast<uint32>(ContentionCount.GetValue()) > ContentionThreshold)
-    {
-        bUseSlowLock.Set(1);
-        FScopeLock Lock(&SlowLock);
-        return true;
-    }
-    
-    // If no timeout specified, just spin until we get the lock
-    if (TimeoutMs == 0)
+    return bAcquired;
+}
+
+bool FHybridLock::AcquireLock(uint32 TimeoutMs)
+{
+    if (FAdaptiveSpinWait::TryLock(State))
     {
-        LockAtomic(FastLock);
         return true;
     }
     
-    // Try with timeout
-    double StartTime = FPlatformTime::Seconds();
-    double EndTime = StartTime + (TimeoutMs / 1000.0);
-    
-    while (!TryLockAtomic(FastLock))
-    {
-        // Check if we've timed out
-        if (FPlatformTime::Seconds() >= EndTime)
-        {
-            return false;
-        }
-        
-        // Yield to other threads
-        FPlatformProcess::Yield();
-    }
-    
-    return true;
+    ContentionCount.Increment();
+    return FAdaptiveSpinWait::LockSlow(State, Budget, TimeoutMs);
 }
 
 void FHybridLock::Unlock()
 {
-    if (bUseSlowLock.GetValue() > 0)
-    {
-        SlowLock.Unlock();
-    }
-    else
-    {
-        UnlockAtomic(FastLock);
-    }
+    FLockProfiler::Release(this);
+    FAdaptiveSpinWait::Unlock(State);
 }
 
 uint32 FHybridLock::GetContentionCount() const
@@ -552,23 +645,11 @@ uint32 FHybridLock::GetContentionCount() const
 void FHybridLock::ResetContentionStats()
 {
     ContentionCount.Set(0);
-    bUseSlowLock.Set(0);
 }
 
 void FHybridLock::SetContentionThreshold(uint32 Threshold)
 {
-    ContentionThreshold = Threshold;
-}
-
-void FHybridLock::UpdateContentionStats()
-{
-    int32 NewCount = ContentionCount.Increment();
-    
-    // If contention exceeds threshold, switch to slow lock
-    if (NewCount >= static_cast<int32>(ContentionThreshold) && bUseSlowLock.GetValue() == 0)
-    {
-        bUseSlowLock.Set(1);
-    }
+    // Spin-versus-park is decided by the learned spin budget; nothing to configure
 }
 
 //----------------------------------------------------------------------
@@ -725,6 +806,7 @@ bool FZoneBasedLock::LockZone(int32 ZoneId, uint32 TimeoutMs)
     
     // Use SpinLock for the zone
     FSpinLock* ZoneLock = ZoneLocks[ZoneId];
+    uint64 ProfileStart = FLockProfiler::BeginAcquire();
     
     // Try to acquire the lock
     double StartTime = FPlatformTime::Seconds();
@@ -744,6 +826,7 @@ bool FZoneBasedLock::LockZone(int32 ZoneId, uint32 TimeoutMs)
     
     // Update owner
     ZoneOwners[ZoneId].Set(CurrentThreadId);
+    FLockProfiler::EndAcquire(ProfileStart, ZoneLock, PLATFORM_RETURN_ADDRESS(), ELockProfileType::Zone);
     
     return true;
 }
@@ -765,9 +848,12 @@ bool FZoneBasedLock::TryLockZone(int32 ZoneId)
     
     // Try to lock the zone
     FSpinLock* ZoneLock = ZoneLocks[ZoneId];
+    uint64 ProfileStart = FLockProfiler::BeginAcquire();
     
     if (ZoneLock->TryLock())
     {
+        FLockProfiler::EndAcquire(ProfileStart, ZoneLock, PLATFORM_RETURN_ADDRESS(), ELockProfileType::Zone);
+        
         // Add to thread-local accessed zones
         if (FThreadSafety::GetThreadAccessedZones() == nullptr)
         {
@@ -804,6 +890,7 @@ void FZoneBasedLock::UnlockZone(int32 ZoneId)
     ZoneOwners[ZoneId].Set(INDEX_NONE);
     
     // Unlock the zone
+    FLockProfiler::Release(ZoneLocks[ZoneId]);
     ZoneLocks[ZoneId]->Unlock();
     
     // Remove from thread-local accessed zones
@@ -815,6 +902,9 @@ void FZoneBasedLock::UnlockZone(int32 ZoneId)
 
 bool FZoneBasedLock::LockMultipleZones(const TArray<int32>& ZoneIds, uint32 TimeoutMs)
 {
+    // Attribute the individual zone acquisitions to our caller
+    FLockProfiler::FSiteScope SiteScope(PLATFORM_RETURN_ADDRESS());
+    
     if (ZoneIds.Num() == 0)
     {
         return true;
@@ -1032,15 +1122,8 @@ bool FThreadSafety::DetectPotentialDeadlock(const FString& LockName, uint32 Time
 
 TArray<uint32> FThreadSafety::GetThreadLockOrder()
 {
-    TArray<uint32> Result;
-    
-    // Return the current thread's highest lock level
-    if (FHierarchicalLock::GetThreadHighestLockLevel() > 0)
-    {
-        Result.Add(FHierarchicalLock::GetThreadHighestLockLevel());
-    }
-    
-    return Result;
+    // Hierarchical levels held by the current thread, lowest first (empty when validation is compiled out)
+    return FLockOrderValidator::GetHeldLevels(ELockOrderDomain::Hierarchical);
 }
 
 struct FValidationThreadData
@@ -0,0 +1,931 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ZoneManager.h"
+#include "ZoneRebalancer.h"
+#include "TransactionManager.h"
+#include "ThreadSafety.h"
+#include "LockProfiler.h"
+#include "TaskScheduler.h"
+#include "TaskTraceRecorder.h"
+#include "AsyncTaskManager.h"
+#include "Utils/SimpleSpinLock.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/ThreadSafeCounter64.h"
+#include "HAL/CriticalSection.h"
+#include "Misc/ScopeLock.h"
+#include "Math/RandomStream.h"
+#include "Async/ParallelFor.h"
+#include "Async/Async.h"
+#include "Misc/ScopeRWLock.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformMisc.h"
+
+/**
+ * Benchmark programs for the threading and task system
+ * Each benchmark logs its results; timings are wall-clock and include result gathering
+ */
+
+/**
+ * Benchmark for zone position queries
+ * Compares the lock-free Morton spatial hash used by FZoneManager against the previous
+ * mutex-guarded TMap grid that probed every cell of the bounding cube
+ */
+void BenchmarkZoneSpatialQueries()
+{
+    const int32 ZoneCount = 50000;
+    const int32 QueryCount = 1000000;
+    const float CellSize = 200.0f;
+    const float QueryRadius = 500.0f;
+
+    // Roughly one zone per cell across a cube of cells
+    const float WorldExtent = FMath::Pow(static_cast<float>(ZoneCount), 1.0f / 3.0f) * CellSize;
+
+    FRandomStream Random(1234);
+
+    TArray<FVector> ZonePositions;
+    ZonePositions.Reserve(ZoneCount);
+    for (int32 i = 0; i < ZoneCount; ++i)
+    {
+        ZonePositions.Add(FVector(
+            Random.FRandRange(0.0f, WorldExtent),
+            Random.FRandRange(0.0f, WorldExtent),
+            Random.FRandRange(0.0f, WorldExtent)));
+    }
+
+    TArray<FVector> QueryPositions;
+    QueryPositions.Reserve(QueryCount);
+    for (int32 i = 0; i < QueryCount; ++i)
+    {
+        QueryPositions.Add(FVector(
+            Random.FRandRange(0.0f, WorldExtent),
+            Random.FRandRange(0.0f, WorldExtent),
+            Random.FRandRange(0.0f, WorldExtent)));
+    }
+
+    // Previous implementation: locked TMap grid with a full cube walk
+    TMap<FIntVector, TArray<int32>> LegacyLookup;
+    FCriticalSection LegacyLock;
+    for (int32 i = 0; i < ZoneCount; ++i)
+    {
+        FIntVector Key(
+            FMath::FloorToInt32(ZonePositions[i].X / CellSize),
+            FMath::FloorToInt32(ZonePositions[i].Y / CellSize),
+            FMath::FloorToInt32(ZonePositions[i].Z / CellSize));
+        LegacyLookup.FindOrAdd(Key).Add(i);
+    }
+
+    auto LegacyQuery = [&](const FVector& Position, TArray<int32>& OutResult)
+    {
+        FScopeLock Lock(&LegacyLock);
+        FIntVector Center(
+            FMath::FloorToInt32(Position.X / CellSize),
+            FMath::FloorToInt32(Position.Y / CellSize),
+            FMath::FloorToInt32(Position.Z / CellSize));
+        int32 GridRadius = FMath::CeilToInt32(QueryRadius / CellSize) + 1;
+        for (int32 X = Center.X - GridRadius; X <= Center.X + GridRadius; X++)
+        {
+            for (int32 Y = Center.Y - GridRadius; Y <= Center.Y + GridRadius; Y++)
+            {
+                for (int32 Z = Center.Z - GridRadius; Z <= Center.Z + GridRadius; Z++)
+                {
+                    const TArray<int32>* Cell = LegacyLookup.Find(FIntVector(X, Y, Z));
+                    if (Cell)
+                    {
+                        for (int32 Index : *Cell)
+                        {
+                            if (FVector::Dist(ZonePositions[Index], Position) <= QueryRadius)
+                            {
+                                OutResult.AddUnique(Index);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    // New implementation
+    FZoneSpatialHash SpatialHash(CellSize);
+    for (int32 i = 0; i < ZoneCount; ++i)
+    {
+        SpatialHash.Insert(i, ZonePositions[i], nullptr);
+    }
+
+    // Single-threaded runs
+    int64 LegacyHits = 0;
+    double StartTime = FPlatformTime::Seconds();
+    {
+        TArray<int32> Result;
+        for (int32 i = 0; i < QueryCount; ++i)
+        {
+            Result.Reset();
+            LegacyQuery(QueryPositions[i], Result);
+            LegacyHits += Result.Num();
+        }
+    }
+    double LegacySeconds = FPlatformTime::Seconds() - StartTime;
+
+    int64 HashHits = 0;
+    StartTime = FPlatformTime::Seconds();
+    {
+        TArray<int32> Result;
+        for (int32 i = 0; i < QueryCount; ++i)
+        {
+            Result.Reset();
+            SpatialHash.GatherInRadius(QueryPositions[i], QueryRadius, Result);
+            HashHits += Result.Num();
+        }
+    }
+    double HashSeconds = FPlatformTime::Seconds() - StartTime;
+
+    // Parallel runs show how each path scales with concurrent readers
+    const int32 BatchCount = 256;
+    const int32 BatchSize = QueryCount / BatchCount;
+
+    StartTime = FPlatformTime::Seconds();
+    ParallelFor(BatchCount, [&](int32 Batch)
+    {
+        TArray<int32> Result;
+        for (int32 i = Batch * BatchSize; i < (Batch + 1) * BatchSize; ++i)
+        {
+            Result.Reset();
+            LegacyQuery(QueryPositions[i], Result);
+        }
+    });
+    double LegacyParallelSeconds = FPlatformTime::Seconds() - StartTime;
+
+    StartTime = FPlatformTime::Seconds();
+    ParallelFor(BatchCount, [&](int32 Batch)
+    {
+        TArray<int32> Result;
+        for (int32 i = Batch * BatchSize; i < (Batch + 1) * BatchSize; ++i)
+        {
+            Result.Reset();
+            SpatialHash.GatherInRadius(QueryPositions[i], QueryRadius, Result);
+        }
+    });
+    double HashParallelSeconds = FPlatformTime::Seconds() - StartTime;
+
+    if (LegacyHits != HashHits)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Zone spatial benchmark: result mismatch (legacy %lld, hash %lld)"), LegacyHits, HashHits);
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("Zone spatial benchmark: %d zones, %d radius queries (r=%.0f), %d cells"),
+        ZoneCount, QueryCount, QueryRadius, SpatialHash.GetCellCount());
+    UE_LOG(LogTemp, Display, TEXT("  Locked TMap grid:     %.3f s single-threaded, %.3f s parallel (%.1f ns/query)"),
+        LegacySeconds, LegacyParallelSeconds, LegacySeconds * 1.0e9 / QueryCount);
+    UE_LOG(LogTemp, Display, TEXT("  Lock-free Morton hash: %.3f s single-threaded, %.3f s parallel (%.1f ns/query)"),
+        HashSeconds, HashParallelSeconds, HashSeconds * 1.0e9 / QueryCount);
+}
+
+/**
+ * Benchmark for adaptive zone rebalancing
+ * Worker threads commit to random points inside a hotspot smaller than one zone. Commits
+ * are measured with the initial layout, then again after FZoneRebalancer has had time to
+ * split the hot zone. Zones are created in a dedicated region far from the world origin
+ * and removed afterwards.
+ */
+void BenchmarkZoneRebalancing()
+{
+    const int32 BenchmarkRegionId = 0x7EBA;
+    const FVector Origin(1.0e6f, 1.0e6f, 1.0e6f);
+    const float ZoneSize = 200.0f;
+    const int32 GridExtent = 4;
+    const float HotspotExtent = 150.0f;
+    const int32 WorkerCount = 8;
+    const double PhaseSeconds = 2.0;
+    const double AdaptSeconds = 2.0;
+
+    FZoneManager& ZoneManager = FZoneManager::Get();
+
+    // The static phase must not be rebalanced
+    const FZoneRebalancerConfig PreviousConfig = ZoneManager.GetRebalancerConfig();
+    FZoneRebalancerConfig StaticConfig = PreviousConfig;
+    StaticConfig.bEnabled = false;
+    ZoneManager.SetRebalancerConfig(StaticConfig);
+
+    // Grid of cell-aligned zones; the hotspot sits inside the first zone
+    for (int32 X = 0; X < GridExtent; ++X)
+    {
+        for (int32 Y = 0; Y < GridExtent; ++Y)
+        {
+            for (int32 Z = 0; Z < GridExtent; ++Z)
+            {
+                ZoneManager.CreateZone(Origin + (FVector(X, Y, Z) + 0.5f) * ZoneSize, BenchmarkRegionId);
+            }
+        }
+    }
+    const FVector HotspotCenter = Origin + FVector(ZoneSize * 0.5f);
+
+    // Each worker repeatedly takes one zone, does a short edit and commits a new version
+    auto RunPhase = [&](double Seconds, int64& OutCommits, int64& OutConflicts)
+    {
+        FThreadSafeCounter64 Commits;
+        FThreadSafeCounter64 Conflicts;
+        double EndTime = FPlatformTime::Seconds() + Seconds;
+
+        ParallelFor(WorkerCount, [&](int32 Worker)
+        {
+            FRandomStream Random(Worker + 1);
+            int32 ThreadId = static_cast<int32>(FPlatformTLS::GetCurrentThreadId());
+
+            while (FPlatformTime::Seconds() < EndTime)
+            {
+                FVector Point = HotspotCenter + FVector(
+                    Random.FRandRange(-0.5f, 0.5f),
+                    Random.FRandRange(-0.5f, 0.5f),
+                    Random.FRandRange(-0.5f, 0.5f)) * HotspotExtent;
+
+                int32 ZoneId = ZoneManager.GetZoneIdAtPosition(Point);
+                if (ZoneId == INDEX_NONE)
+                {
+                    continue;
+                }
+
+                FMultiZoneAcquisition Acquisition;
+                if (!ZoneManager.TryAcquireZones(MakeArrayView(&ZoneId, 1), ThreadId, EZoneAccessMode::ReadWrite, Acquisition))
+                {
+                    ZoneManager.RecordZoneAccess(ZoneId, ThreadId, 0.0, true, true);
+                    Conflicts.Increment();
+                    continue;
+                }
+
+                // Simulated edit while the zone is held
+                volatile float Accumulator = 0.0f;
+                for (int32 i = 0; i < 2000; ++i)
+                {
+                    Accumulator = Accumulator + FMath::Sqrt(static_cast<float>(i));
+                }
+
+                ZoneManager.IncrementZoneVersion(ZoneId);
+                ZoneManager.ReleaseZones(Acquisition);
+                Commits.Increment();
+            }
+        });
+
+        OutCommits = Commits.GetValue();
+        OutConflicts = Conflicts.GetValue();
+    };
+
+    int64 BaselineCommits = 0;
+    int64 BaselineConflicts = 0;
+    int32 BaselineZones = ZoneManager.GetZonesInRegion(BenchmarkRegionId).Num();
+    RunPhase(PhaseSeconds, BaselineCommits, BaselineConflicts);
+
+    // Fast-reacting thresholds so the layout adapts within the benchmark
+    FZoneRebalancerConfig Config;
+    Config.SampleIntervalSeconds = 0.05f;
+    Config.SplitSustainSamples = 3;
+    Config.CooldownSeconds = 0.5f;
+    Config.MergeSustainSamples = 1000;
+
+    ZoneManager.SetRebalancerConfig(Config);
+
+    int64 AdaptCommits = 0;
+    int64 AdaptConflicts = 0;
+    RunPhase(AdaptSeconds, AdaptCommits, AdaptConflicts);
+
+    int64 AdaptedCommits = 0;
+    int64 AdaptedConflicts = 0;
+    RunPhase(PhaseSeconds, AdaptedCommits, AdaptedConflicts);
+
+    FZoneRebalancerStats Stats = ZoneManager.GetRebalancerStats();
+    ZoneManager.SetRebalancerConfig(StaticConfig);
+    int32 AdaptedZones = ZoneManager.GetZonesInRegion(BenchmarkRegionId).Num();
+
+    for (int32 ZoneId : ZoneManager.GetZonesInRegion(BenchmarkRegionId))
+    {
+        ZoneManager.RemoveZone(ZoneId);
+    }
+    ZoneManager.SetRebalancerConfig(PreviousConfig);
+
+    UE_LOG(LogTemp, Display, TEXT("Zone rebalancing benchmark: %d workers, %.0f-unit hotspot in %.0f-unit zones"),
+        WorkerCount, HotspotExtent, ZoneSize);
+    UE_LOG(LogTemp, Display, TEXT("  Static layout:   %d zones, %.0f commits/s, %.1f%% attempts conflicted"),
+        BaselineZones, BaselineCommits / PhaseSeconds,
+        100.0 * BaselineConflicts / FMath::Max<int64>(BaselineCommits + BaselineConflicts, 1));
+    UE_LOG(LogTemp, Display, TEXT("  Adapted layout:  %d zones, %.0f commits/s, %.1f%% attempts conflicted"),
+        AdaptedZones, AdaptedCommits / PhaseSeconds,
+        100.0 * AdaptedConflicts / FMath::Max<int64>(AdaptedCommits + AdaptedConflicts, 1));
+    UE_LOG(LogTemp, Display, TEXT("  Rebalancer: %llu passes, %llu splits, %llu merges, %llu deferred"),
+        Stats.PassCount, Stats.SplitCount, Stats.MergeCount, Stats.DeferredCount);
+}
+
+/**
+ * Benchmark for the transaction commit path
+ * Worker threads run many small transactions (one zone written, one read) against a private
+ * transaction manager, first committing individually and then with group commit enabled.
+ * Reports committed transactions per second and p50/p99 CommitTransaction latency.
+ */
+void BenchmarkTransactionGroupCommit()
+{
+    const int32 WorkerCount = 8;
+    const int32 TransactionsPerWorker = 10000;
+    const int32 ZoneCount = 4096;
+
+    auto RunMode = [&](bool bGroupCommit, double& OutCommitsPerSecond, double& OutP50Us, double& OutP99Us, int64& OutAborts)
+    {
+        FTransactionManager Manager;
+        Manager.Initialize();
+
+        FGroupCommitConfig GroupConfig;
+        GroupConfig.bEnabled = bGroupCommit;
+        Manager.SetGroupCommitConfig(GroupConfig);
+
+        // Conflicts abort immediately so retry sleeps do not dominate the measurement
+        FTransactionConfig Config;
+        Config.bAutoRetry = false;
+        Config.ConflictStrategy = EConflictResolution::Abort;
+
+        TArray<TArray<float>> WorkerLatencies;
+        WorkerLatencies.SetNum(WorkerCount);
+        FThreadSafeCounter64 Commits;
+        FThreadSafeCounter64 Aborts;
+
+        double StartTime = FPlatformTime::Seconds();
+        ParallelFor(WorkerCount, [&](int32 Worker)
+        {
+            FRandomStream Random(Worker + 1);
+            TArray<float>& Latencies = WorkerLatencies[Worker];
+            Latencies.Reserve(TransactionsPerWorker);
+
+            for (int32 i = 0; i < TransactionsPerWorker; ++i)
+            {
+                FMiningTransactionContext* Context = nullptr;
+                if (!Manager.BeginTransaction(Config, Context))
+                {
+                    continue;
+                }
+
+                Context->AddToReadSet(Random.RandRange(0, ZoneCount - 1));
+                Context->AddToWriteSet(Random.RandRange(0, ZoneCount - 1));
+
+                double CommitStart = FPlatformTime::Seconds();
+                bool bCommitted = Manager.CommitTransaction(Context);
+                Latencies.Add(static_cast<float>((FPlatformTime::Seconds() - CommitStart) * 1.0e6));
+
+                if (bCommitted)
+                {
+                    Commits.Increment();
+                }
+                else
+                {
+                    Aborts.Increment();
+                }
+            }
+        });
+        double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+        TArray<float> AllLatencies;
+        for (const TArray<float>& Latencies : WorkerLatencies)
+        {
+            AllLatencies.Append(Latencies);
+        }
+        AllLatencies.Sort();
+
+        OutCommitsPerSecond = Commits.GetValue() / ElapsedSeconds;
+        OutP50Us = AllLatencies.Num() > 0 ? AllLatencies[AllLatencies.Num() / 2] : 0.0;
+        OutP99Us = AllLatencies.Num() > 0 ? AllLatencies[FMath::Min(AllLatencies.Num() * 99 / 100, AllLatencies.Num() - 1)] : 0.0;
+        OutAborts = Aborts.GetValue();
+
+        Manager.Shutdown();
+    };
+
+    double IndividualRate, IndividualP50, IndividualP99;
+    double GroupRate, GroupP50, GroupP99;
+    int64 IndividualAborts, GroupAborts;
+    RunMode(false, IndividualRate, IndividualP50, IndividualP99, IndividualAborts);
+    RunMode(true, GroupRate, GroupP50, GroupP99, GroupAborts);
+
+    UE_LOG(LogTemp, Display, TEXT("Transaction commit benchmark: %d workers x %d transactions over %d zones"),
+        WorkerCount, TransactionsPerWorker, ZoneCount);
+    UE_LOG(LogTemp, Display, TEXT("  Individual commit: %.0f commits/s, p50 %.1f us, p99 %.1f us, %lld aborted"),
+        IndividualRate, IndividualP50, IndividualP99, IndividualAborts);
+    UE_LOG(LogTemp, Display, TEXT("  Group commit:      %.0f commits/s, p50 %.1f us, p99 %.1f us, %lld aborted"),
+        GroupRate, GroupP50, GroupP99, GroupAborts);
+}
+
+/**
+ * Benchmark for read scaling of FMiningReaderWriterLock
+ * Dedicated threads repeatedly take a read lock and read one entry of a small shared table for a
+ * fixed period, from 1 to 64 threads. FRWLock is measured the same way as a baseline. A second
+ * pass adds a writer that takes the lock once per millisecond, so readers are repeatedly made to
+ * back off and writers have to drain the reader stripes.
+ */
+void BenchmarkReaderWriterLockScaling()
+{
+    const float RunSeconds = 0.5f;
+    const int32 TableSize = 64;
+    const int32 ThreadCounts[] = { 1, 2, 4, 8, 16, 32, 64 };
+
+    TArray<int64> Table;
+    Table.Init(1, TableSize);
+    FThreadSafeCounter64 Checksum;
+
+    // Runs ReaderThreads dedicated threads calling ReadOp until stopped, with an optional writer
+    // calling WriteOp once per millisecond. Returns reads per second across all threads.
+    auto Measure = [&](int32 ReaderThreads, bool bWithWriter, TFunction<int64(int32)> ReadOp, TFunction<void()> WriteOp, int64& OutWrites) -> double
+    {
+        std::atomic<bool> bStarted(false);
+        std::atomic<bool> bStopped(false);
+        FThreadSafeCounter64 Reads;
+        FThreadSafeCounter64 Writes;
+
+        TArray<TFuture<void>> Threads;
+        for (int32 Thread = 0; Thread < ReaderThreads; ++Thread)
+        {
+            Threads.Add(Async(EAsyncExecution::Thread, [&, Thread]()
+            {
+                while (!bStarted.load())
+                {
+                    FPlatformProcess::Yield();
+                }
+
+                int64 LocalReads = 0;
+                int64 LocalSum = 0;
+                while (!bStopped.load(std::memory_order_relaxed))
+                {
+                    LocalSum += ReadOp(static_cast<int32>(LocalReads + Thread) & (TableSize - 1));
+                    LocalReads++;
+                }
+
+                Reads.Add(LocalReads);
+                Checksum.Add(LocalSum);
+            }));
+        }
+
+        if (bWithWriter)
+        {
+            Threads.Add(Async(EAsyncExecution::Thread, [&]()
+            {
+                while (!bStarted.load())
+                {
+                    FPlatformProcess::Yield();
+                }
+
+                while (!bStopped.load(std::memory_order_relaxed))
+                {
+                    WriteOp();
+                    Writes.Increment();
+                    FPlatformProcess::Sleep(0.001f);
+                }
+            }));
+        }
+
+        double StartTime = FPlatformTime::Seconds();
+        bStarted.store(true);
+        FPlatformProcess::Sleep(RunSeconds);
+        bStopped.store(true);
+        double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+        for (TFuture<void>& Thread : Threads)
+        {
+            Thread.Wait();
+        }
+
+        OutWrites = Writes.GetValue();
+        return Reads.GetValue() / ElapsedSeconds;
+    };
+
+    FMiningReaderWriterLock MiningLock;
+    FRWLock EngineLock;
+
+    auto MiningRead = [&](int32 Index) -> int64
+    {
+        FScopedReadLock Lock(MiningLock);
+        return Table[Index];
+    };
+    auto MiningWrite = [&]()
+    {
+        FScopedWriteLock Lock(MiningLock);
+        Table[0]++;
+    };
+    auto EngineRead = [&](int32 Index) -> int64
+    {
+        FReadScopeLock Lock(EngineLock);
+        return Table[Index];
+    };
+    auto EngineWrite = [&]()
+    {
+        FWriteScopeLock Lock(EngineLock);
+        Table[0]++;
+    };
+
+    UE_LOG(LogTemp, Display, TEXT("Reader-writer lock scaling benchmark: %.1f s per run, reads per second in millions"), RunSeconds);
+    UE_LOG(LogTemp, Display, TEXT("  Threads | Mining | FRWLock | Mining + writer | FRWLock + writer"));
+
+    for (int32 ThreadCount : ThreadCounts)
+    {
+        int64 MiningWrites = 0;
+        int64 EngineWrites = 0;
+        int64 Unused = 0;
+
+        double MiningRate = Measure(ThreadCount, false, MiningRead, MiningWrite, Unused);
+        double EngineRate = Measure(ThreadCount, false, EngineRead, EngineWrite, Unused);
+        double MiningWriterRate = Measure(ThreadCount, true, MiningRead, MiningWrite, MiningWrites);
+        double EngineWriterRate = Measure(ThreadCount, true, EngineRead, EngineWrite, EngineWrites);
+
+        UE_LOG(LogTemp, Display, TEXT("  %7d | %6.1f | %7.1f | %8.1f (%lld w) | %9.1f (%lld w)"),
+            ThreadCount, MiningRate / 1.0e6, EngineRate / 1.0e6,
+            MiningWriterRate / 1.0e6, MiningWrites, EngineWriterRate / 1.0e6, EngineWrites);
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("  Checksum %lld"), Checksum.GetValue());
+}
+
+/**
+ * Benchmark for the lock profiler
+ * Measures the per-acquire cost of profiling on an uncontended FHybridLock with the profiler off,
+ * sampling every acquisition, and sampling one in 16. Then runs a contended workload from two call
+ * sites and logs the resulting report.
+ */
+void BenchmarkLockProfilerOverhead()
+{
+    const int32 Iterations = 10000000;
+
+    FHybridLock Lock;
+
+    auto TimeLoop = [&]() -> double
+    {
+        double StartTime = FPlatformTime::Seconds();
+        for (int32 i = 0; i < Iterations; ++i)
+        {
+            Lock.Lock();
+            Lock.Unlock();
+        }
+        return (FPlatformTime::Seconds() - StartTime) * 1.0e9 / Iterations;
+    };
+
+    FLockProfiler::Disable();
+    double OffNs = TimeLoop();
+
+    FLockProfiler::Reset();
+    FLockProfiler::Enable(1);
+    double AllNs = TimeLoop();
+
+    FLockProfiler::Enable(16);
+    double SampledNs = TimeLoop();
+    FLockProfiler::Disable();
+
+    UE_LOG(LogTemp, Display, TEXT("Lock profiler overhead benchmark: %d uncontended lock/unlock pairs"), Iterations);
+    UE_LOG(LogTemp, Display, TEXT("  Profiler off:       %.1f ns per acquire"), OffNs);
+    UE_LOG(LogTemp, Display, TEXT("  Sampling all:       %.1f ns per acquire (+%.1f ns)"), AllNs, AllNs - OffNs);
+    UE_LOG(LogTemp, Display, TEXT("  Sampling 1 in 16:   %.1f ns per acquire (+%.1f ns)"), SampledNs, SampledNs - OffNs);
+
+    // Contended workload: a hot lock with a long hold and a cold lock with a short one
+    const int32 WorkerCount = 8;
+    const int32 OperationsPerWorker = 20000;
+    FHybridLock HotLock;
+    FHybridLock ColdLock;
+    FThreadSafeCounter64 Checksum;
+
+    FLockProfiler::Reset();
+    FLockProfiler::Enable(1);
+
+    ParallelFor(WorkerCount, [&](int32 Worker)
+    {
+        int64 LocalSum = 0;
+        for (int32 i = 0; i < OperationsPerWorker; ++i)
+        {
+            HotLock.Lock();
+            for (int32 Spin = 0; Spin < 200; ++Spin)
+            {
+                LocalSum += Spin ^ i;
+            }
+            HotLock.Unlock();
+
+            ColdLock.Lock();
+            LocalSum += i;
+            ColdLock.Unlock();
+        }
+        Checksum.Add(LocalSum);
+    });
+
+    FLockProfiler::Disable();
+
+    TArray<FLockSiteReport> Report = FLockProfiler::BuildReport(10);
+    UE_LOG(LogTemp, Display, TEXT("%s"), *FLockProfiler::FormatReportText(Report));
+    UE_LOG(LogTemp, Verbose, TEXT("%s"), *FLockProfiler::FormatReportJson(Report));
+    UE_LOG(LogTemp, Verbose, TEXT("  Checksum %lld"), Checksum.GetValue());
+}
+
+/** Spin lock that retries forever with a PAUSE between attempts, as the spin locks did before */
+struct FBenchmarkYieldSpinLock
+{
+    std::atomic<int32> State{0};
+
+    void Lock()
+    {
+        int32 Expected = 0;
+        while (!State.compare_exchange_weak(Expected, 1, std::memory_order_acquire))
+        {
+            Expected = 0;
+            FPlatformProcess::Yield();
+        }
+    }
+
+    void Unlock()
+    {
+        State.store(0, std::memory_order_release);
+    }
+};
+
+/**
+ * Fairness and throughput matrix for the spin-then-park locks
+ * Dedicated threads repeatedly acquire one lock, hold it for a fixed number of PAUSE iterations and
+ * then pause outside it, for a fixed period. Each cell reports total acquisitions per second and
+ * the ratio of the busiest thread's acquisitions to the least busy thread's (1.0 is perfectly
+ * fair). FSpinLock, FSimpleSpinLock and FHybridLock share FAdaptiveSpinWait; an unbounded yield
+ * spin lock and FCriticalSection are measured as baselines. Thread counts above the core count
+ * show whether waiters park instead of stealing the owner's time slice.
+ */
+void BenchmarkSpinLockPolicies()
+{
+    const float RunSeconds = 0.25f;
+    const int32 ThinkPauses = 100;
+    const int32 ThreadCounts[] = { 1, 2, 4, 8, 16, 32 };
+    const int32 HoldPauseCounts[] = { 0, 50, 2000 };
+
+    int64 SharedCounter = 0;
+
+    auto Pause = [](int32 Count)
+    {
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            FPlatformProcess::Yield();
+        }
+    };
+
+    // Returns acquisitions per second across all threads and the max/min per-thread ratio
+    auto Measure = [&](auto& Lock, int32 ThreadCount, int32 HoldPauses, double& OutFairness) -> double
+    {
+        std::atomic<bool> bStarted(false);
+        std::atomic<bool> bStopped(false);
+        TArray<int64> Acquisitions;
+        Acquisitions.Init(0, ThreadCount);
+
+        TArray<TFuture<void>> Threads;
+        for (int32 Thread = 0; Thread < ThreadCount; ++Thread)
+        {
+            Threads.Add(Async(EAsyncExecution::Thread, [&, Thread]()
+            {
+                while (!bStarted.load())
+                {
+                    FPlatformProcess::Yield();
+                }
+
+                int64 LocalAcquisitions = 0;
+                while (!bStopped.load(std::memory_order_relaxed))
+                {
+                    Lock.Lock();
+                    SharedCounter++;
+                    Pause(HoldPauses);
+                    Lock.Unlock();
+
+                    LocalAcquisitions++;
+                    Pause(ThinkPauses);
+                }
+                Acquisitions[Thread] = LocalAcquisitions;
+            }));
+        }
+
+        double StartTime = FPlatformTime::Seconds();
+        bStarted.store(true);
+        FPlatformProcess::Sleep(RunSeconds);
+        bStopped.store(true);
+        double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+        for (TFuture<void>& Thread : Threads)
+        {
+            Thread.Wait();
+        }
+
+        int64 Total = 0;
+        int64 MinAcquisitions = MAX_int64;
+        int64 MaxAcquisitions = 0;
+        for (int64 Count : Acquisitions)
+        {
+            Total += Count;
+            MinAcquisitions = FMath::Min(MinAcquisitions, Count);
+            MaxAcquisitions = FMath::Max(MaxAcquisitions, Count);
+        }
+
+        OutFairness = (MinAcquisitions > 0) ? static_cast<double>(MaxAcquisitions) / MinAcquisitions : -1.0;
+        return Total / ElapsedSeconds;
+    };
+
+    FSpinLock SpinLock;
+    FSimpleSpinLock SimpleSpinLock;
+    FHybridLock HybridLock;
+    FBenchmarkYieldSpinLock YieldSpinLock;
+    FCriticalSection CriticalSection;
+
+    UE_LOG(LogTemp, Display, TEXT("Spin lock policy benchmark: %.2f s per cell, %d think pauses, %d cores"),
+        RunSeconds, ThinkPauses, FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+    UE_LOG(LogTemp, Display, TEXT("  Cells are thousands of acquisitions per second / max:min per-thread ratio (-1 means a thread starved)"));
+
+    for (int32 HoldPauses : HoldPauseCounts)
+    {
+        UE_LOG(LogTemp, Display, TEXT("  Hold %d pauses"), HoldPauses);
+        UE_LOG(LogTemp, Display, TEXT("  Threads | %14s | %14s | %14s | %14s | %14s"),
+            TEXT("FSpinLock"), TEXT("FSimpleSpinLock"), TEXT("FHybridLock"), TEXT("YieldSpin"), TEXT("FCriticalSect"));
+
+        for (int32 ThreadCount : ThreadCounts)
+        {
+            double Fairness[5];
+            double Rates[5];
+            Rates[0] = Measure(SpinLock, ThreadCount, HoldPauses, Fairness[0]);
+            Rates[1] = Measure(SimpleSpinLock, ThreadCount, HoldPauses, Fairness[1]);
+            Rates[2] = Measure(HybridLock, ThreadCount, HoldPauses, Fairness[2]);
+            Rates[3] = Measure(YieldSpinLock, ThreadCount, HoldPauses, Fairness[3]);
+            Rates[4] = Measure(CriticalSection, ThreadCount, HoldPauses, Fairness[4]);
+
+            FString Row = FString::Printf(TEXT("  %7d"), ThreadCount);
+            for (int32 Column = 0; Column < 5; ++Column)
+            {
+                Row += FString::Printf(TEXT(" | %7.0f / %4.1f"), Rates[Column] / 1.0e3, Fairness[Column]);
+            }
+            UE_LOG(LogTemp, Display, TEXT("%s"), *Row);
+        }
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("  FHybridLock contended acquisitions: %u"), HybridLock.GetContentionCount());
+    UE_LOG(LogTemp, Verbose, TEXT("  Counter %lld"), SharedCounter);
+}
+
+/**
+ * Benchmark for task timeline recording
+ * Measures the per-task cost of FTaskTraceRecorder::RecordTask with recording off and on, on a task
+ * with two dependencies, from one thread and from one thread per core at once
+ */
+void BenchmarkTaskTraceRecording()
+{
+    const int32 Iterations = 2000000;
+    const int32 ThreadCount = FMath::Max(FPlatformMisc::NumberOfCoresIncludingHyperthreads(), 1);
+
+    FTaskConfig Config;
+    FTaskDependency Dependency;
+    Dependency.TaskId = 1;
+    Config.Dependencies.Add(Dependency);
+    Dependency.TaskId = 2;
+    Config.Dependencies.Add(Dependency);
+
+    FMiningTask Task(3, []() {}, Config, TEXT("Trace benchmark task"));
+    Task.EnqueueTime = Task.CreationTime;
+    Task.StartTime = Task.CreationTime;
+    Task.CompletionTime = Task.CreationTime;
+
+    auto MeasureNs = [&]() -> double
+    {
+        double StartTime = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < Iterations; ++Index)
+        {
+            FTaskTraceRecorder::RecordTask(Task, Index & 7);
+        }
+        return (FPlatformTime::Seconds() - StartTime) * 1.0e9 / Iterations;
+    };
+
+    FTaskTraceRecorder::Disable();
+    double DisabledNs = MeasureNs();
+
+    FTaskTraceRecorder::Reset();
+    FTaskTraceRecorder::Enable();
+    double EnabledNs = MeasureNs();
+
+    // Every thread writes its own ring, so this should match the single-thread cost
+    std::atomic<int64> TotalNanoseconds(0);
+    ParallelFor(ThreadCount, [&](int32)
+    {
+        TotalNanoseconds.fetch_add(static_cast<int64>(MeasureNs() * 1000.0));
+    });
+    double ParallelNs = TotalNanoseconds.load() / 1000.0 / ThreadCount;
+
+    FTaskTraceRecorder::Disable();
+    int32 RecordedEvents = FTaskTraceRecorder::CollectEvents().Num();
+    FTaskTraceRecorder::Reset();
+
+    UE_LOG(LogTemp, Display, TEXT("Task trace recording benchmark: %d records per run"), Iterations);
+    UE_LOG(LogTemp, Display, TEXT("  Recording off:          %.1f ns per task"), DisabledNs);
+    UE_LOG(LogTemp, Display, TEXT("  Recording on:           %.1f ns per task"), EnabledNs);
+    UE_LOG(LogTemp, Display, TEXT("  Recording on, %2d threads: %.1f ns per task"), ThreadCount, ParallelNs);
+    UE_LOG(LogTemp, Display, TEXT("  %d events retained across the rings"), RecordedEvents);
+}
+
+/** Operation that reports progress a fixed number of times and completes */
+class FBenchmarkAsyncOperation : public FAsyncOperationImpl
+{
+public:
+    FBenchmarkAsyncOperation(uint64 InId, const FString& InName, int32 InProgressReports)
+        : FAsyncOperationImpl(InId, TEXT("DispatchLatencyBenchmark"), InName)
+        , ProgressReports(InProgressReports)
+    {
+    }
+
+    virtual bool Execute() override
+    {
+        FAsyncProgress Report;
+        for (int32 Index = 0; Index < ProgressReports; ++Index)
+        {
+            Report.ItemsProcessed = Index + 1;
+            Report.TotalItems = ProgressReports;
+            Report.CompletionPercentage = static_cast<float>(Index + 1) / ProgressReports;
+            UpdateProgress(Report);
+        }
+        return true;
+    }
+
+    virtual bool Cancel() override
+    {
+        return true;
+    }
+
+private:
+    int32 ProgressReports;
+};
+
+/**
+ * Benchmark for async operation callback dispatch
+ * Measures completion latency (operation finished to callback running) for callbacks run on the
+ * completing worker and for game thread callbacks drained every 1 ms, once per 60 Hz frame and every
+ * 100 ms (the old tick interval), then how many progress callbacks reach the game thread when a
+ * worker reports progress in a tight loop. Must run on the game thread.
+ */
+void BenchmarkAsyncCompletionDispatch()
+{
+    const int32 OperationCount = 2000;
+    const int32 ProgressReports = 100000;
+
+    FAsyncTaskManager& Manager = static_cast<FAsyncTaskManager&>(FAsyncTaskManager::Get());
+
+    static int32 ProgressReportsPerOperation = 0;
+    Manager.RegisterOperationType(TEXT("DispatchLatencyBenchmark"), [](uint64 Id, const FString& Name) -> FAsyncOperationImpl*
+    {
+        return new FBenchmarkAsyncOperation(Id, Name, ProgressReportsPerOperation);
+    });
+
+    auto Measure = [&](EAsyncCallbackThread CallbackThread, double DrainIntervalSeconds, const TCHAR* Label)
+    {
+        ProgressReportsPerOperation = 0;
+        Manager.ResetDispatchStats();
+        std::atomic<int32> CompletedCount(0);
+
+        for (int32 Index = 0; Index < OperationCount; ++Index)
+        {
+            uint64 OperationId = Manager.CreateOperation(TEXT("DispatchLatencyBenchmark"));
+            Manager.RegisterCompletionCallback(OperationId, FAsyncCompletionDelegate::CreateLambda([&CompletedCount](const FAsyncResult&)
+            {
+                CompletedCount.fetch_add(1, std::memory_order_relaxed);
+            }), CallbackThread);
+            Manager.StartOperation(OperationId);
+        }
+
+        double NextDrain = FPlatformTime::Seconds();
+        double Deadline = NextDrain + 30.0;
+        while (CompletedCount.load(std::memory_order_relaxed) < OperationCount && FPlatformTime::Seconds() < Deadline)
+        {
+            if (FPlatformTime::Seconds() >= NextDrain)
+            {
+                Manager.ProcessGameThreadCallbacks();
+                NextDrain += DrainIntervalSeconds;
+            }
+            FPlatformProcess::Sleep(0.0f);
+        }
+
+        FAsyncDispatchStats Stats = Manager.GetDispatchStats();
+        UE_LOG(LogTemp, Display, TEXT("  %-32s avg %8.3f ms, max %8.3f ms (%llu callbacks)"),
+            Label, Stats.AverageCompletionLatencyMs, Stats.MaxCompletionLatencyMs, Stats.CompletionsDispatched);
+    };
+
+    UE_LOG(LogTemp, Display, TEXT("Async completion dispatch benchmark: %d operations per run"), OperationCount);
+    Measure(EAsyncCallbackThread::CompletingThread, 0.001, TEXT("Completing worker:"));
+    Measure(EAsyncCallbackThread::GameThread, 0.001, TEXT("Game thread, 1 ms sync point:"));
+    Measure(EAsyncCallbackThread::GameThread, 1.0 / 60.0, TEXT("Game thread, per 60 Hz frame:"));
+    Measure(EAsyncCallbackThread::GameThread, 0.1, TEXT("Game thread, 100 ms tick:"));
+
+    // One operation flooding progress while the game thread drains once per frame
+    ProgressReportsPerOperation = ProgressReports;
+    Manager.ResetDispatchStats();
+    std::atomic<int32> ProgressCallbacks(0);
+    uint64 OperationId = Manager.CreateOperation(TEXT("DispatchLatencyBenchmark"));
+    Manager.RegisterProgressCallback(OperationId, FAsyncProgressDelegate::CreateLambda([&ProgressCallbacks](const FAsyncProgress&)
+    {
+        ProgressCallbacks.fetch_add(1, std::memory_order_relaxed);
+    }), 0, EAsyncCallbackThread::GameThread);
+    Manager.StartOperation(OperationId);
+
+    double Deadline = FPlatformTime::Seconds() + 30.0;
+    while (Manager.GetOperationStatus(OperationId) == EAsyncStatus::InProgress && FPlatformTime::Seconds() < Deadline)
+    {
+        Manager.ProcessGameThreadCallbacks();
+        FPlatformProcess::Sleep(1.0f / 60.0f);
+    }
+    Manager.ProcessGameThreadCallbacks();
+
+    FAsyncDispatchStats Stats = Manager.GetDispatchStats();
+    UE_LOG(LogTemp, Display, TEXT("  Progress: %llu reports coalesced into %d game thread callbacks"),
+        Stats.ProgressReported, ProgressCallbacks.load());
+
+    Manager.CleanupCompletedOperations(1.0e-6);
+}
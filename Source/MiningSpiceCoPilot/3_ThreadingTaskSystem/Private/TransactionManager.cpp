@@ -8,6 +8,8 @@
 #include "Utils/SimpleSpinLock.h" // Custom implementation from spinlocks.txt
 #include "ThreadSafety.h" // For FScopedSpinLock
 #include "GenericPlatform/GenericPlatformAtomics.h"
+#include "HAL/Event.h"
+#include "Misc/ScopeLock.h"
 
 /**
  * Scoped spin lock guard using custom FSimpleSpinLock
@@ -70,8 +72,9 @@ uint32 FTransactionManager::CurrentTransactionTLS = FPlatformTLS::AllocTlsSlot()
 
 // Implementation of FMiningTransactionContextImpl
 
-FMiningTransactionContextImpl::FMiningTransactionContextImpl(uint64 InTransactionId, const FTransactionConfig& InConfig)
+FMiningTransactionContextImpl::FMiningTransactionContextImpl(uint64 InTransactionId, const FTransactionConfig& InConfig, FTransactionManager* InManager)
     : TransactionId(InTransactionId)
+    , Manager(InManager)
     , Status(ETransactionStatus::NotStarted)
     , Config(InConfig)
 {
@@ -115,6 +118,9 @@ ETransactionStatus FMiningTransactionContextImpl::GetStatus() const
 
 bool FMiningTransactionContextImpl::AddToReadSet(int32 ZoneId, int32 MaterialId)
 {
+    // Observe the version before taking our lock so the manager's locks are never nested inside it
+    uint32 Version = Manager ? Manager->ReadCurrentVersion(ZoneId, MaterialId) : 0;
+    
     FSimpleScopedSpinLock ScopeLock(Lock);
     
     // Check if transaction is active
@@ -123,11 +129,18 @@ bool FMiningTransactionContextImpl::AddToReadSet(int32 ZoneId, int32 MaterialId)
         return false;
     }
     
+    AddToReadSetLocked(ZoneId, MaterialId, Version);
+    
+    return true;
+}
+
+void FMiningTransactionContextImpl::AddToReadSetLocked(int32 ZoneId, int32 MaterialId, uint32 Version)
+{
     // Create a version record for this read
     FVersionRecord Record;
     Record.ZoneId = ZoneId;
     Record.MaterialId = MaterialId;
-    Record.Version = 0; // Will be filled by the transaction manager
+    Record.Version = Version;
     Record.bIsReadOnly = true;
     
     // Add to read set if not already present
@@ -145,12 +158,13 @@ bool FMiningTransactionContextImpl::AddToReadSet(int32 ZoneId, int32 MaterialId)
     {
         ReadSet.Add(Record);
     }
-    
-    return true;
 }
 
 bool FMiningTransactionContextImpl::AddToWriteSet(int32 ZoneId, int32 MaterialId)
 {
+    // Observe the version before taking our lock so the manager's locks are never nested inside it
+    uint32 Version = Manager ? Manager->ReadCurrentVersion(ZoneId, MaterialId) : 0;
+    
     FSimpleScopedSpinLock ScopeLock(Lock);
     
     // Check if transaction is active
@@ -163,7 +177,7 @@ bool FMiningTransactionContextImpl::AddToWriteSet(int32 ZoneId, int32 MaterialId
     FVersionRecord Record;
     Record.ZoneId = ZoneId;
     Record.MaterialId = MaterialId;
-    Record.Version = 0; // Will be filled by the transaction manager
+    Record.Version = Version;
     Record.bIsReadOnly = false;
     
     // Add to write set if not already present
@@ -181,13 +195,26 @@ bool FMiningTransactionContextImpl::AddToWriteSet(int32 ZoneId, int32 MaterialId
     {
         WriteSet.Add(Record);
         
-        // Any write also implies a read
-        AddToReadSet(ZoneId, MaterialId);
+        // Any write also implies a read (our lock is already held)
+        AddToReadSetLocked(ZoneId, MaterialId, Version);
     }
     
     return true;
 }
 
+bool FMiningTransactionContextImpl::AddCommutativeOperation(const FCommutativeFieldOp& Operation)
+{
+    // The operation's target is written, so it joins the write set (and with it the read set)
+    if (!AddToWriteSet(Operation.ZoneId, Operation.MaterialId))
+    {
+        return false;
+    }
+    
+    FSimpleScopedSpinLock ScopeLock(Lock);
+    OperationLog.Add(Operation);
+    return true;
+}
+
 FTransactionStats FMiningTransactionContextImpl::GetStats() const
 {
     FSimpleScopedSpinLock ScopeLock(Lock);
@@ -255,6 +282,11 @@ const TArray<FVersionRecord>& FMiningTransactionContextImpl::GetWriteSet() const
     return WriteSet;
 }
 
+const TArray<FCommutativeFieldOp>& FMiningTransactionContextImpl::GetOperationLog() const
+{
+    return OperationLog;
+}
+
 void FMiningTransactionContextImpl::AddConflict(const FTransactionConflict& Conflict)
 {
     FSimpleScopedSpinLock ScopeLock(Lock);
@@ -306,6 +338,7 @@ void FMiningTransactionContextImpl::ClearReadWriteSets()
     FSimpleScopedSpinLock ScopeLock(Lock);
     ReadSet.Empty();
     WriteSet.Empty();
+    OperationLog.Empty();
 }
 
 // Implementation of FTransactionManager
@@ -316,17 +349,34 @@ FTransactionManager::FTransactionManager()
     , CommittedTransactions(0)
     , AbortedTransactions(0)
     , ConflictCount(0)
+    , GroupCommitBatches(0)
+    , GroupCommittedTransactions(0)
+    , GroupCommitFallbacks(0)
 {
-    // Allocate TLS slot for current transaction
-    CurrentTransactionTLS = FPlatformTLS::AllocTlsSlot();
+    // The current transaction TLS slot is allocated once at static initialization and
+    // shared by every manager instance
 }
 
 FTransactionManager::~FTransactionManager()
 {
     Shutdown();
     
-    // Free TLS slot
-    FPlatformTLS::FreeTlsSlot(CurrentTransactionTLS);
+    // Clear singleton instance if it's this instance
+    if (Instance == this)
+    {
+        Instance = nullptr;
+    }
+}
+
+FTransactionManager::FCommitBatch::FCommitBatch()
+    : bClosed(false)
+    , DoneEvent(FPlatformProcess::GetSynchEventFromPool(true))
+{
+}
+
+FTransactionManager::FCommitBatch::~FCommitBatch()
+{
+    FPlatformProcess::ReturnSynchEventToPool(DoneEvent);
 }
 
 bool FTransactionManager::Initialize()
@@ -380,6 +430,11 @@ void FTransactionManager::Shutdown()
         MaterialVersions.Empty();
     }
     
+    {
+        FScopeLock CommitScope(&CommitLock);
+        WriteMergeStates.Empty();
+    }
+    
     // Clean up active transactions
     {
         FSimpleScopedSpinLock ScopeLock(TransactionLock);
@@ -396,6 +451,12 @@ void FTransactionManager::Shutdown()
                     Transaction->SetStatus(ETransactionStatus::Aborted);
                 }
                 
+                // Do not leave the calling thread pointing at a deleted transaction
+                if (FPlatformTLS::GetTlsValue(CurrentTransactionTLS) == Transaction)
+                {
+                    FPlatformTLS::SetTlsValue(CurrentTransactionTLS, nullptr);
+                }
+                
                 delete Transaction;
             }
         }
@@ -422,7 +483,7 @@ bool FTransactionManager::BeginTransaction(const FTransactionConfig& Config, FMi
     uint64 TransactionId = GenerateTransactionId();
     
     // Create transaction context
-    FMiningTransactionContextImpl* Context = new FMiningTransactionContextImpl(TransactionId, Config);
+    FMiningTransactionContextImpl* Context = new FMiningTransactionContextImpl(TransactionId, Config, this);
     
     // Add to active transactions
     {
@@ -463,9 +524,41 @@ bool FTransactionManager::CommitTransaction(FMiningTransactionContext* Context)
     // Set status to committing
     TransactionImpl->SetStatus(ETransactionStatus::Committing);
     
-    // Validate the transaction
+    bool bGroupCommit;
+    {
+        FSimpleScopedSpinLock ScopeLock(BatchLock);
+        bGroupCommit = GroupCommitConfig.bEnabled;
+    }
+    
+    if (bGroupCommit)
+    {
+        if (CommitTransactionGrouped(TransactionImpl))
+        {
+            return true;
+        }
+        
+        // Conflicted within the batch: retry on our own so the configured conflict strategy applies
+        FPlatformAtomics::InterlockedIncrement(reinterpret_cast<volatile int64*>(&GroupCommitFallbacks));
+    }
+    
+    return CommitTransactionIndividually(TransactionImpl);
+}
+
+bool FTransactionManager::CommitTransactionIndividually(FMiningTransactionContextImpl* TransactionImpl)
+{
+    // Validate the transaction and publish it atomically if it is valid
     TArray<FTransactionConflict> Conflicts;
-    bool bIsValid = ValidateReadSet(TransactionImpl, Conflicts);
+    bool bIsValid;
+    {
+        FScopeLock CommitScope(&CommitLock);
+        bIsValid = ValidateReadSet(TransactionImpl, Conflicts);
+        
+        if (bIsValid)
+        {
+            PublishTransaction(TransactionImpl);
+            CommitClock.Increment();
+        }
+    }
     
     if (!bIsValid)
     {
@@ -476,8 +569,12 @@ bool FTransactionManager::CommitTransaction(FMiningTransactionContext* Context)
             RecordConflict(Conflict.ZoneId);
         }
         
-        // Check auto-retry configuration
-        if (TransactionImpl->GetConfig().bAutoRetry && 
+        if (TransactionImpl->GetConfig().ConflictStrategy == EConflictResolution::Merge &&
+            TryMergeAndPublish(TransactionImpl))
+        {
+            // Operation log replayed on the latest state; nothing left to publish
+        }
+        else if (TransactionImpl->GetConfig().bAutoRetry && 
             TransactionImpl->IncrementRetryCount() <= TransactionImpl->GetConfig().MaxRetries)
         {
             // Apply retry strategy based on configuration
@@ -500,20 +597,9 @@ bool FTransactionManager::CommitTransaction(FMiningTransactionContext* Context)
         else if (TransactionImpl->GetConfig().ConflictStrategy == EConflictResolution::Force)
         {
             // Force commit despite conflicts
-            bIsValid = true;
-        }
-        else if (TransactionImpl->GetConfig().ConflictStrategy == EConflictResolution::Merge)
-        {
-            // Try to merge changes
-            bIsValid = MergeChanges(TransactionImpl);
-            
-            if (!bIsValid)
-            {
-                // If merge fails, set status to aborted
-                TransactionImpl->SetStatus(ETransactionStatus::Aborted);
-                FPlatformAtomics::InterlockedIncrement(reinterpret_cast<volatile int64*>(&AbortedTransactions));
-                return false;
-            }
+            FScopeLock CommitScope(&CommitLock);
+            PublishTransaction(TransactionImpl);
+            CommitClock.Increment();
         }
         else if (TransactionImpl->GetConfig().ConflictStrategy == EConflictResolution::Retry)
         {
@@ -526,17 +612,14 @@ bool FTransactionManager::CommitTransaction(FMiningTransactionContext* Context)
         }
         else
         {
-            // Abort transaction
+            // Abort transaction (including merges whose operations do not commute)
             TransactionImpl->SetStatus(ETransactionStatus::Aborted);
             FPlatformAtomics::InterlockedIncrement(reinterpret_cast<volatile int64*>(&AbortedTransactions));
             return false;
         }
     }
     
-    // If we get here, the transaction is valid or forced through
-    
-    // Update all zone and material versions
-    UpdateVersions(TransactionImpl);
+    // If we get here, the transaction was valid, merged or forced through
     
     // Set status to committed
     TransactionImpl->SetStatus(ETransactionStatus::Committed);
@@ -545,6 +628,158 @@ bool FTransactionManager::CommitTransaction(FMiningTransactionContext* Context)
     FPlatformAtomics::InterlockedIncrement(reinterpret_cast<volatile int64*>(&CommittedTransactions));
     
     // After a successful commit, call the completion callback if registered
+    ExecuteCompletionCallback(TransactionImpl);
+    
+    return true;
+}
+
+bool FTransactionManager::CommitTransactionGrouped(FMiningTransactionContextImpl* TransactionImpl)
+{
+    TSharedPtr<FCommitBatch, ESPMode::ThreadSafe> Batch;
+    int32 BatchIndex;
+    bool bIsLeader = false;
+    double WindowSeconds;
+    
+    // Join the open batch, or open one and lead it
+    {
+        FSimpleScopedSpinLock ScopeLock(BatchLock);
+        
+        if (!OpenBatch.IsValid())
+        {
+            OpenBatch = MakeShared<FCommitBatch, ESPMode::ThreadSafe>();
+            OpenBatch->Transactions.Reserve(GroupCommitConfig.MaxBatchSize);
+            bIsLeader = true;
+        }
+        
+        Batch = OpenBatch;
+        BatchIndex = Batch->Transactions.Add(TransactionImpl);
+        WindowSeconds = GroupCommitConfig.WindowMicroseconds / 1000000.0;
+        
+        // A full batch stops accepting transactions immediately
+        if (Batch->Transactions.Num() >= GroupCommitConfig.MaxBatchSize)
+        {
+            Batch->bClosed = true;
+            OpenBatch.Reset();
+        }
+    }
+    
+    if (bIsLeader)
+    {
+        // Give other committers a short window to join
+        double Deadline = FPlatformTime::Seconds() + WindowSeconds;
+        while (!Batch->bClosed && FPlatformTime::Seconds() < Deadline)
+        {
+            FPlatformProcess::YieldThread();
+        }
+        
+        {
+            FSimpleScopedSpinLock ScopeLock(BatchLock);
+            if (OpenBatch == Batch)
+            {
+                OpenBatch.Reset();
+            }
+            Batch->bClosed = true;
+        }
+        
+        ProcessCommitBatch(*Batch);
+        Batch->DoneEvent->Trigger();
+    }
+    else
+    {
+        Batch->DoneEvent->Wait();
+    }
+    
+    // Each committer runs its own callback; a follower's context may be cleaned up as soon as
+    // the follower returns, so the leader must not touch it after the trigger
+    const bool bCommitted = Batch->Results[BatchIndex] == EGroupCommitResult::Committed;
+    if (bCommitted)
+    {
+        ExecuteCompletionCallback(TransactionImpl);
+    }
+    
+    return bCommitted;
+}
+
+void FTransactionManager::ProcessCommitBatch(FCommitBatch& Batch)
+{
+    const int32 Count = Batch.Transactions.Num();
+    Batch.Results.Init(EGroupCommitResult::Conflict, Count);
+    
+    // Keys written by transactions already accepted into this batch
+    TSet<uint64> BatchWrites;
+    int32 CommittedCount = 0;
+    
+    {
+        FScopeLock CommitScope(&CommitLock);
+        
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            FMiningTransactionContextImpl* Transaction = Batch.Transactions[Index];
+            
+            // Validate against published versions; conflicts are recorded by the individual retry
+            TArray<FTransactionConflict> Conflicts;
+            if (!ValidateReadSet(Transaction, Conflicts))
+            {
+                continue;
+            }
+            
+            // A transaction that read what an earlier batch member writes would miss that write
+            bool bReadsBatchWrite = false;
+            for (const FVersionRecord& Record : Transaction->GetReadSet())
+            {
+                if (BatchWrites.Contains(MakeVersionKey(Record.ZoneId, Record.MaterialId)))
+                {
+                    bReadsBatchWrite = true;
+                    break;
+                }
+            }
+            
+            if (bReadsBatchWrite)
+            {
+                continue;
+            }
+            
+            for (const FVersionRecord& Record : Transaction->GetWriteSet())
+            {
+                BatchWrites.Add(MakeVersionKey(Record.ZoneId, Record.MaterialId));
+            }
+            
+            Batch.Results[Index] = EGroupCommitResult::Committed;
+            CommittedCount++;
+        }
+        
+        // Every write set entry is now unique across the batch, so one increment per entry
+        // publishes the whole batch
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            if (Batch.Results[Index] == EGroupCommitResult::Committed)
+            {
+                PublishTransaction(Batch.Transactions[Index]);
+            }
+        }
+        
+        if (CommittedCount > 0)
+        {
+            CommitClock.Increment();
+        }
+    }
+    
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        if (Batch.Results[Index] == EGroupCommitResult::Committed)
+        {
+            Batch.Transactions[Index]->SetStatus(ETransactionStatus::Committed);
+        }
+    }
+    
+    // Update statistics once for the whole batch
+    FPlatformAtomics::InterlockedAdd(reinterpret_cast<volatile int64*>(&CommittedTransactions), CommittedCount);
+    FPlatformAtomics::InterlockedAdd(reinterpret_cast<volatile int64*>(&GroupCommittedTransactions), CommittedCount);
+    FPlatformAtomics::InterlockedIncrement(reinterpret_cast<volatile int64*>(&GroupCommitBatches));
+}
+
+void FTransactionManager::ExecuteCompletionCallback(FMiningTransactionContextImpl* TransactionImpl)
+{
     FSimpleScopedSpinLock CallbackLockScope(CallbackLock);
     
     uint32 TypeId = TransactionImpl->GetConfig().TypeId;
@@ -557,8 +792,6 @@ bool FTransactionManager::CommitTransaction(FMiningTransactionContext* Context)
         
         UE_LOG(LogTemp, Verbose, TEXT("FTransactionManager::CommitTransaction - executed completion callback for type ID %u"), TypeId);
     }
-    
-    return true;
 }
 
 void FTransactionManager::AbortTransaction(FMiningTransactionContext* Context)
@@ -642,6 +875,10 @@ TMap<FString, double> FTransactionManager::GetGlobalStats() const
     Stats.Add(TEXT("AbortedTransactions"), static_cast<double>(AbortedTransactions));
     Stats.Add(TEXT("ConflictCount"), static_cast<double>(ConflictCount));
     Stats.Add(TEXT("ActiveTransactions"), static_cast<double>(ActiveTransactions.Num()));
+    Stats.Add(TEXT("CommitClock"), static_cast<double>(CommitClock.GetValue()));
+    Stats.Add(TEXT("GroupCommitBatches"), static_cast<double>(GroupCommitBatches));
+    Stats.Add(TEXT("GroupCommittedTransactions"), static_cast<double>(GroupCommittedTransactions));
+    Stats.Add(TEXT("GroupCommitFallbacks"), static_cast<double>(GroupCommitFallbacks));
     
     return Stats;
 }
@@ -688,6 +925,26 @@ ITransactionManager& FTransactionManager::Get()
     return *Instance;
 }
 
+void FTransactionManager::SetGroupCommitConfig(const FGroupCommitConfig& InConfig)
+{
+    FSimpleScopedSpinLock ScopeLock(BatchLock);
+    
+    GroupCommitConfig = InConfig;
+    GroupCommitConfig.MaxBatchSize = FMath::Max(GroupCommitConfig.MaxBatchSize, 1);
+    GroupCommitConfig.WindowMicroseconds = FMath::Max(GroupCommitConfig.WindowMicroseconds, 0.0f);
+}
+
+FGroupCommitConfig FTransactionManager::GetGroupCommitConfig() const
+{
+    FSimpleScopedSpinLock ScopeLock(BatchLock);
+    return GroupCommitConfig;
+}
+
+uint32 FTransactionManager::ReadCurrentVersion(int32 ZoneId, int32 MaterialId)
+{
+    return GetVersionRecord(ZoneId, MaterialId, true).Version;
+}
+
 uint64 FTransactionManager::GenerateTransactionId()
 {
     return static_cast<uint64>(NextTransactionId.Increment());
@@ -771,21 +1028,98 @@ void FTransactionManager::UpdateVersions(const FMiningTransactionContextImpl* Tr
     // Only update versions for entries in the write set
     for (const FVersionRecord& Record : Transaction->GetWriteSet())
     {
+        uint32 NewVersion;
+        
         if (Record.MaterialId == INDEX_NONE)
         {
             // Zone-level update
             FThreadSafeCounter* VersionCounter = GetOrCreateZoneVersion(Record.ZoneId);
-            VersionCounter->Increment();
+            NewVersion = VersionCounter->Increment();
         }
         else
         {
             // Material-level update
             FThreadSafeCounter* VersionCounter = GetOrCreateMaterialVersion(Record.ZoneId, Record.MaterialId);
-            VersionCounter->Increment();
+            NewVersion = VersionCounter->Increment();
+        }
+        
+        // Remember which kind of write produced this version so later merges can check it
+        FWriteMergeState& MergeState = WriteMergeStates.FindOrAdd(MakeVersionKey(Record.ZoneId, Record.MaterialId));
+        switch (GetWriteClass(Transaction, Record))
+        {
+            case ECommutativeOpClass::Min:
+                MergeState.LastMinVersion = NewVersion;
+                break;
+                
+            case ECommutativeOpClass::Max:
+                MergeState.LastMaxVersion = NewVersion;
+                break;
+                
+            case ECommutativeOpClass::NonCommutative:
+                MergeState.LastNonCommutativeVersion = NewVersion;
+                break;
         }
     }
 }
 
+void FTransactionManager::PublishTransaction(const FMiningTransactionContextImpl* Transaction)
+{
+    UpdateVersions(Transaction);
+    
+    const TArray<FCommutativeFieldOp>& OperationLog = Transaction->GetOperationLog();
+    if (OperationLog.Num() == 0)
+    {
+        return;
+    }
+    
+    // Copy the applier out so it runs without the callback lock held
+    FCommutativeOpApplyDelegate Applier;
+    {
+        FSimpleScopedSpinLock CallbackLockScope(CallbackLock);
+        const FCommutativeOpApplyDelegate* Found = OperationAppliers.Find(Transaction->GetConfig().TypeId);
+        if (Found)
+        {
+            Applier = *Found;
+        }
+    }
+    
+    // Applied under the commit lock so logs reach the data in version order; the lock blocks
+    // rather than spins, so committers queued behind a slow applier sleep instead of burning cores
+    Applier.ExecuteIfBound(OperationLog);
+}
+
+ECommutativeOpClass FTransactionManager::GetWriteClass(const FMiningTransactionContextImpl* Transaction, const FVersionRecord& WriteRecord)
+{
+    bool bCovered = false;
+    ECommutativeOpClass WriteClass = ECommutativeOpClass::NonCommutative;
+    
+    for (const FCommutativeFieldOp& Operation : Transaction->GetOperationLog())
+    {
+        if (Operation.ZoneId != WriteRecord.ZoneId || Operation.MaterialId != WriteRecord.MaterialId)
+        {
+            continue;
+        }
+        
+        if (!bCovered)
+        {
+            WriteClass = Operation.GetClass();
+            bCovered = true;
+        }
+        else if (Operation.GetClass() != WriteClass)
+        {
+            // Min and max operations on the same data do not commute
+            return ECommutativeOpClass::NonCommutative;
+        }
+    }
+    
+    return WriteClass;
+}
+
+uint64 FTransactionManager::MakeVersionKey(int32 ZoneId, int32 MaterialId)
+{
+    return (static_cast<uint64>(static_cast<uint32>(ZoneId)) << 32) | static_cast<uint32>(MaterialId);
+}
+
 bool FTransactionManager::ValidateReadSet(const FMiningTransactionContextImpl* Transaction, TArray<FTransactionConflict>& OutConflicts)
 {
     // Start validation time measurement
@@ -912,43 +1246,65 @@ bool FTransactionManager::ShouldUseFastPath(const FMiningTransactionContextImpl*
     return ConflictRate < Threshold;
 }
 
-bool FTransactionManager::MergeChanges(FMiningTransactionContextImpl* Transaction)
+bool FTransactionManager::TryMergeAndPublish(FMiningTransactionContextImpl* Transaction)
 {
-    // Get the read set
-    const TArray<FVersionRecord>& ReadSet = Transaction->GetReadSet();
     const TArray<FVersionRecord>& WriteSet = Transaction->GetWriteSet();
     
-    // Simple implementation just updates all read versions to current
-    // A more sophisticated implementation would actually merge data
-    for (const FVersionRecord& Record : ReadSet)
+    FScopeLock CommitScope(&CommitLock);
+    
+    // Re-check under the commit lock: versions may have moved since validation
+    for (const FVersionRecord& Record : Transaction->GetReadSet())
     {
-        FVersionRecord UpdatedRecord = GetVersionRecord(Record.ZoneId, Record.MaterialId, Record.bIsReadOnly);
+        uint32 CurrentVersion = ReadCurrentVersion(Record.ZoneId, Record.MaterialId);
+        if (CurrentVersion == Record.Version)
+        {
+            continue;
+        }
         
-        // Check if this record is also in the write set
-        bool bIsInWriteSet = false;
-        for (const FVersionRecord& WriteRecord : WriteSet)
+        // Data we only read has changed underneath us; replaying writes cannot fix that
+        const FVersionRecord* WriteRecord = WriteSet.FindByPredicate([&Record](const FVersionRecord& Candidate)
         {
-            if (WriteRecord.ZoneId == Record.ZoneId && WriteRecord.MaterialId == Record.MaterialId)
-            {
-                bIsInWriteSet = true;
-                break;
-            }
+            return Candidate.ZoneId == Record.ZoneId && Candidate.MaterialId == Record.MaterialId;
+        });
+        if (!WriteRecord)
+        {
+            return false;
         }
         
-        // Skip records that are in the write set - those will be handled differently
-        if (bIsInWriteSet)
+        ECommutativeOpClass WriteClass = GetWriteClass(Transaction, *WriteRecord);
+        if (WriteClass == ECommutativeOpClass::NonCommutative)
         {
-            continue;
+            return false;
+        }
+        
+        // Every write published since we read must commute with ours
+        const FWriteMergeState* MergeState = WriteMergeStates.Find(MakeVersionKey(Record.ZoneId, Record.MaterialId));
+        if (!MergeState || MergeState->LastNonCommutativeVersion > Record.Version)
+        {
+            return false;
         }
         
-        // For read-only records, just update the version
-        // This is equivalent to re-reading the latest value
-        const_cast<FVersionRecord&>(Record).Version = UpdatedRecord.Version;
+        uint32 LastOtherClassVersion = WriteClass == ECommutativeOpClass::Min ? MergeState->LastMaxVersion : MergeState->LastMinVersion;
+        if (LastOtherClassVersion > Record.Version)
+        {
+            return false;
+        }
     }
     
-    // In a real implementation, you would also need to merge write operations
-    // This would require domain-specific knowledge of how to combine conflicting changes
+    // Replaying the log on the latest state is equivalent to applying it after the conflicting commits
+    PublishTransaction(Transaction);
+    CommitClock.Increment();
+    
+    return true;
+}
+
+bool FTransactionManager::RegisterOperationApplier(uint32 TypeId, const FCommutativeOpApplyDelegate& Applier)
+{
+    FSimpleScopedSpinLock ScopeLock(CallbackLock);
+    
+    OperationAppliers.FindOrAdd(TypeId) = Applier;
     
+    UE_LOG(LogTemp, Verbose, TEXT("FTransactionManager::RegisterOperationApplier - registered applier for type ID %u"), TypeId);
     return true;
 }
 
@@ -0,0 +1,251 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TransactionManager.h"
+#include "CommutativeFieldOp.h"
+#include "HAL/CriticalSection.h"
+#include "Misc/ScopeLock.h"
+#include "Math/RandomStream.h"
+#include "Async/ParallelFor.h"
+
+/**
+ * Dense distance field used as the merge target in the tests below
+ */
+struct FMergeTestField
+{
+    /** Samples per axis */
+    int32 Resolution;
+
+    /** World distance between samples */
+    float SampleSpacing;
+
+    /** Signed distance samples */
+    TArray<float> Values;
+
+    FMergeTestField()
+        : Resolution(32)
+        , SampleSpacing(10.0f)
+    {
+        // Flat ground: solid below Z = 160
+        Values.SetNumUninitialized(Resolution * Resolution * Resolution);
+        for (int32 Index = 0; Index < Values.Num(); ++Index)
+        {
+            Values[Index] = GetPosition(Index).Z - 160.0f;
+        }
+    }
+
+    FVector GetPosition(int32 Index) const
+    {
+        int32 X = Index % Resolution;
+        int32 Y = (Index / Resolution) % Resolution;
+        int32 Z = Index / (Resolution * Resolution);
+        return FVector(X, Y, Z) * SampleSpacing;
+    }
+
+    void Apply(const TArray<FCommutativeFieldOp>& Operations)
+    {
+        for (const FCommutativeFieldOp& Operation : Operations)
+        {
+            for (int32 Index = 0; Index < Values.Num(); ++Index)
+            {
+                Values[Index] = Operation.Apply(Values[Index], GetPosition(Index));
+            }
+        }
+    }
+
+    bool Matches(const FMergeTestField& Other) const
+    {
+        // Min and max are exact, so any valid merge must reproduce the serial result bit for bit
+        return Values == Other.Values;
+    }
+};
+
+/**
+ * Runs one transaction that logs the given operations and commits it
+ */
+static bool CommitOperations(FTransactionManager& Manager, const FTransactionConfig& Config, const TArray<FCommutativeFieldOp>& Operations)
+{
+    FMiningTransactionContext* Context = nullptr;
+    if (!Manager.BeginTransaction(Config, Context))
+    {
+        return false;
+    }
+
+    for (const FCommutativeFieldOp& Operation : Operations)
+    {
+        Context->AddCommutativeOperation(Operation);
+    }
+
+    return Manager.CommitTransaction(Context);
+}
+
+/**
+ * Creates a manager whose operation logs are applied to a test field
+ */
+static void InitializeMergeTestManager(FTransactionManager& Manager, FMergeTestField& Field, uint32 TypeId, FCriticalSection& FieldLock)
+{
+    Manager.Initialize();
+    Manager.RegisterOperationApplier(TypeId, FCommutativeOpApplyDelegate::CreateLambda(
+        [&Field, &FieldLock](const TArray<FCommutativeFieldOp>& Operations)
+        {
+            FScopeLock Lock(&FieldLock);
+            Field.Apply(Operations);
+        }));
+}
+
+/**
+ * Test program for commutative merge of conflicting transactions
+ * Compares fields produced through conflicting, merged transactions with the same operations
+ * applied serially, and checks that non-commuting conflicts are still rejected
+ */
+void TestTransactionMerge()
+{
+    const uint32 TypeId = 7001;
+    const int32 ZoneId = 1;
+
+    FTransactionConfig Config;
+    Config.TypeId = TypeId;
+    Config.bAutoRetry = false;
+    Config.ConflictStrategy = EConflictResolution::Merge;
+
+    // Two overlapping carves that both read version 1 of the zone
+    {
+        FMergeTestField Field;
+        FCriticalSection FieldLock;
+        FTransactionManager Manager;
+        InitializeMergeTestManager(Manager, Field, TypeId, FieldLock);
+
+        FCommutativeFieldOp CarveA = FCommutativeFieldOp::MakeSphere(ZoneId, ECommutativeOpType::Subtraction, FVector(150.0f, 150.0f, 160.0f), 60.0f, 20.0f);
+        FCommutativeFieldOp CarveB = FCommutativeFieldOp::MakeBox(ZoneId, ECommutativeOpType::Subtraction, FVector(190.0f, 160.0f, 140.0f), FVector(40.0f, 30.0f, 50.0f), 20.0f);
+
+        FMiningTransactionContext* First = nullptr;
+        FMiningTransactionContext* Second = nullptr;
+        Manager.BeginTransaction(Config, First);
+        Manager.BeginTransaction(Config, Second);
+        First->AddCommutativeOperation(CarveA);
+        Second->AddCommutativeOperation(CarveB);
+
+        bool bFirstCommitted = Manager.CommitTransaction(First);
+        bool bSecondCommitted = Manager.CommitTransaction(Second);
+        verifyf(bFirstCommitted && bSecondCommitted, TEXT("overlapping carves both commit"));
+        verifyf(Second->GetConflicts().Num() > 0, TEXT("second carve saw a conflict"));
+
+        FMergeTestField Serial;
+        Serial.Apply({ CarveA, CarveB });
+        FMergeTestField Reversed;
+        Reversed.Apply({ CarveB, CarveA });
+        verifyf(Field.Matches(Serial), TEXT("merged carves match serial application"));
+        verifyf(Field.Matches(Reversed), TEXT("merged carves match reversed serial application"));
+
+        // The manager owns the contexts; shutting it down frees them
+        Manager.Shutdown();
+    }
+
+    // A carve and a fill on the same zone do not commute
+    {
+        FMergeTestField Field;
+        FCriticalSection FieldLock;
+        FTransactionManager Manager;
+        InitializeMergeTestManager(Manager, Field, TypeId, FieldLock);
+
+        FCommutativeFieldOp Carve = FCommutativeFieldOp::MakeSphere(ZoneId, ECommutativeOpType::Subtraction, FVector(150.0f, 150.0f, 160.0f), 60.0f, 20.0f);
+        FCommutativeFieldOp Fill = FCommutativeFieldOp::MakeSphere(ZoneId, ECommutativeOpType::Union, FVector(170.0f, 150.0f, 180.0f), 40.0f, 20.0f);
+
+        FMiningTransactionContext* First = nullptr;
+        FMiningTransactionContext* Second = nullptr;
+        Manager.BeginTransaction(Config, First);
+        Manager.BeginTransaction(Config, Second);
+        First->AddCommutativeOperation(Carve);
+        Second->AddCommutativeOperation(Fill);
+
+        bool bFirstCommitted = Manager.CommitTransaction(First);
+        bool bSecondCommitted = Manager.CommitTransaction(Second);
+        verifyf(bFirstCommitted && !bSecondCommitted, TEXT("fill conflicting with a carve is not merged"));
+        verifyf(Second->GetStatus() == ETransactionStatus::Aborted, TEXT("non-commuting transaction is aborted"));
+
+        FMergeTestField Serial;
+        Serial.Apply({ Carve });
+        verifyf(Field.Matches(Serial), TEXT("aborted fill left the field untouched"));
+
+        Manager.Shutdown();
+    }
+
+    // A transaction whose read-only data changed cannot be merged
+    {
+        FMergeTestField Field;
+        FCriticalSection FieldLock;
+        FTransactionManager Manager;
+        InitializeMergeTestManager(Manager, Field, TypeId, FieldLock);
+
+        FCommutativeFieldOp CarveA = FCommutativeFieldOp::MakeSphere(ZoneId, ECommutativeOpType::Subtraction, FVector(100.0f, 100.0f, 160.0f), 40.0f, 20.0f);
+        FCommutativeFieldOp CarveB = FCommutativeFieldOp::MakeSphere(ZoneId + 1, ECommutativeOpType::Subtraction, FVector(200.0f, 200.0f, 160.0f), 40.0f, 20.0f);
+
+        FMiningTransactionContext* First = nullptr;
+        FMiningTransactionContext* Second = nullptr;
+        Manager.BeginTransaction(Config, First);
+        Manager.BeginTransaction(Config, Second);
+        First->AddCommutativeOperation(CarveA);
+        Second->AddToReadSet(ZoneId);
+        Second->AddCommutativeOperation(CarveB);
+
+        bool bFirstCommitted = Manager.CommitTransaction(First);
+        bool bSecondCommitted = Manager.CommitTransaction(Second);
+        verifyf(bFirstCommitted && !bSecondCommitted, TEXT("stale read-only record prevents merge"));
+
+        Manager.Shutdown();
+    }
+
+    // Many threads carving the same zone concurrently, with and without group commit
+    for (bool bGroupCommit : { false, true })
+    {
+        const int32 WorkerCount = 8;
+        const int32 CarvesPerWorker = 25;
+
+        FMergeTestField Field;
+        FCriticalSection FieldLock;
+        FTransactionManager Manager;
+        InitializeMergeTestManager(Manager, Field, TypeId, FieldLock);
+
+        FGroupCommitConfig GroupConfig;
+        GroupConfig.bEnabled = bGroupCommit;
+        Manager.SetGroupCommitConfig(GroupConfig);
+
+        TArray<TArray<FCommutativeFieldOp>> WorkerOperations;
+        WorkerOperations.SetNum(WorkerCount);
+        for (int32 Worker = 0; Worker < WorkerCount; ++Worker)
+        {
+            FRandomStream Random(Worker + 11);
+            for (int32 i = 0; i < CarvesPerWorker; ++i)
+            {
+                FVector Center(Random.FRandRange(50.0f, 260.0f), Random.FRandRange(50.0f, 260.0f), Random.FRandRange(100.0f, 200.0f));
+                WorkerOperations[Worker].Add(Random.FRand() < 0.5f ?
+                    FCommutativeFieldOp::MakeSphere(ZoneId, ECommutativeOpType::Subtraction, Center, Random.FRandRange(15.0f, 50.0f), 20.0f) :
+                    FCommutativeFieldOp::MakeBox(ZoneId, ECommutativeOpType::Subtraction, Center, FVector(Random.FRandRange(10.0f, 40.0f)), 20.0f));
+            }
+        }
+
+        FThreadSafeCounter Committed;
+        ParallelFor(WorkerCount, [&](int32 Worker)
+        {
+            for (const FCommutativeFieldOp& Operation : WorkerOperations[Worker])
+            {
+                if (CommitOperations(Manager, Config, { Operation }))
+                {
+                    Committed.Increment();
+                }
+            }
+        });
+
+        FMergeTestField Serial;
+        for (const TArray<FCommutativeFieldOp>& Operations : WorkerOperations)
+        {
+            Serial.Apply(Operations);
+        }
+
+        verifyf(Committed.GetValue() == WorkerCount * CarvesPerWorker, TEXT("all concurrent carves commit (group commit %d)"), bGroupCommit);
+        verifyf(Field.Matches(Serial), TEXT("concurrent carves match serial application (group commit %d)"), bGroupCommit);
+
+        Manager.Shutdown();
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("Transaction merge test completed"));
+}
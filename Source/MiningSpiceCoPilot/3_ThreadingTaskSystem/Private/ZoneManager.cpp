@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "ZoneManager.h"
+#include "EpochManager.h"
 #include "Misc/ScopeLock.h"
 #include "HAL/PlatformTime.h"
 
@@ -13,17 +14,41 @@ static const float SpatialGridSize = 200.0f;
 // Default timeout for zone acquisition in milliseconds
 static const uint32 DefaultAcquisitionTimeoutMs = 5000;
 
+// Initial backoff between multi-zone batch attempts in microseconds
+static const uint32 MultiZoneInitialBackoffUs = 50;
+
+// Maximum backoff between multi-zone batch attempts in microseconds
+static const uint32 MultiZoneMaxBackoffUs = 2000;
+
+// Number of batch attempts that only yield before sleeping
+static const int32 MultiZoneYieldAttempts = 4;
+
 // Threshold for marking a zone as high contention
 static const uint32 HighContentionThreshold = 10;
 
 // Threshold for marking a zone as frequently modified (as percentage of accesses)
 static const float FrequentModificationThreshold = 0.5f;
 
+/**
+ * Frees a retired zone descriptor and its material version counters
+ * Lock-free readers may still hold the descriptor, so zones are retired through FEpochManager
+ */
+static void DeleteZoneDescriptor(void* Pointer)
+{
+    FZoneDescriptor* Zone = static_cast<FZoneDescriptor*>(Pointer);
+    for (auto& MaterialPair : Zone->MaterialVersions)
+    {
+        delete MaterialPair.Value;
+    }
+    delete Zone;
+}
+
 /**
  * Constructor
  */
 FZoneManager::FZoneManager()
     : bIsInitialized(false)
+    , SpatialHash(SpatialGridSize)
 {
     // Store singleton instance
     Instance = this;
@@ -64,12 +89,15 @@ bool FZoneManager::Initialize()
     // Initialize maps
     Zones.Empty();
     ZonesByRegion.Empty();
-    SpatialLookup.Empty();
+    SpatialHash.Reset();
     ZoneSpatialKeys.Empty();
     
     // Mark as initialized
     bIsInitialized = true;
     
+    // Adapt the zone layout to contention in the background
+    StartRebalancer();
+    
     UE_LOG(LogTemp, Log, TEXT("Zone Manager initialized"));
     
     return true;
@@ -86,30 +114,26 @@ void FZoneManager::Shutdown()
         return;
     }
     
+    // Stop splitting and merging before the zones go away
+    StopRebalancer();
+    
     // Clean up all zones
     {
         FScopeLock Lock(&ZoneLock);
         
-        // Delete all zone descriptors
+        // Retire all zone descriptors; lock-free readers may still hold them
         for (auto& Pair : Zones)
         {
-            FZoneDescriptor* Zone = Pair.Value;
-            if (Zone)
+            if (Pair.Value)
             {
-                // Clean up material version counters
-                for (auto& MaterialPair : Zone->MaterialVersions)
-                {
-                    delete MaterialPair.Value;
-                }
-                
-                delete Zone;
+                FEpochManager::Get().Retire(Pair.Value, &DeleteZoneDescriptor);
             }
         }
         
         // Clear maps
         Zones.Empty();
         ZonesByRegion.Empty();
-        SpatialLookup.Empty();
+        SpatialHash.Reset();
         ZoneSpatialKeys.Empty();
     }
     
@@ -138,42 +162,74 @@ int32 FZoneManager::CreateZone(const FVector& Position, int32 RegionId)
         return INDEX_NONE;
     }
     
-    // Generate a unique zone ID
-    int32 ZoneId = NextZoneId.Increment();
+    // Create a new zone descriptor with a unique ID
+    FZoneDescriptor* Zone = NewZoneDescriptor(Position, RegionId, FVector(SpatialGridSize));
+    
+    // Add to zones map
+    {
+        FScopeLock Lock(&ZoneLock);
+        RegisterZone(Zone);
+    }
     
-    // Create a new zone descriptor
+    return Zone->ZoneId;
+}
+
+/**
+ * Allocates a zone descriptor with a fresh ID without publishing it
+ */
+FZoneDescriptor* FZoneManager::NewZoneDescriptor(const FVector& Position, int32 RegionId, const FVector& Dimensions)
+{
     FZoneDescriptor* Zone = new FZoneDescriptor();
-    Zone->ZoneId = ZoneId;
+    Zone->ZoneId = NextZoneId.Increment();
     Zone->RegionId = RegionId;
     Zone->Position = Position;
-    Zone->Dimensions = FVector(SpatialGridSize); // Default size
+    Zone->Dimensions = Dimensions;
     Zone->OwnershipStatus = EZoneOwnershipStatus::None;
+    return Zone;
+}
+
+/**
+ * Publishes a zone descriptor to the zone, region and spatial maps
+ */
+void FZoneManager::RegisterZone(FZoneDescriptor* Zone)
+{
+    // Add to main zones map
+    Zones.Add(Zone->ZoneId, Zone);
     
-    // Add to zones map
+    // Add to regions map
+    ZonesByRegion.FindOrAdd(Zone->RegionId).Add(Zone->ZoneId);
+    
+    // Add to spatial lookup
+    AddZoneToSpatialLookup(Zone->ZoneId, Zone->Position, Zone->Dimensions);
+}
+
+/**
+ * Unpublishes and retires a zone descriptor regardless of ownership state
+ */
+void FZoneManager::UnregisterZone(FZoneDescriptor* Zone)
+{
+    int32 ZoneId = Zone->ZoneId;
+    
+    // Remove from regions map
+    TSet<int32>* RegionZones = ZonesByRegion.Find(Zone->RegionId);
+    if (RegionZones)
     {
-        FScopeLock Lock(&ZoneLock);
-        
-        // Add to main zones map
-        Zones.Add(ZoneId, Zone);
+        RegionZones->Remove(ZoneId);
         
-        // Add to regions map
-        TSet<int32>* RegionZones = ZonesByRegion.Find(RegionId);
-        if (RegionZones)
-        {
-            RegionZones->Add(ZoneId);
-        }
-        else
+        // Remove empty region entries
+        if (RegionZones->Num() == 0)
         {
-            TSet<int32> NewSet;
-            NewSet.Add(ZoneId);
-            ZonesByRegion.Add(RegionId, NewSet);
+            ZonesByRegion.Remove(Zone->RegionId);
         }
-        
-        // Add to spatial lookup
-        AddZoneToSpatialLookup(ZoneId, Position);
     }
     
-    return ZoneId;
+    // Remove from spatial lookup
+    RemoveZoneFromSpatialLookup(ZoneId, Zone->Position);
+    
+    // Remove from zones map; readers that found the descriptor lock-free may still be using it,
+    // so it is freed once every thread pinned now has unpinned
+    Zones.Remove(ZoneId);
+    FEpochManager::Get().Retire(Zone, &DeleteZoneDescriptor);
 }
 
 /**
@@ -203,26 +259,23 @@ UE::Math::TIntVector3<int> FZoneManager::ComputeSpatialKey(const UE::Math::TVect
 /**
  * Adds a zone to the spatial lookup grid
  */
-void FZoneManager::AddZoneToSpatialLookup(int32 ZoneId, const FVector& Position)
+void FZoneManager::AddZoneToSpatialLookup(int32 ZoneId, const FVector& Position, const FVector& Dimensions)
 {
-    // Compute spatial key
-    FIntVector Key = ComputeSpatialKey(Position);
+    // Merged zones span several cells and their center sits on a boundary, so the zone goes
+    // into every cell its bounds overlap
+    FVector Extent = Dimensions * 0.5f;
+    TArray<FIntVector> Keys;
+    SpatialHash.ComputeOverlappedCells(Position, Extent, Keys);
     
-    // Add to spatial lookup
-    TArray<int32>* ZonesAtKey = SpatialLookup.Find(Key);
-    if (ZonesAtKey)
-    {
-        ZonesAtKey->Add(ZoneId);
-    }
-    else
+    // Publish to the lock-free spatial hash
+    FZoneDescriptor** ZonePtr = Zones.Find(ZoneId);
+    for (const FIntVector& Key : Keys)
     {
-        TArray<int32> NewArray;
-        NewArray.Add(ZoneId);
-        SpatialLookup.Add(Key, NewArray);
+        SpatialHash.Insert(ZoneId, Position, Extent, Key, ZonePtr ? *ZonePtr : nullptr);
     }
     
-    // Store the key for this zone
-    ZoneSpatialKeys.Add(ZoneId, Key);
+    // Store the keys for this zone
+    ZoneSpatialKeys.Add(ZoneId, MoveTemp(Keys));
 }
 
 /**
@@ -230,28 +283,20 @@ void FZoneManager::AddZoneToSpatialLookup(int32 ZoneId, const FVector& Position)
  */
 void FZoneManager::RemoveZoneFromSpatialLookup(int32 ZoneId, const FVector& Position)
 {
-    // Find the key for this zone
-    FIntVector* KeyPtr = ZoneSpatialKeys.Find(ZoneId);
-    if (!KeyPtr)
-    {
-        // Compute it if not found
-        FIntVector Key = ComputeSpatialKey(Position);
-        KeyPtr = &Key;
-    }
-    
-    // Remove from spatial lookup
-    TArray<int32>* ZonesAtKey = SpatialLookup.Find(*KeyPtr);
-    if (ZonesAtKey)
+    // Remove from every cell the zone was added to, or from its center's cell if none were recorded
+    TArray<FIntVector>* KeysPtr = ZoneSpatialKeys.Find(ZoneId);
+    if (KeysPtr)
     {
-        ZonesAtKey->Remove(ZoneId);
-        
-        // Remove empty arrays
-        if (ZonesAtKey->Num() == 0)
+        for (const FIntVector& Key : *KeysPtr)
         {
-            SpatialLookup.Remove(*KeyPtr);
+            SpatialHash.Remove(ZoneId, Key);
         }
     }
-    
+    else
+    {
+        SpatialHash.Remove(ZoneId, SpatialHash.ComputeCellCoord(Position));
+    }
+        
     // Remove the key mapping
     ZoneSpatialKeys.Remove(ZoneId);
 }
@@ -284,33 +329,7 @@ bool FZoneManager::RemoveZone(int32 ZoneId)
         return false;
     }
     
-    // Remove from regions map
-    TSet<int32>* RegionZones = ZonesByRegion.Find(Zone->RegionId);
-    if (RegionZones)
-    {
-        RegionZones->Remove(ZoneId);
-        
-        // Remove empty region entries
-        if (RegionZones->Num() == 0)
-        {
-            ZonesByRegion.Remove(Zone->RegionId);
-        }
-    }
-    
-    // Remove from spatial lookup
-    RemoveZoneFromSpatialLookup(ZoneId, Zone->Position);
-    
-    // Clean up material version counters
-    for (auto& MaterialPair : Zone->MaterialVersions)
-    {
-        delete MaterialPair.Value;
-    }
-    
-    // Delete the zone descriptor
-    delete Zone;
-    
-    // Remove from zones map
-    Zones.Remove(ZoneId);
+    UnregisterZone(Zone);
     
     return true;
 }
@@ -334,58 +353,64 @@ FZoneDescriptor* FZoneManager::GetZone(int32 ZoneId)
 }
 
 /**
- * Gets a zone by world position
+ * Copies a zone's placement under ZoneLock
  */
-FZoneDescriptor* FZoneManager::GetZoneAtPosition(const FVector& Position)
+bool FZoneManager::GetZoneSnapshot(int32 ZoneId, FZoneSnapshot& OutSnapshot) const
 {
     // Ensure we're initialized
     if (!bIsInitialized)
     {
-        return nullptr;
+        return false;
     }
     
     FScopeLock Lock(&ZoneLock);
     
-    // Compute spatial key for the position
-    FIntVector Key = ComputeSpatialKey(Position);
-    
-    // Look up zones at this position
-    TArray<int32>* ZoneIds = SpatialLookup.Find(Key);
-    if (!ZoneIds || ZoneIds->Num() == 0)
+    const FZoneDescriptor* const* ZonePtr = Zones.Find(ZoneId);
+    if (!ZonePtr || !(*ZonePtr))
     {
-        return nullptr;
+        return false;
     }
     
-    // Find the closest zone to the position
-    float ClosestDistSq = MAX_FLT;
-    int32 ClosestZoneId = INDEX_NONE;
-    
-    for (int32 Id : *ZoneIds)
+    // Copy while the lock keeps the descriptor alive
+    const FZoneDescriptor* Zone = *ZonePtr;
+    OutSnapshot.ZoneId = Zone->ZoneId;
+    OutSnapshot.RegionId = Zone->RegionId;
+    OutSnapshot.Position = Zone->Position;
+    OutSnapshot.Dimensions = Zone->Dimensions;
+    return true;
+}
+
+/**
+ * Gets a zone by world position
+ */
+FZoneDescriptor* FZoneManager::GetZoneAtPosition(const FVector& Position)
+{
+    // Ensure we're initialized
+    if (!bIsInitialized)
     {
-        FZoneDescriptor** ZonePtr = Zones.Find(Id);
-        if (ZonePtr && *ZonePtr)
-        {
-            FZoneDescriptor* Zone = *ZonePtr;
-            
-            // Calculate squared distance to zone center
-            float DistSq = FVector::DistSquared(Zone->Position, Position);
-            
-            // Check if this is closer
-            if (DistSq < ClosestDistSq)
-            {
-                ClosestDistSq = DistSq;
-                ClosestZoneId = Id;
-            }
-        }
+        return nullptr;
     }
     
-    // Return the closest zone
-    if (ClosestZoneId != INDEX_NONE)
+    // The descriptor is only kept alive by the caller's own pin
+    checkf(FEpochManager::Get().IsPinned(), TEXT("FZoneManager::GetZoneAtPosition - Caller must hold an FEpochGuard while using the descriptor"));
+    
+    // Lock-free lookup of the closest zone in the position's cell
+    return SpatialHash.FindClosestInCell(Position);
+}
+
+/**
+ * Gets the ID of the zone at a world position
+ */
+int32 FZoneManager::GetZoneIdAtPosition(const FVector& Position) const
+{
+    // Ensure we're initialized
+    if (!bIsInitialized)
     {
-        return Zones[ClosestZoneId];
+        return INDEX_NONE;
     }
     
-    return nullptr;
+    // Lock-free lookup of the closest zone in the position's cell
+    return SpatialHash.FindClosestZoneIdInCell(Position);
 }
 
 /**
@@ -405,13 +430,6 @@ bool FZoneManager::AcquireZoneOwnership(int32 ZoneId, int32 ThreadId, EZoneAcces
         TimeoutMs = DefaultAcquisitionTimeoutMs;
     }
     
-    // Get the zone
-    FZoneDescriptor* Zone = GetZone(ZoneId);
-    if (!Zone)
-    {
-        return false;
-    }
-    
     // Calculate timeout time
     double StartTime = FPlatformTime::Seconds();
     double EndTime = StartTime + (TimeoutMs / 1000.0);
@@ -429,95 +447,13 @@ bool FZoneManager::AcquireZoneOwnership(int32 ZoneId, int32 ThreadId, EZoneAcces
             break;
         }
         
-        // Attempt to acquire based on access mode
-        switch (AccessMode)
+        // Attempt to acquire based on access mode; the zone may be split or merged while we wait
+        EZoneTryAcquireResult Result = TryAcquireZoneById(ZoneId, ThreadId, AccessMode);
+        if (Result == EZoneTryAcquireResult::Removed)
         {
-            case EZoneAccessMode::ReadOnly:
-                // Read-only access: can share with other readers
-                Zone->Lock.Lock();
-                
-                if (Zone->OwnershipStatus == EZoneOwnershipStatus::None || 
-                    Zone->OwnershipStatus == EZoneOwnershipStatus::Shared)
-                {
-                    // Zone is available for shared access
-                    Zone->OwnershipStatus = EZoneOwnershipStatus::Shared;
-                    Zone->ReaderCount.Increment();
-                    bAcquired = true;
-                }
-                else if (Zone->OwnershipStatus == EZoneOwnershipStatus::Exclusive && 
-                         Zone->OwnerThreadId.GetValue() == ThreadId)
-                {
-                    // We already own it exclusively, so we can read too
-                    bAcquired = true;
-                }
-                
-                Zone->Lock.Unlock();
-                break;
-                
-            case EZoneAccessMode::ReadWrite:
-                // Read-write access: need exclusive ownership
-                Zone->Lock.Lock();
-                
-                if (Zone->OwnershipStatus == EZoneOwnershipStatus::None)
-                {
-                    // Zone is available
-                    Zone->OwnershipStatus = EZoneOwnershipStatus::Exclusive;
-                    Zone->OwnerThreadId.Set(ThreadId);
-                    bAcquired = true;
-                }
-                else if (Zone->OwnershipStatus == EZoneOwnershipStatus::Exclusive && 
-                         Zone->OwnerThreadId.GetValue() == ThreadId)
-                {
-                    // We already own it
-                    bAcquired = true;
-                }
-                
-                Zone->Lock.Unlock();
-                break;
-                
-            case EZoneAccessMode::Exclusive:
-                // Exclusive access: need exclusive ownership, no readers
-                Zone->Lock.Lock();
-                
-                if (Zone->OwnershipStatus == EZoneOwnershipStatus::None)
-                {
-                    // Zone is available
-                    Zone->OwnershipStatus = EZoneOwnershipStatus::Exclusive;
-                    Zone->OwnerThreadId.Set(ThreadId);
-                    bAcquired = true;
-                }
-                else if (Zone->OwnershipStatus == EZoneOwnershipStatus::Exclusive && 
-                         Zone->OwnerThreadId.GetValue() == ThreadId)
-                {
-                    // We already own it
-                    bAcquired = true;
-                }
-                
-                Zone->Lock.Unlock();
-                break;
-                
-            case EZoneAccessMode::MaterialOnly:
-                // Material-only access: less restrictive, can have multiple writers to different materials
-                Zone->Lock.Lock();
-                
-                if (Zone->OwnershipStatus == EZoneOwnershipStatus::None || 
-                    Zone->OwnershipStatus == EZoneOwnershipStatus::Shared)
-                {
-                    // Zone is available for material-level access
-                    Zone->OwnershipStatus = EZoneOwnershipStatus::Shared;
-                    Zone->ReaderCount.Increment();
-                    bAcquired = true;
-                }
-                else if (Zone->OwnershipStatus == EZoneOwnershipStatus::Exclusive && 
-                         Zone->OwnerThreadId.GetValue() == ThreadId)
-                {
-                    // We already own it exclusively
-                    bAcquired = true;
-                }
-                
-                Zone->Lock.Unlock();
-                break;
+            return false;
         }
+        bAcquired = Result != EZoneTryAcquireResult::Busy;
         
         // If not acquired, sleep briefly
         if (!bAcquired)
@@ -537,6 +473,274 @@ bool FZoneManager::AcquireZoneOwnership(int32 ZoneId, int32 ThreadId, EZoneAcces
     return bAcquired;
 }
 
+/**
+ * Makes one non-blocking attempt to take ownership of a zone
+ */
+FZoneManager::EZoneTryAcquireResult FZoneManager::TryAcquireZoneInternal(FZoneDescriptor* Zone, int32 ThreadId, EZoneAccessMode AccessMode)
+{
+    EZoneTryAcquireResult Result = EZoneTryAcquireResult::Busy;
+    
+    Zone->Lock.Lock();
+    
+    switch (AccessMode)
+    {
+        case EZoneAccessMode::ReadOnly:
+        case EZoneAccessMode::MaterialOnly:
+            // Read-only and material-only access can share with other readers
+            if (Zone->OwnershipStatus == EZoneOwnershipStatus::None || 
+                Zone->OwnershipStatus == EZoneOwnershipStatus::Shared)
+            {
+                // Zone is available for shared access
+                Zone->OwnershipStatus = EZoneOwnershipStatus::Shared;
+                Zone->ReaderCount.Increment();
+                Result = EZoneTryAcquireResult::Acquired;
+            }
+            else if (Zone->OwnershipStatus == EZoneOwnershipStatus::Exclusive && 
+                     Zone->OwnerThreadId.GetValue() == ThreadId)
+            {
+                // We already own it exclusively, so we can read too
+                Result = EZoneTryAcquireResult::AlreadyOwned;
+            }
+            break;
+            
+        case EZoneAccessMode::ReadWrite:
+        case EZoneAccessMode::Exclusive:
+            // Read-write and exclusive access need exclusive ownership with no readers
+            if (Zone->OwnershipStatus == EZoneOwnershipStatus::None)
+            {
+                // Zone is available
+                Zone->OwnershipStatus = EZoneOwnershipStatus::Exclusive;
+                Zone->OwnerThreadId.Set(ThreadId);
+                Result = EZoneTryAcquireResult::Acquired;
+            }
+            else if (Zone->OwnershipStatus == EZoneOwnershipStatus::Exclusive && 
+                     Zone->OwnerThreadId.GetValue() == ThreadId)
+            {
+                // We already own it
+                Result = EZoneTryAcquireResult::AlreadyOwned;
+            }
+            break;
+    }
+    
+    Zone->Lock.Unlock();
+    
+    return Result;
+}
+
+/**
+ * Resets an acquisition for a new request with sorted, deduplicated zone IDs
+ */
+void FZoneManager::PrepareZoneBatch(TArrayView<const int32> ZoneIds, int32 ThreadId, EZoneAccessMode AccessMode, FMultiZoneAcquisition& OutAcquisition)
+{
+    OutAcquisition = FMultiZoneAcquisition();
+    OutAcquisition.ThreadId = ThreadId;
+    OutAcquisition.AccessMode = AccessMode;
+    
+    // Canonical order: ascending zone ID with duplicates removed
+    OutAcquisition.ZoneIds.Reserve(ZoneIds.Num());
+    for (int32 ZoneId : ZoneIds)
+    {
+        OutAcquisition.ZoneIds.Add(ZoneId);
+    }
+    OutAcquisition.ZoneIds.Sort();
+    
+    int32 WriteIndex = 0;
+    for (int32 ReadIndex = 0; ReadIndex < OutAcquisition.ZoneIds.Num(); ++ReadIndex)
+    {
+        if (WriteIndex == 0 || OutAcquisition.ZoneIds[WriteIndex - 1] != OutAcquisition.ZoneIds[ReadIndex])
+        {
+            OutAcquisition.ZoneIds[WriteIndex++] = OutAcquisition.ZoneIds[ReadIndex];
+        }
+    }
+    OutAcquisition.ZoneIds.SetNum(WriteIndex, false);
+    OutAcquisition.AcquiredZoneIds.Reserve(OutAcquisition.ZoneIds.Num());
+}
+
+/**
+ * Looks up a zone and makes one ownership attempt while the zone map is locked
+ */
+FZoneManager::EZoneTryAcquireResult FZoneManager::TryAcquireZoneById(int32 ZoneId, int32 ThreadId, EZoneAccessMode AccessMode)
+{
+    FScopeLock Lock(&ZoneLock);
+    
+    FZoneDescriptor** ZonePtr = Zones.Find(ZoneId);
+    if (!ZonePtr || !(*ZonePtr))
+    {
+        return EZoneTryAcquireResult::Removed;
+    }
+    
+    return TryAcquireZoneInternal(*ZonePtr, ThreadId, AccessMode);
+}
+
+/**
+ * Makes one pass over a sorted zone set, rolling back on the first busy zone
+ */
+FZoneManager::EZoneTryAcquireResult FZoneManager::TryAcquireZoneBatch(FMultiZoneAcquisition& Acquisition)
+{
+    Acquisition.AttemptCount++;
+    Acquisition.AcquiredZoneIds.Reset();
+    Acquisition.ZonesHeld = 0;
+    
+    for (int32 ZoneId : Acquisition.ZoneIds)
+    {
+        EZoneTryAcquireResult Result = TryAcquireZoneById(ZoneId, Acquisition.ThreadId, Acquisition.AccessMode);
+        
+        if (Result == EZoneTryAcquireResult::Busy || Result == EZoneTryAcquireResult::Removed)
+        {
+            // Back off as a batch: drop everything taken in this pass, newest first
+            for (int32 Index = Acquisition.AcquiredZoneIds.Num() - 1; Index >= 0; --Index)
+            {
+                ReleaseZoneOwnership(Acquisition.AcquiredZoneIds[Index], Acquisition.ThreadId);
+            }
+            Acquisition.AcquiredZoneIds.Reset();
+            Acquisition.ZonesHeld = 0;
+            return Result;
+        }
+        
+        if (Result == EZoneTryAcquireResult::Acquired)
+        {
+            Acquisition.AcquiredZoneIds.Add(ZoneId);
+        }
+        Acquisition.ZonesHeld++;
+    }
+    
+    return EZoneTryAcquireResult::Acquired;
+}
+
+/**
+ * Acquires several zones as a batch without risking deadlock
+ */
+bool FZoneManager::AcquireZones(TArrayView<const int32> ZoneIds, int32 ThreadId, EZoneAccessMode AccessMode, FMultiZoneAcquisition& OutAcquisition, uint32 TimeoutMs)
+{
+    PrepareZoneBatch(ZoneIds, ThreadId, AccessMode, OutAcquisition);
+    
+    // Ensure we're initialized
+    if (!bIsInitialized)
+    {
+        return false;
+    }
+    
+    // Use default timeout if none specified
+    if (TimeoutMs == 0)
+    {
+        TimeoutMs = DefaultAcquisitionTimeoutMs;
+    }
+    
+    // Fail fast on unknown zones instead of backing off until the timeout
+    for (int32 ZoneId : OutAcquisition.ZoneIds)
+    {
+        if (!GetZone(ZoneId))
+        {
+            return false;
+        }
+    }
+    
+    double StartTime = FPlatformTime::Seconds();
+    double EndTime = StartTime + (TimeoutMs / 1000.0);
+    
+    // Exponential backoff between batch attempts: yield first, then sleep up to the cap
+    uint32 BackoffUs = MultiZoneInitialBackoffUs;
+    
+    EZoneTryAcquireResult BatchResult;
+    while ((BatchResult = TryAcquireZoneBatch(OutAcquisition)) != EZoneTryAcquireResult::Acquired)
+    {
+        double CurrentTime = FPlatformTime::Seconds();
+        
+        // A zone that was split or merged away will never become available
+        if (CurrentTime >= EndTime || BatchResult == EZoneTryAcquireResult::Removed)
+        {
+            OutAcquisition.WaitTimeMs = (CurrentTime - StartTime) * 1000.0;
+            return false;
+        }
+        
+        if (OutAcquisition.AttemptCount <= MultiZoneYieldAttempts)
+        {
+            FPlatformProcess::YieldThread();
+        }
+        else
+        {
+            // Add jitter so competing batches do not retry in lockstep
+            uint32 SleepUs = FMath::Min(BackoffUs, static_cast<uint32>((EndTime - CurrentTime) * 1000000.0));
+            SleepUs = static_cast<uint32>(FMath::RandRange(static_cast<int32>(SleepUs / 2), static_cast<int32>(FMath::Max(SleepUs, 1u))));
+            FPlatformProcess::Sleep(SleepUs / 1000000.0f);
+            BackoffUs = FMath::Min(BackoffUs * 2, MultiZoneMaxBackoffUs);
+        }
+    }
+    
+    OutAcquisition.AcquiredTime = FPlatformTime::Seconds();
+    OutAcquisition.WaitTimeMs = (OutAcquisition.AcquiredTime - StartTime) * 1000.0;
+    OutAcquisition.bAcquired = true;
+    
+    // Record access for every zone; a retried batch counts as a conflict so contention metrics see it
+    bool bHadConflict = OutAcquisition.AttemptCount > 1;
+    for (int32 ZoneId : OutAcquisition.ZoneIds)
+    {
+        RecordZoneAccess(ZoneId, ThreadId, 0.0, AccessMode != EZoneAccessMode::ReadOnly, bHadConflict);
+    }
+    
+    return true;
+}
+
+/**
+ * Attempts to acquire several zones in a single pass without waiting
+ */
+bool FZoneManager::TryAcquireZones(TArrayView<const int32> ZoneIds, int32 ThreadId, EZoneAccessMode AccessMode, FMultiZoneAcquisition& OutAcquisition)
+{
+    PrepareZoneBatch(ZoneIds, ThreadId, AccessMode, OutAcquisition);
+    
+    // Ensure we're initialized
+    if (!bIsInitialized)
+    {
+        return false;
+    }
+    
+    double StartTime = FPlatformTime::Seconds();
+    
+    if (TryAcquireZoneBatch(OutAcquisition) != EZoneTryAcquireResult::Acquired)
+    {
+        OutAcquisition.WaitTimeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+        return false;
+    }
+    
+    OutAcquisition.AcquiredTime = FPlatformTime::Seconds();
+    OutAcquisition.WaitTimeMs = (OutAcquisition.AcquiredTime - StartTime) * 1000.0;
+    OutAcquisition.bAcquired = true;
+    
+    for (int32 ZoneId : OutAcquisition.ZoneIds)
+    {
+        RecordZoneAccess(ZoneId, ThreadId, 0.0, AccessMode != EZoneAccessMode::ReadOnly, false);
+    }
+    
+    return true;
+}
+
+/**
+ * Releases zones previously taken with AcquireZones or TryAcquireZones
+ */
+bool FZoneManager::ReleaseZones(FMultiZoneAcquisition& Acquisition)
+{
+    if (!Acquisition.bAcquired)
+    {
+        return false;
+    }
+    
+    double ReleaseTime = FPlatformTime::Seconds();
+    Acquisition.HoldTimeMs = (ReleaseTime - Acquisition.AcquiredTime) * 1000.0;
+    
+    // Release in reverse canonical order
+    bool bAllReleased = true;
+    for (int32 Index = Acquisition.AcquiredZoneIds.Num() - 1; Index >= 0; --Index)
+    {
+        bAllReleased &= ReleaseZoneOwnership(Acquisition.AcquiredZoneIds[Index], Acquisition.ThreadId);
+    }
+    
+    Acquisition.AcquiredZoneIds.Reset();
+    Acquisition.ZonesHeld = 0;
+    Acquisition.bAcquired = false;
+    
+    return bAllReleased;
+}
+
 /**
  * Releases ownership of a zone
  */
@@ -669,44 +873,8 @@ TArray<int32> FZoneManager::GetZonesInRadius(const FVector& Position, float Radi
         return Result;
     }
     
-    FScopeLock Lock(&ZoneLock);
-    
-    // Calculate grid range based on radius
-    FIntVector CenterKey = ComputeSpatialKey(Position);
-    int32 GridRadius = FMath::CeilToInt(Radius / SpatialGridSize) + 1;
-    
-    // Check all grid cells in range
-    for (int32 X = CenterKey.X - GridRadius; X <= CenterKey.X + GridRadius; X++)
-    {
-        for (int32 Y = CenterKey.Y - GridRadius; Y <= CenterKey.Y + GridRadius; Y++)
-        {
-            for (int32 Z = CenterKey.Z - GridRadius; Z <= CenterKey.Z + GridRadius; Z++)
-            {
-                FIntVector Key(X, Y, Z);
-                
-                // Get zones in this cell
-                const TArray<int32>* ZonesInCell = SpatialLookup.Find(Key);
-                if (ZonesInCell)
-                {
-                    for (int32 ZoneId : *ZonesInCell)
-                    {
-                        const FZoneDescriptor* const* ZonePtr = Zones.Find(ZoneId);
-                        if (ZonePtr && *ZonePtr)
-                        {
-                            const FZoneDescriptor* Zone = *ZonePtr;
-                            
-                            // Check if zone center is within radius
-                            float Distance = FVector::Dist(Zone->Position, Position);
-                            if (Distance <= Radius)
-                            {
-                                Result.AddUnique(ZoneId);
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
+    // Lock-free walk of the cells intersecting the sphere; each zone lives in exactly one cell
+    SpatialHash.GatherInRadius(Position, Radius, Result);
     
     return Result;
 }
@@ -1194,32 +1362,55 @@ bool FZoneManager::SplitZone(int32 ZoneId)
         return false;
     }
     
-    // Get the zone
-    FZoneDescriptor* Zone = GetZone(ZoneId);
-    if (!Zone)
+    // Check if zone has high contention
+    FZoneMetrics Metrics = GetZoneMetrics(ZoneId);
+    if (!Metrics.bHighContention)
     {
         return false;
     }
     
-    // Check if zone has high contention
-    if (!Zone->Metrics.bHighContention)
+    TArray<int32> ChildZoneIds;
+    return SplitZoneIntoOctants(ZoneId, ChildZoneIds);
+}
+
+/**
+ * Splits a zone into eight octant zones, migrating versions atomically
+ */
+bool FZoneManager::SplitZoneIntoOctants(int32 ZoneId, TArray<int32>& OutChildZoneIds)
+{
+    OutChildZoneIds.Reset();
+    
+    // Ensure we're initialized
+    if (!bIsInitialized)
     {
         return false;
     }
     
-    // Only split if zone is currently not in use
-    if (Zone->OwnershipStatus != EZoneOwnershipStatus::None)
+    FScopeLock Lock(&ZoneLock);
+    
+    FZoneDescriptor** ZonePtr = Zones.Find(ZoneId);
+    if (!ZonePtr || !(*ZonePtr))
     {
         return false;
     }
     
-    FScopeLock Lock(&ZoneLock);
+    FZoneDescriptor* Zone = *ZonePtr;
+    
+    // Claim the zone so no thread can acquire it while versions are migrated
+    if (!BeginZoneTransition(Zone))
+    {
+        return false;
+    }
+    
+    // Children start one version past the parent so any read of the parent is stale,
+    // and inherit the parent's material versions unchanged
+    int32 ChildVersion = Zone->Version.GetValue() + 1;
     
     // Calculate dimensions for sub-zones
     FVector SubDimensions = Zone->Dimensions * 0.5f;
     
-    // Create 8 sub-zones (octree division)
-    TArray<int32> NewZoneIds;
+    // Build all 8 sub-zones (octree division) before publishing any of them
+    TArray<FZoneDescriptor*, TInlineAllocator<8>> Children;
     for (int32 X = 0; X < 2; X++)
     {
         for (int32 Y = 0; Y < 2; Y++)
@@ -1232,50 +1423,30 @@ bool FZoneManager::SplitZone(int32 ZoneId)
                     (Y - 0.5f) * SubDimensions.Y,
                     (Z - 0.5f) * SubDimensions.Z
                 );
-                FVector SubPosition = Zone->Position + Offset;
                 
-                // Create new zone
-                int32 NewZoneId = CreateZone(SubPosition, Zone->RegionId);
-                if (NewZoneId != INDEX_NONE)
+                FZoneDescriptor* Child = NewZoneDescriptor(Zone->Position + Offset, Zone->RegionId, SubDimensions);
+                Child->Version.Set(ChildVersion);
+                Child->MaterialIds = Zone->MaterialIds;
+                for (const auto& MaterialPair : Zone->MaterialVersions)
                 {
-                    NewZoneIds.Add(NewZoneId);
-                    
-                    // Update dimensions
-                    FZoneDescriptor* NewZone = GetZone(NewZoneId);
-                    if (NewZone)
-                    {
-                        NewZone->Dimensions = SubDimensions;
-                        
-                        // Copy material IDs from parent zone
-                        NewZone->MaterialIds = Zone->MaterialIds;
-                        
-                        // Create material version counters for the new zone
-                        for (int32 MaterialId : NewZone->MaterialIds)
-                        {
-                            GetOrCreateMaterialVersion(NewZone, MaterialId);
-                        }
-                    }
+                    GetOrCreateMaterialVersion(Child, MaterialPair.Key)->Set(MaterialPair.Value->GetValue());
                 }
+                
+                Children.Add(Child);
             }
         }
     }
     
-    // Check if all sub-zones were created successfully
-    if (NewZoneIds.Num() == 8)
+    // Publish the children and retire the parent in one ZoneLock critical section
+    for (FZoneDescriptor* Child : Children)
     {
-        // Remove the original zone
-        RemoveZone(ZoneId);
-        return true;
-    }
-    else
-    {
-        // Remove any partially created sub-zones
-        for (int32 NewZoneId : NewZoneIds)
-        {
-            RemoveZone(NewZoneId);
-        }
-        return false;
+        RegisterZone(Child);
+        OutChildZoneIds.Add(Child->ZoneId);
     }
+    
+    UnregisterZone(Zone);
+    
+    return true;
 }
 
 /**
@@ -1295,104 +1466,132 @@ bool FZoneManager::MergeZones(int32 ZoneId1, int32 ZoneId2)
         return false;
     }
     
-    // Get the zones
-    FZoneDescriptor* Zone1 = GetZone(ZoneId1);
-    FZoneDescriptor* Zone2 = GetZone(ZoneId2);
-    
-    if (!Zone1 || !Zone2)
-    {
-        return false;
-    }
-    
     // Check if both zones have low usage
-    if (Zone1->Metrics.bHighContention || Zone2->Metrics.bHighContention ||
-        Zone1->Metrics.bFrequentlyModified || Zone2->Metrics.bFrequentlyModified)
+    FZoneMetrics Metrics1 = GetZoneMetrics(ZoneId1);
+    FZoneMetrics Metrics2 = GetZoneMetrics(ZoneId2);
+    if (Metrics1.bHighContention || Metrics2.bHighContention ||
+        Metrics1.bFrequentlyModified || Metrics2.bFrequentlyModified)
     {
         return false;
     }
     
-    // Only merge if both zones are currently not in use
-    if (Zone1->OwnershipStatus != EZoneOwnershipStatus::None ||
-        Zone2->OwnershipStatus != EZoneOwnershipStatus::None)
+    return MergeZonesInto(ZoneId1, ZoneId2) != INDEX_NONE;
+}
+
+/**
+ * Merges two zones into a new zone covering both, migrating versions atomically
+ */
+int32 FZoneManager::MergeZonesInto(int32 ZoneId1, int32 ZoneId2)
+{
+    // Ensure we're initialized
+    if (!bIsInitialized || ZoneId1 == ZoneId2)
     {
-        return false;
+        return INDEX_NONE;
     }
     
     FScopeLock Lock(&ZoneLock);
     
-    // Create new zone at the midpoint between the two zones
-    FVector MergedPosition = (Zone1->Position + Zone2->Position) * 0.5f;
-    
-    // Calculate dimensions to encompass both zones
-    FVector Min = FVector(
-        FMath::Min(Zone1->Position.X - Zone1->Dimensions.X * 0.5f, Zone2->Position.X - Zone2->Dimensions.X * 0.5f),
-        FMath::Min(Zone1->Position.Y - Zone1->Dimensions.Y * 0.5f, Zone2->Position.Y - Zone2->Dimensions.Y * 0.5f),
-        FMath::Min(Zone1->Position.Z - Zone1->Dimensions.Z * 0.5f, Zone2->Position.Z - Zone2->Dimensions.Z * 0.5f)
-    );
-    
-    FVector Max = FVector(
-        FMath::Max(Zone1->Position.X + Zone1->Dimensions.X * 0.5f, Zone2->Position.X + Zone2->Dimensions.X * 0.5f),
-        FMath::Max(Zone1->Position.Y + Zone1->Dimensions.Y * 0.5f, Zone2->Position.Y + Zone2->Dimensions.Y * 0.5f),
-        FMath::Max(Zone1->Position.Z + Zone1->Dimensions.Z * 0.5f, Zone2->Position.Z + Zone2->Dimensions.Z * 0.5f)
-    );
-    
-    FVector MergedDimensions = Max - Min;
-    
-    // Create the merged zone
-    int32 MergedZoneId = CreateZone(MergedPosition, Zone1->RegionId);
-    if (MergedZoneId == INDEX_NONE)
+    FZoneDescriptor** ZonePtr1 = Zones.Find(ZoneId1);
+    FZoneDescriptor** ZonePtr2 = Zones.Find(ZoneId2);
+    if (!ZonePtr1 || !(*ZonePtr1) || !ZonePtr2 || !(*ZonePtr2))
     {
-        return false;
+        return INDEX_NONE;
     }
     
-    // Get the merged zone
-    FZoneDescriptor* MergedZone = GetZone(MergedZoneId);
-    if (!MergedZone)
+    FZoneDescriptor* Zone1 = *ZonePtr1;
+    FZoneDescriptor* Zone2 = *ZonePtr2;
+    
+    if (Zone1->RegionId != Zone2->RegionId)
     {
-        return false;
+        return INDEX_NONE;
     }
     
-    // Set merged zone dimensions
-    MergedZone->Dimensions = MergedDimensions;
-    
-    // Combine material IDs
-    TSet<int32> CombinedMaterials;
-    for (int32 MaterialId : Zone1->MaterialIds)
+    // Claim both zones in ascending ID order; roll back if the second is in use
+    FZoneDescriptor* First = ZoneId1 < ZoneId2 ? Zone1 : Zone2;
+    FZoneDescriptor* Second = ZoneId1 < ZoneId2 ? Zone2 : Zone1;
+    if (!BeginZoneTransition(First))
     {
-        CombinedMaterials.Add(MaterialId);
+        return INDEX_NONE;
     }
-    for (int32 MaterialId : Zone2->MaterialIds)
+    if (!BeginZoneTransition(Second))
     {
-        CombinedMaterials.Add(MaterialId);
+        CancelZoneTransition(First);
+        return INDEX_NONE;
     }
     
-    // Set combined materials
-    MergedZone->MaterialIds.Empty();
-    for (int32 MaterialId : CombinedMaterials)
-    {
-        MergedZone->MaterialIds.Add(MaterialId);
-    }
+    // Calculate bounds that encompass both zones
+    FVector Min = (Zone1->Position - Zone1->Dimensions * 0.5f).ComponentMin(Zone2->Position - Zone2->Dimensions * 0.5f);
+    FVector Max = (Zone1->Position + Zone1->Dimensions * 0.5f).ComponentMax(Zone2->Position + Zone2->Dimensions * 0.5f);
+    
+    FZoneDescriptor* MergedZone = NewZoneDescriptor((Min + Max) * 0.5f, Zone1->RegionId, Max - Min);
+    
+    // The merged zone is newer than either source
+    MergedZone->Version.Set(FMath::Max(Zone1->Version.GetValue(), Zone2->Version.GetValue()) + 1);
     
-    // Create material version counters for the merged zone
-    for (int32 MaterialId : MergedZone->MaterialIds)
+    // Combine material IDs, keeping the highest version of each material
+    for (FZoneDescriptor* Source : { Zone1, Zone2 })
     {
-        FThreadSafeCounter* VersionCounter = GetOrCreateMaterialVersion(MergedZone, MaterialId);
-        
-        // Set to maximum of the two zone's material versions
-        uint32 Version1 = GetMaterialVersion(ZoneId1, MaterialId);
-        uint32 Version2 = GetMaterialVersion(ZoneId2, MaterialId);
-        uint32 MaxVersion = FMath::Max(Version1, Version2);
+        for (int32 MaterialId : Source->MaterialIds)
+        {
+            MergedZone->MaterialIds.AddUnique(MaterialId);
+        }
         
-        if (MaxVersion > 1)
+        for (const auto& MaterialPair : Source->MaterialVersions)
         {
-            VersionCounter->Set(MaxVersion);
+            FThreadSafeCounter* VersionCounter = GetOrCreateMaterialVersion(MergedZone, MaterialPair.Key);
+            VersionCounter->Set(FMath::Max(VersionCounter->GetValue(), MaterialPair.Value->GetValue()));
         }
     }
     
-    // Remove the original zones
-    bool bSuccess = RemoveZone(ZoneId1) && RemoveZone(ZoneId2);
+    // Publish the merged zone and retire the sources in one ZoneLock critical section
+    RegisterZone(MergedZone);
+    UnregisterZone(Zone1);
+    UnregisterZone(Zone2);
+    
+    return MergedZone->ZoneId;
+}
+
+/**
+ * Claims an unowned zone for a structural change by moving it to the Transition state
+ */
+bool FZoneManager::BeginZoneTransition(FZoneDescriptor* Zone)
+{
+    FScopeLock ZoneStateLock(&Zone->Lock);
+    
+    if (Zone->OwnershipStatus != EZoneOwnershipStatus::None)
+    {
+        return false;
+    }
     
-    return bSuccess;
+    Zone->OwnershipStatus = EZoneOwnershipStatus::Transition;
+    return true;
+}
+
+/**
+ * Returns a zone claimed by BeginZoneTransition to the unowned state
+ */
+void FZoneManager::CancelZoneTransition(FZoneDescriptor* Zone)
+{
+    FScopeLock ZoneStateLock(&Zone->Lock);
+    Zone->OwnershipStatus = EZoneOwnershipStatus::None;
+}
+
+/**
+ * Gets the IDs of all zones
+ */
+TArray<int32> FZoneManager::GetAllZoneIds() const
+{
+    TArray<int32> Result;
+    
+    // Ensure we're initialized
+    if (!bIsInitialized)
+    {
+        return Result;
+    }
+    
+    FScopeLock Lock(&ZoneLock);
+    Zones.GetKeys(Result);
+    return Result;
 }
 
 /**
@@ -1475,6 +1674,78 @@ bool FZoneManager::ReorganizeZoneMaterials(int32 ZoneId)
     return true;
 }
 
+/**
+ * Replaces the rebalancer thresholds and starts or stops the rebalancer to match
+ */
+void FZoneManager::SetRebalancerConfig(const FZoneRebalancerConfig& InConfig)
+{
+    RebalancerConfig = InConfig;
+    
+    if (!bIsInitialized)
+    {
+        return;
+    }
+    
+    if (!RebalancerConfig.bEnabled)
+    {
+        StopRebalancer();
+    }
+    else if (Rebalancer.IsValid())
+    {
+        Rebalancer->SetConfig(RebalancerConfig);
+    }
+    else
+    {
+        StartRebalancer();
+    }
+}
+
+/**
+ * Gets the rebalancer configuration
+ */
+FZoneRebalancerConfig FZoneManager::GetRebalancerConfig() const
+{
+    return RebalancerConfig;
+}
+
+/**
+ * Gets statistics of the running rebalancer
+ */
+FZoneRebalancerStats FZoneManager::GetRebalancerStats() const
+{
+    return Rebalancer.IsValid() ? Rebalancer->GetStats() : FZoneRebalancerStats();
+}
+
+/**
+ * Creates and starts the rebalancer if the config enables it
+ */
+void FZoneManager::StartRebalancer()
+{
+    if (!RebalancerConfig.bEnabled || Rebalancer.IsValid())
+    {
+        return;
+    }
+    
+    Rebalancer = MakeUnique<FZoneRebalancer>(*this, RebalancerConfig);
+    if (!Rebalancer->Initialize())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("FZoneManager::StartRebalancer - Failed to start the rebalancer thread; zones will not be split or merged"));
+        Rebalancer.Reset();
+    }
+}
+
+/**
+ * Stops and destroys the rebalancer
+ */
+void FZoneManager::StopRebalancer()
+{
+    if (Rebalancer.IsValid())
+    {
+        Rebalancer->Shutdown();
+        Rebalancer.Reset();
+    }
+}
+
 /**
  * Gets an instance of the zone manager
  */
@@ -0,0 +1,383 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ZoneRebalancer.h"
+#include "ZoneManager.h"
+#include "EpochManager.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+// Tolerance used when comparing zone extents
+static const float ZoneAlignmentTolerance = 0.1f;
+
+FZoneRebalancer::FZoneRebalancer(FZoneManager& InZoneManager, const FZoneRebalancerConfig& InConfig)
+    : ZoneManager(InZoneManager)
+    , Config(InConfig)
+    , LastSampleTime(0.0)
+    , Thread(nullptr)
+    , ThreadEvent(nullptr)
+    , bShouldStop(false)
+{
+}
+
+FZoneRebalancer::~FZoneRebalancer()
+{
+    Shutdown();
+}
+
+bool FZoneRebalancer::Initialize()
+{
+    if (Thread)
+    {
+        return true;
+    }
+
+    bShouldStop = false;
+
+    // Create thread event
+    if (!ThreadEvent)
+    {
+        ThreadEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    }
+
+    // Create rebalancing thread
+    Thread = FRunnableThread::Create(this, TEXT("ZoneRebalancer"), 0, TPri_BelowNormal);
+
+    return Thread != nullptr;
+}
+
+void FZoneRebalancer::Shutdown()
+{
+    if (Thread)
+    {
+        bShouldStop = true;
+        ThreadEvent->Trigger();
+
+        Thread->WaitForCompletion();
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    if (ThreadEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(ThreadEvent);
+        ThreadEvent = nullptr;
+    }
+}
+
+bool FZoneRebalancer::Init()
+{
+    return true;
+}
+
+uint32 FZoneRebalancer::Run()
+{
+    while (!bShouldStop)
+    {
+        RunRebalancePass();
+
+        // Splits and merges retire descriptors on this thread; collect them while it holds no references
+        FEpochManager::Get().Quiesce();
+
+        // Wait for the next sample or an early wake-up on shutdown
+        uint32 WaitMs = static_cast<uint32>(FMath::Max(GetConfig().SampleIntervalSeconds, 0.01f) * 1000.0f);
+        ThreadEvent->Wait(WaitMs);
+    }
+
+    return 0;
+}
+
+void FZoneRebalancer::Stop()
+{
+    bShouldStop = true;
+
+    if (ThreadEvent)
+    {
+        ThreadEvent->Trigger();
+    }
+}
+
+void FZoneRebalancer::Exit()
+{
+}
+
+int32 FZoneRebalancer::RunRebalancePass()
+{
+    FScopeLock Lock(&RebalanceLock);
+
+    double CurrentTime = FPlatformTime::Seconds();
+    double ElapsedSeconds = LastSampleTime > 0.0 ? CurrentTime - LastSampleTime : 0.0;
+    LastSampleTime = CurrentTime;
+
+    SampleZones(CurrentTime, ElapsedSeconds);
+
+    // Splits take priority: relieving contention matters more than reclaiming cold zones
+    int32 Budget = Config.MaxOperationsPerPass;
+    int32 Operations = ApplySplits(CurrentTime, Budget);
+    Operations += ApplyMerges(CurrentTime, Budget);
+
+    Stats.PassCount++;
+    Stats.LastPassTimeMs = (FPlatformTime::Seconds() - CurrentTime) * 1000.0;
+
+    return Operations;
+}
+
+void FZoneRebalancer::SetConfig(const FZoneRebalancerConfig& InConfig)
+{
+    FScopeLock Lock(&RebalanceLock);
+    Config = InConfig;
+}
+
+FZoneRebalancerConfig FZoneRebalancer::GetConfig() const
+{
+    FScopeLock Lock(&RebalanceLock);
+    return Config;
+}
+
+FZoneRebalancerStats FZoneRebalancer::GetStats() const
+{
+    FScopeLock Lock(&RebalanceLock);
+    return Stats;
+}
+
+void FZoneRebalancer::SampleZones(double CurrentTime, double ElapsedSeconds)
+{
+    TArray<int32> ZoneIds = ZoneManager.GetAllZoneIds();
+
+    // Drop state for zones that were removed outside the rebalancer
+    TSet<int32> LiveZones(ZoneIds);
+    for (auto It = HeatStates.CreateIterator(); It; ++It)
+    {
+        if (!LiveZones.Contains(It.Key()))
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    for (int32 ZoneId : ZoneIds)
+    {
+        FZoneMetrics Metrics = ZoneManager.GetZoneMetrics(ZoneId);
+
+        FZoneHeatState* State = HeatStates.Find(ZoneId);
+        if (!State)
+        {
+            // First sight of this zone: establish a baseline only
+            FZoneHeatState& NewState = HeatStates.Add(ZoneId);
+            NewState.LastAccessCount = Metrics.AccessCount;
+            NewState.LastConflictCount = Metrics.ConflictCount;
+            continue;
+        }
+
+        if (ElapsedSeconds <= 0.0)
+        {
+            continue;
+        }
+
+        uint64 AccessDelta = Metrics.AccessCount - State->LastAccessCount;
+        uint64 ConflictDelta = Metrics.ConflictCount - State->LastConflictCount;
+        State->LastAccessCount = Metrics.AccessCount;
+        State->LastConflictCount = Metrics.ConflictCount;
+
+        float SampleAccessRate = static_cast<float>(AccessDelta / ElapsedSeconds);
+        float SampleConflictRate = AccessDelta > 0 ? static_cast<float>(ConflictDelta) / AccessDelta : 0.0f;
+
+        State->AccessRate = FMath::Lerp(State->AccessRate, SampleAccessRate, Config.SmoothingFactor);
+        State->ConflictRate = FMath::Lerp(State->ConflictRate, SampleConflictRate, Config.SmoothingFactor);
+
+        // Hysteresis: a hot streak only resets once the conflict rate falls well below the threshold
+        if (State->ConflictRate >= Config.SplitConflictRate && State->AccessRate >= Config.SplitMinAccessRate)
+        {
+            State->HotSamples++;
+        }
+        else if (State->ConflictRate < Config.SplitConflictRate * 0.5f)
+        {
+            State->HotSamples = 0;
+        }
+
+        if (State->AccessRate <= Config.MergeMaxAccessRate && State->ConflictRate < Config.SplitConflictRate * 0.5f)
+        {
+            State->ColdSamples++;
+        }
+        else
+        {
+            State->ColdSamples = 0;
+        }
+    }
+}
+
+int32 FZoneRebalancer::ApplySplits(double CurrentTime, int32& Budget)
+{
+    TArray<int32> Candidates;
+    for (const auto& Pair : HeatStates)
+    {
+        if (Pair.Value.HotSamples >= Config.SplitSustainSamples && CurrentTime >= Pair.Value.CooldownUntil)
+        {
+            Candidates.Add(Pair.Key);
+        }
+    }
+
+    // Hottest zones first so a limited budget goes where it helps most
+    Candidates.Sort([this](int32 A, int32 B)
+    {
+        return HeatStates[A].ConflictRate > HeatStates[B].ConflictRate;
+    });
+
+    int32 SplitCount = 0;
+    for (int32 ZoneId : Candidates)
+    {
+        if (Budget <= 0)
+        {
+            break;
+        }
+
+        // Copy the placement; the descriptor may be freed by a concurrent split, merge or removal
+        FZoneSnapshot Zone;
+        if (!ZoneManager.GetZoneSnapshot(ZoneId, Zone) || Zone.Dimensions.GetMin() * 0.5f < Config.MinSplitDimension)
+        {
+            continue;
+        }
+
+        TArray<int32> ChildZoneIds;
+        if (!ZoneManager.SplitZoneIntoOctants(ZoneId, ChildZoneIds))
+        {
+            // Zone is owned right now; it stays hot and is retried next pass
+            Stats.DeferredCount++;
+            continue;
+        }
+
+        HeatStates.Remove(ZoneId);
+        for (int32 ChildZoneId : ChildZoneIds)
+        {
+            HeatStates.Add(ChildZoneId).CooldownUntil = CurrentTime + Config.CooldownSeconds;
+        }
+
+        Stats.SplitCount++;
+        SplitCount++;
+        Budget--;
+    }
+
+    return SplitCount;
+}
+
+int32 FZoneRebalancer::ApplyMerges(double CurrentTime, int32& Budget)
+{
+    auto IsMergeCandidate = [this, CurrentTime](int32 ZoneId)
+    {
+        const FZoneHeatState* State = HeatStates.Find(ZoneId);
+        return State && State->ColdSamples >= Config.MergeSustainSamples && CurrentTime >= State->CooldownUntil;
+    };
+
+    TArray<int32> Candidates;
+    for (const auto& Pair : HeatStates)
+    {
+        if (IsMergeCandidate(Pair.Key))
+        {
+            Candidates.Add(Pair.Key);
+        }
+    }
+    Candidates.Sort();
+
+    TSet<int32> Consumed;
+    int32 MergeCount = 0;
+
+    for (int32 ZoneId : Candidates)
+    {
+        if (Budget <= 0)
+        {
+            break;
+        }
+
+        if (Consumed.Contains(ZoneId))
+        {
+            continue;
+        }
+
+        FZoneSnapshot Zone;
+        if (!ZoneManager.GetZoneSnapshot(ZoneId, Zone))
+        {
+            continue;
+        }
+
+        // Face neighbours of an equal-sized zone are one edge length away along a single axis
+        FVector Position = Zone.Position;
+        FVector Dimensions = Zone.Dimensions;
+        TArray<int32> Neighbours = ZoneManager.GetZonesInRadius(Position, Dimensions.GetMax() + ZoneAlignmentTolerance);
+        Neighbours.Sort();
+
+        for (int32 NeighbourId : Neighbours)
+        {
+            if (NeighbourId == ZoneId || Consumed.Contains(NeighbourId) || !IsMergeCandidate(NeighbourId))
+            {
+                continue;
+            }
+
+            FZoneSnapshot Neighbour;
+            if (!ZoneManager.GetZoneSnapshot(NeighbourId, Neighbour) || !AreZonesFaceAligned(Zone, Neighbour))
+            {
+                continue;
+            }
+
+            // MergeZonesInto re-checks both zones under ZoneLock, so a stale snapshot only costs a deferral
+            FVector MergedDimensions = Dimensions + (Neighbour.Position - Position).GetAbs();
+            if (MergedDimensions.GetMax() > Config.MaxMergedDimension + ZoneAlignmentTolerance)
+            {
+                continue;
+            }
+
+            int32 MergedZoneId = ZoneManager.MergeZonesInto(ZoneId, NeighbourId);
+            if (MergedZoneId == INDEX_NONE)
+            {
+                // One of the zones is owned or in a different region
+                Stats.DeferredCount++;
+                continue;
+            }
+
+            HeatStates.Remove(ZoneId);
+            HeatStates.Remove(NeighbourId);
+            HeatStates.Add(MergedZoneId).CooldownUntil = CurrentTime + Config.CooldownSeconds;
+            Consumed.Add(ZoneId);
+            Consumed.Add(NeighbourId);
+
+            Stats.MergeCount++;
+            MergeCount++;
+            Budget--;
+            break;
+        }
+    }
+
+    return MergeCount;
+}
+
+bool FZoneRebalancer::AreZonesFaceAligned(const FZoneSnapshot& Zone1, const FZoneSnapshot& Zone2)
+{
+    if (Zone1.RegionId != Zone2.RegionId)
+    {
+        return false;
+    }
+
+    if (!Zone1.Dimensions.Equals(Zone2.Dimensions, ZoneAlignmentTolerance))
+    {
+        return false;
+    }
+
+    // Centers must match on two axes and be exactly one edge length apart on the third
+    FVector Offset = (Zone2.Position - Zone1.Position).GetAbs();
+    int32 SeparatedAxes = 0;
+    for (int32 Axis = 0; Axis < 3; ++Axis)
+    {
+        if (FMath::IsNearlyEqual(Offset[Axis], 0.0f, ZoneAlignmentTolerance))
+        {
+            continue;
+        }
+
+        if (!FMath::IsNearlyEqual(Offset[Axis], Zone1.Dimensions[Axis], ZoneAlignmentTolerance))
+        {
+            return false;
+        }
+
+        SeparatedAxes++;
+    }
+
+    return SeparatedAxes == 1;
+}
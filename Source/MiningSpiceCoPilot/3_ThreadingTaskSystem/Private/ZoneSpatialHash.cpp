@@ -0,0 +1,450 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ZoneSpatialHash.h"
+#include "EpochManager.h"
+#include "HAL/UnrealMemory.h"
+
+// Initial slot capacity (power of two)
+static const uint64 InitialSpatialHashCapacity = 1024;
+
+// Resize once more than half of the slots have been used
+static const int32 SpatialHashMaxLoadDivisor = 2;
+
+// Fraction of a cell a box may reach into a neighbouring cell without overlapping it
+static const float CellOverlapTolerance = 0.001f;
+
+FZoneSpatialHash::FZoneSpatialHash(float InCellSize)
+    : CellSize(InCellSize)
+    , InvCellSize(1.0f / InCellSize)
+    , Table(AllocateTable(InitialSpatialHashCapacity))
+{
+}
+
+FZoneSpatialHash::~FZoneSpatialHash()
+{
+    // No readers may be active during destruction; retired memory belongs to the epoch manager
+    FTable* Current = Table.load(std::memory_order_acquire);
+    for (uint64 Index = 0; Index <= Current->Mask; ++Index)
+    {
+        FMemory::Free(Current->Slots[Index].Cell.load(std::memory_order_relaxed));
+    }
+    FreeTable(Current);
+}
+
+uint64 FZoneSpatialHash::SpreadBits(uint64 Value)
+{
+    Value &= 0x1fffff;
+    Value = (Value | (Value << 32)) & 0x1f00000000ffffull;
+    Value = (Value | (Value << 16)) & 0x1f0000ff0000ffull;
+    Value = (Value | (Value << 8)) & 0x100f00f00f00f00full;
+    Value = (Value | (Value << 4)) & 0x10c30c30c30c30c3ull;
+    Value = (Value | (Value << 2)) & 0x1249249249249249ull;
+    return Value;
+}
+
+uint64 FZoneSpatialHash::EncodeMorton(const FIntVector& Coord)
+{
+    return SpreadBits(static_cast<uint64>(Coord.X + CoordBias)) |
+           (SpreadBits(static_cast<uint64>(Coord.Y + CoordBias)) << 1) |
+           (SpreadBits(static_cast<uint64>(Coord.Z + CoordBias)) << 2);
+}
+
+FIntVector FZoneSpatialHash::ComputeCellCoord(const FVector& Position) const
+{
+    return FIntVector(
+        FMath::FloorToInt32(Position.X * InvCellSize),
+        FMath::FloorToInt32(Position.Y * InvCellSize),
+        FMath::FloorToInt32(Position.Z * InvCellSize)
+    );
+}
+
+void FZoneSpatialHash::ComputeOverlappedCells(const FVector& Position, const FVector& Extent, TArray<FIntVector>& OutCells) const
+{
+    OutCells.Reset();
+
+    // Boxes are half-open, and faces lying on a cell boundary do not reach into the next cell
+    FIntVector MinCell;
+    FIntVector MaxCell;
+    for (int32 Axis = 0; Axis < 3; ++Axis)
+    {
+        double Min = (Position[Axis] - Extent[Axis]) * InvCellSize + CellOverlapTolerance;
+        double Max = (Position[Axis] + Extent[Axis]) * InvCellSize - CellOverlapTolerance;
+        MinCell[Axis] = FMath::FloorToInt32(Min);
+        MaxCell[Axis] = FMath::Max(FMath::FloorToInt32(Max), MinCell[Axis]);
+    }
+
+    for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+    {
+        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+        {
+            for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+            {
+                OutCells.Add(FIntVector(X, Y, Z));
+            }
+        }
+    }
+}
+
+FZoneSpatialHash::FSlot* FZoneSpatialHash::FindSlot(const FTable* InTable, uint64 StoredKey)
+{
+    // Fold the high bits in but keep the low Morton bits so neighbouring cells land in nearby slots
+    uint64 Index = (StoredKey ^ (StoredKey >> 32)) & InTable->Mask;
+
+    for (;;)
+    {
+        FSlot& Slot = InTable->Slots[Index];
+        uint64 SlotKey = Slot.Key.load(std::memory_order_acquire);
+        if (SlotKey == StoredKey || SlotKey == 0)
+        {
+            return &Slot;
+        }
+        Index = (Index + 1) & InTable->Mask;
+    }
+}
+
+const FZoneSpatialHash::FCell* FZoneSpatialHash::FindCell(const FTable* InTable, const FIntVector& Coord)
+{
+    uint64 StoredKey = EncodeMorton(Coord) | OccupiedBit;
+    const FSlot* Slot = FindSlot(InTable, StoredKey);
+    if (Slot->Key.load(std::memory_order_acquire) != StoredKey)
+    {
+        return nullptr;
+    }
+    return Slot->Cell.load(std::memory_order_acquire);
+}
+
+FZoneSpatialHash::FCell* FZoneSpatialHash::AllocateCell(int32 Count)
+{
+    if (Count <= 0)
+    {
+        return nullptr;
+    }
+
+    SIZE_T Size = sizeof(FCell) + (Count - 1) * sizeof(FZoneSpatialEntry);
+    FCell* Cell = static_cast<FCell*>(FMemory::Malloc(Size, alignof(FCell)));
+    Cell->Count = Count;
+    return Cell;
+}
+
+FZoneSpatialHash::FTable* FZoneSpatialHash::AllocateTable(uint64 Capacity)
+{
+    FTable* NewTable = new FTable();
+    NewTable->Mask = Capacity - 1;
+    NewTable->UsedSlots = 0;
+    NewTable->LiveCells = 0;
+    NewTable->Slots = new FSlot[Capacity];
+
+    for (uint64 Index = 0; Index < Capacity; ++Index)
+    {
+        NewTable->Slots[Index].Key.store(0, std::memory_order_relaxed);
+        NewTable->Slots[Index].Cell.store(nullptr, std::memory_order_relaxed);
+    }
+
+    return NewTable;
+}
+
+void FZoneSpatialHash::FreeTable(FTable* InTable)
+{
+    if (InTable)
+    {
+        delete[] InTable->Slots;
+        delete InTable;
+    }
+}
+
+void FZoneSpatialHash::RetireCell(FCell* Cell)
+{
+    FEpochManager::Get().Retire(Cell, [](void* Pointer) { FMemory::Free(Pointer); });
+}
+
+void FZoneSpatialHash::RetireTable(FTable* InTable)
+{
+    FEpochManager::Get().Retire(InTable, [](void* Pointer) { FreeTable(static_cast<FTable*>(Pointer)); });
+}
+
+void FZoneSpatialHash::Insert(int32 ZoneId, const FVector& Position, FZoneDescriptor* Zone)
+{
+    Insert(ZoneId, Position, FVector::ZeroVector, ComputeCellCoord(Position), Zone);
+}
+
+void FZoneSpatialHash::Insert(int32 ZoneId, const FVector& Position, const FVector& Extent, const FIntVector& CellCoord, FZoneDescriptor* Zone)
+{
+    FTable* Current = Table.load(std::memory_order_relaxed);
+    uint64 StoredKey = EncodeMorton(CellCoord) | OccupiedBit;
+    FSlot* Slot = FindSlot(Current, StoredKey);
+
+    FCell* OldCell = Slot->Cell.load(std::memory_order_relaxed);
+    int32 OldCount = OldCell ? OldCell->Count : 0;
+
+    // Build the replacement cell with the new entry appended
+    FCell* NewCell = AllocateCell(OldCount + 1);
+    if (OldCount > 0)
+    {
+        FMemory::Memcpy(NewCell->Entries, OldCell->Entries, OldCount * sizeof(FZoneSpatialEntry));
+    }
+    NewCell->Entries[OldCount].ZoneId = ZoneId;
+    NewCell->Entries[OldCount].Position = Position;
+    NewCell->Entries[OldCount].Extent = Extent;
+    NewCell->Entries[OldCount].Zone = Zone;
+
+    // Publish the cell before the key so a reader that sees the key also sees the cell
+    Slot->Cell.store(NewCell, std::memory_order_release);
+    if (Slot->Key.load(std::memory_order_relaxed) == 0)
+    {
+        Slot->Key.store(StoredKey, std::memory_order_release);
+        Current->UsedSlots++;
+    }
+
+    if (OldCell)
+    {
+        RetireCell(OldCell);
+    }
+    else
+    {
+        Current->LiveCells++;
+    }
+
+    MaybeResize();
+}
+
+bool FZoneSpatialHash::Remove(int32 ZoneId, const FIntVector& CellCoord)
+{
+    FTable* Current = Table.load(std::memory_order_relaxed);
+    uint64 StoredKey = EncodeMorton(CellCoord) | OccupiedBit;
+    FSlot* Slot = FindSlot(Current, StoredKey);
+
+    FCell* OldCell = Slot->Key.load(std::memory_order_relaxed) == StoredKey ?
+        Slot->Cell.load(std::memory_order_relaxed) : nullptr;
+    if (!OldCell)
+    {
+        return false;
+    }
+
+    int32 RemoveIndex = INDEX_NONE;
+    for (int32 Index = 0; Index < OldCell->Count; ++Index)
+    {
+        if (OldCell->Entries[Index].ZoneId == ZoneId)
+        {
+            RemoveIndex = Index;
+            break;
+        }
+    }
+
+    if (RemoveIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    // Build the replacement cell without the entry; an empty cell is published as nullptr
+    FCell* NewCell = AllocateCell(OldCell->Count - 1);
+    if (NewCell)
+    {
+        int32 WriteIndex = 0;
+        for (int32 Index = 0; Index < OldCell->Count; ++Index)
+        {
+            if (Index != RemoveIndex)
+            {
+                NewCell->Entries[WriteIndex++] = OldCell->Entries[Index];
+            }
+        }
+    }
+    else
+    {
+        Current->LiveCells--;
+    }
+
+    Slot->Cell.store(NewCell, std::memory_order_release);
+    RetireCell(OldCell);
+
+    return true;
+}
+
+void FZoneSpatialHash::Reset()
+{
+    FTable* OldTable = Table.load(std::memory_order_relaxed);
+    Table.store(AllocateTable(InitialSpatialHashCapacity), std::memory_order_release);
+
+    for (uint64 Index = 0; Index <= OldTable->Mask; ++Index)
+    {
+        FCell* Cell = OldTable->Slots[Index].Cell.load(std::memory_order_relaxed);
+        if (Cell)
+        {
+            RetireCell(Cell);
+        }
+    }
+    RetireTable(OldTable);
+}
+
+void FZoneSpatialHash::MaybeResize()
+{
+    FTable* Current = Table.load(std::memory_order_relaxed);
+    uint64 Capacity = Current->Mask + 1;
+    if (static_cast<uint64>(Current->UsedSlots) * SpatialHashMaxLoadDivisor <= Capacity)
+    {
+        return;
+    }
+
+    // Size for live cells only; slots left behind by emptied cells are compacted away
+    uint64 NewCapacity = InitialSpatialHashCapacity;
+    while (NewCapacity < static_cast<uint64>(Current->LiveCells) * 4)
+    {
+        NewCapacity <<= 1;
+    }
+
+    // Cells are immutable, so the new table can point at the same cells
+    FTable* NewTable = AllocateTable(NewCapacity);
+    for (uint64 Index = 0; Index < Capacity; ++Index)
+    {
+        FSlot& OldSlot = Current->Slots[Index];
+        FCell* Cell = OldSlot.Cell.load(std::memory_order_relaxed);
+        if (Cell)
+        {
+            uint64 StoredKey = OldSlot.Key.load(std::memory_order_relaxed);
+            FSlot* NewSlot = FindSlot(NewTable, StoredKey);
+            NewSlot->Cell.store(Cell, std::memory_order_relaxed);
+            NewSlot->Key.store(StoredKey, std::memory_order_relaxed);
+            NewTable->UsedSlots++;
+            NewTable->LiveCells++;
+        }
+    }
+
+    Table.store(NewTable, std::memory_order_release);
+    RetireTable(Current);
+}
+
+FZoneDescriptor* FZoneSpatialHash::FindClosestInCell(const FVector& Position) const
+{
+    FZoneSpatialEntry Entry;
+    return FindClosestEntry(Position, Entry) ? Entry.Zone : nullptr;
+}
+
+int32 FZoneSpatialHash::FindClosestZoneIdInCell(const FVector& Position) const
+{
+    FZoneSpatialEntry Entry;
+    return FindClosestEntry(Position, Entry) ? Entry.ZoneId : INDEX_NONE;
+}
+
+bool FZoneSpatialHash::FindClosestEntry(const FVector& Position, FZoneSpatialEntry& OutEntry) const
+{
+    FEpochGuard Guard;
+
+    const FCell* Cell = FindCell(Table.load(std::memory_order_acquire), ComputeCellCoord(Position));
+    if (!Cell)
+    {
+        return false;
+    }
+
+    double ClosestDistSq = MAX_dbl;
+    int32 ClosestIndex = INDEX_NONE;
+    bool bClosestContains = false;
+
+    // A zone larger than a cell can have its center further away than a neighbour's
+    // center while still containing the position, so containment wins over distance
+    for (int32 Index = 0; Index < Cell->Count; ++Index)
+    {
+        const FZoneSpatialEntry& Entry = Cell->Entries[Index];
+        const FVector Offset = (Position - Entry.Position).GetAbs();
+        const bool bContains = !Entry.Extent.IsZero() &&
+            Offset.X <= Entry.Extent.X && Offset.Y <= Entry.Extent.Y && Offset.Z <= Entry.Extent.Z;
+        if (bClosestContains && !bContains)
+        {
+            continue;
+        }
+
+        double DistSq = Offset.SizeSquared();
+        if (DistSq < ClosestDistSq || (bContains && !bClosestContains))
+        {
+            ClosestDistSq = DistSq;
+            ClosestIndex = Index;
+            bClosestContains = bContains;
+        }
+    }
+
+    if (ClosestIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    // Copy while the pin keeps the cell alive
+    OutEntry = Cell->Entries[ClosestIndex];
+    return true;
+}
+
+void FZoneSpatialHash::GatherInRadius(const FVector& Position, float Radius, TArray<int32>& OutZoneIds) const
+{
+    if (Radius < 0.0f)
+    {
+        return;
+    }
+
+    FEpochGuard Guard;
+    const FTable* Current = Table.load(std::memory_order_acquire);
+
+    const double RadiusSq = static_cast<double>(Radius) * Radius;
+
+    // Squared distance from a coordinate to the cell interval [Cell, Cell + 1) along one axis
+    auto AxisDistSq = [this](double Value, int32 CellIndex) -> double
+    {
+        double Min = CellIndex * static_cast<double>(CellSize);
+        double Max = Min + CellSize;
+        double Delta = Value < Min ? Min - Value : (Value > Max ? Value - Max : 0.0);
+        return Delta * Delta;
+    };
+
+    // Walk only cells whose bounds intersect the sphere: the Y span shrinks with the X
+    // distance and the Z span is solved directly from what remains of the radius
+    int32 MinX = FMath::FloorToInt32((Position.X - Radius) * InvCellSize);
+    int32 MaxX = FMath::FloorToInt32((Position.X + Radius) * InvCellSize);
+
+    for (int32 X = MinX; X <= MaxX; ++X)
+    {
+        double RemainingX = RadiusSq - AxisDistSq(Position.X, X);
+        if (RemainingX < 0.0)
+        {
+            continue;
+        }
+
+        double ExtentY = FMath::Sqrt(RemainingX);
+        int32 MinY = FMath::FloorToInt32((Position.Y - ExtentY) * InvCellSize);
+        int32 MaxY = FMath::FloorToInt32((Position.Y + ExtentY) * InvCellSize);
+
+        for (int32 Y = MinY; Y <= MaxY; ++Y)
+        {
+            double RemainingY = RemainingX - AxisDistSq(Position.Y, Y);
+            if (RemainingY < 0.0)
+            {
+                continue;
+            }
+
+            double ExtentZ = FMath::Sqrt(RemainingY);
+            int32 MinZ = FMath::FloorToInt32((Position.Z - ExtentZ) * InvCellSize);
+            int32 MaxZ = FMath::FloorToInt32((Position.Z + ExtentZ) * InvCellSize);
+
+            for (int32 Z = MinZ; Z <= MaxZ; ++Z)
+            {
+                const FCell* Cell = FindCell(Current, FIntVector(X, Y, Z));
+                if (!Cell)
+                {
+                    continue;
+                }
+
+                for (int32 Index = 0; Index < Cell->Count; ++Index)
+                {
+                    // Zones spanning several cells are reported only from the cell holding their center
+                    const FZoneSpatialEntry& Entry = Cell->Entries[Index];
+                    if (FVector::DistSquared(Entry.Position, Position) <= RadiusSq &&
+                        ComputeCellCoord(Entry.Position) == FIntVector(X, Y, Z))
+                    {
+                        OutZoneIds.Add(Entry.ZoneId);
+                    }
+                }
+            }
+        }
+    }
+}
+
+int32 FZoneSpatialHash::GetCellCount() const
+{
+    FEpochGuard Guard;
+    return Table.load(std::memory_order_acquire)->LiveCells;
+}
@@ -0,0 +1,138 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformProcess.h"
+#include <atomic>
+
+/**
+ * Shared waiting strategy for the threading module's word-sized locks
+ *
+ * A lock word is Unlocked, Locked, or LockedWithWaiters. Acquisition is a single CAS when the
+ * lock is free. Under contention the waiter spins with exponential PAUSE backoff, bounded by a
+ * per-lock budget learned from how long recent waiters had to spin before the owner released,
+ * and then parks on the lock word's address. Unlock only pays for a wake when a waiter has
+ * parked, so a lock that is held briefly never enters the kernel and a lock that is held for a
+ * long time stops burning cores almost immediately.
+ *
+ * Parking is a futex-style address wait: threads sleep in a hashed table of wait queues keyed by
+ * address and re-check the lock word under the queue lock, so a release can never be missed.
+ */
+class MININGSPICECOPILOT_API FAdaptiveSpinWait
+{
+public:
+    /** Lock word values */
+    static constexpr int32 Unlocked = 0;
+    static constexpr int32 Locked = 1;
+    static constexpr int32 LockedWithWaiters = 2;
+
+    /** Spin budget bounds in PAUSE iterations */
+    static constexpr uint32 MinSpinBudget = 16;
+    static constexpr uint32 MaxSpinBudget = 8192;
+
+    /** Longest single backoff step in PAUSE iterations */
+    static constexpr uint32 MaxBackoff = 64;
+
+    /**
+     * Learned spin budget for one lock
+     * Holds a running average of the PAUSE iterations recent waiters spent before acquiring
+     */
+    struct FSpinBudget
+    {
+        std::atomic<uint32> AverageSpins{MinSpinBudget};
+    };
+
+    /**
+     * Tries to acquire a lock word without waiting
+     * @param State Lock word
+     * @return True if the lock was acquired
+     */
+    static FORCEINLINE bool TryLock(std::atomic<int32>& State)
+    {
+        int32 Expected = Unlocked;
+        return State.load(std::memory_order_relaxed) == Unlocked &&
+            State.compare_exchange_strong(Expected, Locked, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    /**
+     * Acquires a lock word, spinning and then parking
+     * @param State Lock word
+     * @param Budget Spin budget of the lock
+     */
+    static FORCEINLINE void Lock(std::atomic<int32>& State, FSpinBudget& Budget)
+    {
+        if (!TryLock(State))
+        {
+            LockSlow(State, Budget, 0);
+        }
+    }
+
+    /**
+     * Acquires a lock word with a timeout
+     * @param State Lock word
+     * @param Budget Spin budget of the lock
+     * @param TimeoutMs Maximum time to wait in milliseconds (0 for no timeout)
+     * @return True if the lock was acquired
+     */
+    static FORCEINLINE bool Lock(std::atomic<int32>& State, FSpinBudget& Budget, uint32 TimeoutMs)
+    {
+        return TryLock(State) || LockSlow(State, Budget, TimeoutMs);
+    }
+
+    /**
+     * Releases a lock word and wakes one parked waiter if there is one
+     * @param State Lock word
+     */
+    static FORCEINLINE void Unlock(std::atomic<int32>& State)
+    {
+        if (State.exchange(Unlocked, std::memory_order_release) == LockedWithWaiters)
+        {
+            WakeOne(&State);
+        }
+    }
+
+    /**
+     * Contended acquisition path
+     * @param State Lock word
+     * @param Budget Spin budget of the lock
+     * @param TimeoutMs Maximum time to wait in milliseconds (0 for no timeout)
+     * @return True if the lock was acquired
+     */
+    static bool LockSlow(std::atomic<int32>& State, FSpinBudget& Budget, uint32 TimeoutMs);
+
+    /**
+     * Sleeps while an address holds the expected value
+     * Returns immediately if the value already differs; may also return spuriously
+     * @param Address Address to wait on
+     * @param Expected Value to sleep on
+     * @param TimeoutMs Maximum time to sleep in milliseconds (0 for no timeout)
+     * @return False if the wait timed out
+     */
+    static bool WaitOnAddress(const std::atomic<int32>& Address, int32 Expected, uint32 TimeoutMs = 0);
+
+    /**
+     * Wakes one thread sleeping on an address
+     * @param Address Address passed to WaitOnAddress
+     * @return True if a thread was woken
+     */
+    static bool WakeOne(const void* Address);
+
+    /**
+     * Wakes every thread sleeping on an address
+     * @param Address Address passed to WaitOnAddress
+     * @return Number of threads woken
+     */
+    static int32 WakeAll(const void* Address);
+
+    /**
+     * Gets the spin limit currently derived from a budget
+     * @param Budget Spin budget of a lock
+     * @return Maximum PAUSE iterations a waiter spends before parking
+     */
+    static FORCEINLINE uint32 GetSpinLimit(const FSpinBudget& Budget)
+    {
+        // Allow twice the recent average so the budget can grow back when hold times lengthen
+        return FMath::Min(Budget.AverageSpins.load(std::memory_order_relaxed) * 2 + MinSpinBudget, MaxSpinBudget);
+    }
+};
@@ -13,11 +13,59 @@
 #include "Containers/Queue.h"
 // #include "Misc/Ticker.h"
 #include "Tickable.h" // Replace with Tickable.h which should contain the ticker functionality
+#include <atomic>
 
 // Forward declarations 
 class FAsyncOperationImpl;
 template<class TTask> class FAsyncTask;
 
+/**
+ * Thread that operation callbacks run on
+ */
+enum class EAsyncCallbackThread : uint8
+{
+    /** Queued and run on the game thread at the next FAsyncTaskManager::ProcessGameThreadCallbacks */
+    GameThread,
+    
+    /** Run immediately on the thread that completed the operation or reported the progress */
+    CompletingThread
+};
+
+/**
+ * Counters for callback dispatch
+ */
+struct MININGSPICECOPILOT_API FAsyncDispatchStats
+{
+    /** Completion callbacks run */
+    uint64 CompletionsDispatched;
+    
+    /** Completion callbacks that went through the game thread queue */
+    uint64 CompletionsQueued;
+    
+    /** Average time from completion to the callback running (milliseconds) */
+    double AverageCompletionLatencyMs;
+    
+    /** Longest time from completion to the callback running (milliseconds) */
+    double MaxCompletionLatencyMs;
+    
+    /** Progress reports made by operations with a game thread progress callback */
+    uint64 ProgressReported;
+    
+    /** Progress callbacks run on the game thread; reports made while one was queued are merged into it */
+    uint64 ProgressDispatched;
+    
+    /** Constructor */
+    FAsyncDispatchStats()
+        : CompletionsDispatched(0)
+        , CompletionsQueued(0)
+        , AverageCompletionLatencyMs(0.0)
+        , MaxCompletionLatencyMs(0.0)
+        , ProgressReported(0)
+        , ProgressDispatched(0)
+    {
+    }
+};
+
 /**
  * Async operation implementation class
  */
@@ -57,11 +105,14 @@ public:
     /** Gets the operation result */
     FAsyncResult GetResult() const;
     
-    /** Registers a progress callback */
-    bool RegisterProgressCallback(const FAsyncProgressDelegate& Callback, uint32 UpdateIntervalMs);
+    /**
+     * Registers a progress callback
+     * @param UpdateIntervalMs Minimum time between callbacks (at least 10 ms); reports made sooner are dropped
+     */
+    bool RegisterProgressCallback(const FAsyncProgressDelegate& Callback, uint32 UpdateIntervalMs, EAsyncCallbackThread CallbackThread = EAsyncCallbackThread::GameThread);
     
     /** Registers a completion callback */
-    bool RegisterCompletionCallback(const FAsyncCompletionDelegate& Callback);
+    bool RegisterCompletionCallback(const FAsyncCompletionDelegate& Callback, EAsyncCallbackThread CallbackThread = EAsyncCallbackThread::GameThread);
     
     /** Sets the operation parameters */
     void SetParameters(const TMap<FString, FString>& Params);
@@ -78,9 +129,35 @@ public:
     /** Called when the operation completes */
     void NotifyCompletion();
     
-    /** Called to trigger progress callbacks */
+    /** Called to trigger progress callbacks, at most once per update interval; must not be called with StateLock held */
     void NotifyProgress();
     
+    /** Runs the progress callback queued by NotifyProgress with the latest progress (game thread) */
+    void DispatchQueuedProgress();
+    
+    /** Continuation handler, given the status and result the operation ended with */
+    typedef TFunction<void(EAsyncStatus, FAsyncResult&&)> FContinuationHandler;
+    
+    /**
+     * Registers a handler to run once when the operation ends
+     * Runs immediately on the calling thread if the operation has already ended. An operation with a
+     * single handler moves its result into it; GetResult afterwards keeps only the success flags and
+     * error code. With several handlers each gets a copy.
+     */
+    void AddContinuation(FContinuationHandler Handler);
+    
+    /** Runs the continuation handlers; only the first call after the operation ends has any effect */
+    void FireContinuations();
+    
+    /**
+     * Ends the operation with a status and result, then notifies completion and continuations
+     * @return False if the operation had already ended
+     */
+    bool Resolve(EAsyncStatus FinalStatus, FAsyncResult&& FinalResult);
+    
+    /** Checks whether the operation has ended */
+    bool IsFinished() const;
+    
     /** Gets the creation time of this operation */
     double GetCreationTime() const;
     
@@ -96,7 +173,7 @@ public:
     /** Sets the completion time */
     void SetCompletionTime(double Time);
     
-    /** Checks if a progress update is due */
+    /** Checks if the progress update interval has passed since the last notification */
     bool IsProgressUpdateDue() const;
 
 protected:
@@ -127,13 +204,28 @@ protected:
     /** Completion callback */
     FAsyncCompletionDelegate CompletionCallback;
     
+    /** Thread the progress callback runs on */
+    EAsyncCallbackThread ProgressCallbackThread;
+    
+    /** Thread the completion callback runs on */
+    EAsyncCallbackThread CompletionCallbackThread;
+    
+    /** Whether a progress update is waiting in the game thread queue */
+    FThreadSafeBool bProgressQueued;
+    
+    /** Handlers to run when the operation ends */
+    TArray<FContinuationHandler> Continuations;
+    
+    /** Whether the continuation handlers have run */
+    bool bContinuationsFired;
+    
     /** Lock for state access */
     mutable FCriticalSection StateLock;
     
     /** Progress update interval in seconds */
     double ProgressUpdateIntervalSeconds;
     
-    /** Last progress update time */
+    /** Time of the last progress notification that passed the update interval */
     double LastProgressUpdateTime;
     
     /** Creation time */
@@ -259,6 +351,9 @@ public:
     virtual TArray<uint64> GetActiveOperations() const override;
     virtual TArray<uint64> GetOperationsOfType(const FString& OperationType) const override;
     virtual uint32 CleanupCompletedOperations(double MaxAgeSeconds = 300.0) override;
+    virtual uint64 Then(uint64 AntecedentId, FAsyncContinuation Continuation, bool bRunOnFailure = false) override;
+    virtual uint64 WhenAll(const TArray<uint64>& OperationIds) override;
+    virtual uint64 WhenAny(const TArray<uint64>& OperationIds) override;
     
     static IAsyncOperation& Get();
     //~ End IAsyncOperation Interface
@@ -269,9 +364,6 @@ public:
     /** Gets all registered operation types */
     TArray<FString> GetRegisteredOperationTypes() const;
     
-    /** Updates progress for all active operations */
-    void UpdateOperations();
-    
     /** Gets operation by ID */
     FAsyncOperationImpl* GetOperationById(uint64 OperationId) const;
     
@@ -280,6 +372,38 @@ public:
     
     /** Creates a delta between two progress updates */
     static FString CreateProgressDelta(const FAsyncProgress& Previous, const FAsyncProgress& Current);
+    
+    /** Registers a progress callback that runs on the given thread */
+    bool RegisterProgressCallback(uint64 OperationId, const FAsyncProgressDelegate& Callback, uint32 UpdateIntervalMs, EAsyncCallbackThread CallbackThread);
+    
+    /** Registers a completion callback that runs on the given thread */
+    bool RegisterCompletionCallback(uint64 OperationId, const FAsyncCompletionDelegate& Callback, EAsyncCallbackThread CallbackThread);
+    
+    /**
+     * Runs the callbacks queued for the game thread
+     * Called every frame from Tick; call it at any other game thread sync point to deliver
+     * completions sooner. Must only be called on the game thread.
+     * @return Number of callbacks run
+     */
+    int32 ProcessGameThreadCallbacks();
+    
+    /** Queues a completion callback for the game thread (any thread) */
+    void PostCompletion(uint64 OperationId, const FAsyncCompletionDelegate& Callback, const FAsyncResult& Result, double CompletionTime);
+    
+    /** Queues a progress callback for the game thread (any thread); the caller coalesces repeats */
+    void PostProgress(uint64 OperationId);
+    
+    /** Records that a completion callback ran */
+    void RecordCompletionDispatched(double CompletionTime);
+    
+    /** Records a progress report from an operation with a game thread progress callback */
+    void RecordProgressReported();
+    
+    /** Gets callback dispatch counters */
+    FAsyncDispatchStats GetDispatchStats() const;
+    
+    /** Resets callback dispatch counters */
+    void ResetDispatchStats();
 
     //~ Begin FTickableGameObject Interface
     virtual void Tick(float DeltaTime) override;
@@ -314,9 +438,38 @@ private:
     /** Timer handle for periodic updates */
     FDelegateHandle UpdateTimerHandle;
     
+    /** Callback queued for the game thread */
+    struct FQueuedCallback
+    {
+        /** Operation the callback belongs to */
+        uint64 OperationId;
+        
+        /** Whether this is a completion; otherwise the operation's latest progress is delivered */
+        bool bCompletion;
+        
+        /** Completion callback and its arguments */
+        FAsyncCompletionDelegate CompletionCallback;
+        FAsyncResult Result;
+        double CompletionTime;
+    };
+    
+    /** Callbacks posted by worker threads, drained on the game thread */
+    TQueue<FQueuedCallback, EQueueMode::Mpsc> GameThreadCallbacks;
+    
+    /** Dispatch counters */
+    std::atomic<uint64> CompletionsDispatched;
+    std::atomic<uint64> CompletionsQueued;
+    std::atomic<uint64> TotalCompletionLatencyUs;
+    std::atomic<uint64> MaxCompletionLatencyUs;
+    std::atomic<uint64> ProgressReported;
+    std::atomic<uint64> ProgressDispatched;
+    
     /** Generates a unique operation ID */
     uint64 GenerateOperationId();
     
+    /** Adds an operation created by the manager itself (continuations and combinators) */
+    void AddInternalOperation(FAsyncOperationImpl* Operation);
+    
     /** Moves an operation to completed state */
     void MoveToCompleted(FAsyncOperationImpl* Operation);
     
@@ -325,7 +478,4 @@ private:
     
     /** Ticker callback for updating operations */
     bool TickUpdateOperations(float DeltaTime);
-
-    /** Update interval in seconds */
-    float TickInterval;
 };
\ No newline at end of file
@@ -0,0 +1,154 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * CSG operation applied to a signed distance field (negative values are inside material)
+ */
+enum class ECommutativeOpType : uint8
+{
+    /** Adds material: min(Field, Shape) */
+    Union,
+
+    /** Carves material away: max(Field, -Shape) */
+    Subtraction,
+
+    /** Keeps material inside the shape: max(Field, Shape) */
+    Intersection
+};
+
+/**
+ * Primitive shape used by a field operation
+ */
+enum class ECommutativeOpShape : uint8
+{
+    /** Sphere; Extent.X is the radius */
+    Sphere,
+
+    /** Axis-aligned box; Extent is the half size */
+    Box
+};
+
+/**
+ * Commutativity class of a field operation
+ * Operations in the same class commute with each other, so they can be replayed in any order
+ */
+enum class ECommutativeOpClass : uint8
+{
+    /** Pointwise minimum (Union) */
+    Min,
+
+    /** Pointwise maximum (Subtraction, Intersection) */
+    Max,
+
+    /** Write that cannot be reordered (no operation log, or mixed classes) */
+    NonCommutative
+};
+
+/**
+ * Logged CSG operation on a zone's distance field
+ * Every operation is a pointwise min or max against the shape's distance inside its bounds and
+ * the identity outside them, so operations of the same class produce the same field whatever
+ * order they are applied in. Transactions carrying such logs can be merged on conflict by
+ * replaying them on top of the newer state.
+ */
+struct MININGSPICECOPILOT_API FCommutativeFieldOp
+{
+    /** ID of the zone being edited */
+    int32 ZoneId;
+
+    /** ID of the material channel being edited (INDEX_NONE for the zone's shared field) */
+    int32 MaterialId;
+
+    /** CSG operation */
+    ECommutativeOpType OperationType;
+
+    /** Primitive shape */
+    ECommutativeOpShape Shape;
+
+    /** Shape center in world space */
+    FVector Center;
+
+    /** Shape extent (radius in X for spheres, half size for boxes) */
+    FVector Extent;
+
+    /** World-space region the operation may modify */
+    FBox Bounds;
+
+    /** Constructor */
+    FCommutativeFieldOp()
+        : ZoneId(INDEX_NONE)
+        , MaterialId(INDEX_NONE)
+        , OperationType(ECommutativeOpType::Subtraction)
+        , Shape(ECommutativeOpShape::Sphere)
+        , Center(FVector::ZeroVector)
+        , Extent(FVector::ZeroVector)
+        , Bounds(ForceInit)
+    {
+    }
+
+    /**
+     * Creates a sphere operation whose bounds cover the sphere plus a band around it
+     * (or the whole field for an intersection)
+     * @param InZoneId Zone being edited
+     * @param InOperationType CSG operation
+     * @param InCenter Sphere center
+     * @param Radius Sphere radius
+     * @param BandWidth Distance outside the surface that is also updated
+     * @param InMaterialId Material channel (INDEX_NONE for the shared field)
+     * @return Operation description
+     */
+    static FCommutativeFieldOp MakeSphere(int32 InZoneId, ECommutativeOpType InOperationType, const FVector& InCenter, float Radius, float BandWidth, int32 InMaterialId = INDEX_NONE);
+
+    /**
+     * Creates a box operation whose bounds cover the box plus a band around it
+     * (or the whole field for an intersection)
+     * @param InZoneId Zone being edited
+     * @param InOperationType CSG operation
+     * @param InCenter Box center
+     * @param HalfSize Box half size
+     * @param BandWidth Distance outside the surface that is also updated
+     * @param InMaterialId Material channel (INDEX_NONE for the shared field)
+     * @return Operation description
+     */
+    static FCommutativeFieldOp MakeBox(int32 InZoneId, ECommutativeOpType InOperationType, const FVector& InCenter, const FVector& HalfSize, float BandWidth, int32 InMaterialId = INDEX_NONE);
+
+    /**
+     * Gets the region an operation may modify
+     * @param InOperationType CSG operation
+     * @param ShapeBounds Bounds of the shape plus its band
+     * @return ShapeBounds for union and subtraction; unbounded for intersection, which empties
+     *         everything outside the shape
+     */
+    static FBox GetAffectedBounds(ECommutativeOpType InOperationType, const FBox& ShapeBounds);
+
+    /**
+     * Gets the commutativity class of an operation type
+     * @param InOperationType Operation type
+     * @return Min for Union, Max for Subtraction and Intersection
+     */
+    static ECommutativeOpClass GetClass(ECommutativeOpType InOperationType);
+
+    /**
+     * Gets the commutativity class of this operation
+     * @return Class of this operation
+     */
+    ECommutativeOpClass GetClass() const { return GetClass(OperationType); }
+
+    /**
+     * Evaluates the signed distance to this operation's shape
+     * @param Position World position
+     * @return Signed distance (negative inside the shape)
+     */
+    float EvaluateShape(const FVector& Position) const;
+
+    /**
+     * Applies this operation to one field sample
+     * @param FieldValue Current signed distance at the position
+     * @param Position World position of the sample
+     * @return New signed distance; unchanged outside Bounds
+     */
+    float Apply(float FieldValue, const FVector& Position) const;
+};
@@ -0,0 +1,204 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+/**
+ * Epoch-based memory reclamation for lock-free structures in the threading module
+ *
+ * Readers pin the current global epoch for the duration of an access (FEpochGuard). Writers
+ * unlink an object and retire it instead of deleting it; the object is freed once the global
+ * epoch has advanced twice past the epoch it was retired in, at which point no pinned reader can
+ * still hold a reference. The epoch only advances when every pinned thread has observed the
+ * current one, so a thread that stays pinned holds back reclamation but never blocks readers.
+ *
+ * Each thread keeps its own retire list and collects it in amortized batches. FMiningTaskWorker
+ * pins around every task it runs and quiesces between tasks, so task code may read lock-free
+ * structures without its own guard.
+ */
+class MININGSPICECOPILOT_API FEpochManager
+{
+public:
+    /** Function used to free a retired object */
+    typedef void (*FDeleter)(void* Object);
+
+    /** Destructor; frees everything still retired (no thread may be pinned) */
+    ~FEpochManager();
+
+    /**
+     * Gets the process-wide epoch manager
+     * @return Epoch manager instance
+     */
+    static FEpochManager& Get();
+
+    /**
+     * Pins the calling thread at the current epoch; pins nest
+     * Memory read through lock-free structures stays valid until the matching Exit
+     */
+    void Enter();
+
+    /** Releases one pin taken by Enter */
+    void Exit();
+
+    /**
+     * Checks whether the calling thread is pinned
+     * @return True between Enter and the matching Exit
+     */
+    bool IsPinned() const;
+
+    /**
+     * Retires an object that has been unlinked from every shared structure
+     * @param Object Object to free later
+     * @param Deleter Function that frees it
+     */
+    void Retire(void* Object, FDeleter Deleter);
+
+    /**
+     * Retires an object allocated with new
+     * @param Object Object to delete later
+     */
+    template<typename T>
+    void Retire(T* Object)
+    {
+        Retire(static_cast<void*>(Object), [](void* Pointer) { delete static_cast<T*>(Pointer); });
+    }
+
+    /**
+     * Marks a point where the calling thread holds no references (e.g. between tasks)
+     * Collects the thread's retire list once enough objects have accumulated
+     */
+    void Quiesce();
+
+    /**
+     * Tries to advance the global epoch and frees the calling thread's reclaimable objects,
+     * together with any left behind by threads that have exited
+     * @return Number of objects freed
+     */
+    int32 Collect();
+
+    /**
+     * Waits until every object the calling thread, or an exited thread, retired before the call
+     * has been freed. Must not be called while pinned; intended for shutdown and tests
+     * @param TimeoutMs Maximum time to wait in milliseconds (0 for no timeout)
+     * @return True if those objects were freed before the timeout
+     */
+    bool Synchronize(uint32 TimeoutMs = 0);
+
+    /** Gets the current global epoch */
+    uint64 GetGlobalEpoch() const;
+
+    /** Gets the number of objects retired but not yet freed, across all threads */
+    int64 GetPendingCount() const;
+
+    /** Gets the total number of objects freed */
+    int64 GetFreedCount() const;
+
+    /** Retire list length at which Quiesce and Exit collect */
+    static constexpr int32 CollectThreshold = 64;
+
+private:
+    /** Object waiting for its epoch to expire */
+    struct FRetiredObject
+    {
+        void* Object;
+        FDeleter Deleter;
+        uint64 Epoch;
+    };
+
+    /** Per-thread state; records are never freed, only recycled when their thread exits */
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) FThreadRecord
+    {
+        /** Pinned epoch with ActiveBit set, or 0 while the thread is not pinned */
+        std::atomic<uint64> PinnedEpoch{0};
+
+        /** Whether a live thread owns this record */
+        std::atomic<bool> bInUse{false};
+
+        /** Next record in the registry */
+        FThreadRecord* Next = nullptr;
+
+        /** Pin nesting depth (owner only) */
+        int32 PinDepth = 0;
+
+        /** Objects retired by this thread, in epoch order (owner only) */
+        TArray<FRetiredObject> RetireList;
+    };
+
+    /** Releases a record when its thread exits */
+    struct FThreadRecordHandle
+    {
+        FThreadRecord* Record = nullptr;
+        ~FThreadRecordHandle();
+    };
+
+    /** Set in PinnedEpoch while the thread is pinned */
+    static constexpr uint64 ActiveBit = 1ull << 63;
+
+    /** Constructor */
+    FEpochManager();
+
+    /** Gets or registers the calling thread's record */
+    FThreadRecord& GetThreadRecord();
+
+    /** Hands a retire list to the orphan list and frees the record for reuse */
+    void ReleaseThreadRecord(FThreadRecord* Record);
+
+    /**
+     * Advances the global epoch if every pinned thread has observed it
+     * @return True if the epoch advanced
+     */
+    bool TryAdvanceEpoch();
+
+    /**
+     * Frees the reclaimable prefix of a retire list
+     * @param List Retire list in epoch order
+     * @param SafeEpoch Objects retired before this epoch are freed
+     * @return Number of objects freed
+     */
+    int32 FreeExpired(TArray<FRetiredObject>& List, uint64 SafeEpoch);
+
+    /** Global epoch */
+    std::atomic<uint64> GlobalEpoch;
+
+    /** Head of the record registry (append only) */
+    std::atomic<FThreadRecord*> Records;
+
+    /** Objects left behind by exited threads */
+    TArray<FRetiredObject> OrphanList;
+
+    /** Guards OrphanList */
+    FCriticalSection OrphanLock;
+
+    /** Objects retired but not yet freed */
+    std::atomic<int64> PendingCount;
+
+    /** Objects freed */
+    std::atomic<int64> FreedCount;
+};
+
+/**
+ * Scoped epoch pin
+ * Keeps memory read from lock-free structures alive until the guard is destroyed
+ */
+class MININGSPICECOPILOT_API FEpochGuard
+{
+public:
+    /** Constructor; pins the calling thread */
+    FEpochGuard()
+    {
+        FEpochManager::Get().Enter();
+    }
+
+    /** Destructor; releases the pin */
+    ~FEpochGuard()
+    {
+        FEpochManager::Get().Exit();
+    }
+
+private:
+    FEpochGuard(const FEpochGuard&) = delete;
+    FEpochGuard& operator=(const FEpochGuard&) = delete;
+};
@@ -145,6 +145,12 @@ DECLARE_DELEGATE_OneParam(FAsyncProgressDelegate, const FAsyncProgress&);
  */
 DECLARE_DELEGATE_OneParam(FAsyncCompletionDelegate, const FAsyncResult&);
 
+/**
+ * Continuation body: takes the antecedent's result by move and returns the continuation's result
+ * A result with bSuccess false fails the continuation, or cancels it if bCancelled is set
+ */
+typedef TFunction<FAsyncResult(FAsyncResult&&)> FAsyncContinuation;
+
 /**
  * Base interface for async operations in the SVO+SDF mining architecture
  */
@@ -276,6 +282,34 @@ public:
      */
     virtual uint32 CleanupCompletedOperations(double MaxAgeSeconds = 300.0) = 0;
     
+    /**
+     * Creates an operation that runs a continuation on a task scheduler worker once another operation completes
+     * If the antecedent fails or is cancelled, the continuation is skipped (unless bRunOnFailure) and the
+     * new operation ends the same way with the antecedent's result, so failures and cancellation flow
+     * down the whole chain. Cancelling the new operation cancels everything chained after it.
+     * @param AntecedentId ID of the operation to continue from
+     * @param Continuation Function given the antecedent's result
+     * @param bRunOnFailure Whether to also run the continuation when the antecedent fails (not when cancelled)
+     * @return ID of the continuation operation or 0 if the antecedent does not exist
+     */
+    virtual uint64 Then(uint64 AntecedentId, FAsyncContinuation Continuation, bool bRunOnFailure = false) = 0;
+    
+    /**
+     * Creates an operation that completes when all the given operations have completed
+     * Its result data is a TArray<FAsyncResult> with their results in the given order. It fails or is
+     * cancelled with the first antecedent that fails or is cancelled.
+     * @param OperationIds IDs of the operations to wait for
+     * @return ID of the combined operation or 0 if any operation does not exist
+     */
+    virtual uint64 WhenAll(const TArray<uint64>& OperationIds) = 0;
+    
+    /**
+     * Creates an operation that ends with the first of the given operations to end, taking its status and result
+     * @param OperationIds IDs of the operations to wait for
+     * @return ID of the combined operation or 0 if the list is empty or any operation does not exist
+     */
+    virtual uint64 WhenAny(const TArray<uint64>& OperationIds) = 0;
+    
     /**
      * Gets the singleton instance
      * @return Reference to the async operation manager
@@ -6,6 +6,7 @@
 #include "UObject/Interface.h"
 #include "Utils/SimpleSpinLock.h" // Replace the Misc/SpinLock.h include with our custom implementation
 #include "HAL/ThreadSafeCounter.h"
+#include "CommutativeFieldOp.h"
 #include "ITransactionManager.generated.h"
 
 // Forward declarations
@@ -20,6 +21,12 @@ struct FVersionRecord;
  */
 DECLARE_DELEGATE_TwoParams(FTransactionCompletionDelegate, uint32 /*TypeId*/, const FTransactionStats& /*Stats*/);
 
+/** 
+ * Delegate that applies a committed transaction's field operation log to the live data
+ * Called in commit order while the commit is being published; must not commit transactions
+ */
+DECLARE_DELEGATE_OneParam(FCommutativeOpApplyDelegate, const TArray<FCommutativeFieldOp>& /*Operations*/);
+
 /**
  * Transaction conflict resolution strategy
  */
@@ -34,7 +41,7 @@ enum class EConflictResolution : uint8
     /** Force the transaction through (caution: may cause inconsistencies) */
     Force,
     
-    /** Merge changes with the latest version */
+    /** Merge by replaying the transaction's commutative operation log on the latest version */
     Merge
 };
 
@@ -293,6 +300,16 @@ public:
      */
     virtual bool AddToWriteSet(int32 ZoneId, int32 MaterialId = INDEX_NONE) = 0;
     
+    /**
+     * Logs a commutative field operation performed by this transaction
+     * The operation's zone and material are added to the write set. With EConflictResolution::Merge,
+     * a conflict on writes that are covered only by operations of one commutativity class is
+     * resolved by replaying the log on the newer state instead of aborting.
+     * @param Operation Field operation to log
+     * @return True if the operation was logged
+     */
+    virtual bool AddCommutativeOperation(const FCommutativeFieldOp& Operation) = 0;
+    
     /**
      * Gets statistics for this transaction
      * @return Transaction statistics
@@ -450,6 +467,14 @@ public:
      */
     virtual bool RegisterCompletionCallback(uint32 TypeId, const FTransactionCompletionDelegate& Callback) = 0;
     
+    /**
+     * Registers the delegate that applies operation logs of committed transactions
+     * @param TypeId Type ID to register the applier for
+     * @param Applier Delegate to call with each committed transaction's operation log
+     * @return True if registration was successful
+     */
+    virtual bool RegisterOperationApplier(uint32 TypeId, const FCommutativeOpApplyDelegate& Applier) = 0;
+    
     /**
      * Gets the singleton instance
      * @return Reference to the transaction manager
@@ -0,0 +1,182 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Whether lock ordering is validated
+ * On by default in Debug and Development builds; a target can override it through its definitions
+ */
+#ifndef MINING_LOCK_ORDER_VALIDATION
+#define MINING_LOCK_ORDER_VALIDATION (UE_BUILD_DEBUG || UE_BUILD_DEVELOPMENT)
+#endif
+
+/**
+ * Independent lock hierarchies checked by the validator
+ * Ordering is only enforced between locks of the same domain
+ */
+enum class ELockOrderDomain : uint8
+{
+    /** ERegistryLockLevel ordering tracked by FRegistryOperationValidator */
+    Registry,
+
+    /** FHierarchicalLock levels */
+    Hierarchical,
+
+    Count
+};
+
+/**
+ * First lock order violation observed in the process
+ */
+struct FLockOrderViolation
+{
+    /** Domain the violation occurred in */
+    ELockOrderDomain Domain;
+
+    /** Level of the lock already held */
+    uint32 HeldLevel;
+
+    /** Level of the lock being acquired */
+    uint32 AcquiredLevel;
+
+    /** Call site that acquired the held lock */
+    const void* HeldSite;
+
+    /** Call site of the violating acquisition */
+    const void* AcquireSite;
+
+    /** Thread that made the violating acquisition */
+    uint32 ThreadId;
+
+    /** Constructor */
+    FLockOrderViolation()
+        : Domain(ELockOrderDomain::Registry)
+        , HeldLevel(0)
+        , AcquiredLevel(0)
+        , HeldSite(nullptr)
+        , AcquireSite(nullptr)
+        , ThreadId(0)
+    {
+    }
+};
+
+/**
+ * Lock hierarchy validator
+ *
+ * Each thread keeps one 64-bit mask of held ranks per domain. Acquiring rank R is legal when no
+ * rank at or above R is held, which is a single shift and test against the mask; recording and
+ * releasing set and clear the bit. The acquiring call site is remembered per held rank, so the
+ * first violation in the process is logged with the call sites of both locks. Later violations
+ * are only counted. With MINING_LOCK_ORDER_VALIDATION off every call compiles away.
+ *
+ * Levels below DirectRankCount are used as ranks directly. Larger levels share ranks by hundreds,
+ * so Service..SDF map to ranks 33..37, and everything from 3100 up shares MaxRank. The mapping never
+ * puts a higher level at a lower rank, and acquiring a rank that is already held compares the full
+ * levels, so distinct levels that share a rank are still ordered exactly.
+ */
+class MININGSPICECOPILOT_API FLockOrderValidator
+{
+public:
+    /** Highest rank the mask can track */
+    static constexpr uint32 MaxRank = 63;
+
+    /** Levels below this are their own rank; higher ranks may be shared by several levels */
+    static constexpr uint32 DirectRankCount = 32;
+
+    /**
+     * Maps a lock level to its rank in the per-thread mask
+     * Non-decreasing in Level, so a lock at a higher rank always has a higher level
+     * @param Level Lock level
+     * @return Rank in [0, MaxRank]
+     */
+    static FORCEINLINE uint32 GetRank(uint32 Level)
+    {
+        return Level < DirectRankCount ? Level : FMath::Min(DirectRankCount + Level / 100, MaxRank);
+    }
+
+    /**
+     * Records an acquisition, reporting it if it breaks the hierarchy
+     * Call before blocking on the lock so an ordering deadlock is reported rather than hung on
+     * @param Domain Lock hierarchy
+     * @param Level Level of the lock being acquired
+     * @param Site Call site to report for this acquisition (null for the caller's return address)
+     * @return False if the acquisition violates the hierarchy
+     */
+    static FORCEINLINE bool OnAcquire(ELockOrderDomain Domain, uint32 Level, const void* Site = nullptr)
+    {
+#if MINING_LOCK_ORDER_VALIDATION
+        return OnAcquireChecked(Domain, Level, Site);
+#else
+        return true;
+#endif
+    }
+
+    /**
+     * Records a release, or an acquisition that was abandoned
+     * @param Domain Lock hierarchy
+     * @param Level Level of the lock
+     */
+    static FORCEINLINE void OnRelease(ELockOrderDomain Domain, uint32 Level)
+    {
+#if MINING_LOCK_ORDER_VALIDATION
+        OnReleaseChecked(Domain, Level);
+#endif
+    }
+
+    /**
+     * Checks whether the calling thread may acquire a level without recording anything
+     * @param Domain Lock hierarchy
+     * @param Level Level of the lock
+     * @return True if no lock at or above the level's rank is held (always true when compiled out)
+     */
+    static bool CanAcquire(ELockOrderDomain Domain, uint32 Level);
+
+    /**
+     * Gets the levels the calling thread holds, lowest first
+     * @param Domain Lock hierarchy
+     * @return Held levels (empty when compiled out)
+     */
+    static TArray<uint32> GetHeldLevels(ELockOrderDomain Domain);
+
+    /**
+     * Gets the highest level the calling thread holds
+     * @param Domain Lock hierarchy
+     * @return Highest held level, or 0 if none
+     */
+    static uint32 GetHighestHeldLevel(ELockOrderDomain Domain);
+
+    /**
+     * Forgets every lock the calling thread holds in a domain
+     * Used for cleanup or when recovering from errors
+     * @param Domain Lock hierarchy
+     */
+    static void ResetThread(ELockOrderDomain Domain);
+
+    /**
+     * Gets the first violation observed since the last reset
+     * @param OutViolation Receives the violation
+     * @return True if a violation has been observed
+     */
+    static bool GetFirstViolation(FLockOrderViolation& OutViolation);
+
+    /** Gets the number of violations observed since the last reset */
+    static int64 GetViolationCount();
+
+    /** Clears the recorded violations so the next one is reported in full */
+    static void ResetViolations();
+
+    /** Checks whether validation is compiled in */
+    static constexpr bool IsEnabled()
+    {
+        return MINING_LOCK_ORDER_VALIDATION != 0;
+    }
+
+private:
+    /** Validated path of OnAcquire */
+    static bool OnAcquireChecked(ELockOrderDomain Domain, uint32 Level, const void* Site);
+
+    /** Validated path of OnRelease */
+    static void OnReleaseChecked(ELockOrderDomain Domain, uint32 Level);
+};
@@ -0,0 +1,245 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Kind of lock acquisition recorded by the lock profiler
+ */
+enum class ELockProfileType : uint8
+{
+    /** FHybridLock */
+    Hybrid,
+
+    /** FNUMAOptimizedSpinLock */
+    NUMASpin,
+
+    /** One zone of an FZoneBasedLock */
+    Zone,
+
+    /** Shared acquisition of an FMiningReaderWriterLock */
+    Read,
+
+    /** Exclusive acquisition of an FMiningReaderWriterLock */
+    Write
+};
+
+/**
+ * One profiled lock acquisition
+ */
+struct FLockProfileSample
+{
+    /** Lock that was acquired */
+    const void* Lock;
+
+    /** Return address of the acquiring frame */
+    const void* Site;
+
+    /** Cycles spent waiting to acquire */
+    uint64 WaitCycles;
+
+    /** Cycles the lock was held */
+    uint64 HoldCycles;
+
+    /** Kind of acquisition */
+    ELockProfileType Type;
+};
+
+/**
+ * Aggregated profile for one lock acquired from one call site
+ */
+struct FLockSiteReport
+{
+    /** Lock address */
+    const void* Lock;
+
+    /** Call-site return address */
+    const void* Site;
+
+    /** Symbolicated call site, or the address if symbols are unavailable */
+    FString SiteName;
+
+    /** Kind of acquisition */
+    ELockProfileType Type;
+
+    /** Number of sampled acquisitions */
+    int64 SampleCount;
+
+    /** Total wait time over the samples in microseconds */
+    double TotalWaitUs;
+
+    /** Longest wait in microseconds */
+    double MaxWaitUs;
+
+    /** Total hold time over the samples in microseconds */
+    double TotalHoldUs;
+
+    /** Longest hold in microseconds */
+    double MaxHoldUs;
+
+    /** Constructor */
+    FLockSiteReport()
+        : Lock(nullptr)
+        , Site(nullptr)
+        , Type(ELockProfileType::Hybrid)
+        , SampleCount(0)
+        , TotalWaitUs(0.0)
+        , MaxWaitUs(0.0)
+        , TotalHoldUs(0.0)
+        , MaxHoldUs(0.0)
+    {
+    }
+};
+
+/**
+ * Opt-in contention profiler shared by the threading module's locks
+ *
+ * Locks bracket each acquisition with BeginAcquire/EndAcquire and call Release before unlocking.
+ * While disabled that costs one relaxed load per call. While enabled, every SampleEvery-th
+ * acquisition on a thread records its wait time, hold time and the acquiring call site into a
+ * per-thread ring buffer, without any shared writes. BuildReport merges the rings on demand into
+ * a ranking of lock/site pairs by total wait time.
+ *
+ * The call site is the return address of the frame that called the lock. Scoped lock helpers that
+ * are not inlined install an FSiteScope so their caller is reported instead of the helper.
+ */
+class MININGSPICECOPILOT_API FLockProfiler
+{
+public:
+    /** Samples kept per thread; older samples are overwritten */
+    static constexpr int32 RingCapacity = 8192;
+
+    /**
+     * Starts profiling
+     * @param SampleEvery Record one acquisition in this many per thread (1 records all)
+     */
+    static void Enable(int32 SampleEvery = 1);
+
+    /** Stops profiling; recorded samples are kept until Reset */
+    static void Disable();
+
+    /** Discards all recorded samples */
+    static void Reset();
+
+    /** Checks whether profiling is enabled */
+    static FORCEINLINE bool IsEnabled()
+    {
+        return bEnabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Called by a lock before it starts acquiring
+     * @return Start timestamp to pass to EndAcquire, or 0 if this acquisition is not sampled
+     */
+    static FORCEINLINE uint64 BeginAcquire()
+    {
+        return IsEnabled() ? BeginAcquireSampled() : 0;
+    }
+
+    /**
+     * Called by a lock once it has been acquired
+     * @param StartCycles Value returned by BeginAcquire
+     * @param Lock Lock that was acquired
+     * @param Site Return address of the acquiring frame
+     * @param Type Kind of acquisition
+     */
+    static FORCEINLINE void EndAcquire(uint64 StartCycles, const void* Lock, const void* Site, ELockProfileType Type)
+    {
+        if (StartCycles != 0)
+        {
+            EndAcquireSampled(StartCycles, Lock, Site, Type);
+        }
+    }
+
+    /**
+     * Called by a lock before it is released
+     * @param Lock Lock being released
+     */
+    static FORCEINLINE void Release(const void* Lock)
+    {
+        if (IsEnabled())
+        {
+            ReleaseSampled(Lock);
+        }
+    }
+
+    /**
+     * Attributes acquisitions made while in scope to the given call site
+     * Used by out-of-line scoped lock helpers; the outermost scope wins
+     */
+    class MININGSPICECOPILOT_API FSiteScope
+    {
+    public:
+        explicit FSiteScope(const void* Site)
+            : bActive(IsEnabled() && PushSite(Site))
+        {
+        }
+
+        ~FSiteScope()
+        {
+            if (bActive)
+            {
+                PopSite();
+            }
+        }
+
+    private:
+        bool bActive;
+    };
+
+    /**
+     * Merges every thread's samples into per lock and call site totals
+     * @param MaxEntries Maximum number of entries to return (0 for all)
+     * @return Entries ranked by total wait time, highest first
+     */
+    static TArray<FLockSiteReport> BuildReport(int32 MaxEntries = 20);
+
+    /**
+     * Formats a report as an aligned text table
+     * @param Report Entries from BuildReport
+     * @return Report text
+     */
+    static FString FormatReportText(const TArray<FLockSiteReport>& Report);
+
+    /**
+     * Formats a report as JSON
+     * @param Report Entries from BuildReport
+     * @return JSON document with one object per entry
+     */
+    static FString FormatReportJson(const TArray<FLockSiteReport>& Report);
+
+    /**
+     * Gets a display name for an acquisition type
+     * @param Type Acquisition type
+     * @return Type name
+     */
+    static const TCHAR* GetTypeName(ELockProfileType Type);
+
+    /**
+     * Symbolicates a call-site return address
+     * @param Site Return address
+     * @return Function and line, or the address if symbols are unavailable
+     */
+    static FString GetSiteName(const void* Site);
+
+private:
+    /** Whether profiling is enabled */
+    static std::atomic<bool> bEnabled;
+
+    /** Sampled path of BeginAcquire */
+    static uint64 BeginAcquireSampled();
+
+    /** Sampled path of EndAcquire */
+    static void EndAcquireSampled(uint64 StartCycles, const void* Lock, const void* Site, ELockProfileType Type);
+
+    /** Enabled path of Release */
+    static void ReleaseSampled(const void* Lock);
+
+    /** Installs a call-site override; returns false if one is already installed */
+    static bool PushSite(const void* Site);
+
+    /** Removes the call-site override */
+    static void PopSite();
+};
@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "TaskScheduler.h"
 
+struct FTaskTraceEvent;
+
 /**
  * Task dependency relationship types
  */
@@ -122,6 +124,122 @@ enum class EVisualizationFormat : uint8
     Text
 };
 
+/**
+ * Schedule analysis of one task in a recorded frame
+ */
+struct MININGSPICECOPILOT_API FTaskSlackInfo
+{
+    /** Task ID */
+    uint64 TaskId;
+    
+    /** Task description, or "Task <id>" if no name was given for it */
+    FString Description;
+    
+    /** Worker that ran the task */
+    int32 WorkerId;
+    
+    /** Measured execution time (milliseconds) */
+    double DurationMs;
+    
+    /** Earliest start if every task started as soon as its dependencies finished (milliseconds) */
+    double EarliestStartMs;
+    
+    /** Latest start that does not lengthen the span (milliseconds) */
+    double LatestStartMs;
+    
+    /** How long the task could be delayed or lengthened without lengthening the span (milliseconds) */
+    double SlackMs;
+    
+    /** Whether the task is on the critical path */
+    bool bOnCriticalPath;
+    
+    /** Dependencies present in the frame */
+    TArray<uint64> Dependencies;
+    
+    /** Constructor */
+    FTaskSlackInfo()
+        : TaskId(0)
+        , WorkerId(INDEX_NONE)
+        , DurationMs(0.0)
+        , EarliestStartMs(0.0)
+        , LatestStartMs(0.0)
+        , SlackMs(0.0)
+        , bOnCriticalPath(false)
+    {
+    }
+};
+
+/**
+ * Predicted frame time for a worker count
+ */
+struct MININGSPICECOPILOT_API FWorkerScalingEstimate
+{
+    /** Number of workers */
+    int32 WorkerCount;
+    
+    /** Lower bound on the frame time: max(work / workers, span) (milliseconds) */
+    double BestMakespanMs;
+    
+    /** Frame time any greedy scheduler achieves: work / workers + span (milliseconds) */
+    double GreedyMakespanMs;
+    
+    /** Speedup over running the frame on one worker, at the lower bound */
+    double BestSpeedup;
+    
+    /** Speedup over running the frame on one worker, at the greedy bound */
+    double GreedySpeedup;
+    
+    /** Constructor */
+    FWorkerScalingEstimate()
+        : WorkerCount(0)
+        , BestMakespanMs(0.0)
+        , GreedyMakespanMs(0.0)
+        , BestSpeedup(0.0)
+        , GreedySpeedup(0.0)
+    {
+    }
+};
+
+/**
+ * Critical-path and slack analysis of a recorded frame of tasks
+ */
+struct MININGSPICECOPILOT_API FCriticalPathReport
+{
+    /** Per-task analysis, in dependency order */
+    TArray<FTaskSlackInfo> Tasks;
+    
+    /** Tasks on the critical path, first to last */
+    TArray<uint64> CriticalPath;
+    
+    /** Sum of all task durations (milliseconds) */
+    double TotalWorkMs;
+    
+    /** Length of the critical path (milliseconds) */
+    double SpanMs;
+    
+    /** Work / span: the most workers the frame can keep busy on average */
+    double Parallelism;
+    
+    /** Measured time from the first task start to the last task end (milliseconds) */
+    double ObservedMakespanMs;
+    
+    /** Number of distinct workers that ran tasks in the frame */
+    int32 ObservedWorkerCount;
+    
+    /** Predicted frame times for the requested worker counts */
+    TArray<FWorkerScalingEstimate> Scaling;
+    
+    /** Constructor */
+    FCriticalPathReport()
+        : TotalWorkMs(0.0)
+        , SpanMs(0.0)
+        , Parallelism(0.0)
+        , ObservedMakespanMs(0.0)
+        , ObservedWorkerCount(0)
+    {
+    }
+};
+
 /**
  * Task dependency visualizer for debugging complex task chains
  * Provides visualization of task dependencies and execution states for debugging.
@@ -170,6 +288,48 @@ public:
      */
     bool SaveVisualization(const FString& Filename, const FString& Visualization, EVisualizationFormat Format);
     
+    /**
+     * Exports the task timeline recorded by FTaskTraceRecorder as Chrome trace-event JSON
+     * Load the result in chrome://tracing or ui.perfetto.dev. Each worker is a track of task
+     * slices, dependencies are flow arrows from the end of a dependency to the start of its
+     * dependent, and tasks on the critical path are coloured and tagged in their arguments.
+     * @return Trace JSON (an empty trace if nothing was recorded)
+     */
+    FString ExportChromeTrace();
+    
+    /**
+     * Computes the critical path, per-task slack and work/span scaling of a recorded frame
+     * Durations are the measured execution times and edges are the dependencies between tasks in
+     * the frame; queueing and worker availability are ignored, so the span is the frame time with
+     * unlimited workers. Comparing the span with the observed frame time shows whether more
+     * workers could help (observed well above span and parallelism above the worker count) or
+     * whether only shortening critical tasks will.
+     * Only the events are read, so a saved or hand-built frame can be analysed without a scheduler.
+     * @param Events Recorded task events (e.g. FTaskTraceRecorder::CollectEvents for one frame)
+     * @param WorkerCounts Worker counts to predict frame times for (empty for 1, 2, 4 ... 64)
+     * @param TaskNames Description by task ID (e.g. from GetTraceTaskNames); unnamed tasks are "Task <id>"
+     * @return Analysis of the frame
+     */
+    FCriticalPathReport AnalyzeCriticalPath(const TArray<FTaskTraceEvent>& Events, const TArray<int32>& WorkerCounts = TArray<int32>(),
+        const TMap<uint64, FString>& TaskNames = TMap<uint64, FString>());
+    
+    /**
+     * Renders a critical-path analysis
+     * DOT annotates every task with its duration and slack and draws the critical path in red;
+     * Text lists the scaling table and tasks by slack; JSON serializes the report
+     * @param Report Analysis from AnalyzeCriticalPath
+     * @param Format Output format (DOT, JSON or Text)
+     * @return Visualization in the requested format
+     */
+    FString VisualizeCriticalPath(const FCriticalPathReport& Report, EVisualizationFormat Format = EVisualizationFormat::Text);
+    
+    /**
+     * Looks up descriptions of recorded tasks the live scheduler still knows
+     * @param Events Recorded task events
+     * @return Description by task ID
+     */
+    TMap<uint64, FString> GetTraceTaskNames(const TArray<FTaskTraceEvent>& Events) const;
+    
     /**
      * Gets the singleton instance
      * @return Reference to the task dependency visualizer
@@ -74,6 +74,9 @@ public:
     /** Creation timestamp */
     double CreationTime;
     
+    /** Time the task was placed in its priority queue */
+    double EnqueueTime;
+        
     /** Start timestamp */
     double StartTime;
     
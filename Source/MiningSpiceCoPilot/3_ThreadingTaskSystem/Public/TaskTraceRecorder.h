@@ -0,0 +1,107 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TaskSystem/TaskTypes.h"
+#include <atomic>
+
+class FMiningTask;
+
+/**
+ * Timeline record of one executed task
+ */
+struct FTaskTraceEvent
+{
+    /** Task ID */
+    uint64 TaskId;
+
+    /** Time the task was placed in its priority queue, in FPlatformTime::Seconds */
+    double EnqueueTime;
+
+    /** Time a worker started the task */
+    double StartTime;
+
+    /** Time the task finished */
+    double EndTime;
+
+    /** Index of the worker that ran the task */
+    int32 WorkerId;
+
+    /** Task type */
+    ETaskType Type;
+
+    /** Task priority */
+    ETaskPriority Priority;
+
+    /** Whether the task completed successfully */
+    bool bSucceeded;
+
+    /** Whether Dependencies is the task's full list; false if the IDs were overwritten before collection */
+    bool bDependenciesComplete;
+
+    /** IDs of the tasks this task depended on */
+    TArray<uint64> Dependencies;
+};
+
+/**
+ * Runtime-switchable task timeline recorder
+ *
+ * FMiningTaskWorker records every task it finishes with its enqueue, start and end timestamps and
+ * the worker index. The timestamps are the ones the task already takes, so a record is a copy of
+ * about 64 bytes into the calling thread's event ring plus 8 bytes per dependency into its
+ * dependency ring: no allocation, no lock and no shared writes. While disabled the cost is one
+ * relaxed load per task.
+ * FTaskDependencyVisualizer::ExportChromeTrace turns the records into a Chrome trace.
+ */
+class MININGSPICECOPILOT_API FTaskTraceRecorder
+{
+public:
+    /** Events kept per worker thread; older events are overwritten */
+    static constexpr int32 RingCapacity = 8192;
+
+    /** Dependency IDs kept per worker thread; events whose IDs are overwritten lose their dependencies */
+    static constexpr int32 DependencyRingCapacity = RingCapacity * 4;
+
+    /** Starts recording */
+    static void Enable();
+
+    /** Stops recording; recorded events are kept until Reset */
+    static void Disable();
+
+    /** Discards all recorded events */
+    static void Reset();
+
+    /** Checks whether recording is enabled */
+    static FORCEINLINE bool IsEnabled()
+    {
+        return bEnabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Records a finished task
+     * @param Task Task that has just completed or failed
+     * @param WorkerId Index of the worker that ran it
+     */
+    static FORCEINLINE void RecordTask(const FMiningTask& Task, int32 WorkerId)
+    {
+        if (IsEnabled())
+        {
+            RecordTaskEnabled(Task, WorkerId);
+        }
+    }
+
+    /**
+     * Copies every worker's recorded events
+     * Safe to call while recording; events overwritten during the copy are dropped
+     * @return Events from all workers, ordered by start time
+     */
+    static TArray<FTaskTraceEvent> CollectEvents();
+
+private:
+    /** Whether recording is enabled */
+    static std::atomic<bool> bEnabled;
+
+    /** Enabled path of RecordTask */
+    static void RecordTaskEnabled(const FMiningTask& Task, int32 WorkerId);
+};
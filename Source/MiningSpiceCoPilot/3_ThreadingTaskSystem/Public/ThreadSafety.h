@@ -12,6 +12,11 @@
 #include "Containers/Map.h"
 #include "String/Find.h"
 #include "HAL/PlatformAffinity.h" // For NUMA functionality
+#include "LockProfiler.h"
+#include "AdaptiveSpinWait.h"
+#include "LockOrderValidator.h"
+#include "EpochManager.h"
+#include <atomic>
 
 // Forward declarations
 class MININGSPICECOPILOT_API FThreadSafety;
@@ -40,43 +45,45 @@ enum class ERegistryLockLevel : uint32
 
 /**
  * Lightweight spin lock implementation for Mining system
- * Provides fast locking with minimal overhead for short-held locks
+ * Spins briefly with exponential backoff and parks once the lock's learned spin budget runs out
  */
 class MININGSPICECOPILOT_API FSpinLock
 {
 public:
     /** Constructor */
-    FSpinLock() : bLocked(0) {}
+    FSpinLock() : State(FAdaptiveSpinWait::Unlocked) {}
     
     /** Acquires the lock */
     void Lock()
     {
-        while (FPlatformAtomics::InterlockedCompareExchange(&bLocked, 1, 0) != 0)
-        {
-            FPlatformProcess::Yield();
-        }
+        FAdaptiveSpinWait::Lock(State, Budget);
     }
     
     /** Releases the lock */
     void Unlock()
     {
-        FPlatformAtomics::InterlockedExchange(&bLocked, 0);
+        FAdaptiveSpinWait::Unlock(State);
     }
     
     /** Tries to acquire the lock without waiting */
     bool TryLock()
     {
-        return FPlatformAtomics::InterlockedCompareExchange(&bLocked, 1, 0) == 0;
+        return FAdaptiveSpinWait::TryLock(State);
     }
     
 private:
-    /** Lock state (0 = unlocked, 1 = locked) */
-    volatile int32 bLocked;
+    /** Lock word (see FAdaptiveSpinWait) */
+    std::atomic<int32> State;
+    
+    /** Spin budget learned from recent waits */
+    FAdaptiveSpinWait::FSpinBudget Budget;
 };
 
 /**
  * Registry operation validator for deadlock prevention
- * Tracks lock acquisition history and validates lock hierarchies
+ * Tracks the registry levels each thread holds and validates lock hierarchies; backed by
+ * FLockOrderValidator, so checks cost a few bit operations and compile out with
+ * MINING_LOCK_ORDER_VALIDATION
  */
 class MININGSPICECOPILOT_API FRegistryOperationValidator
 {
@@ -90,31 +97,20 @@ public:
      */
     static bool CanSafelyAcquireLock(ERegistryLockLevel Level)
     {
-        TArray<ERegistryLockLevel>& LockHistory = GetThreadLockHistoryInternal();
-        
-        // If no locks are held, any lock can be acquired
-        if (LockHistory.Num() == 0)
-        {
-            return true;
-        }
-        
-        // Check that the level is lower than the highest lock level already held
         // Higher value means lower in the hierarchy (SDF = 500 > Material = 300)
-        uint32 CurrentLevel = static_cast<uint32>(LockHistory.Last());
-        uint32 NewLevel = static_cast<uint32>(Level);
-        
-        return NewLevel > CurrentLevel;
+        return FLockOrderValidator::CanAcquire(ELockOrderDomain::Registry, static_cast<uint32>(Level));
     }
     
     /**
      * Adds a lock to the thread's lock history
+     * Reports the acquisition if it violates the hierarchy, so call it before blocking on the lock
      * 
      * @param Level The level of the lock being acquired
+     * @return False if the acquisition violates the hierarchy
      */
-    static void AddLockToHistory(ERegistryLockLevel Level)
+    static FORCEINLINE bool AddLockToHistory(ERegistryLockLevel Level)
     {
-        TArray<ERegistryLockLevel>& LockHistory = GetThreadLockHistoryInternal();
-        LockHistory.Add(Level);
+        return FLockOrderValidator::OnAcquire(ELockOrderDomain::Registry, static_cast<uint32>(Level));
     }
     
     /**
@@ -122,29 +118,24 @@ public:
      * 
      * @param Level The level of the lock being released
      */
-    static void RemoveLockFromHistory(ERegistryLockLevel Level)
+    static FORCEINLINE void RemoveLockFromHistory(ERegistryLockLevel Level)
     {
-        TArray<ERegistryLockLevel>& LockHistory = GetThreadLockHistoryInternal();
-        
-        // Find and remove the last occurrence of this lock level
-        for (int32 Index = LockHistory.Num() - 1; Index >= 0; --Index)
-        {
-            if (LockHistory[Index] == Level)
-            {
-                LockHistory.RemoveAt(Index);
-                break;
-            }
-        }
+        FLockOrderValidator::OnRelease(ELockOrderDomain::Registry, static_cast<uint32>(Level));
     }
     
     /**
      * Gets the thread's current lock history
      * 
-     * @return Array of lock levels currently held by this thread
+     * @return Array of lock levels currently held by this thread, in hierarchy order
      */
     static TArray<ERegistryLockLevel> GetThreadLockHistory()
     {
-        return GetThreadLockHistoryInternal();
+        TArray<ERegistryLockLevel> LockHistory;
+        for (uint32 Level : FLockOrderValidator::GetHeldLevels(ELockOrderDomain::Registry))
+        {
+            LockHistory.Add(static_cast<ERegistryLockLevel>(Level));
+        }
+        return LockHistory;
     }
     
     /**
@@ -153,8 +144,7 @@ public:
      */
     static void ClearThreadLockHistory()
     {
-        TArray<ERegistryLockLevel>& LockHistory = GetThreadLockHistoryInternal();
-        LockHistory.Reset();
+        FLockOrderValidator::ResetThread(ELockOrderDomain::Registry);
     }
     
     /**
@@ -180,24 +170,39 @@ public:
         
         return true;
     }
+};
+
+/**
+ * Per-thread slot used to spread reader bookkeeping across cache lines
+ * Slots are handed out round robin on a thread's first use, so up to MaxSlots threads never share one
+ */
+class MININGSPICECOPILOT_API FThreadStripeSlot
+{
+public:
+    /** Upper bound on the number of stripes a structure should allocate */
+    static constexpr int32 MaxSlots = 64;
 
-private:
     /**
-     * Gets the thread-local lock history
-     * @return Reference to the thread's lock history
+     * Gets the calling thread's slot
+     * @return Slot in [0, MaxSlots)
      */
-    static TArray<ERegistryLockLevel>& GetThreadLockHistoryInternal()
-    {
-        // Thread-local storage ensures each thread has its own history
-        // This approach avoids the "data with thread storage duration may not have dll interface" error
-        static thread_local TArray<ERegistryLockLevel> LocalHistory;
-        return LocalHistory;
-    }
+    static int32 Get();
+
+    /**
+     * Gets the stripe count structures should allocate on this machine
+     * @return Hardware thread count rounded up to a power of two, at most MaxSlots
+     */
+    static int32 GetStripeCount();
 };
 
 /**
  * Reader-writer lock optimized for shared distance field state
- * Provides fast access for read-heavy workloads with minimal contention
+ * Readers announce themselves on per-thread striped counters, each on its own cache line, so an
+ * uncontended read touches only one line that no other reader writes. A writer claims ownership,
+ * which makes new readers back off, then drains the stripes. Blocked readers and writers park on
+ * events and are woken by the thread that releases them rather than polling.
+ * A thread holding the write lock may also read, and a thread may re-enter the read lock while a
+ * writer is draining.
  */
 class MININGSPICECOPILOT_API FMiningReaderWriterLock
 {
@@ -244,24 +249,52 @@ public:
     void DowngradeToReadLock();
 
 private:
-    /** Number of active readers */
-    FThreadSafeCounter ReaderCount;
+    /** Reader counter padded to a full cache line */
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) FReaderStripe
+    {
+        std::atomic<int32> Count{0};
+    };
+
+    /** Reader stripes (power-of-two count) */
+    FReaderStripe* ReaderStripes;
     
-    /** Flag indicating if a writer is active */
-    FThreadSafeCounter WriterActive;
+    /** Stripe count minus one */
+    int32 StripeMask;
     
-    /** Flag indicating if a writer is waiting */
-    FThreadSafeCounter WriterWaiting;
+    /** ID of the thread owning the write lock (0 if none); readers back off while it is set */
+    std::atomic<uint32> WriterThreadId;
     
-    /** ID of the thread currently holding a write lock */
-    FThreadSafeCounter WriterThreadId;
+    /** Write lock recursion depth, only touched by the owning thread */
+    int32 WriterRecursion;
     
-    /** Event for writers to wait on */
+    /** Number of writers waiting for ownership or draining readers */
+    std::atomic<int32> WriterWaiting;
+    
+    /** Auto-reset event for writers waiting for ownership */
     FEvent* WriterEvent;
     
-    /** Event for readers to wait on */
+    /** Auto-reset event for the owning writer waiting for readers to drain */
+    FEvent* DrainEvent;
+    
+    /** Manual-reset event that is open while no writer owns the lock */
     FEvent* ReaderEvent;
     
+    /** Gets the reader stripe assigned to the calling thread */
+    FReaderStripe& GetThreadStripe() const;
+    
+    /** Removes a reader from a stripe and wakes a draining writer if there is one */
+    void ReleaseReaderStripe(FReaderStripe& Stripe);
+    
+    /**
+     * Waits until every reader stripe is empty
+     * @param EndTime Absolute deadline in seconds (DBL_MAX for no timeout)
+     * @return True if all readers drained before the deadline
+     */
+    bool DrainReaders(double EndTime);
+    
+    /** Clears write ownership and wakes blocked readers and one waiting writer */
+    void ReleaseWriterOwnership();
+    
     /** Gets the current thread ID */
     static uint32 GetCurrentThreadId();
 };
@@ -351,9 +384,8 @@ public:
     /** Gets whether this lock is currently held by the calling thread */
     bool IsLockedByCurrentThread() const;
 
-    /** Thread-specific highest acquired lock level - stored using platform TLS */
+    /** Gets the highest hierarchical lock level the calling thread holds (0 if none or not validated) */
     static uint32 GetThreadHighestLockLevel();
-    static void SetThreadHighestLockLevel(uint32 Level);
 
 private:
     /** Lock hierarchy level */
@@ -367,9 +399,6 @@ private:
     
     /** Whether the lock is currently held */
     FThreadSafeCounter LockCount;
-    
-    /** TLS slot for the ThreadHighestLockLevel */
-    static uint32 ThreadHighestLockLevelTLS;
 };
 
 /**
@@ -393,26 +422,12 @@ public:
     {
         if (Lock)
         {
-            if (FRegistryOperationValidator::CanSafelyAcquireLock(Level))
-            {
-                bLocked = Lock->Lock(TimeoutMs);
-                if (bLocked)
-                {
-                    FRegistryOperationValidator::AddLockToHistory(Level);
-                }
-            }
-            else
+            // Validate before blocking so an ordering deadlock is reported instead of hanging
+            FRegistryOperationValidator::AddLockToHistory(Level);
+            bLocked = Lock->Lock(TimeoutMs);
+            if (!bLocked)
             {
-                // Log the violation in debug builds
-                UE_LOG(LogTemp, Error, TEXT("Lock hierarchy violation detected! Attempting to acquire %s lock while holding incompatible locks."),
-                    *UEnum::GetValueAsString(Level));
-                
-                // In shipping builds, we'll still try to acquire the lock but log the error
-                bLocked = Lock->Lock(TimeoutMs);
-                if (bLocked)
-                {
-                    FRegistryOperationValidator::AddLockToHistory(Level);
-                }
+                FRegistryOperationValidator::RemoveLockFromHistory(Level);
             }
         }
     }
@@ -456,7 +471,10 @@ private:
 };
 
 /**
- * A hybrid lock that can switch between spin lock and critical section based on contention
+ * General-purpose lock with timeout support
+ * Uncontended acquisition is a single CAS; contended waiters spin with backoff for a budget
+ * learned from recent waits and then park, so the lock behaves like a spin lock for short
+ * critical sections and like a critical section for long ones without switching modes
  */
 class MININGSPICECOPILOT_API FHybridLock
 {
@@ -477,33 +495,31 @@ public:
     /** Releases the lock */
     void Unlock();
     
-    /** Gets the contention count */
+    /** Gets the number of acquisitions that found the lock held */
     uint32 GetContentionCount() const;
     
     /** Resets contention statistics */
     void ResetContentionStats();
     
-    /** Sets the threshold for switching lock types */
+    /**
+     * Sets the threshold for switching lock types
+     * Kept for compatibility; spinning versus parking is now decided per acquisition by the
+     * learned spin budget, so the threshold has no effect
+     */
     void SetContentionThreshold(uint32 Threshold);
 
 private:
-    /** Critical section for high-contention case */
-    FCriticalSection SlowLock;
+    /** Lock word (see FAdaptiveSpinWait) */
+    std::atomic<int32> State;
     
-    /** Spin lock for low-contention case */
-    TAtomic<int32> FastLock;
+    /** Spin budget learned from recent waits */
+    FAdaptiveSpinWait::FSpinBudget Budget;
     
     /** Current contention count */
     FThreadSafeCounter ContentionCount;
     
-    /** Contention threshold for switching lock types */
-    uint32 ContentionThreshold;
-    
-    /** Whether to use the slow lock */
-    FThreadSafeCounter bUseSlowLock;
-    
-    /** Updates contention statistics */
-    void UpdateContentionStats();
+    /** Acquires the lock without profiling */
+    bool AcquireLock(uint32 TimeoutMs);
 };
 
 /**
@@ -546,16 +562,48 @@ private:
 
 /**
  * Versioned type table for registry implementations
- * Provides atomic access to type information with optimistic concurrency
+ * Readers never lock and never touch a reference count: the table is an immutable open-addressed
+ * snapshot published by pointer swap. Writers serialize, take the next version, and publish a rebuilt
+ * snapshot stamped with it; superseded snapshots are retired through FEpochManager.
+ * Pointers returned by FindTypeInfo stay valid for the lifetime of the FReadScope they were found under,
+ * or for as long as the calling thread stays pinned (task workers are pinned while running a task).
  */
 template<typename TTypeInfo>
 class MININGSPICECOPILOT_API FVersionedTypeTable
 {
+    struct FSnapshot;
+
 public:
+    /**
+     * Pins the calling thread so snapshots it reads are not reclaimed
+     * Scopes are an FEpochGuard tied to one table and may nest
+     */
+    class FReadScope
+    {
+    public:
+        explicit FReadScope(const FVersionedTypeTable& InTable)
+            : Table(InTable)
+        {
+        }
+
+    private:
+        friend class FVersionedTypeTable;
+
+        const FVersionedTypeTable& Table;
+        FEpochGuard Guard;
+    };
+
     /** Constructor */
     FVersionedTypeTable()
-        : Version(0)
+        : Published(BuildSnapshot(TMap<uint32, TSharedRef<TTypeInfo>>(), 0))
+        , Version(0)
+    {
+    }
+    
+    /** Destructor; no readers may be active, retired snapshots belong to the epoch manager */
+    ~FVersionedTypeTable()
     {
+        delete Published.load(std::memory_order_acquire);
     }
     
     /** Gets the current version */
@@ -583,15 +631,44 @@ public:
         return Version.compare_exchange_strong(OutOldVersion, NewVersion, std::memory_order_acq_rel);
     }
     
+    /**
+     * Finds a type info without locking or copying a shared pointer
+     * @param TypeId The ID of the type to retrieve
+     * @param Scope Read scope pinning the table; the result is valid until the scope ends
+     * @return Type info, or nullptr if not found
+     */
+    const TTypeInfo* FindTypeInfo(uint32 TypeId, const FReadScope& Scope) const
+    {
+        check(&Scope.Table == this);
+        return Published.load(std::memory_order_acquire)->Find(TypeId);
+    }
+    
+    /**
+     * Finds a type info together with the version it was read at
+     * Both come from the same snapshot, so the result is exactly the entry published under OutVersion
+     * @param TypeId The ID of the type to retrieve
+     * @param OutVersion Receives the version of the snapshot the lookup was made in
+     * @param Scope Read scope pinning the table; the result is valid until the scope ends
+     * @return Type info, or nullptr if not found
+     */
+    const TTypeInfo* FindTypeInfoVersioned(uint32 TypeId, uint32& OutVersion, const FReadScope& Scope) const
+    {
+        check(&Scope.Table == this);
+        const FSnapshot* Snapshot = Published.load(std::memory_order_acquire);
+        OutVersion = Snapshot->Version;
+        return Snapshot->Find(TypeId);
+    }
+    
     /**
      * Gets a type info by ID
+     * Prefer FindTypeInfo on hot paths; this copies a shared pointer out of the snapshot
      * @param TypeId The ID of the type to retrieve
      * @return Shared reference to the type info, or nullptr if not found
      */
     TSharedPtr<TTypeInfo> GetTypeInfo(uint32 TypeId) const
     {
-        FScopedReadLock ReadLock(TypeTableLock);
-        auto* Found = Types.Find(TypeId);
+        FReadScope Scope(*this);
+        const TSharedRef<TTypeInfo>* Found = Published.load(std::memory_order_acquire)->Types.Find(TypeId);
         if (Found)
         {
             return *Found;
@@ -607,19 +684,14 @@ public:
      */
     TSharedPtr<TTypeInfo> GetTypeInfoVersioned(uint32 TypeId, uint32& OutVersion) const
     {
-        // Load the current version
-        OutVersion = LoadVersion();
-        
-        // Try optimistic read first
+        FReadScope Scope(*this);
+        const FSnapshot* Snapshot = Published.load(std::memory_order_acquire);
+        OutVersion = Snapshot->Version;
+        const TSharedRef<TTypeInfo>* Found = Snapshot->Types.Find(TypeId);
+        if (Found)
         {
-            FScopedReadLock ReadLock(TypeTableLock);
-            auto* Found = Types.Find(TypeId);
-            if (Found)
-            {
-                return *Found;
-            }
+            return *Found;
         }
-        
         return nullptr;
     }
     
@@ -630,9 +702,10 @@ public:
      */
     void AddOrUpdateTypeInfo(uint32 TypeId, TSharedRef<TTypeInfo> TypeInfo)
     {
-        FScopedWriteLock WriteLock(TypeTableLock);
+        FScopeLock Lock(&WriterLock);
+        TMap<uint32, TSharedRef<TTypeInfo>> Types = Published.load(std::memory_order_relaxed)->Types;
         Types.Add(TypeId, TypeInfo);
-        IncrementVersion();
+        PublishLocked(Types);
     }
     
     /**
@@ -642,10 +715,11 @@ public:
      */
     bool RemoveTypeInfo(uint32 TypeId)
     {
-        FScopedWriteLock WriteLock(TypeTableLock);
+        FScopeLock Lock(&WriterLock);
+        TMap<uint32, TSharedRef<TTypeInfo>> Types = Published.load(std::memory_order_relaxed)->Types;
         if (Types.Remove(TypeId) > 0)
         {
-            IncrementVersion();
+            PublishLocked(Types);
             return true;
         }
         return false;
@@ -658,8 +732,8 @@ public:
     TArray<uint32> GetAllTypeIds() const
     {
         TArray<uint32> Result;
-        FScopedReadLock ReadLock(TypeTableLock);
-        Types.GetKeys(Result);
+        FReadScope Scope(*this);
+        Published.load(std::memory_order_acquire)->Types.GetKeys(Result);
         return Result;
     }
     
@@ -669,8 +743,8 @@ public:
      */
     TMap<uint32, TSharedRef<TTypeInfo>> GetAllTypeInfos() const
     {
-        FScopedReadLock ReadLock(TypeTableLock);
-        return Types;
+        FReadScope Scope(*this);
+        return Published.load(std::memory_order_acquire)->Types;
     }
     
     /**
@@ -678,9 +752,8 @@ public:
      */
     void Clear()
     {
-        FScopedWriteLock WriteLock(TypeTableLock);
-        Types.Empty();
-        IncrementVersion();
+        FScopeLock Lock(&WriterLock);
+        PublishLocked(TMap<uint32, TSharedRef<TTypeInfo>>());
     }
     
     /**
@@ -689,19 +762,102 @@ public:
      */
     int32 Num() const
     {
-        FScopedReadLock ReadLock(TypeTableLock);
-        return Types.Num();
+        FReadScope Scope(*this);
+        return Published.load(std::memory_order_acquire)->Types.Num();
     }
 
 private:
-    /** Table of type infos */
-    TMap<uint32, TSharedRef<TTypeInfo>> Types;
+    /** Immutable table contents; replaced wholesale on every update */
+    struct FSnapshot
+    {
+        /** Owning references, also used for enumeration */
+        TMap<uint32, TSharedRef<TTypeInfo>> Types;
+        
+        /** Open-addressed slot keys: TypeId with bit 32 set, or 0 if empty */
+        TArray<uint64> SlotKeys;
+        
+        /** Type info for each slot */
+        TArray<const TTypeInfo*> SlotInfos;
+        
+        /** Slot count minus one (slot count is a power of two) */
+        uint32 Mask;
+        
+        /** Table version this snapshot was published under */
+        uint32 Version;
+                
+        /** Finds a type info by linear probing */
+        const TTypeInfo* Find(uint32 TypeId) const
+        {
+            uint64 Key = static_cast<uint64>(TypeId) | OccupiedBit;
+            for (uint32 Index = HashTypeId(TypeId) & Mask; ; Index = (Index + 1) & Mask)
+            {
+                uint64 SlotKey = SlotKeys[Index];
+                if (SlotKey == Key)
+                {
+                    return SlotInfos[Index];
+                }
+                if (SlotKey == 0)
+                {
+                    return nullptr;
+                }
+            }
+        }
+    };
+    
+    /** Occupied flag folded into slot keys so type ID 0 is distinguishable from empty */
+    static constexpr uint64 OccupiedBit = 1ull << 32;
+    
+    /** Spreads sequential type IDs across the table */
+    static uint32 HashTypeId(uint32 TypeId)
+    {
+        return TypeId * 2654435761u;
+    }
+    
+    /** Builds a snapshot with at most half of its slots in use */
+    static FSnapshot* BuildSnapshot(const TMap<uint32, TSharedRef<TTypeInfo>>& Types, uint32 InVersion)
+    {
+        FSnapshot* Snapshot = new FSnapshot();
+        Snapshot->Types = Types;
+        Snapshot->Version = InVersion;
+        
+        uint32 SlotCount = FMath::RoundUpToPowerOfTwo(FMath::Max<uint32>(16, static_cast<uint32>(Types.Num()) * 2));
+        Snapshot->Mask = SlotCount - 1;
+        Snapshot->SlotKeys.SetNumZeroed(SlotCount);
+        Snapshot->SlotInfos.SetNumZeroed(SlotCount);
+        
+        for (const TPair<uint32, TSharedRef<TTypeInfo>>& Pair : Snapshot->Types)
+        {
+            uint32 Index = HashTypeId(Pair.Key) & Snapshot->Mask;
+            while (Snapshot->SlotKeys[Index] != 0)
+            {
+                Index = (Index + 1) & Snapshot->Mask;
+            }
+            Snapshot->SlotKeys[Index] = static_cast<uint64>(Pair.Key) | OccupiedBit;
+            Snapshot->SlotInfos[Index] = &Pair.Value.Get();
+        }
+        
+        return Snapshot;
+    }
+    
+    /** Publishes a rebuilt snapshot and retires the previous one (WriterLock held) */
+    void PublishLocked(const TMap<uint32, TSharedRef<TTypeInfo>>& Types)
+    {
+        // The snapshot carries its own version, so readers never pair it with another snapshot's
+        uint32 NewVersion = Version.fetch_add(1, std::memory_order_acq_rel) + 1;
+        FSnapshot* Previous = Published.exchange(BuildSnapshot(Types, NewVersion), std::memory_order_acq_rel);
+        
+        // Readers pinned before the exchange may still be probing the previous snapshot
+        FEpochManager::Get().Retire(Previous);
+    }
+    
+    /** Currently published snapshot */
+    std::atomic<FSnapshot*> Published;
     
     /** Current version of the table */
     std::atomic<uint32> Version;
     
-    /** Lock for table modification */
-    mutable FMiningReaderWriterLock TypeTableLock;
+    /** Serializes writers */
+    FCriticalSection WriterLock;
 };
 
 /**
@@ -953,6 +1109,7 @@ public:
     /** Acquires the lock, optimizing for same-domain threads */
     void Lock()
     {
+        uint64 ProfileStart = FLockProfiler::BeginAcquire();
         uint32 CurrentThreadId = FPlatformTLS::GetCurrentThreadId();
         // Temporarily use domain 0 until FThreadSafety is fully initialized
         uint32 CurrentDomain = 0; // Will be properly implemented after FThreadSafety is fully defined
@@ -998,11 +1155,13 @@ public:
         
         // Lock acquired
         OwnerThreadId = CurrentThreadId;
+        FLockProfiler::EndAcquire(ProfileStart, this, PLATFORM_RETURN_ADDRESS(), ELockProfileType::NUMASpin);
     }
     
     /** Releases the lock */
     void Unlock()
     {
+        FLockProfiler::Release(this);
         OwnerThreadId = 0;
         FPlatformAtomics::InterlockedExchange(&bLocked, 0);
     }
@@ -1010,9 +1169,11 @@ public:
     /** Tries to acquire the lock without waiting */
     bool TryLock()
     {
+        uint64 ProfileStart = FLockProfiler::BeginAcquire();
         if (FPlatformAtomics::InterlockedCompareExchange(&bLocked, 1, 0) == 0)
         {
             OwnerThreadId = FPlatformTLS::GetCurrentThreadId();
+            FLockProfiler::EndAcquire(ProfileStart, this, PLATFORM_RETURN_ADDRESS(), ELockProfileType::NUMASpin);
             return true;
         }
         return false;
@@ -5,11 +5,46 @@
 #include "CoreMinimal.h"
 #include "Interfaces/ITransactionManager.h"
 #include "HAL/ThreadSafeCounter.h"
+#include "HAL/ThreadSafeCounter64.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/CriticalSection.h"
 #include "Utils/SimpleSpinLock.h" // Custom implementation from spinlocks.txt
+#include "Templates/SharedPointer.h"
 
 // Forward declarations
 class FMiningTransactionContext;
 class FMiningTransactionContextImpl;
+class FTransactionManager;
+class FEvent;
+
+/**
+ * Group commit configuration
+ * When enabled, commits arriving within a short window are validated together by one
+ * leader thread. Non-conflicting transactions are published with a single increment per
+ * written version and one commit clock tick. Each committing thread then runs its own
+ * transaction's completion callback before CommitTransaction returns, as on the individual
+ * path. Conflicting transactions fall back to the individual commit path and its retry
+ * handling.
+ */
+struct FGroupCommitConfig
+{
+    /** Whether commits are grouped */
+    bool bEnabled;
+    
+    /** Time the batch leader waits for more commits to join, in microseconds */
+    float WindowMicroseconds;
+    
+    /** Batch size at which the batch closes without waiting for the window */
+    int32 MaxBatchSize;
+    
+    /** Constructor with default values */
+    FGroupCommitConfig()
+        : bEnabled(false)
+        , WindowMicroseconds(100.0f)
+        , MaxBatchSize(64)
+    {
+    }
+};
 
 /**
  * Mining transaction context implementation
@@ -18,7 +53,7 @@ class MININGSPICECOPILOT_API FMiningTransactionContextImpl : public FMiningTrans
 {
 public:
     /** Constructor */
-    FMiningTransactionContextImpl(uint64 InTransactionId, const FTransactionConfig& InConfig);
+    FMiningTransactionContextImpl(uint64 InTransactionId, const FTransactionConfig& InConfig, FTransactionManager* InManager = nullptr);
     
     /** Destructor */
     virtual ~FMiningTransactionContextImpl();
@@ -28,6 +63,7 @@ public:
     virtual ETransactionStatus GetStatus() const override;
     virtual bool AddToReadSet(int32 ZoneId, int32 MaterialId = INDEX_NONE) override;
     virtual bool AddToWriteSet(int32 ZoneId, int32 MaterialId = INDEX_NONE) override;
+    virtual bool AddCommutativeOperation(const FCommutativeFieldOp& Operation) override;
     virtual FTransactionStats GetStats() const override;
     virtual const FTransactionConfig& GetConfig() const override;
     virtual TArray<FTransactionConflict> GetConflicts() const override;
@@ -44,6 +80,9 @@ public:
     /** Gets the write set */
     const TArray<FVersionRecord>& GetWriteSet() const;
     
+    /** Gets the commutative operation log */
+    const TArray<FCommutativeFieldOp>& GetOperationLog() const;
+    
     /** Adds a conflict to the transaction */
     void AddConflict(const FTransactionConflict& Conflict);
     
@@ -68,16 +107,22 @@ public:
     /** Sets the resource usage for the transaction */
     void SetPeakMemoryUsage(uint64 MemoryUsageBytes);
     
-    /** Clears the read and write sets for retry */
+    /** Clears the read and write sets and the operation log for retry */
     void ClearReadWriteSets();
     
     /** Gets a reference to the stats (for internal use by FTransactionManager) */
     FTransactionStats& GetMutableStats() { return Stats; }
 
 private:
+    /** Adds a record to the read set; Lock must be held */
+    void AddToReadSetLocked(int32 ZoneId, int32 MaterialId, uint32 Version);
+    
     /** Transaction ID */
     uint64 TransactionId;
     
+    /** Manager that owns this transaction, used to observe versions (may be null) */
+    FTransactionManager* Manager;
+    
     /** Transaction status */
     ETransactionStatus Status;
     
@@ -90,6 +135,9 @@ private:
     /** Write set (zones and materials to be modified) */
     TArray<FVersionRecord> WriteSet;
     
+    /** Commutative field operations performed by this transaction */
+    TArray<FCommutativeFieldOp> OperationLog;
+    
     /** Conflicts detected during validation */
     TArray<FTransactionConflict> Conflicts;
     
@@ -147,11 +195,80 @@ public:
     virtual bool UpdateFastPathThreshold(uint32 TypeId, float ConflictRate) override;
     
     virtual bool RegisterCompletionCallback(uint32 TypeId, const FTransactionCompletionDelegate& Callback) override;
+    virtual bool RegisterOperationApplier(uint32 TypeId, const FCommutativeOpApplyDelegate& Applier) override;
     
     static ITransactionManager& Get();
     //~ End ITransactionManager Interface
     
+    /**
+     * Sets the group commit configuration
+     * @param InConfig New configuration; takes effect for commits that start afterwards
+     */
+    void SetGroupCommitConfig(const FGroupCommitConfig& InConfig);
+    
+    /**
+     * Gets the group commit configuration
+     * @return Current configuration
+     */
+    FGroupCommitConfig GetGroupCommitConfig() const;
+    
+    /**
+     * Reads the current version of a zone or material (used by transaction contexts)
+     * @param ZoneId ID of the zone
+     * @param MaterialId ID of the material (INDEX_NONE for the zone version)
+     * @return Current version
+     */
+    uint32 ReadCurrentVersion(int32 ZoneId, int32 MaterialId);
+    
 private:
+    /** Outcome of a transaction within a commit batch */
+    enum class EGroupCommitResult : uint8
+    {
+        /** Batch has not been processed yet */
+        Pending,
+        
+        /** Transaction was published with the batch */
+        Committed,
+        
+        /** Transaction conflicted and must take the individual commit path */
+        Conflict
+    };
+    
+    /** Transactions collected during one group commit window */
+    struct FCommitBatch
+    {
+        FCommitBatch();
+        ~FCommitBatch();
+        
+        /** Transactions in arrival order */
+        TArray<FMiningTransactionContextImpl*> Transactions;
+        
+        /** Result per transaction, filled in by the leader */
+        TArray<EGroupCommitResult> Results;
+        
+        /** Set once no more transactions may join */
+        FThreadSafeBool bClosed;
+        
+        /** Triggered by the leader once results are available */
+        FEvent* DoneEvent;
+    };
+    
+    /** Commits a transaction that is already in the Committing state on its own */
+    bool CommitTransactionIndividually(FMiningTransactionContextImpl* Transaction);
+    
+    /**
+     * Joins or leads a commit batch
+     * @return True if the transaction was committed with the batch, false if it conflicted
+     */
+    bool CommitTransactionGrouped(FMiningTransactionContextImpl* Transaction);
+    
+    /** Validates and publishes a closed batch; called by the batch leader */
+    void ProcessCommitBatch(FCommitBatch& Batch);
+    
+    /** Executes the completion callback for a committed transaction */
+    void ExecuteCompletionCallback(FMiningTransactionContextImpl* Transaction);
+    
+
     /** Whether the transaction manager has been initialized */
     bool bIsInitialized;
     
@@ -194,9 +311,59 @@ private:
     /** Map of completion callbacks by transaction type ID */
     TMap<uint32, FTransactionCompletionDelegate> CompletionCallbacks;
     
+    /** Map of operation log appliers by transaction type ID */
+    TMap<uint32, FCommutativeOpApplyDelegate> OperationAppliers;
+    
     /** Lock for callback map access */
     mutable FSimpleSpinLock CallbackLock;
     
+    /** Versions at which each commutativity class last wrote a zone or material */
+    struct FWriteMergeState
+    {
+        /** Version published by the latest Min-class write */
+        uint32 LastMinVersion;
+        
+        /** Version published by the latest Max-class write */
+        uint32 LastMaxVersion;
+        
+        /** Version published by the latest write that cannot be reordered */
+        uint32 LastNonCommutativeVersion;
+        
+        FWriteMergeState()
+            : LastMinVersion(0)
+            , LastMaxVersion(0)
+            , LastNonCommutativeVersion(0)
+        {
+        }
+    };
+    
+    /** Merge state by version key; guarded by CommitLock */
+    TMap<uint64, FWriteMergeState> WriteMergeStates;
+    
+    /**
+     * Serializes validation with version publication so commits are atomic
+     * Operation logs are applied under it so they reach the data in version order, and appliers
+     * can take arbitrarily long, so it is a blocking lock rather than a spinlock
+     */
+    FCriticalSection CommitLock;
+    
+    /** Group commit configuration */
+    FGroupCommitConfig GroupCommitConfig;
+    
+    /** Batch currently accepting transactions, or null if none is open */
+    TSharedPtr<FCommitBatch, ESPMode::ThreadSafe> OpenBatch;
+    
+    /** Lock for group commit configuration and the open batch */
+    mutable FSimpleSpinLock BatchLock;
+    
+    /** Global commit clock, advanced once per published commit or batch */
+    FThreadSafeCounter64 CommitClock;
+    
+    /** Group commit statistics */
+    uint64 GroupCommitBatches;
+    uint64 GroupCommittedTransactions;
+    uint64 GroupCommitFallbacks;
+    
     /** Generates a unique transaction ID */
     uint64 GenerateTransactionId();
     
@@ -212,9 +379,18 @@ private:
     /** Gets a version record from a zone and material */
     FVersionRecord GetVersionRecord(int32 ZoneId, int32 MaterialId, bool bIsReadOnly);
     
-    /** Updates versions for a committed transaction */
+    /** Updates versions and merge state for a committed transaction; CommitLock must be held */
     void UpdateVersions(const FMiningTransactionContextImpl* Transaction);
     
+    /** Updates versions and applies the operation log of a committed transaction; CommitLock must be held */
+    void PublishTransaction(const FMiningTransactionContextImpl* Transaction);
+    
+    /** Gets the commutativity class of the operations a transaction logged for one write record */
+    static ECommutativeOpClass GetWriteClass(const FMiningTransactionContextImpl* Transaction, const FVersionRecord& WriteRecord);
+    
+    /** Combines a zone and material ID into a single key */
+    static uint64 MakeVersionKey(int32 ZoneId, int32 MaterialId);
+    
     /** Validates transaction read set versions */
     bool ValidateReadSet(const FMiningTransactionContextImpl* Transaction, TArray<FTransactionConflict>& OutConflicts);
     
@@ -227,8 +403,13 @@ private:
     /** Should this transaction use the fast path */
     bool ShouldUseFastPath(const FMiningTransactionContextImpl* Transaction) const;
     
-    /** Helper method to merge changes when conflict occurs but can be resolved */
-    bool MergeChanges(FMiningTransactionContextImpl* Transaction);
+    /**
+     * Publishes a conflicting transaction by replaying its operation log on the latest state
+     * Succeeds only if every changed record is a write covered by operations of one commutativity
+     * class and every write published since it was read was of that same class
+     * @return True if the transaction was merged and published
+     */
+    bool TryMergeAndPublish(FMiningTransactionContextImpl* Transaction);
 
     /** Singleton instance */
     static FTransactionManager* Instance;
@@ -3,63 +3,35 @@
 #include "CoreMinimal.h"
 #include "HAL/PlatformProcess.h"
 #include "HAL/PlatformAtomics.h"
+#include "AdaptiveSpinWait.h"
 
 /**
  * High-performance spin lock implementation optimized for low contention scenarios
- * Uses exponential backoff to reduce CPU usage under contention
+ * Contended waiters spin with exponential backoff for a learned budget and then park
  */
 class MININGSPICECOPILOT_API FSimpleSpinLock
 {
 private:
-    /** The lock state - 0 means unlocked, 1 means locked */
-    volatile int32 LockState;
+    /** The lock word (see FAdaptiveSpinWait) */
+    std::atomic<int32> LockState;
+
+    /** Spin budget learned from recent waits */
+    FAdaptiveSpinWait::FSpinBudget Budget;
 
 public:
     /** Constructor */
-    FORCEINLINE FSimpleSpinLock() : LockState(0) {}
+    FORCEINLINE FSimpleSpinLock() : LockState(FAdaptiveSpinWait::Unlocked) {}
 
     /** Destructor */
     FORCEINLINE ~FSimpleSpinLock() {}
 
     /**
-     * Acquires the lock, spinning until successful
-     * Uses exponential backoff to reduce CPU usage during contention
+     * Acquires the lock
+     * Spins with exponential backoff while the owner is likely to release soon, then parks
      */
     FORCEINLINE void Lock()
     {
-        // First attempt - optimistic lock acquisition without backoff
-        if (TryLock())
-        {
-            return;
-        }
-
-        // Enter contention path with exponential backoff
-        uint32 SpinCount = 0;
-        while (!TryLock())
-        {
-            // Exponential backoff - prevents cache line thrashing and excessive CPU usage
-            if (SpinCount < 10u) // Fixed: using unsigned literal
-            {
-                // Initial backoff - use CPU yield/pause instruction
-                for (uint32 i = 0; i < (1u << SpinCount); ++i)
-                {
-                    FPlatformProcess::Yield();
-                }
-            }
-            else if (SpinCount < 20u) // Fixed: using unsigned literal
-            {
-                // Medium backoff - sleep for short periods
-                FPlatformProcess::SleepNoStats(0.0001f); // 0.1ms
-            }
-            else
-            {
-                // Long backoff - sleep for longer periods
-                FPlatformProcess::SleepNoStats(0.001f); // 1ms
-            }
-            
-            // Increment spin count, capping at 30 to prevent overflow
-            SpinCount = FMath::Min(SpinCount + 1, 30u);
-        }
+        FAdaptiveSpinWait::Lock(LockState, Budget);
     }
 
     /**
@@ -68,17 +40,15 @@ public:
      */
     FORCEINLINE bool TryLock()
     {
-        // Atomically exchange 0 with 1, returns the previous value
-        return FPlatformAtomics::InterlockedCompareExchange(&LockState, 1, 0) == 0;
+        return FAdaptiveSpinWait::TryLock(LockState);
     }
 
     /**
-     * Releases the lock
+     * Releases the lock, waking one parked waiter if there is one
      */
     FORCEINLINE void Unlock()
     {
-        // Memory barrier to ensure all writes while lock was held are visible
-        FPlatformAtomics::InterlockedExchange(&LockState, 0); // Fixed: Using InterlockedExchange instead of MemoryBarrier
+        FAdaptiveSpinWait::Unlock(LockState);
     }
 
     /**
@@ -87,6 +57,6 @@ public:
      */
     FORCEINLINE bool IsLocked() const
     {
-        return LockState != 0;
+        return LockState.load(std::memory_order_relaxed) != FAdaptiveSpinWait::Unlocked;
     }
 };
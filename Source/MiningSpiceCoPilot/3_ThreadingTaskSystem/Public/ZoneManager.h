@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "HAL/ThreadSafeCounter.h"
 #include "HAL/CriticalSection.h"
+#include "ZoneSpatialHash.h"
+#include "ZoneRebalancer.h"
 
 /**
  * Zone access mode for memory and concurrency optimization
@@ -141,10 +143,91 @@ struct FZoneDescriptor
     }
 };
 
+/**
+ * Copy of a zone's placement
+ * Unlike a descriptor pointer, stays valid after the zone is split, merged or removed
+ */
+struct FZoneSnapshot
+{
+    /** Zone ID */
+    int32 ZoneId;
+    
+    /** Region ID this zone belongs to */
+    int32 RegionId;
+    
+    /** Zone position in world space */
+    FVector Position;
+    
+    /** Zone dimensions */
+    FVector Dimensions;
+    
+    /** Constructor */
+    FZoneSnapshot()
+        : ZoneId(INDEX_NONE)
+        , RegionId(INDEX_NONE)
+        , Position(FVector::ZeroVector)
+        , Dimensions(FVector::ZeroVector)
+    {
+    }
+};
+
+/**
+ * Result of a multi-zone acquisition
+ * Records the canonical zone order and which zones were actually taken so
+ * the whole set can be released as a batch
+ */
+struct FMultiZoneAcquisition
+{
+    /** Requested zone IDs, sorted and deduplicated */
+    TArray<int32> ZoneIds;
+    
+    /** Zones taken by this acquisition (excludes zones the thread already owned exclusively) */
+    TArray<int32> AcquiredZoneIds;
+    
+    /** Thread that holds the zones */
+    int32 ThreadId;
+    
+    /** Access mode the zones were acquired with */
+    EZoneAccessMode AccessMode;
+    
+    /** Number of requested zones held when acquisition finished */
+    int32 ZonesHeld;
+    
+    /** Number of batch attempts made (1 means uncontended) */
+    int32 AttemptCount;
+    
+    /** Time spent acquiring the batch in milliseconds */
+    double WaitTimeMs;
+    
+    /** Time at which all zones became held, in seconds */
+    double AcquiredTime;
+    
+    /** Time the zones were held in milliseconds (set on release) */
+    double HoldTimeMs;
+    
+    /** Whether every requested zone is currently held */
+    bool bAcquired;
+    
+    /** Constructor */
+    FMultiZoneAcquisition()
+        : ThreadId(INDEX_NONE)
+        , AccessMode(EZoneAccessMode::ReadOnly)
+        , ZonesHeld(0)
+        , AttemptCount(0)
+        , WaitTimeMs(0.0)
+        , AcquiredTime(0.0)
+        , HoldTimeMs(0.0)
+        , bAcquired(false)
+    {
+    }
+};
+
 /**
  * Zone manager for the Mining system
  * Manages zone grid partitioning and ownership tracking
- * for transaction coordination in the mining system
+ * for transaction coordination in the mining system. While initialized it runs an
+ * FZoneRebalancer that splits hot zones and merges cold ones, unless the rebalancer
+ * config disables it.
  */
 class MININGSPICECOPILOT_API FZoneManager
 {
@@ -195,12 +278,32 @@ public:
     FZoneDescriptor* GetZone(int32 ZoneId);
     
     /**
-     * Gets a zone by world position
+     * Copies a zone's placement under ZoneLock
+     * Use this instead of GetZone when the zone may be split, merged or removed concurrently
+     * @param ZoneId ID of the zone
+     * @param OutSnapshot Receives the zone's ID, region, position and dimensions
+     * @return True if the zone exists
+     */
+    bool GetZoneSnapshot(int32 ZoneId, FZoneSnapshot& OutSnapshot) const;
+    
+    /**
+     * Gets a zone by world position without locking
+     * Removed, split and merged zones are retired through FEpochManager, so the descriptor stays
+     * valid only while the caller holds an FEpochGuard. Task workers are pinned while running a
+     * task; other callers must take a guard before the call and keep it while using the result.
      * @param Position World position to find zone at
      * @return Zone descriptor or nullptr if not found
      */
     FZoneDescriptor* GetZoneAtPosition(const FVector& Position);
     
+    /**
+     * Gets the ID of the zone at a world position
+     * Prefer this over GetZoneAtPosition when zones may be split or merged concurrently
+     * @param Position World position to query
+     * @return Zone ID or INDEX_NONE if no zone exists at the position
+     */
+    int32 GetZoneIdAtPosition(const FVector& Position) const;
+    
     /**
      * Acquires ownership of a zone
      * @param ZoneId ID of the zone to acquire
@@ -219,6 +322,38 @@ public:
      */
     bool ReleaseZoneOwnership(int32 ZoneId, int32 ThreadId);
     
+    /**
+     * Acquires several zones as a batch without risking deadlock
+     * Zone IDs are sorted and deduplicated and taken in ascending order; if any zone
+     * is busy every zone taken so far is released and the batch backs off before retrying
+     * @param ZoneIds IDs of the zones to acquire (duplicates and order are ignored)
+     * @param ThreadId ID of the thread acquiring ownership
+     * @param AccessMode Mode of access applied to every zone
+     * @param OutAcquisition Receives the held zones and acquisition timings
+     * @param TimeoutMs Maximum time to wait in milliseconds (0 for the default timeout)
+     * @return True if all zones were acquired
+     */
+    bool AcquireZones(TArrayView<const int32> ZoneIds, int32 ThreadId, EZoneAccessMode AccessMode, FMultiZoneAcquisition& OutAcquisition, uint32 TimeoutMs = 0);
+    
+    /**
+     * Attempts to acquire several zones in a single pass without waiting
+     * Either every zone is acquired or none are held on return
+     * @param ZoneIds IDs of the zones to acquire (duplicates and order are ignored)
+     * @param ThreadId ID of the thread acquiring ownership
+     * @param AccessMode Mode of access applied to every zone
+     * @param OutAcquisition Receives the held zones and acquisition timings
+     * @return True if all zones were acquired
+     */
+    bool TryAcquireZones(TArrayView<const int32> ZoneIds, int32 ThreadId, EZoneAccessMode AccessMode, FMultiZoneAcquisition& OutAcquisition);
+    
+    /**
+     * Releases zones previously taken with AcquireZones or TryAcquireZones
+     * Zones are released in reverse acquisition order and the hold time is recorded
+     * @param Acquisition Acquisition to release; HoldTimeMs is filled in
+     * @return True if every acquired zone was released
+     */
+    bool ReleaseZones(FMultiZoneAcquisition& Acquisition);
+    
     /**
      * Gets the current owner thread of a zone
      * @param ZoneId ID of the zone to check
@@ -233,6 +368,12 @@ public:
      */
     TArray<int32> GetZonesInRegion(int32 RegionId) const;
     
+    /**
+     * Gets the IDs of all zones
+     * @return Array of every zone ID
+     */
+    TArray<int32> GetAllZoneIds() const;
+    
     /**
      * Gets all zones within a radius from a position
      * @param Position Center position
@@ -329,6 +470,18 @@ public:
      */
     bool SplitZone(int32 ZoneId);
     
+    /**
+     * Splits a zone into eight octant zones without checking its metrics
+     * The parent is claimed, its children are published with the parent's version plus one
+     * and its material versions, and the parent is removed in a single critical section. The
+     * parent's descriptor is retired through FEpochManager, so pinned lock-free readers may
+     * keep using it until they unpin
+     * @param ZoneId ID of the zone to split
+     * @param OutChildZoneIds Receives the IDs of the new zones
+     * @return True if the zone was split; fails if the zone is owned
+     */
+    bool SplitZoneIntoOctants(int32 ZoneId, TArray<int32>& OutChildZoneIds);
+    
     /**
      * Merges two adjacent zones with low usage
      * @param ZoneId1 ID of the first zone
@@ -337,6 +490,16 @@ public:
      */
     bool MergeZones(int32 ZoneId1, int32 ZoneId2);
     
+    /**
+     * Merges two zones of the same region into one zone covering both, without checking metrics
+     * The merged zone takes the higher version plus one and the highest version of each material.
+     * The source descriptors are retired through FEpochManager like a split's parent
+     * @param ZoneId1 ID of the first zone
+     * @param ZoneId2 ID of the second zone
+     * @return ID of the merged zone or INDEX_NONE if either zone is owned or missing
+     */
+    int32 MergeZonesInto(int32 ZoneId1, int32 ZoneId2);
+    
     /**
      * Checks if two zones are adjacent in space
      * @param ZoneId1 ID of the first zone
@@ -345,6 +508,25 @@ public:
      */
     bool AreZonesAdjacent(int32 ZoneId1, int32 ZoneId2);
     
+    /**
+     * Replaces the rebalancer thresholds; starts or stops the rebalancer thread to match bEnabled
+     * Call from the thread that initializes and shuts down the manager
+     * @param InConfig New rebalancer configuration
+     */
+    void SetRebalancerConfig(const FZoneRebalancerConfig& InConfig);
+    
+    /**
+     * Gets the rebalancer configuration
+     * @return Current configuration
+     */
+    FZoneRebalancerConfig GetRebalancerConfig() const;
+    
+    /**
+     * Gets statistics of the running rebalancer
+     * @return Current statistics, or empty statistics if the rebalancer is not running
+     */
+    FZoneRebalancerStats GetRebalancerStats() const;
+    
     /**
      * Reorganizes materials within a fragmented zone
      * @param ZoneId ID of the zone to reorganize
@@ -368,11 +550,11 @@ private:
     /** Map of zone sets by region ID */
     TMap<int32, TSet<int32>> ZonesByRegion;
     
-    /** Spatial lookup grid for fast position-based queries */
-    TMap<FIntVector, TArray<int32>> SpatialLookup;
+    /** Lock-free spatial hash for position-based queries (written under ZoneLock) */
+    FZoneSpatialHash SpatialHash;
     
-    /** Map of spatial keys by zone ID for efficient removal */
-    TMap<int32, FIntVector> ZoneSpatialKeys;
+    /** Spatial hash cells each zone was inserted into, for removal */
+    TMap<int32, TArray<FIntVector>> ZoneSpatialKeys;
     
     /** Next zone ID */
     FThreadSafeCounter NextZoneId;
@@ -380,6 +562,18 @@ private:
     /** Lock for zone data access */
     mutable FCriticalSection ZoneLock;
     
+    /** Configuration applied to the rebalancer when it starts */
+    FZoneRebalancerConfig RebalancerConfig;
+    
+    /** Background rebalancer, running while the manager is initialized and the config enables it */
+    TUniquePtr<FZoneRebalancer> Rebalancer;
+    
+    /** Creates and starts the rebalancer if the config enables it */
+    void StartRebalancer();
+    
+    /** Stops and destroys the rebalancer */
+    void StopRebalancer();
+    
     /**
      * Computes the spatial grid key for a position
      * @param Position Position to compute key for
@@ -395,14 +589,15 @@ private:
     FIntVector ComputeSpatialKey(const FVector& Position) const;
     
     /**
-     * Adds a zone to the spatial lookup grid
+     * Adds a zone to every spatial lookup cell its bounds overlap
      * @param ZoneId ID of the zone to add
      * @param Position Position of the zone
+     * @param Dimensions Dimensions of the zone
      */
-    void AddZoneToSpatialLookup(int32 ZoneId, const FVector& Position);
+    void AddZoneToSpatialLookup(int32 ZoneId, const FVector& Position, const FVector& Dimensions);
     
     /**
-     * Removes a zone from the spatial lookup grid
+     * Removes a zone from every spatial lookup cell it was added to
      * @param ZoneId ID of the zone to remove
      * @param Position Position of the zone
      */
@@ -416,6 +611,91 @@ private:
      */
     FThreadSafeCounter* GetOrCreateMaterialVersion(FZoneDescriptor* Zone, int32 MaterialId);
     
+    /**
+     * Allocates a zone descriptor with a fresh ID without publishing it
+     * @param Position Zone center
+     * @param RegionId Region the zone belongs to
+     * @param Dimensions Zone size
+     * @return New zone descriptor
+     */
+    FZoneDescriptor* NewZoneDescriptor(const FVector& Position, int32 RegionId, const FVector& Dimensions);
+    
+    /**
+     * Publishes a zone to the zone, region and spatial maps (ZoneLock must be held)
+     * @param Zone Zone descriptor to publish
+     */
+    void RegisterZone(FZoneDescriptor* Zone);
+    
+    /**
+     * Unpublishes a zone regardless of ownership and retires its descriptor (ZoneLock must be held)
+     * @param Zone Zone descriptor to remove
+     */
+    void UnregisterZone(FZoneDescriptor* Zone);
+    
+    /**
+     * Claims an unowned zone for a structural change by moving it to the Transition state
+     * @param Zone Zone to claim
+     * @return True if the zone was unowned and is now in transition
+     */
+    bool BeginZoneTransition(FZoneDescriptor* Zone);
+    
+    /**
+     * Returns a zone claimed by BeginZoneTransition to the unowned state
+     * @param Zone Zone to release
+     */
+    void CancelZoneTransition(FZoneDescriptor* Zone);
+    
+    /** Outcome of a single non-blocking zone acquisition attempt */
+    enum class EZoneTryAcquireResult : uint8
+    {
+        /** Ownership was taken and must be released */
+        Acquired,
+        
+        /** Thread already owned the zone exclusively; nothing to release */
+        AlreadyOwned,
+        
+        /** Zone is held by another thread */
+        Busy,
+        
+        /** Zone no longer exists (removed, split or merged) */
+        Removed
+    };
+    
+    /**
+     * Makes one non-blocking attempt to take ownership of a zone
+     * @param Zone Zone descriptor
+     * @param ThreadId ID of the thread acquiring ownership
+     * @param AccessMode Mode of access
+     * @return Result of the attempt
+     */
+    EZoneTryAcquireResult TryAcquireZoneInternal(FZoneDescriptor* Zone, int32 ThreadId, EZoneAccessMode AccessMode);
+    
+    /**
+     * Looks up a zone and makes one attempt to take ownership while ZoneLock is held,
+     * so the descriptor cannot be retired by a split or merge during the attempt
+     * @param ZoneId ID of the zone to acquire
+     * @param ThreadId ID of the thread requesting ownership
+     * @param AccessMode Mode of access
+     * @return Result of the attempt; Removed if the zone no longer exists
+     */
+    EZoneTryAcquireResult TryAcquireZoneById(int32 ZoneId, int32 ThreadId, EZoneAccessMode AccessMode);
+    
+    /**
+     * Makes one pass over a sorted zone set, rolling back on the first busy zone
+     * @param Acquisition Acquisition state with sorted zone IDs
+     * @return Acquired if every zone is held after the pass, otherwise Busy or Removed
+     */
+    EZoneTryAcquireResult TryAcquireZoneBatch(FMultiZoneAcquisition& Acquisition);
+    
+    /**
+     * Resets an acquisition for a new request with sorted, deduplicated zone IDs
+     * @param ZoneIds Requested zone IDs
+     * @param ThreadId ID of the acquiring thread
+     * @param AccessMode Mode of access
+     * @param OutAcquisition Acquisition to initialize
+     */
+    static void PrepareZoneBatch(TArrayView<const int32> ZoneIds, int32 ThreadId, EZoneAccessMode AccessMode, FMultiZoneAcquisition& OutAcquisition);
+    
     /**
      * Updates the contention status for a zone based on metrics
      * @param Zone Zone descriptor to update
@@ -424,4 +704,64 @@ private:
     
     /** Singleton instance */
     static FZoneManager* Instance;
-};
\ No newline at end of file
+};
+
+/**
+ * Helper class for scoped multi-zone ownership
+ * Acquires a zone set in canonical order on construction and releases it on destruction
+ */
+class MININGSPICECOPILOT_API FScopedZoneOwnership
+{
+public:
+    /**
+     * Constructor
+     * @param InManager Zone manager to acquire from
+     * @param ZoneIds Zone IDs to acquire
+     * @param ThreadId ID of the acquiring thread
+     * @param AccessMode Mode of access applied to every zone
+     * @param TimeoutMs Maximum time to wait in milliseconds (0 for the default timeout)
+     */
+    FScopedZoneOwnership(FZoneManager& InManager, TArrayView<const int32> ZoneIds, int32 ThreadId, EZoneAccessMode AccessMode, uint32 TimeoutMs = 0)
+        : Manager(InManager)
+    {
+        Manager.AcquireZones(ZoneIds, ThreadId, AccessMode, Acquisition, TimeoutMs);
+    }
+    
+    /** Destructor */
+    ~FScopedZoneOwnership()
+    {
+        if (Acquisition.bAcquired)
+        {
+            Manager.ReleaseZones(Acquisition);
+        }
+    }
+    
+    /**
+     * Checks if all zones were successfully acquired
+     * @return True if all zones are held
+     */
+    bool IsLocked() const
+    {
+        return Acquisition.bAcquired;
+    }
+    
+    /**
+     * Gets the acquisition details (zones held, attempts, wait time)
+     * @return Acquisition state
+     */
+    const FMultiZoneAcquisition& GetAcquisition() const
+    {
+        return Acquisition;
+    }
+    
+private:
+    /** The zone manager */
+    FZoneManager& Manager;
+    
+    /** Acquisition state */
+    FMultiZoneAcquisition Acquisition;
+    
+    /** Disable copying */
+    FScopedZoneOwnership(const FScopedZoneOwnership&) = delete;
+    FScopedZoneOwnership& operator=(const FScopedZoneOwnership&) = delete;
+};
@@ -0,0 +1,261 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+
+class FEvent;
+class FZoneManager;
+struct FZoneSnapshot;
+
+/**
+ * Thresholds controlling when the zone rebalancer splits and merges zones
+ */
+struct FZoneRebalancerConfig
+{
+    /** Whether FZoneManager runs its rebalancer thread */
+    bool bEnabled;
+
+    /** Seconds between metric samples */
+    float SampleIntervalSeconds;
+
+    /** Smoothing factor for the per-zone moving averages (0-1, higher reacts faster) */
+    float SmoothingFactor;
+
+    /** Smoothed conflicts per access above which a zone counts as hot */
+    float SplitConflictRate;
+
+    /** Smoothed accesses per second a zone needs before it can count as hot */
+    float SplitMinAccessRate;
+
+    /** Consecutive hot samples before a zone is split */
+    int32 SplitSustainSamples;
+
+    /** Smoothed accesses per second below which a zone counts as cold */
+    float MergeMaxAccessRate;
+
+    /** Consecutive cold samples before a zone is merged with a cold neighbour */
+    int32 MergeSustainSamples;
+
+    /** Seconds a newly created zone is left alone before it can be split or merged again */
+    float CooldownSeconds;
+
+    /** Smallest edge length a split may produce */
+    float MinSplitDimension;
+
+    /** Largest edge length a merge may produce */
+    float MaxMergedDimension;
+
+    /** Maximum number of splits plus merges per pass */
+    int32 MaxOperationsPerPass;
+
+    /** Constructor */
+    FZoneRebalancerConfig()
+        : bEnabled(true)
+        , SampleIntervalSeconds(0.25f)
+        , SmoothingFactor(0.3f)
+        , SplitConflictRate(0.15f)
+        , SplitMinAccessRate(50.0f)
+        , SplitSustainSamples(4)
+        , MergeMaxAccessRate(1.0f)
+        , MergeSustainSamples(20)
+        , CooldownSeconds(10.0f)
+        , MinSplitDimension(25.0f)
+        , MaxMergedDimension(200.0f)
+        , MaxOperationsPerPass(8)
+    {
+    }
+};
+
+/**
+ * Statistics for the zone rebalancer
+ */
+struct FZoneRebalancerStats
+{
+    /** Number of sampling passes run */
+    uint64 PassCount;
+
+    /** Number of zones split */
+    uint64 SplitCount;
+
+    /** Number of zone pairs merged */
+    uint64 MergeCount;
+
+    /** Number of split or merge attempts that failed because a zone was owned */
+    uint64 DeferredCount;
+
+    /** Duration of the most recent pass in milliseconds */
+    double LastPassTimeMs;
+
+    /** Constructor */
+    FZoneRebalancerStats()
+        : PassCount(0)
+        , SplitCount(0)
+        , MergeCount(0)
+        , DeferredCount(0)
+        , LastPassTimeMs(0.0)
+    {
+    }
+};
+
+/**
+ * Adaptive zone rebalancer
+ * Periodically samples FZoneMetrics, splits zones whose conflict rate stays high and
+ * merges face-adjacent zones that stay cold. Decisions use smoothed rates, require the
+ * condition to persist for several samples and put new zones on a cooldown, so the
+ * layout does not oscillate between split and merged states.
+ */
+class MININGSPICECOPILOT_API FZoneRebalancer : public FRunnable
+{
+public:
+    /**
+     * Constructor
+     * @param InZoneManager Zone manager to rebalance
+     * @param InConfig Rebalancing thresholds
+     */
+    FZoneRebalancer(FZoneManager& InZoneManager, const FZoneRebalancerConfig& InConfig = FZoneRebalancerConfig());
+
+    /** Destructor */
+    virtual ~FZoneRebalancer();
+
+    /**
+     * Starts the background sampling thread
+     * @return True if the thread is running
+     */
+    bool Initialize();
+
+    /** Stops the background sampling thread */
+    void Shutdown();
+
+    /**
+     * Samples zone metrics once and applies any splits or merges that are due
+     * Safe to call without the background thread (e.g. from tests or a game-thread tick)
+     * @return Number of splits plus merges applied
+     */
+    int32 RunRebalancePass();
+
+    /**
+     * Replaces the rebalancing thresholds
+     * @param InConfig New thresholds
+     */
+    void SetConfig(const FZoneRebalancerConfig& InConfig);
+
+    /**
+     * Gets the rebalancing thresholds
+     * @return Current thresholds
+     */
+    FZoneRebalancerConfig GetConfig() const;
+
+    /**
+     * Gets rebalancer statistics
+     * @return Current statistics
+     */
+    FZoneRebalancerStats GetStats() const;
+
+    //~ Begin FRunnable Interface
+    virtual bool Init() override;
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+    virtual void Exit() override;
+    //~ End FRunnable Interface
+
+private:
+    /** Smoothed heat tracked per zone between samples */
+    struct FZoneHeatState
+    {
+        /** Access count at the previous sample */
+        uint64 LastAccessCount;
+
+        /** Conflict count at the previous sample */
+        uint64 LastConflictCount;
+
+        /** Smoothed accesses per second */
+        float AccessRate;
+
+        /** Smoothed conflicts per access */
+        float ConflictRate;
+
+        /** Consecutive samples above the split threshold */
+        int32 HotSamples;
+
+        /** Consecutive samples below the merge threshold */
+        int32 ColdSamples;
+
+        /** Time before which the zone may not be split or merged */
+        double CooldownUntil;
+
+        /** Constructor */
+        FZoneHeatState()
+            : LastAccessCount(0)
+            , LastConflictCount(0)
+            , AccessRate(0.0f)
+            , ConflictRate(0.0f)
+            , HotSamples(0)
+            , ColdSamples(0)
+            , CooldownUntil(0.0)
+        {
+        }
+    };
+
+    /**
+     * Updates the heat state of every zone from its metrics
+     * @param CurrentTime Time of this sample
+     * @param ElapsedSeconds Seconds since the previous sample
+     */
+    void SampleZones(double CurrentTime, double ElapsedSeconds);
+
+    /**
+     * Splits zones that have stayed hot
+     * @param CurrentTime Time of this pass
+     * @param Budget Remaining operations for this pass (decremented)
+     * @return Number of zones split
+     */
+    int32 ApplySplits(double CurrentTime, int32& Budget);
+
+    /**
+     * Merges pairs of zones that have stayed cold
+     * @param CurrentTime Time of this pass
+     * @param Budget Remaining operations for this pass (decremented)
+     * @return Number of pairs merged
+     */
+    int32 ApplyMerges(double CurrentTime, int32& Budget);
+
+    /**
+     * Checks whether two zones have equal dimensions and share a full face
+     * @param Zone1 Snapshot of the first zone
+     * @param Zone2 Snapshot of the second zone
+     * @return True if merging them yields a box
+     */
+    static bool AreZonesFaceAligned(const FZoneSnapshot& Zone1, const FZoneSnapshot& Zone2);
+
+    /** Zone manager being rebalanced */
+    FZoneManager& ZoneManager;
+
+    /** Rebalancing thresholds */
+    FZoneRebalancerConfig Config;
+
+    /** Heat state per zone ID */
+    TMap<int32, FZoneHeatState> HeatStates;
+
+    /** Time of the previous sample */
+    double LastSampleTime;
+
+    /** Statistics */
+    FZoneRebalancerStats Stats;
+
+    /** Lock serializing passes and guarding config, heat state and stats */
+    mutable FCriticalSection RebalanceLock;
+
+    /** Sampling thread */
+    FRunnableThread* Thread;
+
+    /** Event used to wake the thread early on shutdown */
+    FEvent* ThreadEvent;
+
+    /** Whether the thread should exit */
+    FThreadSafeBool bShouldStop;
+};
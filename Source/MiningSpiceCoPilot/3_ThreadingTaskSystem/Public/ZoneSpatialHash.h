@@ -0,0 +1,214 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+struct FZoneDescriptor;
+
+/**
+ * Zone entry stored in a spatial hash cell
+ */
+struct FZoneSpatialEntry
+{
+    /** Zone ID */
+    int32 ZoneId;
+
+    /** Zone center in world space */
+    FVector Position;
+
+    /** Half the zone's dimensions, or zero if only the center is known */
+    FVector Extent;
+
+    /** Zone descriptor (owned by the zone manager, which retires it through FEpochManager) */
+    FZoneDescriptor* Zone;
+};
+
+/**
+ * Lock-free spatial hash for zone position queries
+ * Cells are keyed by the Morton code of their grid coordinate and stored in an
+ * open-addressed table. Cells are immutable once published: writers build a
+ * replacement cell and swap a single pointer, and superseded cells and tables are
+ * retired through FEpochManager, so readers never take a lock. Each query pins the
+ * calling thread for its own duration.
+ *
+ * Writers must be externally serialized (FZoneManager holds ZoneLock).
+ */
+class MININGSPICECOPILOT_API FZoneSpatialHash
+{
+public:
+    /**
+     * Constructor
+     * @param InCellSize World size of a grid cell
+     */
+    explicit FZoneSpatialHash(float InCellSize);
+
+    /** Destructor */
+    ~FZoneSpatialHash();
+
+    /**
+     * Inserts a zone into the cell containing its position (writer only)
+     * @param ZoneId ID of the zone
+     * @param Position Zone center
+     * @param Zone Zone descriptor
+     */
+    void Insert(int32 ZoneId, const FVector& Position, FZoneDescriptor* Zone);
+
+    /**
+     * Inserts a zone with known bounds into one cell (writer only)
+     * Zones larger than a cell are inserted into every cell from ComputeOverlappedCells so
+     * position lookups anywhere inside them find the zone.
+     * @param ZoneId ID of the zone
+     * @param Position Zone center
+     * @param Extent Half the zone's dimensions
+     * @param CellCoord Grid coordinate of the cell to insert into
+     * @param Zone Zone descriptor
+     */
+    void Insert(int32 ZoneId, const FVector& Position, const FVector& Extent, const FIntVector& CellCoord, FZoneDescriptor* Zone);
+
+    /**
+     * Removes a zone from a cell (writer only)
+     * @param ZoneId ID of the zone
+     * @param CellCoord Grid coordinate of the cell holding the zone
+     * @return True if the zone was found and removed
+     */
+    bool Remove(int32 ZoneId, const FIntVector& CellCoord);
+
+    /** Removes all zones (writer only) */
+    void Reset();
+
+    /**
+     * Finds the zone closest to a position within the position's cell
+     * Zones whose bounds contain the position are preferred over closer centers. The caller
+     * must be pinned (FEpochGuard) for as long as it uses the returned descriptor.
+     * @param Position World position to query
+     * @return Closest zone descriptor or nullptr if the cell is empty
+     */
+    FZoneDescriptor* FindClosestInCell(const FVector& Position) const;
+
+    /**
+     * Finds the ID of the zone closest to a position within the position's cell
+     * Zones whose bounds contain the position are preferred over closer centers.
+     * Unlike the descriptor, the ID stays safe to use after the zone is retired
+     * @param Position World position to query
+     * @return Closest zone ID or INDEX_NONE if the cell is empty
+     */
+    int32 FindClosestZoneIdInCell(const FVector& Position) const;
+
+    /**
+     * Gathers every zone whose center lies within a sphere
+     * Only cells whose bounds intersect the sphere are probed
+     * @param Position Sphere center
+     * @param Radius Sphere radius
+     * @param OutZoneIds Receives matching zone IDs (appended)
+     */
+    void GatherInRadius(const FVector& Position, float Radius, TArray<int32>& OutZoneIds) const;
+
+    /**
+     * Computes the grid coordinate of a position
+     * @param Position World position
+     * @return Grid cell coordinate
+     */
+    FIntVector ComputeCellCoord(const FVector& Position) const;
+
+    /**
+     * Computes the grid coordinates of every cell a box overlaps
+     * Boxes touching a cell only along a face, within a small tolerance, do not overlap it.
+     * @param Position Box center
+     * @param Extent Half the box's dimensions
+     * @param OutCells Receives the cell coordinates (replaced)
+     */
+    void ComputeOverlappedCells(const FVector& Position, const FVector& Extent, TArray<FIntVector>& OutCells) const;
+
+    /**
+     * Gets the number of non-empty cells
+     * @return Live cell count
+     */
+    int32 GetCellCount() const;
+
+private:
+    /** Immutable cell contents; replaced wholesale on every update */
+    struct FCell
+    {
+        /** Number of entries */
+        int32 Count;
+
+        /** Entries (variable length, Count elements) */
+        FZoneSpatialEntry Entries[1];
+    };
+
+    /** Open-addressed slot; a key is never cleared once set so probes stay valid */
+    struct FSlot
+    {
+        /** Morton key with the occupied bit set, or 0 if empty */
+        std::atomic<uint64> Key;
+
+        /** Current cell, or nullptr if the cell is empty */
+        std::atomic<FCell*> Cell;
+    };
+
+    /** Open-addressed table of slots; resized by publishing a new table */
+    struct FTable
+    {
+        /** Capacity minus one (capacity is a power of two) */
+        uint64 Mask;
+
+        /** Slots in use, including slots whose cell became empty */
+        int32 UsedSlots;
+
+        /** Slots in use with a non-empty cell */
+        int32 LiveCells;
+
+        /** Slot storage */
+        FSlot* Slots;
+    };
+
+    /** World size of a grid cell */
+    float CellSize;
+
+    /** Reciprocal of the cell size */
+    float InvCellSize;
+
+    /** Currently published table */
+    std::atomic<FTable*> Table;
+
+    /** Occupied flag folded into stored keys so a zero Morton code is distinguishable from empty */
+    static constexpr uint64 OccupiedBit = 1ull << 63;
+
+    /** Bias applied to signed cell coordinates before interleaving (21 bits per axis) */
+    static constexpr int32 CoordBias = 1 << 20;
+
+    /** Encodes a grid coordinate as a Morton key */
+    static uint64 EncodeMorton(const FIntVector& Coord);
+
+    /** Spreads the low 21 bits of a value so they occupy every third bit */
+    static uint64 SpreadBits(uint64 Value);
+
+    /** Finds the slot for a key, or the first empty slot in its probe sequence */
+    static FSlot* FindSlot(const FTable* InTable, uint64 StoredKey);
+
+    /** Copies the entry closest to a position within its cell (reader) */
+    bool FindClosestEntry(const FVector& Position, FZoneSpatialEntry& OutEntry) const;
+
+    /** Looks up the published cell for a coordinate (reader) */
+    static const FCell* FindCell(const FTable* InTable, const FIntVector& Coord);
+
+    /** Allocates a cell with room for Count entries */
+    static FCell* AllocateCell(int32 Count);
+
+    /** Allocates an empty table with the given capacity */
+    static FTable* AllocateTable(uint64 Capacity);
+
+    /** Frees a table (not its cells) */
+    static void FreeTable(FTable* InTable);
+
+    /** Grows or compacts the table if the load factor is too high (writer only) */
+    void MaybeResize();
+
+    /** Hands an unlinked cell to the epoch manager (writer only) */
+    static void RetireCell(FCell* Cell);
+
+    /** Hands an unlinked table, but not its cells, to the epoch manager (writer only) */
+    static void RetireTable(FTable* InTable);
+};